@@ -0,0 +1,18 @@
+##################################################
+### for benchmark
+##################################################
+### the benchmark suite shares all the sources of asfem except its main program,
+### it is not built by default, please use 'make asfem-bench' to build it
+set(bench_inc ${inc} include/Benchmark/BenchmarkSuite.h)
+set(bench_src ${src} src/Benchmark/BenchMain.cpp
+                     src/Benchmark/BenchmarkSuite.cpp
+                     src/Benchmark/MicroBenchmarks.cpp
+                     src/Benchmark/MacroBenchmarks.cpp)
+list(REMOVE_ITEM bench_src src/main.cpp)
+
+add_executable(asfem-bench EXCLUDE_FROM_ALL ${bench_inc} ${bench_src})
+target_link_libraries(asfem-bench ${MPI_LIB} ${PETSC_LIB} Threads::Threads)
+
+### usage:
+###   ./asfem-bench -o baseline.json                               (create the baseline)
+###   ./asfem-bench -o current.json --compare baseline.json --tolerance 0.1 (flag the regressions)
@@ -33,12 +33,17 @@ set(src ${src} src/Utils/JsonUtils.cpp)
 #############################################################
 set(inc ${inc} include/Utils/Timer.h)
 set(src ${src} src/Utils/Timer.cpp)
+set(inc ${inc} include/Utils/BinaryStream.h)
+set(inc ${inc} include/Utils/Profiler.h)
+set(src ${src} src/Utils/Profiler.cpp)
 
 #############################################################
 ### For MPITool                                           ###
 #############################################################
 set(inc ${inc} include/MPIUtils/MPIDataBus.h)
 set(src ${src} src/MPIUtils/MPIDataBus.cpp)
+set(inc ${inc} include/MPIUtils/EnsembleComm.h)
+set(src ${src} src/MPIUtils/EnsembleComm.cpp)
 
 #############################################################
 ### For mathematic utils                                  ###
@@ -73,6 +78,13 @@ set(inc ${inc} include/FECell/SingleMeshCell.h)
 set(inc ${inc} include/FECell/FECellData.h)
 set(inc ${inc} include/FECell/FECell.h)
 set(src ${src} src/FECell/FECell.cpp)
+set(src ${src} src/FECell/FECellSerialization.cpp)
+set(src ${src} src/FECell/FECellRebalance.cpp)
+set(inc ${inc} include/FECell/FECellReorder.h)
+set(src ${src} src/FECell/FECellReorder.cpp)
+set(inc ${inc} include/FECell/FECellAdaptivity.h)
+set(src ${src} src/FECell/FECellAdaptivity.cpp)
+set(src ${src} src/FECell/FECellAdaptMesh.cpp)
 set(inc ${inc} include/FECell/FECellGeneratorBase.h)
 ### for 1d lagrange mesh cell
 ### for edge2
@@ -107,6 +119,8 @@ set(src ${src} src/FECell/Lagrange3DHex27MeshCellGenerator.cpp)
 ##
 set(inc ${inc} include/FECell/FECellGenerator.h)
 set(src ${src} src/FECell/FECellGenerator.cpp)
+set(inc ${inc} include/FECell/ImplicitStructuredGrid.h)
+set(src ${src} src/FECell/ImplicitStructuredGrid.cpp)
 
 #############################################################
 ### For FE cell importer class                            ###
@@ -121,6 +135,8 @@ set(src ${src} src/FECell/Msh2File2FECellImporter.cpp)
 ### for msh4 file importer
 set(inc ${inc} include/FECell/Msh4File2FECellImporter.h)
 set(src ${src} src/FECell/Msh4File2FECellImporter.cpp)
+set(inc ${inc} include/FECell/Msh4FileReader.h)
+set(src ${src} src/FECell/Msh4FileReader.cpp)
 ### for gmsh2 file importer
 set(inc ${inc} include/FECell/Gmsh2File2FECellImporter.h)
 set(src ${src} src/FECell/Gmsh2File2FECellImporter.cpp)
@@ -131,6 +147,7 @@ set(src ${src} src/FECell/MeshFile2FECellImporter.cpp)
 ### For FE cell partitioner class                         ###
 #############################################################
 set(inc ${inc} include/FECell/FECellPartitionerBase.h)
+set(src ${src} src/FECell/FECellPartitionerBase.cpp)
 ### for built-in partitioner
 set(inc ${inc} include/FECell/FECellDefaultPartitioner.h)
 set(src ${src} src/FECell/FECellDefaultPartitioner.cpp)
@@ -187,6 +204,7 @@ set(inc ${inc} include/DofHandler/BulkDofHandler.h)
 set(src ${src} src/DofHandler/BulkDofHandler.cpp)
 set(src ${src} src/DofHandler/BulkDofHandlerSettings.cpp)
 set(src ${src} src/DofHandler/CreateBulkDofsMap.cpp)
+set(src ${src} src/DofHandler/BulkDofHandlerSerialization.cpp)
 
 #############################################################
 ### For boundary conditions                               ###
@@ -226,8 +244,11 @@ set(inc ${inc} include/BCSystem/Poisson2DBenchmarkBC.h)
 set(src ${src} src/BCSystem/Poisson2DBenchmarkBC.cpp)
 ###
 set(src ${src} src/BCSystem/ApplyDirichletBC.cpp)
+set(src ${src} src/BCSystem/SetupDirichletDofSets.cpp)
+set(src ${src} src/BCSystem/ApplyHangingNodeConstraints.cpp)
 ### for integrated bcs
 set(src ${src} src/BCSystem/ApplyIntegratedBC.cpp)
+set(src ${src} src/BCSystem/SetupIntegratedBCFaces.cpp)
 set(inc ${inc} include/BCSystem/IntegrateBCBase.h)
 ###
 set(inc ${inc} include/BCSystem/NeumannBC.h)
@@ -330,6 +351,10 @@ set(inc ${inc} include/MateSystem/BulkMaterialBase.h)
 set(src ${src} src/MateSystem/BulkMateSystem.cpp)
 set(src ${src} src/MateSystem/InitBulkMateLibs.cpp)
 set(src ${src} src/MateSystem/RunBulkMateLibs.cpp)
+set(src ${src} src/MateSystem/RunBulkMateLibsBatch.cpp)
+set(inc ${inc} include/MateSystem/BatchMaterialBase.h)
+set(inc ${inc} include/MateSystem/BatchMaterialData.h)
+set(src ${src} src/MateSystem/BatchMaterialData.cpp)
 ### for poisson material
 set(inc ${inc} include/MateSystem/ConstPoissonMaterial.h)
 set(src ${src} src/MateSystem/ConstPoissonMaterial.cpp)
@@ -412,6 +437,8 @@ set(src ${src} src/MateSystem/MateSystem.cpp)
 #############################################################
 set(inc ${inc} include/FE/FE.h)
 set(src ${src} src/FE/FE.cpp)
+set(inc ${inc} include/FE/ReducedIntegration.h)
+set(src ${src} src/FE/ReducedIntegration.cpp)
 ####################################
 # for shape function data
 ####################################
@@ -548,12 +575,16 @@ set(src ${src} src/FE/QPoints/QPoint.cpp)
 ### For FESystem class                                    ###
 #############################################################
 set(inc ${inc} include/FESystem/FECalcType.h)
+set(inc ${inc} include/FESystem/LumpedMassType.h)
 set(inc ${inc} include/FESystem/FESystem.h)
 ### for bulk FE system
 set(inc ${inc} include/FESystem/BulkFESystem.h)
 set(src ${src} src/FESystem/BulkFESystem.cpp)
 set(src ${src} src/FESystem/BulkFESystemInit.cpp)
 set(src ${src} src/FESystem/FormBulkFE.cpp)
+set(src ${src} src/FESystem/FormBulkLumpedMass.cpp)
+set(src ${src} src/FESystem/RunBatchMaterials.cpp)
+set(src ${src} src/FESystem/FormBulkReducedIntegration.cpp)
 set(src ${src} src/FESystem/BulkFESystemAssemble.cpp)
 ### for FE system
 set(src ${src} src/FESystem/FESystem.cpp)
@@ -586,17 +617,25 @@ set(src ${src} src/EquationSystem/EquationSystem.cpp)
 ### For Solution class                                    ###
 #############################################################
 set(inc ${inc} include/SolutionSystem/SolutionSystem.h)
+set(inc ${inc} include/SolutionSystem/SinglePrecisionMateField.h)
 set(src ${src} src/SolutionSystem/SolutionSystem.cpp)
 set(src ${src} src/SolutionSystem/SolutionSystemInit.cpp)
+set(src ${src} src/SolutionSystem/SolutionSystemMigration.cpp)
+set(src ${src} src/SolutionSystem/SolutionSystemPrecision.cpp)
 set(src ${src} src/SolutionSystem/SolutionUpdate.cpp)
 
 #############################################################
 ### For Linear solver class                               ###
 #############################################################
 set(inc ${inc} include/LinearSolver/LinearSolverBase.h)
+set(inc ${inc} include/LinearSolver/FieldSplitBlock.h)
 ### for ksp linear solver
 set(inc ${inc} include/LinearSolver/KSPSolver.h)
 set(src ${src} src/LinearSolver/KSPSolver.cpp)
+set(src ${src} src/LinearSolver/KSPFieldSplit.cpp)
+set(src ${src} src/LinearSolver/KSPMultigrid.cpp)
+set(inc ${inc} include/LinearSolver/SinglePrecisionPC.h)
+set(src ${src} src/LinearSolver/SinglePrecisionPC.cpp)
 ### for linear solver
 set(inc ${inc} include/LinearSolver/LinearSolver.h)
 set(src ${src} src/LinearSolver/LinearSolver.cpp)
@@ -607,6 +646,7 @@ set(src ${src} src/LinearSolver/LinearSolver.cpp)
 set(inc ${inc} include/NonlinearSolver/NonlinearSolverBase.h)
 set(inc ${inc} include/NonlinearSolver/NonlinearSolverType.h)
 set(inc ${inc} include/NonlinearSolver/NonlinearSolverBlock.h)
+set(inc ${inc} include/NonlinearSolver/ForcingTermType.h)
 ### for SNES solver
 set(inc ${inc} include/NonlinearSolver/SNESSolver.h)
 set(src ${src} src/NonlinearSolver/SNESSolver.cpp)
@@ -617,6 +657,9 @@ set(src ${src} src/NonlinearSolver/NonlinearSolver.cpp)
 ### for newton-raphson solver
 set(inc ${inc} include/NonlinearSolver/NewtonRaphsonSolver.h)
 set(src ${src} src/NonlinearSolver/NewtonRaphsonSolver.cpp)
+### for staggered solver
+set(inc ${inc} include/NonlinearSolver/StaggeredSolver.h)
+set(src ${src} src/NonlinearSolver/StaggeredSolver.cpp)
 
 
 #############################################################
@@ -629,6 +672,9 @@ set(inc ${inc} include/TimeStepping/TimeSteppingTool.h)
 set(inc ${inc} include/TimeStepping/TimeStepping.h)
 set(src ${src} src/TimeStepping/TimeStepping.cpp)
 set(src ${src} src/TimeStepping/TimeSteppingSolve.cpp)
+set(src ${src} src/TimeStepping/TimeSteppingExplicit.cpp)
+set(src ${src} src/TimeStepping/TimeSteppingRebalance.cpp)
+set(src ${src} src/TimeStepping/TimeSteppingAdaptivity.cpp)
 set(src ${src} src/TimeStepping/TimeSteppingTool.cpp)
 
 #############################################################
@@ -642,6 +688,8 @@ set(src ${src} src/OutputSystem/SaveResults.cpp)
 ### for vtu format
 set(inc ${inc} include/OutputSystem/VTUWriter.h)
 set(src ${src} src/OutputSystem/VTUWriter.cpp)
+set(inc ${inc} include/OutputSystem/AsyncOutputQueue.h)
+set(src ${src} src/OutputSystem/AsyncOutputQueue.cpp)
 
 
 #############################################################
@@ -653,6 +701,9 @@ set(inc ${inc} include/Postprocess/PostprocessorType.h)
 set(src ${src} src/Postprocess/Postprocessor.cpp)
 set(src ${src} src/Postprocess/SavePostprocessResults.cpp)
 set(src ${src} src/Postprocess/ExecutePostprocess.cpp)
+set(inc ${inc} include/Postprocess/PointProbe.h)
+set(src ${src} src/Postprocess/PointProbe.cpp)
+set(src ${src} src/Postprocess/SetupPointProbes.cpp)
 ###
 set(inc ${inc} include/Postprocess/NodalPostprocessorBase.h)
 ###
@@ -732,10 +783,13 @@ set(inc ${inc} include/FEProblem/FEProblem.h)
 set(inc ${inc} include/FEProblem/FEControlInfo.h)
 set(inc ${inc} include/FEProblem/FEJobType.h)
 set(inc ${inc} include/FEProblem/FEJobBlock.h)
+set(inc ${inc} include/FEProblem/PreparedModelCache.h)
 set(src ${src} src/FEProblem/FEProblem.cpp)
+set(src ${src} src/FEProblem/PreparedModelCache.cpp)
 set(src ${src} src/FEProblem/RunFEProblem.cpp)
 set(src ${src} src/FEProblem/RunStaticAnalysis.cpp)
-set(src ${src} src/FEProblem/RunTransientAnalysis.cpp) 
+set(src ${src} src/FEProblem/RunTransientAnalysis.cpp)
+set(src ${src} src/FEProblem/RunEnsembleAnalysis.cpp)
 
 
 #############################################################
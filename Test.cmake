@@ -2,6 +2,8 @@
 ### for test
 ##################################################
 enable_testing (test)
+### the mpi launcher for the tests which need more than one rank
+find_program (MPIEXEC_EXECUTABLE NAMES mpiexec mpirun HINTS "${MPI_DIR}/bin" "${PETSC_DIR}/bin")
 ### for tutorial
 add_test (NAME step2-2d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/examples/tutorial/step2-2d.json")
 add_test (NAME step2-3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/examples/tutorial/step2-2d.json")
@@ -11,8 +13,49 @@ add_test (NAME step3-3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/examples
 add_test (NAME mesh1d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/mesh1d.json --read-only")
 add_test (NAME mesh2d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/mesh2d.json --read-only")
 add_test (NAME mesh3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/mesh3d.json --read-only")
+add_test (NAME implicit-grid COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/poisson-3d-implicit.json")
+add_test (NAME mesh-reorder COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/poisson-2d-reorder.json")
 add_test (NAME bcs COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/bcs/poisson-2d-mixed.json")
+add_test (NAME bcs-dirichlet-nl COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/bcs/diffusion-2d-dirichlet-nl.json")
+add_test (NAME bcs-rotateddirichlet COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/bcs/neohookean-3d-rotateddirichlet.json")
+### the integrated bcs on quad9 edges, hex8 faces and hex20 faces
+add_test (NAME bcs-traction-2d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/neohookean-cookmembrane-2d-quad9.json")
+add_test (NAME bcs-traction-3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/neohookean-cookmembrane-3d-hex8.json")
+add_test (NAME bcs-pressure-3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/bcs/linearelastic-3d-pressure.json")
 add_test (NAME importmesh2 COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh2-2d.json")
 add_test (NAME importmesh4 COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-2d.json")
+add_test (NAME importmesh4-binary COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-2d-binary.json")
+add_test (NAME importmesh4-binary-datasize4 COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-2d-binary-datasize4.json")
+### the big-endian copy of the binary mesh must be rejected
+add_test (NAME importmesh4-binary-swapped COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-2d-binary-swapped.json")
+set_tests_properties (importmesh4-binary-swapped PROPERTIES PASS_REGULAR_EXPRESSION "endianness")
 add_test (NAME postprocess COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/postprocess/poisson-2d-pps.json")
-add_test (NAME postprocess-sinxy COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/postprocess/sinxy-integration.json")
\ No newline at end of file
+add_test (NAME postprocess-sinxy COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/postprocess/sinxy-integration.json")
+add_test (NAME jacobian-lag COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/diffusion-2d-nl-jacobian-lag.json")
+add_test (NAME inexact-newton COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/diffusion-2d-nl-ew.json")
+add_test (NAME single-precision COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/neohookean-cookmembrane-2d-quad4-single.json")
+add_test (NAME mesh-adaptivity COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/allencahn-2d-adaptivity.json")
+add_test (NAME multigrid COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/poisson-2d-mg.json")
+add_test (NAME explicit-dynamics COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/elastic-wave-2d-explicit.json")
+add_test (NAME fieldsplit COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/smallstraindiff-2d-fieldsplit.json")
+add_test (NAME staggered COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/acfracture-2d-staggered.json")
+add_test (NAME ensemble COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/poisson-2d-ensemble.json")
+add_test (NAME profiler COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/poisson-2d-cg.json" "--profile")
+add_test (NAME async-output COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/output/diffusion-2d-async.json")
+### the first run writes the model cache, the second one loads it
+add_test (NAME model-cache-write COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/poisson-2d-cache.json")
+add_test (NAME model-cache-read COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/mesh/poisson-2d-cache.json")
+set_tests_properties (model-cache-write PROPERTIES FIXTURES_SETUP model-cache)
+set_tests_properties (model-cache-read PROPERTIES FIXTURES_REQUIRED model-cache)
+add_test (NAME reduced-integration COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/neohookean-cookmembrane-2d-quad4-reduced.json")
+### the batched material kernels are checked against the qpoint-by-qpoint ones, the run stops on any difference
+add_test (NAME batch-materials-2d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/neohookean-cookmembrane-2d-quad4-batch.json")
+add_test (NAME batch-materials-3d COMMAND asfem "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/projection/linearelastic-cookmembrane-3d-hex8-batch.json")
+### the rebalance, the migration and the shared dirichlet nodes only happen with more than one rank
+if (MPIEXEC_EXECUTABLE)
+    add_test (NAME rebalance COMMAND ${MPIEXEC_EXECUTABLE} "-n" "2" $<TARGET_FILE:asfem> "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/solver/diffusion-2d-rebalance.json")
+    add_test (NAME bcs-dirichlet-nl-mpi COMMAND ${MPIEXEC_EXECUTABLE} "-n" "2" $<TARGET_FILE:asfem> "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/bcs/diffusion-2d-dirichlet-nl.json")
+    ### the master packs the bulk and the physical group cells of the imported meshes for the other ranks
+    add_test (NAME importmesh4-mpi COMMAND ${MPIEXEC_EXECUTABLE} "-n" "3" $<TARGET_FILE:asfem> "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-2d-mpi.json")
+    add_test (NAME importmesh4-tet4-mpi COMMAND ${MPIEXEC_EXECUTABLE} "-n" "2" $<TARGET_FILE:asfem> "-i" "${CMAKE_CURRENT_SOURCE_DIR}/test_input/importmesh/poisson-msh4-tet4-mpi.json")
+endif ()
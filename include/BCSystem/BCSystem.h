@@ -110,6 +110,17 @@ public:
         }
         return m_BCBlockList[i-1];
     }
+    /**
+     * get the reference of the i-th bc block, it is used to override the bc value in the ensemble run
+     * @param i the integer index for bc block
+     */
+    inline BCBlock& getIthBCBlockRef(const int &i){
+        if(i<1||i>m_BCBlocksNum){
+            MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of range for bcblocks");
+            MessagePrinter::exitAsFem();
+        }
+        return m_BCBlockList[i-1];
+    }
     /**
      * get the penalty coefficient for dirichlet bc
      */
@@ -167,6 +178,12 @@ public:
                                  SparseMatrix &AMATRIX,
                                  Vector &RHS);
 
+    /**
+     * drop the cached dof sets and bc faces, they are rebuilt at the next bc application, this should be called
+     * once the mesh or the dofs map is changed
+     */
+    void resetBoundaryDofSets();
+
     /**
      * release the memory
      */
@@ -204,16 +221,36 @@ private:
                    MatrixXd &LocalK,
                    VectorXd &LocalR);
 
+    /**
+     * the constrained dofs of one dirichlet type bc block, only the nodes owned by current rank are stored (the owner
+     * of a node is the owner of its first constrained dof), and each node appears only once
+     */
+    struct DirichletDofSet{
+        int Dim=0;/**< the dimension of the bc elements */
+        int DofsNum=0;/**< the number of constrained dofs per node */
+        vector<Vector3d> NodeCoords0;/**< the reference coordinates of each node */
+        vector<int> DofIDs;/**< the global dof ids of each node, start from 1 */
+        vector<int> Rows;/**< the same dof ids as the row index of petsc, start from 0 */
+        vector<double> Zeros;/**< the zero residual of each dof */
+        vector<double> Values;/**< the buffer for the constant bc value of each dof */
+    };
+
+    /**
+     * build the constrained dof set of all the dirichlet type bc blocks, this should be called only once before
+     * the first bc application
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dofhandler class
+     * @param U the solution vector, which gives the dof ownership of each rank
+     */
+    void setupDirichletDofSets(const FECell &t_FECell,const DofHandler &t_DofHandler,Vector &U);
+
     /**
      * for dirichlet boundary condition
      * @param CalcType the calculation type
      * @param BCValue the boundary value
      * @param t_BCType the boundary condition type
      * @param Params the json content of parameters for bc block
-     * @param DofIDs the local dofs id of current bc block
-     * @param BCNameList the boundary name list
-     * @param t_FECell the fe cell class
-     * @param t_DofHandler the dofhandler class
+     * @param DofSet the constrained dof set of current bc block
      * @param U the solution vector
      * @param Ucopy the solution vector's copy
      * @param Uold the solution vector of previous step
@@ -226,14 +263,82 @@ private:
                           const double &BCValue,
                           const BCType &t_BCType,
                           const nlohmann::json &Params,
-                          const vector<int> &DofIDs,
-                          const vector<string> &BCNameList,
-                          const FECell &t_FECell,const DofHandler &t_DofHandler,
+                          DirichletDofSet &DofSet,
                           Vector &U,Vector &Ucopy,Vector &Uold,Vector &Uolder,
                           Vector &V,
                           SparseMatrix &AMATRIX,
                           Vector &RHS);
 
+    /**
+     * the cached geometry of one integrated bc face, the face is integrated on the reference configuration, so
+     * its shape functions, JxW, and normals are tabulated once and reused in all the newton iterations
+     */
+    struct IntegratedBCFace{
+        int Dim=0;/**< the dimension of the bc element */
+        int NodesNum=0;/**< the nodes number of the bc element */
+        int QPointsNum=0;/**< the qpoints number of the bc element */
+        vector<int> Rows;/**< the global dof ids of the face, node-major, start from 0 */
+        vector<double> JxW;/**< the jacobian*weight of each qpoint */
+        vector<Vector3d> Normal;/**< the normal vector of each qpoint */
+        vector<Vector3d> QpCoords0;/**< the reference coordinates of each qpoint */
+        vector<double> Shp;/**< the shape function value of each qpoint and node, qpoint-major */
+        vector<Vector3d> Grad;/**< the shape function gradient of each qpoint and node, qpoint-major */
+    };
+
+    /**
+     * tabulate the face geometry of all the integrated bc blocks, this should be called only once before the
+     * first bc application
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dofhandler class
+     * @param t_FE the fe space class
+     */
+    void setupIntegratedBCFaces(const FECell &t_FECell,const DofHandler &t_DofHandler,FE &t_FE);
+
+    /**
+     * fold the hanging nodes of one bc face into their master nodes, so the face only couples to the free dofs
+     * @param t_Cell the bc cell of current face
+     * @param t_DofIDs the local dofs id of current bc block
+     * @param t_DofHandler the dofhandler class
+     * @param t_Face the cached bc face
+     */
+    void condenseHangingNodes(const SingleMeshCell &t_Cell,const vector<int> &t_DofIDs,
+                              const DofHandler &t_DofHandler,IntegratedBCFace &t_Face);
+
+    /**
+     * the hanging dofs owned by current rank, each row holds the constraint u_h-sum(w*u_m)=0
+     */
+    struct HangingDofSet{
+        vector<int> Rows;/**< the hanging dof ids as the row index of petsc, start from 0 */
+        vector<int> MasterPtr;/**< the start position of each row's masters */
+        vector<int> MasterCols;/**< the position of each master in the scattered master values */
+        vector<double> Weights;/**< the weight of each master */
+        vector<int> MasterRows;/**< the unique master dof ids of all the rows, start from 0 */
+        vector<double> Residual;/**< the buffer for the constraint residual of each row */
+        Vec MasterVals;/**< the sequential vector of the master values */
+        VecScatter Scatter;/**< the scatter from the solution vector to the master values */
+    };
+
+    /**
+     * build the hanging dof set of current rank, this should be called only once before the first bc application
+     * @param t_DofHandler the dofhandler class
+     * @param U the solution vector, which gives the dof ownership of each rank
+     */
+    void setupHangingDofSet(const DofHandler &t_DofHandler,Vector &U);
+
+    /**
+     * replace the rows of the hanging dofs by their constraints, the bulk system never assembles into these rows
+     * @param CalcType the calculation type
+     * @param U the solution vector
+     * @param AMATRIX the system K matrix
+     * @param RHS the system residual vector
+     */
+    void applyHangingNodeConstraints(const FECalcType &CalcType,Vector &U,SparseMatrix &AMATRIX,Vector &RHS);
+
+    /**
+     * destroy the hanging dof set and its scatter
+     */
+    void destroyHangingDofSet();
+
     /**
      * for integrated boundary condition
      * @param CalcType the calculation type
@@ -242,10 +347,7 @@ private:
      * @param Ctan the time integration array
      * @param Parameters the json parameter content for bc block
      * @param DofIDs the local dofs id of current bc block
-     * @param BCNameList the boundary name list
-     * @param t_FECell the fe cell class
-     * @param t_DofHandler the dofhandler class
-     * @param t_FE the FE space class
+     * @param Faces the cached faces of current bc block
      * @param U the solution vector
      * @param Uold the solution vector of previous step
      * @param Uolder the solution vector of pre-previous step
@@ -259,9 +361,7 @@ private:
                            const double (&Ctan)[3],
                            const nlohmann::json &Parameters,
                            const vector<int> &DofIDs,
-                           const vector<string> &BCNameList,
-                           const FECell &t_FECell,const DofHandler &t_DofHandler,
-                           FE &t_FE,
+                           const vector<IntegratedBCFace> &Faces,
                            Vector &U,Vector &Uold,Vector &Uolder,
                            Vector &V,
                            SparseMatrix &AMATRIX,
@@ -269,37 +369,18 @@ private:
     
 private:
     /**
-     * assemble local residual to the global RHS
-     * @param Dofs the number of dofs for current bc element
-     * @param DofIDs the local dof ids
-     * @param I the node index, global one
-     * @param JxW the jacobian*weight value
-     * @param t_DofHandler the dofhandler class
-     * @param LocalR the local residual vector
+     * assemble the local residual of one bc face to the global RHS in one call
+     * @param Face the cached bc face
      * @param RHS the system residual vector
      */
-    void assembleLocalResidual2Global(const int &Dofs,const vector<int> &DofIDs,
-                                      const int &I,const double &JxW,
-                                      const DofHandler &t_DofHandler,
-                                      const VectorXd &LocalR,Vector &RHS);
+    void assembleFaceResidual2Global(const IntegratedBCFace &Face,Vector &RHS);
     
     /**
-     * assemble local residual to the global RHS
-     * @param Dofs the number of dofs for current bc element
-     * @param DofIDs the local dof ids
-     * @param I the node i-index, global one
-     * @param J the node j-index, global one
-     * @param JxW the jacobian*weight value
-     * @param t_DofHandler the dofhandler class
-     * @param LocalK the local K matrix
+     * assemble the local jacobian of one bc face to the global K matrix in one call
+     * @param Face the cached bc face
      * @param AMATRIX the system K matrix
      */
-    void assembleLocalJacobian2Global(const int &Dofs,const vector<int> &DofIDs,
-                                      const int &I,const int &J,
-                                      const double &JxW,
-                                      const DofHandler &t_DofHandler,
-                                      const MatrixXd &LocalK,
-                                      SparseMatrix &AMATRIX);
+    void assembleFaceJacobian2Global(const IntegratedBCFace &Face,SparseMatrix &AMATRIX);
 
 
 
@@ -307,6 +388,12 @@ private:
     vector<BCBlock> m_BCBlockList;/**< vector for bc blocks */
     int m_BCBlocksNum; /**< number of bc blocks */
     double m_DirichletPenalty;/**< the penalty coefficient for dirichlet bc */
+    vector<DirichletDofSet> m_DirichletDofSets;/**< the constrained dof set of each bc block */
+    bool m_HasDirichletDofSets;/**< true if the constrained dof sets are ready */
+    vector<vector<IntegratedBCFace>> m_IntegratedBCFaces;/**< the cached faces of each bc block */
+    bool m_HasIntegratedBCFaces;/**< true if the face geometry is tabulated */
+    HangingDofSet m_HangingDofSet;/**< the hanging dofs owned by current rank */
+    bool m_HasHangingDofSet;/**< true if the hanging dof set is ready */
 
 private:
     PetscMPIInt m_Rank;/**< for the rank id of current cpu */
@@ -315,6 +402,8 @@ private:
 private:
     VectorXd m_LocalR;/**< for the local 'element's vector, used for one single element/model */
     MatrixXd m_LocalK;/**< for the local 'element's matrix, used for one single element/model */
+    vector<double> m_FaceR;/**< the residual of one bc face, accumulated from all its qpoints */
+    vector<double> m_FaceK;/**< the row-major jacobian of one bc face, accumulated from all its qpoints */
 
     int m_BCElmtNodesNum;/**< the nodes number of the bc element */
     Nodes m_Nodes;/**< for the nodal coordinates of current bc element (current configuration) */
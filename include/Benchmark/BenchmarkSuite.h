@@ -0,0 +1,179 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.12
+//+++ Purpose: the micro and macro benchmark suite of AsFem, the
+//+++          timings are saved to a json baseline, which can be
+//+++          compared with a previous one to flag regressions
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include "petsc.h"
+#include "nlohmann/json.hpp"
+
+#include "Utils/MessagePrinter.h"
+
+using std::string;
+using std::vector;
+
+/**
+ * This class implements the benchmark suite of AsFem. The micro benchmarks time the single kernels, i.e., the shape
+ * functions, the tensor operations, the materials, the elements, and the PETSc vector/matrix operations. The macro
+ * benchmarks run the full FEProblem on the generated meshes of several sizes, and take the assembly, solve, and output
+ * time from the profiler report. All the results are written to a json file, which can be used as the baseline of the
+ * next run, the case whose time exceeds (1+tolerance) times of the baseline one is flagged as a regression.
+ */
+class BenchmarkSuite{
+public:
+    /**
+     * constructor
+     */
+    BenchmarkSuite();
+
+    /**
+     * read the options from the command line
+     * @param args the number of arguments
+     * @param argv the argument string vector
+     * @return false if the options are invalid or only the help message is required
+     */
+    bool init(int args,char *argv[]);
+
+    /**
+     * run the selected benchmarks
+     */
+    void run();
+
+    /**
+     * write the results and compare them with the baseline (if given), this is a collective call
+     * @return 1 if any regression is detected, otherwise 0
+     */
+    int finalize();
+
+    /**
+     * print out the help message
+     */
+    static void printHelp();
+
+private:
+    //**************************************************
+    //*** for the micro benchmarks
+    //**************************************************
+    /**
+     * time the shape function calculation of each mesh type
+     */
+    void runShapeFunBenchmarks();
+    /**
+     * time the rank-2 and rank-4 tensor kernels
+     */
+    void runTensorBenchmarks();
+    /**
+     * time each material (material only) and each element (material plus element kernels) on one qpoint
+     */
+    void runMateAndElmtBenchmarks();
+    /**
+     * time the PETSc vector and sparse matrix operations
+     */
+    void runLinearAlgebraBenchmarks();
+
+    //**************************************************
+    //*** for the macro benchmarks
+    //**************************************************
+    /**
+     * run the FEProblem on the generated meshes, the assembly/solve/output time is read from the profiler report
+     */
+    void runMacroBenchmarks();
+
+    //**************************************************
+    //*** for the timing and results
+    //**************************************************
+    /**
+     * check whether the benchmark is selected by the '--filter' option
+     * @param name the full name of the benchmark
+     */
+    bool isSelected(const string &name)const;
+    /**
+     * time the given kernel, the batch size is doubled until one batch takes longer than the minimum time, then the
+     * median and the minimum time per call over the repeated batches are recorded. The kernel must return a double,
+     * which is accumulated to prevent the compiler from removing the calculation. The batch sizes are synchronized
+     * over all the ranks, so the collective kernels (i.e., PETSc operations) are allowed.
+     * @param name the full name of the benchmark, i.e., micro/shapefun/quad4
+     * @param size the problem size of the benchmark
+     * @param kernel the kernel to be timed
+     */
+    template<typename Func>
+    void timeKernel(const string &name,const int &size,Func &&kernel){
+        if(!isSelected(name)) return;
+        double sum=0.0,t,tmax;
+        long batch=1;
+        std::chrono::steady_clock::time_point start;
+        while(true){
+            start=std::chrono::steady_clock::now();
+            for(long i=0;i<batch;i++) sum+=kernel();
+            t=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+            MPI_Allreduce(&t,&tmax,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);
+            if(tmax>=m_MinBatchTime||batch>=(1L<<30)) break;
+            batch*=2;
+        }
+        vector<double> samples(m_Repeats,0.0);
+        for(int r=0;r<m_Repeats;r++){
+            start=std::chrono::steady_clock::now();
+            for(long i=0;i<batch;i++) sum+=kernel();
+            t=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+            MPI_Allreduce(&t,&tmax,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);
+            samples[r]=tmax/batch;
+        }
+        m_Sink=sum;
+        std::sort(samples.begin(),samples.end());
+        addResult(name,size,samples[m_Repeats/2],samples[0],batch*m_Repeats);
+    }
+    /**
+     * add one benchmark result
+     * @param name the full name of the benchmark
+     * @param size the problem size of the benchmark
+     * @param time the median time per call in second
+     * @param mintime the minimum time per call in second
+     * @param calls the total number of timed calls
+     */
+    void addResult(const string &name,const int &size,const double &time,const double &mintime,const long &calls);
+    /**
+     * write the results to the json file, only the master rank writes the file
+     * @param filename the file name of the json file
+     */
+    void writeResults(const string &filename)const;
+    /**
+     * compare the results with the baseline file and print out the summary
+     * @param filename the file name of the baseline json file
+     * @return the number of regressions
+     */
+    int compareWithBaseline(const string &filename);
+
+private:
+    bool m_RunMicro;/**< true for running the micro benchmarks */
+    bool m_RunMacro;/**< true for running the macro benchmarks */
+    string m_Filter;/**< only the benchmark whose name contains the filter string is executed */
+    string m_OutputFileName;/**< the json file name of the results */
+    string m_BaselineFileName;/**< the json file name of the baseline, empty for no comparison */
+    string m_WorkDir;/**< the folder for the generated input files of the macro benchmarks */
+    double m_Tolerance;/**< the relative tolerance of the regression check */
+    double m_MinBatchTime;/**< the minimum time of one timed batch in second */
+    int m_Repeats;/**< the repeats of the timed batches */
+    int m_MacroLevels;/**< the number of mesh sizes of each macro benchmark */
+    int m_Rank;/**< the rank id */
+    int m_Size;/**< the number of ranks */
+    nlohmann::json m_Results;/**< the benchmark results */
+    volatile double m_Sink;/**< the sink of the kernel results */
+
+};
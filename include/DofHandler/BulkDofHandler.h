@@ -59,6 +59,16 @@ public:
      * @param t_elmtSystem the element class
      */
     void createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmtSystem);
+    /**
+     * update the local elemental dofs map after the bulk elements are re-partitioned,
+     * the global dofs map is not changed
+     * @param t_fecell the fe cell class
+     */
+    void updateLocalBulkDofsMap(FECell &t_fecell);
+    /**
+     * return true if the dofs map is computed from the implicit structured grid
+     */
+    inline bool isImplicitDofsMap()const{return m_IsImplicitDofsMap;}
     /**
      * add dof name to the namelist, it must be unique and non-duplicated name
      * @param dofname string for the name of one single dof
@@ -155,6 +165,7 @@ public:
             MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of nodes' max dof num(="+to_string(m_MaxDofsPerNode)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap) return (i-1)*m_MaxDofsPerNode+j;
         return m_NodalDofIDs_Global[i-1][j-1];
     }
     /**
@@ -171,6 +182,7 @@ public:
             MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of nodes' max dof num(="+to_string(m_MaxDofsPerNode)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap) return (i-1)*m_MaxDofsPerNode+j-1;
         return m_NodalDofIDs_Global[i-1][j-1]-1;
     }
     /**
@@ -183,10 +195,11 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
-        if(j<1||j>static_cast<int>(m_ElementalDofIDs_Global[i-1].size())){
-            MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of elmts' dof num(="+to_string(m_ElementalDofIDs_Global[i-1].size())+")");
+        if(j<1||j>getIthBulkElmtDofsNum(i)){
+            MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of elmts' dof num(="+to_string(getIthBulkElmtDofsNum(i))+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap) return getImplicitElmtDofID(i,j);
         return m_ElementalDofIDs_Global[i-1][j-1];
     }
     /**
@@ -199,10 +212,11 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
-        if(j<1||j>static_cast<int>(m_ElementalDofIDs_Global[i-1].size())){
-            MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of elmts' dof num(="+to_string(m_ElementalDofIDs_Global[i-1].size())+")");
+        if(j<1||j>getIthBulkElmtDofsNum(i)){
+            MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of elmts' dof num(="+to_string(getIthBulkElmtDofsNum(i))+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap) return getImplicitElmtDofID(i,j)-1;
         return m_ElementalDofIDs_Global[i-1][j-1]-1;
     }
     /**
@@ -215,6 +229,10 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap){
+            for(int j=0;j<m_MaxDofsPerElmt;j++) elmtdofs[j]=getImplicitElmtDofID(i,j+1);
+            return;
+        }
         bool AllDofsAreZero;AllDofsAreZero=true;
         for(int j=0;j<static_cast<int>(m_ElementalDofIDs_Global[i-1].size());j++){
             elmtdofs[j]=m_ElementalDofIDs_Global[i-1][j];
@@ -235,6 +253,10 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap){
+            for(int j=0;j<m_MaxDofsPerElmt;j++) elmtdofs[j]=getImplicitElmtDofID(i,j+1)-1;
+            return;
+        }
         bool AllDofsAreZero;AllDofsAreZero=true;
         for(int j=0;j<static_cast<int>(m_ElementalDofIDs_Global[i-1].size());j++){
             elmtdofs[j]=m_ElementalDofIDs_Global[i-1][j]-1;
@@ -255,6 +277,10 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap){
+            for(int j=0;j<m_MaxDofsPerElmt;j++) elmtdofs[j]=getImplicitElmtDofID(i,j+1);
+            return;
+        }
         for(int j=0;j<static_cast<int>(m_ElementalDofIDs_Global[i-1].size());j++){
             elmtdofs[j]=m_ElementalDofIDs_Global[i-1][j];
         }
@@ -269,6 +295,10 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap){
+            for(int j=0;j<m_MaxDofsPerElmt;j++) elmtdofs[j]=getImplicitElmtDofID(i,j+1)-1;
+            return;
+        }
         for(int j=0;j<static_cast<int>(m_ElementalDofIDs_Global[i-1].size());j++){
             elmtdofs[j]=m_ElementalDofIDs_Global[i-1][j]-1;
         }
@@ -282,6 +312,7 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of elmts' range(="+to_string(m_BulkElmtsNum)+")");
             MessagePrinter::exitAsFem();
         }
+        if(m_IsImplicitDofsMap) return m_MaxDofsPerElmt;
         return static_cast<int>(m_ElementalDofIDs_Global[i-1].size());
     }
 
@@ -342,6 +373,62 @@ public:
     }
 
 
+    //***************************************************
+    //*** for the hanging nodes of the adapted mesh
+    //***************************************************
+    /**
+     * return true if the mesh has hanging nodes, whose dofs are constrained by their master nodes
+     */
+    inline bool hasHangingNodes()const{return !m_HangingNodeIDs.empty();}
+    /**
+     * get the ids of all the hanging nodes
+     */
+    inline const vector<int>& getHangingNodeIDsRef()const{return m_HangingNodeIDs;}
+    /**
+     * get the masters number of the i-th node, 0 if it is not a hanging node
+     * @param i integer for i-th node
+     */
+    inline int getIthNodeMastersNum(const int &i)const{
+        if(m_NodeHangingIDs.empty()||m_NodeHangingIDs[i-1]<0) return 0;
+        return m_HangingMasterPtr[m_NodeHangingIDs[i-1]+1]-m_HangingMasterPtr[m_NodeHangingIDs[i-1]];
+    }
+    /**
+     * get the j-th master node id of the i-th hanging node
+     * @param i integer for i-th node
+     * @param j integer for j-th master
+     */
+    inline int getIthNodeJthMasterID(const int &i,const int &j)const{
+        return m_HangingMasterIDs[m_HangingMasterPtr[m_NodeHangingIDs[i-1]]+j-1];
+    }
+    /**
+     * get the weight of the j-th master node of the i-th hanging node
+     * @param i integer for i-th node
+     * @param j integer for j-th master
+     */
+    inline double getIthNodeJthMasterWeight(const int &i,const int &j)const{
+        return m_HangingMasterWeights[m_HangingMasterPtr[m_NodeHangingIDs[i-1]]+j-1];
+    }
+    /**
+     * replace the dofs of the hanging nodes by the same dofs of their masters, the result is sorted and unique,
+     * it gives the columns one element couples to once the hanging dofs are eliminated
+     * @param t_DofIDs the dof ids (start from 1)
+     * @param t_ExpandedDofIDs the expanded dof ids (start from 1)
+     */
+    void expandHangingDofIDs(const vector<int> &t_DofIDs,vector<int> &t_ExpandedDofIDs)const;
+
+    /**
+     * write the dofs map of current rank into the binary buffer
+     * @param writer the binary writer
+     */
+    void writeDofsMap(BinaryWriter &writer)const;
+    /**
+     * read the dofs map of current rank from the binary buffer, the fe cell's local elemental dof ids
+     * are reset as well, return false if the data is broken or inconsistent with the dofs block
+     * @param reader the binary reader
+     * @param t_fecell the fe cell class
+     */
+    bool readDofsMap(BinaryReader &reader,FECell &t_fecell);
+
     /**
      * release the memory
      */
@@ -362,6 +449,24 @@ public:
     void printBulkElementalDofsInfo(const bool &flag=false)const;
 
 
+private:
+    /**
+     * create the dofs map for the implicit structured grid, every node carries all the dofs, so the global
+     * maps are not stored, only the local elemental dof ids are created
+     * @param t_fecell the fe cell class
+     * @param t_elmtSystem the element class
+     */
+    void createImplicitBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmtSystem);
+    /**
+     * get the i-th element's j-th dof id from the implicit grid
+     * @param i integer for i-th elmt
+     * @param j integer for j-th dof
+     */
+    inline int getImplicitElmtDofID(const int &i,const int &j)const{
+        const int nodeid=m_ImplicitGrid.getIthBulkElmtJthNodeID(i,(j-1)/m_MaxDofsPerNode+1);
+        return (nodeid-1)*m_MaxDofsPerNode+(j-1)%m_MaxDofsPerNode+1;
+    }
+
 protected:
     vector<string> m_DofNameList;/**< vector for the name of dofs of each node */
     vector<int> m_DofIDList;/**< vecotr for the related dof id of each dof(name) */
@@ -379,4 +484,13 @@ protected:
     int m_MaxRowNNZ;/**< for the maximum nonzeros of row*/
     int m_MaxNNZ;/**< for the maximum nonzeros of the dof map */
 
+    vector<int> m_HangingNodeIDs;/**< the id of each hanging node */
+    vector<int> m_HangingMasterPtr;/**< the start position of each hanging node's masters */
+    vector<int> m_HangingMasterIDs;/**< the master node ids */
+    vector<double> m_HangingMasterWeights;/**< the weight of each master node */
+    vector<int> m_NodeHangingIDs;/**< the position of each node in the hanging node list, -1 for the free node */
+
+    bool m_IsImplicitDofsMap;/**< true if the dofs map is computed from the implicit structured grid */
+    ImplicitStructuredGrid m_ImplicitGrid;/**< the copy of the implicit structured grid */
+
 };
\ No newline at end of file
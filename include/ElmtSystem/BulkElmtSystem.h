@@ -117,6 +117,28 @@ public:
         }
         return m_ElmtBlockList[i-1];
     }
+    /**
+     * get the reference of the i-th bulk element block, it is used to override the material parameters in the ensemble run
+     * @param i integer for the block index, start from 1
+     */
+    inline ElmtBlock& getIthBulkElmtBlockRef(const int &i){
+        if(i<1||i>m_ElmtBlockNum){
+            MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of range for your bulk element block list");
+            MessagePrinter::exitAsFem();
+        }
+        return m_ElmtBlockList[i-1];
+    }
+    /**
+     * get the const reference of the i-th bulk element block, which avoids the copy of the json parameters
+     * @param i integer for the block index, start from 1
+     */
+    inline const ElmtBlock& getIthBulkElmtBlockRef(const int &i)const{
+        if(i<1||i>m_ElmtBlockNum){
+            MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of range for your bulk element block list");
+            MessagePrinter::exitAsFem();
+        }
+        return m_ElmtBlockList[i-1];
+    }
     /**
      * get the bulk element block vector
      */
@@ -18,6 +18,7 @@
 
 #include "ElmtSystem/ElmtType.h"
 #include "MateSystem/MateType.h"
+#include "FE/QPointType.h"
 #include "Utils/MessagePrinter.h"
 
 /**
@@ -44,6 +45,15 @@ public:
         m_MateType=MateType::NULLMATE;
 
         m_JsonParams.clear();
+        m_SinglePrecisionMateNames.clear();
+        m_UseBatchMate=true;
+        m_CheckBatchMate=false;
+
+        m_HasOwnQPoints=false;
+        m_QPointType=QPointType::GAUSSLEGENDRE;
+        m_QPointOrder=-1;
+        m_IsSelectiveReduced=false;
+        m_HourglassCoef=0.0;
     }
     /**
      * reset the content of current element block
@@ -64,6 +74,15 @@ public:
         m_MateType=MateType::NULLMATE;
 
         m_JsonParams.clear();
+        m_SinglePrecisionMateNames.clear();
+        m_UseBatchMate=true;
+        m_CheckBatchMate=false;
+
+        m_HasOwnQPoints=false;
+        m_QPointType=QPointType::GAUSSLEGENDRE;
+        m_QPointOrder=-1;
+        m_IsSelectiveReduced=false;
+        m_HourglassCoef=0.0;
     }
     /**
      * print out the information of current element block
@@ -84,10 +103,37 @@ public:
 
         MessagePrinter::printNormalTxt("  material type name = "+m_MateTypeName);
 
+        if(m_SinglePrecisionMateNames.size()>0){
+            str="";
+            for(const auto &it:m_SinglePrecisionMateNames) str+=it+" ";
+            MessagePrinter::printNormalTxt("  single-precision materials = "+str);
+        }
+        if(!m_UseBatchMate){
+            MessagePrinter::printNormalTxt("  batched material kernel = off");
+        }
+        else if(m_CheckBatchMate){
+            MessagePrinter::printNormalTxt("  batched material kernel = on, checked against the qpoint-by-qpoint one");
+        }
+
         str="";
         for(const auto &it:m_DomainNameList) str+=it+" ";
         MessagePrinter::printNormalTxt("  domain = "+str);
 
+        if(m_HasOwnQPoints){
+            str=m_QPointType==QPointType::GAUSSLOBATTO?"gauss-lobatto":"gauss-legendre";
+            if(m_QPointOrder>=0) str+=", order = "+to_string(m_QPointOrder);
+            MessagePrinter::printNormalTxt("  qpoints = "+str);
+        }
+        if(m_IsSelectiveReduced){
+            MessagePrinter::printNormalTxt("  volumetric terms = selective reduced (mean dilatation)");
+        }
+        if(m_HourglassCoef>0.0){
+            char buff[69];
+            snprintf(buff,69,"  hourglass coefficient = %14.5e",m_HourglassCoef);
+            str=buff;
+            MessagePrinter::printNormalTxt(str);
+        }
+
         if(m_JsonParams.size()>0){
             MessagePrinter::printNormalTxt("  parameters are:");
             char buff[69];
@@ -133,5 +179,14 @@ public:
     string m_MateTypeName;/**< string name for material type of current element */
     MateType m_MateType;/**< the type of material used in current element */
     nlohmann::json m_JsonParams;/**< json class for material paramters of current element */
+    vector<string> m_SinglePrecisionMateNames;/**< the materials whose qpoint values are stored in single precision */
+    bool m_UseBatchMate;/**< true if the batched material kernel is used when it is available */
+    bool m_CheckBatchMate;/**< true if the batched material results are checked against the qpoint-by-qpoint ones */
+    //*** for the block-wise integration rule
+    bool m_HasOwnQPoints;/**< true if current block defines its own bulk qpoints, otherwise the global one is used */
+    QPointType m_QPointType;/**< the qpoint type of current block */
+    int m_QPointOrder;/**< the qpoint order of current block, -1 means the global order is used */
+    bool m_IsSelectiveReduced;/**< true if the volumetric terms use the element averaged (mean dilatation) gradient */
+    double m_HourglassCoef;/**< the hourglass control coefficient for the single-point quad4/hex8 element */
 
 };
\ No newline at end of file
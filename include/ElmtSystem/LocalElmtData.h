@@ -42,6 +42,7 @@ struct LocalElmtInfo{
     int m_QpointsNum;/**< the total qpoints num of current element */
     int m_QpointID;/**< current qpoint id (local one) */
     double m_TempVal;/**< temp variables to store whatever required by users */
+    bool m_IsMeanDilatation=false;/**< true if the volumetric terms use the element averaged shape function gradients */
 };
 
 /**
@@ -55,6 +56,8 @@ struct LocalShapeFun{
     Vector3d m_GradTrial;/**< the gradient of the trial function for current gauss point*/
     Vector3d m_GradTestCurrent;/**< the gradient of the test function based on the current configuration for current gauss point*/
     Vector3d m_GradTrialCurrent;/**< the gradient of the trial function based on the current configuration for current gauss point*/
+    Vector3d m_GradTestMean;/**< the element averaged gradient of the test function, used by the mean dilatation */
+    Vector3d m_GradTrialMean;/**< the element averaged gradient of the trial function, used by the mean dilatation */
 
 };
 
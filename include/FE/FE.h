@@ -19,6 +19,7 @@
 #include "FE/ShapeFun.h"
 
 #include "FECell/FECell.h"
+#include "ElmtSystem/ElmtBlock.h"
 
 /**
  * This class implement the general function and management of both shape functions and qpoints classes
@@ -41,6 +42,35 @@ public:
      */
     void init(const FECell &t_FECell);
 
+    /**
+     * init the bulk qpoints of each element block, the block without its own 'qpoints' uses the global one,
+     * this must be called after init/initdefault
+     * @param t_BlockList the bulk element block list
+     * @param t_FECell the fe cell class
+     */
+    void initBlockQpoints(const vector<ElmtBlock> &t_BlockList,const FECell &t_FECell);
+    /**
+     * get the bulk qpoints of the i-th element block, i=0 means the element is not covered by any block,
+     * then the global bulk qpoints are returned
+     * @param i the block id, start from 1
+     */
+    inline const QPoint& getIthBlockBulkQpoints(const int &i)const{
+        if(i==0) return m_BulkQpoints;
+        if(i<0||i>static_cast<int>(m_BlockBulkQpoints.size())){
+            MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of range for the block qpoints list");
+            MessagePrinter::exitAsFem();
+        }
+        return m_BlockBulkQpoints[i-1];
+    }
+    /**
+     * get the maximum qpoints number of all the bulk element blocks, it is the stride of the qpoint materials
+     */
+    inline int getMaxBulkQPointsNum()const{return m_MaxBulkQPointsNum;}
+    /**
+     * return true if any element block uses a different rule from the global bulk qpoints
+     */
+    inline bool hasBlockQpoints()const{return m_HasBlockQpoints;}
+
     /**
      * get the maximum dim of FE space
      */
@@ -67,9 +97,12 @@ public:
     QPoint m_BulkQpoints;/**< gauss integration points for the bulk element */
     QPoint m_SurfaceQpoints;/**< gauss integration points for the surface element */
     QPoint m_LineQpoints;/**< gauss integration points for the line element */
+    vector<QPoint> m_BlockBulkQpoints;/**< gauss integration points for the bulk element of each element block */
 
 private:
     int m_MaxDim;/**< the max dimension of fe space */
     int m_MinDim;/**< the min dimension of fe space */
+    int m_MaxBulkQPointsNum;/**< the max qpoints number of all the bulk element blocks */
+    bool m_HasBlockQpoints;/**< true if any element block has its own bulk qpoints */
 
 };
\ No newline at end of file
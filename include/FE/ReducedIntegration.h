@@ -0,0 +1,106 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.21
+//+++ Purpose: the element averaged quantities for the selective
+//+++          reduced integration (mean dilatation) and the
+//+++          hourglass control of the single-point quad4/hex8
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <vector>
+
+#include "FE/QPoint.h"
+#include "FE/ShapeFun.h"
+#include "FECell/Nodes.h"
+#include "MathUtils/Vector3d.h"
+
+using std::vector;
+
+/**
+ * This class computes the element averaged shape function gradients, B_bar=int(grad(N))dV/V, which are used by
+ * the mean dilatation (selective reduced integration of the volumetric terms) and by the Flanagan-Belytschko
+ * hourglass control of the single-point quad4/hex8 element
+ */
+class ReducedIntegration{
+public:
+    /**
+     * constructor
+     */
+    ReducedIntegration();
+
+    /**
+     * compute the element averaged shape function gradients over the given qpoints
+     * @param t_Qpoints the qpoints of current element
+     * @param t_Shp the bulk shape functions
+     * @param t_Nodes the nodal coordinates of current element
+     * @param t_Dim the dimension of current element
+     * @param t_NodesNum the nodes number of current element
+     */
+    void computeMeanShapeGrad(const QPoint &t_Qpoints,ShapeFun &t_Shp,const Nodes &t_Nodes,const int &t_Dim,const int &t_NodesNum);
+    /**
+     * get the averaged shape function gradient of the i-th node
+     * @param i the node index, start from 1
+     */
+    inline const Vector3d& getIthMeanShapeGrad(const int &i)const{return m_MeanShapeGrad[i-1];}
+    /**
+     * get the volume of current element
+     */
+    inline double getVolume()const{return m_Volume;}
+    /**
+     * get the element averaged dilatation, div(u), of a nodal displacement field
+     * @param u the nodal displacement, the k-th component of the i-th node is stored in u[(i-1)*3+k-1]
+     */
+    double getMeanDilatation(const double *u)const;
+    /**
+     * replace the volumetric part of the qpoint displacement gradient by the mean dilatation, grad(u)_kk+=(div_bar-div(u))/dim
+     * @param t_MeanDiv the mean dilatation of current sub element
+     * @param t_DispNum the number of the displacement components
+     * @param t_Dim the dimension of current element
+     * @param t_GradU the displacement gradient, the gradient of the k-th component is stored in t_GradU[k]
+     */
+    static void applyMeanDilatation(const double &t_MeanDiv,const int &t_DispNum,const int &t_Dim,vector<Vector3d> &t_GradU){
+        double div=0.0;
+        for(int k=1;k<=t_DispNum;k++) div+=t_GradU[k](k);
+        for(int k=1;k<=t_DispNum;k++) t_GradU[k](k)+=(t_MeanDiv-div)/t_Dim;
+    }
+
+    /**
+     * compute the hourglass shape vectors gamma=(h-(h.x)B_bar)/2^dim, computeMeanShapeGrad must be called before
+     * @param t_MeshType the mesh type, only quad4 and hex8 are supported
+     * @param t_Nodes the nodal coordinates of current element
+     */
+    void computeHourglassVectors(const MeshType &t_MeshType,const Nodes &t_Nodes);
+    /**
+     * get the number of hourglass modes, 1 for quad4 and 4 for hex8
+     */
+    inline int getHourglassModesNum()const{return m_HourglassModesNum;}
+    /**
+     * get the gamma of the j-th node for the i-th hourglass mode
+     * @param i the mode index, start from 1
+     * @param j the node index, start from 1
+     */
+    inline double getIthModeJthNodeGamma(const int &i,const int &j)const{return m_Gamma[(i-1)*m_NodesNum+j-1];}
+    /**
+     * get the hourglass stiffness k=coef*C*V*(B_bar:B_bar), where C is the maximum diagonal stiffness of the material
+     * @param t_Coef the hourglass control coefficient, 0.01~0.1 is usually enough
+     * @param t_Modulus the material stiffness C
+     */
+    double getHourglassStiffness(const double &t_Coef,const double &t_Modulus)const;
+
+private:
+    int m_Dim;/**< the dimension of current element */
+    int m_NodesNum;/**< the nodes number of current element */
+    double m_Volume;/**< the volume of current element */
+    vector<Vector3d> m_MeanShapeGrad;/**< the element averaged shape function gradients */
+    int m_HourglassModesNum;/**< the number of hourglass modes */
+    vector<double> m_Gamma;/**< the hourglass shape vectors, stored in [(mode-1)*nodes+node-1] */
+};
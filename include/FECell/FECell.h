@@ -25,7 +25,11 @@
 
 
 #include "Utils/MessagePrinter.h"
+#include "Utils/BinaryStream.h"
 #include "FECell/FECellData.h"
+#include "FECell/ImplicitStructuredGrid.h"
+#include "FECell/FECellReorder.h"
+#include "FECell/FECellAdaptivity.h"
 
 
 using std::vector;
@@ -157,6 +161,7 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of the bulk element number's range");
             MessagePrinter::exitAsFem();
         }
+        if(m_CellData.IsImplicitGrid) return m_ImplicitGrid.getBulkElmtVTKCellType();
         return m_CellData.MeshCell_Total[i-1].VTKCellType;
     }
     /**
@@ -168,6 +173,7 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of bulk elements number range, can\'t get the partition id for it");
             MessagePrinter::exitAsFem();
         }
+        if(m_CellData.IsImplicitGrid) return m_ImplicitGrid.getNodesNumPerBulkElmt();
         return m_CellData.MeshCell_Total[i-1].NodesNumPerElmt;
     }
     /**
@@ -184,6 +190,7 @@ public:
             MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of bulk elements nodes number range, can\'t get the node id for it");
             MessagePrinter::exitAsFem();
         }
+        if(m_CellData.IsImplicitGrid) return m_ImplicitGrid.getIthBulkElmtJthNodeID(i,j);
         return m_CellData.MeshCell_Total[i-1].ElmtConn[j-1];
     }
     /**
@@ -195,6 +202,7 @@ public:
             MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of bulk elements number range, can\'t get the partition id for it");
             MessagePrinter::exitAsFem();
         }
+        if(m_CellData.IsImplicitGrid) return m_ImplicitGrid.getIthBulkElmtRankID(i,static_cast<int>(m_CellData.RanksElmtsNum_Global.size()));
         return m_CellData.BulkCellPartionInfo_Global[i-1];
     }
     /**
@@ -237,6 +245,7 @@ public:
             MessagePrinter::printErrorTxt("j="+to_string(j)+" is out of NodeCoords range");
             MessagePrinter::exitAsFem();
         }
+        if(m_CellData.IsImplicitGrid) return m_ImplicitGrid.getIthNodeJthCoord(i,j);
         return m_CellData.NodeCoords_Global[(i-1)*3+j-1];
     }
 
@@ -248,6 +257,10 @@ public:
      * Get the reference of the local bulk mesh cell vector
      */
     inline vector<SingleMeshCell>& getLocalBulkFECellVecRef(){return m_CellData.MeshCell_Local;}
+    /**
+     * Get the const reference of the local bulk mesh cell vector
+     */
+    inline const vector<SingleMeshCell>& getLocalBulkFECellVecRef()const{return m_CellData.MeshCell_Local;}
 
     /**
      * Get the copy of local physical id to fe cell vector mapping
@@ -290,6 +303,17 @@ public:
         }
         return vector<SingleMeshCell>(0);
     }
+    /**
+     * get the reference of the local cell vector via its physical name
+     * @param phyname the string name of the physical group
+     */
+    inline const vector<SingleMeshCell>& getLocalMeshCellVectorRefViaPhyName(const string &phyname)const{
+        if (!m_CellData.PhyName2MeshCellVectorMap_Local.count(phyname)) {
+            MessagePrinter::printErrorTxt("phyname="+phyname+" does not exist in your local mesh cell vector, please check your mesh file");
+            MessagePrinter::exitAsFem();
+        }
+        return m_CellData.PhyName2MeshCellVectorMap_Local.at(phyname);
+    }
     /**
      * Get the copy of the local physical name to fe cell vector mapping
      */
@@ -349,6 +373,11 @@ public:
      * @param name the physical name
      */
     inline vector<int> getFECellBulkElmtIDSetViaPhyName(const string &name)const{
+        if(m_CellData.IsImplicitGrid&&name=="alldomain"){
+            vector<int> ids(m_CellData.BulkElmtsNum);
+            for(int e=1;e<=m_CellData.BulkElmtsNum;e++) ids[e-1]=e;
+            return ids;
+        }
         if(m_CellData.PhyName2BulkFECellIDMap_Global.count(name)){
             return m_CellData.PhyName2BulkFECellIDMap_Global.at(name);
         }
@@ -360,6 +389,17 @@ public:
      * Get the mesh order of bulk elements
      */
     inline int getFECellBulkMeshOrder()const{return m_CellData.MeshOrder;}
+    /**
+     * return true if the mesh comes from the built-in generators, whose nodes form a structured lattice
+     */
+    inline bool isStructuredGrid()const{return m_CellData.IsStructuredGrid;}
+    /**
+     * Get the elements number of the built-in mesh along one axis
+     * @param i the axis, 1 for x, 2 for y and 3 for z
+     */
+    inline int getFECellElmtsNumAlongAxis(const int &i)const{
+        return i==1?m_CellData.Nx:(i==2?m_CellData.Ny:m_CellData.Nz);
+    }
     /**
      * Get the dim of elements via its physical name
      * @param name string for the physical name 
@@ -455,11 +495,92 @@ public:
      * @param methodname
      */
     void setMeshDistributionMethod(const string &methodname){MeshDistributionMethod=methodname;}
+    /**
+     * get the name of the mesh distribution method
+     */
+    inline string getMeshDistributionMethod()const{return MeshDistributionMethod;}
+    /**
+     * setup the reordering of the global mesh, which is applied before the distribution
+     * @param t_ElmtType the reorder type of the bulk elements
+     * @param t_NodeType the reorder type of the nodes (and the dofs)
+     */
+    void setMeshReorderMethod(const MeshReorderType &t_ElmtType,const MeshReorderType &t_NodeType){
+        m_ElmtReorderType=t_ElmtType;
+        m_NodeReorderType=t_NodeType;
+    }
+    /**
+     * return true if the bulk elements or nodes are reordered, only valid on the master rank
+     */
+    inline bool isMeshReordered()const{
+        return m_CellData.BulkElmtOrigIDs_Global.size()||m_CellData.NodeOrigIDs_Global.size();
+    }
+    /**
+     * get the original id (before the reordering) of the i-th node, only valid on the master rank
+     * @param i the node id, start from 1
+     */
+    inline int getFECellIthNodeOrigID(const int &i)const{
+        return m_CellData.NodeOrigIDs_Global.empty()?i:m_CellData.NodeOrigIDs_Global[i-1];
+    }
+    /**
+     * get the original id (before the reordering) of the i-th bulk element, only valid on the master rank
+     * @param i the element id, start from 1
+     */
+    inline int getFECellIthBulkElmtOrigID(const int &i)const{
+        return m_CellData.BulkElmtOrigIDs_Global.empty()?i:m_CellData.BulkElmtOrigIDs_Global[i-1];
+    }
+    /**
+     * setup the implicit structured grid for the built-in linear mesh, the global connectivity and coordinates
+     * are not created, return false if the mesh type is not supported
+     */
+    bool createImplicitGrid();
+    /**
+     * return true if current fe cell is an implicit structured grid
+     */
+    inline bool isImplicitGrid()const{return m_CellData.IsImplicitGrid;}
+    /**
+     * get the reference of the implicit structured grid
+     */
+    inline const ImplicitStructuredGrid& getImplicitGridRef()const{return m_ImplicitGrid;}
     /**
      * distribute the mesh cell into each mpi rank
      * @param distmethodname the name of the distribution method
      */
     void distributeMesh();
+    /**
+     * set the cost weight of each bulk element before the distribution, only the master rank stores it,
+     * an empty vector means all the elements have the same cost
+     * @param t_Weights the weight vector of all the bulk elements
+     */
+    void setBulkElmtWeights(const vector<double> &t_Weights);
+    /**
+     * re-partition the bulk elements by their measured cost and migrate the mesh cells to the new owners,
+     * the physical group cells for the boundary conditions are not changed. Return false if the partition is not changed.
+     * @param t_LocalCost the cost of each local bulk element, in the same order as the local mesh cells
+     * @param t_OldPartInfo the partition info before the rebalance, which is used to migrate the other local data
+     */
+    bool rebalanceBulkElmts(const vector<double> &t_LocalCost,vector<int> &t_OldPartInfo);
+    /**
+     * get the partition info (the 0-based rank id of each bulk element), which is shared by all the ranks
+     */
+    inline const vector<int>& getBulkElmtsPartInfo()const{return m_CellData.BulkCellPartionInfo_Global;}
+    /**
+     * refine and coarsen the bulk elements by the nodal values of one dof, the new mesh is rebuilt on the master rank
+     * and distributed again. Return false if the mesh is not changed.
+     * @param t_NodalValues the nodal values of the marked dof, only used on the master rank
+     * @param t_Marker the marker type
+     * @param t_Refine the refine threshold
+     * @param t_Coarsen the coarsen threshold
+     * @param t_MaxLevel the maximum refinement level
+     * @param t_Transfer the mapping between the old and new mesh, the nodal part is shared among ranks,
+     *        the elemental part is only stored on the master rank
+     */
+    bool adaptMesh(const vector<double> &t_NodalValues,const MeshAdaptMarkerType &t_Marker,
+                   const double &t_Refine,const double &t_Coarsen,const int &t_MaxLevel,
+                   MeshTransferData &t_Transfer);
+    /**
+     * return true if the mesh has hanging nodes
+     */
+    inline bool hasHangingNodes()const{return !m_CellData.HangingNodeIDs_Global.empty();}
 
 
     /**
@@ -479,6 +600,29 @@ public:
      */
     void printMeshInfo()const;
 
+    /**
+     * write the fe cell data of current rank (after the distribution) into the binary buffer
+     * @param writer the binary writer
+     */
+    void writeCellData(BinaryWriter &writer)const;
+    /**
+     * read the fe cell data of current rank from the binary buffer, return false if the data is broken
+     * @param reader the binary reader
+     */
+    bool readCellData(BinaryReader &reader);
+    /**
+     * write one mesh cell into the binary buffer
+     * @param writer the binary writer
+     * @param cell the mesh cell to be written
+     */
+    static void writeSingleMeshCell(BinaryWriter &writer,const SingleMeshCell &cell);
+    /**
+     * read one mesh cell from the binary buffer, return false if the data is broken
+     * @param reader the binary reader
+     * @param cell the mesh cell to be read
+     */
+    static bool readSingleMeshCell(BinaryReader &reader,SingleMeshCell &cell);
+
     /**
      * release the allocated memory
      */
@@ -486,7 +630,11 @@ public:
 
 private:
     FECellData m_CellData;/**< the FE cell data structure of the whole system */
+    ImplicitStructuredGrid m_ImplicitGrid;/**< the implicit structured grid, only used if IsImplicitGrid is true */
 
     string MeshDistributionMethod;/**< the name of the mesh distribution method */
+    MeshReorderType m_ElmtReorderType;/**< the reorder type of the bulk elements */
+    MeshReorderType m_NodeReorderType;/**< the reorder type of the nodes */
+    FECellAdaptivity m_Adaptivity;/**< the refinement forest of the adaptive mesh, only used on the master rank */
 
 };
\ No newline at end of file
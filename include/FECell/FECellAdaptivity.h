@@ -0,0 +1,187 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.17
+//+++ Purpose: the quadtree/octree of the adaptive h-refinement
+//+++          and coarsening for quad4 and hex8 mesh
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+
+#include "Utils/MessagePrinter.h"
+#include "FECell/FECellData.h"
+
+using std::vector;
+using std::map;
+using std::string;
+
+/**
+ * the error indicator used to mark the elements
+ */
+enum class MeshAdaptMarkerType{
+    GRADIENT,
+    VALUE
+};
+
+/**
+ * The mapping between the mesh before and after one adaptation, it is used to transfer the solution vectors
+ * and the qpoint history. All the ids start from 1.
+ */
+struct MeshTransferData{
+    int Dim=0;/**< the dimension of the bulk elements */
+    vector<int> NodeSrcPtr;/**< the start position of the source nodes of each new node */
+    vector<int> NodeSrcIDs;/**< the old node ids, a new node is interpolated from them */
+    vector<double> NodeSrcWeights;/**< the interpolation weight of each source node */
+    vector<int> ElmtSrcPtr;/**< the start position of the source elements of each new element */
+    vector<int> ElmtSrcIDs;/**< the old element ids, which overlap with the new element */
+    vector<double> ElmtSrcMaps;/**< the affine map xi_old=a*xi+b_k of each source, 4 values (a,b_1,b_2,b_3) for each */
+};
+
+/**
+ * This class implements the non-conforming h-refinement of the quad4 and hex8 mesh. The refinement history
+ * is stored as a forest whose roots are the elements of the original mesh, each refinement splits one element
+ * into 2^dim children and the coarsening merges them back. The 2:1 balance is kept across the edges, so each
+ * hanging node has at most one level difference to its masters. The forest only lives on the master rank.
+ */
+class FECellAdaptivity{
+public:
+    /**
+     * constructor
+     */
+    FECellAdaptivity();
+
+    /**
+     * return true if the forest is built from the mesh
+     */
+    inline bool isInitialized()const{return m_IsInitialized;}
+    /**
+     * build the forest from the current global mesh, it only works on the master rank
+     * @param t_CellData the fe cell data
+     */
+    void init(const FECellData &t_CellData);
+    /**
+     * compute the refine(1)/coarsen(-1)/keep(0) flag of each bulk element from the nodal values
+     * @param t_CellData the fe cell data
+     * @param t_NodalValues the value of the marked dof on each node
+     * @param t_Marker the marker type
+     * @param t_Refine the refine threshold, which is a fraction of the max indicator for the gradient marker
+     * @param t_Coarsen the coarsen threshold, which is a fraction of the max indicator for the gradient marker
+     * @param t_Marks the flag of each bulk element
+     */
+    void markElmts(const FECellData &t_CellData,const vector<double> &t_NodalValues,
+                   const MeshAdaptMarkerType &t_Marker,const double &t_Refine,const double &t_Coarsen,
+                   vector<int> &t_Marks)const;
+    /**
+     * refine and coarsen the marked elements, then rebuild the global mesh in the fe cell data, return false if
+     * the mesh is not changed
+     * @param t_Marks the flag of each bulk element
+     * @param t_MaxLevel the maximum refinement level
+     * @param t_CellData the fe cell data
+     * @param t_Transfer the mapping between the old and new mesh
+     */
+    bool adaptMesh(const vector<int> &t_Marks,const int &t_MaxLevel,FECellData &t_CellData,MeshTransferData &t_Transfer);
+
+    /**
+     * release the forest
+     */
+    void releaseMemory();
+
+private:
+    /**
+     * one cell of the forest
+     */
+    struct AdaptCell{
+        int Level=0;/**< the refinement level, 0 for the root */
+        int Parent=-1;/**< the parent cell, -1 for the root */
+        int RootID=0;/**< the bulk element id of the root in the original mesh */
+        int Offset=0;/**< the bits of the child position in its parent, bit-k for the k-th axis */
+        vector<int> Children;/**< the children cells, empty if it is never refined */
+        vector<int> Nodes;/**< the node ids of the pool */
+        vector<vector<int>> FacePhyIDs;/**< the boundary physical ids of each face */
+        double Volume=0.0;/**< the volume */
+        bool IsActive=true;/**< true if it is a leaf of current mesh */
+        int ExportID=0;/**< the bulk element id of current mesh, 0 if it is not active */
+    };
+
+    /**
+     * get the node id of one lattice point of a cell, the point of a new node is created if needed
+     * @param t_Cell the cell id
+     * @param t_Point the lattice point, each coordinate is 0, 1 or 2
+     */
+    int getLatticeNode(const int &t_Cell,const int (&t_Point)[3]);
+    /**
+     * find the node whose parents are the given nodes, return 0 if it doesn't exist
+     * @param t_Parents the parent node ids
+     */
+    int findNode(vector<int> t_Parents)const;
+    /**
+     * return true if the node exists and is used by the active cells
+     * @param t_Parents the parent node ids
+     */
+    bool isNodeUsed(const vector<int> &t_Parents)const;
+    /**
+     * split one active cell into its children
+     * @param t_Cell the cell id
+     */
+    void refineCell(const int &t_Cell);
+    /**
+     * merge the children of one cell back
+     * @param t_Cell the cell id
+     */
+    void coarsenCell(const int &t_Cell);
+    /**
+     * return true if one edge of the active cell is split twice by its neighbours
+     * @param t_Cell the cell id
+     */
+    bool isCellUnbalanced(const int &t_Cell)const;
+    /**
+     * collect the active cells in the tree order
+     * @param t_Cell the cell id
+     * @param t_Cells the active cell list
+     */
+    void collectActiveCells(const int &t_Cell,vector<int> &t_Cells)const;
+    /**
+     * return true if the pool node belongs to the nodal set
+     * @param t_Node the pool node id
+     * @param t_Set the flag of each pool node, 0 for unknown, 1 for inside and -1 for outside
+     */
+    bool isNodeInSet(const int &t_Node,vector<int> &t_Set)const;
+    /**
+     * write the active cells into the fe cell data and compute the hanging node constraints
+     * @param t_CellData the fe cell data
+     */
+    void exportMesh(FECellData &t_CellData);
+
+private:
+    bool m_IsInitialized;/**< true if the forest is ready */
+    int m_Dim;/**< the dimension of the bulk elements */
+    int m_ChildrenNum;/**< 2^dim */
+    int m_FacesNum;/**< 2*dim */
+    int m_RootsNum;/**< the number of root cells */
+    MeshType m_BulkMeshType;/**< the mesh type of the bulk elements */
+    MeshType m_FaceMeshType;/**< the mesh type of the boundary faces */
+
+    vector<AdaptCell> m_Cells;/**< all the cells of the forest, the roots come first */
+    vector<double> m_NodeCoords;/**< the coordinates of the pool nodes */
+    vector<vector<int>> m_NodeParents;/**< the sorted parent ids of each created node, empty for the original nodes */
+    vector<int> m_NodeUseCount;/**< the number of active cells which use each node */
+    vector<int> m_NodeExportID;/**< the node id of current mesh, 0 if the node is not used */
+    map<vector<int>,int> m_Parents2NodeMap;/**< the created node of each parent set */
+
+    vector<SingleMeshCell> m_RootCells;/**< the bulk cells of the original mesh, only the physical info is used */
+    vector<vector<int>> m_RootBulkPhyIDs;/**< the bulk physical ids of each root cell */
+    vector<vector<string>> m_RootBulkPhyNames;/**< the bulk physical names of each root cell */
+    map<int,vector<SingleMeshCell>> m_LowerDimCells;/**< the lower dimension cells (dim<maxdim-1), the node ids are pool ids */
+    map<string,vector<int>> m_NodalSets;/**< the pool node ids of each nodal physical group */
+};
@@ -66,6 +66,8 @@ struct FECellData{
     int Nx;/**< elements num along x-axis */
     int Ny;/**< elements num along y-axis */
     int Nz;/**< elements num along z-axis */
+    bool IsImplicitGrid;/**< true if the built-in structured mesh is not stored, but computed from nx/ny/nz */
+    bool IsStructuredGrid;/**< true if the mesh comes from the built-in generators, the nodes are ordered along x, then y and z */
 
     vector<double> NodeCoords_Global;/**< the nodal coordinates of all the mesh point, which is only stored in master rank */
 
@@ -110,5 +112,16 @@ struct FECellData{
     //*** for partition message
     vector<int> BulkCellPartionInfo_Global;/**< the partition info of the bulk fe cell */
     vector<int> RanksElmtsNum_Global;/**< this vector stores the number of bulk elmts owned by each rank */
+    vector<double> BulkElmtWeights_Global;/**< the cost weight of each bulk element (only on master rank), empty means uniform weights */
+
+    //*** for the mesh reordering
+    vector<int> BulkElmtOrigIDs_Global;/**< the original id of each bulk element before the reordering (only on master rank), empty if not reordered */
+    vector<int> NodeOrigIDs_Global;/**< the original id of each node before the reordering (only on master rank), empty if not reordered */
+
+    //*** for the hanging nodes of the adapted mesh, shared among ranks
+    vector<int> HangingNodeIDs_Global;/**< the id of each hanging node, empty if the mesh is conforming */
+    vector<int> HangingNodeMasterPtr_Global;/**< the start position of each hanging node's masters, the size is the hanging nodes number + 1 */
+    vector<int> HangingNodeMasterIDs_Global;/**< the master node ids of all the hanging nodes */
+    vector<double> HangingNodeMasterWeights_Global;/**< the interpolation weight of each master node */
 
 };
\ No newline at end of file
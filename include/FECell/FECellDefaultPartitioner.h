@@ -24,4 +24,13 @@ public:
      * @param t_CellData the fecell data 
      */
     virtual void partitionFECell(FECellData &t_CellData) override;
+
+    /**
+     * split the bulk elements into contiguous chunks with nearly the same total weight,
+     * each rank owns at least one element if there are enough elements
+     * @param t_Weights the weight of each bulk element
+     * @param t_RanksNum the number of ranks
+     * @param t_RankOffsets the 0-based start index of each rank, the size is t_RanksNum+1
+     */
+    static void splitElmtsByWeights(const vector<double> &t_Weights,const int &t_RanksNum,vector<int> &t_RankOffsets);
 };
\ No newline at end of file
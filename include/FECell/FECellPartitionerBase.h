@@ -27,4 +27,13 @@ public:
      * @param t_celldata the fecell data 
      */
     virtual void partitionFECell(FECellData &t_celldata)=0;
+
+protected:
+    /**
+     * distribute the partitioned fe cell from master rank to all the ranks, the shared info is broadcast
+     * and the local cells of each rank are packed into one buffer, this must be called on all the ranks
+     * @param t_CellData the fecell data, the BulkCellPartionInfo_Global and RanksElmtsNum_Global must be ready on master rank
+     * @param t_RankCells the bulk cells owned by each rank, only used on master rank
+     */
+    void distributeFECell(FECellData &t_CellData,vector<vector<SingleMeshCell>> &t_RankCells);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.15
+//+++ Purpose: renumber the bulk elements and nodes of the global
+//+++          mesh for a better memory locality, i.e., along the
+//+++          space filling curve or by reverse Cuthill-McKee
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <cstdint>
+
+#include "Utils/MessagePrinter.h"
+#include "FECell/FECellData.h"
+
+/**
+ * the ordering method of the bulk elements or nodes
+ */
+enum class MeshReorderType{
+    NONE,
+    MORTON,
+    HILBERT,
+    RCM
+};
+
+/**
+ * This class renumbers the global mesh on the master rank before the partition, the element order decides
+ * the local element order of each rank, and the node order decides the dofs numbering (and the matrix bandwidth)
+ */
+class FECellReorder{
+public:
+    /**
+     * get the reorder type from its name, return false if the name is invalid
+     * @param t_name the name, i.e., none, morton, hilbert, rcm
+     * @param t_type the reorder type
+     */
+    static bool getReorderTypeFromName(const string &t_name,MeshReorderType &t_type);
+    /**
+     * get the name of the reorder type
+     * @param t_type the reorder type
+     */
+    static string getReorderTypeName(const MeshReorderType &t_type);
+
+    /**
+     * renumber the bulk elements and nodes of the global mesh, it only works on the master rank
+     * @param t_ElmtType the reorder type of the bulk elements, rcm is not supported for elements
+     * @param t_NodeType the reorder type of the nodes
+     * @param t_CellData the fe cell data
+     */
+    static void reorderFECell(const MeshReorderType &t_ElmtType,const MeshReorderType &t_NodeType,FECellData &t_CellData);
+
+    /**
+     * compute the ordering of the points along the space filling curve
+     * @param t_Coords the coordinates of the points, 3 values for each point
+     * @param t_Dim the dimension of the points
+     * @param t_Type the curve type, morton or hilbert
+     * @param t_Order the old index (0-based) of the i-th point in the new order
+     */
+    static void computeCurveOrder(const vector<double> &t_Coords,const int &t_Dim,const MeshReorderType &t_Type,vector<int> &t_Order);
+    /**
+     * compute the reverse Cuthill-McKee ordering of a graph
+     * @param t_Adjacency the 0-based neighbours of each vertex
+     * @param t_Order the old index (0-based) of the i-th vertex in the new order
+     */
+    static void computeRCMOrder(const vector<vector<int>> &t_Adjacency,vector<int> &t_Order);
+
+private:
+    /**
+     * compute the key of one point along the space filling curve
+     * @param t_X the integer coordinates, each one has t_Bits bits
+     * @param t_Dim the dimension
+     * @param t_Bits the number of bits of each coordinate
+     * @param t_Type the curve type, morton or hilbert
+     */
+    static uint64_t computeCurveKey(uint32_t (&t_X)[3],const int &t_Dim,const int &t_Bits,const MeshReorderType &t_Type);
+};
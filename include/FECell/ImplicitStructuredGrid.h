@@ -0,0 +1,151 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.08
+//+++ Purpose: the implicit structured grid for the built-in
+//+++          linear mesh (edge2/quad4/hex8), the connectivity,
+//+++          coordinates and boundary sets are computed from the
+//+++          (i,j,k) index instead of being stored
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "FECell/FECellData.h"
+
+/**
+ * This class describes the built-in structured mesh by its nx/ny/nz and bounding box only. The node and element
+ * numbering is exactly the same as the one of the Lagrange mesh cell generators, so the global mesh never needs to be
+ * stored on the master rank, each rank only creates its own local cells.
+ */
+class ImplicitStructuredGrid{
+public:
+    /**
+     * constructor
+     */
+    ImplicitStructuredGrid();
+
+    /**
+     * check whether the given mesh type can be described by the implicit grid (edge2, quad4 and hex8 only)
+     * @param meshtype the bulk mesh type
+     */
+    static bool isMeshTypeSupported(const MeshType &meshtype);
+
+    /**
+     * setup the grid from the mesh info of the cell data, and fill the mesh scalars and the physical group info
+     * of the cell data (on all the ranks), the global cells and coordinates are not created
+     * @param t_celldata the fe cell data structure
+     */
+    bool init(FECellData &t_celldata);
+    /**
+     * create the local bulk cells, boundary cells, nodal sets and node ids of current rank, the cells are split in the
+     * same way as the built-in 'asfem' partitioner, no communication is required
+     * @param t_celldata the fe cell data structure
+     */
+    void createLocalFECell(FECellData &t_celldata)const;
+
+    /**
+     * get the nodes number
+     */
+    inline int getNodesNum()const{return m_NodesNum;}
+    /**
+     * get the bulk elements number
+     */
+    inline int getBulkElmtsNum()const{return m_BulkElmtsNum;}
+    /**
+     * get the nodes number of each bulk element
+     */
+    inline int getNodesNumPerBulkElmt()const{return m_NodesNumPerBulkElmt;}
+    /**
+     * get the vtk cell type of the bulk element
+     */
+    inline int getBulkElmtVTKCellType()const{return m_BulkElmtVTKCellType;}
+    /**
+     * get the i-th node's j-th coordinate
+     * @param i the node id, start from 1
+     * @param j the component, 1->x, 2->y, 3->z
+     */
+    inline double getIthNodeJthCoord(const int &i,const int &j)const{
+        const int ix=(i-1)%(m_Nx+1);
+        if(j==1) return m_Xmin+ix*m_Dx;
+        if(m_Dim==1) return (j==2)?m_Ymin+ix*m_Dy:m_Zmin+ix*m_Dz;
+        const int iy=((i-1)/(m_Nx+1))%(m_Ny+1);
+        if(j==2) return m_Ymin+iy*m_Dy;
+        if(m_Dim==2) return 0.0;
+        return m_Zmin+((i-1)/((m_Nx+1)*(m_Ny+1)))*m_Dz;
+    }
+    /**
+     * get the i-th bulk element's j-th node id
+     * @param i the element id, start from 1
+     * @param j the local node index, start from 1
+     */
+    inline int getIthBulkElmtJthNodeID(const int &i,const int &j)const{
+        const int ix=(i-1)%m_Nx;
+        const int iy=((i-1)/m_Nx)%m_Ny;
+        const int iz=(i-1)/(m_Nx*m_Ny);
+        return iz*(m_Nx+1)*(m_Ny+1)+iy*(m_Nx+1)+ix+1+m_NodeOffset[j-1];
+    }
+    /**
+     * get the rank id of the i-th bulk element, which follows the built-in 'asfem' partitioner
+     * @param i the element id, start from 1
+     * @param size the number of ranks (the mesh is not distributed yet if it is zero)
+     */
+    inline int getIthBulkElmtRankID(const int &i,const int &size)const{
+        if(size<2) return 0;
+        const int ranksize=m_BulkElmtsNum/size;
+        if(ranksize<1) return size-1;
+        return std::min((i-1)/ranksize,size-1);
+    }
+
+private:
+    /**
+     * get the elements number of the given side
+     * @param side the side index, 0->left, 1->right, 2->bottom, 3->top, 4->back, 5->front
+     */
+    int getSideElmtsNum(const int &side)const;
+    /**
+     * get the nodes number of the given side
+     * @param side the side index
+     */
+    int getSideNodesNum(const int &side)const;
+    /**
+     * get the i-th node id (in ascending order) of the given side
+     * @param side the side index
+     * @param i the index of the node on current side, start from 0
+     */
+    int getSideIthNodeID(const int &side,const int &i)const;
+    /**
+     * create the i-th bulk cell
+     * @param e the element id, start from 1
+     * @param cell the mesh cell to be filled
+     */
+    void createBulkCell(const int &e,SingleMeshCell &cell)const;
+    /**
+     * create the i-th boundary cell of the given side, the order is the same as the one of the mesh generators
+     * @param side the side index
+     * @param i the index of the cell on current side, start from 0
+     * @param cell the mesh cell to be filled
+     */
+    void createSideCell(const int &side,const int &i,SingleMeshCell &cell)const;
+    /**
+     * compute the local range of current rank, same as the built-in partitioner
+     */
+    static void getLocalRange(const int &datasize,const int &size,const int &rank,int &iStart,int &iEnd);
+
+private:
+    int m_Dim;/**< the dimension of the grid */
+    int m_Nx,m_Ny,m_Nz;/**< the elements number along each axis */
+    double m_Xmin,m_Ymin,m_Zmin;/**< the lower corner of the domain */
+    double m_Dx,m_Dy,m_Dz;/**< the element size along each axis */
+    int m_NodesNum;/**< the nodes number */
+    int m_BulkElmtsNum;/**< the bulk elements number */
+    int m_NodesNumPerBulkElmt;/**< the nodes number of each bulk element */
+    int m_BulkElmtVTKCellType;/**< the vtk cell type of the bulk element */
+    int m_NodeOffset[8];/**< the node id offset of each local node from the first node of the element */
+};
@@ -32,12 +32,6 @@ protected:
     virtual bool importMeshFile(const string &filename,FECellData &t_celldata) override;
 
 private:
-    /**
-     * get the maximum dimension of the bulk mesh from msh file
-     * @param filename the msh file name
-     */
-    int getMaxMeshDim(const string &filename)const;
-
     /**
      * get the maximum dimension of the bulk mesh from msh file
      * @param entityDim the dimension of current entity
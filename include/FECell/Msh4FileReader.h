@@ -0,0 +1,223 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.02
+//+++ Purpose: the memory-mapped reader of the msh (version-4.1)
+//+++          file, both ascii and binary format are supported
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "Utils/MessagePrinter.h"
+
+using std::string;
+using std::vector;
+
+/**
+ * the physical group defined in the $PhysicalNames block
+ */
+struct Msh4PhysicalName{
+    int m_Dim=0;/**< the dimension of the physical group */
+    int m_ID=0;/**< the physical id */
+    string m_Name;/**< the physical name, without '"' */
+};
+
+/**
+ * the node entity block of the $Nodes section
+ */
+struct Msh4NodeBlock{
+    int m_EntityDim=0;/**< the dimension of the entity */
+    int m_EntityTag=0;/**< the tag of the entity */
+    int m_Parametric=0;/**< 1 if the parametric coordinates are given */
+    size_t m_NodesNum=0;/**< the number of nodes in this block */
+    size_t m_TagsOffset=0;/**< the byte offset of the node tags in the file */
+    size_t m_CoordsOffset=0;/**< the byte offset of the node coordinates in the file */
+    vector<size_t> m_TagsChunkOffsets;/**< the byte offsets of each chunk of node tags (ascii only) */
+    vector<size_t> m_CoordsChunkOffsets;/**< the byte offsets of each chunk of node coordinates (ascii only) */
+    vector<int> m_NodeTags;/**< the node tags */
+    vector<double> m_Coords;/**< the node coordinates, 3 per node */
+};
+
+/**
+ * the element entity block of the $Elements section
+ */
+struct Msh4ElmtBlock{
+    int m_EntityDim=0;/**< the dimension of the entity */
+    int m_EntityTag=0;/**< the tag of the entity */
+    int m_ElmtType=0;/**< the gmsh element type */
+    int m_NodesPerElmt=0;/**< the nodes number of each element */
+    size_t m_ElmtsNum=0;/**< the number of elements in this block */
+    size_t m_Offset=0;/**< the byte offset of the first element in the file */
+    vector<size_t> m_ChunkOffsets;/**< the byte offsets of each chunk of elements (ascii only) */
+    vector<int> m_ElmtTags;/**< the element tags */
+    vector<int> m_Conn;/**< the element connectivity, m_NodesPerElmt per element */
+};
+
+/**
+ * This class maps the msh4 file into memory and parses the $MeshFormat, $PhysicalNames, $Entities,
+ * $Nodes and $Elements sections without copying the file content. The entity blocks of the $Nodes and
+ * $Elements sections (split into chunks for the large blocks) are parsed by multiple threads.
+ */
+class Msh4FileReader{
+public:
+    /**
+     * constructor
+     */
+    Msh4FileReader();
+    /**
+     * destructor
+     */
+    ~Msh4FileReader();
+
+    /**
+     * read the whole msh4 file, return false if the file is invalid
+     * @param filename the msh file name
+     * @param nthreads the number of parsing threads, 0 for the number of hardware threads
+     */
+    bool readMeshFile(const string &filename,const int &nthreads=0);
+
+    /**
+     * release the mapped file and all the parsed data
+     */
+    void releaseMemory();
+
+    //*********************************************
+    //*** for gettings
+    //*********************************************
+    /**
+     * return true if the file is in binary format
+     */
+    inline bool isBinary()const{return m_IsBinary;}
+    /**
+     * get the version of the msh file
+     */
+    inline double getVersion()const{return m_Version;}
+    /**
+     * get the physical groups
+     */
+    inline const vector<Msh4PhysicalName>& getPhysicalNames()const{return m_PhysicalNames;}
+    /**
+     * get the physical id of each entity, indexed by (entity tag-1), zero if no physical id is assigned
+     * @param dim the dimension of the entity
+     */
+    inline const vector<int>& getEntityPhyIDs(const int &dim)const{return m_EntityPhyIDs[dim];}
+    /**
+     * get the total nodes number
+     */
+    inline int getNodesNum()const{return m_NodesNum;}
+    /**
+     * get the minimum node tag
+     */
+    inline int getMinNodeTag()const{return m_MinNodeTag;}
+    /**
+     * get the maximum node tag
+     */
+    inline int getMaxNodeTag()const{return m_MaxNodeTag;}
+    /**
+     * get the node blocks
+     */
+    inline const vector<Msh4NodeBlock>& getNodeBlocks()const{return m_NodeBlocks;}
+    /**
+     * get the total elements number
+     */
+    inline int getElmtsNum()const{return m_ElmtsNum;}
+    /**
+     * get the minimum element tag
+     */
+    inline int getMinElmtTag()const{return m_MinElmtTag;}
+    /**
+     * get the maximum element tag
+     */
+    inline int getMaxElmtTag()const{return m_MaxElmtTag;}
+    /**
+     * get the element blocks
+     */
+    inline const vector<Msh4ElmtBlock>& getElmtBlocks()const{return m_ElmtBlocks;}
+    /**
+     * get the maximum dimension of all the element blocks
+     */
+    int getMaxElmtDim()const;
+
+private:
+    /**
+     * map the file into memory
+     * @param filename the msh file name
+     */
+    bool mapFile(const string &filename);
+    /**
+     * unmap the file
+     */
+    void unmapFile();
+
+    /**
+     * read the next line from the current position, the position is moved to the next line
+     * @param line the line without the trailing '\r\n'
+     */
+    bool readLine(string &line);
+    /**
+     * move the current position to the line after '$EndXXX'
+     * @param name the section name without '$', i.e., 'Nodes'
+     */
+    bool skipSection(const string &name);
+    /**
+     * move the current position to the next line
+     */
+    void skipLine();
+    /**
+     * read a size_t (ascii or binary) from the current position
+     */
+    size_t readSizeT();
+    /**
+     * read an int (ascii or binary) from the current position
+     */
+    int readInt();
+    /**
+     * read a double (ascii or binary) from the current position
+     */
+    double readDouble();
+
+    bool readMeshFormat();/**< parse the $MeshFormat section */
+    bool readPhysicalNames();/**< parse the $PhysicalNames section */
+    bool readEntities();/**< parse the $Entities section */
+    bool readNodes();/**< parse the headers of the $Nodes section and locate the chunks */
+    bool readElements();/**< parse the headers of the $Elements section and locate the chunks */
+    /**
+     * parse the nodes and elements of all the blocks by the worker threads
+     * @param nthreads the number of threads
+     */
+    bool parseBlocks(const int &nthreads);
+
+private:
+    const char *m_Data;/**< the beginning of the mapped file */
+    size_t m_Size;/**< the size of the mapped file */
+    size_t m_Pos;/**< the current position */
+    int m_FileDescriptor;/**< the file descriptor of the mapped file */
+    vector<char> m_Buffer;/**< the file content if mmap is not available */
+
+    double m_Version;/**< the msh file version */
+    bool m_IsBinary;/**< true for binary file */
+    int m_DataSize;/**< the size of size_t in the file */
+    bool m_HasNodes,m_HasElmts;/**< true if the sections are found */
+
+    vector<Msh4PhysicalName> m_PhysicalNames;/**< the physical groups */
+    vector<int> m_EntityPhyIDs[4];/**< the physical id of points, curves, surfaces and volumes */
+
+    int m_NodesNum,m_MinNodeTag,m_MaxNodeTag;/**< the nodes info */
+    vector<Msh4NodeBlock> m_NodeBlocks;/**< the node blocks */
+
+    int m_ElmtsNum,m_MinElmtTag,m_MaxElmtTag;/**< the elements info */
+    vector<Msh4ElmtBlock> m_ElmtBlocks;/**< the element blocks */
+
+    static const size_t m_ChunkSize=65536;/**< the number of nodes/elements parsed by one task */
+};
@@ -155,6 +155,10 @@ public:
      * get the data of the coordinates vector
     */
     inline double* getData(){return m_Coordinates.data();}
+    /**
+     * get the const data of the coordinates vector
+    */
+    inline const double* getData()const{return m_Coordinates.data();}
     /**
      * get the reference of coordinate vector
     */
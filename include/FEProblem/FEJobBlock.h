@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include "nlohmann/json.hpp"
 #include "Utils/MessagePrinter.h"
 #include "FEProblem/FEJobType.h"
 
@@ -26,6 +29,8 @@ public:
     string   m_JobTypeName="static";/**< the job type name */
     bool m_IsDebug=true;/**< message print level */
     bool m_IsDepDebug=false;/**< for the dep message print */
+    std::vector<string> m_VariantNames;/**< the variant names of the ensemble run, empty for a single run */
+    std::vector<nlohmann::json> m_VariantOverrides;/**< the 'elements', 'bcs', and 'ics' overrides of each variant */
 
     /**
      * init the job block
@@ -35,13 +40,22 @@ public:
         m_JobTypeName="static";
         m_IsDebug=true;
         m_IsDepDebug=false;
+        m_VariantNames.clear();
+        m_VariantOverrides.clear();
     }
+    /**
+     * check whether the job is an ensemble of several variants
+     */
+    bool isEnsemble()const{return !m_VariantNames.empty();}
     /**
      * print out the job block information
      */
     void printJobInfo(){
         MessagePrinter::printNormalTxt("Job information summary:");
         MessagePrinter::printNormalTxt("  job type="+m_JobTypeName);
+        if(isEnsemble()){
+            MessagePrinter::printNormalTxt("  ensemble variants="+to_string(m_VariantNames.size()));
+        }
         if(m_IsDebug){
             if(m_IsDepDebug){
                 MessagePrinter::printNormalTxt("  dep message print is enabled");
@@ -67,13 +67,24 @@ public:
 
 private:
     /**
-     * run the FEM simulation for static problem
+     * run the FEM simulation for static problem, return true if it converges
      */
-    void runStaticAnalysis();
+    bool runStaticAnalysis();
     /**
-     * run the FEM simulation for transient problem
+     * run the FEM simulation for transient problem, return true if it converges
      */
-    void runTransientAnalysis();
+    bool runTransientAnalysis();
+    /**
+     * run the variants of the ensemble one by one on the same mesh, dofs map, and solvers,
+     * the variants are distributed over the rank groups of '--ensemble-groups'
+     */
+    void runEnsembleAnalysis();
+    /**
+     * apply the 'elements', 'bcs', and 'ics' overrides of one variant to the current blocks
+     * @param t_name the variant name
+     * @param t_overrides the json overrides of the variant
+     */
+    bool applyEnsembleOverrides(const string &t_name,const nlohmann::json &t_overrides);
     
 private:
     InputSystem m_InputSystem;/**< input system for input file reading */
@@ -0,0 +1,125 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.05
+//+++ Purpose: the prepared model cache, which stores the
+//+++          distributed fe cell and dofs map of each rank in
+//+++          a binary file, so the following runs of the same
+//+++          model can skip the mesh generation, partition and
+//+++          dofs map creation
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "nlohmann/json.hpp"
+
+#include "Utils/MessagePrinter.h"
+#include "Utils/BinaryStream.h"
+#include "FECell/FECell.h"
+#include "DofHandler/DofHandler.h"
+
+using std::string;
+using std::vector;
+
+/**
+ * This class manages the prepared model cache. Each rank owns one cache file named by the hash of the
+ * mesh/dofs/elements(domain and dofs only) blocks and the number of ranks, i.e.,
+ * 'cachedir/model-<hash>-np<ranks>-rank<rank>.cache'. The cache file is mapped into memory for the loading.
+ */
+class PreparedModelCache{
+public:
+    /**
+     * constructor
+     */
+    PreparedModelCache();
+    /**
+     * destructor
+     */
+    ~PreparedModelCache();
+
+    /**
+     * setup the cache from the input file, the cache is enabled by "cache":true in the mesh block
+     * @param inputfilename the name of the input file
+     * @param t_json the json of the whole input file
+     */
+    bool init(const string &inputfilename,const nlohmann::json &t_json);
+
+    /**
+     * load the fe cell from the cache files, return true only if all the ranks load their cache successfully (collective)
+     * @param t_fecell the fe cell class
+     */
+    bool loadFECell(FECell &t_fecell);
+    /**
+     * load the dofs map from the cache files, return true only if all the ranks load their cache successfully (collective)
+     * @param t_fecell the fe cell class
+     * @param t_dofhandler the dof handler class
+     */
+    bool loadDofsMap(FECell &t_fecell,DofHandler &t_dofhandler);
+    /**
+     * save the distributed fe cell and the dofs map into the cache file of each rank (collective)
+     * @param t_fecell the fe cell class
+     * @param t_dofhandler the dof handler class
+     */
+    bool save(const FECell &t_fecell,const DofHandler &t_dofhandler)const;
+    /**
+     * unmap the cache file
+     */
+    void close();
+
+    /**
+     * return true if the cache is enabled
+     */
+    inline bool isEnabled()const{return m_IsEnabled;}
+    /**
+     * return true if the fe cell is loaded from the cache
+     */
+    inline bool isFECellLoaded()const{return m_IsFECellLoaded;}
+    /**
+     * return true if the dofs map is loaded from the cache
+     */
+    inline bool isDofsMapLoaded()const{return m_IsDofsMapLoaded;}
+    /**
+     * get the cache file name of current rank
+     */
+    inline string getCacheFileName()const{return m_FileName;}
+
+private:
+    /**
+     * compute the hash key of the model
+     * @param t_json the json of the whole input file
+     * @param ranks the number of ranks
+     */
+    static uint64_t computeModelKey(const nlohmann::json &t_json,const int &ranks);
+    /**
+     * map the cache file of current rank and check its header, return false if the file is missing or invalid
+     */
+    bool mapFile();
+
+private:
+    bool m_IsEnabled;/**< true if the cache is enabled */
+    bool m_IsFECellLoaded;/**< true if the fe cell is loaded from the cache */
+    bool m_IsDofsMapLoaded;/**< true if the dofs map is loaded from the cache */
+    string m_CacheDir;/**< the folder of the cache files */
+    string m_FileName;/**< the cache file name of current rank */
+    uint64_t m_Key;/**< the hash key of the model */
+
+    const char *m_Data;/**< the beginning of the mapped file */
+    size_t m_Size;/**< the size of the mapped file */
+    int m_FileDescriptor;/**< the file descriptor of the mapped file */
+    vector<char> m_Buffer;/**< the file content if mmap is not available */
+    size_t m_FECellOffset,m_FECellSize;/**< the location of the fe cell section */
+    size_t m_DofsMapOffset,m_DofsMapSize;/**< the location of the dofs map section */
+
+    static const uint32_t m_Version=3;/**< the version of the cache file format */
+};
@@ -26,6 +26,7 @@
 #include "FECell/FECell.h"
 #include "DofHandler/DofHandler.h"
 #include "FE/FE.h"
+#include "FE/ReducedIntegration.h"
 #include "EquationSystem/EquationSystem.h"
 #include "SolutionSystem/SolutionSystem.h"
 
@@ -37,6 +38,7 @@
 #include "MathUtils/SparseMatrix.h"
 
 #include "FESystem/FECalcType.h"
+#include "FESystem/LumpedMassType.h"
 
 #include "ElmtSystem/ElmtSystem.h"
 #include "MateSystem/MateSystem.h"
@@ -97,6 +99,30 @@ public:
                     SolutionSystem &t_SolnSystem,
                     SparseMatrix &AMATRIX,
                     Vector &RHS);
+    /**
+     * assemble the diagonal (lumped) mass vector for the explicit dynamics, the density comes from the 'density'
+     * parameter of each element block (1.0 if it is not given)
+     * @param t_LumpType the lumping scheme, row-sum: m_i=int(rho*N_i), hrz: int(rho*N_i^2) scaled to the element mass
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dofHandler class
+     * @param t_FE the fe class for the shape function and gauss points
+     * @param t_ElmtSystem the element system class
+     * @param Mass the global lumped mass vector
+     */
+    void formBulkLumpedMass(const LumpedMassType &t_LumpType,
+                            const FECell &t_FECell,
+                            const DofHandler &t_DofHandler,
+                            FE &t_FE,
+                            const ElmtSystem &t_ElmtSystem,
+                            Vector &Mass);
+    /**
+     * estimate the critical time increment of the central difference scheme, dt=min(h_e/c_e), where h_e is the
+     * smallest node distance of each bulk element and c_e=sqrt((lambda+2G)/rho) is its dilatational wave speed
+     * (or the 'wave-speed' parameter of the element block)
+     * @param t_FECell the fe cell class
+     * @param t_ElmtSystem the element system class
+     */
+    double estimateStableDt(const FECell &t_FECell,const ElmtSystem &t_ElmtSystem)const;
     /**
      * release the allocated memory
      */
@@ -110,6 +136,27 @@ public:
      */
     inline double getMaxCoefOfKMatrix()const{return m_MaxKmatCoeff;}
 
+    //***************************************************************
+    //*** for the element cost measurement
+    //***************************************************************
+    /**
+     * enable/disable the timing of each local bulk element during the assembly, the time is accumulated until it is reset
+     * @param flag true for the measurement
+     */
+    inline void setElmtCostMeasurement(const bool &flag){m_MeasureElmtCost=flag;}
+    /**
+     * return true if the element cost is measured
+     */
+    inline bool isElmtCostMeasured()const{return m_MeasureElmtCost;}
+    /**
+     * get the accumulated assembly time of each local bulk element
+     */
+    inline const vector<double>& getLocalElmtCost()const{return m_LocalElmtCost;}
+    /**
+     * reset the accumulated assembly time, it must be called once the local elements are changed
+     */
+    inline void resetLocalElmtCost(){m_LocalElmtCost.clear();}
+
 private:
     //***************************************************************
     //*** assemble functions
@@ -150,6 +197,75 @@ private:
                                        const DofHandler &t_DofHandler,
                                        const MatrixXd &SubK,
                                        SparseMatrix &AMATRIX);
+    /**
+     * evaluate the materials with the batched kernel for all the qpoints of one local element, the other sub
+     * elements are still evaluated qpoint by qpoint in formBulkFE
+     * @param e the local element id, start from 1
+     * @param t_Cell the fe cell of current element
+     * @param t_DofHandler the dofHandler class
+     * @param t_FE the fe class for the shape function and gauss points
+     * @param t_ElmtSystem the element system class
+     * @param t_MateSystem the material system class
+     * @param t_SolnSystem the solution system class, the ghost copies should be ready
+     */
+    void runBatchMaterials(const int &e,
+                           const SingleMeshCell &t_Cell,
+                           const DofHandler &t_DofHandler,
+                           FE &t_FE,
+                           const ElmtSystem &t_ElmtSystem,
+                           MateSystem &t_MateSystem,
+                           const SolutionSystem &t_SolnSystem);
+    /**
+     * check the unpacked batched materials of one qpoint against the qpoint-by-qpoint material libs, the local
+     * element solution of current qpoint should be ready. The run stops if any material differs
+     * @param e the local element id, start from 1
+     * @param qp the qpoint id, start from 1
+     * @param t_Block the element block of current sub element
+     * @param t_MateSystem the material system class
+     */
+    void checkBatchMaterials(const int &e,const int &qp,
+                             const ElmtBlock &t_Block,
+                             MateSystem &t_MateSystem);
+    /**
+     * compute the element averaged shape function gradients and the mean dilatation of each sub element, this is
+     * only done if any sub element uses the selective reduced integration or the hourglass control
+     * @param e the local element id, start from 1
+     * @param t_Cell the fe cell of current element
+     * @param t_DofHandler the dofHandler class
+     * @param t_FE the fe class for the shape function and gauss points
+     * @param t_Qpoints the qpoints of current element
+     * @param t_ElmtSystem the element system class
+     * @param t_SolnSystem the solution system class, the ghost copies should be ready
+     */
+    void computeReducedIntegration(const int &e,
+                                   const SingleMeshCell &t_Cell,
+                                   const DofHandler &t_DofHandler,
+                                   FE &t_FE,
+                                   const QPoint &t_Qpoints,
+                                   const ElmtSystem &t_ElmtSystem,
+                                   const SolutionSystem &t_SolnSystem);
+    /**
+     * assemble the Flanagan-Belytschko stiffness type hourglass control of the single-point quad4/hex8 element,
+     * computeReducedIntegration must be called before
+     * @param t_CalcType the calculation type
+     * @param Ctan the time derivative coefficients
+     * @param e the local element id, start from 1
+     * @param t_Cell the fe cell of current element
+     * @param t_DofHandler the dofHandler class
+     * @param t_ElmtSystem the element system class
+     * @param t_SolnSystem the solution system class, the ghost copies should be ready
+     * @param AMATRIX the global K matrix
+     * @param RHS the global residual vector
+     */
+    void assembleHourglassControl(const FECalcType &t_CalcType,
+                                  const double (&Ctan)[3],
+                                  const int &e,
+                                  const SingleMeshCell &t_Cell,
+                                  const DofHandler &t_DofHandler,
+                                  const ElmtSystem &t_ElmtSystem,
+                                  const SolutionSystem &t_SolnSystem,
+                                  SparseMatrix &AMATRIX,
+                                  Vector &RHS);
 
 
 private:
@@ -160,6 +276,8 @@ private:
     MatrixXd m_LocalK;/**< for the local Jacobian matrix, this is used for the whole element */
     VectorXd m_SubR;/**< for the local 'element's vector, used for one single element/model */
     MatrixXd m_SubK;/**< for the local 'element's matrix, used for one single element/model */
+    vector<VectorXd> m_QpSubR;/**< the sub element residual of each node at current qpoint, inserted after all the kernels */
+    vector<MatrixXd> m_QpSubK;/**< the sub element jacobian of each node pair at current qpoint, [(i-1)*nodes+j-1] */
 
     vector<int> m_ElmtConn;/**< for local element's connectivity */
     vector<int> m_ElmtDofIDs;/**< for local elemental nodes' gloabl ids, start from 0 */
@@ -168,6 +286,9 @@ private:
 
     double m_MaxKmatCoeff;/**< the max(absolute) value of current K matrix */
 
+    bool m_MeasureElmtCost;/**< true if the assembly time of each local element is measured */
+    vector<double> m_LocalElmtCost;/**< the accumulated assembly time of each local element */
+
     vector<double> m_ElmtU;/**< 'displacemen' of current element */
     vector<double> m_ElmtUold;/**< previous 'displacemen' of current element */
     vector<double> m_ElmtUolder;/**< pre-previous 'displacemen' of current element */
@@ -181,6 +302,16 @@ private:
     LocalElmtSolution m_LocalElmtSoln;/**< for the local element solution */
     LocalShapeFun m_LocalShp;/**< for the local shape function */
 
+    vector<bool> m_IsBatchedSubElmt;/**< true if the sub element's material is evaluated by the batched kernel */
+    vector<BatchMaterialInput> m_BatchMateInputs;/**< the SoA material input of each sub element */
+    vector<BatchMaterialOutput> m_BatchMateOutputs;/**< the SoA material output of each sub element */
+
+    bool m_HasReducedIntegration;/**< true if any sub element of current element uses the mean dilatation or the hourglass control */
+    ReducedIntegration m_ReducedIntegration;/**< the element averaged quantities of current element */
+    vector<double> m_SubElmtMeanDilatation;/**< the mean dilatation of each sub element */
+    vector<double> m_HourglassModulus;/**< the material stiffness of each sub element for the hourglass control */
+    vector<double> m_ReducedNodalU;/**< the nodal displacement of current sub element, [(i-1)*3+k-1] */
+
 private:
 
     
@@ -84,6 +84,17 @@ public:
      * get the number of ic blocks read from input file
      */
     inline int getICBlocksNum()const{return m_icblocks_num;}
+    /**
+     * get the reference of the i-th ic block, it is used to override the ic value in the ensemble run
+     * @param i the integer index for ic block
+     */
+    inline ICBlock& getIthICBlockRef(const int &i){
+        if(i<1||i>m_icblocks_num){
+            MessagePrinter::printErrorTxt("i="+to_string(i)+" is out of range for icblocks");
+            MessagePrinter::exitAsFem();
+        }
+        return m_icblock_list[i-1];
+    }
 
 private:
     //*******************************************************
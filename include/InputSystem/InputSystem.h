@@ -43,6 +43,7 @@
 #include "OutputSystem/OutputSystem.h"
 #include "Postprocess/Postprocessor.h"
 #include "FEProblem/FEJobBlock.h"
+#include "FEProblem/PreparedModelCache.h"
 
 using std::string;
 using std::vector;
@@ -112,6 +113,16 @@ public:
      */
     bool isReadOnly()const{return m_ReadOnly;}
 
+    /**
+     * check whether the profiler is enabled by the '--profile' option
+     */
+    bool isProfileEnabled()const{return m_Profile;}
+
+    /**
+     * get the reference of the prepared model cache
+     */
+    inline PreparedModelCache& getModelCacheRef(){return m_ModelCache;}
+
 private:
     /**
      * read the mesh block from json file
@@ -213,9 +224,11 @@ private:
 
 private:
     bool m_ReadOnly;/**< boolean flag, if readonly=true, it will only read the mesh block */
+    bool m_Profile;/**< boolean flag, if true, the runtime profiler is enabled */
     bool m_HasInputFile;/**< boolean flag, if true then the input file is loaded */
     string m_InputFileName;/**< string for the name of input file */
     string m_MeshFileName;/**< string for the name of mesh file(external mesh file)*/
     nlohmann::json m_Json;/**< json file reader */
+    PreparedModelCache m_ModelCache;/**< the prepared model cache */
     
 };
\ No newline at end of file
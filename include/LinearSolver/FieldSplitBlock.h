@@ -0,0 +1,47 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.12
+//+++ Purpose: define the split (field) block for the fieldsplit
+//+++          preconditioner, each split is built from dof names
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/**
+ * this class stores the information of one split in the fieldsplit preconditioner
+ */
+class FieldSplitBlock{
+public:
+    FieldSplitBlock(){
+        init();
+    }
+
+    string m_SplitName;/**< the name of current split, it is also used as the PETSc options prefix */
+    vector<string> m_DofNameList;/**< the dof names belong to current split */
+    string m_KSPTypeName;/**< the ksp solver of current split */
+    string m_PCTypeName;/**< the preconditioner of current split */
+
+    /**
+     * initialize the split block
+     */
+    void init(){
+        m_SplitName.clear();
+        m_DofNameList.clear();
+        m_KSPTypeName="preonly";
+        m_PCTypeName="ilu";
+    }
+};
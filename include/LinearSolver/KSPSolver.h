@@ -16,6 +16,8 @@
 #pragma once
 
 #include "LinearSolver/LinearSolverBase.h"
+#include "LinearSolver/FieldSplitBlock.h"
+#include "DofHandler/DofHandler.h"
 
 #include "petsc.h"
 
@@ -40,6 +42,22 @@ public:
      */
     void init();
 
+    /**
+     * create the index sets of the fieldsplit preconditioner from the dof names, it only works for preconditioner=fieldsplit
+     * @param t_DofHandler the dof handler class
+     * @param A the sparse matrix, which offers the row ownership of each rank
+     */
+    void initFieldSplit(const DofHandler &t_DofHandler,SparseMatrix &A);
+
+    /**
+     * create the grid hierarchy and the interpolations of the geometric multigrid preconditioner from the built-in
+     * structured mesh, it only works for preconditioner=mg
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dof handler class
+     * @param A the sparse matrix, which offers the row ownership of each rank
+     */
+    void initMultigrid(const FECell &t_FECell,const DofHandler &t_DofHandler,SparseMatrix &A);
+
     /**
      * release the allocated memory
      */
@@ -78,6 +96,21 @@ public:
         m_Tolerance = tolerance;
     }
 
+    /**
+     * reset the relative tolerance of ksp solver before the next solve, which is used as the forcing term
+     * of the inexact newton method
+     * @param rtol the relative tolerance
+     */
+    void setRelativeTolerance(const double &rtol);
+
+    /**
+     * compute the true linear residual norm |b-A*x| after each solve
+     * @param flag true for computing the linear residual norm
+     */
+    void setComputeResidualNorm(const bool &flag) {
+        m_ComputeResidualNorm=flag;
+    }
+
     /**
      * set the solver name of ksp
      * @param typeName string name for the ksp solver
@@ -94,6 +127,91 @@ public:
         m_PCTypeName = typeName;
     }
 
+    /**
+     * set the precision of the preconditioner factors
+     * @param typeName double or single, single is only valid for the ilu and bjacobi preconditioners
+     */
+    void setPCPrecisionName(const std::string &typeName) {
+        m_PCPrecisionName=typeName;
+    }
+
+    /**
+     * reuse the current preconditioner in the following solves, the operator will not be refactored
+     * even if the matrix has been modified, which is used by the modified newton method
+     * @param flag true for reusing the preconditioner, false for rebuilding it in the next solve
+     */
+    void setReusePreconditioner(const bool &flag) {
+        m_ReusePreconditioner=flag;
+    }
+
+    /**
+     * set the composition type of the fieldsplit preconditioner
+     * @param typeName additive, multiplicative, symmetric-multiplicative or schur
+     */
+    void setFieldSplitTypeName(const std::string &typeName) {
+        m_FieldSplitTypeName=typeName;
+    }
+
+    /**
+     * set the schur factorization type of the fieldsplit preconditioner
+     * @param typeName diag, lower, upper or full
+     */
+    void setSchurFactTypeName(const std::string &typeName) {
+        m_SchurFactTypeName=typeName;
+    }
+
+    /**
+     * set the preconditioner of the schur complement
+     * @param typeName self, selfp, a11 or full
+     */
+    void setSchurPreTypeName(const std::string &typeName) {
+        m_SchurPreTypeName=typeName;
+    }
+
+    /**
+     * add one split to the fieldsplit preconditioner
+     * @param t_Block the split block
+     */
+    void addFieldSplitBlock(const FieldSplitBlock &t_Block) {
+        m_FieldSplitBlockList.push_back(t_Block);
+    }
+
+    /**
+     * set the number of multigrid levels
+     * @param levels the levels number, 0 means the mesh is coarsened as many times as possible
+     */
+    void setMGLevels(const int &levels) {
+        m_MGLevels=levels;
+    }
+
+    /**
+     * set the cycle type of the multigrid preconditioner
+     * @param typeName v or w
+     */
+    void setMGCycleTypeName(const std::string &typeName) {
+        m_MGCycleTypeName=typeName;
+    }
+
+    /**
+     * set the smoother of the multigrid levels
+     * @param typeName the ksp type of the smoother, i.e., chebyshev, richardson or gmres
+     * @param pcTypeName the preconditioner of the smoother, i.e., sor, jacobi, bjacobi or ilu
+     * @param steps the smoothing steps on each level
+     */
+    void setMGSmoother(const std::string &typeName,const std::string &pcTypeName,const int &steps) {
+        m_MGSmootherTypeName=typeName;
+        m_MGSmootherPCTypeName=pcTypeName;
+        m_MGSmoothSteps=steps;
+    }
+
+    /**
+     * set the solver of the coarsest multigrid level
+     * @param typeName redundant, lu, gamg, bjacobi or jacobi
+     */
+    void setMGCoarseSolverTypeName(const std::string &typeName) {
+        m_MGCoarseSolverTypeName=typeName;
+    }
+
     /**
      * get the KSP class copy
      * @return the copy of KSP class
@@ -132,6 +250,22 @@ public:
         return m_Iterations;
     }
 
+    /**
+     * check whether the preconditioner will be reused in the next solve
+     * @return true if the preconditioner is reused
+     */
+    bool isPreconditionerReused()const {
+        return m_ReusePreconditioner;
+    }
+
+    /**
+     * get the true linear residual norm |b-A*x| of the last solve, only valid if setComputeResidualNorm(true) is called
+     * @return the linear residual norm
+     */
+    double getLinearResidualNorm()const {
+        return m_LinearResidualNorm;
+    }
+
     /**
      * get the restart number of GMRES solver
      * @return GMRES restart number
@@ -156,11 +290,25 @@ public:
         return m_PCTypeName;
     }
 
+    /**
+     * get the precision name of the preconditioner factors
+     * @return double or single
+     */
+    string getPCPrecisionName()const {
+        return m_PCPrecisionName;
+    }
+
     /**
      * print the summary information of KSP solver
      */
     void printKSPSolverInfo()const;
 
+private:
+    /**
+     * set the composition type and the sub-solvers of the fieldsplit preconditioner
+     */
+    void setFieldSplitOptions();
+
 
 protected:
     int m_Iterations;/**< the iterations of the linear solver */
@@ -168,10 +316,28 @@ protected:
     int m_GMRESRestartNumber;/**< the restart number of GMRES */
     double m_Tolerance;/**< the error tolerance of the linear solver */
     bool m_IsAllocated;/**< the status of the memory allocation */
+    bool m_ReusePreconditioner;/**< if true, the preconditioner will not be rebuilt in the next solve */
+    bool m_ComputeResidualNorm;/**< if true, the true linear residual norm will be calculated after each solve */
+    double m_LinearResidualNorm;/**< the true linear residual norm of the last solve */
+    Vec m_LinearResidual;/**< the work vector for b-A*x */
+    bool m_HasResidualVec;/**< the allocation status of the work vector */
 
     KSP m_KSP;/**< the KSP solver class */
     PC m_PC;/**< the Preconditoner class */
 
     string m_KSPSolverTypeName;/**< the string name of the KSP Solver type */
     string m_PCTypeName;/**< the string name of the precondition type */
+    string m_PCPrecisionName;/**< the precision of the preconditioner factors, double or single */
+
+    string m_FieldSplitTypeName;/**< the composition type of the fieldsplit preconditioner */
+    string m_SchurFactTypeName;/**< the schur factorization type of the fieldsplit preconditioner */
+    string m_SchurPreTypeName;/**< the preconditioner type of the schur complement */
+    vector<FieldSplitBlock> m_FieldSplitBlockList;/**< the splits of the fieldsplit preconditioner */
+
+    int m_MGLevels;/**< the number of multigrid levels, 0 for the maximum levels of the mesh */
+    int m_MGSmoothSteps;/**< the smoothing steps of each multigrid level */
+    string m_MGCycleTypeName;/**< the cycle type of the multigrid preconditioner */
+    string m_MGSmootherTypeName;/**< the ksp type of the multigrid smoother */
+    string m_MGSmootherPCTypeName;/**< the preconditioner type of the multigrid smoother */
+    string m_MGCoarseSolverTypeName;/**< the preconditioner type of the coarsest multigrid level */
 };
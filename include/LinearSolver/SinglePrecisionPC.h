@@ -0,0 +1,71 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.16
+//+++ Purpose: the block-jacobi preconditioner with ILU(0) factors
+//+++          stored in single precision
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <vector>
+
+#include "petsc.h"
+
+using std::vector;
+
+/**
+ * This class implements the block-jacobi preconditioner, the diagonal block of each rank is factorized by ILU(0) and
+ * the factors are stored in single precision. It is attached to PETSc as a shell preconditioner, the factorization
+ * and the triangular solves are computed in double precision, so the krylov iterations are still in double precision,
+ * only the memory and the bandwidth of the factors are halved.
+ */
+class SinglePrecisionPC{
+public:
+    /**
+     * set the PETSc preconditioner to a shell one and attach the single-precision factors to it
+     * @param t_PC the PETSc preconditioner
+     */
+    static void attachToPC(PC &t_PC);
+
+private:
+    /**
+     * the setup callback of PETSc, it is called once the operator is changed
+     */
+    static PetscErrorCode setUp(PC t_PC);
+    /**
+     * the apply callback of PETSc, y=(LU)^-1*x
+     */
+    static PetscErrorCode apply(PC t_PC,Vec x,Vec y);
+    /**
+     * the destroy callback of PETSc
+     */
+    static PetscErrorCode destroy(PC t_PC);
+
+    /**
+     * compute the ILU(0) factors of the local diagonal block
+     * @param A the local diagonal block
+     * @return false if one row misses its diagonal entry
+     */
+    bool factorize(Mat &A);
+    /**
+     * apply the forward and backward substitution
+     * @param b the right-hand side array
+     * @param x the solution array
+     */
+    void solve(const PetscScalar *b,PetscScalar *x)const;
+
+private:
+    PetscInt m_RowsNum=0;/**< the number of local rows */
+    vector<PetscInt> m_RowPtr;/**< the row pointers of the factors */
+    vector<PetscInt> m_ColIDs;/**< the local column ids of the factors */
+    vector<PetscInt> m_DiagIDs;/**< the position of the diagonal entry of each row */
+    vector<float> m_Vals;/**< the L (unit lower part) and U factors in single precision */
+};
@@ -0,0 +1,57 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.13
+//+++ Purpose: split the mpi ranks into several groups for the
+//+++          ensemble execution, each group runs its own
+//+++          variants on the sub-communicator
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "mpi.h"
+
+/**
+ * This class splits MPI_COMM_WORLD into '--ensemble-groups n' sub-communicators before PETSc is initialized,
+ * then PETSC_COMM_WORLD of each group is the sub-communicator.
+ */
+class EnsembleComm{
+public:
+    /**
+     * read '--ensemble-groups n' from the command line and split the mpi ranks, it must be called before PetscInitialize
+     * @param args number of arguments
+     * @param argv the argument string vector
+     * @return true if everything is ok
+     */
+    static bool init(int args,char *argv[]);
+    /**
+     * free the sub-communicator and finalize mpi, it must be called after PetscFinalize
+     */
+    static void finalize();
+
+    /**
+     * get the number of rank groups, 1 means no splitting
+     */
+    static int getGroupsNum(){return m_GroupsNum;}
+    /**
+     * get the 0-based group id of current rank
+     */
+    static int getGroupID(){return m_GroupID;}
+    /**
+     * check whether current rank belongs to the first group, only this group writes the shared mesh files
+     */
+    static bool isMainGroup(){return m_GroupID==0;}
+
+private:
+    static int m_GroupsNum;/**< the number of rank groups */
+    static int m_GroupID;/**< the group id of current rank */
+    static bool m_OwnMPI;/**< true if mpi is initialized here, rather than by PETSc */
+    static MPI_Comm m_SubComm;/**< the sub-communicator of current group */
+};
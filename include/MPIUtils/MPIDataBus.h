@@ -22,6 +22,7 @@
 
 #include "FECell/SingleMeshCell.h"
 #include "FECell/MeshType.h"
+#include "Utils/BinaryStream.h"
 
 #include "mpi.h"
 
@@ -200,4 +201,79 @@ public:
     */
     static void receivePhyName2NodeIDVecMapFromMaster(map<string,vector<int>> &Localmap,const int &Tag);
 
+    /**
+     * Exchange the byte buffers among all the ranks, the i-th send buffer goes to the i-th rank, if the buffers of
+     * any rank exceed 2GB in total, all the ranks switch to the chunked point-to-point transfer
+     * @param SendBufs the buffers to be sent, one for each rank
+     * @param RecvBufs the received buffers, one from each rank
+     */
+    static void exchangeBuffersAmongRanks(const vector<vector<char>> &SendBufs,vector<vector<char>> &RecvBufs);
+
+    //*************************************************************
+    //*** for the packed buffer transfer, the whole data structure
+    //*** is packed into one buffer for each rank
+    //*************************************************************
+    /**
+     * Pack the mesh cell vector into the binary buffer with the flat format: the fixed-size cell headers,
+     * then the connectivity, dof ids and physical ids of all the cells, the coordinates are stored once for each node
+     * @param Writer the binary writer
+     * @param MeshCellVec the mesh cell vector to be packed
+     * @param PhyName2IDMap the physical name to id map shared by all the ranks, the physical names are sent as the id
+     */
+    static void packMeshCellVector(BinaryWriter &Writer,const vector<SingleMeshCell> &MeshCellVec,const map<string,int> &PhyName2IDMap);
+    /**
+     * Unpack the mesh cell vector from the binary buffer, return false if the buffer is broken
+     * @param Reader the binary reader
+     * @param MeshCellVec the mesh cell vector used to store the data
+     * @param PhyID2NameMap the physical id to name map shared by all the ranks
+     */
+    static bool unpackMeshCellVector(BinaryReader &Reader,vector<SingleMeshCell> &MeshCellVec,const map<int,string> &PhyID2NameMap);
+    /**
+     * Pack the aligned vector (with the same width) of integer vector into the binary buffer
+     * @param Writer the binary writer
+     * @param Vec the vector stores integer vectors
+     */
+    static void packAlignedVectorOfIntegerVector(BinaryWriter &Writer,const vector<vector<int>> &Vec);
+    /**
+     * Unpack the aligned vector (with the same width) of integer vector from the binary buffer, return false if the buffer is broken
+     * @param Reader the binary reader
+     * @param Vec the vector used to store the integer vectors
+     */
+    static bool unpackAlignedVectorOfIntegerVector(BinaryReader &Reader,vector<vector<int>> &Vec);
+
+    /**
+     * Send the i-th buffer to the i-th rank without blocking each other, all the sends are completed together,
+     * each buffer is sent in chunks below 2GB and received by receiveChunkedBufferFromMaster,
+     * this should be called on master rank, the 0-th buffer is not sent
+     * @param SendBufs the buffers to be sent, one for each rank
+     * @param Tag the id of the sending message
+     */
+    static void sendBuffersToOthers(const vector<vector<char>> &SendBufs,const int &Tag);
+    /**
+     * Send the buffer to the given rank in blocking mode, the buffer is split into the chunks below 2GB, so its size
+     * is not limited by the int count of MPI, this should be called on master rank
+     * @param Buf the buffer to be sent
+     * @param cpuid the id of the receiving rank
+     * @param Tag the id of the sending message
+     */
+    static void sendChunkedBufferToOther(const vector<char> &Buf,const int &cpuid,const int &Tag);
+    /**
+     * Receive the buffer sent by sendChunkedBufferToOther or sendBuffersToOthers from master rank, this should be called on each rank locally
+     * @param Buf the buffer used to store the data from master rank
+     * @param Tag the received message tag
+     */
+    static void receiveChunkedBufferFromMaster(vector<char> &Buf,const int &Tag);
+    /**
+     * Scatter the buffers from master rank to all the ranks, the i-th buffer goes to the i-th rank, the buffers
+     * should not exceed 2GB in total, otherwise all the ranks exit together, this must be called on all the ranks
+     * @param SendBufs the buffers to be sent, one for each rank, only used on master rank
+     * @param RecvBuf the buffer received by current rank
+     */
+    static void scatterBuffersFromMaster(const vector<vector<char>> &SendBufs,vector<char> &RecvBuf);
+    /**
+     * Broadcast the buffer from master rank to all the ranks in chunks below 2GB, this must be called on all the ranks
+     * @param Buf the buffer to be sent on master rank, and the received buffer on other ranks
+     */
+    static void broadcastBufferFromMaster(vector<char> &Buf);
+
 };
\ No newline at end of file
@@ -0,0 +1,42 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.20
+//+++ Purpose: Define the abstract class for the materials, which
+//+++          can evaluate all the qpoints of one element at once
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "MateSystem/BatchMaterialData.h"
+
+#include "nlohmann/json.hpp"
+#include "Utils/JsonUtils.h"
+#include "Utils/MessagePrinter.h"
+
+/**
+ * This abstract class defines the batched material calculation, the materials inherit it besides the
+ * BulkMaterialBase, the per-qpoint computeMaterialProperties is still used for the material initialization
+ * and the materials without the batched kernel.
+ */
+class BatchMaterialBase{
+protected:
+    /**
+     * Compute the material properties of all the qpoints of current batch, the json parameters should be parsed
+     * only once, then the qpoints loop should be the innermost one
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output)=0;
+
+};
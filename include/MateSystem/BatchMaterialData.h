@@ -0,0 +1,187 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.20
+//+++ Purpose: the struct-of-arrays (SoA) input and output of the
+//+++          batched material calculation, the c-th component of
+//+++          the q-th qpoint is stored in [c*N+q], N is the
+//+++          qpoints number of the batch
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+
+#include "MateSystem/MaterialsContainer.h"
+
+using std::string;
+using std::vector;
+using std::map;
+
+/**
+ * the component id of the (i,j) rank-2 tensor in the SoA arrays, index starts from 1
+ */
+inline int batchRank2ID(const int &i,const int &j){return (i-1)*3+j-1;}
+/**
+ * the component id of the (i,j,k,l) rank-4 tensor in the SoA arrays, index starts from 1
+ */
+inline int batchRank4ID(const int &i,const int &j,const int &k,const int &l){return (((i-1)*3+j-1)*3+k-1)*3+l-1;}
+/**
+ * compute the von-mises value, sqrt(1.5*dev(A):dev(A)), of a SoA rank-2 tensor
+ * @param N the qpoints number
+ * @param A the SoA rank-2 tensor
+ * @param vm the output von-mises value of each qpoint
+ */
+inline void batchVonMises(const int &N,const double *A,double *vm){
+    for(int q=0;q<N;q++) vm[q]=0.0;
+    for(int c=0;c<9;c++){
+        for(int q=0;q<N;q++) vm[q]+=A[c*N+q]*A[c*N+q];
+    }
+    double tr;
+    for(int q=0;q<N;q++){
+        // dev(A):dev(A)=A:A-tr(A)^2/3
+        tr=A[q]+A[4*N+q]+A[8*N+q];
+        vm[q]=std::sqrt(1.5*std::max(vm[q]-tr*tr/3.0,0.0));
+    }
+}
+
+/**
+ * the SoA input of the batched material calculation, all the qpoints of one (sub) element are packed together,
+ * so the kernels can loop over the qpoints in the innermost loop
+ */
+struct BatchMaterialInput{
+    int m_QpointsNum=0;/**< N, the qpoints number of current batch */
+    int m_Dim=0;/**< the dimension of current element */
+    int m_DofsNum=0;/**< the dofs number of current sub element */
+    double m_T=0.0;/**< the current time */
+    double m_Dt=0.0;/**< the current time increment */
+
+    vector<double> m_U;/**< the i-th dof value, stored in [(i-1)*N+q] */
+    vector<double> m_GradU;/**< the k-th component of the i-th dof gradient, stored in [((i-1)*3+k-1)*N+q] */
+
+    map<string,vector<double>> m_ScalarMaterialsOld;/**< the scalar materials of previous step, [q] */
+    map<string,vector<double>> m_VectorMaterialsOld;/**< the vector materials of previous step, [(k-1)*N+q] */
+    map<string,vector<double>> m_Rank2MaterialsOld;/**< the rank-2 materials of previous step, [((i-1)*3+j-1)*N+q] */
+
+    /**
+     * resize the solution arrays, the packed old materials are removed
+     * @param nqp the qpoints number
+     * @param dofs the dofs number of current sub element
+     */
+    void resize(const int &nqp,const int &dofs){
+        m_QpointsNum=nqp;
+        m_DofsNum=dofs;
+        m_U.assign(dofs*nqp,0.0);
+        m_GradU.assign(3*dofs*nqp,0.0);
+        m_ScalarMaterialsOld.clear();
+        m_VectorMaterialsOld.clear();
+        m_Rank2MaterialsOld.clear();
+    }
+    /**
+     * get the pointer of the i-th dof value over the qpoints
+     * @param i the dof index, start from 1
+     */
+    inline const double* U(const int &i)const{return m_U.data()+(i-1)*m_QpointsNum;}
+    inline double* U(const int &i){return m_U.data()+(i-1)*m_QpointsNum;}
+    /**
+     * get the pointer of the k-th component of the i-th dof gradient over the qpoints
+     * @param i the dof index, start from 1
+     * @param k the component index, start from 1
+     */
+    inline const double* GradU(const int &i,const int &k)const{return m_GradU.data()+((i-1)*3+k-1)*m_QpointsNum;}
+    inline double* GradU(const int &i,const int &k){return m_GradU.data()+((i-1)*3+k-1)*m_QpointsNum;}
+
+    /**
+     * get the old scalar material over the qpoints
+     * @param matename the material name
+     */
+    const double* ScalarMaterialOld(const string &matename)const;
+    /**
+     * get the old rank-2 material over the qpoints, the (i,j) component starts from [((i-1)*3+j-1)*N]
+     * @param matename the material name
+     */
+    const double* Rank2MaterialOld(const string &matename)const;
+    /**
+     * pack the scalar, vector and rank-2 materials of previous step of the q-th qpoint, the rank-4 ones are
+     * never used as the history variables, so they are skipped
+     * @param q the qpoint index, start from 0
+     * @param t_mateold the materials of previous step
+     */
+    void packMaterialsOld(const int &q,const MaterialsContainer &t_mateold);
+};
+
+/**
+ * the SoA output of the batched material calculation, each material is allocated on its first request
+ */
+struct BatchMaterialOutput{
+    int m_QpointsNum=0;/**< N, the qpoints number of current batch */
+    map<string,vector<double>> m_ScalarMaterials;/**< [q] */
+    map<string,vector<double>> m_VectorMaterials;/**< [(k-1)*N+q] */
+    map<string,vector<double>> m_Rank2Materials;/**< [((i-1)*3+j-1)*N+q] */
+    map<string,vector<double>> m_Rank4Materials;/**< [((((i-1)*3+j-1)*3+k-1)*3+l-1)*N+q] */
+
+    /**
+     * remove all the materials of the previous batch
+     * @param nqp the qpoints number of the new batch
+     */
+    void reset(const int &nqp){
+        m_QpointsNum=nqp;
+        m_ScalarMaterials.clear();
+        m_VectorMaterials.clear();
+        m_Rank2Materials.clear();
+        m_Rank4Materials.clear();
+    }
+    /**
+     * get the scalar material slot over the qpoints
+     * @param matename the material name
+     */
+    inline double* ScalarMaterial(const string &matename){
+        vector<double> &vals=m_ScalarMaterials[matename];
+        vals.resize(m_QpointsNum,0.0);
+        return vals.data();
+    }
+    /**
+     * get the vector material slot, the k-th component starts from [(k-1)*N]
+     * @param matename the material name
+     */
+    inline double* VectorMaterial(const string &matename){
+        vector<double> &vals=m_VectorMaterials[matename];
+        vals.resize(3*m_QpointsNum,0.0);
+        return vals.data();
+    }
+    /**
+     * get the rank-2 material slot, the (i,j) component starts from [((i-1)*3+j-1)*N]
+     * @param matename the material name
+     */
+    inline double* Rank2Material(const string &matename){
+        vector<double> &vals=m_Rank2Materials[matename];
+        vals.resize(9*m_QpointsNum,0.0);
+        return vals.data();
+    }
+    /**
+     * get the rank-4 material slot, the (i,j,k,l) component starts from [((((i-1)*3+j-1)*3+k-1)*3+l-1)*N]
+     * @param matename the material name
+     */
+    inline double* Rank4Material(const string &matename){
+        vector<double> &vals=m_Rank4Materials[matename];
+        vals.resize(81*m_QpointsNum,0.0);
+        return vals.data();
+    }
+    /**
+     * copy the materials of the q-th qpoint into the material container
+     * @param q the qpoint index, start from 0
+     * @param t_mate the material container to be written
+     */
+    void unpack(const int &q,MaterialsContainer &t_mate)const;
+};
@@ -20,6 +20,7 @@
  */
 #include "MateSystem/MateType.h"
 #include "MateSystem/MaterialsContainer.h"
+#include "MateSystem/BatchMaterialData.h"
 
 /**
  * For built-in and user-defined materials (UMAT)
@@ -116,6 +117,23 @@ public:
                          const LocalElmtInfo &ElmtInfo,
                          const LocalElmtSolution &ElmtSoln);
 
+    /**
+     * check whether the material has the batched kernel, the other ones are evaluated qpoint by qpoint
+     * @param t_MateType the type of material calculation
+     */
+    static bool hasBatchMateLibs(const MateType &t_MateType);
+    /**
+     * run the batched material libs, which evaluate all the qpoints of one sub element at once
+     * @param t_MateType the type of material calculation
+     * @param Params the parameters read from json file
+     * @param Input the SoA solution and old materials of the qpoints
+     * @param Output the SoA materials of the qpoints
+     */
+    void runBulkMateLibsBatch(const MateType &t_MateType,
+                              const nlohmann::json &Params,
+                              const BatchMaterialInput &Input,
+                              BatchMaterialOutput &Output);
+
 public:
     MaterialsContainer m_MaterialContainerOld;/**< the materials container of previous step */
     MaterialsContainer m_MaterialContainer;/**< the material container of current step */
@@ -18,11 +18,13 @@
 #pragma once
 
 #include "MateSystem/BulkMaterialBase.h"
+#include "MateSystem/BatchMaterialBase.h"
 
 /**
  * This class calculate the constant D and dDdc for the diffusion equation
  */
-class ConstDiffusionMaterial:public BulkMaterialBase{
+class ConstDiffusionMaterial:public BulkMaterialBase,
+                             public BatchMaterialBase{
 protected:
     /**
      * Initial the preset material properties, if you don't need the history information of some materials, 
@@ -50,6 +52,15 @@ protected:
                                            const LocalElmtSolution &t_elmtsoln,
                                            const MaterialsContainer &t_mateold,
                                            MaterialsContainer &t_mate) override;
+    /**
+     * Compute the material properties of all the qpoints of current batch at once
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output) override;
 
 
 
@@ -16,12 +16,14 @@
 
 #include "MateSystem/BulkMaterialBase.h"
 #include "MateSystem/FreeEnergyMaterialBase.h"
+#include "MateSystem/BatchMaterialBase.h"
 
 /**
  * This class calculate the double well potential 
  */
 class DoubleWellPotentialMaterial:public BulkMaterialBase,
-                                  public FreeEnergyMaterialBase{
+                                  public FreeEnergyMaterialBase,
+                                  public BatchMaterialBase{
 public:
     /**
      * Constructor
@@ -57,6 +59,15 @@ protected:
                                            const LocalElmtSolution &t_elmtsoln,
                                            const MaterialsContainer &t_mateold,
                                            MaterialsContainer &t_mate) override;
+    /**
+     * Compute the material properties of all the qpoints of current batch at once
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output) override;
 
 private:
     /**
@@ -17,12 +17,14 @@
 
 #include "MateSystem/BulkMaterialBase.h"
 #include "MateSystem/ElasticMaterialBase.h"
+#include "MateSystem/BatchMaterialBase.h"
 
 /**
  * This class implement the constitutive law for linear elastic materials
  */
 class LinearElasticMaterial:public BulkMaterialBase,
-                            public ElasticMaterialBase{
+                            public ElasticMaterialBase,
+                            public BatchMaterialBase{
 protected:
     /**
      * Initial the preset material properties, if you don't need the history information of some materials, then you can avoid calling this function
@@ -48,6 +50,15 @@ protected:
                                            const LocalElmtSolution &t_elmtsoln,
                                            const MaterialsContainer &t_mateold,
                                            MaterialsContainer &t_mate) override;
+    /**
+     * Compute the material properties of all the qpoints of current batch at once
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output) override;
 
 private:
     /**
@@ -151,6 +151,12 @@ public:
     inline ScalarMateType& getScalarMaterialsRef(){
         return m_ScalarMaterials;
     }
+    /**
+     * get the const reference of scalar materials
+     */
+    inline const ScalarMateType& getScalarMaterialsRef()const{
+        return m_ScalarMaterials;
+    }
     /**
      * get the copy of scalar materials
      */
@@ -164,6 +170,12 @@ public:
     inline VectorMateType& getVectorMaterialsRef(){
         return m_VectorMaterials;
     }
+    /**
+     * get the const reference of vector materials
+     */
+    inline const VectorMateType& getVectorMaterialsRef()const{
+        return m_VectorMaterials;
+    }
     /**
      * get the copy of vector materials
      */
@@ -177,6 +189,12 @@ public:
     inline Rank2MateType& getRank2MaterialsRef(){
         return m_Rank2Materials;
     }
+    /**
+     * get the const reference of rank-2 materials
+     */
+    inline const Rank2MateType& getRank2MaterialsRef()const{
+        return m_Rank2Materials;
+    }
     /**
      * get the copy of rank-2 materials
      */
@@ -17,13 +17,15 @@
 
 #include "MateSystem/BulkMaterialBase.h"
 #include "MateSystem/ElasticMaterialBase.h"
+#include "MateSystem/BatchMaterialBase.h"
 
 
 /**
  * This class implement the constitutive law for linear elastic materials
  */
 class NeoHookeanMaterial:public BulkMaterialBase,
-                         public ElasticMaterialBase{
+                         public ElasticMaterialBase,
+                         public BatchMaterialBase{
 protected:
     /**
      * Initial the preset material properties, if you don't need the history information of some materials, then you can avoid calling this function
@@ -49,6 +51,15 @@ protected:
                                            const LocalElmtSolution &t_elmtsoln,
                                            const MaterialsContainer &t_mateold,
                                            MaterialsContainer &t_mate) override;
+    /**
+     * Compute the material properties of all the qpoints of current batch at once
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output) override;
 
 private:
     /**
@@ -80,5 +91,6 @@ private:
     Rank2Tensor m_C,m_Cinv;/**< for the right Cauchy-Green tensor and its inverse*/
     Rank2Tensor m_strain,m_pk2_stress,m_stress;/**< local stress and strain tensor */
     Rank4Tensor m_jacobian,m_I4Sym;/**< local jacobian tensor */
+    vector<double> m_BatchWork;/**< the SoA scratch arrays of the batched calculation */
 
 };
\ No newline at end of file
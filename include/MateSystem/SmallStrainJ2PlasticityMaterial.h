@@ -20,13 +20,15 @@
 
 #include "MateSystem/BulkMaterialBase.h"
 #include "MateSystem/PlasticMaterialBase.h"
+#include "MateSystem/BatchMaterialBase.h"
 
 
 /**
  * This class calculate the constitituve laws for J2 plasticity material in small strain case.
 */
 class SmallStrainJ2PlasticityMaterial:public BulkMaterialBase,
-                                      public PlasticMaterialBase{
+                                      public PlasticMaterialBase,
+                                      public BatchMaterialBase{
 public:
     SmallStrainJ2PlasticityMaterial();
     ~SmallStrainJ2PlasticityMaterial();
@@ -57,6 +59,15 @@ protected:
                                            const LocalElmtSolution &t_elmtsoln,
                                            const MaterialsContainer &t_mateold,
                                            MaterialsContainer &t_mate) override;
+    /**
+     * Compute the material properties of all the qpoints of current batch at once
+     * @param t_inputparams the input material parameters read from the input file
+     * @param t_input the SoA solution and the old materials of the qpoints
+     * @param t_output the SoA materials to be calculated
+     */
+    virtual void computeBatchMaterialProperties(const nlohmann::json &t_inputparams,
+                                                const BatchMaterialInput &t_input,
+                                                BatchMaterialOutput &t_output) override;
 
 private:
     /**
@@ -105,6 +116,7 @@ private:
     Rank2Tensor m_stress_trial,m_N;/**< the trial stress and plastic strain tensor */
     Rank2Tensor m_devStress,m_stress,m_dev_strain,m_I;
     Rank4Tensor m_I4Sym;/**< symmetric identity-4 tensor */
+    vector<double> m_BatchWork;/**< the SoA scratch arrays of the batched calculation */
 
 private:
     VectorXd m_args;/**< the arguments for different dofs */
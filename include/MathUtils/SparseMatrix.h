@@ -164,6 +164,12 @@ public:
     inline void disableReallocation(){
         MatSetOption(m_matrix,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);//disable new element insertion
     }
+    /**
+     * keep the zeroed entries in the sparsity pattern, so MatZeroRows does not change the nonzero state
+     */
+    inline void keepNonzeroPattern(){
+        MatSetOption(m_matrix,MAT_KEEP_NONZERO_PATTERN,PETSC_TRUE);
+    }
     //****************************************************************
     //*** add/insert value operations
     //****************************************************************
@@ -0,0 +1,24 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.10
+//+++ Purpose: the forcing term types for the inexact newton method
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+/**
+ * the enum class for the forcing term (relative tolerance of the linear solver) in inexact newton method
+ */
+enum class ForcingTermType{
+    NONE,/**< the fixed tolerance defined in [linearsolver] block */
+    EW1,/**< Eisenstat-Walker choice 1, eta_k=| |R_k|-|R_k-1 + K_k-1*dU_k-1| |/|R_k-1| */
+    EW2 /**< Eisenstat-Walker choice 2, eta_k=gamma*(|R_k|/|R_k-1|)^alpha */
+};
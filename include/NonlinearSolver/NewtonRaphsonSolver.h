@@ -16,6 +16,7 @@
 
 #include "LinearSolver/LinearSolver.h"
 #include "NonlinearSolver/NonlinearSolverBase.h"
+#include "NonlinearSolver/ForcingTermType.h"
 #include "Utils/Timer.h"
 
 
@@ -77,8 +78,62 @@ public:
         m_RRelTol=t_Tolerance;
     }
 
+    /**
+     * set the jacobian lagging iterations, the K matrix and its preconditioner will be rebuilt every k iterations,
+     * k=1 gives the classical newton-raphson method
+     * @param t_LagIters the lagging iterations
+     */
+    void setJacobianLagIterations(int t_LagIters) {
+        m_JacobianLagIters=t_LagIters;
+    }
+
+    /**
+     * allow the lagged jacobian to be reused across the time steps
+     * @param t_Flag true for reusing the jacobian in the following steps
+     */
+    void setLagJacobianAcrossSteps(bool t_Flag) {
+        m_LagJacobianAcrossSteps=t_Flag;
+    }
+
+    /**
+     * set the contraction ratio |R_k|/|R_k-1|, above which the lagged jacobian will be rebuilt
+     * @param t_Ratio the contraction ratio
+     */
+    void setJacobianRefreshRatio(double t_Ratio) {
+        m_JacobianRefreshRatio=t_Ratio;
+    }
+
+    /**
+     * set the forcing term of the inexact newton method, the relative tolerance of the linear solver
+     * will be updated before each linear solve
+     * @param t_Type the forcing term type
+     * @param t_Eta0 the forcing term of the first iteration
+     * @param t_EtaMin the lower bound of the forcing term
+     * @param t_EtaMax the upper bound of the forcing term
+     */
+    void setForcingTerm(ForcingTermType t_Type,double t_Eta0,double t_EtaMin,double t_EtaMax) {
+        m_ForcingTermType=t_Type;
+        m_Eta0=t_Eta0;
+        m_EtaMin=t_EtaMin;
+        m_EtaMax=t_EtaMax;
+    }
+
+    /**
+     * drop the (lagged) jacobian, the next iteration will rebuild it, i.e., when the material parameters are changed
+     */
+    void resetJacobian() {
+        m_HasJacobian=false;
+        m_JacobianAge=0;
+    }
+
     void printSolverInfo()const;
 
+private:
+    /**
+     * compute the forcing term (Eisenstat-Walker) from the residual history
+     */
+    void computeForcingTerm();
+
 
 private:
     int m_MaxIterations;/**< the maximum iterations */
@@ -91,6 +146,23 @@ private:
     double m_dUnorm;/**< the norm of the delta u */
     double m_dUnorm0;/**< the initial norm of the delta u */
 
+    int m_JacobianLagIters;/**< rebuild the jacobian every k iterations */
+    bool m_LagJacobianAcrossSteps;/**< reuse the lagged jacobian in the following time steps */
+    double m_JacobianRefreshRatio;/**< rebuild the jacobian once the contraction rate exceeds this ratio */
+    bool m_HasJacobian;/**< true if the K matrix holds a valid (maybe lagged) jacobian */
+    bool m_RefreshJacobian;/**< true if the jacobian must be rebuilt in the next iteration */
+    int m_JacobianAge;/**< the number of solves since the last jacobian rebuild */
+    int m_JacobianBuilds;/**< the number of jacobian rebuilds in the current step */
+    double m_RnormOld;/**< the residual norm of the previous iteration */
+
+    ForcingTermType m_ForcingTermType;/**< the forcing term type of inexact newton method */
+    double m_Eta0;/**< the initial forcing term */
+    double m_EtaMin;/**< the lower bound of the forcing term */
+    double m_EtaMax;/**< the upper bound of the forcing term */
+    double m_Eta;/**< the current forcing term */
+    double m_LinearRnorm;/**< the linear residual norm |R+K*dU| of the previous solve */
+    int m_KSPIterations;/**< the accumulated linear iterations of the current step */
+
     Timer m_Timer;/**< timer */
 
 };
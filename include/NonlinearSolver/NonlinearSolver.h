@@ -20,6 +20,7 @@
 #include "NewtonRaphsonSolver.h"
 #include "LinearSolver/LinearSolver.h"
 #include "NonlinearSolver/SNESSolver.h"
+#include "NonlinearSolver/StaggeredSolver.h"
 
 
 /**
@@ -27,7 +28,8 @@
  * The R(x)->0 problem will be solved within this class
  */
 class NonlinearSolver:public SNESSolver,
-                      public NewtonRaphsonSolver{
+                      public NewtonRaphsonSolver,
+                      public StaggeredSolver{
 public:
     /**
      * constructor
@@ -17,8 +17,10 @@
 #include <iostream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include "NonlinearSolver/NonlinearSolverType.h"
+#include "NonlinearSolver/ForcingTermType.h"
 
 
 using std::vector;
@@ -37,6 +39,18 @@ public:
         m_RelTolR=5.0e-10;
         m_STol=0.0; // |dx|<|x|*stol
         m_CheckJacobian=false;
+        m_JacobianLagIters=1;
+        m_LagJacobianAcrossSteps=false;
+        m_JacobianRefreshRatio=0.5;
+        m_ForcingTermType=ForcingTermType::NONE;
+        m_Eta0=0.3;
+        m_EtaMax=0.9;
+        m_EtaMin=1.0e-10;
+        m_StaggeredMaxIters=50;
+        m_StaggeredAbsTol=1.0e-7;
+        m_StaggeredRelTol=1.0e-5;
+        m_StaggeredGroupDofNames.clear();
+        m_StaggeredGroupPCNames.clear();
     }
 
     string              m_NlSolverTypeName;/**< the string name of nonlinear solver */
@@ -46,6 +60,18 @@ public:
     double m_RelTolR;/**< the relative tolerance for residual */
     double m_STol;/**< the tolerance for line search */
     bool m_CheckJacobian=false;/**< if this is true, then SNES will compare your jacobian with the finite difference one */
+    int m_JacobianLagIters;/**< rebuild the jacobian (and the preconditioner) every k iterations, only for asfem's NR solver */
+    bool m_LagJacobianAcrossSteps;/**< if true, the lagged jacobian will be reused in the following time steps */
+    double m_JacobianRefreshRatio;/**< force a jacobian rebuild once |R_k|/|R_k-1| exceeds this ratio */
+    ForcingTermType m_ForcingTermType;/**< the forcing term type of the inexact newton method, only for asfem's NR solver */
+    double m_Eta0;/**< the forcing term of the first iteration */
+    double m_EtaMax;/**< the upper bound of the forcing term */
+    double m_EtaMin;/**< the lower bound of the forcing term */
+    int m_StaggeredMaxIters;/**< the maximum staggered passes over all the field groups */
+    double m_StaggeredAbsTol;/**< the absolute tolerance of the field increment |dU| of one staggered pass */
+    double m_StaggeredRelTol;/**< the relative tolerance of the field increment, w.r.t. the one of the first pass */
+    vector<vector<string>> m_StaggeredGroupDofNames;/**< the dof names of each field group */
+    vector<string> m_StaggeredGroupPCNames;/**< the preconditioner of each field group */
 
     /**
      * initialize the nlsolver block
@@ -58,5 +84,17 @@ public:
         m_RelTolR=5.0e-10;
         m_STol=0.0; // |dx|<|x|*stol
         m_CheckJacobian=false;
+        m_JacobianLagIters=1;
+        m_LagJacobianAcrossSteps=false;
+        m_JacobianRefreshRatio=0.5;
+        m_ForcingTermType=ForcingTermType::NONE;
+        m_Eta0=0.3;
+        m_EtaMax=0.9;
+        m_EtaMin=1.0e-10;
+        m_StaggeredMaxIters=50;
+        m_StaggeredAbsTol=1.0e-7;
+        m_StaggeredRelTol=1.0e-5;
+        m_StaggeredGroupDofNames.clear();
+        m_StaggeredGroupPCNames.clear();
     }
 };
\ No newline at end of file
@@ -19,6 +19,7 @@
  */
 enum class NonlinearSolverType{
     ASFEMNR,
+    STAGGERED,
     NEWTON,
     NEWTONLS,
     NEWTONAL,
@@ -0,0 +1,136 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.15
+//+++ Purpose: the staggered (alternate-minimization) solver, each
+//+++          field group is solved by its own newton-raphson
+//+++          iterations on the sub-matrix of the group's dofs
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "LinearSolver/LinearSolver.h"
+#include "NonlinearSolver/NonlinearSolverBase.h"
+#include "Utils/Timer.h"
+
+#include "petsc.h"
+
+using std::vector;
+using std::string;
+
+class StaggeredSolver : public NonlinearSolverBase {
+public:
+    StaggeredSolver();
+
+    /**
+     * solve the nonlinear equation group by group, if success then return true
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dof class
+     * @param t_FE the fe class
+     * @param t_ElmtSystem the element system class
+     * @param t_MateSystem the material system class
+     * @param t_FESystem the fe system class
+     * @param t_BCSystem the boundary condition system
+     * @param t_SolnSystem the solution system class
+     * @param t_EqSystem the equation system class
+     * @param t_LinearSolver the linear solver system
+     * @param t_FECtrlInfo the fe control info
+     */
+    virtual bool solve(FECell &t_FECell,
+                       DofHandler &t_DofHandler,
+                       FE &t_FE,
+                       ElmtSystem &t_ElmtSystem,
+                       MateSystem &t_MateSystem,
+                       FESystem &t_FESystem,
+                       BCSystem &t_BCSystem,
+                       SolutionSystem &t_SolnSystem,
+                       EquationSystem &t_EqSystem,
+                       LinearSolver &t_LinearSolver,
+                       FEControlInfo &t_FECtrlInfo) override;
+
+    /**
+     * get the staggered passes of the last solve
+     */
+    inline int getStaggeredIterationNum()const {
+        return m_StaggeredIters;
+    }
+
+    /**
+     * set the newton-raphson parameters of each field group
+     * @param t_MaxIters the maximum newton iterations of each group
+     * @param t_AbsTol the absolute tolerance of the group residual
+     * @param t_RelTol the relative tolerance of the group residual
+     */
+    void setGroupNRParams(int t_MaxIters,double t_AbsTol,double t_RelTol) {
+        m_GroupMaxIters=t_MaxIters;
+        m_GroupRAbsTol=t_AbsTol;
+        m_GroupRRelTol=t_RelTol;
+    }
+
+    /**
+     * set the parameters of the staggered passes
+     * @param t_MaxIters the maximum staggered passes
+     * @param t_AbsTol the absolute tolerance of the field increment of one pass
+     * @param t_RelTol the relative tolerance of the field increment of one pass
+     */
+    void setStaggeredParams(int t_MaxIters,double t_AbsTol,double t_RelTol) {
+        m_MaxStaggeredIters=t_MaxIters;
+        m_dUAbsTol=t_AbsTol;
+        m_dURelTol=t_RelTol;
+    }
+
+    /**
+     * set the field groups
+     * @param t_GroupDofNames the dof names of each group
+     * @param t_GroupPCNames the preconditioner names of each group
+     */
+    void setFieldGroups(const vector<vector<string>> &t_GroupDofNames,const vector<string> &t_GroupPCNames) {
+        m_GroupDofNames=t_GroupDofNames;
+        m_GroupPCNames=t_GroupPCNames;
+    }
+
+    void printSolverInfo()const;
+
+    void releaseMemory();
+
+private:
+    /**
+     * create the index set, sub-matrix and sub-ksp of each field group
+     * @param t_DofHandler the dof handler class
+     * @param t_EqSystem the equation system class
+     * @param t_SolnSystem the solution system class
+     */
+    void setupFieldGroups(const DofHandler &t_DofHandler,EquationSystem &t_EqSystem,SolutionSystem &t_SolnSystem);
+
+private:
+    int m_GroupMaxIters;/**< the maximum newton iterations of each group */
+    double m_GroupRAbsTol;/**< the absolute tolerance of the group residual */
+    double m_GroupRRelTol;/**< the relative tolerance of the group residual */
+    int m_MaxStaggeredIters;/**< the maximum staggered passes */
+    double m_dUAbsTol;/**< the absolute tolerance of the field increment */
+    double m_dURelTol;/**< the relative tolerance of the field increment */
+    int m_StaggeredIters;/**< the staggered passes of the last solve */
+    int m_TotalGroupIters;/**< the accumulated group newton iterations of the last solve */
+
+    vector<vector<string>> m_GroupDofNames;/**< the dof names of each group */
+    vector<string> m_GroupPCNames;/**< the preconditioner of each group */
+
+    bool m_IsSetup;/**< true if the group ISs and sub-systems are created */
+    vector<IS> m_GroupIS;/**< the index set (rows) of each group */
+    vector<Mat> m_GroupK;/**< the sub-matrix of each group */
+    vector<Vec> m_GroupdU;/**< the sub-solution increment of each group */
+    vector<KSP> m_GroupKSP;/**< the linear solver of each group */
+    Vec m_Upass;/**< the solution at the beginning of current pass */
+
+    Timer m_Timer;/**< timer */
+};
@@ -0,0 +1,91 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.24
+//+++ Purpose: the bounded task queue served by a background
+//+++          output thread
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using std::string;
+
+/**
+ * This class runs the output tasks (file serialization) on a dedicated thread, the tasks are executed
+ * in the order they are pushed. The queue is bounded, if it is full, push() blocks until
+ * the output thread catches up. Each task returns an empty string on success, otherwise the error message.
+ */
+class AsyncOutputQueue{
+public:
+    /**
+     * constructor
+     */
+    AsyncOutputQueue();
+    /**
+     * destructor, the remaining tasks are flushed
+     */
+    ~AsyncOutputQueue();
+
+    AsyncOutputQueue(const AsyncOutputQueue&)=delete;
+    AsyncOutputQueue& operator=(const AsyncOutputQueue&)=delete;
+
+    /**
+     * start the output thread
+     * @param maxdepth the maximum number of pending tasks
+     */
+    void start(const int &maxdepth);
+    /**
+     * push a new task to the queue, it blocks if the queue is full
+     * @param task the output task
+     */
+    void push(std::function<string()> task);
+    /**
+     * wait until all the pending tasks are finished
+     */
+    void flush();
+    /**
+     * flush the queue and stop the output thread
+     */
+    void stop();
+
+    /**
+     * check whether the output thread is running
+     */
+    inline bool isRunning()const{return m_IsRunning;}
+    /**
+     * check whether one of the finished tasks failed, the error message is returned (empty if no error)
+     */
+    string getErrorMessage();
+
+private:
+    /**
+     * the loop of the output thread
+     */
+    void run();
+
+private:
+    std::thread m_Thread;/**< the output thread */
+    std::mutex m_Mutex;/**< the mutex for the queue */
+    std::condition_variable m_TaskCond;/**< notified when a new task is pushed or the thread should stop */
+    std::condition_variable m_SpaceCond;/**< notified when a task is finished */
+    std::deque<std::function<string()>> m_Tasks;/**< the pending tasks */
+    int m_MaxDepth;/**< the maximum number of pending tasks */
+    bool m_IsRunning;/**< true if the output thread is running */
+    bool m_IsBusy;/**< true if the output thread is executing a task */
+    bool m_StopRequested;/**< true if the output thread should exit */
+    string m_ErrorMsg;/**< the message of the first failed task */
+};
@@ -18,6 +18,7 @@
 
 #include "OutputSystem/ResultFileFormat.h"
 #include "OutputSystem/VTUWriter.h"
+#include "OutputSystem/AsyncOutputQueue.h"
 
 
 /**
@@ -44,6 +45,16 @@ public:
      * @param t_format the file format type
      */
     void setFileFormat(const ResultFileFormat &t_format){m_fileformat=t_format;}
+    /**
+     * enable/disable the asynchronous output, if enabled, the result files are written by a background thread
+     * @param flag true for asynchronous output
+     */
+    void setAsyncOutput(const bool &flag){m_async=flag;}
+    /**
+     * setup the maximum number of snapshots waiting for the output thread
+     * @param depth the queue depth
+     */
+    void setQueueDepth(const int &depth){m_queuedepth=depth;}
 
     /**
      * save result to different files according to the output format
@@ -72,6 +83,10 @@ public:
      * save the end info of pvd file
      */
     void savePVDEnd();
+    /**
+     * wait for all the pending output tasks and stop the output thread, it must be called before exit
+     */
+    void flush();
 
     //*****************************************************
     //*** general gettings
@@ -84,12 +99,28 @@ public:
      * get the output interval number
      */
     inline int getIntervalNum()const{return m_intervals;}
+    /**
+     * check whether the asynchronous output is enabled
+     */
+    inline bool isAsyncOutput()const{return m_async;}
 
     /**
      * print out the output system info
      */
     void printInfo()const;
 
+private:
+    /**
+     * run the output task on the master rank, it is pushed to the output thread for asynchronous output,
+     * otherwise it is executed in place
+     * @param task the task returns an empty string on success, otherwise the error message
+     */
+    void runOutputTask(std::function<string()> task);
+    /**
+     * stop the simulation if one of the asynchronous output tasks failed
+     */
+    void checkOutputError();
+
 
 private:
     string m_inputfile_name;/**< for the string name of input file */
@@ -98,6 +129,9 @@ private:
     ResultFileFormat m_fileformat;/**< for the result file format */
 
     int m_intervals;/**< the output interval number */
+    bool m_async;/**< true for the asynchronous output */
+    int m_queuedepth;/**< the maximum number of pending output tasks */
+    AsyncOutputQueue m_outputqueue;/**< the queue served by the output thread */
 
 private:
     PetscMPIInt m_rank;/** for the processor id */
@@ -14,8 +14,31 @@
 
 #pragma once
 
+#include <memory>
+
 #include "OutputSystem/ResultWriterBase.h"
 
+/**
+ * The rank-0 copy of everything needed to write one vtu file, it doesn't hold any PETSc object,
+ * so it can be serialized by the background output thread while the solver moves on
+ */
+struct VTUSnapshot{
+    string m_FileName;/**< the name of the vtu file */
+    std::shared_ptr<const string> m_GeometryTxt;/**< the formatted points and cells block, shared by all the steps */
+    std::shared_ptr<const string> m_NodeOrigIDTxt;/**< the formatted original node ids of the reordered mesh, null if the mesh is not reordered */
+    int m_NodesNum=0;/**< the number of nodes */
+    vector<string> m_DofNames;/**< the dof names */
+    vector<string> m_ScalarNames;/**< the projected scalar material names */
+    vector<string> m_VectorNames;/**< the projected vector material names */
+    vector<string> m_Rank2Names;/**< the projected rank-2 material names */
+    vector<string> m_Rank4Names;/**< the projected rank-4 material names */
+    vector<double> m_U;/**< the nodal solution, stored as (node-1)*dofs+dof-1 */
+    vector<vector<double>> m_ScalarVals;/**< the projected scalar values of each material */
+    vector<vector<double>> m_VectorVals;/**< the projected vector values of each material, 3 components per node */
+    vector<vector<double>> m_Rank2Vals;/**< the projected rank-2 values of each material, 9 components per node */
+    vector<vector<double>> m_Rank4Vals;/**< the projected rank-4 values of each material, 36 components per node */
+};
+
 /**
  * Save results to vtu file
  */
@@ -40,7 +63,38 @@ public:
                              SolutionSystem &t_solution,
                              ProjectionSystem &t_projection) override;
 
+    /**
+     * gather the solution and the projected fields to the master rank, this is a collective call.
+     * only the master rank's snapshot is filled, the others are left empty
+     * @param t_filename the string name of result file
+     * @param t_fecell the mesh class
+     * @param t_dofHandler the dofhandler class
+     * @param t_solution the solution class
+     * @param t_projection the projection class
+     * @param t_snapshot the snapshot to be filled
+     */
+    void takeSnapshot(const string &t_filename,
+                      const FECell &t_fecell,
+                      const DofHandler &t_dofHandler,
+                      SolutionSystem &t_solution,
+                      ProjectionSystem &t_projection,
+                      VTUSnapshot &t_snapshot);
+
+    /**
+     * write the snapshot to its vtu file, it doesn't call any PETSc/MPI function, so it is safe
+     * to call it from the output thread. An empty string is returned on success, otherwise the error message
+     * @param t_snapshot the snapshot taken on the master rank
+     */
+    static string writeSnapshot(const VTUSnapshot &t_snapshot);
+
+    /**
+     * drop the cached geometry text, it must be called if the mesh is changed
+     */
+    void resetGeometryCache(){m_GeometryTxt.reset();m_NodeOrigIDTxt.reset();}
+
 private:
     PetscMPIInt m_rank;/**< the processor id */
+    std::shared_ptr<const string> m_GeometryTxt;/**< the cached points and cells block of the vtu file */
+    std::shared_ptr<const string> m_NodeOrigIDTxt;/**< the cached original node ids of the reordered mesh */
 
 };
\ No newline at end of file
@@ -0,0 +1,143 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.10
+//+++ Purpose: the probe service for nodal and point value monitors,
+//+++          each probe is resolved to its owner rank once, and
+//+++          all the probe values are gathered by one MPI_Gatherv
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include "petsc.h"
+
+#include "MathUtils/Vector3d.h"
+#include "FECell/FECell.h"
+#include "DofHandler/DofHandler.h"
+#include "SolutionSystem/SolutionSystem.h"
+#include "ProjectionSystem/ProjectionSystem.h"
+#include "FE/FE.h"
+
+/**
+ * the source vector of a probe term
+ */
+enum class ProbeSource{
+    SOLUTION,
+    SCALARMATE,
+    VECTORMATE,
+    RANK2MATE
+};
+
+/**
+ * This class evaluates the sensor-like monitors. Each probe value is a weighted sum of a few entries of the solution
+ * or projection vectors, i.e., one entry for a nodal value, and the shape function weighted entries of the host
+ * element for a point value. Only the owner rank of each entry reads it from its local array, the partial sums are
+ * collected on the master rank by a single MPI_Gatherv, so no ghost copy of the global vector is needed.
+ */
+class PointProbe{
+public:
+    /**
+     * constructor
+     */
+    PointProbe();
+
+    /**
+     * add the probe of one vector entry
+     * @param slot the slot index of the probe result, start from 0
+     * @param source the source vector type
+     * @param sourceid the index of the source vector in its projection list, start from 0 (0 for the solution)
+     * @param index the global index of the entry, start from 1
+     */
+    void addEntryProbe(const int &slot,const ProbeSource &source,const int &sourceid,const int &index);
+    /**
+     * add the probe of a dof's value at an arbitrary point, the host element is searched among the local bulk
+     * cells of all the ranks, this function must be called by all the ranks
+     * @param slot the slot index of the probe result, start from 0
+     * @param point the coordinates of the point
+     * @param dofid the local dof id, start from 1
+     * @param t_fecell the fe cell class
+     * @param t_dofhandler the dof handler class
+     * @param t_fe the fe space class
+     * @return false if the point is outside of the mesh
+     */
+    bool addPointProbe(const int &slot,const Vector3d &point,const int &dofid,
+                       const FECell &t_fecell,const DofHandler &t_dofhandler,FE &t_fe);
+
+    /**
+     * resolve the owner rank and local offset of all the probe terms, this function must be called by all the
+     * ranks after all the probes are added
+     * @param t_soln the solution system
+     * @param t_projsystem the projection system
+     */
+    void setup(SolutionSystem &t_soln,ProjectionSystem &t_projsystem);
+
+    /**
+     * gather the probe values to the master rank, only the master rank's values are updated
+     * @param t_soln the solution system
+     * @param t_projsystem the projection system
+     * @param values the result vector, the value of each probe is written to its slot
+     */
+    void gatherProbeValues(SolutionSystem &t_soln,ProjectionSystem &t_projsystem,vector<double> &values);
+
+    /**
+     * check whether the probes are resolved
+     */
+    inline bool isSetup()const{return m_IsSetup;}
+    /**
+     * get the number of probe terms
+     */
+    inline int getProbeTermsNum()const{return static_cast<int>(m_Terms.size());}
+
+    /**
+     * release the allocated memory
+     */
+    void releaseMemory();
+
+private:
+    /**
+     * get the source vector of the probe term
+     * @param source the source vector type
+     * @param sourceid the index of the source vector in its projection list
+     * @param t_soln the solution system
+     * @param t_projsystem the projection system
+     */
+    static Vector& getSourceVector(const ProbeSource &source,const int &sourceid,
+                                   SolutionSystem &t_soln,ProjectionSystem &t_projsystem);
+    /**
+     * search the local coordinates of the given point in the given cell by the newton iteration of the isoparametric map
+     * @param cell the mesh cell
+     * @param point the coordinates of the point
+     * @param t_shp the shape function class of the bulk element
+     * @param xi the local coordinates of the point
+     * @return true if the point is inside the cell
+     */
+    static bool locatePointInCell(const SingleMeshCell &cell,const Vector3d &point,ShapeFun &t_shp,double (&xi)[3]);
+
+private:
+    /**
+     * the single term of a probe, the probe value is the sum of weight*vector(index) of all its terms
+     */
+    struct ProbeTerm{
+        int Slot;/**< the slot index of the probe result */
+        ProbeSource Source;/**< the source vector type */
+        int SourceID;/**< the index of the source vector in its projection list */
+        int Index;/**< the global index of the entry, start from 1 */
+        double Weight;/**< the weight of the entry */
+    };
+    vector<ProbeTerm> m_Terms;/**< all the probe terms, same on all the ranks */
+    vector<ProbeTerm> m_LocalTerms;/**< the probe terms owned by current rank, the index is the local array offset */
+    vector<double> m_LocalValues;/**< the partial values of the local terms */
+    vector<int> m_GatheredSlots;/**< the slot index of each gathered value (master rank only) */
+    vector<double> m_GatheredValues;/**< the gathered partial values (master rank only) */
+    vector<int> m_RecvCounts;/**< the number of terms owned by each rank (master rank only) */
+    vector<int> m_Displs;/**< the displacement of each rank in the gathered values (master rank only) */
+    bool m_IsSetup;/**< the flag for the setup status */
+
+};
@@ -31,6 +31,7 @@
 
 #include "Postprocess/PostprocessorType.h"
 #include "Postprocess/PostprocessorBlock.h"
+#include "Postprocess/PointProbe.h"
 
 /**
  * For different postprocessors
@@ -182,6 +183,15 @@ public:
         return m_output_interval;
     }
 
+    /**
+     * invalidate the probes, they are located and resolved to their owner ranks again before the next postprocess
+     * step, this must be called once the mesh or the vector layout is changed
+     */
+    inline void resetProbes(){
+        m_probe.releaseMemory();
+        m_pps_isprobed.assign(m_pps_blocksnum,false);
+    }
+
     /**
      * release the allocated memory
      */
@@ -193,6 +203,20 @@ public:
     void printInfo()const;
 
 private:
+    /**
+     * resolve all the nodal value, nodal material (except the rank-4 one) and point value pps to the probe service,
+     * this is done only once before the first postprocess step
+     * @param t_fecell the fe cell class
+     * @param t_dofhandler the dof handler class
+     * @param t_fe the fe space class
+     * @param t_soln the solution system
+     * @param t_projsystem the projection system
+     */
+    void setupPointProbes(const FECell &t_fecell,
+                          const DofHandler &t_dofhandler,
+                          FE &t_fe,
+                          SolutionSystem &t_soln,
+                          ProjectionSystem &t_projsystem);
     /**
      * execute the nodal type postprocess
      * @param pps_type the type of postprocess
@@ -209,26 +233,23 @@ private:
                                    SolutionSystem &t_soln,
                                    ProjectionSystem &t_projsystem);
     /**
-     * execute the side integral type postprocess
-     * @param pps_type the type of postprocess
-     * @param dofid the local id of the specific dof
-     * @param sidenames the sides name vector
-     * @param t_parameters the json parameters taken from input file
+     * accumulate the local side integral and side area of all the pps blocks defined on the given side, the
+     * shape functions of each qpoint are evaluated only once and shared by all these blocks
+     * @param sidename the string name of the side
+     * @param blockids the index (start from 1) of the pps blocks defined on current side
      * @param t_fecell the fe cell class
      * @param t_dofhandler the dof handler class
      * @param t_fe the fe space class
      * @param t_soln the solution system
      * @param t_projsystem the projection system
      */
-    double executeSideIntegralPostprocess(const PostprocessorType &pps_type,
-                                          const int &dofid,
-                                          const vector<string> &sidenames,
-                                          const nlohmann::json &t_parameters,
-                                          const FECell &t_fecell,
-                                          const DofHandler &t_dofhandler,
-                                          FE &t_fe,
-                                          SolutionSystem &t_soln,
-                                          ProjectionSystem &t_projsystem);
+    void accumulateSideIntegralPostprocess(const string &sidename,
+                                           const vector<int> &blockids,
+                                           const FECell &t_fecell,
+                                           const DofHandler &t_dofhandler,
+                                           FE &t_fe,
+                                           SolutionSystem &t_soln,
+                                           ProjectionSystem &t_projsystem);
     
     /**
      * execute the side integral postprocess libs
@@ -251,26 +272,23 @@ private:
                                           ProjectionSystem &t_projsystem);
 
     /**
-     * execute the volume integral type postprocess
-     * @param pps_type the type of postprocess
-     * @param dofid the local id of the specific dof
-     * @param domainnames the domain name vector
-     * @param t_parameters the json parameters taken from input file
+     * accumulate the local volume integral and domain volume of all the pps blocks defined on the given domain, the
+     * shape functions of each qpoint are evaluated only once and shared by all these blocks
+     * @param domainname the string name of the domain
+     * @param blockids the index (start from 1) of the pps blocks defined on current domain
      * @param t_fecell the fe cell class
      * @param t_dofhandler the dof handler class
      * @param t_fe the fe space class
      * @param t_soln the solution system
      * @param t_projsystem the projection system
      */
-    double executeVolumeIntegralPostprocess(const PostprocessorType &pps_type,
-                                            const int &dofid,
-                                            const vector<string> &domainnames,
-                                            const nlohmann::json &t_parameters,
-                                            const FECell &t_fecell,
-                                            const DofHandler &t_dofhandler,
-                                            FE &t_fe,
-                                            SolutionSystem &t_soln,
-                                            ProjectionSystem &t_projsystem);
+    void accumulateVolumeIntegralPostprocess(const string &domainname,
+                                             const vector<int> &blockids,
+                                             const FECell &t_fecell,
+                                             const DofHandler &t_dofhandler,
+                                             FE &t_fe,
+                                             SolutionSystem &t_soln,
+                                             ProjectionSystem &t_projsystem);
     /**
      * execute the volume integral postprocess libs
      * @param pps_type the type of postprocess
@@ -297,16 +315,19 @@ private:
     int m_output_interval;/**< the output interval */
     vector<string> m_pps_namelist;/**< the name vector for the final postprocessed variables */
     vector<double> m_pps_values;/**< the value vector for the final postprocessed variables */
+    vector<double> m_pps_localsums;/**< the local (integral,measure) pair of each pps block, packed for one reduction */
+    vector<double> m_pps_globalsums;/**< the reduced (integral,measure) pair of each pps block */
 
     //***********************
     vector<PostprocessorBlock> m_pps_blocklist;/**< for the postprocess block defined in input file */
     int m_pps_blocksnum;/**< number of pps blocks */
 
+    PointProbe m_probe;/**< the probe service for the nodal and point value pps */
+    vector<bool> m_pps_isprobed;/**< whether the pps block is evaluated by the probe service */
+
     LocalElmtInfo m_local_elmtinfo;/**< for the local element info data structure */
     LocalShapeFun m_local_shp;/**< for the local shape function */
     Nodes m_nodes0,m_nodes;/**< the nodal coordinates of current element */
-    Rank2Tensor m_xs;
-    Vector3d m_normal;/**< the normal vector */
 
 private:
     PetscMPIInt m_rank;/**< the local rank */
@@ -24,6 +24,7 @@ enum class PostprocessorType{
     NODALVECTORMATERIALVALUE,
     NODALRANK2MATERIALVALUE,
     NODALRANK4MATERIALVALUE,
+    POINTVALUE,
     //*********************************
     // for side type pps
     //*********************************
@@ -17,6 +17,7 @@
 
 
 #include "ProjectionSystem/ProjectionBase.h"
+#include "FE/ReducedIntegration.h"
 
 /**
  * This class implements the least square projection from integration points to nodal points
@@ -194,6 +195,10 @@ private:
     Nodes m_Nodes;/**< for the nodal coordinates of current bulk element (current configuration) */
     Nodes m_Nodes0;/**< for the nodal coordinates of current bulk element (reference configuration) */
 
+    ReducedIntegration m_ReducedIntegration;/**< for the mean dilatation of the selective reduced integration blocks */
+    vector<double> m_SubElmtMeanDilatation;/**< the mean dilatation of each sub element */
+    vector<double> m_ReducedNodalU;/**< the nodal displacements of current element */
+
     LocalElmtInfo m_LocalElmtInfo;/**< for the local element information */
     LocalElmtSolution m_LocalElmtSoln;/**< for the local element solution */
 
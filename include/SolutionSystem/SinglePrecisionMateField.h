@@ -0,0 +1,29 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.16
+//+++ Purpose: the single-precision storage of one qpoint material
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <vector>
+
+using std::vector;
+
+/**
+ * This struct stores the values of one material on all the local qpoints in single precision,
+ * the components of each qpoint are stored contiguously, i.e., vals[(e-1)*qpnum*ncomp+(qp-1)*ncomp+k]
+ */
+struct SinglePrecisionMateField{
+    int m_ComponentsNum=0;/**< 1 for scalar, 3 for vector, 9 for rank-2, and 81 for rank-4 tensor materials */
+    vector<float> m_Vals;/**< the values of current step */
+    vector<float> m_ValsOld;/**< the values of the previous step */
+};
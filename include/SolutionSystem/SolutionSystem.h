@@ -15,9 +15,14 @@
 
 #pragma once
 
+#include <set>
+
 #include "MathUtils/Vector.h"
 #include "MateSystem/MaterialsName.h"
+#include "MateSystem/MaterialsContainer.h"
+#include "SolutionSystem/SinglePrecisionMateField.h"
 #include "DofHandler/DofHandler.h"
+#include "FECell/FECellAdaptivity.h"
 #include "FE/FE.h"
 
 
@@ -46,6 +51,72 @@ public:
      * update materials vectors
      */
     void updateMaterialsSolution();
+    /**
+     * move the qpoint materials (current and old) of the local elements to their new owner ranks after the re-partition,
+     * the solution vectors are distributed by dofs, so they don't need to be moved
+     * @param t_OldPartInfo the rank id of each bulk element before the re-partition
+     * @param t_NewPartInfo the rank id of each bulk element after the re-partition
+     */
+    void migrateLocalQpMaterials(const vector<int> &t_OldPartInfo,const vector<int> &t_NewPartInfo);
+    /**
+     * move the solution vectors and the qpoint materials to the adapted mesh, the nodal values are interpolated from
+     * the old nodes, and each new qpoint takes the history of the nearest qpoint of the old element which covers it.
+     * The dofs map and the partition info must already be updated to the new mesh.
+     * @param t_Transfer the mapping between the old and new mesh, the element part is only used on the master rank
+     * @param t_DofHandler the dofhandler of the new mesh
+     * @param t_FE the fe space class
+     * @param t_OldPartInfo the rank id of each old bulk element
+     * @param t_NewPartInfo the rank id of each new bulk element
+     */
+    void transferSolution(const MeshTransferData &t_Transfer,const DofHandler &t_DofHandler,const FE &t_FE,
+                          const vector<int> &t_OldPartInfo,const vector<int> &t_NewPartInfo);
+
+    /**
+     * set the materials whose qpoint values are stored in single precision, the materials are still computed in double,
+     * only their storage (current and old) is reduced
+     * @param t_MateNames the name list of the single-precision materials
+     */
+    void setSinglePrecisionMaterials(const vector<string> &t_MateNames);
+    /**
+     * check whether any material is stored in single precision
+     */
+    inline bool hasSinglePrecisionMaterials()const{return !m_SinglePrecisionMateNames.empty();}
+    /**
+     * save the materials of one local qpoint, the single-precision ones are stored in the float arrays
+     * @param e the local element id, start from 1
+     * @param qp the qpoint id, start from 1
+     * @param t_Mate the materials container
+     * @param t_IsOld true for saving them as the materials of the previous step
+     */
+    void saveLocalQpMaterials(const int &e,const int &qp,MaterialsContainer &t_Mate,const bool &t_IsOld);
+    /**
+     * load the materials of the previous step of one local qpoint
+     * @param e the local element id, start from 1
+     * @param qp the qpoint id, start from 1
+     * @param t_MateOld the materials container to be filled
+     */
+    void loadLocalQpMaterialsOld(const int &e,const int &qp,MaterialsContainer &t_MateOld)const;
+    /**
+     * get the current scalar material of one local qpoint, no matter which precision it is stored in
+     * @param e the local element id, start from 1
+     * @param qp the qpoint id, start from 1
+     * @param t_MateName the material name
+     * @param t_Val the material value
+     * @return false if the material can't be found
+     */
+    bool getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,double &t_Val)const;
+    /**
+     * get the current vector material of one local qpoint, no matter which precision it is stored in
+     */
+    bool getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Vector3d &t_Val)const;
+    /**
+     * get the current rank-2 tensor material of one local qpoint, no matter which precision it is stored in
+     */
+    bool getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Rank2Tensor &t_Val)const;
+    /**
+     * get the current rank-4 tensor material of one local qpoint, no matter which precision it is stored in
+     */
+    bool getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Rank4Tensor &t_Val)const;
 
     /**
      * release the allocated memory
@@ -241,10 +312,17 @@ public:
     vector<Rank2MateType>  m_QpointsRank2MaterialsOld_Local;/**< for rank-2 materials of each gauss point */
     vector<Rank4MateType>  m_QpointsRank4MaterialsOld_Local;/**< for rank-4 materials of each gauss point */
 
+    //*** for the materials stored in single precision, they are removed from the maps above
+    map<string,SinglePrecisionMateField> m_SinglePrecisionScalarMaterials_Local;/**< for single-precision scalar materials of the local qpoints */
+    map<string,SinglePrecisionMateField> m_SinglePrecisionVectorMaterials_Local;/**< for single-precision vector materials of the local qpoints */
+    map<string,SinglePrecisionMateField> m_SinglePrecisionRank2Materials_Local;/**< for single-precision rank-2 materials of the local qpoints */
+    map<string,SinglePrecisionMateField> m_SinglePrecisionRank4Materials_Local;/**< for single-precision rank-4 materials of the local qpoints */
+
 private:
     bool m_Allocated;/**< boolean flag for the allocation status */
     int m_BulkElmtsNum;/**< the number of total bulk elements */
     int m_BulkElmtsNum_Local;/**< the number of local bulk elements */
     int m_QpointsNum;/**< for the number of gauss points of each bulk element */
+    std::set<string> m_SinglePrecisionMateNames;/**< the names of the materials stored in single precision */
 
 };
\ No newline at end of file
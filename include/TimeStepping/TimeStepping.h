@@ -92,6 +92,70 @@ public:
      * @param flag true to enable the adaptive time stepping
      */
     void setAdaptiveFlag(const bool &flag){m_Data.m_IsAdaptive=flag;}
+    /**
+     * setup the step interval of the load balance check
+     * @param interval the step interval, 0 means no rebalance
+     */
+    void setRebalanceInterval(const int &interval){m_Data.m_RebalanceInterval=interval;}
+    /**
+     * setup the imbalance threshold which triggers the rebalance
+     * @param threshold the threshold of max/avg-1 of the rank assembly time
+     */
+    void setRebalanceThreshold(const double &threshold){m_Data.m_RebalanceThreshold=threshold;}
+    /**
+     * setup the step interval of the mesh adaptivity
+     * @param interval the step interval, 0 means no mesh adaptivity
+     */
+    void setMeshAdaptInterval(const int &interval){m_Data.m_AdaptInterval=interval;}
+    /**
+     * setup the adaptation passes applied to the initial conditions
+     * @param steps the number of passes
+     */
+    void setMeshAdaptInitialSteps(const int &steps){m_Data.m_AdaptInitialSteps=steps;}
+    /**
+     * setup the dof name which drives the marker of the mesh adaptivity
+     * @param dofname the dof name
+     */
+    void setMeshAdaptDofName(const string &dofname){m_Data.m_AdaptDofName=dofname;}
+    /**
+     * setup the marker type of the mesh adaptivity
+     * @param marker the marker type
+     */
+    void setMeshAdaptMarker(const MeshAdaptMarkerType &marker){m_Data.m_AdaptMarker=marker;}
+    /**
+     * setup the refine and coarsen thresholds of the marker
+     * @param refine the refine threshold
+     * @param coarsen the coarsen threshold
+     */
+    void setMeshAdaptThresholds(const double &refine,const double &coarsen){
+        m_Data.m_AdaptRefine=refine;
+        m_Data.m_AdaptCoarsen=coarsen;
+    }
+    /**
+     * setup the maximum refinement level of the mesh adaptivity
+     * @param level the maximum level
+     */
+    void setMeshAdaptMaxLevel(const int &level){m_Data.m_AdaptMaxLevel=level;}
+    /**
+     * setup the lumped mass of the explicit dynamics
+     * @param lumptype the lumping scheme
+     */
+    void setLumpedMassType(const LumpedMassType &lumptype){m_Data.m_LumpedMassType=lumptype;}
+    /**
+     * setup the cfl factor of the explicit sub-step
+     * @param cfl the cfl factor, it should be smaller than 1
+     */
+    void setCFLFactor(const double &cfl){m_Data.m_CFLFactor=cfl;}
+    /**
+     * setup the estimation of the explicit sub-step
+     * @param flag true to estimate the stable dt, false to use dt0 directly
+     */
+    void setStableDtEstimation(const bool &flag){m_Data.m_EstimateStableDt=flag;}
+    /**
+     * setup the maximum explicit sub-steps of each step
+     * @param steps the maximum sub-steps
+     */
+    void setMaxSubSteps(const int &steps){m_Data.m_MaxSubSteps=steps;}
 
     /**
      * apply the default time stepping settings
@@ -139,6 +203,18 @@ public:
      * get the adaptive status
      */
     inline bool isAdaptive()const{return m_Data.m_IsAdaptive;}
+    /**
+     * get the step interval of the load balance check
+     */
+    inline int getRebalanceInterval()const{return m_Data.m_RebalanceInterval;}
+    /**
+     * get the imbalance threshold of the rebalance
+     */
+    inline double getRebalanceThreshold()const{return m_Data.m_RebalanceThreshold;}
+    /**
+     * get the step interval of the mesh adaptivity
+     */
+    inline int getMeshAdaptInterval()const{return m_Data.m_AdaptInterval;}
     /**
      * get the time integration method
      */
@@ -182,6 +258,88 @@ public:
 
 
 
+private:
+    /**
+     * solve the dynamic equation with the explicit central difference scheme, M*a=-R(u), where M is the lumped mass,
+     * each sub-step only needs one residual evaluation. The output and postprocess intervals count the steps of dt0,
+     * each of them is split into the sub-steps of the stable dt.
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dof class
+     * @param t_FE the fe class
+     * @param t_ElmtSystem the element system class
+     * @param t_MateSystem the material system class
+     * @param t_FESystem the fe system class
+     * @param t_BCSystem the boundary condition system
+     * @param t_ICSystem the initial condition system
+     * @param t_SolnSystem the solution system class
+     * @param t_EqSystem the equation system class
+     * @param t_ProjSystem the projection system
+     * @param t_FECtrlInfo the fe control info
+     * @param t_Output  the output system
+     * @param t_PostProcess the postprocess system
+     */
+    bool solveExplicit(FECell &t_FECell,
+                       DofHandler &t_DofHandler,
+                       FE &t_FE,
+                       ElmtSystem &t_ElmtSystem,
+                       MateSystem &t_MateSystem,
+                       FESystem &t_FESystem,
+                       BCSystem &t_BCSystem,
+                       ICSystem &t_ICSystem,
+                       SolutionSystem &t_SolnSystem,
+                       EquationSystem &t_EqSystem,
+                       ProjectionSystem &t_ProjSystem,
+                       FEControlInfo &t_FECtrlInfo,
+                       OutputSystem &t_Output,
+                       Postprocessor &t_PostProcess);
+
+    /**
+     * check the rank-time imbalance of the bulk assembly, if it exceeds the threshold, re-partition the bulk elements
+     * by their measured cost and migrate the local data to the new owner ranks
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dof class
+     * @param t_ElmtSystem the element system class
+     * @param t_FESystem the fe system class
+     * @param t_SolnSystem the solution system class
+     */
+    void rebalanceBulkElmts(FECell &t_FECell,
+                            DofHandler &t_DofHandler,
+                            ElmtSystem &t_ElmtSystem,
+                            FESystem &t_FESystem,
+                            SolutionSystem &t_SolnSystem);
+
+    /**
+     * refine and coarsen the mesh by the marker of the adapted dof, then rebuild the dofs map, the sparsity pattern
+     * and the solvers, and transfer the solution vectors and the qpoint materials to the new mesh
+     * @param t_FECell the fe cell class
+     * @param t_DofHandler the dof class
+     * @param t_FE the fe class
+     * @param t_ElmtSystem the element system class
+     * @param t_FESystem the fe system class
+     * @param t_BCSystem the boundary condition system
+     * @param t_SolnSystem the solution system class
+     * @param t_EqSystem the equation system class
+     * @param t_ProjSystem the projection system
+     * @param t_LinearSolver the linear solver system
+     * @param t_NLSolver the nonlinear solver
+     * @param t_Output  the output system
+     * @param t_PostProcess the postprocess system
+     * @return true if the mesh is changed
+     */
+    bool adaptMesh(FECell &t_FECell,
+                   DofHandler &t_DofHandler,
+                   FE &t_FE,
+                   ElmtSystem &t_ElmtSystem,
+                   FESystem &t_FESystem,
+                   BCSystem &t_BCSystem,
+                   SolutionSystem &t_SolnSystem,
+                   EquationSystem &t_EqSystem,
+                   ProjectionSystem &t_ProjSystem,
+                   LinearSolver &t_LinearSolver,
+                   NonlinearSolver &t_NLSolver,
+                   OutputSystem &t_Output,
+                   Postprocessor &t_PostProcess);
+
 private:
     TimeSteppingData m_Data;/**< the time stepping data */
 
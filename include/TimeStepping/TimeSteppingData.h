@@ -14,6 +14,13 @@
 
 #pragma once
 
+#include <string>
+
+#include "FECell/FECellAdaptivity.h"
+#include "FESystem/LumpedMassType.h"
+
+using std::string;
+
 /**
  * time stepping data
  */
@@ -28,6 +35,19 @@ struct TimeSteppingData{
     double m_GrowthFactor;/**< the growth factor for time adaptive */
     bool m_IsAdaptive;/**< boolean flag for adaptive */
     int m_OptimizeIters=3;/**< optimize nonlinear iterations for time adaptive */
+    int m_RebalanceInterval=0;/**< check the load balance every n steps, 0 means no rebalance */
+    double m_RebalanceThreshold=0.2;/**< rebalance once the rank-time imbalance (max/avg-1) exceeds this value */
+    int m_AdaptInterval=0;/**< adapt the mesh every n steps, 0 means no mesh adaptivity */
+    int m_AdaptInitialSteps=0;/**< the adaptation passes applied to the initial conditions */
+    string m_AdaptDofName;/**< the dof whose nodal values drive the marker */
+    MeshAdaptMarkerType m_AdaptMarker=MeshAdaptMarkerType::GRADIENT;/**< the marker type of the mesh adaptivity */
+    double m_AdaptRefine=0.5;/**< the refine threshold of the marker */
+    double m_AdaptCoarsen=0.05;/**< the coarsen threshold of the marker */
+    int m_AdaptMaxLevel=2;/**< the maximum refinement level */
+    LumpedMassType m_LumpedMassType=LumpedMassType::ROWSUM;/**< the lumped mass of the explicit dynamics */
+    double m_CFLFactor=0.9;/**< the explicit sub-step is cfl*min(h_e/c_e) */
+    bool m_EstimateStableDt=true;/**< true if the explicit sub-step comes from the cfl estimate, otherwise dt0 is used */
+    int m_MaxSubSteps=100000;/**< the maximum explicit sub-steps of each (output) step */
 
     TimeSteppingType m_SteppingType;/**< the time stepping type */
 };
@@ -18,5 +18,6 @@ enum class TimeSteppingType{
     STATIC,
     BACKWARDEULER,
     CRANCKNICOLSON,
-    BDF2
+    BDF2,
+    EXPLICIT
 };
\ No newline at end of file
@@ -0,0 +1,242 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.05
+//+++ Purpose: simple binary writer/reader for the raw byte buffer,
+//+++          which is used by the cache file and data packing
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+using std::string;
+using std::vector;
+
+/**
+ * This class appends the plain data, strings and vectors into a contiguous byte buffer
+ */
+class BinaryWriter{
+public:
+    /**
+     * write a plain (trivially copyable) value
+     * @param value the value to be written
+     */
+    template<typename T>
+    inline void writeValue(const T &value){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be written");
+        const char *p=reinterpret_cast<const char*>(&value);
+        m_Data.insert(m_Data.end(),p,p+sizeof(T));
+    }
+    /**
+     * write a string, the length is written first
+     * @param str the string to be written
+     */
+    inline void writeString(const string &str){
+        writeValue(static_cast<uint64_t>(str.size()));
+        m_Data.insert(m_Data.end(),str.begin(),str.end());
+    }
+    /**
+     * write a vector of plain values, the length is written first
+     * @param vec the vector to be written
+     */
+    template<typename T>
+    inline void writeVector(const vector<T> &vec){
+        writeArray(vec.data(),vec.size());
+    }
+    /**
+     * write an array of plain values, the length is written first
+     * @param data the pointer of the array
+     * @param n the length of the array
+     */
+    template<typename T>
+    inline void writeArray(const T *data,const size_t &n){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be written");
+        writeValue(static_cast<uint64_t>(n));
+        if(n<1) return;
+        const char *p=reinterpret_cast<const char*>(data);
+        m_Data.insert(m_Data.end(),p,p+n*sizeof(T));
+    }
+    /**
+     * write an array of plain values without the length, the reader must know the length
+     * @param data the pointer of the array
+     * @param n the length of the array
+     */
+    template<typename T>
+    inline void writeRawArray(const T *data,const size_t &n){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be written");
+        if(n<1) return;
+        const char *p=reinterpret_cast<const char*>(data);
+        m_Data.insert(m_Data.end(),p,p+n*sizeof(T));
+    }
+    /**
+     * write a vector of strings, the length is written first
+     * @param vec the string vector to be written
+     */
+    inline void writeStringVector(const vector<string> &vec){
+        writeValue(static_cast<uint64_t>(vec.size()));
+        for(const auto &str:vec) writeString(str);
+    }
+
+    /**
+     * reserve the memory of the buffer
+     * @param n the number of bytes
+     */
+    inline void reserve(const size_t &n){m_Data.reserve(n);}
+    /**
+     * clear the buffer
+     */
+    inline void clear(){m_Data.clear();}
+    /**
+     * get the size of the buffer
+     */
+    inline size_t getSize()const{return m_Data.size();}
+    /**
+     * get the pointer of the buffer
+     */
+    inline const char* getData()const{return m_Data.data();}
+    /**
+     * get the reference of the buffer
+     */
+    inline vector<char>& getDataRef(){return m_Data;}
+
+private:
+    vector<char> m_Data;/**< the byte buffer */
+};
+
+/**
+ * This class reads the plain data, strings and vectors from a byte buffer (which is not owned by the reader),
+ * once a read goes beyond the buffer, the reader becomes invalid and all the following reads fail
+ */
+class BinaryReader{
+public:
+    /**
+     * constructor
+     * @param data the pointer of the byte buffer
+     * @param size the size of the byte buffer
+     */
+    BinaryReader(const char *data,const size_t &size):m_Data(data),m_Size(size),m_Pos(0),m_IsValid(true){}
+
+    /**
+     * read a plain (trivially copyable) value
+     * @param value the value to be read
+     */
+    template<typename T>
+    inline bool readValue(T &value){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be read");
+        if(!require(sizeof(T))) return false;
+        std::memcpy(&value,m_Data+m_Pos,sizeof(T));
+        m_Pos+=sizeof(T);
+        return true;
+    }
+    /**
+     * read a string
+     * @param str the string to be read
+     */
+    inline bool readString(string &str){
+        uint64_t n;
+        if(!readValue(n)||!require(n)) return false;
+        str.assign(m_Data+m_Pos,static_cast<size_t>(n));
+        m_Pos+=static_cast<size_t>(n);
+        return true;
+    }
+    /**
+     * read a vector of plain values
+     * @param vec the vector to be read
+     */
+    template<typename T>
+    inline bool readVector(vector<T> &vec){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be read");
+        uint64_t n;
+        if(!readValue(n)) return false;
+        if(n>(m_Size-m_Pos)/sizeof(T)){
+            m_IsValid=false;
+            return false;
+        }
+        vec.resize(static_cast<size_t>(n));
+        if(n>0) std::memcpy(vec.data(),m_Data+m_Pos,static_cast<size_t>(n)*sizeof(T));
+        m_Pos+=static_cast<size_t>(n)*sizeof(T);
+        return true;
+    }
+    /**
+     * read an array of plain values written by writeRawArray
+     * @param data the pointer of the array, which must hold n values
+     * @param n the length of the array
+     */
+    template<typename T>
+    inline bool readRawArray(T *data,const size_t &n){
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable type can be read");
+        if(n>0&&(!m_IsValid||n>(m_Size-m_Pos)/sizeof(T))) return fail();
+        if(n>0) std::memcpy(data,m_Data+m_Pos,n*sizeof(T));
+        m_Pos+=n*sizeof(T);
+        return true;
+    }
+    /**
+     * read a vector of strings
+     * @param vec the string vector to be read
+     */
+    inline bool readStringVector(vector<string> &vec){
+        uint64_t n;
+        if(!readValue(n)||n>m_Size-m_Pos) return fail();
+        vec.resize(static_cast<size_t>(n));
+        for(auto &str:vec){
+            if(!readString(str)) return false;
+        }
+        return true;
+    }
+    /**
+     * skip the given bytes
+     * @param n the number of bytes
+     */
+    inline bool skip(const size_t &n){
+        if(!require(n)) return false;
+        m_Pos+=n;
+        return true;
+    }
+
+    /**
+     * return true if all the reads are successful
+     */
+    inline bool isValid()const{return m_IsValid;}
+    /**
+     * get the current position
+     */
+    inline size_t getPosition()const{return m_Pos;}
+    /**
+     * get the number of the remaining bytes
+     */
+    inline size_t getRemainingSize()const{return m_Size-m_Pos;}
+
+private:
+    /**
+     * check whether n bytes are still available
+     */
+    inline bool require(const uint64_t &n){
+        if(!m_IsValid||n>m_Size-m_Pos) return fail();
+        return true;
+    }
+    /**
+     * mark the reader as invalid
+     */
+    inline bool fail(){
+        m_IsValid=false;
+        return false;
+    }
+
+private:
+    const char *m_Data;/**< the pointer of the byte buffer */
+    size_t m_Size;/**< the size of the byte buffer */
+    size_t m_Pos;/**< the current position */
+    bool m_IsValid;/**< false if any read fails */
+};
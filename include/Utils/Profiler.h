@@ -0,0 +1,115 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.20
+//+++ Purpose: the hierarchical runtime profiler of AsFem, it is
+//+++          enabled by the '--profile' command line option
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+#include "petsc.h"
+
+using std::string;
+using std::vector;
+using std::map;
+
+/**
+ * this class implements the hierarchical profiler, each scope is timed within its parent scope,
+ * the per-rank statistics (min/max/avg) and call counts are written to json and csv files at exit
+ */
+class Profiler{
+public:
+    /**
+     * enable or disable the profiler, it should be called by all the ranks
+     * @param flag true for enabling the profiler
+     */
+    static void enable(const bool &flag);
+
+    /**
+     * check if the profiler is enabled
+     */
+    static inline bool isEnabled(){
+        return m_Enabled;
+    }
+
+    /**
+     * open a new scope under the current one
+     * @param name the name of the scope
+     * @param petscstage true for registering (and pushing) a PETSc log stage for this scope
+     */
+    static void beginScope(const char *name,const bool &petscstage=false);
+
+    /**
+     * close the current scope
+     */
+    static void endScope();
+
+    /**
+     * reduce the statistics of all the ranks and write them to 'prefix-profile.json' and 'prefix-profile.csv',
+     * this is a collective call
+     * @param prefix the prefix of the report files
+     */
+    static void writeReport(const string &prefix);
+
+private:
+    /**
+     * the node of the scope tree
+     */
+    struct ScopeNode{
+        string m_Name;/**< the scope name */
+        string m_Path;/**< the full path of the scope, i.e., run/nlsolver/assembly */
+        int m_Parent;/**< the parent node id, -1 for the root */
+        int m_Depth;/**< the depth of current scope */
+        vector<int> m_Children;/**< the child node ids */
+        double m_Time;/**< the accumulated time in seconds */
+        long m_Calls;/**< the call counts */
+        bool m_HasStage;/**< true if a PETSc log stage is registered */
+        PetscLogStage m_Stage;/**< the PETSc log stage */
+    };
+
+    static bool m_Enabled;/**< the status of the profiler */
+    static vector<ScopeNode> m_Nodes;/**< the scope tree, the first one is the root */
+    static vector<int> m_NodeStack;/**< the stack of the opened scopes */
+    static vector<std::chrono::steady_clock::time_point> m_StartStack;/**< the start time of the opened scopes */
+    static map<string,PetscLogStage> m_Stages;/**< the registered PETSc log stages */
+};
+
+/**
+ * the RAII helper of the profiler scope, it does nothing if the profiler is disabled
+ */
+class ProfilerScope{
+public:
+    /**
+     * open the scope
+     * @param name the name of the scope
+     * @param petscstage true for registering a PETSc log stage
+     */
+    explicit ProfilerScope(const char *name,const bool &petscstage=false){
+        m_IsActive=Profiler::isEnabled();
+        if(m_IsActive) Profiler::beginScope(name,petscstage);
+    }
+    /**
+     * close the scope
+     */
+    ~ProfilerScope(){
+        if(m_IsActive) Profiler::endScope();
+    }
+    ProfilerScope(const ProfilerScope&)=delete;
+    ProfilerScope& operator=(const ProfilerScope&)=delete;
+private:
+    bool m_IsActive;/**< true if the scope is opened */
+};
@@ -13,10 +13,16 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "Application.h"
+#include "MPIUtils/EnsembleComm.h"
 
 Application::Application(){}
 
 PetscErrorCode Application::init(int args,char *argv[]){
+    // the ranks must be split before PETSc is initialized on the sub-communicator
+    if(!EnsembleComm::init(args,argv)){
+        EnsembleComm::finalize();
+        return 1;
+    }
     PetscCall(PetscInitialize(&args,&argv,NULL,NULL));
     PetscCall(PetscOptionsSetValue(NULL, "-options_left", "no"));// disable the options left warning
     return 0;
@@ -24,6 +30,7 @@ PetscErrorCode Application::init(int args,char *argv[]){
 //*****************************************
 PetscErrorCode Application::finalize(){
     PetscCall(PetscFinalize());
+    EnsembleComm::finalize();
     return 0;
 }
 //***********************************************
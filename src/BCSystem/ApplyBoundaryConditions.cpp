@@ -14,6 +14,7 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "BCSystem/BCSystem.h"
+#include "Utils/Profiler.h"
 
 void BCSystem::applyBoundaryConditions(const FECalcType &CalcType,
                                        const double &t,const double (&Ctan)[3],
@@ -27,9 +28,18 @@ void BCSystem::applyBoundaryConditions(const FECalcType &CalcType,
                                        Vector &V,
                                        SparseMatrix &AMATRIX,
                                        Vector &RHS){
+    ProfilerScope BCScope("boundary-conditions");
 
     double bcvalue;
-    for(const auto &it:m_BCBlockList){
+    if(!m_HasIntegratedBCFaces) setupIntegratedBCFaces(t_FECell,t_DofHandler,t_FE);
+    if(!m_HasDirichletDofSets) setupDirichletDofSets(t_FECell,t_DofHandler,U);
+    if(t_DofHandler.hasHangingNodes()){
+        // the constraints go first, a hanging node on a dirichlet boundary is then overwritten by the dirichlet bc
+        if(!m_HasHangingDofSet) setupHangingDofSet(t_DofHandler,U);
+        applyHangingNodeConstraints(CalcType,U,AMATRIX,RHS);
+    }
+    for(int b=0;b<m_BCBlocksNum;b++){
+        const BCBlock &it=m_BCBlockList[b];
         bcvalue=it.m_BCValue;
         m_LocalElmtInfo.m_T=t;
         if(it.m_IsTimeDependent) bcvalue=t*it.m_BCValue;
@@ -42,7 +52,7 @@ void BCSystem::applyBoundaryConditions(const FECalcType &CalcType,
            it.m_BCType==BCType::USER4DIRICHLETBC||
            it.m_BCType==BCType::USER5DIRICHLETBC||
            it.m_BCType==BCType::POISSON2DBENCHMARKBC){
-            applyDirichletBC(CalcType,bcvalue,it.m_BCType,it.m_JsonParams,it.m_DofIDs,it.m_BoundaryNameList,t_FECell,t_DofHandler,U,Ucopy,Uold,Uolder,V,AMATRIX,RHS);
+            applyDirichletBC(CalcType,bcvalue,it.m_BCType,it.m_JsonParams,m_DirichletDofSets[b],U,Ucopy,Uold,Uolder,V,AMATRIX,RHS);
         }
         else if(it.m_BCType==BCType::NODALDIRICHLETBC){
             continue;
@@ -63,8 +73,7 @@ void BCSystem::applyBoundaryConditions(const FECalcType &CalcType,
             applyIntegratedBC(CalcType,bcvalue,it.m_BCType,Ctan,
                               it.m_JsonParams,
                               it.m_DofIDs,
-                              it.m_BoundaryNameList,
-                              t_FECell,t_DofHandler,t_FE,
+                              m_IntegratedBCFaces[b],
                               U,Uold,Uolder,V,
                               AMATRIX,RHS);
         }// end-of-boundary-type-choose
@@ -87,7 +96,9 @@ void BCSystem::applyPresetBoundaryConditions(const FECalcType &CalcType,
                                              SparseMatrix &AMATRIX,
                                              Vector &RHS){
     double bcvalue;
-    for(const auto &it:m_BCBlockList){
+    if(!m_HasDirichletDofSets) setupDirichletDofSets(t_FECell,t_DofHandler,U);
+    for(int b=0;b<m_BCBlocksNum;b++){
+        const BCBlock &it=m_BCBlockList[b];
         bcvalue=it.m_BCValue;
         m_LocalElmtInfo.m_T=t;
         if(it.m_IsTimeDependent) bcvalue=t*it.m_BCValue;
@@ -100,7 +111,7 @@ void BCSystem::applyPresetBoundaryConditions(const FECalcType &CalcType,
            it.m_BCType==BCType::USER4DIRICHLETBC||
            it.m_BCType==BCType::USER5DIRICHLETBC||
            it.m_BCType==BCType::POISSON2DBENCHMARKBC){
-            applyDirichletBC(CalcType,bcvalue,it.m_BCType,it.m_JsonParams,it.m_DofIDs,it.m_BoundaryNameList,t_FECell,t_DofHandler,U,Ucopy,Uold,Uolder,V,AMATRIX,RHS);
+            applyDirichletBC(CalcType,bcvalue,it.m_BCType,it.m_JsonParams,m_DirichletDofSets[b],U,Ucopy,Uold,Uolder,V,AMATRIX,RHS);
         }
         else if(it.m_BCType==BCType::NODALDIRICHLETBC){
             continue;
@@ -10,7 +10,8 @@
 //+++ Author : Yang Bai
 //+++ Date   : 2020.12.26
 //+++ Purpose: here we apply dirichlet boundary condition via the 
-//+++          penalty method
+//+++          penalty method, the penalty rows are set in one
+//+++          MatZeroRows call over the precomputed dof set
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "BCSystem/BCSystem.h"
@@ -19,10 +20,7 @@ void BCSystem::applyDirichletBC(const FECalcType &CalcType,
                                 const double &BCValue,
                                 const BCType &t_BCType,
                                 const nlohmann::json &Params,
-                                const vector<int> &DofIDs,
-                                const vector<string> &BCNameList,
-                                const FECell &t_FECell,
-                                const DofHandler &t_DofHandler,
+                                DirichletDofSet &DofSet,
                                 Vector &U,
                                 Vector &Ucopy,
                                 Vector &Uold,
@@ -30,100 +28,109 @@ void BCSystem::applyDirichletBC(const FECalcType &CalcType,
                                 Vector &V,
                                 SparseMatrix &AMATRIX,
                                 Vector &RHS){
-    int i,j,k,iInd;
-    vector<int> globaldofids;
-    globaldofids.resize(DofIDs.size(),0);
+    const int nRows=static_cast<int>(DofSet.Rows.size());
+    const int nDofs=DofSet.DofsNum;
 
-    m_LocalElmtInfo.m_DofsNum=static_cast<int>(DofIDs.size());
-
-    Ucopy.makeGhostCopy();
-    Uold.makeGhostCopy();
-    Uolder.makeGhostCopy();
-    V.makeGhostCopy();
+    // the residual and the penalty rows are the same for all the dirichlet type bcs
+    if(CalcType==FECalcType::COMPUTERESIDUAL||CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+        RHS.insertValues(nRows,DofSet.Rows.data(),DofSet.Zeros.data());
+        RHS.assemble();
+    }
+    if(CalcType==FECalcType::COMPUTEJACOBIAN||CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+        // collective call, the rows are already assembled by the bulk fe system
+        MatZeroRows(AMATRIX.getReference(),nRows,DofSet.Rows.data(),m_DirichletPenalty,NULL,NULL);
+    }
 
-    for(const auto &name:BCNameList){
-        for (const auto &cell:t_FECell.getLocalMeshCellVectorCopyViaPhyName(name)){
-            m_LocalElmtInfo.m_Dim=cell.Dim;
-            m_LocalElmtInfo.m_DofsNum=static_cast<int>(DofIDs.size());
-            for(i=1;i<=cell.NodesNumPerElmt;i++){
-                j=cell.ElmtConn[i-1];
-                m_LocalElmtInfo.m_QpCoords0(1)=cell.ElmtNodeCoords0(i,1);
-                m_LocalElmtInfo.m_QpCoords0(2)=cell.ElmtNodeCoords0(i,2);
-                m_LocalElmtInfo.m_QpCoords0(3)=cell.ElmtNodeCoords0(i,3);
-                for(k=1;k<=m_LocalElmtInfo.m_DofsNum;k++){
-                    iInd=t_DofHandler.getIthNodeJthDofID(j,DofIDs[k-1]);
-                    globaldofids[k-1]=iInd;
+    // the constant (or time-only) bc value is set in one call
+    if(t_BCType==BCType::DIRICHLETBC){
+        std::fill(DofSet.Values.begin(),DofSet.Values.end(),BCValue);
+        U.insertValues(nRows,DofSet.Rows.data(),DofSet.Values.data());
+        U.assemble();
+        return;
+    }
 
-                    m_LocalElmtSoln.m_QpU[k]=Ucopy.getIthValueFromGhost(iInd);
-                    m_LocalElmtSoln.m_QpUold[k]=Uold.getIthValueFromGhost(iInd);
-                    m_LocalElmtSoln.m_QpUolder[k]=Uolder.getIthValueFromGhost(iInd);
-                    m_LocalElmtSoln.m_QpV[k]=V.getIthValueFromGhost(iInd);
-                }
+    // the user-defined bcs may read the solution, the built-in ones only depend on the coordinates and time
+    const bool NeedsSolution=t_BCType==BCType::USER1DIRICHLETBC||
+                             t_BCType==BCType::USER2DIRICHLETBC||
+                             t_BCType==BCType::USER3DIRICHLETBC||
+                             t_BCType==BCType::USER4DIRICHLETBC||
+                             t_BCType==BCType::USER5DIRICHLETBC;
+    if(NeedsSolution){
+        Ucopy.makeGhostCopy();
+        Uold.makeGhostCopy();
+        Uolder.makeGhostCopy();
+        V.makeGhostCopy();
+    }
 
-                switch (t_BCType)
-                {
-                case BCType::DIRICHLETBC:
-                    DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::ROTATEDDIRICHLETBC:
-                    RotatedDirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::USER1DIRICHLETBC:
-                    User1DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::USER2DIRICHLETBC:
-                    User2DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::USER3DIRICHLETBC:
-                    User3DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::USER4DIRICHLETBC:
-                    User4DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::USER5DIRICHLETBC:
-                    User5DirichletBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                case BCType::POISSON2DBENCHMARKBC:
-                    Poisson2DBenchmarkBC::computeBCValue(CalcType,m_DirichletPenalty,BCValue,Params,
-                                                m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
-                                                U,AMATRIX,RHS);
-                    break;
-                default:
-                    MessagePrinter::printErrorTxt("unsupported dirichlet type boundary condition in ApplyDirichletBC.cpp, plese check your input file or your code");
-                    MessagePrinter::exitAsFem();
-                    break;
-                }
+    int k,iInd;
+    vector<int> globaldofids(nDofs,0);
+    m_LocalElmtInfo.m_Dim=DofSet.Dim;
+    m_LocalElmtInfo.m_DofsNum=nDofs;
+    for(int i=0;i<static_cast<int>(DofSet.NodeCoords0.size());i++){
+        m_LocalElmtInfo.m_QpCoords0=DofSet.NodeCoords0[i];
+        for(k=1;k<=nDofs;k++){
+            iInd=DofSet.DofIDs[i*nDofs+k-1];
+            globaldofids[k-1]=iInd;
+            if(NeedsSolution){
+                m_LocalElmtSoln.m_QpU[k]=Ucopy.getIthValueFromGhost(iInd);
+                m_LocalElmtSoln.m_QpUold[k]=Uold.getIthValueFromGhost(iInd);
+                m_LocalElmtSoln.m_QpUolder[k]=Uolder.getIthValueFromGhost(iInd);
+                m_LocalElmtSoln.m_QpV[k]=V.getIthValueFromGhost(iInd);
             }
         }
 
+        // the K and R parts are done above, so the kernels only update U
+        switch (t_BCType)
+        {
+        case BCType::ROTATEDDIRICHLETBC:
+            RotatedDirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::USER1DIRICHLETBC:
+            User1DirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::USER2DIRICHLETBC:
+            User2DirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::USER3DIRICHLETBC:
+            User3DirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::USER4DIRICHLETBC:
+            User4DirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::USER5DIRICHLETBC:
+            User5DirichletBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        case BCType::POISSON2DBENCHMARKBC:
+            Poisson2DBenchmarkBC::computeBCValue(FECalcType::UPDATEU,m_DirichletPenalty,BCValue,Params,
+                                        m_LocalElmtInfo,m_LocalElmtSoln,globaldofids,
+                                        U,AMATRIX,RHS);
+            break;
+        default:
+            MessagePrinter::printErrorTxt("unsupported dirichlet type boundary condition in ApplyDirichletBC.cpp, plese check your input file or your code");
+            MessagePrinter::exitAsFem();
+            break;
+        }
     }
 
-    Ucopy.destroyGhostCopy();
-    Uold.destroyGhostCopy();
-    Uolder.destroyGhostCopy();
-    V.destroyGhostCopy();
+    if(NeedsSolution){
+        Ucopy.destroyGhostCopy();
+        Uold.destroyGhostCopy();
+        Uolder.destroyGhostCopy();
+        V.destroyGhostCopy();
+    }
 
-    // do the assemble
     U.assemble();
-    if(CalcType==FECalcType::COMPUTERESIDUAL) RHS.assemble();
-    if(CalcType==FECalcType::COMPUTEJACOBIAN) AMATRIX.assemble();
-    if (CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN) {
-        RHS.assemble();
-        AMATRIX.assemble();
-    }
 
-}
\ No newline at end of file
+}
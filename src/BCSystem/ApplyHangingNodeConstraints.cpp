@@ -0,0 +1,113 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.17
+//+++ Purpose: impose the hanging node constraints of the adapted
+//+++          mesh, each hanging dof follows its masters:
+//+++            u_h=sum(w_m*u_m)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <algorithm>
+
+#include "BCSystem/BCSystem.h"
+
+void BCSystem::setupHangingDofSet(const DofHandler &t_DofHandler,Vector &U){
+    destroyHangingDofSet();
+    HangingDofSet &dofset=m_HangingDofSet;
+
+    PetscInt iStart,iEnd;
+    VecGetOwnershipRange(U.getVectorRef(),&iStart,&iEnd);
+
+    int j,k,row;
+    dofset.MasterPtr.push_back(0);
+    for(const auto &nodeid:t_DofHandler.getHangingNodeIDsRef()){
+        for(k=1;k<=t_DofHandler.getMaxDofsPerNode();k++){
+            row=t_DofHandler.getIthNodeJthDofID0(nodeid,k);
+            if(row<iStart||row>=iEnd) continue;
+            dofset.Rows.push_back(row);
+            for(j=1;j<=t_DofHandler.getIthNodeMastersNum(nodeid);j++){
+                dofset.MasterCols.push_back(t_DofHandler.getIthNodeJthDofID0(t_DofHandler.getIthNodeJthMasterID(nodeid,j),k));
+                dofset.Weights.push_back(t_DofHandler.getIthNodeJthMasterWeight(nodeid,j));
+            }
+            dofset.MasterPtr.push_back(static_cast<int>(dofset.MasterCols.size()));
+        }
+    }
+    // the masters may live on other ranks, only the unique ones are scattered in each newton iteration
+    dofset.MasterRows=dofset.MasterCols;
+    std::sort(dofset.MasterRows.begin(),dofset.MasterRows.end());
+    dofset.MasterRows.erase(std::unique(dofset.MasterRows.begin(),dofset.MasterRows.end()),dofset.MasterRows.end());
+    for(auto &col:dofset.MasterCols){
+        col=static_cast<int>(std::lower_bound(dofset.MasterRows.begin(),dofset.MasterRows.end(),col)-dofset.MasterRows.begin());
+    }
+    dofset.Residual.assign(dofset.Rows.size(),0.0);
+
+    IS is;
+    const int nMasters=static_cast<int>(dofset.MasterRows.size());
+    ISCreateGeneral(PETSC_COMM_SELF,nMasters,dofset.MasterRows.data(),PETSC_COPY_VALUES,&is);
+    VecCreateSeq(PETSC_COMM_SELF,nMasters,&dofset.MasterVals);
+    VecScatterCreate(U.getVectorRef(),is,dofset.MasterVals,NULL,&dofset.Scatter);
+    ISDestroy(&is);
+
+    m_HasHangingDofSet=true;
+}
+
+void BCSystem::applyHangingNodeConstraints(const FECalcType &CalcType,Vector &U,SparseMatrix &AMATRIX,Vector &RHS){
+    HangingDofSet &dofset=m_HangingDofSet;
+    const int nRows=static_cast<int>(dofset.Rows.size());
+    int i,p;
+
+    if(CalcType==FECalcType::COMPUTERESIDUAL||CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+        const PetscScalar *vals;
+        PetscScalar uh;
+        VecScatterBegin(dofset.Scatter,U.getVectorRef(),dofset.MasterVals,INSERT_VALUES,SCATTER_FORWARD);
+        VecScatterEnd(dofset.Scatter,U.getVectorRef(),dofset.MasterVals,INSERT_VALUES,SCATTER_FORWARD);
+        VecGetArrayRead(dofset.MasterVals,&vals);
+        for(i=0;i<nRows;i++){
+            VecGetValues(U.getVectorRef(),1,&dofset.Rows[i],&uh);
+            dofset.Residual[i]=uh;
+            for(p=dofset.MasterPtr[i];p<dofset.MasterPtr[i+1];p++){
+                dofset.Residual[i]-=dofset.Weights[p]*vals[dofset.MasterCols[p]];
+            }
+        }
+        VecRestoreArrayRead(dofset.MasterVals,&vals);
+        RHS.insertValues(nRows,dofset.Rows.data(),dofset.Residual.data());
+        RHS.assemble();
+    }
+    if(CalcType==FECalcType::COMPUTEJACOBIAN||CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+        // the hanging rows only hold the zero entries of the sparsity pattern, so they are simply overwritten
+        const PetscScalar one=1.0;
+        PetscScalar minusw;
+        PetscInt col;
+        for(i=0;i<nRows;i++){
+            MatSetValues(AMATRIX.getReference(),1,&dofset.Rows[i],1,&dofset.Rows[i],&one,INSERT_VALUES);
+            for(p=dofset.MasterPtr[i];p<dofset.MasterPtr[i+1];p++){
+                col=dofset.MasterRows[dofset.MasterCols[p]];
+                minusw=-dofset.Weights[p];
+                MatSetValues(AMATRIX.getReference(),1,&dofset.Rows[i],1,&col,&minusw,INSERT_VALUES);
+            }
+        }
+        MatAssemblyBegin(AMATRIX.getReference(),MAT_FINAL_ASSEMBLY);
+        MatAssemblyEnd(AMATRIX.getReference(),MAT_FINAL_ASSEMBLY);
+    }
+}
+
+void BCSystem::destroyHangingDofSet(){
+    if(m_HasHangingDofSet){
+        VecScatterDestroy(&m_HangingDofSet.Scatter);
+        VecDestroy(&m_HangingDofSet.MasterVals);
+    }
+    m_HangingDofSet.Rows.clear();
+    m_HangingDofSet.MasterPtr.clear();
+    m_HangingDofSet.MasterCols.clear();
+    m_HangingDofSet.Weights.clear();
+    m_HangingDofSet.MasterRows.clear();
+    m_HangingDofSet.Residual.clear();
+    m_HasHangingDofSet=false;
+}
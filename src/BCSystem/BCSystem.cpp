@@ -22,6 +22,11 @@ BCSystem::BCSystem(){
     m_BCBlockList.clear();
     m_BCBlocksNum=0;
     m_DirichletPenalty=1.0e16;
+    m_DirichletDofSets.clear();
+    m_HasDirichletDofSets=false;
+    m_IntegratedBCFaces.clear();
+    m_HasIntegratedBCFaces=false;
+    m_HasHangingDofSet=false;
 }
 
 void BCSystem::init(const int &dofs){
@@ -49,9 +54,16 @@ void BCSystem::releaseMemory(){
 
     m_BCBlockList.clear();
     m_BCBlocksNum=0;
+    m_DirichletDofSets.clear();
+    m_HasDirichletDofSets=false;
+    m_IntegratedBCFaces.clear();
+    m_HasIntegratedBCFaces=false;
+    destroyHangingDofSet();
 
     m_LocalK.clean();
     m_LocalR.clean();
+    m_FaceR.clear();
+    m_FaceK.clear();
     m_Nodes0.clear();
     m_Nodes.clear();
 
@@ -67,6 +79,14 @@ void BCSystem::releaseMemory(){
     m_LocalElmtSoln.m_QpGradV.clear();
 }
 
+void BCSystem::resetBoundaryDofSets(){
+    m_DirichletDofSets.clear();
+    m_HasDirichletDofSets=false;
+    m_IntegratedBCFaces.clear();
+    m_HasIntegratedBCFaces=false;
+    destroyHangingDofSet();
+}
+
 void BCSystem::addBCBlock2List(const BCBlock &t_BCBlock){
     if(m_BCBlockList.size()<1){
         m_BCBlockList.push_back(t_BCBlock);
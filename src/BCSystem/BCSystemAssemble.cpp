@@ -10,34 +10,16 @@
 //+++ Author : Yang Bai
 //+++ Date   : 2022.08.13
 //+++ Purpose: assemble the local R and K to global one for different
-//+++          boundary conditions
+//+++          boundary conditions, one blocked call per bc face
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "BCSystem/BCSystem.h"
 
-void BCSystem::assembleLocalResidual2Global(const int &Dofs,const vector<int> &DofIDs,
-                                            const int &I,const double &JxW,
-                                            const DofHandler &t_DofHandler,
-                                            const VectorXd &LocalR,Vector &RHS){
-    int iInd;
-    for(int i=0;i<Dofs;i++){
-        iInd=t_DofHandler.getIthNodeJthDofID(I,DofIDs[i]);
-        RHS.addValue(iInd,LocalR(i+1)*JxW);
-    }
+void BCSystem::assembleFaceResidual2Global(const IntegratedBCFace &Face,Vector &RHS){
+    RHS.addValues(static_cast<int>(Face.Rows.size()),Face.Rows.data(),m_FaceR.data());
 }
 
-void BCSystem::assembleLocalJacobian2Global(const int &Dofs,const vector<int> &DofIDs,
-                                            const int &I,const int &J,
-                                            const double &JxW,
-                                            const DofHandler &t_DofHandler,
-                                            const MatrixXd &LocalK,
-                                            SparseMatrix &AMATRIX){
-    int iInd,jInd;
-    for(int i=0;i<Dofs;i++){
-        iInd=t_DofHandler.getIthNodeJthDofID(I,DofIDs[i]);
-        for(int j=0;j<Dofs;j++){
-            jInd=t_DofHandler.getIthNodeJthDofID(J,DofIDs[j]);
-            AMATRIX.addValue(iInd,jInd,LocalK(i+1,j+1)*JxW);
-        }
-    }
-}
\ No newline at end of file
+void BCSystem::assembleFaceJacobian2Global(const IntegratedBCFace &Face,SparseMatrix &AMATRIX){
+    const int n=static_cast<int>(Face.Rows.size());
+    AMATRIX.addValues(n,Face.Rows.data(),n,Face.Rows.data(),m_FaceK.data());
+}
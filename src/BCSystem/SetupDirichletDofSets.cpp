@@ -0,0 +1,115 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.11
+//+++ Purpose: build the owned and deduplicated constrained dofs of
+//+++          each dirichlet type bc block once, so the bc cells
+//+++          are not visited again in the newton iterations
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <map>
+#include "BCSystem/BCSystem.h"
+
+/**
+ * check whether the bc type is applied by applyDirichletBC
+ */
+static bool isDirichletTypeBC(const BCType &t_BCType){
+    return t_BCType==BCType::DIRICHLETBC||
+           t_BCType==BCType::ROTATEDDIRICHLETBC||
+           t_BCType==BCType::CYCLICDIRICHLETBC||
+           t_BCType==BCType::USER1DIRICHLETBC||
+           t_BCType==BCType::USER2DIRICHLETBC||
+           t_BCType==BCType::USER3DIRICHLETBC||
+           t_BCType==BCType::USER4DIRICHLETBC||
+           t_BCType==BCType::USER5DIRICHLETBC||
+           t_BCType==BCType::POISSON2DBENCHMARKBC;
+}
+
+void BCSystem::setupDirichletDofSets(const FECell &t_FECell,const DofHandler &t_DofHandler,Vector &U){
+    MPI_Comm_rank(PETSC_COMM_WORLD,&m_Rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&m_Size);
+
+    PetscInt iStart,iEnd;
+    VecGetOwnershipRange(U.getVectorRef(),&iStart,&iEnd);
+
+    int i,k,nodeid,iInd,localdim,nLocal,nTotal;
+    vector<int> localnodeids,allnodeids,counts(m_Size,0),displs(m_Size,0);
+    vector<double> localcoords,allcoords;
+    map<int,Vector3d> localnodes,allnodes;
+    Vector3d coords;
+
+    m_DirichletDofSets.assign(m_BCBlocksNum,DirichletDofSet());
+    for(int b=0;b<m_BCBlocksNum;b++){
+        const BCBlock &block=m_BCBlockList[b];
+        if(!isDirichletTypeBC(block.m_BCType)) continue;
+        DirichletDofSet &dofset=m_DirichletDofSets[b];
+        dofset.DofsNum=static_cast<int>(block.m_DofIDs.size());
+
+        // collect the unique nodes of the local bc cells, shared nodes are visited only once from now on
+        localnodes.clear();
+        localdim=0;
+        for(const auto &name:block.m_BoundaryNameList){
+            for(const auto &cell:t_FECell.getLocalMeshCellVectorCopyViaPhyName(name)){
+                localdim=max(localdim,cell.Dim);
+                for(i=1;i<=cell.NodesNumPerElmt;i++){
+                    nodeid=cell.ElmtConn[i-1];
+                    if(localnodes.count(nodeid)) continue;
+                    coords(1)=cell.ElmtNodeCoords0(i,1);
+                    coords(2)=cell.ElmtNodeCoords0(i,2);
+                    coords(3)=cell.ElmtNodeCoords0(i,3);
+                    localnodes[nodeid]=coords;
+                }
+            }
+        }
+        MPI_Allreduce(&localdim,&dofset.Dim,1,MPI_INT,MPI_MAX,PETSC_COMM_WORLD);
+
+        // the owner of a dof may not hold any bc cell of it, so the boundary nodes (a surface set) are shared by all the ranks
+        localnodeids.clear();localcoords.clear();
+        for(const auto &it:localnodes){
+            localnodeids.push_back(it.first);
+            for(k=1;k<=3;k++) localcoords.push_back(it.second(k));
+        }
+        nLocal=static_cast<int>(localnodeids.size());
+        MPI_Allgather(&nLocal,1,MPI_INT,counts.data(),1,MPI_INT,PETSC_COMM_WORLD);
+        nTotal=0;
+        for(int cpuid=0;cpuid<m_Size;cpuid++){
+            displs[cpuid]=nTotal;
+            nTotal+=counts[cpuid];
+        }
+        allnodeids.resize(nTotal);
+        MPI_Allgatherv(localnodeids.data(),nLocal,MPI_INT,allnodeids.data(),counts.data(),displs.data(),MPI_INT,PETSC_COMM_WORLD);
+        for(int cpuid=0;cpuid<m_Size;cpuid++){
+            counts[cpuid]*=3;displs[cpuid]*=3;
+        }
+        allcoords.resize(3*nTotal);
+        MPI_Allgatherv(localcoords.data(),3*nLocal,MPI_DOUBLE,allcoords.data(),counts.data(),displs.data(),MPI_DOUBLE,PETSC_COMM_WORLD);
+
+        // keep the nodes whose first constrained dof is owned by current rank
+        allnodes.clear();
+        for(i=0;i<nTotal;i++){
+            nodeid=allnodeids[i];
+            iInd=t_DofHandler.getIthNodeJthDofID(nodeid,block.m_DofIDs[0]);
+            if(iInd-1<iStart||iInd-1>=iEnd) continue;
+            for(k=1;k<=3;k++) coords(k)=allcoords[3*i+k-1];
+            allnodes[nodeid]=coords;
+        }
+        for(const auto &it:allnodes){
+            dofset.NodeCoords0.push_back(it.second);
+            for(k=0;k<dofset.DofsNum;k++){
+                iInd=t_DofHandler.getIthNodeJthDofID(it.first,block.m_DofIDs[k]);
+                dofset.DofIDs.push_back(iInd);
+                dofset.Rows.push_back(iInd-1);
+            }
+        }
+        dofset.Zeros.assign(dofset.Rows.size(),0.0);
+        dofset.Values.assign(dofset.Rows.size(),0.0);
+    }
+    m_HasDirichletDofSets=true;
+}
@@ -0,0 +1,208 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.11
+//+++ Purpose: tabulate the shape functions, JxW, and normals of
+//+++          the integrated bc faces once, all of them are
+//+++          evaluated on the reference configuration
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <algorithm>
+
+#include "BCSystem/BCSystem.h"
+
+/**
+ * check whether the bc type is applied by applyIntegratedBC
+ */
+static bool isIntegratedTypeBC(const BCType &t_BCType){
+    switch (t_BCType)
+    {
+    case BCType::DIRICHLETBC:
+    case BCType::ROTATEDDIRICHLETBC:
+    case BCType::CYCLICDIRICHLETBC:
+    case BCType::USER1DIRICHLETBC:
+    case BCType::USER2DIRICHLETBC:
+    case BCType::USER3DIRICHLETBC:
+    case BCType::USER4DIRICHLETBC:
+    case BCType::USER5DIRICHLETBC:
+    case BCType::POISSON2DBENCHMARKBC:
+    case BCType::NODALDIRICHLETBC:
+    case BCType::NODALNEUMANNBC:
+    case BCType::NODALFLUXBC:
+    case BCType::NODALFORCEBC:
+    case BCType::NULLBC:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void BCSystem::condenseHangingNodes(const SingleMeshCell &t_Cell,const vector<int> &t_DofIDs,
+                                    const DofHandler &t_DofHandler,IntegratedBCFace &t_Face){
+    const int nNodes=t_Face.NodesNum;
+    const int nDofs=static_cast<int>(t_DofIDs.size());
+    int i,j,qp;
+    bool HasHangingNode=false;
+    for(i=1;i<=nNodes;i++){
+        if(t_DofHandler.getIthNodeMastersNum(t_Cell.ElmtConn[i-1])>0) HasHangingNode=true;
+    }
+    if(!HasHangingNode) return;
+
+    vector<int> NodeIDs;
+    for(i=1;i<=nNodes;i++){
+        const int nodeid=t_Cell.ElmtConn[i-1];
+        if(t_DofHandler.getIthNodeMastersNum(nodeid)==0) NodeIDs.push_back(nodeid);
+        for(j=1;j<=t_DofHandler.getIthNodeMastersNum(nodeid);j++) NodeIDs.push_back(t_DofHandler.getIthNodeJthMasterID(nodeid,j));
+    }
+    std::sort(NodeIDs.begin(),NodeIDs.end());
+    NodeIDs.erase(std::unique(NodeIDs.begin(),NodeIDs.end()),NodeIDs.end());
+    const int nMasters=static_cast<int>(NodeIDs.size());
+
+    // the shape function of a hanging node is shared by its masters with the constraint weights
+    vector<double> Shp(t_Face.QPointsNum*nMasters,0.0);
+    vector<Vector3d> Grad(t_Face.QPointsNum*nMasters,Vector3d(0.0));
+    int m;
+    for(i=1;i<=nNodes;i++){
+        const int nodeid=t_Cell.ElmtConn[i-1];
+        const int nm=t_DofHandler.getIthNodeMastersNum(nodeid);
+        for(j=1;j<=std::max(nm,1);j++){
+            const int masterid=(nm==0)?nodeid:t_DofHandler.getIthNodeJthMasterID(nodeid,j);
+            const double w=(nm==0)?1.0:t_DofHandler.getIthNodeJthMasterWeight(nodeid,j);
+            m=static_cast<int>(std::lower_bound(NodeIDs.begin(),NodeIDs.end(),masterid)-NodeIDs.begin());
+            for(qp=0;qp<t_Face.QPointsNum;qp++){
+                Shp[qp*nMasters+m]+=w*t_Face.Shp[qp*nNodes+i-1];
+                Grad[qp*nMasters+m]+=t_Face.Grad[qp*nNodes+i-1]*w;
+            }
+        }
+    }
+    t_Face.NodesNum=nMasters;
+    t_Face.Shp=Shp;
+    t_Face.Grad=Grad;
+    t_Face.Rows.resize(nMasters*nDofs);
+    for(i=1;i<=nMasters;i++){
+        for(j=1;j<=nDofs;j++){
+            t_Face.Rows[(i-1)*nDofs+j-1]=t_DofHandler.getIthNodeJthDofID(NodeIDs[i-1],t_DofIDs[j-1])-1;
+        }
+    }
+}
+
+void BCSystem::setupIntegratedBCFaces(const FECell &t_FECell,const DofHandler &t_DofHandler,FE &t_FE){
+    int i,k,qp,nNodes,nQps,maxFaceDofs=0;
+    double xi,eta,w,dist;
+    IntegratedBCFace face;
+
+    m_IntegratedBCFaces.assign(m_BCBlocksNum,vector<IntegratedBCFace>(0));
+    for(int b=0;b<m_BCBlocksNum;b++){
+        const BCBlock &block=m_BCBlockList[b];
+        if(!isIntegratedTypeBC(block.m_BCType)) continue;
+        const int nDofs=static_cast<int>(block.m_DofIDs.size());
+        for(const auto &name:block.m_BoundaryNameList){
+            for(const auto &cell:t_FECell.getLocalMeshCellVectorCopyViaPhyName(name)){
+                if(cell.Dim>2 || cell.Dim<0){
+                    MessagePrinter::printErrorTxt("Invalid dim (="+to_string(cell.Dim)+") for integrated boundary condition");
+                    MessagePrinter::exitAsFem();
+                }
+                nNodes=cell.NodesNumPerElmt;
+                if(cell.Dim==0) nQps=1;
+                else if(cell.Dim==1) nQps=t_FE.m_LineQpoints.getQPointsNum();
+                else nQps=t_FE.m_SurfaceQpoints.getQPointsNum();
+
+                face.Dim=cell.Dim;
+                face.NodesNum=nNodes;
+                face.QPointsNum=nQps;
+                face.Rows.resize(nNodes*nDofs);
+                for(i=1;i<=nNodes;i++){
+                    for(k=1;k<=nDofs;k++){
+                        face.Rows[(i-1)*nDofs+k-1]=t_DofHandler.getIthNodeJthDofID(cell.ElmtConn[i-1],block.m_DofIDs[k-1])-1;
+                    }
+                }
+                face.JxW.assign(nQps,0.0);
+                face.Normal.assign(nQps,Vector3d(0.0));
+                face.QpCoords0.assign(nQps,Vector3d(0.0));
+                face.Shp.assign(nQps*nNodes,0.0);
+                face.Grad.assign(nQps*nNodes,Vector3d(0.0));
+                maxFaceDofs=max(maxFaceDofs,nNodes*nDofs);
+
+                if(cell.Dim==0){
+                    // for 'point' case, each node takes the full value
+                    face.JxW[0]=1.0;
+                    for(i=1;i<=nNodes;i++){
+                        face.Shp[i-1]=1.0;
+                        face.QpCoords0[0](1)=cell.ElmtNodeCoords0(i,1);
+                        face.QpCoords0[0](2)=cell.ElmtNodeCoords0(i,2);
+                        face.QpCoords0[0](3)=cell.ElmtNodeCoords0(i,3);
+                    }
+                    m_IntegratedBCFaces[b].push_back(face);
+                    continue;
+                }
+
+                ShapeFun &shp=cell.Dim==1?t_FE.m_LineShp:t_FE.m_SurfaceShp;
+                for(qp=1;qp<=nQps;qp++){
+                    if(cell.Dim==1){
+                        xi =t_FE.m_LineQpoints.getIthPointJthCoord(qp,1);
+                        eta=0.0;
+                        w  =t_FE.m_LineQpoints.getIthPointJthCoord(qp,0);
+                    }
+                    else{
+                        xi =t_FE.m_SurfaceQpoints.getIthPointJthCoord(qp,1);
+                        eta=t_FE.m_SurfaceQpoints.getIthPointJthCoord(qp,2);
+                        w  =t_FE.m_SurfaceQpoints.getIthPointJthCoord(qp,0);
+                    }
+                    shp.calc(xi,eta,0.0,cell.ElmtNodeCoords0,false);
+
+                    // for the normal vector of current qpoint
+                    m_XS.setToZeros();m_Normal=0.0;
+                    for(i=1;i<=nNodes;i++){
+                        m_XS(1,1)+=shp.shape_grad(i)(1)*cell.ElmtNodeCoords0(i,1);
+                        m_XS(2,1)+=shp.shape_grad(i)(1)*cell.ElmtNodeCoords0(i,2);
+                        m_XS(3,1)+=shp.shape_grad(i)(1)*cell.ElmtNodeCoords0(i,3);
+                        if(cell.Dim==2){
+                            m_XS(1,2)+=shp.shape_grad(i)(2)*cell.ElmtNodeCoords0(i,1);
+                            m_XS(2,2)+=shp.shape_grad(i)(2)*cell.ElmtNodeCoords0(i,2);
+                            m_XS(3,2)+=shp.shape_grad(i)(2)*cell.ElmtNodeCoords0(i,3);
+                        }
+                    }
+                    if(cell.Dim==1){
+                        dist=sqrt(m_XS(1,1)*m_XS(1,1)+m_XS(2,1)*m_XS(2,1));
+                        m_Normal(1)= m_XS(2,1)/dist;// dy/dxi
+                        m_Normal(2)=-m_XS(1,1)/dist;// dx/dxi
+                        m_Normal(3)= 0.0;
+                    }
+                    else{
+                        m_Normal(1)=m_XS(2,1)*m_XS(3,2)-m_XS(3,1)*m_XS(2,2);
+                        m_Normal(2)=m_XS(3,1)*m_XS(1,2)-m_XS(1,1)*m_XS(3,2);
+                        m_Normal(3)=m_XS(1,1)*m_XS(2,2)-m_XS(2,1)*m_XS(1,2);
+                        dist=sqrt(m_Normal(1)*m_Normal(1)+m_Normal(2)*m_Normal(2)+m_Normal(3)*m_Normal(3));
+                        m_Normal(1)=m_Normal(1)/dist;
+                        m_Normal(2)=m_Normal(2)/dist;
+                        m_Normal(3)=m_Normal(3)/dist;
+                    }
+                    face.Normal[qp-1]=m_Normal;
+
+                    shp.calc(xi,eta,0.0,cell.ElmtNodeCoords0,true);
+                    face.JxW[qp-1]=shp.getJacDet()*w;
+                    for(i=1;i<=nNodes;i++){
+                        face.Shp[(qp-1)*nNodes+i-1]=shp.shape_value(i);
+                        face.Grad[(qp-1)*nNodes+i-1]=shp.shape_grad(i);
+                        face.QpCoords0[qp-1](1)+=shp.shape_value(i)*cell.ElmtNodeCoords0(i,1);
+                        face.QpCoords0[qp-1](2)+=shp.shape_value(i)*cell.ElmtNodeCoords0(i,2);
+                        face.QpCoords0[qp-1](3)+=shp.shape_value(i)*cell.ElmtNodeCoords0(i,3);
+                    }
+                }
+                if(t_DofHandler.hasHangingNodes()) condenseHangingNodes(cell,block.m_DofIDs,t_DofHandler,face);
+                maxFaceDofs=max(maxFaceDofs,face.NodesNum*nDofs);
+                m_IntegratedBCFaces[b].push_back(face);
+            }
+        }
+    }
+    m_FaceR.assign(maxFaceDofs,0.0);
+    m_FaceK.assign(maxFaceDofs*maxFaceDofs,0.0);
+    m_HasIntegratedBCFaces=true;
+}
@@ -0,0 +1,33 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.12
+//+++ Purpose: the main program of the asfem-bench target
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Application.h"
+#include "Benchmark/BenchmarkSuite.h"
+
+int main(int args,char *argv[]){
+    Application myapp;
+
+    if(myapp.init(args,argv)) return 1;
+
+    BenchmarkSuite bench;
+    if(!bench.init(args,argv)){
+        myapp.finalize();
+        return 1;
+    }
+    bench.run();
+    const int status=bench.finalize();
+
+    if(myapp.finalize()) return 1;
+    return status;
+}
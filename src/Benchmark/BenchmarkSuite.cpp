@@ -0,0 +1,231 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.12
+//+++ Purpose: the options, results, and baseline comparison of
+//+++          the benchmark suite
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <fstream>
+#include <map>
+
+#include "Benchmark/BenchmarkSuite.h"
+
+BenchmarkSuite::BenchmarkSuite(){
+    m_RunMicro=true;
+    m_RunMacro=true;
+    m_Filter.clear();
+    m_OutputFileName="asfem-bench.json";
+    m_BaselineFileName.clear();
+    m_WorkDir=".";
+    m_Tolerance=0.1;
+    m_MinBatchTime=0.02;
+    m_Repeats=5;
+    m_MacroLevels=3;
+    m_Rank=0;
+    m_Size=1;
+    m_Results=nlohmann::json::array();
+    m_Sink=0.0;
+}
+
+void BenchmarkSuite::printHelp(){
+    MessagePrinter::printStars();
+    MessagePrinter::printNormalTxt("Usage: asfem-bench [options]");
+    MessagePrinter::printNormalTxt("  --micro              run the micro benchmarks only");
+    MessagePrinter::printNormalTxt("  --macro              run the macro benchmarks only");
+    MessagePrinter::printNormalTxt("  --filter str         run the benchmarks whose name contains str");
+    MessagePrinter::printNormalTxt("  -o file.json         the result file (default: asfem-bench.json)");
+    MessagePrinter::printNormalTxt("  --compare file.json  compare the results with the baseline file");
+    MessagePrinter::printNormalTxt("  --tolerance val      the relative tolerance of regressions (default: 0.1)");
+    MessagePrinter::printNormalTxt("  --min-time val       the minimum time [s] of one timed batch (default: 0.02)");
+    MessagePrinter::printNormalTxt("  --repeats n          the repeats of the timed batches (default: 5)");
+    MessagePrinter::printNormalTxt("  --macro-levels n     the mesh sizes of each macro benchmark (default: 3)");
+    MessagePrinter::printNormalTxt("  --workdir dir        the folder for the macro input files (default: .)");
+    MessagePrinter::printStars();
+}
+
+bool BenchmarkSuite::init(int args,char *argv[]){
+    MPI_Comm_rank(PETSC_COMM_WORLD,&m_Rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&m_Size);
+
+    bool HasMicro=false,HasMacro=false;
+    string opt;
+    for(int i=1;i<args;i++){
+        opt=argv[i];
+        if(opt=="-h"||opt=="--help"){
+            printHelp();
+            return false;
+        }
+        else if(opt=="--micro"){
+            HasMicro=true;
+        }
+        else if(opt=="--macro"){
+            HasMacro=true;
+        }
+        else if(opt=="--filter"||opt=="-o"||opt=="--compare"||opt=="--tolerance"||
+                opt=="--min-time"||opt=="--repeats"||opt=="--macro-levels"||opt=="--workdir"){
+            if(i+1>=args){
+                MessagePrinter::printErrorTxt("a value is required after the option '"+opt+"' of asfem-bench");
+                return false;
+            }
+            string val=argv[++i];
+            if(opt=="--filter") m_Filter=val;
+            else if(opt=="-o") m_OutputFileName=val;
+            else if(opt=="--compare") m_BaselineFileName=val;
+            else if(opt=="--workdir") m_WorkDir=val;
+            else if(opt=="--tolerance") m_Tolerance=std::atof(val.c_str());
+            else if(opt=="--min-time") m_MinBatchTime=std::atof(val.c_str());
+            else if(opt=="--repeats") m_Repeats=std::atoi(val.c_str());
+            else m_MacroLevels=std::atoi(val.c_str());
+        }
+        // the other options are left for PETSc
+    }
+    if(HasMicro||HasMacro){
+        m_RunMicro=HasMicro;
+        m_RunMacro=HasMacro;
+    }
+    if(m_Tolerance<=0.0||m_MinBatchTime<=0.0||m_Repeats<1||m_MacroLevels<1){
+        MessagePrinter::printErrorTxt("the tolerance, min-time, repeats, and macro-levels of asfem-bench must be positive");
+        return false;
+    }
+    return true;
+}
+
+void BenchmarkSuite::run(){
+    if(m_RunMicro){
+        MessagePrinter::printStars();
+        MessagePrinter::printNormalTxt("Start to run the micro benchmarks ...");
+        runShapeFunBenchmarks();
+        runTensorBenchmarks();
+        runMateAndElmtBenchmarks();
+        runLinearAlgebraBenchmarks();
+    }
+    if(m_RunMacro){
+        MessagePrinter::printStars();
+        MessagePrinter::printNormalTxt("Start to run the macro benchmarks ...");
+        runMacroBenchmarks();
+    }
+}
+
+int BenchmarkSuite::finalize(){
+    int Regressions=0;
+    if(!m_BaselineFileName.empty()){
+        Regressions=compareWithBaseline(m_BaselineFileName);
+    }
+    writeResults(m_OutputFileName);
+    MPI_Bcast(&Regressions,1,MPI_INT,0,PETSC_COMM_WORLD);
+    return Regressions>0?1:0;
+}
+
+bool BenchmarkSuite::isSelected(const string &name)const{
+    return m_Filter.empty()||name.find(m_Filter)!=string::npos;
+}
+
+void BenchmarkSuite::addResult(const string &name,const int &size,const double &time,const double &mintime,const long &calls){
+    nlohmann::json result;
+    result["name"]=name;
+    result["size"]=size;
+    result["time"]=time;
+    result["time-min"]=mintime;
+    result["calls"]=calls;
+    m_Results.push_back(result);
+
+    char buff[110];
+    snprintf(buff,110,"  %-52s %12.4e [s]",name.c_str(),time);
+    MessagePrinter::printNormalTxt(buff);
+}
+
+void BenchmarkSuite::writeResults(const string &filename)const{
+    if(m_Rank!=0) return;
+    nlohmann::json report;
+    report["asfem-bench"]=1;
+    report["ranks"]=m_Size;
+    report["min-time"]=m_MinBatchTime;
+    report["repeats"]=m_Repeats;
+    report["benchmarks"]=m_Results;
+    std::ofstream out;
+    out.open(filename,std::ios::out);
+    if(!out.is_open()){
+        MessagePrinter::printErrorTxt("can\'t write the benchmark results to "+filename);
+        return;
+    }
+    out<<report.dump(4)<<std::endl;
+    out.close();
+    MessagePrinter::printNormalTxt("Benchmark results are saved to "+filename);
+}
+
+int BenchmarkSuite::compareWithBaseline(const string &filename){
+    if(m_Rank!=0) return 0;
+    std::ifstream in;
+    in.open(filename,std::ios::in);
+    if(!in.is_open()){
+        MessagePrinter::printErrorTxt("can\'t open the baseline file "+filename);
+        return 1;
+    }
+    nlohmann::json baseline;
+    try{
+        baseline=nlohmann::json::parse(in);
+    }
+    catch(const nlohmann::json::exception &e){
+        MessagePrinter::printErrorTxt("invalid baseline file "+filename+", "+e.what());
+        return 1;
+    }
+    in.close();
+    if(!baseline.contains("benchmarks")||!baseline.at("benchmarks").is_array()){
+        MessagePrinter::printErrorTxt("no 'benchmarks' array in the baseline file "+filename);
+        return 1;
+    }
+    if(baseline.contains("ranks")&&baseline.at("ranks")!=m_Size){
+        MessagePrinter::printWarningTxt("the baseline is created with a different number of ranks");
+    }
+
+    std::map<string,double> BaseTimes;
+    for(const auto &it:baseline.at("benchmarks")){
+        BaseTimes[it.at("name").get<string>()]=it.at("time").get<double>();
+    }
+
+    int Regressions=0,Improvements=0,Missing=0;
+    double ratio;
+    char buff[110];
+    string status;
+    MessagePrinter::printStars();
+    MessagePrinter::printNormalTxt("Compare with the baseline: "+filename);
+    for(auto &result:m_Results){
+        const string name=result.at("name").get<string>();
+        if(!BaseTimes.count(name)||BaseTimes[name]<=0.0){
+            Missing+=1;
+            result["status"]="new";
+            continue;
+        }
+        ratio=result.at("time").get<double>()/BaseTimes[name];
+        if(ratio>1.0+m_Tolerance){
+            status="regression";Regressions+=1;
+        }
+        else if(ratio<1.0/(1.0+m_Tolerance)){
+            status="improvement";Improvements+=1;
+        }
+        else{
+            status="ok";
+        }
+        result["baseline-time"]=BaseTimes[name];
+        result["ratio"]=ratio;
+        result["status"]=status;
+        if(status!="ok"){
+            snprintf(buff,110,"  %-52s %7.3fx %s",name.c_str(),ratio,status.c_str());
+            if(status=="regression") MessagePrinter::printWarningTxt(buff);
+            else MessagePrinter::printNormalTxt(buff);
+        }
+    }
+    snprintf(buff,110,"%d regressions, %d improvements, %d new cases (tolerance=%.3f)",
+             Regressions,Improvements,Missing,m_Tolerance);
+    MessagePrinter::printNormalTxt(buff);
+    MessagePrinter::printStars();
+    return Regressions;
+}
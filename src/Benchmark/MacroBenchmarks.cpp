@@ -0,0 +1,137 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.12
+//+++ Purpose: the macro benchmarks, the whole FEProblem is solved
+//+++          on the generated meshes of several sizes, and the
+//+++          phase time is read from the profiler report
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <fstream>
+
+#include "Benchmark/BenchmarkSuite.h"
+#include "FEProblem/FEProblem.h"
+
+/**
+ * create the input file of the macro benchmark
+ * @param filename the input file name
+ * @param is3d true for the 3d linear elastic case, otherwise the 2d poisson case
+ * @param n the number of elements along each direction
+ */
+static void writeMacroInputFile(const string &filename,const bool &is3d,const int &n){
+    nlohmann::json input;
+    if(is3d){
+        input["mesh"]={{"type","asfem"},{"dim",3},{"nx",n},{"ny",n},{"nz",n},
+                       {"xmax",1.0},{"ymax",1.0},{"zmax",1.0},{"meshtype","hex8"},{"savemesh",false}};
+        input["dofs"]={{"names",{"ux","uy","uz"}}};
+        input["elements"]["elmt1"]={{"type","mechanics"},{"dofs",{"ux","uy","uz"}},
+                                    {"material",{{"type","linearelastic"},{"parameters",{{"E",1000.0},{"nu",0.3}}}}}};
+        input["projection"]={{"type","default"},{"scalarmate",{"vonMises-stress"}}};
+        input["bcs"]["fix"]={{"type","dirichlet"},{"dofs",{"ux","uy","uz"}},{"bcvalue",0.0},{"side",{"left"}}};
+        input["bcs"]["load"]={{"type","dirichlet"},{"dofs",{"ux"}},{"bcvalue",0.01},{"side",{"right"}}};
+    }
+    else{
+        input["mesh"]={{"type","asfem"},{"dim",2},{"nx",n},{"ny",n},
+                       {"xmax",1.0},{"ymax",1.0},{"meshtype","quad4"},{"savemesh",false}};
+        input["dofs"]={{"names",{"phi"}}};
+        input["elements"]["elmt1"]={{"type","poisson"},{"dofs",{"phi"}},
+                                    {"material",{{"type","constpoisson"},{"parameters",{{"sigma",1.0},{"f",0.1}}}}}};
+        input["projection"]={{"type","default"},{"vectormate",{"gradu"}}};
+        input["bcs"]["left"]={{"type","dirichlet"},{"dofs",{"phi"}},{"bcvalue",0.0},{"side",{"left"}}};
+        input["bcs"]["right"]={{"type","neumann"},{"dofs",{"phi"}},{"bcvalue",0.1},{"side",{"right"}}};
+    }
+    input["linearsolver"]={{"type","cg"},{"preconditioner","gamg"},{"maxiters",10000},{"tolerance",1.0e-10}};
+    input["nlsolver"]={{"type","newton"},{"maxiters",20},{"abs-tolerance",5.0e-7},
+                       {"rel-tolerance",5.0e-10},{"s-tolerance",0.0}};
+    input["output"]={{"type","vtu"},{"interval",1}};
+    input["qpoints"]["bulk"]={{"type","gauss-legendre"},{"order",2}};
+    input["job"]={{"type","static"},{"print","off"}};
+
+    std::ofstream out;
+    out.open(filename,std::ios::out);
+    if(!out.is_open()){
+        MessagePrinter::printErrorTxt("can\'t create the benchmark input file "+filename+", please check your '--workdir'");
+        MessagePrinter::exitAsFem();
+    }
+    out<<input.dump(4)<<std::endl;
+    out.close();
+}
+
+void BenchmarkSuite::runMacroBenchmarks(){
+    struct MacroCase{
+        string Name;
+        bool Is3D;
+        int BaseSize;
+    };
+    // the 2d mesh is refined by 2 along each direction per level, the 3d one grows linearly to keep the cost moderate
+    const vector<MacroCase> cases={{"poisson2d-quad4",false,64},{"elasticity3d-hex8",true,8}};
+    const vector<string> phases={"assembly","linear-solve","projection","output"};
+
+    string prefix,inputfile;
+    int n;
+    for(const auto &it:cases){
+        for(int level=0;level<m_MacroLevels;level++){
+            n=it.Is3D?it.BaseSize*(level+1):it.BaseSize*(1<<level);
+            prefix="macro/"+it.Name+"/n"+to_string(n);
+            if(!isSelected(prefix)) continue;
+            MessagePrinter::printNormalTxt("Run "+prefix+" ...");
+
+            inputfile=m_WorkDir+"/bench-"+it.Name+"-n"+to_string(n)+".json";
+            if(m_Rank==0) writeMacroInputFile(inputfile,it.Is3D,n);
+            MPI_Barrier(PETSC_COMM_WORLD);
+
+            // the same command line as 'asfem -i input.json --profile'
+            vector<string> args={"asfem","-i",inputfile,"--profile"};
+            vector<char*> argv;
+            for(auto &arg:args) argv.push_back(&arg[0]);
+
+            std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+            {
+                FEProblem feProblem;
+                feProblem.initFEProblem(static_cast<int>(argv.size()),argv.data());
+                feProblem.run();
+                feProblem.finalize();
+            }
+            double total=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+            double maxtotal;
+            MPI_Allreduce(&total,&maxtotal,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);
+
+            // the phase time is the max-over-ranks time of all the scopes with the same name
+            vector<double> times(phases.size(),0.0);
+            if(m_Rank==0){
+                std::ifstream in;
+                in.open(inputfile.substr(0,inputfile.size()-5)+"-profile.json",std::ios::in);
+                if(in.is_open()){
+                    nlohmann::json report=nlohmann::json::parse(in,nullptr,false);
+                    in.close();
+                    if(report.contains("scopes")){
+                        for(const auto &scope:report.at("scopes")){
+                            const string path=scope.at("scope").get<string>();
+                            const string leaf=path.substr(path.find_last_of('/')+1);
+                            for(int i=0;i<static_cast<int>(phases.size());i++){
+                                if(leaf==phases[i]) times[i]+=scope.at("time-max").get<double>();
+                            }
+                        }
+                    }
+                }
+                else{
+                    MessagePrinter::printWarningTxt("can\'t read the profiler report of "+inputfile);
+                }
+            }
+            MPI_Bcast(times.data(),static_cast<int>(times.size()),MPI_DOUBLE,0,PETSC_COMM_WORLD);
+
+            const int nElmts=it.Is3D?n*n*n:n*n;
+            for(int i=0;i<static_cast<int>(phases.size());i++){
+                addResult(prefix+"/"+phases[i],nElmts,times[i],times[i],1);
+            }
+            addResult(prefix+"/total",nElmts,maxtotal,maxtotal,1);
+        }
+    }
+}
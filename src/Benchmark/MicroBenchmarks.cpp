@@ -0,0 +1,385 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.12
+//+++ Purpose: the micro benchmarks, i.e., shape functions, tensor
+//+++          kernels, materials, elements, and the PETSc vector
+//+++          and sparse matrix operations
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Benchmark/BenchmarkSuite.h"
+#include "FE/ShapeFun.h"
+#include "FE/QPoint.h"
+#include "MathUtils/Rank2Tensor.h"
+#include "MathUtils/Rank4Tensor.h"
+#include "MathUtils/Vector.h"
+#include "MathUtils/SparseMatrix.h"
+#include "MateSystem/MateSystem.h"
+#include "ElmtSystem/ElmtSystem.h"
+
+/**
+ * check whether the mesh type is a simplex one
+ */
+static bool isSimplexMesh(const MeshType &t_MeshType){
+    return t_MeshType==MeshType::TRI3||t_MeshType==MeshType::TRI6||
+           t_MeshType==MeshType::TET4||t_MeshType==MeshType::TET10;
+}
+/**
+ * get the nodal coordinates of the reference element, each node is the candidate point where its own shape function
+ * equals one, so the node ordering of the shape function library is always respected
+ * @param t_shp the initialized shape function class
+ * @param dim the dimension of the element
+ * @param nodesnum the number of nodes of the element
+ * @param simplex true for the simplex element
+ * @param nodes the nodal coordinates of the reference element
+ */
+static bool getReferenceNodes(ShapeFun &t_shp,const int &dim,const int &nodesnum,const bool &simplex,Nodes &nodes){
+    vector<double> cands;
+    if(dim==1) cands={-1.0,-1.0/3.0,0.0,1.0/3.0,1.0};
+    else if(simplex) cands={0.0,0.5,1.0};
+    else cands={-1.0,0.0,1.0};
+    const int n=static_cast<int>(cands.size());
+
+    Nodes dummy(nodesnum);
+    vector<bool> found(nodesnum,false);
+    double x[3];
+    nodes.resize(nodesnum);
+    for(int a=0;a<n;a++){
+        for(int b=0;b<(dim>1?n:1);b++){
+            for(int c=0;c<(dim>2?n:1);c++){
+                x[0]=cands[a];x[1]=dim>1?cands[b]:0.0;x[2]=dim>2?cands[c]:0.0;
+                if(simplex&&x[0]+x[1]+x[2]>1.0+1.0e-12) continue;
+                // the nodes are not used for the shape function values
+                t_shp.calc(x[0],x[1],x[2],dummy,false);
+                for(int k=1;k<=nodesnum;k++){
+                    if(std::abs(t_shp.shape_value(k)-1.0)>1.0e-10) continue;
+                    found[k-1]=true;
+                    for(int j=1;j<=3;j++) nodes(k,j)=x[j-1];
+                }
+            }
+        }
+    }
+    for(const auto &it:found){
+        if(!it) return false;
+    }
+    // a slightly sheared element, so the jacobian is not the identity one
+    for(int k=1;k<=nodesnum;k++){
+        nodes(k,1)=1.2*nodes(k,1)+0.1*nodes(k,2);
+        nodes(k,2)=0.9*nodes(k,2)+0.05*nodes(k,3);
+    }
+    return true;
+}
+
+void BenchmarkSuite::runShapeFunBenchmarks(){
+    struct ShapeFunCase{
+        string Name;
+        MeshType Type;
+        int Dim;
+        int NodesNum;
+        int Order;
+    };
+    const vector<ShapeFunCase> cases={
+        {"edge2",MeshType::EDGE2,1,2,1},{"edge3",MeshType::EDGE3,1,3,2},{"edge4",MeshType::EDGE4,1,4,3},
+        {"tri3",MeshType::TRI3,2,3,1},{"tri6",MeshType::TRI6,2,6,2},
+        {"quad4",MeshType::QUAD4,2,4,1},{"quad8",MeshType::QUAD8,2,8,2},{"quad9",MeshType::QUAD9,2,9,2},
+        {"tet4",MeshType::TET4,3,4,1},{"tet10",MeshType::TET10,3,10,2},
+        {"hex8",MeshType::HEX8,3,8,1},{"hex20",MeshType::HEX20,3,20,2},{"hex27",MeshType::HEX27,3,27,2}
+    };
+    for(const auto &it:cases){
+        const string name="micro/shapefun/"+it.Name;
+        if(!isSelected(name)) continue;
+        ShapeFun shp;
+        shp.setMeshType(it.Type);
+        shp.init();
+        Nodes nodes;
+        if(!getReferenceNodes(shp,it.Dim,it.NodesNum,isSimplexMesh(it.Type),nodes)){
+            MessagePrinter::printWarningTxt("can\'t find the reference nodes of "+it.Name+", skip its benchmark");
+            continue;
+        }
+        QPoint qpoints;
+        qpoints.setDim(it.Dim);
+        qpoints.setMeshType(it.Type);
+        qpoints.setQPointType(QPointType::GAUSSLEGENDRE);
+        qpoints.setOrder(it.Order+1);
+        qpoints.createQPoints();
+        const int nQps=qpoints.getQPointsNum();
+        // one call evaluates the shape functions and gradients on all the qpoints of one element
+        timeKernel(name,nQps,[&](){
+            double sum=0.0,xi,eta,zeta;
+            for(int qp=1;qp<=nQps;qp++){
+                xi  =qpoints.getIthPointJthCoord(qp,1);
+                eta =it.Dim>1?qpoints.getIthPointJthCoord(qp,2):0.0;
+                zeta=it.Dim>2?qpoints.getIthPointJthCoord(qp,3):0.0;
+                shp.calc(xi,eta,zeta,nodes,true);
+                sum+=shp.getJacDet();
+            }
+            return sum;
+        });
+    }
+}
+
+void BenchmarkSuite::runTensorBenchmarks(){
+    Rank2Tensor A(0.0),B(0.0),F(0.0),I(0.0);
+    Rank4Tensor C(0.0),D(0.0);
+    A.setToRandom();B.setToRandom();
+    I.setToIdentity();
+    F=I+A*0.1;
+    A=(A+A.transpose())*0.5;// the symmetric one for the eigen decomposition
+    C.setFromEAndNu(210.0,0.3);
+    D.setToRandom();
+    Vector3d gradtest(0.0),gradtrial(0.0);
+    gradtest(1)=0.3;gradtest(2)=-0.2;gradtest(3)=0.1;
+    gradtrial(1)=-0.1;gradtrial(2)=0.4;gradtrial(3)=0.2;
+
+    timeKernel("micro/tensor/rank2-product",9,[&](){return (F*B)(1,2);});
+    timeKernel("micro/tensor/rank2-doubledot",9,[&](){return F.doubledot(B);});
+    timeKernel("micro/tensor/rank2-inverse",9,[&](){return F.inverse()(2,1);});
+    timeKernel("micro/tensor/rank2-exp",9,[&](){return A.exp()(1,1);});
+    timeKernel("micro/tensor/rank2-eigen",9,[&](){
+        double eigval[3];
+        Rank2Tensor eigvec;
+        A.calcEigenValueAndEigenVectors(eigval,eigvec);
+        return eigval[0];
+    });
+    timeKernel("micro/tensor/rank2-positive-projection",81,[&](){return A.getPositiveProjectionTensor()(1,1,2,2);});
+    timeKernel("micro/tensor/rank2-otimes",81,[&](){return F.otimes(B)(1,2,1,2);});
+    timeKernel("micro/tensor/rank4-doubledot-rank2",81,[&](){return C.doubledot(F)(1,1);});
+    timeKernel("micro/tensor/rank4-doubledot-rank4",81,[&](){return C.doubledot(D)(1,2,2,1);});
+    timeKernel("micro/tensor/rank4-push-forward",81,[&](){return C.pushForward(F)(1,1,1,1);});
+    timeKernel("micro/tensor/rank4-ik-component",81,[&](){return C.getIKComponent(1,2,gradtest,gradtrial);});
+}
+
+void BenchmarkSuite::runMateAndElmtBenchmarks(){
+    struct MateElmtCase{
+        string ElmtName;
+        ElmtType Elmt;
+        string MateName;
+        MateType Mate;
+        int Dim;
+        int DofsNum;
+        string Params;
+    };
+    // the parameters are taken from the examples
+    const vector<MateElmtCase> cases={
+        {"poisson",ElmtType::POISSONELMT,"constpoisson",MateType::CONSTPOISSONMATE,2,1,R"({"sigma":1.0,"f":0.1})"},
+        {"poisson",ElmtType::POISSONELMT,"poisson1d-benchmark",MateType::POISSON1DBENCHMARKMATE,1,1,R"({"sigma":1.0,"a":2.0})"},
+        {"poisson",ElmtType::POISSONELMT,"poisson2d-benchmark",MateType::POISSON2DBENCHMARKMATE,2,1,R"({"sigma":1.0,"f":6.0})"},
+        {"poisson",ElmtType::POISSONELMT,"nonlinear-poisson2d",MateType::NONLINEARPOISSON2DMATE,2,1,R"({"sigma":1.0})"},
+        {"poisson",ElmtType::POISSONELMT,"nonlinear-poisson3d",MateType::NONLINEARPOISSON3DMATE,3,1,R"({"sigma":1.0})"},
+        {"diffusion",ElmtType::DIFFUSIONELMT,"constdiffusion",MateType::CONSTDIFFUSIONNMATE,2,1,R"({"D":1.0})"},
+        {"diffusion",ElmtType::DIFFUSIONELMT,"nonlinear-diffusion2d",MateType::NONLINEARDIFFUSION2DMATE,2,1,R"({"D":0.5,"Delta":0.75})"},
+        {"allencahn",ElmtType::ALLENCAHNELMT,"doublewell",MateType::DOUBLEWELLMATE,2,1,
+         R"({"L":100.0,"eps":0.05,"alpha":0.0,"beta":1.0,"w":100.0})"},
+        {"cahnhilliard",ElmtType::CAHNHILLIARDELMT,"binarymixture",MateType::BINARYMIXMATE,2,2,
+         R"({"D":10.0,"chi":2.5,"kappa":0.005})"},
+        {"kobayashi",ElmtType::KOBAYASHIELMT,"kobayashimate",MateType::KOBAYASHIMATE,2,2,
+         R"({"L":1000.0,"k0":0.005,"delta":0.08,"N":4.0,"Latent-heat":-2.5})"},
+        {"mechanics",ElmtType::MECHANICSELMT,"linearelastic",MateType::LINEARELASTICMATE,3,3,R"({"E":1000.0,"nu":0.3})"},
+        {"mechanics",ElmtType::MECHANICSELMT,"saintvenant",MateType::SAINTVENANTMATE,3,3,R"({"E":1000.0,"nu":0.3})"},
+        {"mechanics",ElmtType::MECHANICSELMT,"neohookean",MateType::NEOHOOKEANMATE,3,3,R"({"Lame":432.099,"mu":185.185})"},
+        {"mechanics",ElmtType::MECHANICSELMT,"smallstrainj2plasticity",MateType::SMALLSTRAINJ2PLASTICITYMATE,3,3,
+         R"({"E":210.0,"nu":0.3,"Hardening-modulus":3.5,"Yield-stress":1.2})"},
+        {"mechanics",ElmtType::MECHANICSELMT,"smallstrainexplawj2plasticity",MateType::SMALLSTRAINEXPLAWJ2PLASTICITYMATE,2,2,
+         R"({"E":210.0,"nu":0.3,"Kinf":3.5,"K0":1.0,"delta":35.0,"Yield-stress":0.8,"maxiters":200,"tolerance":5.0e-5})"},
+        {"stressdiffusion",ElmtType::STRESSDIFFUSIONELMT,"smallstraindiffusion",MateType::SMALLSTRAINDIFFUSIONMATE,2,3,
+         R"({"D":1.0,"Omega":0.05,"cref":0.1,"E":120.0,"nu":0.3})"},
+        {"stressdiffusion",ElmtType::STRESSDIFFUSIONELMT,"smallstraindiffusionj2plasticity",MateType::SMALLSTRAINDIFFUSIONJ2MATE,2,3,
+         R"({"D":10.0,"Omega":0.01,"Cref":0.1,"E":100.0,"nu":0.3,"Yield-stress":2.0,"Hardening-modulus":2.5})"},
+        {"stresscahnhilliard",ElmtType::STRESSCAHNHILLIARDELMT,"smallstraincahnhilliard",MateType::SMALLSTRAINCAHNHILLIARDMATE,2,4,
+         R"({"D":1.0,"Height":3.5,"kappa":0.005,"Ca":0.0,"Cb":1.0,"cref":0.1,"Omega":0.06,"E":150.0,"nu":0.3})"},
+        {"allencahnfracture",ElmtType::ALLENCAHNFRACTUREELMT,"linearelasticfracture",MateType::LINEARELASTICFRACMATE,2,3,
+         R"({"L":1.0e6,"Gc":0.0027,"eps":0.012,"K":121.15,"G":80.77,"stabilizer":1.0e-5,"finite-strain":false})"},
+        {"allencahnfracture",ElmtType::ALLENCAHNFRACTUREELMT,"neohookeanpffracture",MateType::NEOHOOKEANPFFRACTUREMATE,2,3,
+         R"({"L":1.0e6,"Gc":0.0027,"eps":0.01,"K":121.15,"G":80.77,"stabilizer":1.0e-6,"finite-strain":true})"},
+        {"miehefracture",ElmtType::MIEHEFRACTUREELMT,"miehefracture",MateType::MIEHEFRACTUREMATE,2,3,
+         R"({"viscosity":1.0e-6,"Gc":0.0027,"eps":0.012,"K":121.15,"G":80.77,"stabilizer":1.0e-6,"finite-strain":false,"plane-strain":true})"},
+        {"diffusionacfracture",ElmtType::DIFFUSIONACFRACTUREELMT,"diffusionacfracture",MateType::DIFFUSIONACFRACTUREMATE,2,4,
+         R"({"D":50.0,"Omega":0.01,"Cref":0.1,"L":1.0e6,"Gc":0.0057,"eps":0.012,"E":100.0,"nu":0.25,"stabilizer":1.0e-5,"finite-strain":false})"}
+    };
+
+    LocalElmtInfo elmtinfo;
+    LocalElmtSolution elmtsoln;
+    LocalShapeFun localshp;
+    const double dt=1.0e-3;
+    const double ctan[3]={1.0,1.0/dt,0.0};
+    for(const auto &it:cases){
+        const string matename="micro/material/"+it.MateName;
+        const string elmtname="micro/element/"+it.ElmtName+"-"+it.MateName;
+        if(!isSelected(matename)&&!isSelected(elmtname)) continue;
+
+        // the reference element is the linear one of each dimension
+        const MeshType meshtype=it.Dim==1?MeshType::EDGE2:(it.Dim==2?MeshType::QUAD4:MeshType::HEX8);
+        const int nNodes=it.Dim==1?2:(it.Dim==2?4:8);
+        ShapeFun shp;
+        shp.setMeshType(meshtype);
+        shp.init();
+        Nodes nodes;
+        getReferenceNodes(shp,it.Dim,nNodes,false,nodes);
+        shp.calc(0.2,it.Dim>1?-0.3:0.0,it.Dim>2?0.1:0.0,nodes,true);
+
+        elmtinfo.m_Dim=it.Dim;
+        elmtinfo.m_NodesNum=nNodes;
+        elmtinfo.m_DofsNum=it.DofsNum;
+        elmtinfo.m_T=0.1;
+        elmtinfo.m_Dt=dt;
+        elmtinfo.m_ElmtID=1;
+        elmtinfo.m_ElmtsNum=1;
+        elmtinfo.m_QpointsNum=1;
+        elmtinfo.m_QpointID=1;
+        elmtinfo.m_QpCoords0=0.0;
+        elmtinfo.m_QpCoords0(1)=0.1;elmtinfo.m_QpCoords0(2)=0.2;
+        elmtinfo.m_QpCoords=elmtinfo.m_QpCoords0;
+
+        // a small and smooth solution state, the phase-field like variables are kept inside (0,1)
+        elmtsoln.m_QpU.assign(it.DofsNum+1,0.0);
+        elmtsoln.m_QpUold.assign(it.DofsNum+1,0.0);
+        elmtsoln.m_QpUolder.assign(it.DofsNum+1,0.0);
+        elmtsoln.m_QpV.assign(it.DofsNum+1,0.0);
+        elmtsoln.m_QpA.assign(it.DofsNum+1,0.0);
+        elmtsoln.m_QpGradU.assign(it.DofsNum+1,Vector3d(0.0));
+        elmtsoln.m_QpGradUold.assign(it.DofsNum+1,Vector3d(0.0));
+        elmtsoln.m_QpGradUolder.assign(it.DofsNum+1,Vector3d(0.0));
+        elmtsoln.m_QpGradV.assign(it.DofsNum+1,Vector3d(0.0));
+        elmtsoln.m_Qpgradu.assign(it.DofsNum+1,Vector3d(0.0));
+        elmtsoln.m_Qpgradv.assign(it.DofsNum+1,Vector3d(0.0));
+        for(int i=1;i<=it.DofsNum;i++){
+            elmtsoln.m_QpU[i]=0.2+0.1*i;
+            elmtsoln.m_QpUold[i]=0.19+0.1*i;
+            elmtsoln.m_QpUolder[i]=0.18+0.1*i;
+            elmtsoln.m_QpV[i]=10.0;
+            for(int j=1;j<=it.Dim;j++){
+                elmtsoln.m_QpGradU[i](j)=1.0e-3*(i+j);
+                elmtsoln.m_QpGradUold[i](j)=0.9e-3*(i+j);
+                elmtsoln.m_QpGradUolder[i](j)=0.8e-3*(i+j);
+                elmtsoln.m_QpGradV[i](j)=0.1;
+            }
+            elmtsoln.m_Qpgradu[i]=elmtsoln.m_QpGradU[i];
+            elmtsoln.m_Qpgradv[i]=elmtsoln.m_QpGradV[i];
+        }
+
+        ElmtBlock block;
+        block.m_ElmtBlockIndex=1;
+        block.m_ElmtBlockName="bench";
+        block.m_ElmtTypeName=it.ElmtName;
+        block.m_ElmtType=it.Elmt;
+        block.m_MateTypeName=it.MateName;
+        block.m_MateType=it.Mate;
+        for(int i=1;i<=it.DofsNum;i++) block.m_DofIDs.push_back(i);
+        block.m_JsonParams=nlohmann::json::parse(it.Params);
+        ElmtSystem elmtsystem;
+        elmtsystem.addElmtBlock2List(block);
+
+        MateSystem matesystem;
+        matesystem.initBulkMateLibs(it.Mate,block.m_JsonParams,elmtinfo,elmtsoln);
+        matesystem.m_MaterialContainerOld.getScalarMaterialsRef()=matesystem.m_MaterialContainer.getScalarMaterialsCopy();
+        matesystem.m_MaterialContainerOld.getVectorMaterialsRef()=matesystem.m_MaterialContainer.getVectorMaterialsCopy();
+        matesystem.m_MaterialContainerOld.getRank2MaterialsRef()=matesystem.m_MaterialContainer.getRank2MaterialsCopy();
+        matesystem.m_MaterialContainerOld.getRank4MaterialsRef()=matesystem.m_MaterialContainer.getRank4MaterialsCopy();
+
+        // one call updates the materials of one qpoint
+        timeKernel(matename,it.DofsNum,[&](){
+            matesystem.runBulkMateLibs(it.Mate,block.m_JsonParams,elmtinfo,elmtsoln);
+            return 0.0;
+        });
+        matesystem.runBulkMateLibs(it.Mate,block.m_JsonParams,elmtinfo,elmtsoln);
+
+        // one call forms the residual and jacobian of all the node pairs on one qpoint, as done in FormBulkFE
+        MatrixXd K(it.DofsNum+1,it.DofsNum+1,0.0);
+        VectorXd R(it.DofsNum+1,0.0);
+        timeKernel(elmtname,nNodes*it.DofsNum,[&](){
+            double sum=0.0;
+            for(int i=1;i<=nNodes;i++){
+                localshp.m_Test=shp.shape_value(i);
+                localshp.m_GradTest=shp.shape_grad(i);
+                localshp.m_GradTestCurrent=shp.shape_grad(i);
+                for(int j=1;j<=nNodes;j++){
+                    localshp.m_Trial=shp.shape_value(j);
+                    localshp.m_GradTrial=shp.shape_grad(j);
+                    localshp.m_GradTrialCurrent=shp.shape_grad(j);
+                    elmtsystem.runBulkElmtLibs(FECalcType::COMPUTERESIDUALANDJACOBIAN,ctan,1,
+                                               matesystem.m_MaterialContainerOld,matesystem.m_MaterialContainer,
+                                               elmtinfo,elmtsoln,localshp,K,R);
+                    sum+=K(1,1);
+                }
+                sum+=R(1);
+            }
+            return sum;
+        });
+    }
+}
+
+void BenchmarkSuite::runLinearAlgebraBenchmarks(){
+    // the 5-point laplacian of a n x n grid
+    const int n=200;
+    const int nRows=n*n;
+    Vector U(nRows),V(nRows),Y(nRows);
+    U.setToRandom();V.setToRandom();
+    PetscInt iStart,iEnd;
+    VecGetOwnershipRange(U.getVectorRef(),&iStart,&iEnd);
+
+    timeKernel("micro/vector/dot",nRows,[&](){return U.dot(V);});
+    timeKernel("micro/vector/norm",nRows,[&](){return U.getNorm();});
+    timeKernel("micro/vector/axpy",nRows,[&](){
+        VecAXPY(Y.getVectorRef(),1.0e-6,U.getVectorRef());
+        return 0.0;
+    });
+    timeKernel("micro/vector/ghost-copy",nRows,[&](){
+        U.makeGhostCopy();
+        return U.getIthValueFromGhost(1);
+    });
+    U.destroyGhostCopy();
+
+    // the element-like insertion, 4 entries per block, all the local rows are visited once
+    int index[4];
+    double vals[4]={0.25,0.25,0.25,0.25};
+    timeKernel("micro/vector/add-values",nRows,[&](){
+        Y.setToZero();
+        for(PetscInt row=iStart;row+3<iEnd;row+=4){
+            for(int k=0;k<4;k++) index[k]=static_cast<int>(row)+k;
+            Y.addValues(4,index,vals);
+        }
+        Y.assemble();
+        return 0.0;
+    });
+
+    SparseMatrix A;
+    A.resize(nRows,nRows,5);
+    PetscInt rStart,rEnd;
+    int cols[5],ncols,i,j;
+    double stencil[5];
+    auto assembleLaplacian=[&](){
+        MatGetOwnershipRange(A.getReference(),&rStart,&rEnd);
+        for(PetscInt row=rStart;row<rEnd;row++){
+            i=static_cast<int>(row)/n;j=static_cast<int>(row)%n;
+            ncols=0;
+            cols[ncols]=static_cast<int>(row);stencil[ncols++]=4.0;
+            if(i>0)  {cols[ncols]=static_cast<int>(row)-n;stencil[ncols++]=-1.0;}
+            if(i<n-1){cols[ncols]=static_cast<int>(row)+n;stencil[ncols++]=-1.0;}
+            if(j>0)  {cols[ncols]=static_cast<int>(row)-1;stencil[ncols++]=-1.0;}
+            if(j<n-1){cols[ncols]=static_cast<int>(row)+1;stencil[ncols++]=-1.0;}
+            int r=static_cast<int>(row);
+            A.addValues(1,&r,ncols,cols,stencil);
+        }
+        A.assemble();
+    };
+    assembleLaplacian();
+    timeKernel("micro/sparsematrix/assembly",nRows,[&](){
+        A.setToZero();
+        assembleLaplacian();
+        return 0.0;
+    });
+    timeKernel("micro/sparsematrix/matmult",nRows,[&](){
+        MatMult(A.getReference(),U.getVectorRef(),Y.getVectorRef());
+        return 0.0;
+    });
+    timeKernel("micro/sparsematrix/norm",nRows,[&](){return A.getNorm();});
+    A.releaseMemory();
+    U.releaseMemory();V.releaseMemory();Y.releaseMemory();
+}
@@ -26,6 +26,12 @@ BulkDofHandler::BulkDofHandler(){
     m_ActiveDofs=0;
     m_ElementalDofIDs_Global.clear();
     m_NodalDofIDs_Global.clear();
+    m_IsImplicitDofsMap=false;
+    m_HangingNodeIDs.clear();
+    m_HangingMasterPtr.clear();
+    m_HangingMasterIDs.clear();
+    m_HangingMasterWeights.clear();
+    m_NodeHangingIDs.clear();
 }
 
 void BulkDofHandler::releaseMemory(){
@@ -40,6 +46,12 @@ void BulkDofHandler::releaseMemory(){
     m_ActiveDofs=0;
     m_ElementalDofIDs_Global.clear();
     m_NodalDofIDs_Global.clear();
+    m_IsImplicitDofsMap=false;
+    m_HangingNodeIDs.clear();
+    m_HangingMasterPtr.clear();
+    m_HangingMasterIDs.clear();
+    m_HangingMasterWeights.clear();
+    m_NodeHangingIDs.clear();
 }
 BulkDofHandler::~BulkDofHandler(){
     m_DofNameList.clear();
@@ -53,6 +65,12 @@ BulkDofHandler::~BulkDofHandler(){
     m_ActiveDofs=0;
     m_ElementalDofIDs_Global.clear();
     m_NodalDofIDs_Global.clear();
+    m_IsImplicitDofsMap=false;
+    m_HangingNodeIDs.clear();
+    m_HangingMasterPtr.clear();
+    m_HangingMasterIDs.clear();
+    m_HangingMasterWeights.clear();
+    m_NodeHangingIDs.clear();
 }
 
 void BulkDofHandler::printBulkDofsInfo()const{
@@ -100,7 +118,7 @@ void BulkDofHandler::printBulkElementalDofsInfo(const bool &flag)const{
                <<", max dofs per elmt="<<m_MaxDofsPerElmt<<endl;
             for(int e=1;e<=m_BulkElmtsNum;e++){
                 str="*** "+to_string(e)+"-th element: ";
-                for(const auto &dofid:m_ElementalDofIDs_Global[e-1]) str+=to_string(dofid)+" ";
+                for(int j=1;j<=getIthBulkElmtDofsNum(e);j++) str+=to_string(getIthBulkElmtJthDofID(e,j))+" ";
                 out<<str<<endl;
             }
             out.close();
@@ -116,7 +134,7 @@ void BulkDofHandler::printBulkElementalDofsInfo(const bool &flag)const{
         string str;
         for(int e=1;e<=m_BulkElmtsNum;e++){
             str="*** "+to_string(e)+"-th element: ";
-            for(const auto &dofid:m_ElementalDofIDs_Global[e-1]) str+=to_string(dofid)+" ";
+            for(int j=1;j<=getIthBulkElmtDofsNum(e);j++) str+=to_string(getIthBulkElmtJthDofID(e,j))+" ";
             cout<<str<<endl;
         }
     }
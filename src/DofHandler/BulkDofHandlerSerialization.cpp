@@ -0,0 +1,83 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.05
+//+++ Purpose: write/read the dofs map of each rank into/from the
+//+++          binary buffer (for the model cache)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "DofHandler/BulkDofHandler.h"
+
+namespace{
+    void writeVectorOfIntVector(BinaryWriter &writer,const vector<vector<int>> &vec){
+        writer.writeValue(static_cast<uint64_t>(vec.size()));
+        for(const auto &it:vec) writer.writeVector(it);
+    }
+    bool readVectorOfIntVector(BinaryReader &reader,vector<vector<int>> &vec){
+        uint64_t n;
+        if(!reader.readValue(n)||n>reader.getRemainingSize()) return false;
+        vec.resize(static_cast<size_t>(n));
+        for(auto &it:vec){
+            if(!reader.readVector(it)) return false;
+        }
+        return true;
+    }
+}
+
+void BulkDofHandler::writeDofsMap(BinaryWriter &writer)const{
+    writer.writeStringVector(m_DofNameList);
+    writer.writeValue(m_BulkElmtsNum);
+    writer.writeValue(m_NodesNum);
+    writer.writeValue(m_MaxDofsPerNode);
+    writer.writeValue(m_MaxDofsPerElmt);
+    writer.writeValue(m_TotalDofs);
+    writer.writeValue(m_ActiveDofs);
+    writer.writeValue(m_MaxRowNNZ);
+    writer.writeValue(m_MaxNNZ);
+    writeVectorOfIntVector(writer,m_ElementalDofIDs_Global);
+    writeVectorOfIntVector(writer,m_ElementalDofIDs_Local);
+    writeVectorOfIntVector(writer,m_NodalDofIDs_Global);
+}
+
+bool BulkDofHandler::readDofsMap(BinaryReader &reader,FECell &t_fecell){
+    vector<string> dofnames;
+    int maxdofs;
+    reader.readStringVector(dofnames);
+    if(dofnames!=m_DofNameList){
+        // the dof names come from the input file, they must be the same as the cached ones
+        return false;
+    }
+    reader.readValue(m_BulkElmtsNum);
+    reader.readValue(m_NodesNum);
+    reader.readValue(maxdofs);
+    reader.readValue(m_MaxDofsPerElmt);
+    reader.readValue(m_TotalDofs);
+    reader.readValue(m_ActiveDofs);
+    reader.readValue(m_MaxRowNNZ);
+    reader.readValue(m_MaxNNZ);
+    if(!reader.isValid()||maxdofs!=m_MaxDofsPerNode) return false;
+    if(!readVectorOfIntVector(reader,m_ElementalDofIDs_Global)) return false;
+    if(!readVectorOfIntVector(reader,m_ElementalDofIDs_Local)) return false;
+    if(!readVectorOfIntVector(reader,m_NodalDofIDs_Global)) return false;
+    // the cached model is always conforming, the hanging nodes only come from the mesh adaptivity
+    m_HangingNodeIDs.clear();
+    m_HangingMasterPtr.clear();
+    m_HangingMasterIDs.clear();
+    m_HangingMasterWeights.clear();
+    m_NodeHangingIDs.clear();
+
+    if(static_cast<int>(m_ElementalDofIDs_Local.size())!=t_fecell.getLocalFECellBulkElmtsNum()) return false;
+    // the elemental dof ids of the local fe cells are restored from the cache as well,
+    // here we only make sure they are the same as the ones in the dofs map
+    for(int e=1;e<=t_fecell.getLocalFECellBulkElmtsNum();e++){
+        t_fecell.getLocalBulkFECellVecRef()[e-1].ElmtDofIDs=m_ElementalDofIDs_Local[e-1];
+    }
+    return true;
+}
@@ -25,6 +25,7 @@ void BulkDofHandler::init(){
     m_ActiveDofs=0;
     m_ElementalDofIDs_Global.clear();
     m_NodalDofIDs_Global.clear();
+    m_IsImplicitDofsMap=false;
 }
 
 void BulkDofHandler::addDofName2List(const string &dofname){
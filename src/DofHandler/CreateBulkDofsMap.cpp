@@ -12,11 +12,19 @@
 //+++ Purpose: generate the dofs map for bulk elements
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#include <limits>
+#include <algorithm>
+
 #include "DofHandler/BulkDofHandler.h"
 #include "MPIUtils/MPIDataBus.h"
 
 void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmtSystem){
-    
+    if(t_fecell.isImplicitGrid()){
+        createImplicitBulkDofsMap(t_fecell,t_elmtSystem);
+        return;
+    }
+    m_IsImplicitDofsMap=false;
+
     m_BulkElmtsNum=t_fecell.getFECellBulkElmtsNum();
     m_NodesNum=t_fecell.getFECellNodesNum();
     m_TotalDofs=m_NodesNum*m_MaxDofsPerNode;// maxdofs_pernode dependes on the dofs name 
@@ -24,13 +32,27 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
     m_MaxDofsPerElmt=m_MaxDofsPerNode*t_fecell.getFECellNodesNumPerBulkElmt();
 
 
+    // the hanging node constraints are shared among ranks
+    const FECellData &celldata=t_fecell.getCellDataRef();
+    m_HangingNodeIDs=celldata.HangingNodeIDs_Global;
+    m_HangingMasterPtr=celldata.HangingNodeMasterPtr_Global;
+    m_HangingMasterIDs=celldata.HangingNodeMasterIDs_Global;
+    m_HangingMasterWeights=celldata.HangingNodeMasterWeights_Global;
+    m_NodeHangingIDs.clear();
+    if(hasHangingNodes()){
+        m_NodeHangingIDs.assign(m_NodesNum,-1);
+        for(int i=0;i<static_cast<int>(m_HangingNodeIDs.size());i++) m_NodeHangingIDs[m_HangingNodeIDs[i]-1]=i;
+    }
+
     int rank,size;
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    vector<char> SharedBuf;
+    vector<vector<char>> SendBufs;
     if(rank==0){
-        // allocate memory for nodal and elemental dofs map
-        m_NodalDofIDs_Global.resize(m_NodesNum,vector<int>(m_MaxDofsPerNode,0));
-        m_ElementalDofIDs_Global.resize(m_BulkElmtsNum,vector<int>(m_MaxDofsPerElmt,0));
+        // allocate memory for nodal and elemental dofs map, the dofs map can be rebuilt after the mesh adaptivity
+        m_NodalDofIDs_Global.assign(m_NodesNum,vector<int>(m_MaxDofsPerNode,0));
+        m_ElementalDofIDs_Global.assign(m_BulkElmtsNum,vector<int>(m_MaxDofsPerElmt,0));
         m_ActiveDofs=0;
         int dofid,elmtid,nodeid;
         vector<int> vec;
@@ -73,6 +95,7 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
         
         // now we can create the elemental dofs map
         vector<vector<int>> RowDofIDs;
+        vector<int> ExpandedDofIDs;
         RowDofIDs.resize(m_ActiveDofs);
         for(int e=1;e<=m_BulkElmtsNum;e++){
             for(int j=1;j<=t_fecell.getFECellIthBulkElmtNodesNum(e);j++){
@@ -92,12 +115,30 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
                 MessagePrinter::printErrorTxt("the length of element dof ids is not equal to MaxDofsPerElmt in CreateBulkDofsMap");
                 MessagePrinter::exitAsFem();
             }
+            if(hasHangingNodes()){
+                // the hanging dofs are eliminated, so the element couples to the masters' dofs
+                expandHangingDofIDs(m_ElementalDofIDs_Global[e-1],ExpandedDofIDs);
+                for(const auto &idofid:ExpandedDofIDs){
+                    for(const auto &jdofid:ExpandedDofIDs) RowDofIDs[idofid-1].push_back(jdofid);
+                }
+                continue;
+            }
             for(int i=0;i<static_cast<int>(m_ElementalDofIDs_Global[e-1].size());i++){
                 for(int j=0;j<static_cast<int>(m_ElementalDofIDs_Global[e-1].size());j++){
                     RowDofIDs[m_ElementalDofIDs_Global[e-1][i]-1].push_back(m_ElementalDofIDs_Global[e-1][j]);
                 }
             }
         }
+        // the row of a hanging dof only keeps its constraint u_h-sum(w*u_m)=0
+        for(const auto &id:m_HangingNodeIDs){
+            for(int k=1;k<=m_MaxDofsPerNode;k++){
+                dofid=(id-1)*m_MaxDofsPerNode+k;
+                RowDofIDs[dofid-1].assign(1,dofid);
+                for(int j=1;j<=getIthNodeMastersNum(id);j++){
+                    RowDofIDs[dofid-1].push_back((getIthNodeJthMasterID(id,j)-1)*m_MaxDofsPerNode+k);
+                }
+            }
+        }
         // now we remove duplicate dofs in each row
         m_MaxNNZ=0;m_MaxRowNNZ=-1;
         for(int i=0;i<m_ActiveDofs;i++){
@@ -117,7 +158,7 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
          */
         m_ElementalDofIDs_Local.clear();
         map<int,vector<vector<int>>> Rank2ElementalDofIDsMap;
-        int cpuid,tag;
+        int cpuid;
         Rank2ElementalDofIDsMap.clear();
         for(int e=1;e<=t_fecell.getFECellBulkElmtsNum();e++){
             cpuid=t_fecell.getFECellIthBulkElmtRankID(e);
@@ -129,41 +170,59 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
                 Rank2ElementalDofIDsMap[cpuid].push_back(m_ElementalDofIDs_Global[e-1]);//stores the local element dof id of each local rank
             }
         }
+        SendBufs.resize(size);
         for(cpuid=1;cpuid<size;cpuid++){
             if(static_cast<int>(Rank2ElementalDofIDsMap[cpuid].size())!=t_fecell.getIthRanksBulkElmtsNum(cpuid)){
                 MessagePrinter::printErrorTxt("Rank-"+to_string(cpuid)+" owns different local bulk elmts number from the one given in FECell,"+
                                               "please check your code in CreateBulkDofsMap.cpp");
                 MessagePrinter::exitAsFem();
             }
-            tag=cpuid*1000+0;
-            MPIDataBus::sendIntegerToOthers(m_MaxNNZ,tag,cpuid);
-            tag=cpuid*1000+1;
-            MPIDataBus::sendIntegerToOthers(m_MaxRowNNZ,tag,cpuid);
-            // send out nodal dof id and elemental dof id
-            tag=cpuid*1000+2;
-            MPIDataBus::sendAlignedVectorOfIntegerVectorToOthers(m_NodalDofIDs_Global,tag,cpuid);
-            tag=cpuid*1000+3;
-            MPIDataBus::sendAlignedVectorOfIntegerVectorToOthers(m_ElementalDofIDs_Global,tag,cpuid);
-            tag=cpuid*1000+4;
-            MPIDataBus::sendAlignedVectorOfIntegerVectorToOthers(Rank2ElementalDofIDsMap[cpuid],tag,cpuid);
+            BinaryWriter writer;
+            MPIDataBus::packAlignedVectorOfIntegerVector(writer,Rank2ElementalDofIDsMap[cpuid]);
+            SendBufs[cpuid]=std::move(writer.getDataRef());
+            Rank2ElementalDofIDsMap[cpuid]=vector<vector<int>>(0);// release memory
         }
         Rank2ElementalDofIDsMap.clear();
+
+        // the nnz info, nodal dof id and elemental dof id are shared by all the ranks
+        BinaryWriter writer;
+        writer.writeValue(m_MaxNNZ);
+        writer.writeValue(m_MaxRowNNZ);
+        MPIDataBus::packAlignedVectorOfIntegerVector(writer,m_NodalDofIDs_Global);
+        MPIDataBus::packAlignedVectorOfIntegerVector(writer,m_ElementalDofIDs_Global);
+        SharedBuf=std::move(writer.getDataRef());
     }// end-of-master-rank
+
+    /**
+     * the shared dof maps are broadcast once, then each rank receives its local elemental dof ids,
+     * the broadcast must go first, otherwise the pending sends of master rank may block the broadcast
+     * both transfers are chunked below 2GB, so the size of the dofs maps is not limited by the int count of MPI
+     */
+    MPIDataBus::broadcastBufferFromMaster(SharedBuf);
+    if(rank==0){
+        MPIDataBus::sendBuffersToOthers(SendBufs,1000);
+        SendBufs.clear();
+    }
     else{
-        int tag;
-        tag=rank*1000+0;
-        MPIDataBus::receiveIntegerFromMaster(m_MaxNNZ,tag);
-        tag=rank*1000+1;
-        MPIDataBus::receiveIntegerFromMaster(m_MaxRowNNZ,tag);
-        tag=rank*1000+2;
-        MPIDataBus::receiveAlignedVectorOfIntegerVectorFromMaster(m_NodalDofIDs_Global,tag);
-        tag=rank*1000+3;
-        MPIDataBus::receiveAlignedVectorOfIntegerVectorFromMaster(m_ElementalDofIDs_Global,tag);
-        tag=rank*1000+4;
-        MPIDataBus::receiveAlignedVectorOfIntegerVectorFromMaster(m_ElementalDofIDs_Local,tag);
+        BinaryReader sharedreader(SharedBuf.data(),SharedBuf.size());
+        sharedreader.readValue(m_MaxNNZ);
+        sharedreader.readValue(m_MaxRowNNZ);
+        bool IsValid=sharedreader.isValid();
+        if(IsValid) IsValid=MPIDataBus::unpackAlignedVectorOfIntegerVector(sharedreader,m_NodalDofIDs_Global);
+        if(IsValid) IsValid=MPIDataBus::unpackAlignedVectorOfIntegerVector(sharedreader,m_ElementalDofIDs_Global);
+
+        vector<char> RecvBuf;
+        MPIDataBus::receiveChunkedBufferFromMaster(RecvBuf,1000);
+        BinaryReader reader(RecvBuf.data(),RecvBuf.size());
+        if(IsValid) IsValid=MPIDataBus::unpackAlignedVectorOfIntegerVector(reader,m_ElementalDofIDs_Local);
+        if(!IsValid){
+            MessagePrinter::printErrorTxt("the dofs map received by rank-"+to_string(rank)+" is broken, please check your code in CreateBulkDofsMap.cpp");
+            MessagePrinter::exitAsFem();
+        }
     }
-    MPI_Bcast(&m_ActiveDofs,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Barrier(MPI_COMM_WORLD);
+    SharedBuf.clear();
+    MPI_Bcast(&m_ActiveDofs,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Barrier(PETSC_COMM_WORLD);
 
     // reset the dof id of each local element in the FECell class
     for (int e=1;e<=t_fecell.getLocalFECellBulkElmtsNum();e++) {
@@ -176,4 +235,94 @@ void BulkDofHandler::createBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmt
             t_fecell.getLocalBulkFECellVecRef()[e-1].ElmtDofIDs=m_ElementalDofIDs_Local[e-1];
         }
     }
-}
\ No newline at end of file
+}
+
+void BulkDofHandler::expandHangingDofIDs(const vector<int> &t_DofIDs,vector<int> &t_ExpandedDofIDs)const{
+    t_ExpandedDofIDs.clear();
+    int nodeid,k;
+    for(const auto &dofid:t_DofIDs){
+        if(dofid<1) continue;
+        nodeid=(dofid-1)/m_MaxDofsPerNode+1;
+        if(getIthNodeMastersNum(nodeid)==0){
+            t_ExpandedDofIDs.push_back(dofid);
+            continue;
+        }
+        k=(dofid-1)%m_MaxDofsPerNode+1;
+        for(int j=1;j<=getIthNodeMastersNum(nodeid);j++){
+            t_ExpandedDofIDs.push_back((getIthNodeJthMasterID(nodeid,j)-1)*m_MaxDofsPerNode+k);
+        }
+    }
+    std::sort(t_ExpandedDofIDs.begin(),t_ExpandedDofIDs.end());
+    t_ExpandedDofIDs.erase(std::unique(t_ExpandedDofIDs.begin(),t_ExpandedDofIDs.end()),t_ExpandedDofIDs.end());
+}
+
+void BulkDofHandler::updateLocalBulkDofsMap(FECell &t_fecell){
+    if(m_IsImplicitDofsMap) return;// the implicit grid is never re-partitioned
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    m_ElementalDofIDs_Local.clear();
+    m_ElementalDofIDs_Local.reserve(t_fecell.getLocalFECellBulkElmtsNum());
+    for(int e=1;e<=m_BulkElmtsNum;e++){
+        if(t_fecell.getFECellIthBulkElmtRankID(e)==rank) m_ElementalDofIDs_Local.push_back(m_ElementalDofIDs_Global[e-1]);
+    }
+    if(static_cast<int>(m_ElementalDofIDs_Local.size())!=t_fecell.getLocalFECellBulkElmtsNum()){
+        MessagePrinter::printErrorTxt("the local elements number of dofs map doesn't match the one of FECell after the re-partition, please check your code");
+        MessagePrinter::exitAsFem();
+    }
+    for(int e=1;e<=t_fecell.getLocalFECellBulkElmtsNum();e++){
+        t_fecell.getLocalBulkFECellVecRef()[e-1].ElmtDofIDs=m_ElementalDofIDs_Local[e-1];
+    }
+}
+
+void BulkDofHandler::createImplicitBulkDofsMap(FECell &t_fecell,const ElmtSystem &t_elmtSystem){
+    m_IsImplicitDofsMap=true;
+    m_ImplicitGrid=t_fecell.getImplicitGridRef();
+
+    m_BulkElmtsNum=t_fecell.getFECellBulkElmtsNum();
+    m_NodesNum=t_fecell.getFECellNodesNum();
+    m_TotalDofs=m_NodesNum*m_MaxDofsPerNode;
+    m_MaxDofsPerElmt=m_MaxDofsPerNode*t_fecell.getFECellNodesNumPerBulkElmt();
+    m_NodalDofIDs_Global.clear();
+    m_ElementalDofIDs_Global.clear();
+
+    // the implicit grid only has the 'alldomain' bulk group, so each node carries all the dofs
+    // of the element blocks, which must cover all the dofs (the same check as the one for the explicit mesh)
+    vector<bool> IsDofUsed(m_MaxDofsPerNode,false);
+    for(const auto &block:t_elmtSystem.getBulkElmtBlockList()){
+        for(const auto &dofid:block.m_DofIDs) IsDofUsed[dofid-1]=true;
+    }
+    for(int j=1;j<=m_MaxDofsPerNode;j++){
+        if(!IsDofUsed[j-1]){
+            MessagePrinter::printErrorTxt("dof="+m_DofNameList[j-1]+" isn\'t used by any element block, for the implicit grid, all the dofs must be assigned to the nodes");
+            MessagePrinter::exitAsFem();
+        }
+    }
+    m_ActiveDofs=m_TotalDofs;
+
+    // for a structured grid, one node is connected to at most 3^dim nodes (itself included),
+    // and along each axis n nodes give 3n-2 connected node pairs
+    const FECellData &celldata=t_fecell.getCellDataRef();
+    long long nodepairs=1;
+    int rownodes=1;
+    for(int d=1;d<=t_fecell.getFECellMaxDim();d++){
+        const int n=(d==1?celldata.Nx:(d==2?celldata.Ny:celldata.Nz))+1;
+        nodepairs*=3LL*n-2;
+        rownodes*=3;
+    }
+    m_MaxRowNNZ=rownodes*m_MaxDofsPerNode;
+    m_MaxNNZ=static_cast<int>(std::min(nodepairs*m_MaxDofsPerNode*m_MaxDofsPerNode,
+                                       static_cast<long long>(std::numeric_limits<int>::max())));
+
+    // the local elemental dof ids are computed from the connectivity of the local cells
+    m_ElementalDofIDs_Local.resize(t_fecell.getLocalFECellBulkElmtsNum());
+    for(int e=1;e<=t_fecell.getLocalFECellBulkElmtsNum();e++){
+        SingleMeshCell &cell=t_fecell.getLocalBulkFECellVecRef()[e-1];
+        m_ElementalDofIDs_Local[e-1].resize(m_MaxDofsPerElmt);
+        for(int i=1;i<=cell.NodesNumPerElmt;i++){
+            for(int j=1;j<=m_MaxDofsPerNode;j++){
+                m_ElementalDofIDs_Local[e-1][(i-1)*m_MaxDofsPerNode+j-1]=(cell.ElmtConn[i-1]-1)*m_MaxDofsPerNode+j;
+            }
+        }
+        cell.ElmtDofIDs=m_ElementalDofIDs_Local[e-1];
+    }
+}
@@ -51,12 +51,24 @@ void BulkElmtSystem::init(const FECell &t_fecell){
     m_GlobalBulkElmtsNum=t_fecell.getFECellBulkElmtsNum();
     m_LocalBulkElmtsNum=t_fecell.getLocalFECellBulkElmtsNum();
 
+    if(t_fecell.isImplicitGrid()){
+        // the implicit grid only has the 'alldomain' bulk group, so all the elements share the same block ids
+        vector<int> idvec;
+        for(int i=1;i<=m_ElmtBlockNum;i++){
+            for(const auto &phyname:m_ElmtBlockList[i-1].m_DomainNameList){
+                if(phyname=="alldomain") idvec.push_back(i);
+            }
+        }
+        m_LocalElemental_ElmtBlockID.assign(m_LocalBulkElmtsNum,idvec);
+        return;
+    }
+
     int rank,size;
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     if(rank==0){
         // assign the global elmtblock id vector
-        m_GlobalElemental_ElmtBlockID.resize(m_GlobalBulkElmtsNum,vector<int>(0));
+        m_GlobalElemental_ElmtBlockID.assign(m_GlobalBulkElmtsNum,vector<int>(0));
         // loop over all the element block list
         for(int i=1;i<=m_ElmtBlockNum;i++){
             for(const auto &phyname:m_ElmtBlockList[i-1].m_DomainNameList){
@@ -80,12 +92,13 @@ void BulkElmtSystem::init(const FECell &t_fecell){
     }// end-of-master-rank
     else{
         vector<int> idvec;
+        m_LocalElemental_ElmtBlockID.clear();// init is called again once the elements are re-partitioned
         for(int e=0;e<t_fecell.getLocalFECellBulkElmtsNum();e++){
             MPIDataBus::receiveIntegerVectorFromMaster(idvec,rank*1000+1);
             m_LocalElemental_ElmtBlockID.push_back(idvec);
         }
     }// end-of-other-ranks
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(PETSC_COMM_WORLD);
 }
 
 void BulkElmtSystem::printBulkElmtSystemInfo()const{
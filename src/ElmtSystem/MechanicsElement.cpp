@@ -59,6 +59,16 @@ void MechanicsElement::computeResidual(const LocalElmtInfo &elmtinfo,
         }
     }
 
+    if(elmtinfo.m_IsMeanDilatation){
+        // B-bar: the volumetric strain of the test function uses the element averaged gradient
+        const Rank2Tensor Stress=mate.Rank2Material("stress");
+        double TrStress=0.0;
+        for(int m=1;m<=elmtinfo.m_Dim;m++) TrStress+=Stress(m,m);
+        for(int i=1;i<=elmtinfo.m_Dim;i++){
+            localR(i)+=TrStress*(shp.m_GradTestMean(i)-shp.m_GradTest(i))/elmtinfo.m_Dim;
+        }
+    }
+
 }
 //*****************************************************************************
 void MechanicsElement::computeJacobian(const LocalElmtInfo &elmtinfo,const double (&Ctan)[3],
@@ -98,4 +108,28 @@ void MechanicsElement::computeJacobian(const LocalElmtInfo &elmtinfo,const doubl
         }
     }
 
+    if(elmtinfo.m_IsMeanDilatation){
+        // K=B_bar^T:C:B_bar, here only the volumetric corrections of the test and trial strains are added
+        const Rank4Tensor Jac=mate.Rank4Material("jacobian");
+        const int Dim=elmtinfo.m_Dim;
+        double CII=0.0,CIk,CiI;
+        for(int m=1;m<=Dim;m++){
+            for(int n=1;n<=Dim;n++) CII+=Jac(m,m,n,n);
+        }
+        for(int i=1;i<=Dim;i++){
+            const double DTest=shp.m_GradTestMean(i)-shp.m_GradTest(i);
+            for(int k=1;k<=Dim;k++){
+                const double DTrial=shp.m_GradTrialMean(k)-shp.m_GradTrial(k);
+                CiI=0.0;CIk=0.0;
+                for(int m=1;m<=Dim;m++){
+                    for(int j=1;j<=3;j++){
+                        CiI+=Jac(i,j,m,m)*shp.m_GradTest(j);
+                        CIk+=Jac(m,m,k,j)*shp.m_GradTrial(j);
+                    }
+                }
+                localK(i,k)+=((CiI*DTrial+DTest*CIk)/Dim+DTest*DTrial*CII/(Dim*Dim))*Ctan[0];
+            }
+        }
+    }
+
 }
\ No newline at end of file
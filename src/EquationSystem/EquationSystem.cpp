@@ -32,21 +32,45 @@ void EquationSystem::createSparsityPattern(const DofHandler &t_dofHandler){
     int n;
 
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     eldofs.resize(t_dofHandler.getMaxDofsPerElmt()+1,0);
     elvals.resize(t_dofHandler.getMaxDofsPerElmt()+1,0.0);
 
     n=t_dofHandler.getMaxDofsPerElmt();
+    vector<int> expandeddofs;
     for(int e=1;e<=t_dofHandler.getLocalBulkElmtsNum();e++){
         t_dofHandler.getIthLocalBulkElmtDofIDs(e,eldofs);
+        if(t_dofHandler.hasHangingNodes()){
+            // the hanging dofs are replaced by their masters' dofs, see BulkFESystem::assembleLocalJacobian2GlobalK
+            eldofs.resize(n);
+            t_dofHandler.expandHangingDofIDs(eldofs,expandeddofs);
+            for(const auto &idof:expandeddofs){
+                for(const auto &jdof:expandeddofs) m_AMATRIX.addValue(idof,jdof,0.0);
+            }
+            continue;
+        }
         for(int i=0;i<n;i++){
             for(int j=0;j<n;j++){
                 m_AMATRIX.addValue(eldofs[i],eldofs[j],elvals[i]);
             }
         }
     }
+    if(t_dofHandler.hasHangingNodes()&&rank==0){
+        // the constraint rows of the hanging dofs: u_h-sum(w*u_m)=0
+        int hdof;
+        for(const auto &nodeid:t_dofHandler.getHangingNodeIDsRef()){
+            for(int k=1;k<=t_dofHandler.getMaxDofsPerNode();k++){
+                hdof=t_dofHandler.getIthNodeJthDofID(nodeid,k);
+                m_AMATRIX.addValue(hdof,hdof,0.0);
+                for(int j=1;j<=t_dofHandler.getIthNodeMastersNum(nodeid);j++){
+                    m_AMATRIX.addValue(hdof,t_dofHandler.getIthNodeJthDofID(t_dofHandler.getIthNodeJthMasterID(nodeid,j),k),0.0);
+                }
+            }
+        }
+    }
     m_AMATRIX.assemble();
     m_AMATRIX.disableReallocation();// the following operation can not modify the sparsity pattern anymore!!!
+    m_AMATRIX.keepNonzeroPattern();// the dirichlet rows are zeroed in place, the pattern stays for the next assembly
 
     eldofs.clear();
     elvals.clear();
@@ -18,6 +18,8 @@
 FE::FE(){
     m_MaxDim=0;
     m_MinDim=0;
+    m_MaxBulkQPointsNum=0;
+    m_HasBlockQpoints=false;
 }
 
 void FE::initdefault(const FECell &t_FECell){
@@ -102,7 +104,7 @@ void FE::init(const FECell &t_FECell){
     // this should only be used on user defines shp and qp block in their input file
     // here the different shp and qpoint have already been defined/given in your input file !!!
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
     m_MaxDim=t_FECell.getFECellMaxDim();
     m_MinDim=t_FECell.getFeCellMinDim();
     if(t_FECell.getFECellMaxDim()==1){
@@ -135,6 +137,55 @@ void FE::init(const FECell &t_FECell){
     }
 }
 
+void FE::initBlockQpoints(const vector<ElmtBlock> &t_BlockList,const FECell &t_FECell){
+    m_BlockBulkQpoints.clear();
+    m_MaxBulkQPointsNum=m_BulkQpoints.getQPointsNum();
+    m_HasBlockQpoints=false;
+    for(const auto &block:t_BlockList){
+        m_BlockBulkQpoints.push_back(m_BulkQpoints);
+        if(!block.m_HasOwnQPoints) continue;
+        QPoint &qpoints=m_BlockBulkQpoints.back();
+        qpoints.setQPointType(block.m_QPointType);
+        if(block.m_QPointOrder>=0) qpoints.setOrder(block.m_QPointOrder);
+        qpoints.createQPoints();
+        if(qpoints.getQPointType()!=m_BulkQpoints.getQPointType()||qpoints.getOrder()!=m_BulkQpoints.getOrder()){
+            m_HasBlockQpoints=true;
+        }
+        m_MaxBulkQPointsNum=std::max(m_MaxBulkQPointsNum,qpoints.getQPointsNum());
+    }
+
+    // the sub elements of one element share the same qpoints loop, so the blocks on the same domain must use the same rule
+    const int BlocksNum=static_cast<int>(t_BlockList.size());
+    for(int i=0;i<BlocksNum;i++){
+        for(int j=i+1;j<BlocksNum;j++){
+            bool IsOverlapped=false;
+            for(const auto &namei:t_BlockList[i].m_DomainNameList){
+                for(const auto &namej:t_BlockList[j].m_DomainNameList){
+                    if(namei==namej||namei=="alldomain"||namej=="alldomain") IsOverlapped=true;
+                }
+            }
+            if(IsOverlapped&&
+               (m_BlockBulkQpoints[i].getQPointType()!=m_BlockBulkQpoints[j].getQPointType()||
+                m_BlockBulkQpoints[i].getOrder()!=m_BlockBulkQpoints[j].getOrder())){
+                MessagePrinter::printErrorTxt("element block '"+t_BlockList[i].m_ElmtBlockName+"' and '"+t_BlockList[j].m_ElmtBlockName
+                                              +"' share the same domain, but their qpoints are different, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+        }
+    }
+
+    // the hourglass control is only designed for the single-point quad4/hex8 element
+    for(int i=0;i<BlocksNum;i++){
+        if(t_BlockList[i].m_HourglassCoef<=0.0) continue;
+        if((t_FECell.getFECellBulkElmtMeshType()!=MeshType::QUAD4&&t_FECell.getFECellBulkElmtMeshType()!=MeshType::HEX8)||
+           m_BlockBulkQpoints[i].getQPointsNum()!=1){
+            MessagePrinter::printErrorTxt("the hourglass control of element block '"+t_BlockList[i].m_ElmtBlockName
+                                          +"' requires the quad4/hex8 mesh with a single qpoint, i.e., 'order':1 in its 'qpoints'");
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
+
 void FE::printFEInfo()const{
     if(getMaxDim()==1){
         MessagePrinter::printNormalTxt("Qpoint info for bulk elmts");
@@ -168,6 +219,8 @@ void FE::releaseMemory(){
     m_SurfaceShp.releaseMemory();
 
     m_BulkQpoints.releaseMemory();
+    for(auto &it:m_BlockBulkQpoints) it.releaseMemory();
+    m_BlockBulkQpoints.clear();
     m_LineQpoints.releaseMemory();
     m_SurfaceQpoints.releaseMemory();
 }
\ No newline at end of file
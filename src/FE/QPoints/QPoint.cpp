@@ -27,6 +27,7 @@ QPoint::QPoint(const QPoint &a){
     m_qptype=a.getQPointType();
     m_meshtype=a.getMeshType();
     m_order=a.getOrder();
+    m_ngp=a.getQPointsNum();
     m_dim=a.getDim();
     m_coords=a.m_coords;
 }
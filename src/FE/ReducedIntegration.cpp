@@ -0,0 +1,107 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.21
+//+++ Purpose: the element averaged quantities for the selective
+//+++          reduced integration (mean dilatation) and the
+//+++          hourglass control of the single-point quad4/hex8
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FE/ReducedIntegration.h"
+
+ReducedIntegration::ReducedIntegration(){
+    m_Dim=0;
+    m_NodesNum=0;
+    m_Volume=0.0;
+    m_MeanShapeGrad.clear();
+    m_HourglassModesNum=0;
+    m_Gamma.clear();
+}
+
+void ReducedIntegration::computeMeanShapeGrad(const QPoint &t_Qpoints,ShapeFun &t_Shp,const Nodes &t_Nodes,const int &t_Dim,const int &t_NodesNum){
+    m_Dim=t_Dim;
+    m_NodesNum=t_NodesNum;
+    m_Volume=0.0;
+    m_MeanShapeGrad.resize(m_NodesNum);
+    for(auto &it:m_MeanShapeGrad) it=0.0;
+
+    double xi,eta,zeta,JxW;
+    for(int qp=1;qp<=t_Qpoints.getQPointsNum();qp++){
+        xi=t_Qpoints.getIthPointJthCoord(qp,1);
+        eta=m_Dim>=2?t_Qpoints.getIthPointJthCoord(qp,2):0.0;
+        zeta=m_Dim==3?t_Qpoints.getIthPointJthCoord(qp,3):0.0;
+        t_Shp.calc(xi,eta,zeta,t_Nodes,true);
+        JxW=t_Shp.getJacDet()*t_Qpoints.getIthWeight(qp);
+        m_Volume+=JxW;
+        for(int i=1;i<=m_NodesNum;i++){
+            m_MeanShapeGrad[i-1]+=t_Shp.shape_grad(i)*JxW;
+        }
+    }
+    for(auto &it:m_MeanShapeGrad) it=it*(1.0/m_Volume);
+}
+
+double ReducedIntegration::getMeanDilatation(const double *u)const{
+    double div=0.0;
+    for(int i=1;i<=m_NodesNum;i++){
+        for(int k=1;k<=m_Dim;k++) div+=m_MeanShapeGrad[i-1](k)*u[(i-1)*3+k-1];
+    }
+    return div;
+}
+
+void ReducedIntegration::computeHourglassVectors(const MeshType &t_MeshType,const Nodes &t_Nodes){
+    // the reference coordinates of the vertices, the node ordering follows ShapeFun2DQuad4 and ShapeFun3DHex8
+    const double RefCoords[8][3]={{-1.0,-1.0,-1.0},{ 1.0,-1.0,-1.0},{ 1.0, 1.0,-1.0},{-1.0, 1.0,-1.0},
+                                  {-1.0,-1.0, 1.0},{ 1.0,-1.0, 1.0},{ 1.0, 1.0, 1.0},{-1.0, 1.0, 1.0}};
+    double scale;
+    vector<double> h;
+    if(t_MeshType==MeshType::QUAD4){
+        // h=xi*eta
+        m_HourglassModesNum=1;
+        scale=1.0/4.0;
+        h.resize(4);
+        for(int i=0;i<4;i++) h[i]=RefCoords[i][0]*RefCoords[i][1];
+    }
+    else if(t_MeshType==MeshType::HEX8){
+        // h=xi*eta, eta*zeta, zeta*xi, xi*eta*zeta
+        m_HourglassModesNum=4;
+        scale=1.0/8.0;
+        h.resize(32);
+        for(int i=0;i<8;i++){
+            h[0*8+i]=RefCoords[i][0]*RefCoords[i][1];
+            h[1*8+i]=RefCoords[i][1]*RefCoords[i][2];
+            h[2*8+i]=RefCoords[i][2]*RefCoords[i][0];
+            h[3*8+i]=RefCoords[i][0]*RefCoords[i][1]*RefCoords[i][2];
+        }
+    }
+    else{
+        MessagePrinter::printErrorTxt("the hourglass control only supports the quad4 and hex8 mesh");
+        MessagePrinter::exitAsFem();
+        return;
+    }
+
+    // remove the linear part of h, so the hourglass force is orthogonal to the rigid body and constant strain modes
+    m_Gamma.resize(m_HourglassModesNum*m_NodesNum);
+    double hx;
+    for(int m=0;m<m_HourglassModesNum;m++){
+        for(int j=0;j<m_NodesNum;j++) m_Gamma[m*m_NodesNum+j]=h[m*m_NodesNum+j];
+        for(int k=1;k<=m_Dim;k++){
+            hx=0.0;
+            for(int j=0;j<m_NodesNum;j++) hx+=h[m*m_NodesNum+j]*t_Nodes(j+1,k);
+            for(int j=0;j<m_NodesNum;j++) m_Gamma[m*m_NodesNum+j]-=hx*m_MeanShapeGrad[j](k);
+        }
+        for(int j=0;j<m_NodesNum;j++) m_Gamma[m*m_NodesNum+j]*=scale;
+    }
+}
+
+double ReducedIntegration::getHourglassStiffness(const double &t_Coef,const double &t_Modulus)const{
+    double BB=0.0;
+    for(int i=0;i<m_NodesNum;i++) BB+=m_MeanShapeGrad[i]*m_MeanShapeGrad[i];
+    return t_Coef*t_Modulus*m_Volume*BB;
+}
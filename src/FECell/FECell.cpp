@@ -15,6 +15,7 @@
 #include <fstream>
 #include "FECell/FECell.h"
 #include "FECell/FECellPartioner.h"
+#include "MPIUtils/EnsembleComm.h"
 
 FECell::FECell() {
     m_CellData.MaxDim=1;
@@ -27,6 +28,8 @@ FECell::FECell() {
     m_CellData.Zmin=0.0;
     m_CellData.Zmax=0.0;
     m_CellData.BulkElmtMeshType=MeshType::EDGE2;
+    m_CellData.IsImplicitGrid=false;
+    m_CellData.IsStructuredGrid=false;
     m_CellData.NodeCoords_Global.clear();
     //
     m_CellData.NodesNum=0;
@@ -40,6 +43,9 @@ FECell::FECell() {
     m_CellData.PhyGroupElmtsNumVector_Global.clear();
 
     m_CellData.NodalPhyGroupNum_Global=0;
+
+    m_ElmtReorderType=MeshReorderType::NONE;
+    m_NodeReorderType=MeshReorderType::NONE;
 }
 
 // setup 1d mesh info
@@ -85,8 +91,10 @@ void FECell::setMeshInfo(const int &nx,const int &ny,const int &nz,
 }
 //****************************************************
 void FECell::saveFECell2VTUFile(const string filename)const{
+    // the rank groups of an ensemble share the same file, only the first group writes it
+    if(!EnsembleComm::isMainGroup()) return;
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     if(rank==0){
         std::ofstream out;
         out.open(filename,std::ios::out);
@@ -104,10 +112,10 @@ void FECell::saveFECell2VTUFile(const string filename)const{
         //*****************************
         // print out node coordinates
         out <<std::scientific << std::setprecision(6);
-        for (int i = 0; i < m_CellData.NodesNum; i++){
-            out << m_CellData.NodeCoords_Global[i*3+1-1] << " "
-                << m_CellData.NodeCoords_Global[i*3+2-1] << " "
-                << m_CellData.NodeCoords_Global[i*3+3-1] << "\n";
+        for (int i = 1; i <= m_CellData.NodesNum; i++){
+            out << getFECellIthNodeJthCoord(i,1) << " "
+                << getFECellIthNodeJthCoord(i,2) << " "
+                << getFECellIthNodeJthCoord(i,3) << "\n";
         }
         out << "</DataArray>\n";
         out << "</Points>\n";
@@ -117,9 +125,9 @@ void FECell::saveFECell2VTUFile(const string filename)const{
         //***************************************
         out << "<Cells>\n";
         out << "<DataArray type=\"Int32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\">\n";
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            for(const auto &id:cell.ElmtConn){
-                out<<id-1<<" ";
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            for(int j=1;j<=getFECellIthBulkElmtNodesNum(e);j++){
+                out<<getFECellIthBulkElmtJthNodeID(e,j)-1<<" ";
             }
             out<<"\n";
         }
@@ -130,8 +138,8 @@ void FECell::saveFECell2VTUFile(const string filename)const{
         //***************************************
         out << "<DataArray type=\"Int32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\">\n";
         int offset = 0;
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            offset+=cell.NodesNumPerElmt;
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            offset+=getFECellIthBulkElmtNodesNum(e);
             out << offset << "\n";
         }
         out << "</DataArray>\n";
@@ -140,8 +148,8 @@ void FECell::saveFECell2VTUFile(const string filename)const{
         //*** For vtk cell type
         //***************************************
         out << "<DataArray type=\"Int32\" Name=\"types\"  NumberOfComponents=\"1\"  format=\"ascii\">\n";
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            out<<cell.VTKCellType<<"\n";
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            out<<getFECellIthBulkElmtVTKCellType(e)<<"\n";
         }
         out << "</DataArray>\n";
         out << "</Cells>\n";
@@ -158,8 +166,10 @@ void FECell::saveFECell2VTUFile(const string filename)const{
 }
 //****************************************************
 void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
+    // the rank groups of an ensemble share the same file, only the first group writes it
+    if(!EnsembleComm::isMainGroup()) return;
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     if(rank==0){
         std::ofstream out;
         out.open(filename,std::ios::out);
@@ -177,7 +187,7 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         // for ranks information
         out << "<DataArray type=\"Int32\" Name=\"cpu\" format=\"ascii\">\n";
         for (int e=1;e<=m_CellData.BulkElmtsNum;e++) {
-            out << m_CellData.BulkCellPartionInfo_Global[e-1] << "\n";
+            out << getFECellIthBulkElmtRankID(e) << "\n";
         }
         out<<"</DataArray>\n";
         out << "</CellData>\n";
@@ -189,10 +199,10 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         //*****************************
         // print out node coordinates
         out <<std::scientific << std::setprecision(6);
-        for (int i = 0; i < m_CellData.NodesNum; i++){
-            out << m_CellData.NodeCoords_Global[i*3+1-1] << " "
-                << m_CellData.NodeCoords_Global[i*3+2-1] << " "
-                << m_CellData.NodeCoords_Global[i*3+3-1] << "\n";
+        for (int i = 1; i <= m_CellData.NodesNum; i++){
+            out << getFECellIthNodeJthCoord(i,1) << " "
+                << getFECellIthNodeJthCoord(i,2) << " "
+                << getFECellIthNodeJthCoord(i,3) << "\n";
         }
         out << "</DataArray>\n";
         out << "</Points>\n";
@@ -202,9 +212,9 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         //***************************************
         out << "<Cells>\n";
         out << "<DataArray type=\"Int32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\">\n";
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            for(const auto &id:cell.ElmtConn){
-                out<<id-1<<" ";
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            for(int j=1;j<=getFECellIthBulkElmtNodesNum(e);j++){
+                out<<getFECellIthBulkElmtJthNodeID(e,j)-1<<" ";
             }
             out<<"\n";
         }
@@ -215,8 +225,8 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         //***************************************
         out << "<DataArray type=\"Int32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\">\n";
         int offset = 0;
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            offset+=cell.NodesNumPerElmt;
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            offset+=getFECellIthBulkElmtNodesNum(e);
             out << offset << "\n";
         }
         out << "</DataArray>\n";
@@ -225,8 +235,8 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         //*** For vtk cell type
         //***************************************
         out << "<DataArray type=\"Int32\" Name=\"types\"  NumberOfComponents=\"1\"  format=\"ascii\">\n";
-        for(const auto &cell:m_CellData.MeshCell_Total){
-            out<<cell.VTKCellType<<"\n";
+        for(int e=1;e<=m_CellData.BulkElmtsNum;e++){
+            out<<getFECellIthBulkElmtVTKCellType(e)<<"\n";
         }
         out << "</DataArray>\n";
         out << "</Cells>\n";
@@ -238,7 +248,7 @@ void FECell::saveFECellPartionInfo2VTUFile(const string filename)const {
         //***************************************
         out << "<DataArray type=\"Int32\" Name=\"partition\"  NumberOfComponents=\"1\"  format=\"ascii\">\n";
         for(int e = 1; e <= m_CellData.BulkElmtsNum; e++){
-            out << m_CellData.BulkCellPartionInfo_Global[e-1] << "\n";
+            out << getFECellIthBulkElmtRankID(e) << "\n";
         }
         out << "</DataArray>\n";
         out << "</CellData>\n";
@@ -295,8 +305,8 @@ void FECell::printSummaryInfo()const{
     }
 
     int rank,size;
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
 
     if(size==1){
         snprintf(buff,65,"  FECell is distributed in %5d cpu",size);
@@ -312,54 +322,54 @@ void FECell::printSummaryInfo()const{
         MPI_Request request;
         int datasize;
         datasize=static_cast<int>(m_CellData.MeshCell_Local.size());
-        MPI_Isend(&datasize,1,MPI_INT,0,1,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,0,1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
 
         datasize=static_cast<int>(m_CellData.PhyName2MeshCellVectorMap_Local.size());
-        MPI_Isend(&datasize,1,MPI_INT,0,2,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,0,2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         for(const auto &it:m_CellData.PhyName2MeshCellVectorMap_Local){
             datasize=static_cast<int>(it.first.size());
-            MPI_Isend(&datasize,1,MPI_INT,0,3,MPI_COMM_WORLD,&request);
+            MPI_Isend(&datasize,1,MPI_INT,0,3,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
 
-            MPI_Isend(it.first.c_str(),datasize,MPI_CHAR,0,4,MPI_COMM_WORLD,&request);
+            MPI_Isend(it.first.c_str(),datasize,MPI_CHAR,0,4,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
 
             datasize=static_cast<int>(it.second.size());
-            MPI_Isend(&datasize,1,MPI_INT,0,5,MPI_COMM_WORLD,&request);
+            MPI_Isend(&datasize,1,MPI_INT,0,5,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
         }
         // for nodal physical info
         datasize=0;
         for(const auto &it:m_CellData.NodalPhyName2NodeIDVecMap_Local) datasize+=static_cast<int>(it.second.size());
-        MPI_Isend(&datasize,1,MPI_INT,0,6,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,0,6,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
 
         datasize=static_cast<int>(m_CellData.NodalPhyName2NodeIDVecMap_Local.size());
-        MPI_Isend(&datasize,1,MPI_INT,0,7,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,0,7,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         for(const auto &it:m_CellData.NodalPhyName2NodeIDVecMap_Local){
             datasize=static_cast<int>(it.first.size());
-            MPI_Isend(&datasize,1,MPI_INT,0,8,MPI_COMM_WORLD,&request);
+            MPI_Isend(&datasize,1,MPI_INT,0,8,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
 
-            MPI_Isend(it.first.c_str(),datasize,MPI_CHAR,0,9,MPI_COMM_WORLD,&request);
+            MPI_Isend(it.first.c_str(),datasize,MPI_CHAR,0,9,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
 
             datasize=static_cast<int>(it.second.size());
-            MPI_Isend(&datasize,1,MPI_INT,0,10,MPI_COMM_WORLD,&request);
+            MPI_Isend(&datasize,1,MPI_INT,0,10,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
         }
         datasize=static_cast<int>(m_CellData.NodeIDs_Local.size());
-        MPI_Isend(&datasize,1,MPI_INT,0,11,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,0,11,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
         if (datasize>0) {
-            MPI_Isend(&m_CellData.NodeIDs_Local[0],1,MPI_INT,0,12,MPI_COMM_WORLD,&request);
+            MPI_Isend(&m_CellData.NodeIDs_Local[0],1,MPI_INT,0,12,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
             //
-            MPI_Isend(&m_CellData.NodeIDs_Local[datasize-1],1,MPI_INT,0,13,MPI_COMM_WORLD,&request);
+            MPI_Isend(&m_CellData.NodeIDs_Local[datasize-1],1,MPI_INT,0,13,PETSC_COMM_WORLD,&request);
             MPI_Wait(&request,MPI_STATUS_IGNORE);
         }
     } // end-of-other-ranks
@@ -407,7 +417,7 @@ void FECell::printSummaryInfo()const{
         string phyname;
 
         for(cpuid=1;cpuid<size;cpuid++){
-            MPI_Irecv(&datasize,1,MPI_INT,cpuid,1,MPI_COMM_WORLD,&req);
+            MPI_Irecv(&datasize,1,MPI_INT,cpuid,1,PETSC_COMM_WORLD,&req);
             MPI_Wait(&req,MPI_STATUS_IGNORE);
 
             MessagePrinter::printDashLine();
@@ -419,19 +429,19 @@ void FECell::printSummaryInfo()const{
             txt=string(buff);
             MessagePrinter::printNormalTxt(txt);
 
-            MPI_Irecv(&phynum,1,MPI_INT,cpuid,2,MPI_COMM_WORLD,&req);
+            MPI_Irecv(&phynum,1,MPI_INT,cpuid,2,PETSC_COMM_WORLD,&req);
             MPI_Wait(&req,MPI_STATUS_IGNORE);
 
             for(int i=0;i<phynum;i++){
-                MPI_Irecv(&datasize,1,MPI_INT,cpuid,3,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&datasize,1,MPI_INT,cpuid,3,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
 
                 phyname.clear();
-                MPI_Irecv(buff,datasize,MPI_CHAR,cpuid,4,MPI_COMM_WORLD,&req);
+                MPI_Irecv(buff,datasize,MPI_CHAR,cpuid,4,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
                 for(int j=0;j<datasize;j++) phyname.push_back(buff[j]);
 
-                MPI_Irecv(&datasize,1,MPI_INT,cpuid,5,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&datasize,1,MPI_INT,cpuid,5,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
 
                 snprintf(buff,65,"      elmtset[%20s]====> elmts num=%6d",phyname.c_str(),datasize);
@@ -441,26 +451,26 @@ void FECell::printSummaryInfo()const{
 
             // for nodal phy info
             nodesnum=0;
-            MPI_Irecv(&nodesnum,1,MPI_INT,cpuid,6,MPI_COMM_WORLD,&req);
+            MPI_Irecv(&nodesnum,1,MPI_INT,cpuid,6,PETSC_COMM_WORLD,&req);
             MPI_Wait(&req,MPI_STATUS_IGNORE);
 
             snprintf(buff,65,"    Local nodes num=%6d",nodesnum);
             txt=string(buff);
             MessagePrinter::printNormalTxt(txt);
 
-            MPI_Irecv(&phynum,1,MPI_INT,cpuid,7,MPI_COMM_WORLD,&req);
+            MPI_Irecv(&phynum,1,MPI_INT,cpuid,7,PETSC_COMM_WORLD,&req);
             MPI_Wait(&req,MPI_STATUS_IGNORE);
 
             for(int i=0;i<phynum;i++){
-                MPI_Irecv(&datasize,1,MPI_INT,cpuid,8,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&datasize,1,MPI_INT,cpuid,8,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
 
                 phyname.clear();
-                MPI_Irecv(buff,datasize,MPI_CHAR,cpuid,9,MPI_COMM_WORLD,&req);
+                MPI_Irecv(buff,datasize,MPI_CHAR,cpuid,9,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
                 for(int j=0;j<datasize;j++) phyname.push_back(buff[j]);
 
-                MPI_Irecv(&datasize,1,MPI_INT,cpuid,10,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&datasize,1,MPI_INT,cpuid,10,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
 
                 snprintf(buff,65,"      nodeset[%20s]====> nodes num=%6d",phyname.c_str(),datasize);
@@ -468,14 +478,14 @@ void FECell::printSummaryInfo()const{
                 MessagePrinter::printNormalTxt(txt);
             }
 
-            MPI_Irecv(&datasize,1,MPI_INT,cpuid,11,MPI_COMM_WORLD,&req);
+            MPI_Irecv(&datasize,1,MPI_INT,cpuid,11,PETSC_COMM_WORLD,&req);
             MPI_Wait(&req,MPI_STATUS_IGNORE);
             int min,max;
             min=-1;max=-1;
             if (datasize>0) {
-                MPI_Irecv(&min,1,MPI_INT,cpuid,12,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&min,1,MPI_INT,cpuid,12,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
-                MPI_Irecv(&max,1,MPI_INT,cpuid,13,MPI_COMM_WORLD,&req);
+                MPI_Irecv(&max,1,MPI_INT,cpuid,13,PETSC_COMM_WORLD,&req);
                 MPI_Wait(&req,MPI_STATUS_IGNORE);
             }
             else {
@@ -494,7 +504,7 @@ void FECell::printMeshInfo()const{
     MessagePrinter::printNormalTxt("Summary information of FECell system");
     MessagePrinter::printDashLine();
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     if(rank==0){
         char buff1[6+17],buff2[7];
         string str;
@@ -503,7 +513,7 @@ void FECell::printMeshInfo()const{
             snprintf(buff1,6+17,"%5d-th element:",e);
             str+=buff1;
             for(int i=1;i<=m_CellData.NodesNumPerBulkElmt;i++){
-                snprintf(buff2,7,"%5d ",m_CellData.MeshCell_Total[e-1].ElmtConn[i-1]);
+                snprintf(buff2,7,"%5d ",getFECellIthBulkElmtJthNodeID(e,i));
                 str+=buff2;
             }
             MessagePrinter::printNormalTxt(str);
@@ -517,8 +527,29 @@ void FECell::releaseMemory(){
 
 }
 
+bool FECell::createImplicitGrid(){
+    return m_ImplicitGrid.init(m_CellData);
+}
+
 void FECell::distributeMesh(){
+    if(m_CellData.IsImplicitGrid){
+        if(m_ElmtReorderType!=MeshReorderType::NONE||m_NodeReorderType!=MeshReorderType::NONE){
+            MessagePrinter::printWarningTxt("the implicit structured grid is already ordered, the mesh reordering is skipped");
+        }
+        // each rank creates its own cells, nothing needs to be sent from the master rank
+        m_ImplicitGrid.createLocalFECell(m_CellData);
+        MPI_Barrier(PETSC_COMM_WORLD);
+        return;
+    }
+    if(m_ElmtReorderType!=MeshReorderType::NONE||m_NodeReorderType!=MeshReorderType::NONE){
+        int rank;
+        MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+        // the global mesh only lives on the master rank, the other ranks get the reordered one from the partition
+        if(rank==0) FECellReorder::reorderFECell(m_ElmtReorderType,m_NodeReorderType,m_CellData);
+        MessagePrinter::printNormalTxt("mesh is reordered, elements by "+FECellReorder::getReorderTypeName(m_ElmtReorderType)+
+                                       ", nodes by "+FECellReorder::getReorderTypeName(m_NodeReorderType));
+    }
     FECellPartioner Part;
     Part.partFECell(MeshDistributionMethod,m_CellData);
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(PETSC_COMM_WORLD);
 }
\ No newline at end of file
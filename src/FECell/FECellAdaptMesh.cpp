@@ -0,0 +1,72 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.17
+//+++ Purpose: adapt the global mesh on the master rank and
+//+++          distribute it again
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FECell/FECell.h"
+#include "FECell/FECellPartioner.h"
+
+namespace{
+    template<typename T>
+    void bcastVector(vector<T> &t_Vec,const MPI_Datatype &t_Type){
+        int n=static_cast<int>(t_Vec.size());
+        MPI_Bcast(&n,1,MPI_INT,0,PETSC_COMM_WORLD);
+        t_Vec.resize(n);
+        if(n>0) MPI_Bcast(t_Vec.data(),n,t_Type,0,PETSC_COMM_WORLD);
+    }
+}
+
+bool FECell::adaptMesh(const vector<double> &t_NodalValues,const MeshAdaptMarkerType &t_Marker,
+                       const double &t_Refine,const double &t_Coarsen,const int &t_MaxLevel,
+                       MeshTransferData &t_Transfer){
+    if(m_CellData.IsImplicitGrid) return false;
+
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    int IsChanged=0;
+    if(rank==0){
+        if(!m_Adaptivity.isInitialized()) m_Adaptivity.init(m_CellData);
+        vector<int> Marks;
+        m_Adaptivity.markElmts(m_CellData,t_NodalValues,t_Marker,t_Refine,t_Coarsen,Marks);
+        IsChanged=m_Adaptivity.adaptMesh(Marks,t_MaxLevel,m_CellData,t_Transfer)?1:0;
+    }
+    MPI_Bcast(&IsChanged,1,MPI_INT,0,PETSC_COMM_WORLD);
+    if(!IsChanged) return false;
+
+    /**
+     * the other ranks only need the sizes and the hanging node constraints, the cells come from the partition
+     */
+    MPI_Bcast(&m_CellData.NodesNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&m_CellData.BulkElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&m_CellData.SurfElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&m_CellData.LineElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&m_CellData.ElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+
+    bcastVector(m_CellData.HangingNodeIDs_Global,MPI_INT);
+    bcastVector(m_CellData.HangingNodeMasterPtr_Global,MPI_INT);
+    bcastVector(m_CellData.HangingNodeMasterIDs_Global,MPI_INT);
+    bcastVector(m_CellData.HangingNodeMasterWeights_Global,MPI_DOUBLE);
+
+    MPI_Bcast(&t_Transfer.Dim,1,MPI_INT,0,PETSC_COMM_WORLD);
+    bcastVector(t_Transfer.NodeSrcPtr,MPI_INT);
+    bcastVector(t_Transfer.NodeSrcIDs,MPI_INT);
+    bcastVector(t_Transfer.NodeSrcWeights,MPI_DOUBLE);
+
+    // the adapted mesh is not reordered again, the new elements of one root stay together
+    FECellPartioner Part;
+    Part.partFECell(MeshDistributionMethod,m_CellData);
+    MPI_Barrier(PETSC_COMM_WORLD);
+
+    return true;
+}
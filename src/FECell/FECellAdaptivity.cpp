@@ -0,0 +1,683 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.17
+//+++ Purpose: the quadtree/octree of the adaptive h-refinement
+//+++          and coarsening for quad4 and hex8 mesh
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include "FECell/FECellAdaptivity.h"
+
+namespace{
+    // the position (0 or 1 along each axis) of each corner node, in the same order as the quad4/hex8 connectivity
+    const int CornerBits[8][3]={{0,0,0},{1,0,0},{1,1,0},{0,1,0},
+                                {0,0,1},{1,0,1},{1,1,1},{0,1,1}};
+    // the faces of quad4 (edges) and hex8, ordered so that the outward normal follows the right-hand rule
+    const int QuadFaces[4][2]={{0,1},{1,2},{2,3},{3,0}};
+    const int HexFaces[6][4]={{0,4,7,3},{1,2,6,5},{0,1,5,4},{3,7,6,2},{0,3,2,1},{4,5,6,7}};
+    // the (axis,side) of each face
+    const int QuadFaceAxis[4][2]={{1,0},{0,1},{1,1},{0,0}};
+    const int HexFaceAxis[6][2]={{0,0},{0,1},{1,0},{1,1},{2,0},{2,1}};
+    const int HexEdges[12][2]={{0,1},{1,2},{2,3},{3,0},{4,5},{5,6},{6,7},{7,4},{0,4},{1,5},{2,6},{3,7}};
+
+    /**
+     * add the old nodes which a pool node is interpolated from
+     */
+    void addNodeSources(const int &t_Node,const double &t_Weight,const vector<vector<int>> &t_Parents,
+                        const vector<int> &t_OldIDs,map<int,double> &t_Sources){
+        if(t_OldIDs[t_Node-1]>0){
+            t_Sources[t_OldIDs[t_Node-1]]+=t_Weight;
+            return;
+        }
+        const double w=t_Weight/static_cast<double>(t_Parents[t_Node-1].size());
+        for(const auto &p:t_Parents[t_Node-1]) addNodeSources(p,w,t_Parents,t_OldIDs,t_Sources);
+    }
+}
+
+FECellAdaptivity::FECellAdaptivity(){
+    m_IsInitialized=false;
+    m_Dim=0;
+    m_ChildrenNum=0;
+    m_FacesNum=0;
+    m_RootsNum=0;
+    m_BulkMeshType=MeshType::NULLTYPE;
+    m_FaceMeshType=MeshType::NULLTYPE;
+}
+
+void FECellAdaptivity::init(const FECellData &t_CellData){
+    releaseMemory();
+    if(t_CellData.IsImplicitGrid){
+        MessagePrinter::printErrorTxt("the implicit structured grid can\'t be adapted, please disable it in your mesh block");
+        MessagePrinter::exitAsFem();
+    }
+    if(t_CellData.BulkElmtMeshType==MeshType::QUAD4){
+        m_Dim=2;
+        m_FaceMeshType=MeshType::EDGE2;
+    }
+    else if(t_CellData.BulkElmtMeshType==MeshType::HEX8){
+        m_Dim=3;
+        m_FaceMeshType=MeshType::QUAD4;
+    }
+    else{
+        MessagePrinter::printErrorTxt("the mesh adaptivity only works for quad4 and hex8 mesh, please check your mesh block");
+        MessagePrinter::exitAsFem();
+    }
+    m_BulkMeshType=t_CellData.BulkElmtMeshType;
+    m_ChildrenNum=1<<m_Dim;
+    m_FacesNum=2*m_Dim;
+    m_RootsNum=t_CellData.BulkElmtsNum;
+
+    /**
+     * the original nodes keep their ids, the created nodes are appended to the pool
+     */
+    m_NodeCoords=t_CellData.NodeCoords_Global;
+    m_NodeParents.assign(t_CellData.NodesNum,vector<int>(0));
+    m_NodeUseCount.assign(t_CellData.NodesNum,0);
+    m_NodeExportID.resize(t_CellData.NodesNum,0);
+    for(int i=1;i<=t_CellData.NodesNum;i++) m_NodeExportID[i-1]=i;
+
+    m_Cells.resize(m_RootsNum);
+    m_RootCells.resize(m_RootsNum);
+    for(int e=1;e<=m_RootsNum;e++){
+        const SingleMeshCell &Root=t_CellData.MeshCell_Total[e-1];
+        m_Cells[e-1].RootID=e;
+        m_Cells[e-1].Nodes=Root.ElmtConn;
+        m_Cells[e-1].FacePhyIDs.resize(m_FacesNum);
+        m_Cells[e-1].Volume=Root.Volume;
+        m_Cells[e-1].ExportID=e;
+        for(const auto &id:Root.ElmtConn) m_NodeUseCount[id-1]+=1;
+
+        m_RootCells[e-1].VTKCellType=Root.VTKCellType;
+        m_RootCells[e-1].PhysicalGroupNums=Root.PhysicalGroupNums;
+        m_RootCells[e-1].PhysicalIDList=Root.PhysicalIDList;
+        m_RootCells[e-1].PhysicalNameList=Root.PhysicalNameList;
+    }
+    m_RootBulkPhyIDs.assign(m_RootsNum,vector<int>(0));
+    m_RootBulkPhyNames.assign(m_RootsNum,vector<string>(0));
+    for(const auto &it:t_CellData.PhyID2BulkFECellIDMap_Global){
+        for(const auto &e:it.second) m_RootBulkPhyIDs[e-1].push_back(it.first);
+    }
+    for(const auto &it:t_CellData.PhyName2BulkFECellIDMap_Global){
+        for(const auto &e:it.second) m_RootBulkPhyNames[e-1].push_back(it.first);
+    }
+
+    /**
+     * the boundary cells are attached to the faces of the root cells, so they can be split with the bulk cells,
+     * the lower dimension cells and the ones which don't match any face are kept as they are
+     */
+    map<vector<int>,vector<std::pair<int,int>>> Face2CellMap;
+    vector<int> key;
+    const int FaceNodesNum=(m_Dim==2)?2:4;
+    for(int c=0;c<m_RootsNum;c++){
+        for(int f=0;f<m_FacesNum;f++){
+            key.resize(FaceNodesNum);
+            for(int j=0;j<FaceNodesNum;j++) key[j]=m_Cells[c].Nodes[(m_Dim==2)?QuadFaces[f][j]:HexFaces[f][j]];
+            std::sort(key.begin(),key.end());
+            Face2CellMap[key].push_back(std::make_pair(c,f));
+        }
+    }
+    map<int,int> PhyID2DimMap;
+    for(int i=0;i<t_CellData.PhyGroupNum_Global;i++){
+        PhyID2DimMap[t_CellData.PhyIDVector_Global[i]]=t_CellData.PhyDimVector_Global[i];
+    }
+    for(const auto &it:t_CellData.PhyID2MeshCellVectorMap_Global){
+        if(!PhyID2DimMap.count(it.first)||PhyID2DimMap.at(it.first)>=m_Dim) continue;
+        for(const auto &cell:it.second){
+            if(PhyID2DimMap.at(it.first)==m_Dim-1&&cell.NodesNumPerElmt==FaceNodesNum){
+                key.assign(cell.ElmtConn.begin(),cell.ElmtConn.begin()+FaceNodesNum);
+                std::sort(key.begin(),key.end());
+                auto jt=Face2CellMap.find(key);
+                if(jt!=Face2CellMap.end()){
+                    for(const auto &cf:jt->second){
+                        vector<int> &ids=m_Cells[cf.first].FacePhyIDs[cf.second];
+                        if(std::find(ids.begin(),ids.end(),it.first)==ids.end()) ids.push_back(it.first);
+                    }
+                    continue;
+                }
+            }
+            m_LowerDimCells[it.first].push_back(cell);
+        }
+    }
+    m_NodalSets=t_CellData.NodalPhyName2NodeIDVecMap_Global;
+
+    m_IsInitialized=true;
+}
+
+void FECellAdaptivity::markElmts(const FECellData &t_CellData,const vector<double> &t_NodalValues,
+                                 const MeshAdaptMarkerType &t_Marker,const double &t_Refine,const double &t_Coarsen,
+                                 vector<int> &t_Marks)const{
+    const int ElmtsNum=t_CellData.BulkElmtsNum;
+    vector<double> Eta(ElmtsNum,0.0);
+    double EtaMax=0.0,vmin,vmax;
+    for(int e=0;e<ElmtsNum;e++){
+        const vector<int> &Conn=t_CellData.MeshCell_Total[e].ElmtConn;
+        vmin=t_NodalValues[Conn[0]-1];
+        vmax=vmin;
+        for(const auto &id:Conn){
+            vmin=std::min(vmin,t_NodalValues[id-1]);
+            vmax=std::max(vmax,t_NodalValues[id-1]);
+        }
+        // the jump inside the element is the gradient times the element size
+        Eta[e]=(t_Marker==MeshAdaptMarkerType::GRADIENT)?vmax-vmin:vmax;
+        EtaMax=std::max(EtaMax,Eta[e]);
+    }
+
+    t_Marks.assign(ElmtsNum,0);
+    if(t_Marker==MeshAdaptMarkerType::GRADIENT){
+        if(EtaMax<=0.0) return;
+        for(int e=0;e<ElmtsNum;e++){
+            if(Eta[e]>t_Refine*EtaMax) t_Marks[e]=1;
+            else if(Eta[e]<t_Coarsen*EtaMax) t_Marks[e]=-1;
+        }
+    }
+    else{
+        for(int e=0;e<ElmtsNum;e++){
+            if(Eta[e]>t_Refine) t_Marks[e]=1;
+            else if(Eta[e]<t_Coarsen) t_Marks[e]=-1;
+        }
+    }
+}
+
+int FECellAdaptivity::getLatticeNode(const int &t_Cell,const int (&t_Point)[3]){
+    vector<int> Parents;
+    bool IsInside;
+    for(int j=0;j<m_ChildrenNum;j++){
+        IsInside=true;
+        for(int k=0;k<m_Dim;k++){
+            if(t_Point[k]!=1&&t_Point[k]!=2*CornerBits[j][k]){
+                IsInside=false;
+                break;
+            }
+        }
+        if(IsInside) Parents.push_back(m_Cells[t_Cell].Nodes[j]);
+    }
+    if(Parents.size()==1) return Parents[0];
+
+    std::sort(Parents.begin(),Parents.end());
+    auto it=m_Parents2NodeMap.find(Parents);
+    if(it!=m_Parents2NodeMap.end()) return it->second;
+
+    // the new node is the center of its parents, which is exact for the bilinear/trilinear geometry
+    const int id=static_cast<int>(m_NodeParents.size())+1;
+    double x[3]={0.0,0.0,0.0};
+    for(const auto &p:Parents){
+        for(int k=0;k<3;k++) x[k]+=m_NodeCoords[(p-1)*3+k]/static_cast<double>(Parents.size());
+    }
+    for(int k=0;k<3;k++) m_NodeCoords.push_back(x[k]);
+    m_NodeUseCount.push_back(0);
+    m_NodeExportID.push_back(0);
+    m_Parents2NodeMap[Parents]=id;
+    m_NodeParents.push_back(Parents);
+    return id;
+}
+
+int FECellAdaptivity::findNode(vector<int> t_Parents)const{
+    std::sort(t_Parents.begin(),t_Parents.end());
+    auto it=m_Parents2NodeMap.find(t_Parents);
+    if(it==m_Parents2NodeMap.end()) return 0;
+    return it->second;
+}
+
+bool FECellAdaptivity::isNodeUsed(const vector<int> &t_Parents)const{
+    const int id=findNode(t_Parents);
+    return id>0&&m_NodeUseCount[id-1]>0;
+}
+
+void FECellAdaptivity::refineCell(const int &t_Cell){
+    if(m_Cells[t_Cell].Children.empty()){
+        int Point[3]={0,0,0};
+        vector<int> Children(m_ChildrenNum,0);
+        for(int k=0;k<m_ChildrenNum;k++){
+            AdaptCell Child;
+            Child.Level=m_Cells[t_Cell].Level+1;
+            Child.Parent=t_Cell;
+            Child.RootID=m_Cells[t_Cell].RootID;
+            Child.Offset=k;
+            Child.Volume=m_Cells[t_Cell].Volume/m_ChildrenNum;
+            Child.Nodes.resize(m_ChildrenNum,0);
+            for(int j=0;j<m_ChildrenNum;j++){
+                for(int i=0;i<m_Dim;i++) Point[i]=((k>>i)&1)+CornerBits[j][i];
+                Child.Nodes[j]=getLatticeNode(t_Cell,Point);
+            }
+            // the child inherits the boundary of the parent face it lies on
+            Child.FacePhyIDs.resize(m_FacesNum);
+            for(int f=0;f<m_FacesNum;f++){
+                const int Axis=(m_Dim==2)?QuadFaceAxis[f][0]:HexFaceAxis[f][0];
+                const int Side=(m_Dim==2)?QuadFaceAxis[f][1]:HexFaceAxis[f][1];
+                if(((k>>Axis)&1)==Side) Child.FacePhyIDs[f]=m_Cells[t_Cell].FacePhyIDs[f];
+            }
+            Children[k]=static_cast<int>(m_Cells.size());
+            m_Cells.push_back(Child);
+        }
+        m_Cells[t_Cell].Children=Children;
+    }
+    else{
+        for(const auto &c:m_Cells[t_Cell].Children) m_Cells[c].IsActive=true;
+    }
+    m_Cells[t_Cell].IsActive=false;
+    for(const auto &id:m_Cells[t_Cell].Nodes) m_NodeUseCount[id-1]-=1;
+    for(const auto &c:m_Cells[t_Cell].Children){
+        for(const auto &id:m_Cells[c].Nodes) m_NodeUseCount[id-1]+=1;
+    }
+}
+
+void FECellAdaptivity::coarsenCell(const int &t_Cell){
+    for(const auto &c:m_Cells[t_Cell].Children){
+        m_Cells[c].IsActive=false;
+        for(const auto &id:m_Cells[c].Nodes) m_NodeUseCount[id-1]-=1;
+    }
+    m_Cells[t_Cell].IsActive=true;
+    for(const auto &id:m_Cells[t_Cell].Nodes) m_NodeUseCount[id-1]+=1;
+}
+
+bool FECellAdaptivity::isCellUnbalanced(const int &t_Cell)const{
+    const int EdgesNum=(m_Dim==2)?4:12;
+    int a,b,m;
+    for(int i=0;i<EdgesNum;i++){
+        a=m_Cells[t_Cell].Nodes[(m_Dim==2)?QuadFaces[i][0]:HexEdges[i][0]];
+        b=m_Cells[t_Cell].Nodes[(m_Dim==2)?QuadFaces[i][1]:HexEdges[i][1]];
+        m=findNode({a,b});
+        if(m<1||m_NodeUseCount[m-1]<1) continue;
+        // the half edges are split again by a neighbour, which is two levels finer
+        if(isNodeUsed({a,m})||isNodeUsed({m,b})) return true;
+    }
+    return false;
+}
+
+void FECellAdaptivity::collectActiveCells(const int &t_Cell,vector<int> &t_Cells)const{
+    if(m_Cells[t_Cell].IsActive){
+        t_Cells.push_back(t_Cell);
+        return;
+    }
+    for(const auto &c:m_Cells[t_Cell].Children) collectActiveCells(c,t_Cells);
+}
+
+bool FECellAdaptivity::isNodeInSet(const int &t_Node,vector<int> &t_Set)const{
+    if(t_Set[t_Node-1]!=0) return t_Set[t_Node-1]>0;
+    bool IsInside=!m_NodeParents[t_Node-1].empty();
+    for(const auto &p:m_NodeParents[t_Node-1]){
+        if(!isNodeInSet(p,t_Set)){
+            IsInside=false;
+            break;
+        }
+    }
+    t_Set[t_Node-1]=IsInside?1:-1;
+    return IsInside;
+}
+
+bool FECellAdaptivity::adaptMesh(const vector<int> &t_Marks,const int &t_MaxLevel,FECellData &t_CellData,MeshTransferData &t_Transfer){
+    if(!m_IsInitialized){
+        MessagePrinter::printErrorTxt("the adaptive mesh is not initialized, please call init first");
+        MessagePrinter::exitAsFem();
+    }
+    const int OldCellsNum=static_cast<int>(m_Cells.size());
+    vector<int> OldCellIDs(OldCellsNum,0);
+    for(int c=0;c<OldCellsNum;c++) OldCellIDs[c]=m_Cells[c].IsActive?m_Cells[c].ExportID:0;
+    const vector<int> OldNodeIDs=m_NodeExportID;
+
+    vector<int> OldActive,Active;
+    for(int r=0;r<m_RootsNum;r++) collectActiveCells(r,OldActive);
+
+    /**
+     * coarsen the families whose children are all marked, the family is restored if it breaks the 2:1 balance
+     */
+    vector<int> Candidates;
+    for(const auto &c:OldActive){
+        const int p=m_Cells[c].Parent;
+        if(p<0) continue;
+        bool IsCoarsenable=true;
+        for(const auto &child:m_Cells[p].Children){
+            if(!m_Cells[child].IsActive||t_Marks[m_Cells[child].ExportID-1]!=-1){
+                IsCoarsenable=false;
+                break;
+            }
+        }
+        if(IsCoarsenable) Candidates.push_back(p);
+    }
+    std::sort(Candidates.begin(),Candidates.end());
+    Candidates.erase(std::unique(Candidates.begin(),Candidates.end()),Candidates.end());
+    for(const auto &p:Candidates){
+        coarsenCell(p);
+        if(isCellUnbalanced(p)) refineCell(p);
+    }
+
+    /**
+     * refine the marked cells, then refine the coarse neighbours until the 2:1 balance is recovered
+     */
+    for(const auto &c:OldActive){
+        if(m_Cells[c].IsActive&&t_Marks[OldCellIDs[c]-1]==1&&m_Cells[c].Level<t_MaxLevel) refineCell(c);
+    }
+    bool IsChanged=true;
+    while(IsChanged){
+        IsChanged=false;
+        Active.clear();
+        for(int r=0;r<m_RootsNum;r++) collectActiveCells(r,Active);
+        for(const auto &c:Active){
+            if(m_Cells[c].IsActive&&isCellUnbalanced(c)){
+                refineCell(c);
+                IsChanged=true;
+            }
+        }
+    }
+    Active.clear();
+    for(int r=0;r<m_RootsNum;r++) collectActiveCells(r,Active);
+    if(Active==OldActive) return false;
+
+    exportMesh(t_CellData);
+
+    /**
+     * the new nodes are interpolated from the old ones
+     */
+    t_Transfer.Dim=m_Dim;
+    t_Transfer.NodeSrcPtr.assign(1,0);
+    t_Transfer.NodeSrcIDs.clear();
+    t_Transfer.NodeSrcWeights.clear();
+    vector<int> NewNode2PoolMap(t_CellData.NodesNum,0);
+    for(int i=1;i<=static_cast<int>(m_NodeExportID.size());i++){
+        if(m_NodeExportID[i-1]>0) NewNode2PoolMap[m_NodeExportID[i-1]-1]=i;
+    }
+    vector<int> OldIDs=OldNodeIDs;
+    OldIDs.resize(m_NodeExportID.size(),0);
+    map<int,double> Sources;
+    for(const auto &i:NewNode2PoolMap){
+        Sources.clear();
+        addNodeSources(i,1.0,m_NodeParents,OldIDs,Sources);
+        for(const auto &it:Sources){
+            t_Transfer.NodeSrcIDs.push_back(it.first);
+            t_Transfer.NodeSrcWeights.push_back(it.second);
+        }
+        t_Transfer.NodeSrcPtr.push_back(static_cast<int>(t_Transfer.NodeSrcIDs.size()));
+    }
+
+    /**
+     * the new elements are mapped to the old ones which overlap with them, xi_old=a*xi+b
+     */
+    t_Transfer.ElmtSrcPtr.assign(1,0);
+    t_Transfer.ElmtSrcIDs.clear();
+    t_Transfer.ElmtSrcMaps.clear();
+    double a,b[3];
+    int cur;
+    for(const auto &c:Active){
+        if(c<OldCellsNum&&OldCellIDs[c]>0){
+            t_Transfer.ElmtSrcIDs.push_back(OldCellIDs[c]);
+            t_Transfer.ElmtSrcMaps.insert(t_Transfer.ElmtSrcMaps.end(),{1.0,0.0,0.0,0.0});
+        }
+        else{
+            // a refined cell is inside one of the old cells
+            a=1.0;b[0]=0.0;b[1]=0.0;b[2]=0.0;
+            cur=c;
+            while(m_Cells[cur].Parent>=0){
+                for(int k=0;k<m_Dim;k++) b[k]=0.5*b[k]+(((m_Cells[cur].Offset>>k)&1)-0.5);
+                a*=0.5;
+                cur=m_Cells[cur].Parent;
+                if(cur<OldCellsNum&&OldCellIDs[cur]>0) break;
+            }
+            if(cur<OldCellsNum&&OldCellIDs[cur]>0){
+                t_Transfer.ElmtSrcIDs.push_back(OldCellIDs[cur]);
+                t_Transfer.ElmtSrcMaps.insert(t_Transfer.ElmtSrcMaps.end(),{a,b[0],b[1],b[2]});
+            }
+            else{
+                // a coarsened cell covers its old descendants, the inverse map is used
+                vector<int> Stack=m_Cells[c].Children;
+                while(!Stack.empty()){
+                    const int d=Stack.back();
+                    Stack.pop_back();
+                    if(d>=OldCellsNum) continue;
+                    if(OldCellIDs[d]<1){
+                        Stack.insert(Stack.end(),m_Cells[d].Children.begin(),m_Cells[d].Children.end());
+                        continue;
+                    }
+                    a=1.0;b[0]=0.0;b[1]=0.0;b[2]=0.0;
+                    for(cur=d;cur!=c;cur=m_Cells[cur].Parent){
+                        for(int k=0;k<m_Dim;k++) b[k]=0.5*b[k]+(((m_Cells[cur].Offset>>k)&1)-0.5);
+                        a*=0.5;
+                    }
+                    t_Transfer.ElmtSrcIDs.push_back(OldCellIDs[d]);
+                    t_Transfer.ElmtSrcMaps.insert(t_Transfer.ElmtSrcMaps.end(),{1.0/a,-b[0]/a,-b[1]/a,-b[2]/a});
+                }
+            }
+        }
+        t_Transfer.ElmtSrcPtr.push_back(static_cast<int>(t_Transfer.ElmtSrcIDs.size()));
+    }
+
+    return true;
+}
+
+void FECellAdaptivity::exportMesh(FECellData &t_CellData){
+    vector<int> Active;
+    for(int r=0;r<m_RootsNum;r++) collectActiveCells(r,Active);
+    for(auto &cell:m_Cells) cell.ExportID=0;
+
+    /**
+     * the original nodes keep their ids, the used new nodes are numbered after them
+     */
+    const int PoolNodesNum=static_cast<int>(m_NodeParents.size());
+    int NodesNum=0;
+    for(int i=0;i<PoolNodesNum;i++){
+        if(m_NodeParents[i].empty()) m_NodeExportID[i]=++NodesNum;
+    }
+    for(int i=0;i<PoolNodesNum;i++){
+        if(m_NodeParents[i].empty()) continue;
+        m_NodeExportID[i]=(m_NodeUseCount[i]>0)?++NodesNum:0;
+    }
+    t_CellData.NodesNum=NodesNum;
+    t_CellData.NodeCoords_Global.assign(NodesNum*3,0.0);
+    for(int i=0;i<PoolNodesNum;i++){
+        if(m_NodeExportID[i]<1) continue;
+        for(int k=0;k<3;k++) t_CellData.NodeCoords_Global[(m_NodeExportID[i]-1)*3+k]=m_NodeCoords[i*3+k];
+    }
+    if(t_CellData.NodeOrigIDs_Global.size()){
+        for(int i=static_cast<int>(t_CellData.NodeOrigIDs_Global.size())+1;i<=NodesNum;i++) t_CellData.NodeOrigIDs_Global.push_back(i);
+    }
+    t_CellData.BulkElmtOrigIDs_Global.clear();
+    t_CellData.BulkElmtWeights_Global.clear();
+
+    /**
+     * for the bulk cells
+     */
+    const int ElmtsNum=static_cast<int>(Active.size());
+    t_CellData.MeshCell_Total.assign(ElmtsNum,SingleMeshCell());
+    t_CellData.PhyID2BulkFECellIDMap_Global.clear();
+    t_CellData.PhyName2BulkFECellIDMap_Global.clear();
+    for(int e=1;e<=ElmtsNum;e++){
+        AdaptCell &Cell=m_Cells[Active[e-1]];
+        const SingleMeshCell &Root=m_RootCells[Cell.RootID-1];
+        SingleMeshCell &Elmt=t_CellData.MeshCell_Total[e-1];
+        Cell.ExportID=e;
+
+        Elmt.Dim=m_Dim;
+        Elmt.NodesNumPerElmt=m_ChildrenNum;
+        Elmt.VTKCellType=Root.VTKCellType;
+        Elmt.CellMeshType=m_BulkMeshType;
+        Elmt.PhysicalGroupNums=Root.PhysicalGroupNums;
+        Elmt.PhysicalIDList=Root.PhysicalIDList;
+        Elmt.PhysicalNameList=Root.PhysicalNameList;
+        Elmt.Volume=Cell.Volume;
+        Elmt.ElmtConn.resize(m_ChildrenNum,0);
+        Elmt.ElmtNodeCoords.resize(m_ChildrenNum);
+        for(int j=1;j<=m_ChildrenNum;j++){
+            Elmt.ElmtConn[j-1]=m_NodeExportID[Cell.Nodes[j-1]-1];
+            for(int k=1;k<=3;k++) Elmt.ElmtNodeCoords(j,k)=m_NodeCoords[(Cell.Nodes[j-1]-1)*3+k-1];
+        }
+        Elmt.ElmtNodeCoords0=Elmt.ElmtNodeCoords;
+
+        for(const auto &id:m_RootBulkPhyIDs[Cell.RootID-1]) t_CellData.PhyID2BulkFECellIDMap_Global[id].push_back(e);
+        for(const auto &name:m_RootBulkPhyNames[Cell.RootID-1]) t_CellData.PhyName2BulkFECellIDMap_Global[name].push_back(e);
+    }
+
+    t_CellData.PhyID2MeshCellVectorMap_Global.clear();
+    t_CellData.PhyName2MeshCellVectorMap_Global.clear();
+    for(const auto &it:t_CellData.PhyID2BulkFECellIDMap_Global){
+        vector<SingleMeshCell> &Cells=t_CellData.PhyID2MeshCellVectorMap_Global[it.first];
+        for(const auto &e:it.second) Cells.push_back(t_CellData.MeshCell_Total[e-1]);
+    }
+    for(const auto &it:t_CellData.PhyName2BulkFECellIDMap_Global){
+        vector<SingleMeshCell> &Cells=t_CellData.PhyName2MeshCellVectorMap_Global[it.first];
+        for(const auto &e:it.second) Cells.push_back(t_CellData.MeshCell_Total[e-1]);
+    }
+
+    /**
+     * for the boundary cells on the faces of the active cells, the shared faces are only added once
+     */
+    const int FaceNodesNum=(m_Dim==2)?2:4;
+    std::set<std::pair<int,vector<int>>> AddedFaces;
+    vector<int> key;
+    for(const auto &c:Active){
+        for(int f=0;f<m_FacesNum;f++){
+            if(m_Cells[c].FacePhyIDs[f].empty()) continue;
+            SingleMeshCell Face;
+            Face.Dim=m_Dim-1;
+            Face.NodesNumPerElmt=FaceNodesNum;
+            Face.VTKCellType=(m_Dim==2)?3:9;
+            Face.CellMeshType=m_FaceMeshType;
+            Face.PhysicalGroupNums=1;
+            Face.ElmtConn.resize(FaceNodesNum,0);
+            Face.ElmtNodeCoords.resize(FaceNodesNum);
+            for(int j=1;j<=FaceNodesNum;j++){
+                const int id=m_Cells[c].Nodes[(m_Dim==2)?QuadFaces[f][j-1]:HexFaces[f][j-1]];
+                Face.ElmtConn[j-1]=m_NodeExportID[id-1];
+                for(int k=1;k<=3;k++) Face.ElmtNodeCoords(j,k)=m_NodeCoords[(id-1)*3+k-1];
+            }
+            Face.ElmtNodeCoords0=Face.ElmtNodeCoords;
+            if(m_Dim==2){
+                Face.Volume=std::sqrt(std::pow(Face.ElmtNodeCoords(2,1)-Face.ElmtNodeCoords(1,1),2)
+                                     +std::pow(Face.ElmtNodeCoords(2,2)-Face.ElmtNodeCoords(1,2),2)
+                                     +std::pow(Face.ElmtNodeCoords(2,3)-Face.ElmtNodeCoords(1,3),2));
+            }
+            else{
+                // half of the cross product of the two diagonals
+                double d1[3],d2[3];
+                for(int k=1;k<=3;k++){
+                    d1[k-1]=Face.ElmtNodeCoords(3,k)-Face.ElmtNodeCoords(1,k);
+                    d2[k-1]=Face.ElmtNodeCoords(4,k)-Face.ElmtNodeCoords(2,k);
+                }
+                Face.Volume=0.5*std::sqrt(std::pow(d1[1]*d2[2]-d1[2]*d2[1],2)
+                                         +std::pow(d1[2]*d2[0]-d1[0]*d2[2],2)
+                                         +std::pow(d1[0]*d2[1]-d1[1]*d2[0],2));
+            }
+            key=Face.ElmtConn;
+            std::sort(key.begin(),key.end());
+            for(const auto &phyid:m_Cells[c].FacePhyIDs[f]){
+                if(!AddedFaces.insert(std::make_pair(phyid,key)).second) continue;
+                const string phyname=t_CellData.PhyID2NameMap_Global.count(phyid)?t_CellData.PhyID2NameMap_Global.at(phyid):to_string(phyid);
+                Face.PhysicalIDList.assign(1,phyid);
+                Face.PhysicalNameList.assign(1,phyname);
+                t_CellData.PhyID2MeshCellVectorMap_Global[phyid].push_back(Face);
+                t_CellData.PhyName2MeshCellVectorMap_Global[phyname].push_back(Face);
+            }
+        }
+    }
+    for(const auto &it:m_LowerDimCells){
+        const string phyname=t_CellData.PhyID2NameMap_Global.count(it.first)?t_CellData.PhyID2NameMap_Global.at(it.first):to_string(it.first);
+        for(auto cell:it.second){
+            for(auto &id:cell.ElmtConn) id=m_NodeExportID[id-1];
+            t_CellData.PhyID2MeshCellVectorMap_Global[it.first].push_back(cell);
+            t_CellData.PhyName2MeshCellVectorMap_Global[phyname].push_back(cell);
+        }
+    }
+
+    t_CellData.LineElmtsNum=0;
+    t_CellData.SurfElmtsNum=0;
+    for(int i=0;i<t_CellData.PhyGroupNum_Global;i++){
+        auto it=t_CellData.PhyID2MeshCellVectorMap_Global.find(t_CellData.PhyIDVector_Global[i]);
+        t_CellData.PhyGroupElmtsNumVector_Global[i]=(it==t_CellData.PhyID2MeshCellVectorMap_Global.end())?0:static_cast<int>(it->second.size());
+        if(t_CellData.PhyDimVector_Global[i]==1&&m_Dim>1) t_CellData.LineElmtsNum+=t_CellData.PhyGroupElmtsNumVector_Global[i];
+        if(t_CellData.PhyDimVector_Global[i]==2&&m_Dim>2) t_CellData.SurfElmtsNum+=t_CellData.PhyGroupElmtsNumVector_Global[i];
+    }
+    t_CellData.BulkElmtsNum=ElmtsNum;
+    t_CellData.ElmtsNum=t_CellData.BulkElmtsNum+t_CellData.SurfElmtsNum+t_CellData.LineElmtsNum;
+
+    /**
+     * a new node belongs to the nodal set if all its parents do
+     */
+    for(int i=0;i<t_CellData.NodalPhyGroupNum_Global;i++){
+        const string phyname=t_CellData.NodalPhyNameVector_Global[i];
+        vector<int> Set(PoolNodesNum,0);
+        for(const auto &id:m_NodalSets[phyname]) Set[id-1]=1;
+        vector<int> &NodeIDs=t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname];
+        NodeIDs.clear();
+        for(int j=1;j<=PoolNodesNum;j++){
+            if(m_NodeExportID[j-1]>0&&isNodeInSet(j,Set)) NodeIDs.push_back(m_NodeExportID[j-1]);
+        }
+        t_CellData.NodalPhyGroupNodesNumVector_Global[i]=static_cast<int>(NodeIDs.size());
+    }
+
+    /**
+     * the used middle node of an active edge (or the center of an active hex face) is a hanging node,
+     * it is constrained by the corners, and the masters which hang themselves are expanded
+     */
+    map<int,map<int,double>> HangingNodes;
+    int m;
+    for(const auto &c:Active){
+        const vector<int> &Nodes=m_Cells[c].Nodes;
+        for(int i=0;i<((m_Dim==2)?4:12);i++){
+            const int a=Nodes[(m_Dim==2)?QuadFaces[i][0]:HexEdges[i][0]];
+            const int b=Nodes[(m_Dim==2)?QuadFaces[i][1]:HexEdges[i][1]];
+            m=findNode({a,b});
+            if(m<1||m_NodeUseCount[m-1]<1||HangingNodes.count(m)) continue;
+            HangingNodes[m][a]=0.5;
+            HangingNodes[m][b]=0.5;
+        }
+        if(m_Dim<3) continue;
+        for(int f=0;f<m_FacesNum;f++){
+            m=findNode({Nodes[HexFaces[f][0]],Nodes[HexFaces[f][1]],Nodes[HexFaces[f][2]],Nodes[HexFaces[f][3]]});
+            if(m<1||m_NodeUseCount[m-1]<1||HangingNodes.count(m)) continue;
+            for(int j=0;j<4;j++) HangingNodes[m][Nodes[HexFaces[f][j]]]=0.25;
+        }
+    }
+    bool IsExpanded=false;
+    while(!IsExpanded){
+        IsExpanded=true;
+        for(auto &it:HangingNodes){
+            map<int,double> Masters;
+            for(const auto &jt:it.second){
+                auto kt=HangingNodes.find(jt.first);
+                if(kt==HangingNodes.end()){
+                    Masters[jt.first]+=jt.second;
+                    continue;
+                }
+                IsExpanded=false;
+                for(const auto &lt:kt->second) Masters[lt.first]+=jt.second*lt.second;
+            }
+            it.second=Masters;
+        }
+    }
+    t_CellData.HangingNodeIDs_Global.clear();
+    t_CellData.HangingNodeMasterPtr_Global.assign(1,0);
+    t_CellData.HangingNodeMasterIDs_Global.clear();
+    t_CellData.HangingNodeMasterWeights_Global.clear();
+    for(const auto &it:HangingNodes){
+        t_CellData.HangingNodeIDs_Global.push_back(m_NodeExportID[it.first-1]);
+        for(const auto &jt:it.second){
+            t_CellData.HangingNodeMasterIDs_Global.push_back(m_NodeExportID[jt.first-1]);
+            t_CellData.HangingNodeMasterWeights_Global.push_back(jt.second);
+        }
+        t_CellData.HangingNodeMasterPtr_Global.push_back(static_cast<int>(t_CellData.HangingNodeMasterIDs_Global.size()));
+    }
+}
+
+void FECellAdaptivity::releaseMemory(){
+    m_IsInitialized=false;
+    m_Cells.clear();
+    m_NodeCoords.clear();
+    m_NodeParents.clear();
+    m_NodeUseCount.clear();
+    m_NodeExportID.clear();
+    m_Parents2NodeMap.clear();
+    m_RootCells.clear();
+    m_RootBulkPhyIDs.clear();
+    m_RootBulkPhyNames.clear();
+    m_LowerDimCells.clear();
+    m_NodalSets.clear();
+}
@@ -14,6 +14,31 @@
 
 #include "FECell/FECellDefaultPartitioner.h"
 
+void FECellDefaultPartitioner::splitElmtsByWeights(const vector<double> &t_Weights,const int &t_RanksNum,vector<int> &t_RankOffsets){
+    const int ElmtsNum=static_cast<int>(t_Weights.size());
+    double TotalWeight=0.0;
+    for(const auto &w:t_Weights) TotalWeight+=w;
+
+    t_RankOffsets.assign(t_RanksNum+1,0);
+    t_RankOffsets[t_RanksNum]=ElmtsNum;
+    double Sum=0.0;
+    int e=0;
+    for(int cpuid=1;cpuid<t_RanksNum;cpuid++){
+        // the chunk ends once its accumulated weight reaches the cpuid/size fraction of the total
+        const double Target=TotalWeight*cpuid/t_RanksNum;
+        while(e<ElmtsNum&&Sum+0.5*t_Weights[e]<Target){
+            Sum+=t_Weights[e];
+            e+=1;
+        }
+        // keep at least one element for the previous rank and each of the remaining ranks
+        if(ElmtsNum>=t_RanksNum){
+            while(e<t_RankOffsets[cpuid-1]+1){Sum+=t_Weights[e];e+=1;}
+            while(e>ElmtsNum-(t_RanksNum-cpuid)){e-=1;Sum-=t_Weights[e];}
+        }
+        t_RankOffsets[cpuid]=e;
+    }
+}
+
 
 void FECellDefaultPartitioner::partitionFECell(FECellData &t_CellData){
 
@@ -21,237 +46,40 @@ void FECellDefaultPartitioner::partitionFECell(FECellData &t_CellData){
     MPI_Comm_size(PETSC_COMM_WORLD,&size);
     MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
 
+    vector<vector<SingleMeshCell>> RankCells;
     if(rank==0){
         /**
          * Now we start to distribute the gloabl mesh cell into different ranks
         */
-        int cpuid;
-        int iStart,iEnd,ranksize;
-        vector<SingleMeshCell> LocalCellVector;
-        vector<int> nodeids;
-        int phyid,dim,phynum,datasize;
-        string phyname;
-
-        t_CellData.PhyID2MeshCellVectorMap_Local.clear();
-        t_CellData.PhyName2MeshCellVectorMap_Local.clear();
-
-        t_CellData.BulkCellPartionInfo_Global.resize(t_CellData.BulkElmtsNum,0);
-        t_CellData.RanksElmtsNum_Global.resize(size,0);
-        t_CellData.NodeIDs_Local.clear();
-
-        for(cpuid=1;cpuid<size;cpuid++){
-            /**
-             * send out the physical group info to other ranks
-             */
-            MPIDataBus::sendIntegerToOthers(t_CellData.PhyGroupNum_Global,1000*cpuid+0,cpuid);
-            for(phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
-                phyid=t_CellData.PhyIDVector_Global[phynum];
-                phyname=t_CellData.PhyNameVector_Global[phynum];
-                datasize=t_CellData.PhyGroupElmtsNumVector_Global[phynum];
-                dim=t_CellData.PhyDimVector_Global[phynum];
-                MPIDataBus::sendIntegerToOthers(phyid,1000*cpuid+10,cpuid);
-                MPIDataBus::sendIntegerToOthers(dim,1000*cpuid+20,cpuid);
-                MPIDataBus::sendIntegerToOthers(datasize,1000*cpuid+30,cpuid);
-                MPIDataBus::sendStringToOthers(phyname,1000*cpuid+40,cpuid);
-            }
-        }
-
-        for(cpuid=0;cpuid<size;cpuid++){
-            /**
-             * for elemental physical cell set
-             */
-            for(phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
-                phyid=t_CellData.PhyIDVector_Global[phynum];
-                phyname=t_CellData.PhyNameVector_Global[phynum];
-
-                datasize=static_cast<int>(t_CellData.PhyID2MeshCellVectorMap_Global[phyid].size());
-                ranksize=datasize/size;
-                iStart=cpuid*ranksize;
-                iEnd=(cpuid+1)*ranksize;
-                if(cpuid==size-1) iEnd=datasize;
-
-
-                LocalCellVector.clear();
-                for(int e=iStart;e<iEnd;e++){
-                    LocalCellVector.push_back(t_CellData.PhyID2MeshCellVectorMap_Global[phyid][e]);
-                }
-
-                if(cpuid==0){
-                    t_CellData.PhyID2MeshCellVectorMap_Local[phyid]=LocalCellVector;
-                    t_CellData.PhyName2MeshCellVectorMap_Local[phyname]=LocalCellVector;
-                }
-                else{
-                    MPIDataBus::sendPhyID2MeshCellMapToOthers(phyid,LocalCellVector,1000*cpuid+60,cpuid);
-                    MPIDataBus::sendPhyName2MeshCellMapToOthers(phyname,LocalCellVector,1000*cpuid+80,cpuid);
-                }
-            }// end-of-physical-group-loop
-            /**
-             * for all domain bulk cell
-             */
-            datasize=t_CellData.BulkElmtsNum;
-            ranksize=datasize/size;
-            iStart=cpuid*ranksize;
-            iEnd=(cpuid+1)*ranksize;
-            if(cpuid==size-1) iEnd=datasize;
-
-            LocalCellVector.clear();
-            for(int e=iStart;e<iEnd;e++){
-                LocalCellVector.push_back(t_CellData.MeshCell_Total[e]);
-                t_CellData.BulkCellPartionInfo_Global[e]=cpuid;
-                t_CellData.RanksElmtsNum_Global[cpuid]+=1;
-            }
-
-            if(cpuid==0){
-                t_CellData.MeshCell_Local=LocalCellVector;
-            }
-            else{
-                MPIDataBus::sendMeshCellToOthers(LocalCellVector,1000*cpuid+100,cpuid);
-            }
-
-            /**
-             * for nodal physical group sets
-             */
-            if(cpuid!=0) MPIDataBus::sendIntegerToOthers(t_CellData.NodalPhyGroupNum_Global,1000*cpuid+200,cpuid);
-            for(phynum=0;phynum<t_CellData.NodalPhyGroupNum_Global;phynum++){
-                phyid=t_CellData.NodalPhyIDVector_Global[phynum];
-                datasize=t_CellData.NodalPhyGroupNodesNumVector_Global[phynum];
-                phyname=t_CellData.NodalPhyNameVector_Global[phynum];
-
-                if(cpuid!=0) MPIDataBus::sendIntegerToOthers(phyid,1000*cpuid+210,cpuid);
-                if(cpuid!=0) MPIDataBus::sendIntegerToOthers(datasize,1000*cpuid+220,cpuid);
-                if(cpuid!=0) MPIDataBus::sendStringToOthers(phyname,1000*cpuid+230,cpuid);
-
-                ranksize=static_cast<int>(t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname].size())/size;
-                iStart=cpuid*ranksize;
-                iEnd=(cpuid+1)*ranksize;
-                if(cpuid==size-1) iEnd=static_cast<int>(t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname].size());
-
-                nodeids.clear();
-                for(int e=iStart;e<iEnd;e++){
-                    nodeids.push_back(t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname][e]);
-                }
-                if(cpuid==0){
-                    t_CellData.NodalPhyName2NodeIDVecMap_Local[phyname]=nodeids;
-                }
-                else{
-                    MPIDataBus::sendPhyName2NodeIDVecMapToOthers(phyname,nodeids,1000*cpuid+240,cpuid);
-                }
-            }
-        }// end-of-cpuid-loop
+        t_CellData.BulkCellPartionInfo_Global.assign(t_CellData.BulkElmtsNum,0);
+        t_CellData.RanksElmtsNum_Global.assign(size,0);
 
         /**
-         * Now we send the BulkCellPartionInfo_Global and RanksElmtsNum_Global to other ranks,
-         * these two vectors are shared among ranks
+         * the bulk elements are split by count, or by their cost weights if they are given
          */
-        for(cpuid=1;cpuid<size;cpuid++){
-            MPIDataBus::sentIntegerVectorToOthers(t_CellData.BulkCellPartionInfo_Global,1000*cpuid+260,cpuid);
-            MPIDataBus::sentIntegerVectorToOthers(t_CellData.RanksElmtsNum_Global,1000*cpuid+280,cpuid);
+        vector<int> RankOffsets;
+        if(static_cast<int>(t_CellData.BulkElmtWeights_Global.size())==t_CellData.BulkElmtsNum){
+            splitElmtsByWeights(t_CellData.BulkElmtWeights_Global,size,RankOffsets);
         }
-        /**
-         * distribute and send the node ids
-         */
-        vector<int> NodeIDs;
-        for(cpuid=0;cpuid<size;cpuid++) {
-            datasize=t_CellData.NodesNum;
-            ranksize=datasize/size;
-            iStart=cpuid*ranksize;
-            iEnd=(cpuid+1)*ranksize;
-            if(cpuid==size-1) iEnd=datasize;
-            NodeIDs.clear();
-            for (int i=iStart;i<iEnd;i++) {
-                NodeIDs.push_back(i+1);
-            }
-            if (cpuid==0) {
-                t_CellData.NodeIDs_Local=NodeIDs;
-            }
-            else {
-                MPIDataBus::sentIntegerVectorToOthers(NodeIDs,1000*cpuid+300,cpuid);
-            }
-        }
-    }// end of rank-0
-    else{
-        /**
-         * receive mesh cell from master rank
-         */
-        vector<int> nodeids;
-        int phyid,dim,phynum,datasize;
-        string phyname;
-
-        t_CellData.PhyID2MeshCellVectorMap_Local.clear();
-        t_CellData.PhyName2MeshCellVectorMap_Local.clear();
-
-        MPIDataBus::receiveIntegerFromMaster(t_CellData.PhyGroupNum_Global,1000*rank+0);
-
-        t_CellData.PhyIDVector_Global.clear();
-        t_CellData.PhyDimVector_Global.clear();
-        t_CellData.PhyGroupElmtsNumVector_Global.clear();
-        t_CellData.PhyNameVector_Global.clear();
-        t_CellData.PhyID2NameMap_Global.clear();
-        t_CellData.PhyName2IDMap_Global.clear();
-        for(phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
-            MPIDataBus::receiveIntegerFromMaster(phyid,1000*rank+10);
-            MPIDataBus::receiveIntegerFromMaster(dim,1000*rank+20);
-            MPIDataBus::receiveIntegerFromMaster(datasize,1000*rank+30);
-            MPIDataBus::receiveStringFromMaster(phyname,1000*rank+40);
-
-            t_CellData.PhyIDVector_Global.push_back(phyid);
-            t_CellData.PhyDimVector_Global.push_back(dim);
-            t_CellData.PhyGroupElmtsNumVector_Global.push_back(datasize);
-            t_CellData.PhyNameVector_Global.push_back(phyname);
-
-            t_CellData.PhyID2NameMap_Global[phyid]=phyname;
-            t_CellData.PhyName2IDMap_Global[phyname]=phyid;
-
-            MPIDataBus::receivePhyID2MeshCellMapFromMaster(t_CellData.PhyID2MeshCellVectorMap_Local,1000*rank+60);
-            MPIDataBus::receivePhyName2MeshCellMapFromMaster(t_CellData.PhyName2MeshCellVectorMap_Local,1000*rank+80);
+        else{
+            RankOffsets.resize(size+1,0);
+            for(int cpuid=0;cpuid<size;cpuid++) RankOffsets[cpuid]=cpuid*(t_CellData.BulkElmtsNum/size);
+            RankOffsets[size]=t_CellData.BulkElmtsNum;
         }
-        /**
-         * for all domain
-         */
-        MPIDataBus::receiveMeshCellFromMaster(t_CellData.MeshCell_Local,1000*rank+100);
 
-        t_CellData.NodeIDs_Local.clear();
-        for (const auto &cell:t_CellData.MeshCell_Local) {
-            for (const auto &id:cell.ElmtConn) {
-                t_CellData.NodeIDs_Local.push_back(id);
+        RankCells.resize(size);
+        for(int cpuid=0;cpuid<size;cpuid++){
+            RankCells[cpuid].reserve(RankOffsets[cpuid+1]-RankOffsets[cpuid]);
+            for(int e=RankOffsets[cpuid];e<RankOffsets[cpuid+1];e++){
+                RankCells[cpuid].push_back(t_CellData.MeshCell_Total[e]);
+                t_CellData.BulkCellPartionInfo_Global[e]=cpuid;
+                t_CellData.RanksElmtsNum_Global[cpuid]+=1;
             }
         }
-        // remove the duplicate ids
-        sort(t_CellData.NodeIDs_Local.begin(),t_CellData.NodeIDs_Local.end());
-        t_CellData.NodeIDs_Local.erase(unique(t_CellData.NodeIDs_Local.begin(),t_CellData.NodeIDs_Local.end()),t_CellData.NodeIDs_Local.end());
-
-        /**
-         * for nodal physical group set
-         */
-        MPIDataBus::receiveIntegerFromMaster(t_CellData.NodalPhyGroupNum_Global,1000*rank+200);
-        t_CellData.NodalPhyGroupNodesNumVector_Global.clear();
-        t_CellData.NodalPhyIDVector_Global.clear();
-        t_CellData.NodalPhyNameVector_Global.clear();
-        t_CellData.NodalPhyID2NameMap_Global.clear();
-        t_CellData.NodalPhyName2IDMap_Global.clear();
-        t_CellData.NodalPhyName2NodeIDVecMap_Local.clear();
-        for(phynum=0;phynum<t_CellData.NodalPhyGroupNum_Global;phynum++){
-            MPIDataBus::receiveIntegerFromMaster(phyid,1000*rank+210);
-            MPIDataBus::receiveIntegerFromMaster(datasize,1000*rank+220);
-            MPIDataBus::receiveStringFromMaster(phyname,1000*rank+230);
-            MPIDataBus::receivePhyName2NodeIDVecMapFromMaster(t_CellData.NodalPhyName2NodeIDVecMap_Local,1000*rank+240);
-
-            t_CellData.NodalPhyIDVector_Global.push_back(phyid);
-            t_CellData.NodalPhyGroupNodesNumVector_Global.push_back(datasize);
-            t_CellData.NodalPhyNameVector_Global.push_back(phyname);
-
-            t_CellData.NodalPhyID2NameMap_Global[phyid]=phyname;
-            t_CellData.NodalPhyName2IDMap_Global[phyname]=phyid;
-        }
+    }// end of rank-0
 
-        /**
-         * Receive bulk element's partition info and ranks elemts number info from master rank
-         */
-        MPIDataBus::receiveIntegerVectorFromMaster(t_CellData.BulkCellPartionInfo_Global,1000*rank+260);
-        MPIDataBus::receiveIntegerVectorFromMaster(t_CellData.RanksElmtsNum_Global,1000*rank+280);
-        /**
-         * for the local node ids
-         */
-        MPIDataBus::receiveIntegerVectorFromMaster(t_CellData.NodeIDs_Local,1000*rank+300);
-    }// end-of-other-ranks
-}
\ No newline at end of file
+    /**
+     * send the local cells, physical groups and partition info to each rank
+     */
+    distributeFECell(t_CellData,RankCells);
+}
@@ -19,6 +19,7 @@ FECellGenerator::FECellGenerator(){
 }
 //********************************************
 bool FECellGenerator::createFEMeshCell(const MeshType &meshtype,FECellData &meshdata){
+    meshdata.IsStructuredGrid=true;
     switch (meshtype)
     {
     case MeshType::EDGE2:
@@ -0,0 +1,233 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author  : Yang Bai
+//+++ Date    : 2025.03.22
+//+++ Function: distribute the partitioned fe cell among ranks,
+//+++           one packed buffer for each rank
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <climits>
+
+#include "FECell/FECellPartitionerBase.h"
+
+void FECellPartitionerBase::distributeFECell(FECellData &t_CellData,vector<vector<SingleMeshCell>> &t_RankCells){
+    int size,rank;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    int iStart,iEnd,ranksize,datasize;
+    int phyid;
+    string phyname;
+
+    /**
+     * the physical group info and the partition info are shared among ranks, so they are broadcast once
+     */
+    vector<char> SharedBuf;
+    if(rank==0){
+        BinaryWriter writer;
+        writer.writeValue(t_CellData.PhyGroupNum_Global);
+        writer.writeVector(t_CellData.PhyIDVector_Global);
+        writer.writeVector(t_CellData.PhyDimVector_Global);
+        writer.writeVector(t_CellData.PhyGroupElmtsNumVector_Global);
+        writer.writeStringVector(t_CellData.PhyNameVector_Global);
+
+        writer.writeValue(t_CellData.NodalPhyGroupNum_Global);
+        writer.writeVector(t_CellData.NodalPhyIDVector_Global);
+        writer.writeVector(t_CellData.NodalPhyGroupNodesNumVector_Global);
+        writer.writeStringVector(t_CellData.NodalPhyNameVector_Global);
+
+        writer.writeVector(t_CellData.BulkCellPartionInfo_Global);
+        writer.writeVector(t_CellData.RanksElmtsNum_Global);
+        SharedBuf=std::move(writer.getDataRef());
+    }
+    MPIDataBus::broadcastBufferFromMaster(SharedBuf);
+    if(rank!=0){
+        BinaryReader reader(SharedBuf.data(),SharedBuf.size());
+        reader.readValue(t_CellData.PhyGroupNum_Global);
+        reader.readVector(t_CellData.PhyIDVector_Global);
+        reader.readVector(t_CellData.PhyDimVector_Global);
+        reader.readVector(t_CellData.PhyGroupElmtsNumVector_Global);
+        reader.readStringVector(t_CellData.PhyNameVector_Global);
+
+        reader.readValue(t_CellData.NodalPhyGroupNum_Global);
+        reader.readVector(t_CellData.NodalPhyIDVector_Global);
+        reader.readVector(t_CellData.NodalPhyGroupNodesNumVector_Global);
+        reader.readStringVector(t_CellData.NodalPhyNameVector_Global);
+
+        reader.readVector(t_CellData.BulkCellPartionInfo_Global);
+        reader.readVector(t_CellData.RanksElmtsNum_Global);
+        if(!reader.isValid()){
+            MessagePrinter::printErrorTxt("the physical group info received from master rank is broken, please check your code");
+            MessagePrinter::exitAsFem();
+        }
+
+        t_CellData.PhyID2NameMap_Global.clear();
+        t_CellData.PhyName2IDMap_Global.clear();
+        for(int phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
+            t_CellData.PhyID2NameMap_Global[t_CellData.PhyIDVector_Global[phynum]]=t_CellData.PhyNameVector_Global[phynum];
+            t_CellData.PhyName2IDMap_Global[t_CellData.PhyNameVector_Global[phynum]]=t_CellData.PhyIDVector_Global[phynum];
+        }
+        t_CellData.NodalPhyID2NameMap_Global.clear();
+        t_CellData.NodalPhyName2IDMap_Global.clear();
+        for(int phynum=0;phynum<t_CellData.NodalPhyGroupNum_Global;phynum++){
+            t_CellData.NodalPhyID2NameMap_Global[t_CellData.NodalPhyIDVector_Global[phynum]]=t_CellData.NodalPhyNameVector_Global[phynum];
+            t_CellData.NodalPhyName2IDMap_Global[t_CellData.NodalPhyNameVector_Global[phynum]]=t_CellData.NodalPhyIDVector_Global[phynum];
+        }
+    }
+
+    /**
+     * the local cells, the nodal physical groups and the node ids of each rank are packed into one buffer
+     */
+    t_CellData.PhyID2MeshCellVectorMap_Local.clear();
+    t_CellData.PhyName2MeshCellVectorMap_Local.clear();
+    t_CellData.NodalPhyName2NodeIDVecMap_Local.clear();
+
+    /**
+     * the buffers are scattered in one collective call as long as they fit in its int displacements, otherwise
+     * the master rank switches to the point-to-point transfer, then each buffer is sent once it is packed and
+     * released right after, the switch is broadcast before any rank enters the scatter
+     */
+    const int FECellTag=9000;
+    const size_t MaxScatterSize=static_cast<size_t>(INT_MAX);
+    int IsStreamed=0;
+    size_t ScatterSize=0;
+    vector<vector<char>> SendBufs;
+    vector<char> RecvBuf;
+    if(rank==0){
+        vector<SingleMeshCell> LocalCellVector;
+        vector<int> NodeIDs;
+        // the same map is rebuilt on other ranks from the broadcast physical group info
+        map<string,int> PhyName2IDMap;
+        for(int phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
+            PhyName2IDMap[t_CellData.PhyNameVector_Global[phynum]]=t_CellData.PhyIDVector_Global[phynum];
+        }
+        SendBufs.resize(size);
+        for(int cpuid=0;cpuid<size;cpuid++){
+            BinaryWriter writer;
+            /**
+             * for elemental physical cell set
+             */
+            for(int phynum=0;phynum<t_CellData.PhyGroupNum_Global;phynum++){
+                phyid=t_CellData.PhyIDVector_Global[phynum];
+                phyname=t_CellData.PhyNameVector_Global[phynum];
+
+                datasize=static_cast<int>(t_CellData.PhyID2MeshCellVectorMap_Global[phyid].size());
+                ranksize=datasize/size;
+                iStart=cpuid*ranksize;
+                iEnd=(cpuid+1)*ranksize;
+                if(cpuid==size-1) iEnd=datasize;
+
+                LocalCellVector.assign(t_CellData.PhyID2MeshCellVectorMap_Global[phyid].begin()+iStart,
+                                       t_CellData.PhyID2MeshCellVectorMap_Global[phyid].begin()+iEnd);
+                if(cpuid==0){
+                    t_CellData.PhyID2MeshCellVectorMap_Local[phyid]=LocalCellVector;
+                    t_CellData.PhyName2MeshCellVectorMap_Local[phyname]=LocalCellVector;
+                }
+                else{
+                    // the id map and the name map share the same cells, so they are sent only once
+                    MPIDataBus::packMeshCellVector(writer,LocalCellVector,PhyName2IDMap);
+                }
+            }
+            /**
+             * for all domain bulk cell
+             */
+            if(cpuid==0){
+                t_CellData.MeshCell_Local=std::move(t_RankCells[0]);
+            }
+            else{
+                MPIDataBus::packMeshCellVector(writer,t_RankCells[cpuid],PhyName2IDMap);
+                t_RankCells[cpuid]=vector<SingleMeshCell>(0);// release memory
+            }
+            /**
+             * for nodal physical group sets
+             */
+            for(int phynum=0;phynum<t_CellData.NodalPhyGroupNum_Global;phynum++){
+                phyname=t_CellData.NodalPhyNameVector_Global[phynum];
+                datasize=static_cast<int>(t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname].size());
+                ranksize=datasize/size;
+                iStart=cpuid*ranksize;
+                iEnd=(cpuid+1)*ranksize;
+                if(cpuid==size-1) iEnd=datasize;
+
+                NodeIDs.assign(t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname].begin()+iStart,
+                               t_CellData.NodalPhyName2NodeIDVecMap_Global[phyname].begin()+iEnd);
+                if(cpuid==0){
+                    t_CellData.NodalPhyName2NodeIDVecMap_Local[phyname]=NodeIDs;
+                }
+                else{
+                    writer.writeVector(NodeIDs);
+                }
+            }
+            /**
+             * for the node ids
+             */
+            datasize=t_CellData.NodesNum;
+            ranksize=datasize/size;
+            iStart=cpuid*ranksize;
+            iEnd=(cpuid+1)*ranksize;
+            if(cpuid==size-1) iEnd=datasize;
+            NodeIDs.clear();
+            for(int i=iStart;i<iEnd;i++) NodeIDs.push_back(i+1);
+            if(cpuid==0){
+                t_CellData.NodeIDs_Local=NodeIDs;
+            }
+            else{
+                writer.writeVector(NodeIDs);
+                SendBufs[cpuid]=std::move(writer.getDataRef());
+                if(!IsStreamed){
+                    ScatterSize+=SendBufs[cpuid].size();
+                    if(ScatterSize>MaxScatterSize){
+                        IsStreamed=1;
+                        MPI_Bcast(&IsStreamed,1,MPI_INT,0,PETSC_COMM_WORLD);
+                        for(int i=1;i<cpuid;i++){
+                            MPIDataBus::sendChunkedBufferToOther(SendBufs[i],i,FECellTag);
+                            vector<char>().swap(SendBufs[i]);// release memory
+                        }
+                    }
+                }
+                if(IsStreamed){
+                    MPIDataBus::sendChunkedBufferToOther(SendBufs[cpuid],cpuid,FECellTag);
+                    vector<char>().swap(SendBufs[cpuid]);// release memory
+                }
+            }
+        }// end-of-cpuid-loop
+        if(!IsStreamed) MPI_Bcast(&IsStreamed,1,MPI_INT,0,PETSC_COMM_WORLD);
+    }
+    else{
+        MPI_Bcast(&IsStreamed,1,MPI_INT,0,PETSC_COMM_WORLD);
+    }
+    if(IsStreamed){
+        if(rank!=0) MPIDataBus::receiveChunkedBufferFromMaster(RecvBuf,FECellTag);
+    }
+    else{
+        MPIDataBus::scatterBuffersFromMaster(SendBufs,RecvBuf);
+    }
+    SendBufs.clear();
+
+    if(rank!=0){
+        BinaryReader reader(RecvBuf.data(),RecvBuf.size());
+        bool IsValid=true;
+        vector<SingleMeshCell> LocalCellVector;
+        for(int phynum=0;phynum<t_CellData.PhyGroupNum_Global&&IsValid;phynum++){
+            IsValid=MPIDataBus::unpackMeshCellVector(reader,LocalCellVector,t_CellData.PhyID2NameMap_Global);
+            t_CellData.PhyID2MeshCellVectorMap_Local[t_CellData.PhyIDVector_Global[phynum]]=LocalCellVector;
+            t_CellData.PhyName2MeshCellVectorMap_Local[t_CellData.PhyNameVector_Global[phynum]]=std::move(LocalCellVector);
+        }
+        if(IsValid) IsValid=MPIDataBus::unpackMeshCellVector(reader,t_CellData.MeshCell_Local,t_CellData.PhyID2NameMap_Global);
+        for(int phynum=0;phynum<t_CellData.NodalPhyGroupNum_Global&&IsValid;phynum++){
+            IsValid=reader.readVector(t_CellData.NodalPhyName2NodeIDVecMap_Local[t_CellData.NodalPhyNameVector_Global[phynum]]);
+        }
+        if(IsValid) IsValid=reader.readVector(t_CellData.NodeIDs_Local);
+        if(!IsValid){
+            MessagePrinter::printErrorTxt("the fe cell received by rank-"+to_string(rank)+" is broken, please check your code");
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
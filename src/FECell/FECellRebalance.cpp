@@ -0,0 +1,125 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.14
+//+++ Purpose: re-partition the bulk elements by their measured
+//+++          cost and migrate the mesh cells among ranks
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FECell/FECell.h"
+#include "FECell/FECellDefaultPartitioner.h"
+#include "MPIUtils/MPIDataBus.h"
+
+void FECell::setBulkElmtWeights(const vector<double> &t_Weights){
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    m_CellData.BulkElmtWeights_Global.clear();
+    if(rank==0) m_CellData.BulkElmtWeights_Global=t_Weights;
+}
+
+bool FECell::rebalanceBulkElmts(const vector<double> &t_LocalCost,vector<int> &t_OldPartInfo){
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    if(m_CellData.IsImplicitGrid||size<2) return false;
+
+    const int ElmtsNum=m_CellData.BulkElmtsNum;
+    const int LocalElmtsNum=static_cast<int>(m_CellData.MeshCell_Local.size());
+    if(static_cast<int>(t_LocalCost.size())!=LocalElmtsNum){
+        MessagePrinter::printErrorTxt("the cost vector size(="+to_string(t_LocalCost.size())+") doesn\'t match the local bulk elements number(="
+                                      +to_string(LocalElmtsNum)+"), can\'t rebalance the mesh");
+        MessagePrinter::exitAsFem();
+    }
+
+    /**
+     * gather the element cost to the master rank, the local cells of each rank are in ascending order of their global id
+     */
+    vector<int> Displs(size,0);
+    for(int i=1;i<size;i++) Displs[i]=Displs[i-1]+m_CellData.RanksElmtsNum_Global[i-1];
+    vector<double> AllCost;
+    if(rank==0) AllCost.resize(ElmtsNum,0.0);
+    MPI_Gatherv(t_LocalCost.data(),LocalElmtsNum,MPI_DOUBLE,
+                AllCost.data(),m_CellData.RanksElmtsNum_Global.data(),Displs.data(),MPI_DOUBLE,0,PETSC_COMM_WORLD);
+
+    vector<int> NewPartInfo(ElmtsNum,0);
+    if(rank==0){
+        vector<int> Cursor=Displs;
+        int cpuid;
+        m_CellData.BulkElmtWeights_Global.resize(ElmtsNum,0.0);
+        for(int e=1;e<=ElmtsNum;e++){
+            cpuid=m_CellData.BulkCellPartionInfo_Global[e-1];
+            m_CellData.BulkElmtWeights_Global[e-1]=AllCost[Cursor[cpuid]];
+            Cursor[cpuid]+=1;
+        }
+        vector<int> RankOffsets;
+        FECellDefaultPartitioner::splitElmtsByWeights(m_CellData.BulkElmtWeights_Global,size,RankOffsets);
+        for(cpuid=0;cpuid<size;cpuid++){
+            for(int e=RankOffsets[cpuid];e<RankOffsets[cpuid+1];e++) NewPartInfo[e]=cpuid;
+        }
+    }
+    MPI_Bcast(NewPartInfo.data(),ElmtsNum,MPI_INT,0,PETSC_COMM_WORLD);
+
+    if(NewPartInfo==m_CellData.BulkCellPartionInfo_Global) return false;
+
+    /**
+     * pack each local cell with its global id, and send it to the new owner
+     */
+    vector<vector<int>> SendIDs(size);
+    vector<vector<const SingleMeshCell*>> SendCells(size);
+    int LocalID=0;
+    for(int e=1;e<=ElmtsNum;e++){
+        if(m_CellData.BulkCellPartionInfo_Global[e-1]!=rank) continue;
+        SendIDs[NewPartInfo[e-1]].push_back(e);
+        SendCells[NewPartInfo[e-1]].push_back(&m_CellData.MeshCell_Local[LocalID]);
+        LocalID+=1;
+    }
+    vector<vector<char>> SendBufs(size),RecvBufs;
+    for(int cpuid=0;cpuid<size;cpuid++){
+        BinaryWriter writer;
+        writer.writeValue(static_cast<uint64_t>(SendIDs[cpuid].size()));
+        for(size_t i=0;i<SendIDs[cpuid].size();i++){
+            writer.writeValue(SendIDs[cpuid][i]);
+            writeSingleMeshCell(writer,*SendCells[cpuid][i]);
+        }
+        SendBufs[cpuid]=std::move(writer.getDataRef());
+    }
+    MPIDataBus::exchangeBuffersAmongRanks(SendBufs,RecvBufs);
+    SendBufs.clear();
+
+    vector<std::pair<int,SingleMeshCell>> RecvCells;
+    RecvCells.reserve(std::count(NewPartInfo.begin(),NewPartInfo.end(),rank));
+    for(int cpuid=0;cpuid<size;cpuid++){
+        BinaryReader reader(RecvBufs[cpuid].data(),RecvBufs[cpuid].size());
+        uint64_t n=0;
+        reader.readValue(n);
+        for(uint64_t i=0;i<n;i++){
+            RecvCells.emplace_back();
+            reader.readValue(RecvCells.back().first);
+            if(!readSingleMeshCell(reader,RecvCells.back().second)){
+                MessagePrinter::printErrorTxt("the mesh cell received from rank-"+to_string(cpuid)+" is broken, the rebalance fails");
+                MessagePrinter::exitAsFem();
+            }
+        }
+    }
+    std::sort(RecvCells.begin(),RecvCells.end(),
+              [](const std::pair<int,SingleMeshCell> &a,const std::pair<int,SingleMeshCell> &b){return a.first<b.first;});
+
+    m_CellData.MeshCell_Local.clear();
+    m_CellData.MeshCell_Local.reserve(RecvCells.size());
+    for(auto &it:RecvCells) m_CellData.MeshCell_Local.push_back(std::move(it.second));
+
+    t_OldPartInfo=m_CellData.BulkCellPartionInfo_Global;
+    m_CellData.BulkCellPartionInfo_Global=NewPartInfo;
+    m_CellData.RanksElmtsNum_Global.assign(size,0);
+    for(const auto &cpuid:NewPartInfo) m_CellData.RanksElmtsNum_Global[cpuid]+=1;
+
+    return true;
+}
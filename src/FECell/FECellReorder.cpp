@@ -0,0 +1,266 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.15
+//+++ Purpose: renumber the bulk elements and nodes of the global
+//+++          mesh for a better memory locality
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <queue>
+
+#include "FECell/FECellReorder.h"
+
+bool FECellReorder::getReorderTypeFromName(const string &t_name,MeshReorderType &t_type){
+    if(t_name=="none") t_type=MeshReorderType::NONE;
+    else if(t_name=="morton") t_type=MeshReorderType::MORTON;
+    else if(t_name=="hilbert") t_type=MeshReorderType::HILBERT;
+    else if(t_name=="rcm") t_type=MeshReorderType::RCM;
+    else return false;
+    return true;
+}
+
+string FECellReorder::getReorderTypeName(const MeshReorderType &t_type){
+    if(t_type==MeshReorderType::MORTON) return "morton";
+    if(t_type==MeshReorderType::HILBERT) return "hilbert";
+    if(t_type==MeshReorderType::RCM) return "rcm";
+    return "none";
+}
+
+uint64_t FECellReorder::computeCurveKey(uint32_t (&t_X)[3],const int &t_Dim,const int &t_Bits,const MeshReorderType &t_Type){
+    if(t_Type==MeshReorderType::HILBERT){
+        // transform the axes into the 'transposed' hilbert index, see J. Skilling, AIP Conf. Proc. 707 (2004) 381
+        const uint32_t M=1u<<(t_Bits-1);
+        uint32_t P,Q,t;
+        for(Q=M;Q>1;Q>>=1){
+            P=Q-1;
+            for(int i=0;i<t_Dim;i++){
+                if(t_X[i]&Q){
+                    t_X[0]^=P;
+                }
+                else{
+                    t=(t_X[0]^t_X[i])&P;
+                    t_X[0]^=t;
+                    t_X[i]^=t;
+                }
+            }
+        }
+        // gray encode
+        for(int i=1;i<t_Dim;i++) t_X[i]^=t_X[i-1];
+        t=0;
+        for(Q=M;Q>1;Q>>=1){
+            if(t_X[t_Dim-1]&Q) t^=Q-1;
+        }
+        for(int i=0;i<t_Dim;i++) t_X[i]^=t;
+    }
+    // interleave the bits, the most significant bit first
+    uint64_t key=0;
+    for(int b=t_Bits-1;b>=0;b--){
+        for(int i=0;i<t_Dim;i++){
+            key=(key<<1)|((t_X[i]>>b)&1u);
+        }
+    }
+    return key;
+}
+
+void FECellReorder::computeCurveOrder(const vector<double> &t_Coords,const int &t_Dim,const MeshReorderType &t_Type,vector<int> &t_Order){
+    const int n=static_cast<int>(t_Coords.size()/3);
+    const int Dim=t_Dim<1?1:(t_Dim>3?3:t_Dim);
+    const int Bits=Dim==1?32:(Dim==2?31:21);// the key must fit into 64 bits
+
+    double Xmin[3],Xmax[3];
+    for(int k=0;k<3;k++){Xmin[k]=1.0e30;Xmax[k]=-1.0e30;}
+    for(int i=0;i<n;i++){
+        for(int k=0;k<3;k++){
+            Xmin[k]=std::min(Xmin[k],t_Coords[3*i+k]);
+            Xmax[k]=std::max(Xmax[k],t_Coords[3*i+k]);
+        }
+    }
+    // the same scale for all the axes, so the curve is not stretched
+    double L=0.0;
+    for(int k=0;k<Dim;k++) L=std::max(L,Xmax[k]-Xmin[k]);
+    if(L<=0.0) L=1.0;
+    const double Scale=(static_cast<double>((1ull<<Bits)-1))/L;
+
+    vector<std::pair<uint64_t,int>> Keys(n);
+    uint32_t X[3];
+    for(int i=0;i<n;i++){
+        for(int k=0;k<3;k++) X[k]=0;
+        for(int k=0;k<Dim;k++) X[k]=static_cast<uint32_t>((t_Coords[3*i+k]-Xmin[k])*Scale);
+        Keys[i]=make_pair(computeCurveKey(X,Dim,Bits,t_Type),i);
+    }
+    // the stable sort keeps the original order of the points with the same key
+    std::stable_sort(Keys.begin(),Keys.end(),
+                     [](const std::pair<uint64_t,int> &a,const std::pair<uint64_t,int> &b){return a.first<b.first;});
+    t_Order.resize(n);
+    for(int i=0;i<n;i++) t_Order[i]=Keys[i].second;
+}
+
+void FECellReorder::computeRCMOrder(const vector<vector<int>> &t_Adjacency,vector<int> &t_Order){
+    const int n=static_cast<int>(t_Adjacency.size());
+    vector<bool> Visited(n,false);
+    vector<int> Level(n,-1);
+    t_Order.clear();
+    t_Order.reserve(n);
+
+    // the breadth-first search from the root, return the last vertex with the minimum degree in the last level
+    auto bfs=[&](const int &root,vector<int> &comp){
+        comp.clear();
+        std::queue<int> q;
+        q.push(root);
+        Level[root]=0;
+        comp.push_back(root);
+        int last=root;
+        while(!q.empty()){
+            const int v=q.front();q.pop();
+            for(const auto &w:t_Adjacency[v]){
+                if(Level[w]>=0) continue;
+                Level[w]=Level[v]+1;
+                comp.push_back(w);
+                q.push(w);
+                if(Level[w]>Level[last]||
+                  (Level[w]==Level[last]&&t_Adjacency[w].size()<t_Adjacency[last].size())) last=w;
+            }
+        }
+        for(const auto &v:comp) Level[v]=-1;
+        return last;
+    };
+
+    vector<int> Comp,Neighbours;
+    for(int start=0;start<n;start++){
+        if(Visited[start]) continue;
+        // the pseudo-peripheral vertex of current component is taken as the root
+        // i.e., the farthest one from the vertex of the minimum degree
+        int root=start;
+        bfs(root,Comp);
+        for(const auto &v:Comp){
+            if(t_Adjacency[v].size()<t_Adjacency[root].size()) root=v;
+        }
+        root=bfs(root,Comp);
+
+        // Cuthill-McKee, the neighbours are visited in ascending order of their degree
+        const size_t First=t_Order.size();
+        t_Order.push_back(root);
+        Visited[root]=true;
+        for(size_t i=First;i<t_Order.size();i++){
+            const int v=t_Order[i];
+            Neighbours.clear();
+            for(const auto &w:t_Adjacency[v]){
+                if(!Visited[w]){
+                    Visited[w]=true;
+                    Neighbours.push_back(w);
+                }
+            }
+            std::stable_sort(Neighbours.begin(),Neighbours.end(),
+                             [&](const int &a,const int &b){return t_Adjacency[a].size()<t_Adjacency[b].size();});
+            t_Order.insert(t_Order.end(),Neighbours.begin(),Neighbours.end());
+        }
+    }
+    std::reverse(t_Order.begin(),t_Order.end());
+}
+
+void FECellReorder::reorderFECell(const MeshReorderType &t_ElmtType,const MeshReorderType &t_NodeType,FECellData &t_CellData){
+    const int ElmtsNum=t_CellData.BulkElmtsNum;
+    const int NodesNum=t_CellData.NodesNum;
+    vector<int> Order;
+
+    /**
+     * for the bulk elements, they are sorted by the curve key of their centroids
+     */
+    if(t_ElmtType==MeshReorderType::MORTON||t_ElmtType==MeshReorderType::HILBERT){
+        vector<double> Centroids(3*ElmtsNum,0.0);
+        for(int e=0;e<ElmtsNum;e++){
+            const SingleMeshCell &cell=t_CellData.MeshCell_Total[e];
+            for(int i=1;i<=cell.NodesNumPerElmt;i++){
+                for(int k=1;k<=3;k++) Centroids[3*e+k-1]+=cell.ElmtNodeCoords0(i,k)/cell.NodesNumPerElmt;
+            }
+        }
+        computeCurveOrder(Centroids,t_CellData.MaxDim,t_ElmtType,Order);
+
+        vector<int> NewElmtID(ElmtsNum,0);
+        vector<SingleMeshCell> Cells(ElmtsNum);
+        vector<int> OrigIDs(ElmtsNum,0);
+        for(int e=0;e<ElmtsNum;e++){
+            NewElmtID[Order[e]]=e+1;
+            Cells[e]=std::move(t_CellData.MeshCell_Total[Order[e]]);
+            // the original id is kept, even if the mesh is reordered again
+            OrigIDs[e]=t_CellData.BulkElmtOrigIDs_Global.empty()?Order[e]+1:t_CellData.BulkElmtOrigIDs_Global[Order[e]];
+        }
+        t_CellData.MeshCell_Total=std::move(Cells);
+        t_CellData.BulkElmtOrigIDs_Global=std::move(OrigIDs);
+        if(static_cast<int>(t_CellData.BulkElmtWeights_Global.size())==ElmtsNum){
+            vector<double> Weights(ElmtsNum);
+            for(int e=0;e<ElmtsNum;e++) Weights[e]=t_CellData.BulkElmtWeights_Global[Order[e]];
+            t_CellData.BulkElmtWeights_Global=std::move(Weights);
+        }
+        for(auto &it:t_CellData.PhyName2BulkFECellIDMap_Global){
+            for(auto &id:it.second) id=NewElmtID[id-1];
+            std::sort(it.second.begin(),it.second.end());
+        }
+        for(auto &it:t_CellData.PhyID2BulkFECellIDMap_Global){
+            for(auto &id:it.second) id=NewElmtID[id-1];
+            std::sort(it.second.begin(),it.second.end());
+        }
+    }
+    else if(t_ElmtType==MeshReorderType::RCM){
+        MessagePrinter::printWarningTxt("rcm is not supported for the bulk elements, the elements are not reordered");
+    }
+
+    /**
+     * for the nodes, they are sorted along the curve or by rcm of the nodal graph of the bulk elements
+     */
+    if(t_NodeType==MeshReorderType::NONE) return;
+    if(t_NodeType==MeshReorderType::RCM){
+        vector<vector<int>> Adjacency(NodesNum);
+        for(const auto &cell:t_CellData.MeshCell_Total){
+            for(const auto &i:cell.ElmtConn){
+                for(const auto &j:cell.ElmtConn){
+                    if(i!=j) Adjacency[i-1].push_back(j-1);
+                }
+            }
+        }
+        for(auto &adj:Adjacency){
+            std::sort(adj.begin(),adj.end());
+            adj.erase(std::unique(adj.begin(),adj.end()),adj.end());
+        }
+        computeRCMOrder(Adjacency,Order);
+    }
+    else{
+        computeCurveOrder(t_CellData.NodeCoords_Global,t_CellData.MaxDim,t_NodeType,Order);
+    }
+
+    vector<int> NewNodeID(NodesNum,0);
+    vector<double> Coords(3*NodesNum,0.0);
+    vector<int> OrigIDs(NodesNum,0);
+    for(int i=0;i<NodesNum;i++){
+        NewNodeID[Order[i]]=i+1;
+        for(int k=0;k<3;k++) Coords[3*i+k]=t_CellData.NodeCoords_Global[3*Order[i]+k];
+        OrigIDs[i]=t_CellData.NodeOrigIDs_Global.empty()?Order[i]+1:t_CellData.NodeOrigIDs_Global[Order[i]];
+    }
+    t_CellData.NodeCoords_Global=std::move(Coords);
+    t_CellData.NodeOrigIDs_Global=std::move(OrigIDs);
+
+    for(auto &cell:t_CellData.MeshCell_Total){
+        for(auto &id:cell.ElmtConn) id=NewNodeID[id-1];
+    }
+    for(auto &it:t_CellData.PhyName2MeshCellVectorMap_Global){
+        for(auto &cell:it.second){
+            for(auto &id:cell.ElmtConn) id=NewNodeID[id-1];
+        }
+    }
+    for(auto &it:t_CellData.PhyID2MeshCellVectorMap_Global){
+        for(auto &cell:it.second){
+            for(auto &id:cell.ElmtConn) id=NewNodeID[id-1];
+        }
+    }
+    for(auto &it:t_CellData.NodalPhyName2NodeIDVecMap_Global){
+        for(auto &id:it.second) id=NewNodeID[id-1];
+        std::sort(it.second.begin(),it.second.end());
+    }
+}
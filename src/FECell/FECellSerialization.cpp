@@ -0,0 +1,289 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.05
+//+++ Purpose: write/read the distributed fe cell data of each rank
+//+++          into/from the binary buffer (for the model cache)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FECell/FECell.h"
+
+namespace{
+    bool readNodes(BinaryReader &reader,Nodes &nodes){
+        vector<double> coords;
+        if(!reader.readVector(coords)||coords.size()%3!=0) return false;
+        nodes.resize(static_cast<int>(coords.size()/3));
+        nodes.getDataRef()=std::move(coords);
+        return true;
+    }
+    void writeMeshCellVector(BinaryWriter &writer,const vector<SingleMeshCell> &cells){
+        writer.writeValue(static_cast<uint64_t>(cells.size()));
+        for(const auto &cell:cells) FECell::writeSingleMeshCell(writer,cell);
+    }
+    bool readMeshCellVector(BinaryReader &reader,vector<SingleMeshCell> &cells){
+        uint64_t n;
+        if(!reader.readValue(n)||n>reader.getRemainingSize()) return false;
+        cells.resize(static_cast<size_t>(n));
+        for(auto &cell:cells){
+            if(!FECell::readSingleMeshCell(reader,cell)) return false;
+        }
+        return true;
+    }
+
+    /**
+     * the key of the maps is either the physical id or the physical name
+     */
+    void writeKey(BinaryWriter &writer,const int &key){writer.writeValue(key);}
+    void writeKey(BinaryWriter &writer,const string &key){writer.writeString(key);}
+    bool readKey(BinaryReader &reader,int &key){return reader.readValue(key);}
+    bool readKey(BinaryReader &reader,string &key){return reader.readString(key);}
+
+    template<typename K>
+    void writeMeshCellMap(BinaryWriter &writer,const map<K,vector<SingleMeshCell>> &cellmap){
+        writer.writeValue(static_cast<uint64_t>(cellmap.size()));
+        for(const auto &it:cellmap){
+            writeKey(writer,it.first);
+            writeMeshCellVector(writer,it.second);
+        }
+    }
+    template<typename K>
+    bool readMeshCellMap(BinaryReader &reader,map<K,vector<SingleMeshCell>> &cellmap){
+        uint64_t n;
+        K key;
+        cellmap.clear();
+        if(!reader.readValue(n)) return false;
+        for(uint64_t i=0;i<n;i++){
+            if(!readKey(reader,key)) return false;
+            if(!readMeshCellVector(reader,cellmap[key])) return false;
+        }
+        return true;
+    }
+
+    template<typename K>
+    void writeIntVectorMap(BinaryWriter &writer,const map<K,vector<int>> &vecmap){
+        writer.writeValue(static_cast<uint64_t>(vecmap.size()));
+        for(const auto &it:vecmap){
+            writeKey(writer,it.first);
+            writer.writeVector(it.second);
+        }
+    }
+    template<typename K>
+    bool readIntVectorMap(BinaryReader &reader,map<K,vector<int>> &vecmap){
+        uint64_t n;
+        K key;
+        vecmap.clear();
+        if(!reader.readValue(n)) return false;
+        for(uint64_t i=0;i<n;i++){
+            if(!readKey(reader,key)) return false;
+            if(!reader.readVector(vecmap[key])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * the id<->name maps can be rebuilt from the id and name vectors
+     */
+    void buildPhyMaps(const vector<int> &ids,const vector<string> &names,map<int,string> &id2name,map<string,int> &name2id){
+        id2name.clear();
+        name2id.clear();
+        for(size_t i=0;i<ids.size()&&i<names.size();i++){
+            id2name[ids[i]]=names[i];
+            name2id[names[i]]=ids[i];
+        }
+    }
+}
+
+void FECell::writeSingleMeshCell(BinaryWriter &writer,const SingleMeshCell &cell){
+    writer.writeValue(cell.Dim);
+    writer.writeValue(cell.NodesNumPerElmt);
+    writer.writeVector(cell.ElmtConn);
+    writer.writeVector(cell.ElmtDofIDs);
+    writer.writeArray(cell.ElmtNodeCoords0.getData(),static_cast<size_t>(cell.ElmtNodeCoords0.getLength()));
+    writer.writeArray(cell.ElmtNodeCoords.getData(),static_cast<size_t>(cell.ElmtNodeCoords.getLength()));
+    writer.writeValue(cell.VTKCellType);
+    writer.writeValue(cell.CellMeshType);
+    writer.writeValue(cell.PhysicalGroupNums);
+    writer.writeStringVector(cell.PhysicalNameList);
+    writer.writeVector(cell.PhysicalIDList);
+    writer.writeValue(cell.Volume);
+}
+bool FECell::readSingleMeshCell(BinaryReader &reader,SingleMeshCell &cell){
+    reader.readValue(cell.Dim);
+    reader.readValue(cell.NodesNumPerElmt);
+    reader.readVector(cell.ElmtConn);
+    reader.readVector(cell.ElmtDofIDs);
+    if(!readNodes(reader,cell.ElmtNodeCoords0)) return false;
+    if(!readNodes(reader,cell.ElmtNodeCoords)) return false;
+    reader.readValue(cell.VTKCellType);
+    reader.readValue(cell.CellMeshType);
+    reader.readValue(cell.PhysicalGroupNums);
+    reader.readStringVector(cell.PhysicalNameList);
+    reader.readVector(cell.PhysicalIDList);
+    reader.readValue(cell.Volume);
+    return reader.isValid();
+}
+
+void FECell::writeCellData(BinaryWriter &writer)const{
+    writer.writeString(MeshDistributionMethod);
+
+    writer.writeValue(m_CellData.MeshOrder);
+    writer.writeValue(m_CellData.MaxDim);
+    writer.writeValue(m_CellData.MinDim);
+
+    writer.writeValue(m_CellData.NodesNum);
+    writer.writeValue(m_CellData.NodesNumPerLineElmt);
+    writer.writeValue(m_CellData.NodesNumPerSurfElmt);
+    writer.writeValue(m_CellData.NodesNumPerBulkElmt);
+
+    writer.writeValue(m_CellData.ElmtsNum);
+    writer.writeValue(m_CellData.BulkElmtsNum);
+    writer.writeValue(m_CellData.SurfElmtsNum);
+    writer.writeValue(m_CellData.LineElmtsNum);
+    writer.writeString(m_CellData.BulkMeshTypeName);
+
+    writer.writeValue(m_CellData.BulkElmtVTKCellType);
+    writer.writeValue(m_CellData.SurfElmtVTKCellType);
+    writer.writeValue(m_CellData.LineElmtVTKCellType);
+
+    writer.writeValue(m_CellData.BulkElmtMeshType);
+    writer.writeValue(m_CellData.SurfElmtMeshType);
+    writer.writeValue(m_CellData.LineElmtMeshType);
+
+    writer.writeValue(m_CellData.Xmin);writer.writeValue(m_CellData.Xmax);
+    writer.writeValue(m_CellData.Ymin);writer.writeValue(m_CellData.Ymax);
+    writer.writeValue(m_CellData.Zmin);writer.writeValue(m_CellData.Zmax);
+    writer.writeValue(m_CellData.Nx);
+    writer.writeValue(m_CellData.Ny);
+    writer.writeValue(m_CellData.Nz);
+    writer.writeValue(m_CellData.IsStructuredGrid);
+
+    writer.writeVector(m_CellData.NodeCoords_Global);
+
+    writer.writeValue(m_CellData.MaxDofsPerNode);
+    writer.writeValue(m_CellData.TotalDofsNum);
+    writer.writeValue(m_CellData.ActiveDofsNum);
+
+    // for elemental physical groups
+    writer.writeValue(m_CellData.PhyGroupNum_Global);
+    writer.writeVector(m_CellData.PhyDimVector_Global);
+    writer.writeVector(m_CellData.PhyIDVector_Global);
+    writer.writeStringVector(m_CellData.PhyNameVector_Global);
+    writer.writeVector(m_CellData.PhyGroupElmtsNumVector_Global);
+
+    writeMeshCellVector(writer,m_CellData.MeshCell_Total);
+    writeMeshCellVector(writer,m_CellData.MeshCell_Local);
+    writer.writeVector(m_CellData.NodeIDs_Local);
+
+    writeMeshCellMap(writer,m_CellData.PhyName2MeshCellVectorMap_Global);
+    writeMeshCellMap(writer,m_CellData.PhyID2MeshCellVectorMap_Global);
+    writeMeshCellMap(writer,m_CellData.PhyName2MeshCellVectorMap_Local);
+    writeMeshCellMap(writer,m_CellData.PhyID2MeshCellVectorMap_Local);
+
+    writeIntVectorMap(writer,m_CellData.PhyName2BulkFECellIDMap_Global);
+    writeIntVectorMap(writer,m_CellData.PhyID2BulkFECellIDMap_Global);
+
+    // for nodal physical groups
+    writer.writeValue(m_CellData.NodalPhyGroupNum_Global);
+    writer.writeVector(m_CellData.NodalPhyIDVector_Global);
+    writer.writeStringVector(m_CellData.NodalPhyNameVector_Global);
+    writer.writeVector(m_CellData.NodalPhyGroupNodesNumVector_Global);
+    writeIntVectorMap(writer,m_CellData.NodalPhyName2NodeIDVecMap_Global);
+    writeIntVectorMap(writer,m_CellData.NodalPhyName2NodeIDVecMap_Local);
+
+    // for partition info
+    writer.writeVector(m_CellData.BulkCellPartionInfo_Global);
+    writer.writeVector(m_CellData.RanksElmtsNum_Global);
+
+    // for the mesh reordering
+    writer.writeVector(m_CellData.BulkElmtOrigIDs_Global);
+    writer.writeVector(m_CellData.NodeOrigIDs_Global);
+}
+
+bool FECell::readCellData(BinaryReader &reader){
+    reader.readString(MeshDistributionMethod);
+
+    reader.readValue(m_CellData.MeshOrder);
+    reader.readValue(m_CellData.MaxDim);
+    reader.readValue(m_CellData.MinDim);
+
+    reader.readValue(m_CellData.NodesNum);
+    reader.readValue(m_CellData.NodesNumPerLineElmt);
+    reader.readValue(m_CellData.NodesNumPerSurfElmt);
+    reader.readValue(m_CellData.NodesNumPerBulkElmt);
+
+    reader.readValue(m_CellData.ElmtsNum);
+    reader.readValue(m_CellData.BulkElmtsNum);
+    reader.readValue(m_CellData.SurfElmtsNum);
+    reader.readValue(m_CellData.LineElmtsNum);
+    reader.readString(m_CellData.BulkMeshTypeName);
+
+    reader.readValue(m_CellData.BulkElmtVTKCellType);
+    reader.readValue(m_CellData.SurfElmtVTKCellType);
+    reader.readValue(m_CellData.LineElmtVTKCellType);
+
+    reader.readValue(m_CellData.BulkElmtMeshType);
+    reader.readValue(m_CellData.SurfElmtMeshType);
+    reader.readValue(m_CellData.LineElmtMeshType);
+
+    reader.readValue(m_CellData.Xmin);reader.readValue(m_CellData.Xmax);
+    reader.readValue(m_CellData.Ymin);reader.readValue(m_CellData.Ymax);
+    reader.readValue(m_CellData.Zmin);reader.readValue(m_CellData.Zmax);
+    reader.readValue(m_CellData.Nx);
+    reader.readValue(m_CellData.Ny);
+    reader.readValue(m_CellData.Nz);
+    reader.readValue(m_CellData.IsStructuredGrid);
+
+    reader.readVector(m_CellData.NodeCoords_Global);
+
+    reader.readValue(m_CellData.MaxDofsPerNode);
+    reader.readValue(m_CellData.TotalDofsNum);
+    reader.readValue(m_CellData.ActiveDofsNum);
+
+    // for elemental physical groups
+    reader.readValue(m_CellData.PhyGroupNum_Global);
+    reader.readVector(m_CellData.PhyDimVector_Global);
+    reader.readVector(m_CellData.PhyIDVector_Global);
+    reader.readStringVector(m_CellData.PhyNameVector_Global);
+    reader.readVector(m_CellData.PhyGroupElmtsNumVector_Global);
+    buildPhyMaps(m_CellData.PhyIDVector_Global,m_CellData.PhyNameVector_Global,
+                 m_CellData.PhyID2NameMap_Global,m_CellData.PhyName2IDMap_Global);
+
+    if(!readMeshCellVector(reader,m_CellData.MeshCell_Total)) return false;
+    if(!readMeshCellVector(reader,m_CellData.MeshCell_Local)) return false;
+    reader.readVector(m_CellData.NodeIDs_Local);
+
+    if(!readMeshCellMap(reader,m_CellData.PhyName2MeshCellVectorMap_Global)) return false;
+    if(!readMeshCellMap(reader,m_CellData.PhyID2MeshCellVectorMap_Global)) return false;
+    if(!readMeshCellMap(reader,m_CellData.PhyName2MeshCellVectorMap_Local)) return false;
+    if(!readMeshCellMap(reader,m_CellData.PhyID2MeshCellVectorMap_Local)) return false;
+
+    if(!readIntVectorMap(reader,m_CellData.PhyName2BulkFECellIDMap_Global)) return false;
+    if(!readIntVectorMap(reader,m_CellData.PhyID2BulkFECellIDMap_Global)) return false;
+
+    // for nodal physical groups
+    reader.readValue(m_CellData.NodalPhyGroupNum_Global);
+    reader.readVector(m_CellData.NodalPhyIDVector_Global);
+    reader.readStringVector(m_CellData.NodalPhyNameVector_Global);
+    reader.readVector(m_CellData.NodalPhyGroupNodesNumVector_Global);
+    buildPhyMaps(m_CellData.NodalPhyIDVector_Global,m_CellData.NodalPhyNameVector_Global,
+                 m_CellData.NodalPhyID2NameMap_Global,m_CellData.NodalPhyName2IDMap_Global);
+    if(!readIntVectorMap(reader,m_CellData.NodalPhyName2NodeIDVecMap_Global)) return false;
+    if(!readIntVectorMap(reader,m_CellData.NodalPhyName2NodeIDVecMap_Local)) return false;
+
+    // for partition info
+    reader.readVector(m_CellData.BulkCellPartionInfo_Global);
+    reader.readVector(m_CellData.RanksElmtsNum_Global);
+
+    // for the mesh reordering
+    reader.readVector(m_CellData.BulkElmtOrigIDs_Global);
+    reader.readVector(m_CellData.NodeOrigIDs_Global);
+
+    return reader.isValid();
+}
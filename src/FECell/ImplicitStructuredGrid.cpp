@@ -0,0 +1,352 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.08
+//+++ Purpose: the implicit structured grid for the built-in
+//+++          linear mesh (edge2/quad4/hex8)
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "mpi.h"
+#include "FECell/ImplicitStructuredGrid.h"
+
+namespace{
+    const string SideNames[6]={"left","right","bottom","top","back","front"};
+    // the local node index (start from 0) of each side, the same as the ones used in the mesh generators
+    const int Edge2SideNodes[2][1]={{0},{1}};
+    const int Quad4SideNodes[4][2]={{3,0},{1,2},{0,1},{2,3}};
+    const int Hex8SideNodes[6][4]={{0,4,7,3},{1,2,6,5},{0,1,5,4},{3,7,6,2},{0,3,2,1},{4,5,6,7}};
+}
+
+ImplicitStructuredGrid::ImplicitStructuredGrid(){
+    m_Dim=1;
+    m_Nx=1;m_Ny=1;m_Nz=1;
+    m_Xmin=0.0;m_Ymin=0.0;m_Zmin=0.0;
+    m_Dx=1.0;m_Dy=0.0;m_Dz=0.0;
+    m_NodesNum=0;
+    m_BulkElmtsNum=0;
+    m_NodesNumPerBulkElmt=0;
+    m_BulkElmtVTKCellType=0;
+    for(int i=0;i<8;i++) m_NodeOffset[i]=0;
+}
+
+bool ImplicitStructuredGrid::isMeshTypeSupported(const MeshType &meshtype){
+    return meshtype==MeshType::EDGE2||meshtype==MeshType::QUAD4||meshtype==MeshType::HEX8;
+}
+
+//*********************************************************
+bool ImplicitStructuredGrid::init(FECellData &t_celldata){
+    if(!isMeshTypeSupported(t_celldata.BulkElmtMeshType)) return false;
+
+    m_Dim=t_celldata.MaxDim;
+    m_Nx=t_celldata.Nx;
+    m_Ny=(m_Dim>1)?t_celldata.Ny:1;
+    m_Nz=(m_Dim>2)?t_celldata.Nz:1;
+    m_Xmin=t_celldata.Xmin;
+    m_Ymin=t_celldata.Ymin;
+    m_Zmin=t_celldata.Zmin;
+
+    t_celldata.MeshOrder=1;
+    t_celldata.ActiveDofsNum=0;
+    t_celldata.TotalDofsNum=0;
+    t_celldata.MaxDofsPerNode=0;
+    if(m_Dim==1){
+        // the same as the edge2 generator, the y and z coords are interpolated along the x-axis
+        m_Dx=(t_celldata.Xmax-t_celldata.Xmin)/m_Nx;
+        m_Dy=(t_celldata.Ymax-t_celldata.Ymin)/m_Nx;
+        m_Dz=(t_celldata.Zmax-t_celldata.Zmin)/m_Nx;
+        m_NodesNum=m_Nx+1;
+        m_NodesNumPerBulkElmt=2;
+        m_BulkElmtVTKCellType=3;
+        m_NodeOffset[0]=0;m_NodeOffset[1]=1;
+
+        t_celldata.MinDim=0;
+        t_celldata.BulkMeshTypeName="edge2";
+        t_celldata.SurfElmtsNum=0;
+        t_celldata.LineElmtsNum=0;
+        t_celldata.NodesNumPerSurfElmt=0;
+        t_celldata.NodesNumPerLineElmt=0;
+        t_celldata.LineElmtVTKCellType=0;
+        t_celldata.LineElmtMeshType=MeshType::NULLTYPE;
+        t_celldata.SurfElmtVTKCellType=0;
+        t_celldata.SurfElmtMeshType=MeshType::NULLTYPE;
+    }
+    else if(m_Dim==2){
+        m_Dx=(t_celldata.Xmax-t_celldata.Xmin)/m_Nx;
+        m_Dy=(t_celldata.Ymax-t_celldata.Ymin)/m_Ny;
+        m_Dz=0.0;
+        m_NodesNum=(m_Nx+1)*(m_Ny+1);
+        m_NodesNumPerBulkElmt=4;
+        m_BulkElmtVTKCellType=9;
+        m_NodeOffset[0]=0;m_NodeOffset[1]=1;
+        m_NodeOffset[2]=m_Nx+2;m_NodeOffset[3]=m_Nx+1;
+
+        t_celldata.MinDim=1;
+        t_celldata.BulkMeshTypeName="quad4";
+        t_celldata.SurfElmtsNum=0;
+        t_celldata.LineElmtsNum=2*(m_Nx+m_Ny);
+        t_celldata.NodesNumPerSurfElmt=0;
+        t_celldata.NodesNumPerLineElmt=2;
+        t_celldata.LineElmtVTKCellType=3;
+        t_celldata.LineElmtMeshType=MeshType::EDGE2;
+        t_celldata.SurfElmtVTKCellType=0;
+        t_celldata.SurfElmtMeshType=MeshType::NULLTYPE;
+    }
+    else{
+        m_Dx=(t_celldata.Xmax-t_celldata.Xmin)/m_Nx;
+        m_Dy=(t_celldata.Ymax-t_celldata.Ymin)/m_Ny;
+        m_Dz=(t_celldata.Zmax-t_celldata.Zmin)/m_Nz;
+        m_NodesNum=(m_Nx+1)*(m_Ny+1)*(m_Nz+1);
+        m_NodesNumPerBulkElmt=8;
+        m_BulkElmtVTKCellType=12;
+        m_NodeOffset[0]=0;m_NodeOffset[1]=1;
+        m_NodeOffset[2]=m_Nx+2;m_NodeOffset[3]=m_Nx+1;
+        for(int i=4;i<8;i++) m_NodeOffset[i]=m_NodeOffset[i-4]+(m_Nx+1)*(m_Ny+1);
+
+        t_celldata.MinDim=2;
+        t_celldata.BulkMeshTypeName="hex8";
+        t_celldata.SurfElmtsNum=2*(m_Nx*m_Ny+m_Nx*m_Nz+m_Ny*m_Nz);
+        t_celldata.LineElmtsNum=0;
+        t_celldata.NodesNumPerSurfElmt=4;
+        t_celldata.NodesNumPerLineElmt=2;
+        t_celldata.LineElmtVTKCellType=3;
+        t_celldata.LineElmtMeshType=MeshType::EDGE2;
+        t_celldata.SurfElmtVTKCellType=9;
+        t_celldata.SurfElmtMeshType=MeshType::QUAD4;
+    }
+    m_BulkElmtsNum=m_Nx*m_Ny*m_Nz;
+
+    t_celldata.BulkElmtsNum=m_BulkElmtsNum;
+    t_celldata.ElmtsNum=t_celldata.BulkElmtsNum
+                       +t_celldata.SurfElmtsNum
+                       +t_celldata.LineElmtsNum;
+    t_celldata.NodesNum=m_NodesNum;
+    t_celldata.NodesNumPerBulkElmt=m_NodesNumPerBulkElmt;
+    t_celldata.BulkElmtVTKCellType=m_BulkElmtVTKCellType;
+
+    // nothing of the global mesh is stored
+    t_celldata.NodeCoords_Global.clear();
+    t_celldata.MeshCell_Total.clear();
+    t_celldata.PhyName2MeshCellVectorMap_Global.clear();
+    t_celldata.PhyID2MeshCellVectorMap_Global.clear();
+    t_celldata.PhyName2BulkFECellIDMap_Global.clear();
+    t_celldata.PhyID2BulkFECellIDMap_Global.clear();
+    t_celldata.NodalPhyName2NodeIDVecMap_Global.clear();
+    t_celldata.BulkCellPartionInfo_Global.clear();
+
+    // setup the physical group information, which is the same on all the ranks
+    t_celldata.PhyGroupNum_Global=1+2*m_Dim;
+    t_celldata.PhyDimVector_Global.assign(1+2*m_Dim,m_Dim-1);
+    t_celldata.PhyIDVector_Global.resize(1+2*m_Dim,0);
+    t_celldata.PhyNameVector_Global.resize(1+2*m_Dim);
+    t_celldata.PhyGroupElmtsNumVector_Global.resize(1+2*m_Dim,0);
+    t_celldata.PhyID2NameMap_Global.clear();
+    t_celldata.PhyName2IDMap_Global.clear();
+
+    t_celldata.PhyDimVector_Global[0]=m_Dim;
+    t_celldata.PhyIDVector_Global[0]=0;
+    t_celldata.PhyNameVector_Global[0]="alldomain";
+    t_celldata.PhyGroupElmtsNumVector_Global[0]=m_BulkElmtsNum;
+    for(int side=0;side<2*m_Dim;side++){
+        t_celldata.PhyIDVector_Global[side+1]=side+1;
+        t_celldata.PhyNameVector_Global[side+1]=SideNames[side];
+        t_celldata.PhyGroupElmtsNumVector_Global[side+1]=getSideElmtsNum(side);
+    }
+    for(int i=0;i<t_celldata.PhyGroupNum_Global;i++){
+        t_celldata.PhyID2NameMap_Global[t_celldata.PhyIDVector_Global[i]]=t_celldata.PhyNameVector_Global[i];
+        t_celldata.PhyName2IDMap_Global[t_celldata.PhyNameVector_Global[i]]=t_celldata.PhyIDVector_Global[i];
+    }
+
+    // setup the nodal physical group information
+    t_celldata.NodalPhyGroupNum_Global=2*m_Dim;
+    t_celldata.NodalPhyIDVector_Global.resize(2*m_Dim);
+    t_celldata.NodalPhyNameVector_Global.resize(2*m_Dim);
+    t_celldata.NodalPhyGroupNodesNumVector_Global.resize(2*m_Dim);
+    t_celldata.NodalPhyID2NameMap_Global.clear();
+    t_celldata.NodalPhyName2IDMap_Global.clear();
+    for(int side=0;side<2*m_Dim;side++){
+        t_celldata.NodalPhyIDVector_Global[side]=10001+side;
+        t_celldata.NodalPhyNameVector_Global[side]=SideNames[side]+"nodes";
+        t_celldata.NodalPhyGroupNodesNumVector_Global[side]=getSideNodesNum(side);
+        t_celldata.NodalPhyID2NameMap_Global[10001+side]=SideNames[side]+"nodes";
+        t_celldata.NodalPhyName2IDMap_Global[SideNames[side]+"nodes"]=10001+side;
+    }
+
+    t_celldata.IsImplicitGrid=true;
+    t_celldata.IsStructuredGrid=true;
+    return true;
+}
+
+//*********************************************************
+void ImplicitStructuredGrid::createLocalFECell(FECellData &t_celldata)const{
+    int rank,size;
+    int iStart,iEnd;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    t_celldata.PhyID2MeshCellVectorMap_Local.clear();
+    t_celldata.PhyName2MeshCellVectorMap_Local.clear();
+    /**
+     * for elemental physical cell set
+     */
+    vector<SingleMeshCell> LocalCellVector;
+    for(int phynum=0;phynum<t_celldata.PhyGroupNum_Global;phynum++){
+        const int phyid=t_celldata.PhyIDVector_Global[phynum];
+        getLocalRange(t_celldata.PhyGroupElmtsNumVector_Global[phynum],size,rank,iStart,iEnd);
+        LocalCellVector.resize(iEnd-iStart);
+        for(int e=iStart;e<iEnd;e++){
+            if(phyid==0){
+                createBulkCell(e+1,LocalCellVector[e-iStart]);
+            }
+            else{
+                createSideCell(phyid-1,e,LocalCellVector[e-iStart]);
+            }
+        }
+        t_celldata.PhyID2MeshCellVectorMap_Local[phyid]=LocalCellVector;
+        t_celldata.PhyName2MeshCellVectorMap_Local[t_celldata.PhyNameVector_Global[phynum]]=LocalCellVector;
+    }
+    /**
+     * for all domain bulk cell
+     */
+    t_celldata.MeshCell_Local=t_celldata.PhyID2MeshCellVectorMap_Local[0];
+    t_celldata.RanksElmtsNum_Global.resize(size,0);
+    for(int cpuid=0;cpuid<size;cpuid++){
+        getLocalRange(m_BulkElmtsNum,size,cpuid,iStart,iEnd);
+        t_celldata.RanksElmtsNum_Global[cpuid]=iEnd-iStart;
+    }
+    /**
+     * for nodal physical group sets
+     */
+    t_celldata.NodalPhyName2NodeIDVecMap_Local.clear();
+    for(int side=0;side<t_celldata.NodalPhyGroupNum_Global;side++){
+        getLocalRange(t_celldata.NodalPhyGroupNodesNumVector_Global[side],size,rank,iStart,iEnd);
+        vector<int> &nodeids=t_celldata.NodalPhyName2NodeIDVecMap_Local[t_celldata.NodalPhyNameVector_Global[side]];
+        nodeids.resize(iEnd-iStart);
+        for(int i=iStart;i<iEnd;i++) nodeids[i-iStart]=getSideIthNodeID(side,i);
+    }
+    /**
+     * for the local node ids
+     */
+    getLocalRange(m_NodesNum,size,rank,iStart,iEnd);
+    t_celldata.NodeIDs_Local.resize(iEnd-iStart);
+    for(int i=iStart;i<iEnd;i++) t_celldata.NodeIDs_Local[i-iStart]=i+1;
+}
+
+//*********************************************************
+int ImplicitStructuredGrid::getSideElmtsNum(const int &side)const{
+    const int n[3]={m_Nx,m_Ny,m_Nz};
+    int num=1;
+    for(int d=0;d<m_Dim;d++){
+        if(d!=side/2) num*=n[d];
+    }
+    return num;
+}
+int ImplicitStructuredGrid::getSideNodesNum(const int &side)const{
+    const int n[3]={m_Nx,m_Ny,m_Nz};
+    int num=1;
+    for(int d=0;d<m_Dim;d++){
+        if(d!=side/2) num*=n[d]+1;
+    }
+    return num;
+}
+int ImplicitStructuredGrid::getSideIthNodeID(const int &side,const int &i)const{
+    // the node id increases with (k,j,i), so looping the free axes from x to z gives the sorted ids
+    const int n[3]={m_Nx,m_Ny,m_Nz};
+    int idx[3]={0,0,0};
+    int r=i;
+    for(int d=0;d<m_Dim;d++){
+        if(d==side/2){
+            idx[d]=(side%2==0)?0:n[d];
+        }
+        else{
+            idx[d]=r%(n[d]+1);
+            r/=n[d]+1;
+        }
+    }
+    return idx[2]*(m_Nx+1)*(m_Ny+1)+idx[1]*(m_Nx+1)+idx[0]+1;
+}
+
+//*********************************************************
+void ImplicitStructuredGrid::createBulkCell(const int &e,SingleMeshCell &cell)const{
+    cell.Dim=m_Dim;
+    cell.NodesNumPerElmt=m_NodesNumPerBulkElmt;
+    cell.VTKCellType=m_BulkElmtVTKCellType;
+    if(m_Dim==1){
+        cell.Volume=m_Dx;
+    }
+    else if(m_Dim==2){
+        cell.Volume=m_Dx*m_Dy;
+    }
+    else{
+        cell.Volume=m_Dx*m_Dy*m_Dz;
+    }
+    cell.ElmtConn.resize(m_NodesNumPerBulkElmt);
+    cell.ElmtNodeCoords.resize(m_NodesNumPerBulkElmt);
+    for(int i=1;i<=m_NodesNumPerBulkElmt;i++){
+        cell.ElmtConn[i-1]=getIthBulkElmtJthNodeID(e,i);
+        for(int j=1;j<=3;j++){
+            cell.ElmtNodeCoords(i,j)=getIthNodeJthCoord(cell.ElmtConn[i-1],j);
+        }
+    }
+    cell.ElmtNodeCoords0=cell.ElmtNodeCoords;
+}
+void ImplicitStructuredGrid::createSideCell(const int &side,const int &i,SingleMeshCell &cell)const{
+    // find the bulk element which owns current boundary cell
+    const int n[3]={m_Nx,m_Ny,m_Nz};
+    int idx[3]={0,0,0};
+    int r=i;
+    for(int d=0;d<m_Dim;d++){
+        if(d==side/2){
+            idx[d]=(side%2==0)?0:n[d]-1;
+        }
+        else{
+            idx[d]=r%n[d];
+            r/=n[d];
+        }
+    }
+    const int e=idx[2]*m_Nx*m_Ny+idx[1]*m_Nx+idx[0]+1;
+    const int *sidenodes;
+    if(m_Dim==1){
+        cell.NodesNumPerElmt=1;
+        cell.VTKCellType=1;
+        sidenodes=Edge2SideNodes[side];
+    }
+    else if(m_Dim==2){
+        cell.NodesNumPerElmt=2;
+        cell.VTKCellType=3;
+        sidenodes=Quad4SideNodes[side];
+    }
+    else{
+        cell.NodesNumPerElmt=4;
+        cell.VTKCellType=9;
+        sidenodes=Hex8SideNodes[side];
+    }
+    cell.Dim=m_Dim-1;
+    cell.Volume=0.0;
+    cell.PhysicalGroupNums=1;
+    cell.PhysicalIDList.assign(1,side+1);
+    cell.PhysicalNameList.assign(1,SideNames[side]);
+    cell.ElmtConn.resize(cell.NodesNumPerElmt);
+    cell.ElmtNodeCoords.resize(cell.NodesNumPerElmt);
+    for(int k=1;k<=cell.NodesNumPerElmt;k++){
+        cell.ElmtConn[k-1]=getIthBulkElmtJthNodeID(e,sidenodes[k-1]+1);
+        for(int j=1;j<=3;j++){
+            cell.ElmtNodeCoords(k,j)=getIthNodeJthCoord(cell.ElmtConn[k-1],j);
+        }
+    }
+    cell.ElmtNodeCoords0=cell.ElmtNodeCoords;
+}
+
+//*********************************************************
+void ImplicitStructuredGrid::getLocalRange(const int &datasize,const int &size,const int &rank,int &iStart,int &iEnd){
+    const int ranksize=datasize/size;
+    iStart=rank*ranksize;
+    iEnd=(rank+1)*ranksize;
+    if(rank==size-1) iEnd=datasize;
+}
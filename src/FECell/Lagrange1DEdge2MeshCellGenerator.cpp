@@ -31,7 +31,7 @@ bool Lagrange1DEdge2MeshCellGenerator::generateFECell(FECellData &t_celldata){
     t_celldata.TotalDofsNum=0;
     t_celldata.MaxDofsPerNode=0;
 
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     if(rank==0){
         vector<SingleMeshCell> leftconn,rightconn;
         vector<int> leftnodes,rightnodes;
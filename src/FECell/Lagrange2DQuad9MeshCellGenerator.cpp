@@ -31,8 +31,8 @@ bool Lagrange2DQuad9MeshCellGenerator::generateFECell(FECellData &t_celldata){
     t_celldata.TotalDofsNum=0;
     t_celldata.MaxDofsPerNode=0;
 
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
     if(rank==0){
         vector<SingleMeshCell> leftconn,rightconn;
         vector<SingleMeshCell> bottomconn,topconn;
@@ -61,8 +61,8 @@ bool Msh2File2FECellImporter::importMeshFile(const string &filename,FECellData &
 
     int rank,size;
 
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
     
     t_celldata.MaxDim=getMaxMeshDim(filename);
     t_celldata.MinDim=0;
@@ -703,21 +703,21 @@ bool Msh2File2FECellImporter::importMeshFile(const string &filename,FECellData &
     /**
      * Share some common variables among ranks
      */
-    MPI_Bcast(&t_celldata.MeshOrder,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.MeshOrder,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.BulkElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.LineElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.SurfElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.ElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.BulkElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.LineElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.SurfElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.ElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.NodesNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerBulkElmt,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerSurfElmt,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerLineElmt,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerBulkElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerSurfElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerLineElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.BulkElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.SurfElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.LineElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.BulkElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.SurfElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.LineElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
 
     return true;
 }
\ No newline at end of file
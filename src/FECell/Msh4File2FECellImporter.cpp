@@ -10,63 +10,16 @@
 //+++ Author : Yang Bai
 //+++ Date   : 2024.07.11
 //+++ Purpose: Implement the msh file (version-4) import function.
-//+++          This mesh file must be the *.msh in version-4.
+//+++          This mesh file must be the *.msh in version-4,
+//+++          both ascii and binary (4.1) formats are supported.
 //+++          For version-2, please use Msh2FileImporter.
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "FECell/Msh4File2FECellImporter.h"
+#include "FECell/Msh4FileReader.h"
 #include "Utils/StringUtils.h"
 #include "MPIUtils/MPIDataBus.h"
 
-int Msh4File2FECellImporter::getMaxMeshDim(const string &filename)const{
-    ifstream in;
-    string str;
-    int maxdim;
-    in.open(filename.c_str(),ios::in);
-    if(!in.is_open()){
-        MessagePrinter::printErrorTxt("can\'t read the .msh file("+filename+"),please make sure file name is correct"
-                                      " or you have the access permission");
-        return false;
-    }
-    maxdim=-1;
-    while(!in.eof()){
-        getline(in,str);
-        if(str.find("$Elements")!=string::npos){
-            int numEntityBlocks;
-            int entityDim,numElementsInBlock;
-            vector<double> numbers;
-
-            getline(in,str);
-            numbers=StringUtils::splitStrNum(str);
-
-            if(numbers.size()!=4){
-                //numEntityBlocks(size_t) numElements(size_t) minElementTag(size_t) maxElementTag(size_t)
-                MessagePrinter::printErrorTxt("Invalid element entities in your msh4 file inside the $Elements");
-                MessagePrinter::exitAsFem();
-            }
-            numEntityBlocks=static_cast<int>(numbers[1-1]);
-
-            for(int nblock=0;nblock<numEntityBlocks;nblock++){
-                getline(in,str);
-                numbers=StringUtils::splitStrNum(str);
-                if(numbers.size()!=4){
-                    MessagePrinter::printErrorTxt("Invalid element entities for current element in your msh4 file inside the $Elements");
-                    MessagePrinter::exitAsFem();
-                }
-                entityDim=static_cast<int>(numbers[1-1]);
-                if(entityDim>maxdim) maxdim=entityDim;
-                numElementsInBlock=static_cast<int>(numbers[4-1]);
-                for(int i=0;i<numElementsInBlock;i++){
-                    getline(in,str);
-                }
-            }
-            break;
-        }
-    }
-    in.close();
-    return maxdim;
-}
-
 int Msh4File2FECellImporter::getPhysicalIDViaEntityTag(const int &entityDim,const int &entityTag)const{
     if(entityDim==0){
         return m_PointsEntityPhyIDs[entityTag-1];
@@ -88,31 +41,39 @@ int Msh4File2FECellImporter::getPhysicalIDViaEntityTag(const int &entityDim,cons
 }
 
 bool Msh4File2FECellImporter::importMeshFile(const string &filename,FECellData &t_celldata){
-    ifstream in;
-    in.open(filename.c_str(),ios::in);
-    if(!in.is_open()){
-        MessagePrinter::printErrorTxt("can\'t read the .msh file("+filename+"),please make sure file name is correct"
-                                      " or you have the access permission");
-        return false;
-    }
-    
-
     int rank,size;
 
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
-    
-    t_celldata.MaxDim=getMaxMeshDim(filename);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    // only the master rank maps and parses the msh file, then the status and the dimension are shared
+    Msh4FileReader reader;
+    int IsSuccess=1;
+    int mshMaxDim=-1;
+    if(rank==0){
+        if(reader.readMeshFile(filename)){
+            if(reader.getVersion()<4.0 || reader.getVersion()>4.2){
+                MessagePrinter::printErrorTxt("version="+to_string(reader.getVersion())+" is not supported for msh4 file importer, "
+                                              "please check your mesh file");
+                IsSuccess=0;
+            }
+            mshMaxDim=reader.getMaxElmtDim();
+        }
+        else{
+            IsSuccess=0;
+        }
+    }
+    MPI_Bcast(&IsSuccess,1,MPI_INT,0,PETSC_COMM_WORLD);
+    if(!IsSuccess) return false;
+    MPI_Bcast(&mshMaxDim,1,MPI_INT,0,PETSC_COMM_WORLD);
+
+    t_celldata.MaxDim=mshMaxDim;
     t_celldata.MinDim=0;
     t_celldata.ActiveDofsNum=0;
     t_celldata.TotalDofsNum=0;
     t_celldata.MaxDofsPerNode=0;
 
-    if(rank!=0) in.close();// close the ifstream on other ranks
-
     if(rank==0){
-        int mshMaxDim;
-
         int mshPhyGroupNum;
         int maxPhyGroupID;
         int maxPhyGroupDim,minPhyGroupDim;
@@ -137,10 +98,6 @@ bool Msh4File2FECellImporter::importMeshFile(const string &filename,FECellData &
         vector<int> ElmtIDFlag;
         vector<SingleMeshCell> TempCellVec,BulkCellVec;
         int PointElmtsNum;
-        string str;
-        double version;
-        int format;
-        vector<double> numbers;
         
         int numNodes=0;
         int minNodeTag=0;
@@ -148,13 +105,9 @@ bool Msh4File2FECellImporter::importMeshFile(const string &filename,FECellData &
         vector<double> NodeCoords;// here the node id may not be contineous case !!!
         vector<int> NodeIDFlag;
         
-        int numEntityBlocks=0;
         int numElements=0;
         int minElementTag=0;
         int maxElementTag=0;
-        int numElementsInBlock=0;
-        
-        mshMaxDim=getMaxMeshDim(filename);
         
         t_celldata.MaxDim=mshMaxDim;
         t_celldata.MinDim=10;
@@ -175,401 +128,266 @@ bool Msh4File2FECellImporter::importMeshFile(const string &filename,FECellData &
         t_celldata.SurfElmtsNum=0;
         t_celldata.BulkElmtsNum=0;
         t_celldata.ElmtsNum=0;
-        while(!in.eof()){
-            getline(in,str);
-            if(str.find("$MeshFormat")!=string::npos){
-                // read the version, format, size
-                int mysize;
-                in>>version>>format>>mysize;
-                if(version<4.0 || version>4.2){
-                    MessagePrinter::printErrorTxt("version="+to_string(version)+" is not supported for msh4 file importer, "
-                                                  "please check your mesh file");
-                    return false;
-                }
+
+        //**************************************************
+        //*** for the physical groups
+        //**************************************************
+        mshPhyGroupNum=static_cast<int>(reader.getPhysicalNames().size());
+        for(const auto &it:reader.getPhysicalNames()){
+            const int phydim=it.m_Dim;
+            const int phyid=it.m_ID;
+            const string phyname=it.m_Name;
+            if(phydim>maxPhyGroupDim) maxPhyGroupDim=phydim;
+            if(minPhyGroupDim<phydim) minPhyGroupDim=phydim;
+            if(phyid>maxPhyGroupID) maxPhyGroupID=phyid;
+            
+            if(phydim==0){
+                // for nodal physical information
+                mshNodalPhyGroupNum+=1;
+                mshNodalPhyGroupNameVec.push_back(phyname);
+                mshNodalPhyGroupIDVec.push_back(phyid);
             }
-            else if(str.find("$PhysicalNames")!=string::npos){
-                int phydim,phyid;
-                string phyname;
-                in>>mshPhyGroupNum;
-                getline(in,str);//remove \n in this line
-                for(int i=0;i<mshPhyGroupNum;i++){
-                    getline(in,str);
-                    istringstream s_stream(str);
-                    s_stream>>phydim>>phyid>>phyname;
-                    // remove the '"' ,keep only the text
-                    phyname.erase(remove(phyname.begin(),phyname.end(),'"'),phyname.end());
-                    if(phydim>maxPhyGroupDim) maxPhyGroupDim=phydim;
-                    if(minPhyGroupDim<phydim) minPhyGroupDim=phydim;
-                    if(phyid>maxPhyGroupID) maxPhyGroupID=phyid;
-                    
-                    if(phydim==0){
-                        // for nodal physical information
-                        mshNodalPhyGroupNum+=1;
-                        mshNodalPhyGroupNameVec.push_back(phyname);
-                        mshNodalPhyGroupIDVec.push_back(phyid);
-                    }
-                    else{
-                        mshPhyGroupDimVec.push_back(phydim);
-                        mshPhyGroupIDVec.push_back(phyid);
-                        mshPhyGroupNameVec.push_back(phyname);
-                    }
-                    if(phydim==mshMaxDim){
-                        mshBulkPhyGroupNum+=1;
-                    }
-                    mshPhyID2NameMap[phyid]=phyname;
-                }
-                getline(in,str);
-            }// end-of-physical-group-reading
-            else if(str.find("$Entities")!=string::npos){
-                getline(in,str);
-                numbers=StringUtils::splitStrNum(str);
-                int numPoints,numCurves,numSurfaces,numVolumes;
-                if(numbers.size()!=4){
-                    MessagePrinter::printErrorTxt("Invalid entity block information in your msh4 file inside the $Entities");
-                    MessagePrinter::exitAsFem();
-                }
-                
-                numPoints=static_cast<int>(numbers[1-1]);
-                numCurves=static_cast<int>(numbers[2-1]);
-                numSurfaces=static_cast<int>(numbers[3-1]);
-                numVolumes=static_cast<int>(numbers[4-1]);
-                
-                // factor=20 to avoid the unordered entitie index(especially the nodal entities)
-                m_PointsEntityPhyIDs.resize(numPoints*100,0);
-                m_CurvesEntityPhyIDS.resize(numCurves*100,0);
-                m_SurfaceEntityPhyIDs.resize(numSurfaces*100,0);
-                m_VolumesEntityPhyIDs.resize(numVolumes*100,0);
-                
-                int i,j;
-                int nodeid,curveid,surfaceid,volumeid;
-                //*** read points entities
-                for(i=0;i<numPoints;i++){
-                    getline(in,str);
-                    numbers=StringUtils::splitStrNum(str);
-                    nodeid=static_cast<int>(numbers[1-1]);
-                    if(static_cast<int>(numbers[5-1])>0){
-                        m_PointsEntityPhyIDs[nodeid-1]=static_cast<int>(numbers[6-1]);
-                    }
-                }
-                //*** read curvess entities
-                for(i=0;i<numCurves;i++){
-                    getline(in,str);
-                    numbers=StringUtils::splitStrNum(str);
-                    curveid=static_cast<int>(numbers[1-1]);
-                    j=static_cast<int>(numbers[8-1]);
-                    if(j>0){
-                        m_CurvesEntityPhyIDS[curveid-1]=static_cast<int>(numbers[8+j-1]);
-                    }
-                }
-                //*** read surfaces entities
-                for(i=0;i<numSurfaces;i++){
-                    getline(in,str);
-                    numbers=StringUtils::splitStrNum(str);
-                    surfaceid=static_cast<int>(numbers[1-1]);
-                    j=static_cast<int>(numbers[8-1]);
-                    if(j>0){
-                        m_SurfaceEntityPhyIDs[surfaceid-1]=static_cast<int>(numbers[8+j-1]);
-                    }
-                }
-                //*** read volumes entities
-                for(i=0;i<numVolumes;i++){
-                    getline(in,str);
-                    numbers=StringUtils::splitStrNum(str);
-                    volumeid=static_cast<int>(numbers[1-1]);
-                    j=static_cast<int>(numbers[8-1]);
-                    if(j>0){
-                        m_VolumesEntityPhyIDs[volumeid-1]=static_cast<int>(numbers[8+j-1]);
-                    }
-                }
+            else{
+                mshPhyGroupDimVec.push_back(phydim);
+                mshPhyGroupIDVec.push_back(phyid);
+                mshPhyGroupNameVec.push_back(phyname);
             }
-            else if(str.find("$Nodes")!=string::npos){
-                // read the nodes' coordinates
-                // node-id, x, y, z
-                vector<int> nodeid;
-                
-                t_celldata.NodesNum=0;
-                getline(in,str); // read the entities
-                numbers=StringUtils::splitStrNum(str);
-                
-                numEntityBlocks=static_cast<int>(numbers[1-1]);
-                numNodes=static_cast<int>(numbers[2-1]);
-                minNodeTag=static_cast<int>(numbers[3-1]);
-                maxNodeTag=static_cast<int>(numbers[4-1]);
-                
-                NodeCoords.resize(3*maxNodeTag,0.0);// here the node id may not be contineous case !!!
-                NodeIDFlag.resize(maxNodeTag,0);
+            if(phydim==mshMaxDim){
+                mshBulkPhyGroupNum+=1;
+            }
+            mshPhyID2NameMap[phyid]=phyname;
+        }// end-of-physical-group-reading
+
+        //**************************************************
+        //*** for the entities
+        //**************************************************
+        m_PointsEntityPhyIDs=reader.getEntityPhyIDs(0);
+        m_CurvesEntityPhyIDS=reader.getEntityPhyIDs(1);
+        m_SurfaceEntityPhyIDs=reader.getEntityPhyIDs(2);
+        m_VolumesEntityPhyIDs=reader.getEntityPhyIDs(3);
+
+        //**************************************************
+        //*** for the nodes' coordinates
+        //**************************************************
+        {
+            numNodes=reader.getNodesNum();
+            minNodeTag=reader.getMinNodeTag();
+            maxNodeTag=reader.getMaxNodeTag();
+            
+            NodeCoords.resize(3*maxNodeTag,0.0);// here the node id may not be contineous case !!!
+            NodeIDFlag.resize(maxNodeTag,0);
 
-                t_celldata.NodesNum=numNodes;
-                
-                double x,y,z;
-                int i,j,numNodesInBlock;
+            t_celldata.NodesNum=numNodes;
+            
+            double x,y,z;
+            int j;
 
-                t_celldata.Xmin=t_celldata.Ymin=t_celldata.Zmin= 1.0e16;
-                t_celldata.Xmax=t_celldata.Ymax=t_celldata.Zmax=-1.0e16;
-                
-                int nNodes=0;
-                for(int nBlock=0;nBlock<numEntityBlocks;nBlock++){
-                    nodeid.clear();
-                    getline(in,str);
-                    numbers=StringUtils::splitStrNum(str);
-                    if(numbers.size()!=4){
-                        MessagePrinter::printErrorTxt("Invalid node entities in your msh4 file inside the $Nodes block");
+            t_celldata.Xmin=t_celldata.Ymin=t_celldata.Zmin= 1.0e16;
+            t_celldata.Xmax=t_celldata.Ymax=t_celldata.Zmax=-1.0e16;
+            
+            int nNodes=0;
+            for(const auto &block:reader.getNodeBlocks()){
+                for(size_t i=0;i<block.m_NodesNum;i++){
+                    j=block.m_NodeTags[i];
+                    if(j<minNodeTag||j>maxNodeTag){
+                        MessagePrinter::printErrorTxt("Invalid node Tag in your msh4 file inside the $Nodes");
                         MessagePrinter::exitAsFem();
                     }
-                    numNodesInBlock=static_cast<int>(numbers[4-1]);
-                    for(i=0;i<numNodesInBlock;i++){
-                        getline(in,str); // read the node id
-                        if(str.size()>1){
-                            if(str.at(str.size()-1)<'0' || str.at(str.size()-1)>'9'){
-                                // Remove the last invalid char, this may come from the msh file generated in different platform.
-                                // In some cases, the last char in this line is not '\n' or ' ', but other unrecognized character.
-                                str.pop_back();
-                            }
-                        }
-                        numbers=StringUtils::splitStrNum(str);
-                        if(numbers.size()<1){
-                            MessagePrinter::printErrorTxt("Can't find a valid node Tag in your msh4 file inside the $Nodes");
-                            MessagePrinter::exitAsFem();
-                        }
-                        if(static_cast<int>(numbers[0])<minNodeTag||static_cast<int>(numbers[0])>maxNodeTag){
-                            MessagePrinter::printErrorTxt("Invalid node Tag in your msh4 file inside the $Nodes");
-                            MessagePrinter::exitAsFem();
-                        }
-                        else{
-                            nodeid.push_back(static_cast<int>(numbers[0]));// store the node id
-                        }
-                    }
-                    for(i=0;i<numNodesInBlock;i++){
-                        getline(in,str);
-                        numbers=StringUtils::splitStrNum(str);
-                        if(numbers.size()!=3){
-                            MessagePrinter::printErrorTxt("Invalid node coordinates information in your msh4 file inside the $Nodes block");
-                            MessagePrinter::exitAsFem();
-                        }
-                        x=numbers[0];y=numbers[1];z=numbers[2];
-                        j=nodeid[i];
-                        NodeCoords[(j-1)*3+0]=x;
-                        NodeCoords[(j-1)*3+1]=y;
-                        NodeCoords[(j-1)*3+2]=z;
-                        nNodes+=1;
-                        NodeIDFlag[j-1]=1;
-
-                        if(x>t_celldata.Xmax) t_celldata.Xmax=x;
-                        if(x<t_celldata.Xmin) t_celldata.Xmin=x;
-                        if(y>t_celldata.Ymax) t_celldata.Ymax=y;
-                        if(y<t_celldata.Ymin) t_celldata.Ymin=y;
-                        if(z>t_celldata.Zmax) t_celldata.Zmax=z;
-                        if(z<t_celldata.Zmin) t_celldata.Zmin=z;
-                    } // end-of-nodes-block-reading
-                } // end-of-block-reading
-                
-                if(nNodes!=numNodes){
-                    MessagePrinter::printErrorTxt("Something is wrong in your msh4 file inside the $Nodes block, nodes numer is not match with the first line");
-                    MessagePrinter::exitAsFem();
-                }
-            }// end-of-node-coordinates-reading
-            else if(str.find("$Elements")!=string::npos){
-                vector<int> tempconn;
-                int elmtid,nodeid,phyid,entityTag,elmttype,vtktype;
-                int nodes,entityDim,elmtorder;
-                string meshtypename;
-                MeshType meshtype;
-
-                SingleMeshCell TempCell;
-                
-                numEntityBlocks=0;
-                numElements=0;
-                minElementTag=0;
-                maxElementTag=0;
-                numElementsInBlock=0;
-
-                t_celldata.LineElmtMeshType=MeshType::EDGE2;
-                t_celldata.SurfElmtMeshType=MeshType::TRI3;
-
-                PointElmtsNum=0;
-                t_celldata.LineElmtsNum=0;
-                t_celldata.SurfElmtsNum=0;
-                t_celldata.BulkElmtsNum=0;
-                t_celldata.ElmtsNum=0;
-                
-                getline(in,str);// read the element total entities
-                numbers=StringUtils::splitStrNum(str);
-                if(numbers.size()!=4){
-                    //numEntityBlocks(size_t) numElements(size_t) minElementTag(size_t) maxElementTag(size_t)
-                    MessagePrinter::printErrorTxt("Invalid element entities in your msh4 file inside the $Elements");
-                    MessagePrinter::exitAsFem();
-                }
-                
-                numEntityBlocks=static_cast<int>(numbers[1-1]);
-                numElements=static_cast<int>(numbers[2-1]);
-                minElementTag=static_cast<int>(numbers[3-1]);
-                maxElementTag=static_cast<int>(numbers[4-1]);
-
-                t_celldata.ElmtsNum=numElements;
-                ElmtPhyIDVec.resize(maxElementTag,0);
-                ElmtDimVec.resize(maxElementTag,0);
-                ElmtConn.resize(maxElementTag);
-                ElmtIDFlag.resize(maxElementTag,0);
-                
-                mshBulkElmtUniquePhyIDVec.clear();
+                    x=block.m_Coords[3*i+0];y=block.m_Coords[3*i+1];z=block.m_Coords[3*i+2];
+                    NodeCoords[(j-1)*3+0]=x;
+                    NodeCoords[(j-1)*3+1]=y;
+                    NodeCoords[(j-1)*3+2]=z;
+                    nNodes+=1;
+                    NodeIDFlag[j-1]=1;
+
+                    if(x>t_celldata.Xmax) t_celldata.Xmax=x;
+                    if(x<t_celldata.Xmin) t_celldata.Xmin=x;
+                    if(y>t_celldata.Ymax) t_celldata.Ymax=y;
+                    if(y<t_celldata.Ymin) t_celldata.Ymin=y;
+                    if(z>t_celldata.Zmax) t_celldata.Zmax=z;
+                    if(z<t_celldata.Zmin) t_celldata.Zmin=z;
+                } // end-of-nodes-block-reading
+            } // end-of-block-reading
+            
+            if(nNodes!=numNodes){
+                MessagePrinter::printErrorTxt("Something is wrong in your msh4 file inside the $Nodes block, nodes numer is not match with the first line");
+                MessagePrinter::exitAsFem();
+            }
+        }// end-of-node-coordinates-reading
+
+        //**************************************************
+        //*** for the elements
+        //**************************************************
+        {
+            vector<int> tempconn;
+            int elmtid,nodeid,phyid,entityTag,elmttype,vtktype;
+            int nodes,entityDim,elmtorder;
+            string meshtypename;
+            MeshType meshtype;
+
+            SingleMeshCell TempCell;
+
+            t_celldata.LineElmtMeshType=MeshType::EDGE2;
+            t_celldata.SurfElmtMeshType=MeshType::TRI3;
+
+            PointElmtsNum=0;
+            t_celldata.LineElmtsNum=0;
+            t_celldata.SurfElmtsNum=0;
+            t_celldata.BulkElmtsNum=0;
+            t_celldata.ElmtsNum=0;
+            
+            numElements=reader.getElmtsNum();
+            minElementTag=reader.getMinElmtTag();
+            maxElementTag=reader.getMaxElmtTag();
+
+            t_celldata.ElmtsNum=numElements;
+            ElmtPhyIDVec.resize(maxElementTag,0);
+            ElmtDimVec.resize(maxElementTag,0);
+            ElmtConn.resize(maxElementTag);
+            ElmtIDFlag.resize(maxElementTag,0);
+            
+            mshBulkElmtUniquePhyIDVec.clear();
 
-                t_celldata.MinDim=10;
+            t_celldata.MinDim=10;
 
-                TempCellVec.clear();
-                BulkCellVec.clear();
+            TempCellVec.clear();
+            BulkCellVec.clear();
+            TempCellVec.reserve(numElements);
+            
+            for(const auto &block:reader.getElmtBlocks()){
+                entityDim=block.m_EntityDim;
+                entityTag=block.m_EntityTag;
+                elmttype=block.m_ElmtType;
+                phyid=getPhysicalIDViaEntityTag(entityDim,entityTag);
+                vtktype=MshFileUtils::getElmtVTKCellTypeFromElmtType(elmttype);
+                meshtype=MshFileUtils::getElmtMeshTypeFromElmtType(elmttype);
+                elmtorder=MshFileUtils::getElmtOrderFromElmtType(elmttype);
+                nodes=block.m_NodesPerElmt;
+                meshtypename=MshFileUtils::getElmtMeshTypeNameFromElmtType(elmttype);
                 
-                for(int block=0;block<numEntityBlocks;block++){
-                    getline(in,str);//get current element entities
-                    //entityDim(int) entityTag(int) elementType(int; see below) numElementsInBlock(size_t)
-                    numbers=StringUtils::splitStrNum(str);
-                    if(numbers.size()!=4){
-                        MessagePrinter::printErrorTxt("Invalid element entities for current element in your msh4 file inside the $Elements");
+                for(size_t i=0;i<block.m_ElmtsNum;i++){
+                    elmtid=block.m_ElmtTags[i];
+                    if(elmtid<minElementTag||elmtid>maxElementTag){
+                        MessagePrinter::printErrorTxt("Invalid element Tag in your msh4 file inside the $Elements");
                         MessagePrinter::exitAsFem();
                     }
                     
-                    entityDim=static_cast<int>(numbers[1-1]);
-                    entityTag=static_cast<int>(numbers[2-1]);
-                    elmttype=static_cast<int>(numbers[3-1]);
-                    numElementsInBlock=static_cast<int>(numbers[4-1]);
-                    phyid=getPhysicalIDViaEntityTag(entityDim,entityTag);
-                    vtktype=MshFileUtils::getElmtVTKCellTypeFromElmtType(elmttype);
-                    meshtype=MshFileUtils::getElmtMeshTypeFromElmtType(elmttype);
-                    elmtorder=MshFileUtils::getElmtOrderFromElmtType(elmttype);
-                    nodes=MshFileUtils::getElmtNodesNumFromElmtType(elmttype);
-                    meshtypename=MshFileUtils::getElmtMeshTypeNameFromElmtType(elmttype);
+                    ElmtIDFlag[elmtid-1]=1;
+                    ElmtDimVec[elmtid-1]=entityDim;
+                    ElmtPhyIDVec[elmtid-1]=phyid;
+                    tempconn.assign(block.m_Conn.begin()+i*nodes,block.m_Conn.begin()+(i+1)*nodes);
+                    MshFileUtils::reorderNodesIndex(elmttype,tempconn);
+                    ElmtConn[elmtid-1]=tempconn;
+
+                    if(entityDim<t_celldata.MinDim) t_celldata.MinDim=entityDim;
                     
-                    for(int i=0;i<numElementsInBlock;i++){
-                        getline(in,str);
-                        numbers=StringUtils::splitStrNum(str);
-                        nodes=static_cast<int>(numbers.size()-1);
-                        elmtid=static_cast<int>(numbers[1-1]);
-                        if(elmtid<minElementTag||elmtid>maxElementTag){
-                            MessagePrinter::printErrorTxt("Invalid element Tag in your msh4 file inside the $Elements");
-                            MessagePrinter::exitAsFem();
+                    if(entityDim==0 && entityDim<mshMaxDim){
+                        PointElmtsNum+=1;
+
+                        TempCell.Dim=0;
+                        TempCell.NodesNumPerElmt=nodes;
+                        TempCell.VTKCellType=vtktype;
+
+                        TempCell.ElmtConn.clear();
+                        TempCell.ElmtNodeCoords0.resize(nodes);
+                        for(int k=0;k<nodes;k++){
+                            nodeid=tempconn[k];
+                            TempCell.ElmtConn.push_back(nodeid);
+                            TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
+                            TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
+                            TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
                         }
-                        
-                        ElmtIDFlag[elmtid-1]=1;
-                        ElmtDimVec[elmtid-1]=entityDim;
-                        ElmtPhyIDVec[elmtid-1]=phyid;
-                        tempconn.resize(nodes);
-                        for(int j=1;j<=nodes;j++){
-                            tempconn[j-1]=static_cast<int>(numbers[j]);
-                        }
-                        
-                        MshFileUtils::reorderNodesIndex(elmttype,tempconn);
-                        ElmtConn[elmtid-1]=tempconn;
+                        TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
 
-                        if(entityDim<t_celldata.MinDim) t_celldata.MinDim=entityDim;
-                        
-                        if(entityDim==0 && entityDim<mshMaxDim){
-                            PointElmtsNum+=1;
-
-                            TempCell.Dim=0;
-                            TempCell.NodesNumPerElmt=nodes;
-                            TempCell.VTKCellType=vtktype;
-
-                            TempCell.ElmtConn.clear();
-                            TempCell.ElmtNodeCoords0.resize(nodes);
-                            for(int k=0;k<nodes;k++){
-                                nodeid=tempconn[k];
-                                TempCell.ElmtConn.push_back(nodeid);
-                                TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
-                                TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
-                                TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
-                            }
-                            TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
-
-                            TempCellVec.push_back(TempCell);
+                        TempCellVec.push_back(TempCell);
+                    }
+                    if(entityDim==1 && entityDim<mshMaxDim){
+                        t_celldata.LineElmtsNum+=1;
+                        t_celldata.NodesNumPerLineElmt=nodes;
+                        t_celldata.LineElmtMeshType=meshtype;
+
+                        TempCell.Dim=1;
+                        TempCell.NodesNumPerElmt=nodes;
+                        TempCell.VTKCellType=vtktype;
+
+                        TempCell.ElmtConn.clear();
+                        TempCell.ElmtNodeCoords0.resize(nodes);
+                        for(int k=0;k<nodes;k++){
+                            nodeid=tempconn[k];
+                            TempCell.ElmtConn.push_back(nodeid);
+                            TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
+                            TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
+                            TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
                         }
-                        if(entityDim==1 && entityDim<mshMaxDim){
-                            t_celldata.LineElmtsNum+=1;
-                            t_celldata.NodesNumPerLineElmt=nodes;
-                            t_celldata.LineElmtMeshType=meshtype;
-
-                            TempCell.Dim=1;
-                            TempCell.NodesNumPerElmt=nodes;
-                            TempCell.VTKCellType=vtktype;
-
-                            TempCell.ElmtConn.clear();
-                            TempCell.ElmtNodeCoords0.resize(nodes);
-                            for(int k=0;k<nodes;k++){
-                                nodeid=tempconn[k];
-                                TempCell.ElmtConn.push_back(nodeid);
-                                TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
-                                TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
-                                TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
-                            }
-                            TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
+                        TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
 
-                            TempCellVec.push_back(TempCell);
+                        TempCellVec.push_back(TempCell);
+                    }
+                    
+                    if(entityDim==2 && entityDim<mshMaxDim){
+                        t_celldata.SurfElmtsNum+=1;
+                        t_celldata.NodesNumPerSurfElmt=nodes;
+                        t_celldata.SurfElmtMeshType=meshtype;
+                        //
+                        TempCell.Dim=2;
+                        TempCell.NodesNumPerElmt=nodes;
+                        TempCell.VTKCellType=vtktype;
+
+                        TempCell.ElmtConn.clear();
+                        TempCell.ElmtNodeCoords0.resize(nodes);
+                        for(int k=0;k<nodes;k++){
+                            nodeid=tempconn[k];
+                            TempCell.ElmtConn.push_back(nodeid);
+                            TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
+                            TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
+                            TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
                         }
-                        
-                        if(entityDim==2 && entityDim<mshMaxDim){
-                            t_celldata.SurfElmtsNum+=1;
-                            t_celldata.NodesNumPerSurfElmt=nodes;
-                            t_celldata.SurfElmtMeshType=meshtype;
-                            //
-                            TempCell.Dim=2;
-                            TempCell.NodesNumPerElmt=nodes;
-                            TempCell.VTKCellType=vtktype;
-
-                            TempCell.ElmtConn.clear();
-                            TempCell.ElmtNodeCoords0.resize(nodes);
-                            for(int k=0;k<nodes;k++){
-                                nodeid=tempconn[k];
-                                TempCell.ElmtConn.push_back(nodeid);
-                                TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
-                                TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
-                                TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
-                            }
-                            TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
+                        TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
 
-                            TempCellVec.push_back(TempCell);
+                        TempCellVec.push_back(TempCell);
+                    }
+                    if(entityDim==mshMaxDim){
+                        t_celldata.BulkElmtsNum+=1;
+                        t_celldata.MeshOrder=elmtorder;
+                        t_celldata.BulkElmtMeshType=meshtype;
+                        t_celldata.BulkElmtVTKCellType=vtktype;
+                        t_celldata.BulkMeshTypeName=meshtypename;
+                        t_celldata.BulkMeshTypeName=meshtypename;
+                        t_celldata.NodesNumPerBulkElmt=nodes;
+                        
+                        mshBulkElmtUniquePhyIDVec.push_back(phyid);
+
+                        TempCell.Dim=mshMaxDim;
+                        TempCell.NodesNumPerElmt=nodes;
+                        TempCell.VTKCellType=vtktype;
+                        TempCell.CellMeshType=meshtype;
+
+                        TempCell.ElmtConn.clear();
+                        TempCell.ElmtNodeCoords0.resize(nodes);
+                        for(int k=0;k<nodes;k++){
+                            nodeid=tempconn[k];
+                            TempCell.ElmtConn.push_back(nodeid);
+                            TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
+                            TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
+                            TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
                         }
-                        if(entityDim==mshMaxDim){
-                            t_celldata.BulkElmtsNum+=1;
-                            t_celldata.MeshOrder=elmtorder;
-                            t_celldata.BulkElmtMeshType=meshtype;
-                            t_celldata.BulkElmtVTKCellType=vtktype;
-                            t_celldata.BulkMeshTypeName=meshtypename;
-                            t_celldata.BulkMeshTypeName=meshtypename;
-                            t_celldata.NodesNumPerBulkElmt=nodes;
-                            
-                            mshBulkElmtUniquePhyIDVec.push_back(phyid);
-
-                            TempCell.Dim=mshMaxDim;
-                            TempCell.NodesNumPerElmt=nodes;
-                            TempCell.VTKCellType=vtktype;
-                            TempCell.CellMeshType=meshtype;
-
-                            TempCell.ElmtConn.clear();
-                            TempCell.ElmtNodeCoords0.resize(nodes);
-                            for(int k=0;k<nodes;k++){
-                                nodeid=tempconn[k];
-                                TempCell.ElmtConn.push_back(nodeid);
-                                TempCell.ElmtNodeCoords0(k+1,1)=NodeCoords[(nodeid-1)*3+1-1];
-                                TempCell.ElmtNodeCoords0(k+1,2)=NodeCoords[(nodeid-1)*3+2-1];
-                                TempCell.ElmtNodeCoords0(k+1,3)=NodeCoords[(nodeid-1)*3+3-1];
-                            }
-                            TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
+                        TempCell.ElmtNodeCoords=TempCell.ElmtNodeCoords0;
 
-                            TempCellVec.push_back(TempCell);
-                            BulkCellVec.push_back(TempCell);
-                        }
-                    } // end-of-element-in-block-reading
-                } // end-of-element-block-loop
-                
-                // before we jump out, we should check the consistency between different elements
-                if(PointElmtsNum
-                  +t_celldata.LineElmtsNum
-                  +t_celldata.SurfElmtsNum
-                  +t_celldata.BulkElmtsNum!=numElements){
-                    MessagePrinter::printErrorTxt("The elements number dosen\'t match with the total one, please check your msh(2) file");
-                    return false;
-                }
-            } // end-of-element-reading
-        }// end-of-msh-file-reading
-        in.close();
+                        TempCellVec.push_back(TempCell);
+                        BulkCellVec.push_back(TempCell);
+                    }
+                } // end-of-element-in-block-reading
+            } // end-of-element-block-loop
+            
+            // before we jump out, we should check the consistency between different elements
+            if(PointElmtsNum
+              +t_celldata.LineElmtsNum
+              +t_celldata.SurfElmtsNum
+              +t_celldata.BulkElmtsNum!=numElements){
+                MessagePrinter::printErrorTxt("The elements number dosen\'t match with the total one, please check your msh(2) file");
+                return false;
+            }
+        } // end-of-element-reading
 
         //**********************************************************************************
         //*** now we re-arrange the node id and element id, to make them to be continue
@@ -1035,21 +853,21 @@ bool Msh4File2FECellImporter::importMeshFile(const string &filename,FECellData &
     /**
      * Share some common variables among ranks
      */
-    MPI_Bcast(&t_celldata.MeshOrder,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.MeshOrder,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.BulkElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.LineElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.SurfElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.ElmtsNum,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.BulkElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.LineElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.SurfElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.ElmtsNum,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.NodesNum,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerBulkElmt,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerSurfElmt,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.NodesNumPerLineElmt,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNum,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerBulkElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerSurfElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.NodesNumPerLineElmt,1,MPI_INT,0,PETSC_COMM_WORLD);
 
-    MPI_Bcast(&t_celldata.BulkElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.SurfElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
-    MPI_Bcast(&t_celldata.LineElmtVTKCellType,1,MPI_INT,0,MPI_COMM_WORLD);
+    MPI_Bcast(&t_celldata.BulkElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.SurfElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
+    MPI_Bcast(&t_celldata.LineElmtVTKCellType,1,MPI_INT,0,PETSC_COMM_WORLD);
 
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,581 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.02
+//+++ Purpose: the memory-mapped reader of the msh (version-4.1)
+//+++          file, both ascii and binary format are supported
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cstring>
+#include <cstdlib>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "FECell/Msh4FileReader.h"
+#include "FECell/MshFileUtils.h"
+
+namespace{
+    /**
+     * skip the separators (and any other invalid char) before the next number
+     */
+    inline const char* skipToNumber(const char *p,const char *end){
+        while(p<end && !((*p>='0'&&*p<='9')||*p=='-'||*p=='.')) ++p;
+        return p;
+    }
+    inline bool parseAsciiLong(const char *&p,const char *end,long long &value){
+        p=skipToNumber(p,end);
+        auto result=std::from_chars(p,end,value);
+        if(result.ec!=std::errc()) return false;
+        p=result.ptr;
+        return true;
+    }
+    inline bool parseAsciiDouble(const char *&p,const char *end,double &value){
+        p=skipToNumber(p,end);
+        char *q;
+        value=std::strtod(p,&q);
+        if(q==p) return false;
+        p=q;
+        return true;
+    }
+    inline const char* nextLine(const char *p,const char *end){
+        const char *nl=static_cast<const char*>(std::memchr(p,'\n',end-p));
+        return nl?nl+1:end;
+    }
+    inline size_t readBinarySizeT(const char *p,const int &datasize){
+        if(datasize==4){
+            unsigned int v;
+            std::memcpy(&v,p,4);
+            return static_cast<size_t>(v);
+        }
+        unsigned long long v;
+        std::memcpy(&v,p,8);
+        return static_cast<size_t>(v);
+    }
+
+    /**
+     * the parsing task of the worker threads
+     */
+    struct ParseTask{
+        int m_Kind;// 0-> node tags, 1-> node coordinates, 2-> elements
+        size_t m_Block;
+        size_t m_First;
+        size_t m_Count;
+        size_t m_Offset;
+    };
+}
+
+Msh4FileReader::Msh4FileReader(){
+    m_Data=nullptr;
+    m_Size=0;
+    m_Pos=0;
+    m_FileDescriptor=-1;
+    m_Version=0.0;
+    m_IsBinary=false;
+    m_DataSize=8;
+    m_HasNodes=false;
+    m_HasElmts=false;
+    m_NodesNum=0;m_MinNodeTag=0;m_MaxNodeTag=0;
+    m_ElmtsNum=0;m_MinElmtTag=0;m_MaxElmtTag=0;
+}
+Msh4FileReader::~Msh4FileReader(){
+    releaseMemory();
+}
+//**********************************************************
+bool Msh4FileReader::mapFile(const string &filename){
+#ifndef _WIN32
+    m_FileDescriptor=open(filename.c_str(),O_RDONLY);
+    if(m_FileDescriptor>=0){
+        struct stat st;
+        if(fstat(m_FileDescriptor,&st)==0 && st.st_size>0){
+            void *ptr=mmap(nullptr,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,m_FileDescriptor,0);
+            if(ptr!=MAP_FAILED){
+                madvise(ptr,static_cast<size_t>(st.st_size),MADV_SEQUENTIAL);
+                m_Data=static_cast<const char*>(ptr);
+                m_Size=static_cast<size_t>(st.st_size);
+                return true;
+            }
+        }
+        close(m_FileDescriptor);
+        m_FileDescriptor=-1;
+    }
+#endif
+    // fall back to the plain file reading
+    std::ifstream in(filename.c_str(),std::ios::in|std::ios::binary);
+    if(!in.is_open()){
+        return false;
+    }
+    in.seekg(0,std::ios::end);
+    m_Buffer.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0,std::ios::beg);
+    in.read(m_Buffer.data(),static_cast<std::streamsize>(m_Buffer.size()));
+    in.close();
+    m_Data=m_Buffer.data();
+    m_Size=m_Buffer.size();
+    return m_Size>0;
+}
+void Msh4FileReader::unmapFile(){
+#ifndef _WIN32
+    if(m_FileDescriptor>=0){
+        munmap(const_cast<char*>(m_Data),m_Size);
+        close(m_FileDescriptor);
+        m_FileDescriptor=-1;
+    }
+#endif
+    m_Buffer.clear();
+    m_Buffer.shrink_to_fit();
+    m_Data=nullptr;
+    m_Size=0;
+    m_Pos=0;
+}
+void Msh4FileReader::releaseMemory(){
+    unmapFile();
+    m_PhysicalNames.clear();
+    for(int i=0;i<4;i++) m_EntityPhyIDs[i].clear();
+    m_NodeBlocks.clear();
+    m_ElmtBlocks.clear();
+}
+//**********************************************************
+bool Msh4FileReader::readLine(string &line){
+    if(m_Pos>=m_Size) return false;
+    const char *begin=m_Data+m_Pos;
+    const char *end=nextLine(begin,m_Data+m_Size);
+    size_t len=end-begin;
+    while(len>0 && (begin[len-1]=='\n'||begin[len-1]=='\r')) len-=1;
+    line.assign(begin,len);
+    m_Pos=end-m_Data;
+    return true;
+}
+void Msh4FileReader::skipLine(){
+    m_Pos=nextLine(m_Data+m_Pos,m_Data+m_Size)-m_Data;
+}
+bool Msh4FileReader::skipSection(const string &name){
+    const string endtag="$End"+name;
+    const char *p=std::search(m_Data+m_Pos,m_Data+m_Size,endtag.begin(),endtag.end());
+    if(p==m_Data+m_Size) return false;
+    m_Pos=p-m_Data;
+    skipLine();
+    return true;
+}
+size_t Msh4FileReader::readSizeT(){
+    if(m_IsBinary){
+        if(m_Pos+m_DataSize>m_Size) return 0;
+        size_t v=readBinarySizeT(m_Data+m_Pos,m_DataSize);
+        m_Pos+=m_DataSize;
+        return v;
+    }
+    long long v=0;
+    const char *p=m_Data+m_Pos;
+    parseAsciiLong(p,m_Data+m_Size,v);
+    m_Pos=p-m_Data;
+    return static_cast<size_t>(v);
+}
+int Msh4FileReader::readInt(){
+    if(m_IsBinary){
+        if(m_Pos+sizeof(int)>m_Size) return 0;
+        int v;
+        std::memcpy(&v,m_Data+m_Pos,sizeof(int));
+        m_Pos+=sizeof(int);
+        return v;
+    }
+    long long v=0;
+    const char *p=m_Data+m_Pos;
+    parseAsciiLong(p,m_Data+m_Size,v);
+    m_Pos=p-m_Data;
+    return static_cast<int>(v);
+}
+double Msh4FileReader::readDouble(){
+    if(m_IsBinary){
+        if(m_Pos+sizeof(double)>m_Size) return 0.0;
+        double v;
+        std::memcpy(&v,m_Data+m_Pos,sizeof(double));
+        m_Pos+=sizeof(double);
+        return v;
+    }
+    double v=0.0;
+    const char *p=m_Data+m_Pos;
+    parseAsciiDouble(p,m_Data+m_Size,v);
+    m_Pos=p-m_Data;
+    return v;
+}
+//**********************************************************
+bool Msh4FileReader::readMeshFormat(){
+    string line;
+    int filetype;
+    readLine(line);
+    std::istringstream ss(line);
+    if(!(ss>>m_Version>>filetype>>m_DataSize)){
+        MessagePrinter::printErrorTxt("Invalid $MeshFormat block in your msh4 file");
+        return false;
+    }
+    m_IsBinary=(filetype==1);
+    if(m_DataSize!=4 && m_DataSize!=8){
+        MessagePrinter::printErrorTxt("data-size="+to_string(m_DataSize)+" is not supported by the msh4 importer");
+        return false;
+    }
+    if(m_IsBinary){
+        if(m_Version<4.1){
+            MessagePrinter::printErrorTxt("binary msh file is only supported for version>=4.1, please re-export your mesh");
+            return false;
+        }
+        int one;
+        if(m_Pos+sizeof(int)>m_Size){
+            MessagePrinter::printErrorTxt("Invalid $MeshFormat block in your binary msh4 file");
+            return false;
+        }
+        std::memcpy(&one,m_Data+m_Pos,sizeof(int));
+        if(one!=1){
+            MessagePrinter::printErrorTxt("the endianness of your binary msh4 file is different from the current machine, please re-export it in ascii format");
+            return false;
+        }
+        m_Pos+=sizeof(int);
+    }
+    return skipSection("MeshFormat");
+}
+//**********************************************************
+bool Msh4FileReader::readPhysicalNames(){
+    // this section is always in ascii format
+    string line;
+    readLine(line);
+    int num=std::atoi(line.c_str());
+    m_PhysicalNames.resize(num);
+    for(int i=0;i<num;i++){
+        if(!readLine(line)){
+            MessagePrinter::printErrorTxt("Invalid $PhysicalNames block in your msh4 file");
+            return false;
+        }
+        std::istringstream ss(line);
+        ss>>m_PhysicalNames[i].m_Dim>>m_PhysicalNames[i].m_ID;
+        size_t first=line.find('"'),last=line.rfind('"');
+        if(first!=string::npos && last>first){
+            m_PhysicalNames[i].m_Name=line.substr(first+1,last-first-1);
+        }
+        else{
+            ss>>m_PhysicalNames[i].m_Name;
+        }
+    }
+    return skipSection("PhysicalNames");
+}
+//**********************************************************
+bool Msh4FileReader::readEntities(){
+    size_t nums[4];
+    for(int dim=0;dim<4;dim++) nums[dim]=readSizeT();
+
+    int tag,phyid;
+    size_t nphys,nbounds;
+    for(int dim=0;dim<4;dim++){
+        vector<std::pair<int,int>> tag2phy;
+        int maxtag=0;
+        for(size_t i=0;i<nums[dim];i++){
+            tag=readInt();
+            // points have x,y,z (only in 4.1), the others have their bounding box
+            const int ncoords=(dim==0&&m_Version>=4.1)?3:6;
+            for(int k=0;k<ncoords;k++) readDouble();
+            nphys=readSizeT();
+            phyid=0;
+            for(size_t k=0;k<nphys;k++){
+                int id=readInt();
+                // points use the first physical tag, the others use the last one
+                if(dim>0||k==0) phyid=id;
+            }
+            if(dim>0){
+                nbounds=readSizeT();
+                for(size_t k=0;k<nbounds;k++) readInt();
+            }
+            if(tag<1){
+                MessagePrinter::printErrorTxt("Invalid entity tag="+to_string(tag)+" in your msh4 file inside the $Entities");
+                return false;
+            }
+            if(tag>maxtag) maxtag=tag;
+            tag2phy.push_back(std::make_pair(tag,phyid));
+        }
+        m_EntityPhyIDs[dim].assign(maxtag,0);
+        for(const auto &it:tag2phy) m_EntityPhyIDs[dim][it.first-1]=it.second;
+    }
+    if(m_Pos>m_Size){
+        MessagePrinter::printErrorTxt("Invalid $Entities block in your msh4 file");
+        return false;
+    }
+    return skipSection("Entities");
+}
+//**********************************************************
+bool Msh4FileReader::readNodes(){
+    const size_t nblocks=readSizeT();
+    m_NodesNum=static_cast<int>(readSizeT());
+    m_MinNodeTag=static_cast<int>(readSizeT());
+    m_MaxNodeTag=static_cast<int>(readSizeT());
+    if(!m_IsBinary) skipLine();
+
+    m_NodeBlocks.resize(nblocks);
+    for(auto &block:m_NodeBlocks){
+        block.m_EntityDim=readInt();
+        block.m_EntityTag=readInt();
+        block.m_Parametric=readInt();
+        block.m_NodesNum=readSizeT();
+        if(m_IsBinary){
+            block.m_TagsOffset=m_Pos;
+            m_Pos+=block.m_NodesNum*m_DataSize;
+            block.m_CoordsOffset=m_Pos;
+            m_Pos+=block.m_NodesNum*(3+(block.m_Parametric?block.m_EntityDim:0))*sizeof(double);
+        }
+        else{
+            // record the beginning of each chunk, then the chunks can be parsed independently
+            skipLine();
+            block.m_TagsOffset=m_Pos;
+            for(size_t i=0;i<block.m_NodesNum;i++){
+                if(i%m_ChunkSize==0) block.m_TagsChunkOffsets.push_back(m_Pos);
+                skipLine();
+            }
+            block.m_CoordsOffset=m_Pos;
+            for(size_t i=0;i<block.m_NodesNum;i++){
+                if(i%m_ChunkSize==0) block.m_CoordsChunkOffsets.push_back(m_Pos);
+                skipLine();
+            }
+        }
+        if(m_Pos>m_Size){
+            MessagePrinter::printErrorTxt("Invalid node entities in your msh4 file inside the $Nodes block, the file may be truncated");
+            return false;
+        }
+    }
+    m_HasNodes=true;
+    return skipSection("Nodes");
+}
+//**********************************************************
+bool Msh4FileReader::readElements(){
+    const size_t nblocks=readSizeT();
+    m_ElmtsNum=static_cast<int>(readSizeT());
+    m_MinElmtTag=static_cast<int>(readSizeT());
+    m_MaxElmtTag=static_cast<int>(readSizeT());
+    if(!m_IsBinary) skipLine();
+
+    m_ElmtBlocks.resize(nblocks);
+    for(auto &block:m_ElmtBlocks){
+        block.m_EntityDim=readInt();
+        block.m_EntityTag=readInt();
+        block.m_ElmtType=readInt();
+        block.m_ElmtsNum=readSizeT();
+        block.m_NodesPerElmt=MshFileUtils::getElmtNodesNumFromElmtType(block.m_ElmtType);
+        if(m_IsBinary){
+            block.m_Offset=m_Pos;
+            m_Pos+=block.m_ElmtsNum*(1+block.m_NodesPerElmt)*m_DataSize;
+        }
+        else{
+            skipLine();
+            block.m_Offset=m_Pos;
+            for(size_t i=0;i<block.m_ElmtsNum;i++){
+                if(i%m_ChunkSize==0) block.m_ChunkOffsets.push_back(m_Pos);
+                skipLine();
+            }
+        }
+        if(m_Pos>m_Size){
+            MessagePrinter::printErrorTxt("Invalid element entities in your msh4 file inside the $Elements, the file may be truncated");
+            return false;
+        }
+    }
+    m_HasElmts=true;
+    return skipSection("Elements");
+}
+//**********************************************************
+bool Msh4FileReader::parseBlocks(const int &nthreads){
+    vector<ParseTask> tasks;
+    size_t nchunks,first,count;
+    for(size_t b=0;b<m_NodeBlocks.size();b++){
+        auto &block=m_NodeBlocks[b];
+        block.m_NodeTags.resize(block.m_NodesNum);
+        block.m_Coords.resize(3*block.m_NodesNum);
+        nchunks=(block.m_NodesNum+m_ChunkSize-1)/m_ChunkSize;
+        for(size_t c=0;c<nchunks;c++){
+            first=c*m_ChunkSize;
+            count=std::min(m_ChunkSize,block.m_NodesNum-first);
+            if(m_IsBinary){
+                tasks.push_back({0,b,first,count,block.m_TagsOffset+first*m_DataSize});
+                tasks.push_back({1,b,first,count,block.m_CoordsOffset+first*(3+(block.m_Parametric?block.m_EntityDim:0))*sizeof(double)});
+            }
+            else{
+                tasks.push_back({0,b,first,count,block.m_TagsChunkOffsets[c]});
+                tasks.push_back({1,b,first,count,block.m_CoordsChunkOffsets[c]});
+            }
+        }
+    }
+    for(size_t b=0;b<m_ElmtBlocks.size();b++){
+        auto &block=m_ElmtBlocks[b];
+        block.m_ElmtTags.resize(block.m_ElmtsNum);
+        block.m_Conn.resize(block.m_ElmtsNum*block.m_NodesPerElmt);
+        nchunks=(block.m_ElmtsNum+m_ChunkSize-1)/m_ChunkSize;
+        for(size_t c=0;c<nchunks;c++){
+            first=c*m_ChunkSize;
+            count=std::min(m_ChunkSize,block.m_ElmtsNum-first);
+            if(m_IsBinary){
+                tasks.push_back({2,b,first,count,block.m_Offset+first*(1+block.m_NodesPerElmt)*m_DataSize});
+            }
+            else{
+                tasks.push_back({2,b,first,count,block.m_ChunkOffsets[c]});
+            }
+        }
+    }
+
+    // each task only writes to its own range of the pre-allocated block arrays, so no lock is needed
+    std::atomic<size_t> next(0);
+    std::atomic<int> failedkind(-1);
+    const char *end=m_Data+m_Size;
+    auto worker=[&](){
+        size_t t;
+        while((t=next.fetch_add(1))<tasks.size()){
+            const ParseTask &task=tasks[t];
+            const char *p=m_Data+task.m_Offset;
+            bool ok=true;
+            if(task.m_Kind==0){
+                auto &block=m_NodeBlocks[task.m_Block];
+                long long v;
+                for(size_t i=task.m_First;i<task.m_First+task.m_Count&&ok;i++){
+                    if(m_IsBinary){
+                        block.m_NodeTags[i]=static_cast<int>(readBinarySizeT(p,m_DataSize));
+                        p+=m_DataSize;
+                    }
+                    else{
+                        ok=parseAsciiLong(p,end,v);
+                        block.m_NodeTags[i]=static_cast<int>(v);
+                    }
+                }
+            }
+            else if(task.m_Kind==1){
+                auto &block=m_NodeBlocks[task.m_Block];
+                const int nparams=block.m_Parametric?block.m_EntityDim:0;
+                for(size_t i=task.m_First;i<task.m_First+task.m_Count&&ok;i++){
+                    if(m_IsBinary){
+                        std::memcpy(&block.m_Coords[3*i],p,3*sizeof(double));
+                        p+=(3+nparams)*sizeof(double);
+                    }
+                    else{
+                        ok=parseAsciiDouble(p,end,block.m_Coords[3*i+0])&&
+                           parseAsciiDouble(p,end,block.m_Coords[3*i+1])&&
+                           parseAsciiDouble(p,end,block.m_Coords[3*i+2]);
+                        p=nextLine(p,end);// skip the parametric coordinates if any
+                    }
+                }
+            }
+            else{
+                auto &block=m_ElmtBlocks[task.m_Block];
+                const int npe=block.m_NodesPerElmt;
+                long long v;
+                for(size_t i=task.m_First;i<task.m_First+task.m_Count&&ok;i++){
+                    if(m_IsBinary){
+                        block.m_ElmtTags[i]=static_cast<int>(readBinarySizeT(p,m_DataSize));
+                        p+=m_DataSize;
+                        for(int j=0;j<npe;j++){
+                            block.m_Conn[i*npe+j]=static_cast<int>(readBinarySizeT(p,m_DataSize));
+                            p+=m_DataSize;
+                        }
+                    }
+                    else{
+                        ok=parseAsciiLong(p,end,v);
+                        block.m_ElmtTags[i]=static_cast<int>(v);
+                        for(int j=0;j<npe&&ok;j++){
+                            ok=parseAsciiLong(p,end,v);
+                            block.m_Conn[i*npe+j]=static_cast<int>(v);
+                        }
+                        p=nextLine(p,end);
+                    }
+                }
+            }
+            if(!ok) failedkind.store(task.m_Kind);
+        }
+    };
+
+    int nworkers=nthreads>0?nthreads:static_cast<int>(std::thread::hardware_concurrency());
+    if(nworkers<1) nworkers=1;
+    if(nworkers>static_cast<int>(tasks.size())) nworkers=static_cast<int>(tasks.size());
+    vector<std::thread> threads;
+    for(int i=1;i<nworkers;i++) threads.emplace_back(worker);
+    worker();
+    for(auto &it:threads) it.join();
+
+    if(failedkind.load()==0){
+        MessagePrinter::printErrorTxt("Can't find a valid node Tag in your msh4 file inside the $Nodes");
+        return false;
+    }
+    else if(failedkind.load()==1){
+        MessagePrinter::printErrorTxt("Invalid node coordinates information in your msh4 file inside the $Nodes block");
+        return false;
+    }
+    else if(failedkind.load()==2){
+        MessagePrinter::printErrorTxt("Invalid element connectivity in your msh4 file inside the $Elements block");
+        return false;
+    }
+    return true;
+}
+//**********************************************************
+bool Msh4FileReader::readMeshFile(const string &filename,const int &nthreads){
+    releaseMemory();
+    if(!mapFile(filename)){
+        MessagePrinter::printErrorTxt("can\'t read the .msh file("+filename+"),please make sure file name is correct"
+                                      " or you have the access permission");
+        return false;
+    }
+    bool HasFormat=false,HasEntities=false;
+    m_HasNodes=false;m_HasElmts=false;
+    string line;
+    while(readLine(line)){
+        if(line.empty()||line[0]!='$') continue;
+        if(line=="$MeshFormat"){
+            if(!readMeshFormat()) return false;
+            HasFormat=true;
+        }
+        else if(!HasFormat){
+            MessagePrinter::printErrorTxt("$MeshFormat must be the first block of your msh4 file");
+            return false;
+        }
+        else if(line=="$PhysicalNames"){
+            if(!readPhysicalNames()) return false;
+        }
+        else if(line=="$Entities"){
+            if(!readEntities()) return false;
+            HasEntities=true;
+        }
+        else if(line=="$Nodes"){
+            if(!readNodes()) return false;
+        }
+        else if(line=="$Elements"){
+            if(!readElements()) return false;
+        }
+        else if(line.compare(0,4,"$End")!=0){
+            // skip the unused sections, i.e., $PartitionedEntities, $Periodic, $NodeData
+            if(!skipSection(line.substr(1))){
+                MessagePrinter::printErrorTxt("can\'t find the end of the "+line+" block in your msh4 file");
+                return false;
+            }
+        }
+    }
+    if(!HasEntities||!m_HasNodes||!m_HasElmts){
+        MessagePrinter::printErrorTxt("$Entities, $Nodes and $Elements blocks are required in your msh4 file");
+        return false;
+    }
+    bool IsSuccess=parseBlocks(nthreads);
+    unmapFile();
+    return IsSuccess;
+}
+//**********************************************************
+int Msh4FileReader::getMaxElmtDim()const{
+    int maxdim=-1;
+    for(const auto &block:m_ElmtBlocks){
+        if(block.m_EntityDim>maxdim) maxdim=block.m_EntityDim;
+    }
+    return maxdim;
+}
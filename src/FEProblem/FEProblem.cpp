@@ -15,6 +15,8 @@
 
 #include "FEProblem/FEProblem.h"
 #include "MPIUtils/MPIDataBus.h"
+#include "Utils/Profiler.h"
+#include "MPIUtils/EnsembleComm.h"
 
 FEProblem::FEProblem(){
     m_Timer.resetTimer();
@@ -26,6 +28,8 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     //***************************************
     m_Timer.startTimer();
     m_InputSystem.init(args,argv);
+    Profiler::enable(m_InputSystem.isProfileEnabled());
+    Profiler::beginScope("input",true);
 
     MessagePrinter::printStars();
     MessagePrinter::printNormalTxt("Start to read the input file");
@@ -38,6 +42,7 @@ void FEProblem::initFEProblem(int args,char *argv[]){
                                 m_Output,
                                 m_PostProcessor,
                                 m_JobBlock);
+    Profiler::endScope();
     m_Timer.endTimer();
     MessagePrinter::printStars();
     m_Timer.printElapseTime("Input file reading is done",false);
@@ -45,9 +50,17 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     //***************************************
     // for mesh init
     //***************************************
+    PreparedModelCache &ModelCache=m_InputSystem.getModelCacheRef();
     m_Timer.startTimer();
-    MessagePrinter::printNormalTxt("Start to distribute fecell ...");
-    m_FECell.distributeMesh();
+    Profiler::beginScope("mesh-setup",true);
+    if(ModelCache.isFECellLoaded()){
+        MessagePrinter::printNormalTxt("FEcell is already distributed by the model cache");
+    }
+    else{
+        MessagePrinter::printNormalTxt("Start to distribute fecell ...");
+        m_FECell.distributeMesh();
+    }
+    Profiler::endScope();
     m_Timer.endTimer();
     m_Timer.printElapseTime("FEcell distribution is done",false);
     m_FECell.getCellDataRef().MaxDofsPerNode=m_DofHandler.getMaxDofsPerNode();
@@ -69,7 +82,12 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     //***************************************
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to create dofs map ...");
-    m_DofHandler.createBulkDofsMap(m_FECell,m_ElmtSystem);
+    Profiler::beginScope("dofs-map",true);
+    if(!ModelCache.loadDofsMap(m_FECell,m_DofHandler)){
+        m_DofHandler.createBulkDofsMap(m_FECell,m_ElmtSystem);
+        if(ModelCache.isEnabled()) ModelCache.save(m_FECell,m_DofHandler);
+    }
+    Profiler::endScope();
     m_Timer.endTimer();
     m_Timer.printElapseTime("Dofs map generation is done",false);
 
@@ -78,6 +96,7 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     //***************************************
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to initialize the Element system ...");
+    Profiler::beginScope("system-init",true);
     m_ElmtSystem.init(m_FECell);
     m_Timer.endTimer();
     m_Timer.printElapseTime("Element system is initialized",false);
@@ -108,6 +127,7 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to initialize the FE space ...");
     m_FE.init(m_FECell);
+    m_FE.initBlockQpoints(m_ElmtSystem.getBulkElmtBlockList(),m_FECell);
     m_Timer.endTimer();
     m_Timer.printElapseTime("FE space is initialized",false);
 
@@ -138,6 +158,14 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to initialize the Solution system ...");
     m_SolnSystem.init(m_DofHandler,m_FE);
+    {
+        // the single-precision materials of all the element blocks share the same qpoint storage
+        vector<string> SinglePrecisionMateNames;
+        for(const auto &block:m_ElmtSystem.getBulkElmtBlockList()){
+            for(const auto &name:block.m_SinglePrecisionMateNames) SinglePrecisionMateNames.push_back(name);
+        }
+        m_SolnSystem.setSinglePrecisionMaterials(SinglePrecisionMateNames);
+    }
     m_Timer.endTimer();
     m_Timer.printElapseTime("Solution system is initialized",false);
 
@@ -156,6 +184,8 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to initialize the linear solver ...");
     m_LinearSolver.init();
+    m_LinearSolver.initFieldSplit(m_DofHandler,m_EqSystem.m_AMATRIX);
+    m_LinearSolver.initMultigrid(m_FECell,m_DofHandler,m_EqSystem.m_AMATRIX);
     m_Timer.endTimer();
     m_Timer.printElapseTime("Linear solver is initialized",false);
 
@@ -174,6 +204,7 @@ void FEProblem::initFEProblem(int args,char *argv[]){
     m_Timer.startTimer();
     MessagePrinter::printNormalTxt("Start to initialize the postprocessor ...");
     m_PostProcessor.init();
+    Profiler::endScope();
     m_Timer.endTimer();
     m_Timer.printElapseTime("Postprocessor is initialized",false);
 
@@ -206,6 +237,14 @@ void FEProblem::initFEProblem(int args,char *argv[]){
 }
 //*******************************************
 void FEProblem::finalize(){
+    m_Output.flush();
+    if(Profiler::isEnabled()){
+        string FileName=m_InputSystem.getInputFileName();
+        FileName=FileName.substr(0,FileName.size()-5);
+        // each rank group of an ensemble has its own report
+        if(EnsembleComm::getGroupsNum()>1) FileName+="-group"+to_string(EnsembleComm::getGroupID());
+        Profiler::writeReport(FileName);
+    }
     m_FECell.releaseMemory();
     m_DofHandler.releaseMemory();
     m_FE.releaseMemory();
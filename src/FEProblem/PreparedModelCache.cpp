@@ -0,0 +1,326 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.05
+//+++ Purpose: the prepared model cache, which stores the
+//+++          distributed fe cell and dofs map of each rank in
+//+++          a binary file
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "petsc.h"
+#include "FEProblem/PreparedModelCache.h"
+#include "MPIUtils/EnsembleComm.h"
+
+namespace{
+    const char CacheMagic[8]={'A','S','F','E','M','P','M','C'};
+    /**
+     * the header of the cache file
+     */
+    struct CacheHeader{
+        char Magic[8];/**< the magic string */
+        uint32_t Version;/**< the format version */
+        int32_t Ranks;/**< the number of ranks */
+        int32_t Rank;/**< the rank id */
+        int32_t Reserved;/**< reserved for the alignment */
+        uint64_t Key;/**< the hash key of the model */
+        uint64_t FECellSize;/**< the bytes of the fe cell section */
+        uint64_t DofsMapSize;/**< the bytes of the dofs map section */
+    };
+
+    /**
+     * FNV-1a hash
+     */
+    inline void hashBytes(uint64_t &hash,const void *data,const size_t &n){
+        const unsigned char *p=static_cast<const unsigned char*>(data);
+        for(size_t i=0;i<n;i++){
+            hash^=static_cast<uint64_t>(p[i]);
+            hash*=1099511628211ULL;
+        }
+    }
+    inline void hashString(uint64_t &hash,const string &str){
+        hashBytes(hash,str.data(),str.size());
+        hashBytes(hash,"\n",1);
+    }
+}
+
+PreparedModelCache::PreparedModelCache(){
+    m_IsEnabled=false;
+    m_IsFECellLoaded=false;
+    m_IsDofsMapLoaded=false;
+    m_CacheDir.clear();
+    m_FileName.clear();
+    m_Key=0;
+    m_Data=nullptr;
+    m_Size=0;
+    m_FileDescriptor=-1;
+    m_FECellOffset=0;m_FECellSize=0;
+    m_DofsMapOffset=0;m_DofsMapSize=0;
+}
+PreparedModelCache::~PreparedModelCache(){
+    close();
+}
+
+//*************************************************************
+bool PreparedModelCache::init(const string &inputfilename,const nlohmann::json &t_json){
+    m_IsEnabled=false;
+    if(!t_json.contains("mesh")) return true;
+    const nlohmann::json &meshjson=t_json.at("mesh");
+    if(meshjson.contains("cache")){
+        if(!meshjson.at("cache").is_boolean()){
+            MessagePrinter::printErrorTxt("invalid boolean value for cache in your mesh block, it should be true/false");
+            return false;
+        }
+        m_IsEnabled=static_cast<bool>(meshjson.at("cache"));
+    }
+    m_CacheDir=inputfilename.substr(0,inputfilename.size()-5)+"-cache";
+    if(meshjson.contains("cache-dir")){
+        if(!meshjson.at("cache-dir").is_string()){
+            MessagePrinter::printErrorTxt("the cache-dir in your mesh block is not a valid string");
+            return false;
+        }
+        m_CacheDir=meshjson.at("cache-dir");
+    }
+    if(m_IsEnabled&&meshjson.contains("implicit")&&meshjson.at("implicit").is_boolean()&&static_cast<bool>(meshjson.at("implicit"))){
+        // the implicit grid is created without any communication, there is nothing worth caching
+        MessagePrinter::printWarningTxt("the model cache is ignored for the implicit grid");
+        m_IsEnabled=false;
+    }
+    if(!m_IsEnabled) return true;
+
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    // the mesh file is checked on the master rank only, then the key is shared
+    unsigned long long key=0;
+    if(rank==0) key=static_cast<unsigned long long>(computeModelKey(t_json,size));
+    MPI_Bcast(&key,1,MPI_UNSIGNED_LONG_LONG,0,PETSC_COMM_WORLD);
+    m_Key=static_cast<uint64_t>(key);
+
+    char buff[70];
+    snprintf(buff,70,"model-%016llx-np%d-rank%d.cache",key,size,rank);
+    m_FileName=m_CacheDir+"/"+string(buff);
+    return true;
+}
+
+uint64_t PreparedModelCache::computeModelKey(const nlohmann::json &t_json,const int &ranks){
+    uint64_t hash=14695981039346656037ULL;
+    hashBytes(hash,&m_Version,sizeof(m_Version));
+    hashBytes(hash,&ranks,sizeof(ranks));
+
+    // for the mesh block, the options which don't change the mesh are excluded
+    nlohmann::json meshjson=t_json.at("mesh");
+    meshjson.erase("cache");
+    meshjson.erase("cache-dir");
+    meshjson.erase("savemesh");
+    hashString(hash,meshjson.dump());
+    if(meshjson.contains("file")&&meshjson.at("file").is_string()){
+        // the content of the mesh file may be changed, here its size and modification time are used
+        const string meshfile=meshjson.at("file");
+        std::error_code ec;
+        const auto filesize=std::filesystem::file_size(meshfile,ec);
+        if(!ec) hashBytes(hash,&filesize,sizeof(filesize));
+        const auto filetime=std::filesystem::last_write_time(meshfile,ec);
+        if(!ec){
+            const auto count=filetime.time_since_epoch().count();
+            hashBytes(hash,&count,sizeof(count));
+        }
+    }
+
+    // the dofs map depends on the dof names, and the domain and dofs of each element block
+    if(t_json.contains("dofs")) hashString(hash,t_json.at("dofs").dump());
+    if(t_json.contains("elements")){
+        for(auto it=t_json.at("elements").begin();it!=t_json.at("elements").end();it++){
+            hashString(hash,it.key());
+            if(it.value().contains("dofs")) hashString(hash,it.value().at("dofs").dump());
+            if(it.value().contains("domain")) hashString(hash,it.value().at("domain").dump());
+        }
+    }
+    return hash;
+}
+
+//*************************************************************
+bool PreparedModelCache::mapFile(){
+    close();
+#ifndef _WIN32
+    m_FileDescriptor=open(m_FileName.c_str(),O_RDONLY);
+    if(m_FileDescriptor>=0){
+        struct stat st;
+        if(fstat(m_FileDescriptor,&st)==0 && st.st_size>0){
+            void *ptr=mmap(nullptr,static_cast<size_t>(st.st_size),PROT_READ,MAP_PRIVATE,m_FileDescriptor,0);
+            if(ptr!=MAP_FAILED){
+                m_Data=static_cast<const char*>(ptr);
+                m_Size=static_cast<size_t>(st.st_size);
+            }
+        }
+        if(!m_Data){
+            ::close(m_FileDescriptor);
+            m_FileDescriptor=-1;
+        }
+    }
+#endif
+    if(!m_Data){
+        // fall back to the plain file reading
+        std::ifstream in(m_FileName.c_str(),std::ios::in|std::ios::binary);
+        if(!in.is_open()) return false;
+        in.seekg(0,std::ios::end);
+        m_Buffer.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0,std::ios::beg);
+        in.read(m_Buffer.data(),static_cast<std::streamsize>(m_Buffer.size()));
+        in.close();
+        m_Data=m_Buffer.data();
+        m_Size=m_Buffer.size();
+    }
+
+    // check the header
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    CacheHeader header;
+    if(m_Size<sizeof(CacheHeader)) return false;
+    std::memcpy(&header,m_Data,sizeof(CacheHeader));
+    if(std::memcmp(header.Magic,CacheMagic,8)!=0||
+       header.Version!=m_Version||
+       header.Ranks!=size||header.Rank!=rank||
+       header.Key!=m_Key||
+       header.FECellSize+header.DofsMapSize!=m_Size-sizeof(CacheHeader)){
+        return false;
+    }
+    m_FECellOffset=sizeof(CacheHeader);
+    m_FECellSize=static_cast<size_t>(header.FECellSize);
+    m_DofsMapOffset=m_FECellOffset+m_FECellSize;
+    m_DofsMapSize=static_cast<size_t>(header.DofsMapSize);
+    return true;
+}
+void PreparedModelCache::close(){
+#ifndef _WIN32
+    if(m_FileDescriptor>=0){
+        munmap(const_cast<char*>(m_Data),m_Size);
+        ::close(m_FileDescriptor);
+        m_FileDescriptor=-1;
+    }
+#endif
+    m_Buffer.clear();
+    m_Buffer.shrink_to_fit();
+    m_Data=nullptr;
+    m_Size=0;
+}
+
+//*************************************************************
+bool PreparedModelCache::loadFECell(FECell &t_fecell){
+    m_IsFECellLoaded=false;
+    if(!m_IsEnabled) return false;
+
+    // the fe cell is read into a temporary one, so the given fe cell is untouched if any rank fails
+    FECell fecell;
+    int IsSuccess=0,IsAllSuccess=0;
+    if(mapFile()){
+        BinaryReader reader(m_Data+m_FECellOffset,m_FECellSize);
+        if(fecell.readCellData(reader)) IsSuccess=1;
+    }
+    MPI_Allreduce(&IsSuccess,&IsAllSuccess,1,MPI_INT,MPI_MIN,PETSC_COMM_WORLD);
+    if(!IsAllSuccess){
+        close();
+        MessagePrinter::printNormalTxt("No valid model cache is found, the mesh will be prepared and saved to "+m_CacheDir);
+        return false;
+    }
+    t_fecell.getCellDataRef()=std::move(fecell.getCellDataRef());
+    t_fecell.setMeshDistributionMethod(fecell.getMeshDistributionMethod());
+    m_IsFECellLoaded=true;
+    MessagePrinter::printNormalTxt("The distributed fe cell is loaded from the model cache in "+m_CacheDir);
+    return true;
+}
+
+bool PreparedModelCache::loadDofsMap(FECell &t_fecell,DofHandler &t_dofhandler){
+    m_IsDofsMapLoaded=false;
+    if(!m_IsFECellLoaded) return false;
+
+    int IsSuccess=0,IsAllSuccess=0;
+    if(m_Data){
+        BinaryReader reader(m_Data+m_DofsMapOffset,m_DofsMapSize);
+        if(t_dofhandler.readDofsMap(reader,t_fecell)) IsSuccess=1;
+    }
+    MPI_Allreduce(&IsSuccess,&IsAllSuccess,1,MPI_INT,MPI_MIN,PETSC_COMM_WORLD);
+    close();
+    if(!IsAllSuccess){
+        MessagePrinter::printWarningTxt("the dofs map in the model cache is invalid, it will be recreated");
+        return false;
+    }
+    m_IsDofsMapLoaded=true;
+    return true;
+}
+
+//*************************************************************
+bool PreparedModelCache::save(const FECell &t_fecell,const DofHandler &t_dofhandler)const{
+    if(!m_IsEnabled) return false;
+    // the rank groups of an ensemble would write the same cache files, only the first group writes them
+    if(!EnsembleComm::isMainGroup()) return false;
+
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    int IsSuccess=1,IsAllSuccess=0;
+    if(rank==0){
+        std::error_code ec;
+        std::filesystem::create_directories(m_CacheDir,ec);
+        if(ec) IsSuccess=0;
+    }
+    MPI_Bcast(&IsSuccess,1,MPI_INT,0,PETSC_COMM_WORLD);
+
+    if(IsSuccess){
+        BinaryWriter fecellwriter,dofswriter;
+        t_fecell.writeCellData(fecellwriter);
+        t_dofhandler.writeDofsMap(dofswriter);
+
+        int size;
+        MPI_Comm_size(PETSC_COMM_WORLD,&size);
+        CacheHeader header;
+        std::memset(&header,0,sizeof(CacheHeader));
+        std::memcpy(header.Magic,CacheMagic,8);
+        header.Version=m_Version;
+        header.Ranks=size;
+        header.Rank=rank;
+        header.Key=m_Key;
+        header.FECellSize=static_cast<uint64_t>(fecellwriter.getSize());
+        header.DofsMapSize=static_cast<uint64_t>(dofswriter.getSize());
+
+        // write into a temporary file first, so an interrupted run never leaves a broken cache
+        const string tmpname=m_FileName+".tmp";
+        std::ofstream out(tmpname.c_str(),std::ios::out|std::ios::binary|std::ios::trunc);
+        if(out.is_open()){
+            out.write(reinterpret_cast<const char*>(&header),sizeof(CacheHeader));
+            out.write(fecellwriter.getData(),static_cast<std::streamsize>(fecellwriter.getSize()));
+            out.write(dofswriter.getData(),static_cast<std::streamsize>(dofswriter.getSize()));
+            out.close();
+            IsSuccess=(!out.fail()&&std::rename(tmpname.c_str(),m_FileName.c_str())==0)?1:0;
+        }
+        else{
+            IsSuccess=0;
+        }
+    }
+    MPI_Allreduce(&IsSuccess,&IsAllSuccess,1,MPI_INT,MPI_MIN,PETSC_COMM_WORLD);
+    if(!IsAllSuccess){
+        MessagePrinter::printWarningTxt("can\'t write the model cache to "+m_CacheDir+", please make sure you have the write permission");
+        return false;
+    }
+    MessagePrinter::printNormalTxt("The distributed fe cell and dofs map are saved to the model cache in "+m_CacheDir);
+    return true;
+}
@@ -0,0 +1,236 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.13
+//+++ Purpose: run the parameter-sweep variants of an ensemble job,
+//+++          the mesh, dofs map, sparsity pattern, and solvers are
+//+++          set up once and shared by all the variants
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <fstream>
+
+#include "FEProblem/FEProblem.h"
+#include "MPIUtils/EnsembleComm.h"
+#include "Utils/Profiler.h"
+
+/**
+ * override the parameters of one block by the 'parameters' object of the variant
+ */
+static bool overrideParams(const string &t_blockname,const nlohmann::json &t_override,nlohmann::json &t_params){
+    if(!t_override.is_object()){
+        MessagePrinter::printErrorTxt("'parameters' of block '"+t_blockname+"' in your ensemble must be a json object");
+        return false;
+    }
+    for(auto it=t_override.begin();it!=t_override.end();it++){
+        if(!t_params.contains(it.key())){
+            MessagePrinter::printWarningTxt("parameter '"+it.key()+"' is not in the base input of block '"+t_blockname+"', it is added by the ensemble");
+        }
+        t_params[it.key()]=it.value();
+    }
+    return true;
+}
+
+bool FEProblem::applyEnsembleOverrides(const string &t_name,const nlohmann::json &t_overrides){
+    bool HasBlock;
+    if(t_overrides.contains("elements")){
+        for(auto it=t_overrides.at("elements").begin();it!=t_overrides.at("elements").end();it++){
+            HasBlock=false;
+            for(int i=1;i<=m_ElmtSystem.getBulkElmtBlocksNum();i++){
+                ElmtBlock &block=m_ElmtSystem.getIthBulkElmtBlockRef(i);
+                if(block.m_ElmtBlockName!=it.key()) continue;
+                HasBlock=true;
+                for(auto par=it.value().begin();par!=it.value().end();par++){
+                    if(par.key()!="parameters"){
+                        MessagePrinter::printErrorTxt("'"+par.key()+"' of elements block '"+it.key()+"' in variant '"+t_name+"' is unsupported, only 'parameters' can be overridden");
+                        return false;
+                    }
+                    if(!overrideParams(it.key(),par.value(),block.m_JsonParams)) return false;
+                }
+            }
+            if(!HasBlock){
+                MessagePrinter::printErrorTxt("can\'t find the elements block '"+it.key()+"' of variant '"+t_name+"', please check your input file");
+                return false;
+            }
+        }
+    }
+    if(t_overrides.contains("bcs")){
+        for(auto it=t_overrides.at("bcs").begin();it!=t_overrides.at("bcs").end();it++){
+            HasBlock=false;
+            for(int i=1;i<=m_BCSystem.getBCBlocksNum();i++){
+                BCBlock &block=m_BCSystem.getIthBCBlockRef(i);
+                if(block.m_BCBlockName!=it.key()) continue;
+                HasBlock=true;
+                for(auto par=it.value().begin();par!=it.value().end();par++){
+                    if(par.key()=="bcvalue"&&par.value().is_number()){
+                        block.m_BCValue=par.value().get<double>();
+                    }
+                    else if(par.key()=="parameters"){
+                        if(!overrideParams(it.key(),par.value(),block.m_JsonParams)) return false;
+                    }
+                    else{
+                        MessagePrinter::printErrorTxt("'"+par.key()+"' of bcs block '"+it.key()+"' in variant '"+t_name+"' is invalid, only 'bcvalue' (number) and 'parameters' can be overridden");
+                        return false;
+                    }
+                }
+            }
+            if(!HasBlock){
+                MessagePrinter::printErrorTxt("can\'t find the bcs block '"+it.key()+"' of variant '"+t_name+"', please check your input file");
+                return false;
+            }
+        }
+    }
+    if(t_overrides.contains("ics")){
+        for(auto it=t_overrides.at("ics").begin();it!=t_overrides.at("ics").end();it++){
+            HasBlock=false;
+            for(int i=1;i<=m_ICSystem.getICBlocksNum();i++){
+                ICBlock &block=m_ICSystem.getIthICBlockRef(i);
+                if(block.m_ICBlockName!=it.key()) continue;
+                HasBlock=true;
+                for(auto par=it.value().begin();par!=it.value().end();par++){
+                    if(par.key()=="icvalue"&&par.value().is_number()){
+                        block.m_ICValue=par.value().get<double>();
+                    }
+                    else if(par.key()=="parameters"){
+                        if(!overrideParams(it.key(),par.value(),block.m_Params)) return false;
+                    }
+                    else{
+                        MessagePrinter::printErrorTxt("'"+par.key()+"' of ics block '"+it.key()+"' in variant '"+t_name+"' is invalid, only 'icvalue' (number) and 'parameters' can be overridden");
+                        return false;
+                    }
+                }
+            }
+            if(!HasBlock){
+                MessagePrinter::printErrorTxt("can\'t find the ics block '"+it.key()+"' of variant '"+t_name+"', please check your input file");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void FEProblem::runEnsembleAnalysis(){
+    const int VariantsNum=static_cast<int>(m_JobBlock.m_VariantNames.size());
+    const int GroupsNum=EnsembleComm::getGroupsNum();
+    const int GroupID=EnsembleComm::getGroupID();
+    const string InputFileName=m_InputSystem.getInputFileName();
+    const string BaseName=InputFileName.substr(0,InputFileName.size()-5);
+
+    // the base blocks, every variant starts from the original input
+    vector<ElmtBlock> BaseElmtBlocks=m_ElmtSystem.getBulkElmtBlockList();
+    vector<BCBlock> BaseBCBlocks;
+    vector<ICBlock> BaseICBlocks;
+    for(int i=1;i<=m_BCSystem.getBCBlocksNum();i++) BaseBCBlocks.push_back(m_BCSystem.getIthBCBlock(i));
+    for(int i=1;i<=m_ICSystem.getICBlocksNum();i++) BaseICBlocks.push_back(m_ICSystem.getIthICBlockRef(i));
+
+    auto restoreBaseBlocks=[&](){
+        for(int i=1;i<=m_ElmtSystem.getBulkElmtBlocksNum();i++){
+            m_ElmtSystem.getIthBulkElmtBlockRef(i).m_JsonParams=BaseElmtBlocks[i-1].m_JsonParams;
+        }
+        for(int i=1;i<=m_BCSystem.getBCBlocksNum();i++){
+            m_BCSystem.getIthBCBlockRef(i).m_BCValue=BaseBCBlocks[i-1].m_BCValue;
+            m_BCSystem.getIthBCBlockRef(i).m_JsonParams=BaseBCBlocks[i-1].m_JsonParams;
+        }
+        for(int i=1;i<=m_ICSystem.getICBlocksNum();i++){
+            m_ICSystem.getIthICBlockRef(i).m_ICValue=BaseICBlocks[i-1].m_ICValue;
+            m_ICSystem.getIthICBlockRef(i).m_Params=BaseICBlocks[i-1].m_Params;
+        }
+    };
+    // check all the variants on every rank first, so an invalid input stops all the groups together
+    for(int v=0;v<VariantsNum;v++){
+        restoreBaseBlocks();
+        if(!applyEnsembleOverrides(m_JobBlock.m_VariantNames[v],m_JobBlock.m_VariantOverrides[v])){
+            MessagePrinter::exitAsFem();
+        }
+    }
+
+    MessagePrinter::printStars();
+    MessagePrinter::printNormalTxt("Start the ensemble run of "+to_string(VariantsNum)+" variants on "+to_string(GroupsNum)+" rank group(s)");
+    MessagePrinter::printStars();
+
+    // status: -1 for the variants of the other groups, 0 for failure, 1 for success
+    vector<int> Status(VariantsNum,-1),AllStatus(VariantsNum,-1);
+    vector<double> Times(VariantsNum,0.0),AllTimes(VariantsNum,0.0);
+    double start;
+    for(int v=0;v<VariantsNum;v++){
+        if(v%GroupsNum!=GroupID) continue;
+        const string &name=m_JobBlock.m_VariantNames[v];
+
+        restoreBaseBlocks();
+        applyEnsembleOverrides(name,m_JobBlock.m_VariantOverrides[v]);
+
+        // start from the same state as a fresh run, only the setup is reused
+        m_SolnSystem.m_Ucurrent.setToZero();
+        m_SolnSystem.m_Uold.setToZero();
+        m_SolnSystem.m_Uolder.setToZero();
+        m_SolnSystem.m_Utemp.setToZero();
+        m_SolnSystem.m_V.setToZero();
+        m_SolnSystem.m_A.setToZero();
+        m_NLSolver.resetJacobian();
+        m_FECtrlInfo.init();
+        m_FECtrlInfo.IsDebug=m_JobBlock.m_IsDebug;
+        m_FECtrlInfo.IsDepDebug=m_JobBlock.m_IsDepDebug;
+
+        // the results of each variant are named by 'input-variant'
+        m_Output.setInputFileName(BaseName+"-"+name+".json");
+        m_PostProcessor.setInputFileName(BaseName+"-"+name+".json");
+
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+        MessagePrinter::printNormalTxt("Run variant '"+name+"' ("+to_string(v+1)+"/"+to_string(VariantsNum)+")",MessageColor::BLUE);
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+
+        start=MPI_Wtime();
+        {
+            ProfilerScope VariantScope("variant");
+            if(m_JobBlock.m_JobType==FEJobType::STATIC){
+                Status[v]=runStaticAnalysis()?1:0;
+            }
+            else{
+                Status[v]=runTransientAnalysis()?1:0;
+            }
+            // finish the pending writes before the file names are changed by the next variant
+            m_Output.flush();
+        }
+        Times[v]=MPI_Wtime()-start;
+        if(!Status[v]){
+            MessagePrinter::printWarningTxt("variant '"+name+"' fails, the ensemble continues with the next variant");
+        }
+    }
+
+    // collect the status of all the groups, MPI_COMM_WORLD contains all of them
+    MPI_Allreduce(Status.data(),AllStatus.data(),VariantsNum,MPI_INT,MPI_MAX,MPI_COMM_WORLD);
+    MPI_Allreduce(Times.data(),AllTimes.data(),VariantsNum,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+
+    int WorldRank,Failures=0;
+    MPI_Comm_rank(MPI_COMM_WORLD,&WorldRank);
+    for(int v=0;v<VariantsNum;v++){
+        if(AllStatus[v]!=1) Failures+=1;
+    }
+    if(WorldRank==0){
+        std::ofstream out;
+        out.open((BaseName+"-ensemble.csv").c_str(),std::ios::out);
+        if(!out.is_open()){
+            MessagePrinter::printErrorTxt("can\'t open "+BaseName+"-ensemble.csv, please make sure you have the write permission");
+        }
+        else{
+            out<<"variant,group,status,time"<<std::endl;
+            for(int v=0;v<VariantsNum;v++){
+                out<<m_JobBlock.m_VariantNames[v]<<","<<v%GroupsNum<<","
+                   <<(AllStatus[v]==1?"converged":"failed")<<","<<AllTimes[v]<<std::endl;
+            }
+            out.close();
+        }
+    }
+    if(EnsembleComm::isMainGroup()){
+        MessagePrinter::printStars();
+        MessagePrinter::printNormalTxt("Ensemble run is done, "+to_string(VariantsNum-Failures)+" of "+to_string(VariantsNum)+" variants converged");
+        MessagePrinter::printNormalTxt("Save the ensemble summary to "+BaseName+"-ensemble.csv");
+        MessagePrinter::printStars();
+    }
+}
@@ -28,11 +28,14 @@ void FEProblem::run(){
     MessagePrinter::printDashLine(MessageColor::BLUE);
 
     if(!m_InputSystem.isReadOnly()){
-        if(m_JobBlock.m_JobType==FEJobType::STATIC){
-            runStaticAnalysis();
+        if(m_JobBlock.isEnsemble()){
+            runEnsembleAnalysis();
+        }
+        else if(m_JobBlock.m_JobType==FEJobType::STATIC){
+            if(!runStaticAnalysis()) MessagePrinter::exitAsFem();
         }
         else if(m_JobBlock.m_JobType==FEJobType::TRANSIENT){
-            runTransientAnalysis();
+            if(!runTransientAnalysis()) MessagePrinter::exitAsFem();
         }
     }
     else{
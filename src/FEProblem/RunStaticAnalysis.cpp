@@ -13,8 +13,10 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "FEProblem/FEProblem.h"
+#include "Utils/Profiler.h"
 
-void FEProblem::runStaticAnalysis(){
+bool FEProblem::runStaticAnalysis(){
+    ProfilerScope AnalysisScope("static-analysis");
     MessagePrinter::printStars();
     MessagePrinter::printNormalTxt("Start the static analysis ...");
     MessagePrinter::printStars();
@@ -54,9 +56,8 @@ void FEProblem::runStaticAnalysis(){
             MessagePrinter::printDashLine(MessageColor::BLUE);
         }
         MessagePrinter::printStars();
+        return true;
     }
-    else{
-        MessagePrinter::printErrorTxt("Static analysis fails, please check either your code or your input file and boundary conditions");
-        MessagePrinter::exitAsFem();
-    }
+    MessagePrinter::printErrorTxt("Static analysis fails, please check either your code or your input file and boundary conditions");
+    return false;
 }
\ No newline at end of file
@@ -13,8 +13,10 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "FEProblem/FEProblem.h"
+#include "Utils/Profiler.h"
 
-void FEProblem::runTransientAnalysis(){
+bool FEProblem::runTransientAnalysis(){
+    ProfilerScope AnalysisScope("transient-analysis");
 
     MessagePrinter::printStars();
     MessagePrinter::printNormalTxt("Start the transient analysis ...");
@@ -40,9 +42,8 @@ void FEProblem::runTransientAnalysis(){
         MessagePrinter::printStars();
         m_Timer.printElapseTime("Transient analysis is done");
         MessagePrinter::printStars();
+        return true;
     }
-    else{
-        MessagePrinter::printErrorTxt("Transient analysis fails, please check either your code or your input file and boundary conditions");
-        MessagePrinter::exitAsFem();
-    }
+    MessagePrinter::printErrorTxt("Transient analysis fails, please check either your code or your input file and boundary conditions");
+    return false;
 }
\ No newline at end of file
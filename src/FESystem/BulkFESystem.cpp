@@ -32,6 +32,8 @@ BulkFESystem::BulkFESystem(){
     m_LocalK.clean();
     m_SubR.clean();
     m_SubK.clean();
+    m_QpSubR.clear();
+    m_QpSubK.clear();
 
     m_ElmtConn.clear();
     m_ElmtDofIDs.clear();
@@ -39,6 +41,9 @@ BulkFESystem::BulkFESystem(){
 
     m_MaxKmatCoeff=-1.0e16;
 
+    m_MeasureElmtCost=false;
+    m_LocalElmtCost.clear();
+
     m_ElmtU.clear();
     m_ElmtUold.clear();
     m_ElmtUolder.clear();
@@ -66,6 +71,11 @@ BulkFESystem::BulkFESystem(){
     m_Nodes.clear();
     m_Nodes0.clear();
 
+    m_HasReducedIntegration=false;
+    m_SubElmtMeanDilatation.clear();
+    m_HourglassModulus.clear();
+    m_ReducedNodalU.clear();
+
 }
 
 void BulkFESystem::releaseMemory(){
@@ -83,6 +93,8 @@ void BulkFESystem::releaseMemory(){
     m_LocalK.clean();
     m_SubR.clean();
     m_SubK.clean();
+    m_QpSubR.clear();
+    m_QpSubK.clear();
 
     m_ElmtConn.clear();
     m_ElmtDofIDs.clear();
@@ -90,6 +102,18 @@ void BulkFESystem::releaseMemory(){
 
     m_MaxKmatCoeff=-1.0e16;
 
+    m_MeasureElmtCost=false;
+    m_LocalElmtCost.clear();
+
+    m_IsBatchedSubElmt.clear();
+    m_BatchMateInputs.clear();
+    m_BatchMateOutputs.clear();
+
+    m_HasReducedIntegration=false;
+    m_SubElmtMeanDilatation.clear();
+    m_HourglassModulus.clear();
+    m_ReducedNodalU.clear();
+
     m_ElmtU.clear();
     m_ElmtUold.clear();
     m_ElmtUolder.clear();
@@ -12,6 +12,8 @@
 //+++ Purpose: Implement the general assemble process in AsFem
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#include <algorithm>
+
 #include "FESystem/BulkFESystem.h"
 
 
@@ -26,6 +28,19 @@ void BulkFESystem::assembleLocalResidual2GlobalR(const int &Dofs,
                                                  const VectorXd &SubR,
                                                  Vector &RHS){
     int iInd;
+    const int nMasters=t_DofHandler.getIthNodeMastersNum(GlobalNodeID);
+    if(nMasters>0){
+        // the residual of a hanging node goes to its masters, the hanging row only keeps the constraint
+        for(int m=1;m<=nMasters;m++){
+            const int MasterID=t_DofHandler.getIthNodeJthMasterID(GlobalNodeID,m);
+            const double w=t_DofHandler.getIthNodeJthMasterWeight(GlobalNodeID,m);
+            for(int i=0;i<Dofs;i++){
+                iInd=t_DofHandler.getIthNodeJthDofID(MasterID,DofIDs[i]);
+                RHS.addValue(iInd,w*SubR(i+1)*JxW);
+            }
+        }
+        return;
+    }
     for(int i=0;i<Dofs;i++){
         iInd=t_DofHandler.getIthNodeJthDofID(GlobalNodeID,DofIDs[i]);
         RHS.addValue(iInd,SubR(i+1)*JxW);
@@ -40,6 +55,36 @@ void BulkFESystem::assembleLocalJacobian2GlobalK(const int &Dofs,
                                                  const MatrixXd &SubK,
                                                  SparseMatrix &AMATRIX){
     int iInd,jInd;
+    if(t_DofHandler.getIthNodeMastersNum(GlobalNodeIDI)>0||t_DofHandler.getIthNodeMastersNum(GlobalNodeIDJ)>0){
+        // K_mn+=w_i*w_j*K_ij, a free node acts as its own master with the unit weight
+        const int nI=std::max(t_DofHandler.getIthNodeMastersNum(GlobalNodeIDI),1);
+        const int nJ=std::max(t_DofHandler.getIthNodeMastersNum(GlobalNodeIDJ),1);
+        int MasterI,MasterJ;
+        double wI,wJ;
+        for(int mi=1;mi<=nI;mi++){
+            MasterI=GlobalNodeIDI;wI=1.0;
+            if(t_DofHandler.getIthNodeMastersNum(GlobalNodeIDI)>0){
+                MasterI=t_DofHandler.getIthNodeJthMasterID(GlobalNodeIDI,mi);
+                wI=t_DofHandler.getIthNodeJthMasterWeight(GlobalNodeIDI,mi);
+            }
+            for(int mj=1;mj<=nJ;mj++){
+                MasterJ=GlobalNodeIDJ;wJ=1.0;
+                if(t_DofHandler.getIthNodeMastersNum(GlobalNodeIDJ)>0){
+                    MasterJ=t_DofHandler.getIthNodeJthMasterID(GlobalNodeIDJ,mj);
+                    wJ=t_DofHandler.getIthNodeJthMasterWeight(GlobalNodeIDJ,mj);
+                }
+                for(int i=0;i<Dofs;i++){
+                    iInd=t_DofHandler.getIthNodeJthDofID(MasterI,DofIDs[i]);
+                    for(int j=0;j<Dofs;j++){
+                        jInd=t_DofHandler.getIthNodeJthDofID(MasterJ,DofIDs[j]);
+                        AMATRIX.addValue(iInd,jInd,wI*wJ*SubK(i+1,j+1)*JxW);
+                        if(abs(SubK(i+1,j+1))>m_MaxKmatCoeff) m_MaxKmatCoeff=abs(SubK(i+1,j+1));
+                    }
+                }
+            }
+        }
+        return;
+    }
     for(int i=0;i<Dofs;i++){
         iInd=t_DofHandler.getIthNodeJthDofID(GlobalNodeIDI,DofIDs[i]);
         for(int j=0;j<Dofs;j++){
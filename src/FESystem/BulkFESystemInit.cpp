@@ -29,6 +29,8 @@ void BulkFESystem::init(const FECell &t_fecell,const DofHandler &t_dofhandler){
 
     m_SubR.resize(m_MaxNodalDofs+1,0.0);
     m_SubK.resize(m_MaxNodalDofs+1,m_MaxNodalDofs+1,0.0);
+    m_QpSubR.assign(m_BulkElmtNodesNum,VectorXd(m_MaxNodalDofs+1,0.0));
+    m_QpSubK.assign(m_BulkElmtNodesNum*m_BulkElmtNodesNum,MatrixXd(m_MaxNodalDofs+1,m_MaxNodalDofs+1,0.0));
 
     m_ElmtConn.resize(m_BulkElmtNodesNum,0);
     m_ElmtDofIDs.resize(m_MaxElmtDofs+1,0);
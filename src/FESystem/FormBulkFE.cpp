@@ -15,6 +15,7 @@
 
 #include "FESystem/BulkFESystem.h"
 #include "NonlinearSolver/SNESSolver.h"
+#include "Utils/Profiler.h"
 
 void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
                               const double &T,
@@ -30,6 +31,7 @@ void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
                               Vector &RHS){
     if(T||Dt||Ctan[0]||t_FECell.getFECellBulkElmtsNum()||t_DofHandler.getBulkElmtsNum()||t_FE.getMaxDim()||
        t_ElmtSystem.getBulkElmtBlocksNum()){}
+    ProfilerScope AssembleScope("assembly");
     if(t_CalcType==FECalcType::COMPUTERESIDUAL){
         RHS.setToZero();
     }
@@ -58,12 +60,17 @@ void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
     int GlobalI,GlobalJ;
 
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
 
     vector<SingleMeshCell> MyLocalCellVec;
     MyLocalCellVec=t_FECell.getLocalBulkFECellVecCopy();
     m_LocalElmtInfo.m_ElmtsNum=t_FECell.getLocalFECellBulkElmtsNum();
+    if(m_MeasureElmtCost&&static_cast<int>(m_LocalElmtCost.size())!=m_LocalElmtInfo.m_ElmtsNum){
+        m_LocalElmtCost.assign(m_LocalElmtInfo.m_ElmtsNum,0.0);
+    }
+    double ElmtStart=0.0;
     for(int e=1;e<=m_LocalElmtInfo.m_ElmtsNum;e++){
+        if(m_MeasureElmtCost) ElmtStart=MPI_Wtime();
         m_LocalElmtInfo.m_Dim=MyLocalCellVec[e-1].Dim;
         m_LocalElmtInfo.m_DofsNum=static_cast<int>(MyLocalCellVec[e-1].ElmtDofIDs.size());
         m_LocalElmtInfo.m_Dt=Dt;
@@ -84,29 +91,46 @@ void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
             m_ElmtA[i]=t_SolnSystem.m_A.getIthValueFromGhost(m_ElmtDofIDs[i]);
         }
 
+        /**
+         * the qpoints of current element come from its element blocks, all the sub elements share the same rule
+         */
+        const QPoint &Qpoints=t_FE.getIthBlockBulkQpoints(t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e)>0?t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,1):0);
+        computeReducedIntegration(e,MyLocalCellVec[e-1],t_DofHandler,t_FE,Qpoints,t_ElmtSystem,t_SolnSystem);
+
+        /**
+         * the materials with the batched kernel are evaluated for all the qpoints of current element at once,
+         * the other ones are still evaluated qpoint by qpoint
+         */
+        if(t_CalcType!=FECalcType::INITMATERIAL){
+            runBatchMaterials(e,MyLocalCellVec[e-1],t_DofHandler,t_FE,t_ElmtSystem,t_MateSystem,t_SolnSystem);
+        }
+
         /**
          * Now, we execute the qpoint integration
          */
-        m_LocalElmtInfo.m_QpointsNum=t_FE.m_BulkQpoints.getQPointsNum();
+        m_LocalElmtInfo.m_QpointsNum=Qpoints.getQPointsNum();
         MyLocalCellVec[e-1].Volume=0.0;
         for(int qp=1;qp<=m_LocalElmtInfo.m_QpointsNum;qp++){
             m_LocalElmtInfo.m_QpointID=qp;
-            w=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,0);
-            xi=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,1);
+            w=Qpoints.getIthPointJthCoord(qp,0);
+            xi=Qpoints.getIthPointJthCoord(qp,1);
             if (m_LocalElmtInfo.m_Dim==1){
                 eta=0.0;
                 zeta=0.0;
             }
             else if(m_LocalElmtInfo.m_Dim==2) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
                 zeta=0.0;
             }
             else if(m_LocalElmtInfo.m_Dim==3) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
-                zeta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,3);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
+                zeta=Qpoints.getIthPointJthCoord(qp,3);
             }
 
-            t_FE.m_BulkShp.calc(xi,eta,zeta,m_Nodes,true);
+            {
+                ProfilerScope ShapeScope("shape-functions");
+                t_FE.m_BulkShp.calc(xi,eta,zeta,m_Nodes,true);
+            }
             J=t_FE.m_BulkShp.getJacDet();
             JxW=J*w;
             MyLocalCellVec[e-1].Volume+=1.0*JxW;/**< for the volume of the current fe cell */
@@ -197,72 +221,93 @@ void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
                     }
                 }// end-of-sub-element-dofs-loop
 
+                // the mean dilatation replaces the volumetric part of the displacement gradient by the element averaged one
+                m_LocalElmtInfo.m_IsMeanDilatation=t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_IsSelectiveReduced;
+                if(m_LocalElmtInfo.m_IsMeanDilatation){
+                    ReducedIntegration::applyMeanDilatation(m_SubElmtMeanDilatation[SubElmt-1],
+                                                            std::min(m_LocalElmtInfo.m_Dim,m_LocalElmtInfo.m_DofsNum),
+                                                            m_LocalElmtInfo.m_Dim,
+                                                            m_LocalElmtSoln.m_QpGradU);
+                }
+
                 //***********************************************************
                 //*** for materials (UMAT) and elements/models (UEL)
                 //***********************************************************
-                if (t_CalcType==FECalcType::INITMATERIAL) {
-                    t_MateSystem.initBulkMateLibs(t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_MateType,
-                                                  t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_JsonParams,
-                                                  m_LocalElmtInfo,
-                                                  m_LocalElmtSoln);
+                {
+                    ProfilerScope MateScope("materials");
+                    if (t_CalcType==FECalcType::INITMATERIAL) {
+                        t_MateSystem.initBulkMateLibs(t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_MateType,
+                                                      t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_JsonParams,
+                                                      m_LocalElmtInfo,
+                                                      m_LocalElmtSoln);
 
 
-                    t_SolnSystem.m_QpointsScalarMaterials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getScalarMaterialsCopy();
-                    t_SolnSystem.m_QpointsVectorMaterials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getVectorMaterialsCopy();
-                    t_SolnSystem.m_QpointsRank2Materials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank2MaterialsCopy();
-                    t_SolnSystem.m_QpointsRank4Materials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank4MaterialsCopy();
+                        t_SolnSystem.saveLocalQpMaterials(e,qp,t_MateSystem.m_MaterialContainer,false);
+                        t_SolnSystem.saveLocalQpMaterials(e,qp,t_MateSystem.m_MaterialContainer,true);
 
-                    t_SolnSystem.m_QpointsScalarMaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getScalarMaterialsCopy();
-                    t_SolnSystem.m_QpointsVectorMaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getVectorMaterialsCopy();
-                    t_SolnSystem.m_QpointsRank2MaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank2MaterialsCopy();
-                    t_SolnSystem.m_QpointsRank4MaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank4MaterialsCopy();
+                    }
+                    else if (m_IsBatchedSubElmt[SubElmt-1]) {
+                        t_SolnSystem.loadLocalQpMaterialsOld(e,qp,t_MateSystem.m_MaterialContainerOld);
+                        m_BatchMateOutputs[SubElmt-1].unpack(qp-1,t_MateSystem.m_MaterialContainer);
+                        if(t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_CheckBatchMate){
+                            checkBatchMaterials(e,qp,t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID),t_MateSystem);
+                        }
+                        t_SolnSystem.saveLocalQpMaterials(e,qp,t_MateSystem.m_MaterialContainer,false);
+                    }
+                    else {
+                        t_SolnSystem.loadLocalQpMaterialsOld(e,qp,t_MateSystem.m_MaterialContainerOld);
+
+                        t_MateSystem.runBulkMateLibs(t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_MateType,
+                                                     t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_JsonParams,
+                                                     m_LocalElmtInfo,
+                                                     m_LocalElmtSoln);
 
+                        t_SolnSystem.saveLocalQpMaterials(e,qp,t_MateSystem.m_MaterialContainer,false);
+                    }
                 }
-                else {
-                    t_MateSystem.m_MaterialContainerOld.getScalarMaterialsRef()=t_SolnSystem.m_QpointsScalarMaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1];
-                    t_MateSystem.m_MaterialContainerOld.getVectorMaterialsRef()=t_SolnSystem.m_QpointsVectorMaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1];
-                    t_MateSystem.m_MaterialContainerOld.getRank2MaterialsRef()=t_SolnSystem.m_QpointsRank2MaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1];
-                    t_MateSystem.m_MaterialContainerOld.getRank4MaterialsRef()=t_SolnSystem.m_QpointsRank4MaterialsOld_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1];
-
-                    t_MateSystem.runBulkMateLibs(t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_MateType,
-                                                 t_ElmtSystem.getIthBulkElmtBlock(SubElmtBlockID).m_JsonParams,
-                                                 m_LocalElmtInfo,
-                                                 m_LocalElmtSoln);
-
-                    t_SolnSystem.m_QpointsScalarMaterials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getScalarMaterialsCopy();
-                    t_SolnSystem.m_QpointsVectorMaterials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getVectorMaterialsCopy();
-                    t_SolnSystem.m_QpointsRank2Materials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank2MaterialsCopy();
-                    t_SolnSystem.m_QpointsRank4Materials_Local[(e-1)*m_LocalElmtInfo.m_QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank4MaterialsCopy();
+                if(m_HasReducedIntegration&&t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_HourglassCoef>0.0&&
+                   t_CalcType!=FECalcType::INITMATERIAL){
+                    // the hourglass stiffness is scaled by the largest diagonal stiffness of the material
+                    const Rank4Tensor &Jac=t_MateSystem.m_MaterialContainer.Rank4Material("jacobian");
+                    m_HourglassModulus[SubElmt-1]=0.0;
+                    for(int k=1;k<=m_LocalElmtInfo.m_Dim;k++) m_HourglassModulus[SubElmt-1]=std::max(m_HourglassModulus[SubElmt-1],Jac(k,k,k,k));
                 }
 
-                if (t_CalcType==FECalcType::COMPUTERESIDUAL||
-                    t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
-                    for (int i=1;i<=m_BulkElmtNodesNum;i++) {
-                        m_LocalShp.m_Test=t_FE.m_BulkShp.shape_value(i);
-                        m_LocalShp.m_GradTest=t_FE.m_BulkShp.shape_grad(i);
-                        GlobalI=MyLocalCellVec[e-1].ElmtConn[i-1];
-
-                        t_ElmtSystem.runBulkElmtLibs(t_CalcType,
-                                                     Ctan,
-                                                     SubElmtBlockID,
-                                                     t_MateSystem.m_MaterialContainerOld,
-                                                     t_MateSystem.m_MaterialContainer,
-                                                     m_LocalElmtInfo,
-                                                     m_LocalElmtSoln,
-                                                     m_LocalShp,
-                                                     m_SubK,
-                                                     m_SubR);
-                        assembleLocalResidual2GlobalR(m_SubElmtDofs,
-                                                      m_SubElmtDofIDs,
-                                                      GlobalI,
-                                                      t_DofHandler,
-                                                      JxW,m_SubR,
-                                                      RHS);
-                        if (t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN) {
+                //***********************************************************
+                //*** the element kernels of all the node pairs are evaluated
+                //*** first, then inserted at once, so each part is timed
+                //*** once per qpoint instead of once per node pair
+                //***********************************************************
+                const bool HasResidual=t_CalcType==FECalcType::COMPUTERESIDUAL||
+                                       t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN;
+                const bool HasJacobian=t_CalcType==FECalcType::COMPUTEJACOBIAN||
+                                       t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN;
+                if(HasResidual||HasJacobian){
+                    {
+                        ProfilerScope KernelScope("element-kernels");
+                        for (int i=1;i<=m_BulkElmtNodesNum;i++) {
+                            m_LocalShp.m_Test=t_FE.m_BulkShp.shape_value(i);
+                            m_LocalShp.m_GradTest=t_FE.m_BulkShp.shape_grad(i);
+                            if(m_LocalElmtInfo.m_IsMeanDilatation) m_LocalShp.m_GradTestMean=m_ReducedIntegration.getIthMeanShapeGrad(i);
+                            if(HasResidual){
+                                t_ElmtSystem.runBulkElmtLibs(t_CalcType,
+                                                             Ctan,
+                                                             SubElmtBlockID,
+                                                             t_MateSystem.m_MaterialContainerOld,
+                                                             t_MateSystem.m_MaterialContainer,
+                                                             m_LocalElmtInfo,
+                                                             m_LocalElmtSoln,
+                                                             m_LocalShp,
+                                                             m_SubK,
+                                                             m_SubR);
+                                m_QpSubR[i-1]=m_SubR;
+                            }
+                            // for the residual-only case, the kernel has been called once above
+                            if(t_CalcType==FECalcType::COMPUTERESIDUAL) continue;
                             for (int j=1;j<=m_BulkElmtNodesNum;j++) {
                                 m_LocalShp.m_Trial=t_FE.m_BulkShp.shape_value(j);
                                 m_LocalShp.m_GradTrial=t_FE.m_BulkShp.shape_grad(j);
-                                GlobalJ=MyLocalCellVec[e-1].ElmtConn[j-1];
+                                if(m_LocalElmtInfo.m_IsMeanDilatation) m_LocalShp.m_GradTrialMean=m_ReducedIntegration.getIthMeanShapeGrad(j);
                                 t_ElmtSystem.runBulkElmtLibs(t_CalcType,
                                                              Ctan,
                                                              SubElmtBlockID,
@@ -273,45 +318,52 @@ void BulkFESystem::formBulkFE(const FECalcType &t_CalcType,
                                                              m_LocalShp,
                                                              m_SubK,
                                                              m_SubR);
-                                assembleLocalJacobian2GlobalK(m_SubElmtDofs,m_SubElmtDofIDs,GlobalI,GlobalJ,JxW,t_DofHandler,m_SubK,AMATRIX);
+                                m_QpSubK[(i-1)*m_BulkElmtNodesNum+j-1]=m_SubK;
                             } // end-of-J-loop
-                        }
-                    } // end-of-I-loop
-                }// end-of-residual-calculation
-                else if (t_CalcType==FECalcType::COMPUTEJACOBIAN) {
-                    for (int i=1;i<=m_BulkElmtNodesNum;i++) {
-                        m_LocalShp.m_Test=t_FE.m_BulkShp.shape_value(i);
-                        m_LocalShp.m_GradTest=t_FE.m_BulkShp.shape_grad(i);
-                        GlobalI=MyLocalCellVec[e-1].ElmtConn[i-1];
-                        for (int j=1;j<=m_BulkElmtNodesNum;j++) {
-                            m_LocalShp.m_Trial=t_FE.m_BulkShp.shape_value(j);
-                            m_LocalShp.m_GradTrial=t_FE.m_BulkShp.shape_grad(j);
-                            GlobalJ=MyLocalCellVec[e-1].ElmtConn[j-1];
-                            t_ElmtSystem.runBulkElmtLibs(t_CalcType,
-                                                         Ctan,
-                                                         SubElmtBlockID,
-                                                         t_MateSystem.m_MaterialContainerOld,
-                                                         t_MateSystem.m_MaterialContainer,
-                                                         m_LocalElmtInfo,
-                                                         m_LocalElmtSoln,
-                                                         m_LocalShp,
-                                                         m_SubK,
-                                                         m_SubR);
-                            assembleLocalJacobian2GlobalK(m_SubElmtDofs,m_SubElmtDofIDs,GlobalI,GlobalJ,JxW,t_DofHandler,m_SubK,AMATRIX);
-                        } // end-of-J-loop
-                    } // end-of-I-loop
-                }// end-of-jacobian-calculation
+                        } // end-of-I-loop
+                    }
+                    {
+                        // the insertion order is the same as the kernel order, so the summation order is not changed
+                        ProfilerScope InsertionScope("petsc-insertion");
+                        for (int i=1;i<=m_BulkElmtNodesNum;i++) {
+                            GlobalI=MyLocalCellVec[e-1].ElmtConn[i-1];
+                            if(HasResidual){
+                                assembleLocalResidual2GlobalR(m_SubElmtDofs,
+                                                              m_SubElmtDofIDs,
+                                                              GlobalI,
+                                                              t_DofHandler,
+                                                              JxW,m_QpSubR[i-1],
+                                                              RHS);
+                            }
+                            if(!HasJacobian) continue;
+                            for (int j=1;j<=m_BulkElmtNodesNum;j++) {
+                                GlobalJ=MyLocalCellVec[e-1].ElmtConn[j-1];
+                                assembleLocalJacobian2GlobalK(m_SubElmtDofs,m_SubElmtDofIDs,GlobalI,GlobalJ,JxW,t_DofHandler,
+                                                              m_QpSubK[(i-1)*m_BulkElmtNodesNum+j-1],AMATRIX);
+                            } // end-of-J-loop
+                        } // end-of-I-loop
+                    }
+                }// end-of-residual-and-jacobian-calculation
             } // end-of-sub-element-loop
         }// end-of-qpoints-loop
+        m_LocalElmtInfo.m_IsMeanDilatation=false;
+
+        if(t_CalcType!=FECalcType::INITMATERIAL){
+            assembleHourglassControl(t_CalcType,Ctan,e,MyLocalCellVec[e-1],t_DofHandler,t_ElmtSystem,t_SolnSystem,AMATRIX,RHS);
+        }
+        if(m_MeasureElmtCost) m_LocalElmtCost[e-1]+=MPI_Wtime()-ElmtStart;
     }// end-of-local-element-loop
 
 
     // finish the final assemble
-    if(t_CalcType==FECalcType::COMPUTERESIDUAL) RHS.assemble();
-    if(t_CalcType==FECalcType::COMPUTEJACOBIAN) AMATRIX.assemble();
-    if (t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN) {
-        RHS.assemble();
-        AMATRIX.assemble();
+    {
+        ProfilerScope InsertionScope("petsc-insertion");
+        if(t_CalcType==FECalcType::COMPUTERESIDUAL) RHS.assemble();
+        if(t_CalcType==FECalcType::COMPUTEJACOBIAN) AMATRIX.assemble();
+        if (t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN) {
+            RHS.assemble();
+            AMATRIX.assemble();
+        }
     }
 
 
@@ -0,0 +1,178 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.19
+//+++ Purpose: assemble the lumped mass vector and estimate the
+//+++          stable time increment for the explicit dynamics
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cmath>
+#include <algorithm>
+
+#include "FESystem/BulkFESystem.h"
+#include "Utils/JsonUtils.h"
+
+void BulkFESystem::formBulkLumpedMass(const LumpedMassType &t_LumpType,
+                                      const FECell &t_FECell,
+                                      const DofHandler &t_DofHandler,
+                                      FE &t_FE,
+                                      const ElmtSystem &t_ElmtSystem,
+                                      Vector &Mass){
+    const int BlocksNum=t_ElmtSystem.getBulkElmtBlocksNum();
+    vector<double> BlockDensity(BlocksNum,1.0);
+    vector<vector<int>> BlockDofIDs(BlocksNum);
+    for(int b=1;b<=BlocksNum;b++){
+        const ElmtBlock Block=t_ElmtSystem.getIthBulkElmtBlock(b);
+        BlockDofIDs[b-1]=Block.m_DofIDs;
+        if(JsonUtils::hasValue(Block.m_JsonParams,"density")){
+            BlockDensity[b-1]=JsonUtils::getValue(Block.m_JsonParams,"density");
+            if(BlockDensity[b-1]<=0.0){
+                MessagePrinter::printErrorTxt("the density of element block-"+to_string(b)+" must be positive, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+        }
+        else{
+            MessagePrinter::printWarningTxt("can\'t find 'density' in element block-"+to_string(b)+", density=1.0 is used for the lumped mass");
+        }
+    }
+
+    Mass.setToZero();
+
+    const vector<SingleMeshCell> &MyLocalCellVec=t_FECell.getLocalBulkFECellVecRef();
+    vector<double> NodalMass,NodalDiag;
+    vector<double> DofDensity(t_DofHandler.getMaxDofsPerNode()+1,0.0);
+    double xi,eta,zeta,w,JxW,ElmtMass,DiagSum;
+    int Dim,NodesNum,SubElmtBlockID;
+    for(int e=1;e<=static_cast<int>(MyLocalCellVec.size());e++){
+        Dim=MyLocalCellVec[e-1].Dim;
+        NodesNum=MyLocalCellVec[e-1].NodesNumPerElmt;
+        m_Nodes=MyLocalCellVec[e-1].ElmtNodeCoords;
+        NodalMass.assign(NodesNum,0.0);
+        NodalDiag.assign(NodesNum,0.0);
+        ElmtMass=0.0;
+        for(int qp=1;qp<=t_FE.m_BulkQpoints.getQPointsNum();qp++){
+            w=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,0);
+            xi=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,1);
+            eta=Dim>=2?t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2):0.0;
+            zeta=Dim==3?t_FE.m_BulkQpoints.getIthPointJthCoord(qp,3):0.0;
+            t_FE.m_BulkShp.calc(xi,eta,zeta,m_Nodes,false);
+            JxW=t_FE.m_BulkShp.getJacDet()*w;
+            ElmtMass+=JxW;
+            for(int i=1;i<=NodesNum;i++){
+                NodalMass[i-1]+=t_FE.m_BulkShp.shape_value(i)*JxW;
+                NodalDiag[i-1]+=t_FE.m_BulkShp.shape_value(i)*t_FE.m_BulkShp.shape_value(i)*JxW;
+            }
+        }
+        if(t_LumpType==LumpedMassType::HRZ){
+            // hinton-rock-zienkiewicz: the consistent diagonal, scaled to keep the element mass
+            DiagSum=0.0;
+            for(const auto &val:NodalDiag) DiagSum+=val;
+            for(int i=0;i<NodesNum;i++) NodalMass[i]=NodalDiag[i]*ElmtMass/DiagSum;
+        }
+
+        // the dof shared by several sub elements only takes the density of the first one
+        std::fill(DofDensity.begin(),DofDensity.end(),0.0);
+        for(int SubElmt=1;SubElmt<=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);SubElmt++){
+            SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
+            for(const auto &dofid:BlockDofIDs[SubElmtBlockID-1]){
+                if(DofDensity[dofid]==0.0) DofDensity[dofid]=BlockDensity[SubElmtBlockID-1];
+            }
+        }
+        for(int i=1;i<=NodesNum;i++){
+            for(int dofid=1;dofid<=t_DofHandler.getMaxDofsPerNode();dofid++){
+                if(DofDensity[dofid]==0.0) continue;
+                Mass.addValue(t_DofHandler.getIthNodeJthDofID(MyLocalCellVec[e-1].ElmtConn[i-1],dofid),
+                              DofDensity[dofid]*NodalMass[i-1]);
+            }
+        }
+    }
+    Mass.assemble();
+
+    /**
+     * the row-sum of the quadratic serendipity elements gives the negative corner masses, the dofs without any
+     * element (i.e., the inactive ones) get the unit mass
+     */
+    PetscInt LocalSize;
+    PetscScalar *vals;
+    int NegativeMasses=0;
+    VecGetLocalSize(Mass.getVectorRef(),&LocalSize);
+    VecGetArray(Mass.getVectorRef(),&vals);
+    for(PetscInt i=0;i<LocalSize;i++){
+        if(vals[i]<0.0) NegativeMasses+=1;
+        else if(vals[i]==0.0) vals[i]=1.0;
+    }
+    VecRestoreArray(Mass.getVectorRef(),&vals);
+    MPI_Allreduce(MPI_IN_PLACE,&NegativeMasses,1,MPI_INT,MPI_SUM,PETSC_COMM_WORLD);
+    if(NegativeMasses>0){
+        MessagePrinter::printErrorTxt(to_string(NegativeMasses)+" negative lumped masses are found, please use the hrz lumped mass for the higher order elements");
+        MessagePrinter::exitAsFem();
+    }
+}
+
+double BulkFESystem::estimateStableDt(const FECell &t_FECell,const ElmtSystem &t_ElmtSystem)const{
+    const int BlocksNum=t_ElmtSystem.getBulkElmtBlocksNum();
+    vector<double> BlockWaveSpeed(BlocksNum,0.0);
+    double E,nu,K,G,lame,rho;
+    for(int b=1;b<=BlocksNum;b++){
+        const nlohmann::json Params=t_ElmtSystem.getIthBulkElmtBlock(b).m_JsonParams;
+        if(JsonUtils::hasValue(Params,"wave-speed")){
+            BlockWaveSpeed[b-1]=JsonUtils::getValue(Params,"wave-speed");
+            continue;
+        }
+        // the dilatational wave speed, c=sqrt((lambda+2G)/rho), follows the parameter sets of the linear elastic material
+        rho=JsonUtils::hasValue(Params,"density")?JsonUtils::getValue(Params,"density"):1.0;
+        lame=G=-1.0;
+        if(JsonUtils::hasValue(Params,"E")&&JsonUtils::hasValue(Params,"nu")){
+            E=JsonUtils::getValue(Params,"E");
+            nu=JsonUtils::getValue(Params,"nu");
+            lame=E*nu/((1.0+nu)*(1.0-2.0*nu));
+            G=0.5*E/(1.0+nu);
+        }
+        else if(JsonUtils::hasValue(Params,"K")&&JsonUtils::hasValue(Params,"G")){
+            K=JsonUtils::getValue(Params,"K");
+            G=JsonUtils::getValue(Params,"G");
+            lame=K-2.0*G/3.0;
+        }
+        else if(JsonUtils::hasValue(Params,"Lame")&&JsonUtils::hasValue(Params,"G")){
+            lame=JsonUtils::getValue(Params,"Lame");
+            G=JsonUtils::getValue(Params,"G");
+        }
+        if(G>0.0&&lame+2.0*G>0.0&&rho>0.0) BlockWaveSpeed[b-1]=std::sqrt((lame+2.0*G)/rho);
+    }
+
+    const vector<SingleMeshCell> &MyLocalCellVec=t_FECell.getLocalBulkFECellVecRef();
+    double Dt=1.0e16;
+    double c,h,dist;
+    for(int e=1;e<=static_cast<int>(MyLocalCellVec.size());e++){
+        c=0.0;
+        for(int SubElmt=1;SubElmt<=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);SubElmt++){
+            c=std::max(c,BlockWaveSpeed[t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt)-1]);
+        }
+        if(c<=0.0) continue;
+        // the smallest node distance, it is a conservative element size for the distorted and the higher order elements
+        const Nodes &ElmtNodes=MyLocalCellVec[e-1].ElmtNodeCoords;
+        h=1.0e16;
+        for(int i=1;i<=MyLocalCellVec[e-1].NodesNumPerElmt;i++){
+            for(int j=i+1;j<=MyLocalCellVec[e-1].NodesNumPerElmt;j++){
+                dist=0.0;
+                for(int k=1;k<=3;k++) dist+=(ElmtNodes(i,k)-ElmtNodes(j,k))*(ElmtNodes(i,k)-ElmtNodes(j,k));
+                h=std::min(h,std::sqrt(dist));
+            }
+        }
+        Dt=std::min(Dt,h/c);
+    }
+    MPI_Allreduce(MPI_IN_PLACE,&Dt,1,MPI_DOUBLE,MPI_MIN,PETSC_COMM_WORLD);
+    if(Dt>=1.0e16){
+        MessagePrinter::printErrorTxt("can\'t estimate the stable dt, please give either 'wave-speed' or the elastic moduli(E,nu or K,G or Lame,G) "
+                                      "in your element block, or disable 'estimate-dt' in the explicit option");
+        MessagePrinter::exitAsFem();
+    }
+    return Dt;
+}
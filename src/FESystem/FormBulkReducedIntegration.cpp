@@ -0,0 +1,122 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.21
+//+++ Purpose: the element averaged quantities of the selective
+//+++          reduced integration and the hourglass control of
+//+++          the single-point quad4/hex8 element
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "FESystem/BulkFESystem.h"
+
+void BulkFESystem::computeReducedIntegration(const int &e,
+                                             const SingleMeshCell &t_Cell,
+                                             const DofHandler &t_DofHandler,
+                                             FE &t_FE,
+                                             const QPoint &t_Qpoints,
+                                             const ElmtSystem &t_ElmtSystem,
+                                             const SolutionSystem &t_SolnSystem){
+    const int SubElmtsNum=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);
+    m_HasReducedIntegration=false;
+    for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+        const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt));
+        if(Block.m_IsSelectiveReduced||Block.m_HourglassCoef>0.0){
+            m_HasReducedIntegration=true;
+            break;
+        }
+    }
+    if(!m_HasReducedIntegration) return;
+
+    m_ReducedIntegration.computeMeanShapeGrad(t_Qpoints,t_FE.m_BulkShp,t_Cell.ElmtNodeCoords,t_Cell.Dim,t_Cell.NodesNumPerElmt);
+    m_SubElmtMeanDilatation.assign(SubElmtsNum,0.0);
+    m_HourglassModulus.assign(SubElmtsNum,0.0);
+    m_ReducedNodalU.assign(3*t_Cell.NodesNumPerElmt,0.0);
+    for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+        const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt));
+        if(!Block.m_IsSelectiveReduced) continue;
+        // the first 'dim' dofs of the mechanics element are the displacements
+        const int DispNum=std::min(t_Cell.Dim,static_cast<int>(Block.m_DofIDs.size()));
+        for(int i=1;i<=t_Cell.NodesNumPerElmt;i++){
+            for(int k=1;k<=DispNum;k++){
+                m_ReducedNodalU[(i-1)*3+k-1]=t_SolnSystem.m_Utemp.getIthValueFromGhost(t_DofHandler.getIthNodeJthDofID(t_Cell.ElmtConn[i-1],Block.m_DofIDs[k-1]));
+            }
+        }
+        m_SubElmtMeanDilatation[SubElmt-1]=m_ReducedIntegration.getMeanDilatation(m_ReducedNodalU.data());
+    }
+}
+
+void BulkFESystem::assembleHourglassControl(const FECalcType &t_CalcType,
+                                            const double (&Ctan)[3],
+                                            const int &e,
+                                            const SingleMeshCell &t_Cell,
+                                            const DofHandler &t_DofHandler,
+                                            const ElmtSystem &t_ElmtSystem,
+                                            const SolutionSystem &t_SolnSystem,
+                                            SparseMatrix &AMATRIX,
+                                            Vector &RHS){
+    if(!m_HasReducedIntegration) return;
+    const int SubElmtsNum=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);
+    const int NodesNum=t_Cell.NodesNumPerElmt;
+    const int Dim=t_Cell.Dim;
+    bool IsHourglassReady=false;
+    int SubElmtBlockID,DispNum;
+    double Kappa,Gij;
+    double Q[4][3];
+    for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+        SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
+        const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID);
+        if(Block.m_HourglassCoef<=0.0) continue;
+        if(!IsHourglassReady){
+            m_ReducedIntegration.computeHourglassVectors(t_Cell.CellMeshType,t_Cell.ElmtNodeCoords);
+            IsHourglassReady=true;
+        }
+        Kappa=m_ReducedIntegration.getHourglassStiffness(Block.m_HourglassCoef,m_HourglassModulus[SubElmt-1]);
+        DispNum=std::min(Dim,static_cast<int>(Block.m_DofIDs.size()));
+        m_SubElmtDofs=static_cast<int>(Block.m_DofIDs.size());
+        for(int i=1;i<=m_SubElmtDofs;i++) m_SubElmtDofIDs[i-1]=Block.m_DofIDs[i-1];
+
+        if(t_CalcType==FECalcType::COMPUTERESIDUAL||t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+            // the hourglass 'strain' q_mk=sum(gamma_mi*u_ik) of each mode
+            for(int i=1;i<=NodesNum;i++){
+                for(int k=1;k<=DispNum;k++){
+                    m_ReducedNodalU[(i-1)*3+k-1]=t_SolnSystem.m_Utemp.getIthValueFromGhost(t_DofHandler.getIthNodeJthDofID(t_Cell.ElmtConn[i-1],Block.m_DofIDs[k-1]));
+                }
+            }
+            for(int m=1;m<=m_ReducedIntegration.getHourglassModesNum();m++){
+                for(int k=1;k<=DispNum;k++){
+                    Q[m-1][k-1]=0.0;
+                    for(int i=1;i<=NodesNum;i++) Q[m-1][k-1]+=m_ReducedIntegration.getIthModeJthNodeGamma(m,i)*m_ReducedNodalU[(i-1)*3+k-1];
+                }
+            }
+            for(int i=1;i<=NodesNum;i++){
+                m_SubR.setToZero();
+                for(int k=1;k<=DispNum;k++){
+                    for(int m=1;m<=m_ReducedIntegration.getHourglassModesNum();m++){
+                        m_SubR(k)+=Kappa*m_ReducedIntegration.getIthModeJthNodeGamma(m,i)*Q[m-1][k-1];
+                    }
+                }
+                assembleLocalResidual2GlobalR(m_SubElmtDofs,m_SubElmtDofIDs,t_Cell.ElmtConn[i-1],t_DofHandler,1.0,m_SubR,RHS);
+            }
+        }
+        if(t_CalcType==FECalcType::COMPUTEJACOBIAN||t_CalcType==FECalcType::COMPUTERESIDUALANDJACOBIAN){
+            for(int i=1;i<=NodesNum;i++){
+                for(int j=1;j<=NodesNum;j++){
+                    Gij=0.0;
+                    for(int m=1;m<=m_ReducedIntegration.getHourglassModesNum();m++){
+                        Gij+=m_ReducedIntegration.getIthModeJthNodeGamma(m,i)*m_ReducedIntegration.getIthModeJthNodeGamma(m,j);
+                    }
+                    m_SubK.setToZero();
+                    for(int k=1;k<=DispNum;k++) m_SubK(k,k)=Kappa*Gij*Ctan[0];
+                    assembleLocalJacobian2GlobalK(m_SubElmtDofs,m_SubElmtDofIDs,t_Cell.ElmtConn[i-1],t_Cell.ElmtConn[j-1],1.0,t_DofHandler,m_SubK,AMATRIX);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,178 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.20
+//+++ Purpose: pack the qpoints solution of one element into the
+//+++          SoA arrays, then call the batched material kernels
+//+++          once for each sub element, and check them against
+//+++          the qpoint-by-qpoint ones if it is asked
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cmath>
+#include <algorithm>
+
+#include "FESystem/BulkFESystem.h"
+#include "Utils/Profiler.h"
+
+void BulkFESystem::runBatchMaterials(const int &e,
+                                     const SingleMeshCell &t_Cell,
+                                     const DofHandler &t_DofHandler,
+                                     FE &t_FE,
+                                     const ElmtSystem &t_ElmtSystem,
+                                     MateSystem &t_MateSystem,
+                                     const SolutionSystem &t_SolnSystem){
+    const int SubElmtsNum=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);
+    if(static_cast<int>(m_IsBatchedSubElmt.size())<SubElmtsNum){
+        m_IsBatchedSubElmt.resize(SubElmtsNum,false);
+        m_BatchMateInputs.resize(SubElmtsNum);
+        m_BatchMateOutputs.resize(SubElmtsNum);
+    }
+    if(SubElmtsNum<1) return;
+    const QPoint &Qpoints=t_FE.getIthBlockBulkQpoints(t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,1));
+    const int QpointsNum=Qpoints.getQPointsNum();
+    bool HasBatchedSubElmt=false;
+    int SubElmtBlockID;
+    for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+        SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
+        const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID);
+        m_IsBatchedSubElmt[SubElmt-1]=Block.m_UseBatchMate&&BulkMateSystem::hasBatchMateLibs(Block.m_MateType);
+        if(!m_IsBatchedSubElmt[SubElmt-1]) continue;
+        HasBatchedSubElmt=true;
+        BatchMaterialInput &Input=m_BatchMateInputs[SubElmt-1];
+        Input.resize(QpointsNum,static_cast<int>(Block.m_DofIDs.size()));
+        Input.m_Dim=t_Cell.Dim;
+        Input.m_T=m_LocalElmtInfo.m_T;
+        Input.m_Dt=m_LocalElmtInfo.m_Dt;
+    }
+    if(!HasBatchedSubElmt) return;
+
+    double xi,eta,zeta,val,shp;
+    int GlobalDofID;
+    for(int qp=1;qp<=QpointsNum;qp++){
+        xi=Qpoints.getIthPointJthCoord(qp,1);
+        eta=t_Cell.Dim>=2?Qpoints.getIthPointJthCoord(qp,2):0.0;
+        zeta=t_Cell.Dim==3?Qpoints.getIthPointJthCoord(qp,3):0.0;
+        {
+            ProfilerScope ShapeScope("shape-functions");
+            t_FE.m_BulkShp.calc(xi,eta,zeta,t_Cell.ElmtNodeCoords,true);
+        }
+
+        t_SolnSystem.loadLocalQpMaterialsOld(e,qp,t_MateSystem.m_MaterialContainerOld);
+        for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+            if(!m_IsBatchedSubElmt[SubElmt-1]) continue;
+            SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
+            const vector<int> &DofIDs=t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_DofIDs;
+            BatchMaterialInput &Input=m_BatchMateInputs[SubElmt-1];
+            for(int i=1;i<=Input.m_DofsNum;i++){
+                double *U=Input.U(i);
+                double *dUdx=Input.GradU(i,1);
+                double *dUdy=Input.GradU(i,2);
+                double *dUdz=Input.GradU(i,3);
+                for(int j=1;j<=t_Cell.NodesNumPerElmt;j++){
+                    GlobalDofID=t_DofHandler.getIthNodeJthDofID(t_Cell.ElmtConn[j-1],DofIDs[i-1]);
+                    val=t_SolnSystem.m_Utemp.getIthValueFromGhost(GlobalDofID);
+                    shp=t_FE.m_BulkShp.shape_value(j);
+                    U[qp-1]+=shp*val;
+                    dUdx[qp-1]+=t_FE.m_BulkShp.shape_grad(j)(1)*val;
+                    dUdy[qp-1]+=t_FE.m_BulkShp.shape_grad(j)(2)*val;
+                    dUdz[qp-1]+=t_FE.m_BulkShp.shape_grad(j)(3)*val;
+                }
+            }
+            if(t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_IsSelectiveReduced){
+                // the same mean dilatation as the qpoint-by-qpoint path in formBulkFE
+                const int DispNum=std::min(t_Cell.Dim,Input.m_DofsNum);
+                double Div=0.0;
+                for(int k=1;k<=DispNum;k++) Div+=Input.GradU(k,k)[qp-1];
+                for(int k=1;k<=DispNum;k++) Input.GradU(k,k)[qp-1]+=(m_SubElmtMeanDilatation[SubElmt-1]-Div)/t_Cell.Dim;
+            }
+            Input.packMaterialsOld(qp-1,t_MateSystem.m_MaterialContainerOld);
+        }
+    }
+
+    {
+        ProfilerScope MateScope("materials");
+        for(int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++){
+            if(!m_IsBatchedSubElmt[SubElmt-1]) continue;
+            SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
+            t_MateSystem.runBulkMateLibsBatch(t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_MateType,
+                                              t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_JsonParams,
+                                              m_BatchMateInputs[SubElmt-1],
+                                              m_BatchMateOutputs[SubElmt-1]);
+        }
+    }
+}
+
+void BulkFESystem::checkBatchMaterials(const int &e,const int &qp,
+                                       const ElmtBlock &t_Block,
+                                       MateSystem &t_MateSystem){
+    // the unpacked batched results are kept, the qpoint-by-qpoint ones are only used for the comparison
+    MaterialsContainer BatchMate=t_MateSystem.m_MaterialContainer;
+    t_MateSystem.runBulkMateLibs(t_Block.m_MateType,t_Block.m_JsonParams,m_LocalElmtInfo,m_LocalElmtSoln);
+
+    const double Tol=1.0e-8;
+    string MismatchName;
+    auto isClose=[&Tol](const double &a,const double &b){
+        return std::abs(a-b)<=Tol*std::max(1.0,std::abs(b));
+    };
+    for(const auto &it:BatchMate.getScalarMaterialsRef()){
+        const ScalarMateType &Mate=t_MateSystem.m_MaterialContainer.getScalarMaterialsRef();
+        if(Mate.count(it.first)<1||!isClose(it.second,Mate.at(it.first))){
+            MismatchName=it.first;break;
+        }
+    }
+    for(const auto &it:BatchMate.getVectorMaterialsRef()){
+        if(!MismatchName.empty()) break;
+        const VectorMateType &Mate=t_MateSystem.m_MaterialContainer.getVectorMaterialsRef();
+        if(Mate.count(it.first)<1){
+            MismatchName=it.first;break;
+        }
+        for(int i=1;i<=3&&MismatchName.empty();i++){
+            if(!isClose(it.second(i),Mate.at(it.first)(i))) MismatchName=it.first;
+        }
+    }
+    for(const auto &it:BatchMate.getRank2MaterialsRef()){
+        if(!MismatchName.empty()) break;
+        const Rank2MateType &Mate=t_MateSystem.m_MaterialContainer.getRank2MaterialsRef();
+        if(Mate.count(it.first)<1){
+            MismatchName=it.first;break;
+        }
+        for(int i=1;i<=3&&MismatchName.empty();i++){
+            for(int j=1;j<=3;j++){
+                if(!isClose(it.second(i,j),Mate.at(it.first)(i,j))){
+                    MismatchName=it.first;break;
+                }
+            }
+        }
+    }
+    for(const auto &it:BatchMate.getRank4MaterialsRef()){
+        if(!MismatchName.empty()) break;
+        const Rank4MateType &Mate=t_MateSystem.m_MaterialContainer.getRank4MaterialsRef();
+        if(Mate.count(it.first)<1){
+            MismatchName=it.first;break;
+        }
+        for(int i=1;i<=3&&MismatchName.empty();i++){
+            for(int j=1;j<=3&&MismatchName.empty();j++){
+                for(int k=1;k<=3&&MismatchName.empty();k++){
+                    for(int l=1;l<=3;l++){
+                        if(!isClose(it.second(i,j,k,l),Mate.at(it.first)(i,j,k,l))){
+                            MismatchName=it.first;break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    if(!MismatchName.empty()){
+        MessagePrinter::printErrorTxt("the batched material '"+MismatchName+"' of "+t_Block.m_ElmtBlockName+" differs from the qpoint-by-qpoint one at the "+
+                                      to_string(qp)+"-th qpoint of the "+to_string(e)+"-th local element");
+        MessagePrinter::exitAsFem();
+    }
+    t_MateSystem.m_MaterialContainer=BatchMate;
+}
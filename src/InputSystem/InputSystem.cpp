@@ -19,6 +19,7 @@ InputSystem::InputSystem(){
     m_MeshFileName.clear();
     m_Json.clear();
     m_ReadOnly=false;
+    m_Profile=false;
 }
 InputSystem::~InputSystem(){
     m_InputFileName.clear();
@@ -27,15 +28,18 @@ InputSystem::~InputSystem(){
 }
 InputSystem::InputSystem(int args,char *argv[]){
     m_ReadOnly=false;
+    m_Profile=false;
     if(args==1){
         // ./asfem or asfem
         m_InputFileName.clear();
         m_MeshFileName.clear();
         m_ReadOnly=false;
+    m_Profile=false;
     }
     else if(args==3){
         // ./asfem -i input.json or asfem -i input.json
         m_ReadOnly=false;
+    m_Profile=false;
         if(string(argv[1]).find("-i")!=string::npos){
             if(string(argv[2]).size()<5){
                 MessagePrinter::printErrorTxt("invalid input file name after '-i', it must be xxx.json");
@@ -74,17 +78,22 @@ InputSystem::InputSystem(int args,char *argv[]){
             if(string(argv[i]).find("--read-only")!=string::npos){
                 m_ReadOnly=true;
             }
+            else if(string(argv[i]).find("--profile")!=string::npos){
+                m_Profile=true;
+            }
         }
     }
 }
 //*************************************************
 void InputSystem::init(int args,char *argv[]){
     m_ReadOnly=false;
+    m_Profile=false;
     if(args==1){
         // ./asfem or asfem
         m_InputFileName.clear();
         m_MeshFileName.clear();
         m_ReadOnly=false;
+    m_Profile=false;
     }
     else if(args==3){
         // ./asfem -i input.json or asfem -i input.json
@@ -126,6 +135,9 @@ void InputSystem::init(int args,char *argv[]){
             if(string(argv[i]).find("--read-only")!=string::npos){
                 m_ReadOnly=true;
             }
+            else if(string(argv[i]).find("--profile")!=string::npos){
+                m_Profile=true;
+            }
         }
     }
 }
\ No newline at end of file
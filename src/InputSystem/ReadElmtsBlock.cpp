@@ -318,6 +318,39 @@ bool InputSystem::readElmtsBlock(nlohmann::json &t_json,const FECell &t_fecell,c
             else{
                 elmtBlock.m_JsonParams=ejson.at("material").at("parameters");
             }//for-parameters-in-materials
+
+            // the qpoint values of these materials are stored in single precision, they are still computed in double
+            elmtBlock.m_SinglePrecisionMateNames.clear();
+            if(ejson.at("material").contains("single-precision")){
+                if(!ejson.at("material").at("single-precision").is_array()){
+                    MessagePrinter::printErrorTxt("'single-precision' in the 'material' of element block-"+to_string(blocks)+" must be an array of material names, i.e., [\"stress\",\"jacobian\"]");
+                    MessagePrinter::exitAsFem();
+                }
+                for(const auto &it:ejson.at("material").at("single-precision")){
+                    if(!it.is_string()||it.get<string>().size()<1){
+                        MessagePrinter::printErrorTxt("invalid material name in 'single-precision' of element block-"+to_string(blocks)+", please check your input file");
+                        MessagePrinter::exitAsFem();
+                    }
+                    elmtBlock.m_SinglePrecisionMateNames.push_back(it.get<string>());
+                }
+            }
+
+            // the batched material kernel is used by default, 'check' also runs the qpoint-by-qpoint one for comparison
+            elmtBlock.m_UseBatchMate=true;
+            elmtBlock.m_CheckBatchMate=false;
+            if(ejson.at("material").contains("batch")){
+                if(ejson.at("material").at("batch").is_boolean()){
+                    elmtBlock.m_UseBatchMate=ejson.at("material").at("batch");
+                }
+                else if(ejson.at("material").at("batch").is_string()&&
+                        ejson.at("material").at("batch").get<string>()=="check"){
+                    elmtBlock.m_CheckBatchMate=true;
+                }
+                else{
+                    MessagePrinter::printErrorTxt("invalid 'batch' in the 'material' of element block-"+to_string(blocks)+", it must be true, false, or \"check\"");
+                    MessagePrinter::exitAsFem();
+                }
+            }
         }
         else{
             MessagePrinter::printWarningTxt("can\'t find 'material' in element block-"+to_string(blocks)+", then no materials will be used");
@@ -326,6 +359,63 @@ bool InputSystem::readElmtsBlock(nlohmann::json &t_json,const FECell &t_fecell,c
             elmtBlock.m_MateType=MateType::NULLMATE;
         } //end-of-'material'-reading
 
+        if(ejson.contains("qpoints")){
+            // the block-wise integration rule, it overrides the global 'bulk' qpoints for the elements of current block
+            auto json_qpoints=ejson.at("qpoints");
+            if(json_qpoints.contains("type")){
+                if(!json_qpoints.at("type").is_string()){
+                    MessagePrinter::printErrorTxt("invalid qpoint type in the 'qpoints' of element block-"+to_string(blocks)+", please check your input file");
+                    MessagePrinter::exitAsFem();
+                }
+                string qtype=json_qpoints.at("type");
+                if(qtype.find("gauss-legendre")!=string::npos){
+                    elmtBlock.m_QPointType=QPointType::GAUSSLEGENDRE;
+                }
+                else if(qtype.find("gauss-lobatto")!=string::npos){
+                    elmtBlock.m_QPointType=QPointType::GAUSSLOBATTO;
+                }
+                else{
+                    MessagePrinter::printErrorTxt("unsupported qpoint type(="+qtype+") in the 'qpoints' of element block-"+to_string(blocks)+", only gauss-legendre and gauss-lobatto are supported");
+                    MessagePrinter::exitAsFem();
+                }
+                elmtBlock.m_HasOwnQPoints=true;
+            }
+            if(json_qpoints.contains("order")){
+                if(!json_qpoints.at("order").is_number_integer()){
+                    MessagePrinter::printErrorTxt("the value of 'order=' option is invalid in the 'qpoints' of element block-"+to_string(blocks)+", please check your input file");
+                    MessagePrinter::exitAsFem();
+                }
+                elmtBlock.m_QPointOrder=json_qpoints.at("order");
+                if(elmtBlock.m_QPointOrder<0){
+                    MessagePrinter::printErrorTxt("order="+to_string(elmtBlock.m_QPointOrder)+" is invalid in the 'qpoints' of element block-"+to_string(blocks)+", please check your input file");
+                    MessagePrinter::exitAsFem();
+                }
+                elmtBlock.m_HasOwnQPoints=true;
+            }
+            if(json_qpoints.contains("selective-reduced")){
+                if(!json_qpoints.at("selective-reduced").is_boolean()){
+                    MessagePrinter::printErrorTxt("'selective-reduced' in the 'qpoints' of element block-"+to_string(blocks)+" must be true or false");
+                    MessagePrinter::exitAsFem();
+                }
+                elmtBlock.m_IsSelectiveReduced=json_qpoints.at("selective-reduced");
+            }
+            if(json_qpoints.contains("hourglass")){
+                if(!json_qpoints.at("hourglass").is_number()){
+                    MessagePrinter::printErrorTxt("'hourglass' in the 'qpoints' of element block-"+to_string(blocks)+" must be a number");
+                    MessagePrinter::exitAsFem();
+                }
+                elmtBlock.m_HourglassCoef=json_qpoints.at("hourglass");
+                if(elmtBlock.m_HourglassCoef<0.0){
+                    MessagePrinter::printErrorTxt("'hourglass' in the 'qpoints' of element block-"+to_string(blocks)+" must be non-negative");
+                    MessagePrinter::exitAsFem();
+                }
+            }
+            if((elmtBlock.m_IsSelectiveReduced||elmtBlock.m_HourglassCoef>0.0)&&elmtBlock.m_ElmtType!=ElmtType::MECHANICSELMT){
+                MessagePrinter::printErrorTxt("'selective-reduced' and 'hourglass' in element block-"+to_string(blocks)+" are only supported by the 'mechanics' element");
+                MessagePrinter::exitAsFem();
+            }
+        }//end-of-'qpoints'-reading
+
         if(!HasType || !HasDofs){
             MessagePrinter::printErrorTxt("information in '"+elmtBlock.m_ElmtBlockName
                                          +"' of your 'elmts' subblock is not complete, please check your input file");
@@ -99,8 +99,16 @@ bool InputSystem::readInputFile(FECell &t_fecell,DofHandler &t_dofhandler,
 
 
     if(m_Json.contains("mesh")){
+        // try the prepared model cache first, the mesh generation/import is skipped if it is valid
+        if(!m_ModelCache.init(m_InputFileName,m_Json)){
+            MessagePrinter::printErrorTxt("something is incorrect in your 'mesh' block, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+        if(m_ModelCache.isEnabled()&&m_ModelCache.loadFECell(t_fecell)){
+            HasMeshBlock=true;
+        }
         // read the mesh block
-        if(readMeshBlock(m_Json.at("mesh"),t_fecell)){
+        else if(readMeshBlock(m_Json.at("mesh"),t_fecell)){
             HasMeshBlock=true;
         }
         else{
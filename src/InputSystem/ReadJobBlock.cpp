@@ -71,6 +71,51 @@ bool InputSystem::readJobBlock(nlohmann::json &t_json,FEJobBlock &t_jobblock){
         t_jobblock.m_IsDepDebug=false;
     }
 
+    t_jobblock.m_VariantNames.clear();
+    t_jobblock.m_VariantOverrides.clear();
+    if(t_json.contains("ensemble")){
+        // "ensemble":[{"name":"v1","elements":{"elmt1":{"parameters":{"E":1.0}}},"bcs":{"bc1":{"bcvalue":0.1}}}, ...]
+        if(!t_json.at("ensemble").is_array()||t_json.at("ensemble").size()<1){
+            MessagePrinter::printErrorTxt("the 'ensemble' option in your job block must be a non-empty array of variants");
+            return false;
+        }
+        for(const auto &variant:t_json.at("ensemble")){
+            if(!variant.is_object()||!variant.contains("name")||!variant.at("name").is_string()){
+                MessagePrinter::printErrorTxt("each variant in your ensemble must be a json object with a valid 'name' string");
+                return false;
+            }
+            const string name=variant.at("name");
+            if(name.empty()||name.find_first_of("/\\ ")!=string::npos){
+                MessagePrinter::printErrorTxt("variant name='"+name+"' is invalid, it is used in the result file name and can\'t contain spaces or slashes");
+                return false;
+            }
+            if(std::find(t_jobblock.m_VariantNames.begin(),t_jobblock.m_VariantNames.end(),name)!=t_jobblock.m_VariantNames.end()){
+                MessagePrinter::printErrorTxt("variant name='"+name+"' is duplicated in your ensemble, please check your input file");
+                return false;
+            }
+            nlohmann::json overrides;
+            for(auto it=variant.begin();it!=variant.end();it++){
+                if(it.key()=="name") continue;
+                if(it.key()!="elements"&&it.key()!="bcs"&&it.key()!="ics"){
+                    MessagePrinter::printErrorTxt("'"+it.key()+"' is unsupported in variant '"+name+"', only 'elements', 'bcs', and 'ics' can be overridden");
+                    return false;
+                }
+                if(!it.value().is_object()){
+                    MessagePrinter::printErrorTxt("'"+it.key()+"' of variant '"+name+"' must be a json object of block overrides");
+                    return false;
+                }
+                for(auto block=it.value().begin();block!=it.value().end();block++){
+                    if(!block.value().is_object()){
+                        MessagePrinter::printErrorTxt("the override of "+it.key()+" block '"+block.key()+"' in variant '"+name+"' must be a json object");
+                        return false;
+                    }
+                }
+                overrides[it.key()]=it.value();
+            }
+            t_jobblock.m_VariantNames.push_back(name);
+            t_jobblock.m_VariantOverrides.push_back(overrides);
+        }
+    }
 
     return HasType;
 }
\ No newline at end of file
@@ -70,7 +70,9 @@ bool InputSystem::readLinearSolverBlock(nlohmann::json &t_json,LinearSolver &t_s
            pcname=="lu"||
            pcname=="cholesky"||
            pcname=="none"||
-           pcname=="shell"){
+           pcname=="shell"||
+           pcname=="fieldsplit"||
+           pcname=="mg"){
             t_solver.setKSPPCTypeName(pcname);
         }
         else{
@@ -83,6 +85,26 @@ bool InputSystem::readLinearSolverBlock(nlohmann::json &t_json,LinearSolver &t_s
         t_solver.setKSPPCTypeName("bjacobi");
     }
 
+    if(t_json.contains("pc-precision")){
+        if(!t_json.at("pc-precision").is_string()){
+            MessagePrinter::printErrorTxt("the pc-precision of your linear solver block is not a valid string");
+            return false;
+        }
+        string precision=t_json.at("pc-precision");
+        if(precision!="double"&&precision!="single"){
+            MessagePrinter::printErrorTxt("pc-precision="+precision+" is invalid in [linearsolver] block, only double and single are supported");
+            return false;
+        }
+        if(precision=="single"&&t_solver.getPCTypeName()!="ilu"&&t_solver.getPCTypeName()!="bjacobi"){
+            MessagePrinter::printErrorTxt("pc-precision=single is only supported by preconditioner=ilu or bjacobi, please check your input file");
+            return false;
+        }
+        t_solver.setPCPrecisionName(precision);
+    }
+    else{
+        t_solver.setPCPrecisionName("double");
+    }
+
     if(t_json.contains("maxiters")){
         if(!t_json.at("maxiters").is_number_integer()){
             MessagePrinter::printErrorTxt("the maxiters in your linear solver block is not a valid integer,"
@@ -118,6 +140,185 @@ bool InputSystem::readLinearSolverBlock(nlohmann::json &t_json,LinearSolver &t_s
     else{
         t_solver.setSolverTolerance(1.0e-16);
     }
+    //****************************************
+    //*** for the fieldsplit preconditioner
+    //****************************************
+    if(t_solver.getPCTypeName()=="fieldsplit"){
+        if(!t_json.contains("fieldsplit")){
+            MessagePrinter::printErrorTxt("preconditioner=fieldsplit requires the 'fieldsplit' sub-block in your linear solver block,"
+                                          "please check your input file");
+            return false;
+        }
+        nlohmann::json splitjson=t_json.at("fieldsplit");
+        if(splitjson.contains("type")){
+            if(!splitjson.at("type").is_string()){
+                MessagePrinter::printErrorTxt("the type of your fieldsplit block is not a valid string");
+                return false;
+            }
+            string splittype=splitjson.at("type");
+            if(splittype!="additive"&&splittype!="multiplicative"&&
+               splittype!="symmetric-multiplicative"&&splittype!="schur"){
+                MessagePrinter::printErrorTxt("type="+splittype+" is invalid in your fieldsplit block,"
+                                              "only additive, multiplicative, symmetric-multiplicative and schur are supported");
+                return false;
+            }
+            t_solver.setFieldSplitTypeName(splittype);
+        }
+        else{
+            t_solver.setFieldSplitTypeName("multiplicative");
+        }
+        if(splitjson.contains("schur-fact")){
+            if(!splitjson.at("schur-fact").is_string()){
+                MessagePrinter::printErrorTxt("the schur-fact of your fieldsplit block is not a valid string");
+                return false;
+            }
+            string facttype=splitjson.at("schur-fact");
+            if(facttype!="diag"&&facttype!="lower"&&facttype!="upper"&&facttype!="full"){
+                MessagePrinter::printErrorTxt("schur-fact="+facttype+" is invalid in your fieldsplit block,"
+                                              "only diag, lower, upper and full are supported");
+                return false;
+            }
+            t_solver.setSchurFactTypeName(facttype);
+        }
+        if(splitjson.contains("schur-pre")){
+            if(!splitjson.at("schur-pre").is_string()){
+                MessagePrinter::printErrorTxt("the schur-pre of your fieldsplit block is not a valid string");
+                return false;
+            }
+            string pretype=splitjson.at("schur-pre");
+            if(pretype!="self"&&pretype!="selfp"&&pretype!="a11"&&pretype!="full"){
+                MessagePrinter::printErrorTxt("schur-pre="+pretype+" is invalid in your fieldsplit block,"
+                                              "only self, selfp, a11 and full are supported");
+                return false;
+            }
+            t_solver.setSchurPreTypeName(pretype);
+        }
+        if(!splitjson.contains("splits")||!splitjson.at("splits").is_object()){
+            MessagePrinter::printErrorTxt("can\'t find a valid 'splits' in your fieldsplit block, please check your input file");
+            return false;
+        }
+        FieldSplitBlock splitBlock;
+        for(auto it=splitjson.at("splits").begin();it!=splitjson.at("splits").end();++it){
+            splitBlock.init();
+            splitBlock.m_SplitName=it.key();
+            nlohmann::json subjson=it.value();
+            if(!subjson.contains("dofs")||!subjson.at("dofs").is_array()||subjson.at("dofs").size()<1){
+                MessagePrinter::printErrorTxt("can\'t find a valid 'dofs' in split-"+splitBlock.m_SplitName+
+                                              " of your fieldsplit block, please check your input file");
+                return false;
+            }
+            for(const auto &dofname:subjson.at("dofs")){
+                if(!dofname.is_string()){
+                    MessagePrinter::printErrorTxt("the dof name in split-"+splitBlock.m_SplitName+" is not a valid string");
+                    return false;
+                }
+                splitBlock.m_DofNameList.push_back(dofname);
+            }
+            if(subjson.contains("solver")){
+                if(!subjson.at("solver").is_string()){
+                    MessagePrinter::printErrorTxt("the solver in split-"+splitBlock.m_SplitName+" is not a valid string");
+                    return false;
+                }
+                splitBlock.m_KSPTypeName=subjson.at("solver");
+                if(splitBlock.m_KSPTypeName!="preonly"&&splitBlock.m_KSPTypeName!="gmres"&&
+                   splitBlock.m_KSPTypeName!="fgmres"&&splitBlock.m_KSPTypeName!="cg"&&
+                   splitBlock.m_KSPTypeName!="bcgs"&&splitBlock.m_KSPTypeName!="richardson"&&
+                   splitBlock.m_KSPTypeName!="chebyshev"){
+                    MessagePrinter::printErrorTxt("solver="+splitBlock.m_KSPTypeName+" is invalid in split-"+splitBlock.m_SplitName+
+                                                  ", only preonly, gmres, fgmres, cg, bcgs, richardson and chebyshev are supported");
+                    return false;
+                }
+            }
+            if(subjson.contains("preconditioner")){
+                if(!subjson.at("preconditioner").is_string()){
+                    MessagePrinter::printErrorTxt("the preconditioner in split-"+splitBlock.m_SplitName+" is not a valid string");
+                    return false;
+                }
+                splitBlock.m_PCTypeName=subjson.at("preconditioner");
+                if(splitBlock.m_PCTypeName!="jacobi"&&splitBlock.m_PCTypeName!="bjacobi"&&
+                   splitBlock.m_PCTypeName!="sor"&&splitBlock.m_PCTypeName!="ilu"&&
+                   splitBlock.m_PCTypeName!="icc"&&splitBlock.m_PCTypeName!="asm"&&
+                   splitBlock.m_PCTypeName!="gamg"&&splitBlock.m_PCTypeName!="lu"&&
+                   splitBlock.m_PCTypeName!="cholesky"&&splitBlock.m_PCTypeName!="none"){
+                    MessagePrinter::printErrorTxt("preconditioner="+splitBlock.m_PCTypeName+" is invalid in split-"+splitBlock.m_SplitName+
+                                                  ", please check your input file");
+                    return false;
+                }
+            }
+            t_solver.addFieldSplitBlock(splitBlock);
+        }
+    }
+    //****************************************
+    //*** for the geometric multigrid preconditioner
+    //****************************************
+    if(t_solver.getPCTypeName()=="mg"&&t_json.contains("multigrid")){
+        // "multigrid":{"levels":4,"cycle":"v","smoother":"chebyshev","smoother-pc":"sor","smooth-steps":2,"coarse-solver":"redundant"}
+        nlohmann::json mgjson=t_json.at("multigrid");
+        if(!mgjson.is_object()){
+            MessagePrinter::printErrorTxt("the 'multigrid' in your linear solver block must be a json object, please check your input file");
+            return false;
+        }
+        if(mgjson.contains("levels")){
+            if(!mgjson.at("levels").is_number_integer()||mgjson.at("levels")<0){
+                MessagePrinter::printErrorTxt("the levels of your multigrid block is not a valid non-negative integer");
+                return false;
+            }
+            t_solver.setMGLevels(mgjson.at("levels"));
+        }
+        if(mgjson.contains("cycle")){
+            if(!mgjson.at("cycle").is_string()||(mgjson.at("cycle")!="v"&&mgjson.at("cycle")!="w")){
+                MessagePrinter::printErrorTxt("the cycle of your multigrid block is invalid, only v and w are supported");
+                return false;
+            }
+            t_solver.setMGCycleTypeName(mgjson.at("cycle"));
+        }
+        string smoother="chebyshev",smootherpc="sor";
+        int steps=2;
+        if(mgjson.contains("smoother")){
+            if(!mgjson.at("smoother").is_string()){
+                MessagePrinter::printErrorTxt("the smoother of your multigrid block is not a valid string");
+                return false;
+            }
+            smoother=mgjson.at("smoother");
+            if(smoother!="chebyshev"&&smoother!="richardson"&&smoother!="gmres"){
+                MessagePrinter::printErrorTxt("smoother="+smoother+" is invalid in your multigrid block, only chebyshev, richardson and gmres are supported");
+                return false;
+            }
+        }
+        if(mgjson.contains("smoother-pc")){
+            if(!mgjson.at("smoother-pc").is_string()){
+                MessagePrinter::printErrorTxt("the smoother-pc of your multigrid block is not a valid string");
+                return false;
+            }
+            smootherpc=mgjson.at("smoother-pc");
+            if(smootherpc!="sor"&&smootherpc!="jacobi"&&smootherpc!="bjacobi"&&smootherpc!="ilu"){
+                MessagePrinter::printErrorTxt("smoother-pc="+smootherpc+" is invalid in your multigrid block, only sor, jacobi, bjacobi and ilu are supported");
+                return false;
+            }
+        }
+        if(mgjson.contains("smooth-steps")){
+            if(!mgjson.at("smooth-steps").is_number_integer()||mgjson.at("smooth-steps")<1){
+                MessagePrinter::printErrorTxt("the smooth-steps of your multigrid block is not a valid positive integer");
+                return false;
+            }
+            steps=mgjson.at("smooth-steps");
+        }
+        t_solver.setMGSmoother(smoother,smootherpc,steps);
+        if(mgjson.contains("coarse-solver")){
+            if(!mgjson.at("coarse-solver").is_string()){
+                MessagePrinter::printErrorTxt("the coarse-solver of your multigrid block is not a valid string");
+                return false;
+            }
+            string coarsesolver=mgjson.at("coarse-solver");
+            if(coarsesolver!="redundant"&&coarsesolver!="lu"&&coarsesolver!="gamg"&&
+               coarsesolver!="bjacobi"&&coarsesolver!="jacobi"){
+                MessagePrinter::printErrorTxt("coarse-solver="+coarsesolver+" is invalid in your multigrid block,"
+                                              " only redundant, lu, gamg, bjacobi and jacobi are supported");
+                return false;
+            }
+            t_solver.setMGCoarseSolverTypeName(coarsesolver);
+        }
+    }
 
 
     return HasType;
@@ -31,6 +31,32 @@ bool InputSystem::readMeshBlock(nlohmann::json &t_json,FECell &t_fecell){
     meshtype=MeshType::NULLTYPE;
     HasNx=false;HasNy=false;HasNz=false;
     HasMeshType=false;IsSaveMesh=false;
+
+    if(t_json.contains("reorder")){
+        // "reorder":{"elements":"hilbert","nodes":"rcm"}, the mesh is reordered before the distribution
+        if(!t_json.at("reorder").is_object()){
+            MessagePrinter::printErrorTxt("the \"reorder\" in your mesh block must be a json object, i.e., {\"elements\":\"hilbert\",\"nodes\":\"rcm\"}");
+            return false;
+        }
+        MeshReorderType ElmtReorder=MeshReorderType::NONE,NodeReorder=MeshReorderType::NONE;
+        for(auto it=t_json.at("reorder").begin();it!=t_json.at("reorder").end();it++){
+            if(it.key()!="elements"&&it.key()!="nodes"){
+                MessagePrinter::printErrorTxt("'"+it.key()+"' is invalid in the \"reorder\" of your mesh block, only 'elements' and 'nodes' are supported");
+                return false;
+            }
+            MeshReorderType &type=it.key()=="elements"?ElmtReorder:NodeReorder;
+            if(!it.value().is_string()||!FECellReorder::getReorderTypeFromName(it.value(),type)){
+                MessagePrinter::printErrorTxt("the reorder method of '"+it.key()+"' in your mesh block is invalid, it should be none, morton, hilbert or rcm");
+                return false;
+            }
+        }
+        if(ElmtReorder==MeshReorderType::RCM){
+            MessagePrinter::printErrorTxt("rcm is only supported for the nodes, please use morton or hilbert for the elements");
+            return false;
+        }
+        t_fecell.setMeshReorderMethod(ElmtReorder,NodeReorder);
+    }
+
     if(t_json.contains("type")){
         if(!t_json.at("type").is_string()){
             MessagePrinter::printErrorTxt("the type name of your mesh block is not a valid string");
@@ -463,6 +489,38 @@ bool InputSystem::readMeshBlock(nlohmann::json &t_json,FECell &t_fecell){
                 t_fecell.setMeshDistributionMethod("asfem");// using built-in distribution method
             }
 
+            bool IsImplicit=false;
+            if(t_json.contains("implicit")){
+                if(!t_json.at("implicit").is_boolean()){
+                    MessagePrinter::printErrorTxt("invalid boolean value for implicit in your mesh block, it should be true/false");
+                    return false;
+                }
+                IsImplicit=static_cast<bool>(t_json.at("implicit"));
+            }
+            if(IsImplicit&&t_fecell.getMeshDistributionMethod().find("asfem")==string::npos){
+                MessagePrinter::printErrorTxt("the implicit grid only works with the \"asfem\" distribution method, please check your mesh block");
+                return false;
+            }
+            if(IsImplicit&&!ImplicitStructuredGrid::isMeshTypeSupported(meshtype)){
+                MessagePrinter::printWarningTxt("the implicit grid only supports edge2, quad4 and hex8 mesh, the mesh will be generated explicitly");
+                IsImplicit=false;
+            }
+            if(IsImplicit){
+                if(!t_fecell.createImplicitGrid()){
+                    MessagePrinter::printErrorTxt("something is wrong with your implicit grid, please check your input file");
+                    return false;
+                }
+                MessagePrinter::printNormalTxt("implicit grid is created, the global mesh is not stored");
+                if(IsSaveMesh){
+                    t_fecell.saveFECell2VTUFile(m_InputFileName.substr(0,m_InputFileName.size()-5)+"-mesh.vtu");
+                    MessagePrinter::printDashLine(MessageColor::BLUE);
+                    MessagePrinter::printNormalTxt("save mesh to "+m_InputFileName.substr(0,m_InputFileName.size()-5)+"-mesh.vtu",MessageColor::BLUE);
+                    MessagePrinter::printDashLine(MessageColor::BLUE);
+                    MessagePrinter::printStars();
+                }
+                return true;
+            }
+
             FECellGenerator fecellGenerator;
             if(fecellGenerator.createFEMeshCell(meshtype,t_fecell.getCellDataRef())){
                 MessagePrinter::printNormalTxt("mesh generator is done, your mesh is generated");
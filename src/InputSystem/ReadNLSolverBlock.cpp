@@ -27,6 +27,10 @@ bool InputSystem::readNLSolverBlock(nlohmann::json &t_json,NonlinearSolver &t_nl
             t_nlsolver.m_NlSolverBlock.m_NlSolverTypeName="newton-raphson from asfem";
             t_nlsolver.m_NlSolverBlock.m_NlSolverType=NonlinearSolverType::ASFEMNR;
         }
+        else if(solvertypename=="staggered"){
+            t_nlsolver.m_NlSolverBlock.m_NlSolverTypeName="staggered newton-raphson from asfem";
+            t_nlsolver.m_NlSolverBlock.m_NlSolverType=NonlinearSolverType::STAGGERED;
+        }
         else if(solvertypename=="newton"){
             t_nlsolver.m_NlSolverBlock.m_NlSolverTypeName="newton with line search";
             t_nlsolver.m_NlSolverBlock.m_NlSolverType=NonlinearSolverType::NEWTONLS;
@@ -125,6 +129,220 @@ bool InputSystem::readNLSolverBlock(nlohmann::json &t_json,NonlinearSolver &t_nl
     else{
         t_nlsolver.m_NlSolverBlock.m_STol=0.0;
     }
+    //**********************************************
+    //*** for the jacobian lagging (modified newton) of asfem's NR solver
+    //**********************************************
+    if(t_json.contains("jacobian-lag")){
+        if(!t_json.at("jacobian-lag").is_number_integer()){
+            MessagePrinter::printErrorTxt("the jacobian-lag in your nlsolver block is not a valid integer,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_JacobianLagIters=t_json.at("jacobian-lag");
+        if(t_nlsolver.m_NlSolverBlock.m_JacobianLagIters<1){
+            MessagePrinter::printErrorTxt("jacobian-lag="+to_string(t_nlsolver.m_NlSolverBlock.m_JacobianLagIters)+
+                                          " is invalid in your nlsolver block, it should be >=1");
+            return false;
+        }
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_JacobianLagIters=1;
+    }
+    //**********************************************
+    if(t_json.contains("jacobian-lag-across-steps")){
+        if(!t_json.at("jacobian-lag-across-steps").is_boolean()){
+            MessagePrinter::printErrorTxt("the jacobian-lag-across-steps in your nlsolver block is not a valid boolean,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_LagJacobianAcrossSteps=t_json.at("jacobian-lag-across-steps");
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_LagJacobianAcrossSteps=false;
+    }
+    //**********************************************
+    if(t_json.contains("jacobian-refresh-ratio")){
+        if(!t_json.at("jacobian-refresh-ratio").is_number_float()){
+            MessagePrinter::printErrorTxt("the jacobian-refresh-ratio in your nlsolver block is not a valid float,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_JacobianRefreshRatio=t_json.at("jacobian-refresh-ratio");
+        if(t_nlsolver.m_NlSolverBlock.m_JacobianRefreshRatio<=0.0){
+            MessagePrinter::printErrorTxt("the jacobian-refresh-ratio in your nlsolver block must be positive,"
+                                          "please check your input file");
+            return false;
+        }
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_JacobianRefreshRatio=0.5;
+    }
+    //**********************************************
+    //*** for the inexact newton (Eisenstat-Walker) of asfem's NR solver
+    //**********************************************
+    if(t_json.contains("forcing-term")){
+        if(!t_json.at("forcing-term").is_string()){
+            MessagePrinter::printErrorTxt("the forcing-term in your nlsolver block is not a valid string,"
+                                          "please check your input file");
+            return false;
+        }
+        string forcingname=t_json.at("forcing-term");
+        if(forcingname=="none"){
+            t_nlsolver.m_NlSolverBlock.m_ForcingTermType=ForcingTermType::NONE;
+        }
+        else if(forcingname=="ew1"){
+            t_nlsolver.m_NlSolverBlock.m_ForcingTermType=ForcingTermType::EW1;
+        }
+        else if(forcingname=="ew2"){
+            t_nlsolver.m_NlSolverBlock.m_ForcingTermType=ForcingTermType::EW2;
+        }
+        else{
+            MessagePrinter::printErrorTxt("forcing-term="+forcingname+" is invalid in [nlsolver] block, only none, ew1 and ew2 are supported");
+            return false;
+        }
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_ForcingTermType=ForcingTermType::NONE;
+    }
+    //**********************************************
+    if(t_json.contains("eta0")){
+        if(!t_json.at("eta0").is_number_float()){
+            MessagePrinter::printErrorTxt("the eta0 in your nlsolver block is not a valid float,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_Eta0=t_json.at("eta0");
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_Eta0=0.3;
+    }
+    //**********************************************
+    if(t_json.contains("eta-max")){
+        if(!t_json.at("eta-max").is_number_float()){
+            MessagePrinter::printErrorTxt("the eta-max in your nlsolver block is not a valid float,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_EtaMax=t_json.at("eta-max");
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_EtaMax=0.9;
+    }
+    //**********************************************
+    if(t_json.contains("eta-min")){
+        if(!t_json.at("eta-min").is_number_float()){
+            MessagePrinter::printErrorTxt("the eta-min in your nlsolver block is not a valid float,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_EtaMin=t_json.at("eta-min");
+    }
+    else{
+        t_nlsolver.m_NlSolverBlock.m_EtaMin=1.0e-10;
+    }
+    if(t_nlsolver.m_NlSolverBlock.m_EtaMin<=0.0||
+       t_nlsolver.m_NlSolverBlock.m_EtaMin>t_nlsolver.m_NlSolverBlock.m_EtaMax||
+       t_nlsolver.m_NlSolverBlock.m_EtaMax>=1.0){
+        MessagePrinter::printErrorTxt("eta-min and eta-max in your nlsolver block must satisfy 0<eta-min<=eta-max<1,"
+                                      "please check your input file");
+        return false;
+    }
+    if(t_nlsolver.m_NlSolverBlock.m_NlSolverType!=NonlinearSolverType::ASFEMNR&&
+       t_nlsolver.m_NlSolverBlock.m_ForcingTermType!=ForcingTermType::NONE){
+        MessagePrinter::printWarningTxt("forcing-term only works for type=asfem, please use -snes_ksp_ew for the SNES solvers");
+    }
+    //**********************************************
+    //*** for the staggered solver
+    //**********************************************
+    if(t_nlsolver.m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED){
+        if(!t_json.contains("staggered")){
+            MessagePrinter::printErrorTxt("type=staggered requires the 'staggered' sub-block in your nlsolver block,"
+                                          "please check your input file");
+            return false;
+        }
+        nlohmann::json sjson=t_json.at("staggered");
+        if(sjson.contains("maxiters")){
+            if(!sjson.at("maxiters").is_number_integer()){
+                MessagePrinter::printErrorTxt("the maxiters in your staggered block is not a valid integer,"
+                                              "please check your input file");
+                return false;
+            }
+            t_nlsolver.m_NlSolverBlock.m_StaggeredMaxIters=sjson.at("maxiters");
+        }
+        else{
+            t_nlsolver.m_NlSolverBlock.m_StaggeredMaxIters=50;
+        }
+        if(sjson.contains("abs-tolerance")){
+            if(!sjson.at("abs-tolerance").is_number_float()){
+                MessagePrinter::printErrorTxt("the abs-tolerance in your staggered block is not a valid float,"
+                                              "please check your input file");
+                return false;
+            }
+            t_nlsolver.m_NlSolverBlock.m_StaggeredAbsTol=sjson.at("abs-tolerance");
+        }
+        else{
+            t_nlsolver.m_NlSolverBlock.m_StaggeredAbsTol=1.0e-7;
+        }
+        if(sjson.contains("rel-tolerance")){
+            if(!sjson.at("rel-tolerance").is_number_float()){
+                MessagePrinter::printErrorTxt("the rel-tolerance in your staggered block is not a valid float,"
+                                              "please check your input file");
+                return false;
+            }
+            t_nlsolver.m_NlSolverBlock.m_StaggeredRelTol=sjson.at("rel-tolerance");
+        }
+        else{
+            t_nlsolver.m_NlSolverBlock.m_StaggeredRelTol=1.0e-5;
+        }
+        // the groups are given as a json array, so the solving order is the one in the input file
+        if(!sjson.contains("groups")||!sjson.at("groups").is_array()||sjson.at("groups").size()<2){
+            MessagePrinter::printErrorTxt("at least 2 field groups are required in the 'groups' of your staggered block,"
+                                          "please check your input file");
+            return false;
+        }
+        t_nlsolver.m_NlSolverBlock.m_StaggeredGroupDofNames.clear();
+        t_nlsolver.m_NlSolverBlock.m_StaggeredGroupPCNames.clear();
+        int ngroups=0;
+        vector<string> dofnames;
+        string pcname;
+        for(const auto &gjson:sjson.at("groups")){
+            ngroups+=1;
+            if(!gjson.contains("dofs")||!gjson.at("dofs").is_array()||gjson.at("dofs").size()<1){
+                MessagePrinter::printErrorTxt("can\'t find a valid 'dofs' in group-"+to_string(ngroups)+
+                                              " of your staggered block, please check your input file");
+                return false;
+            }
+            dofnames.clear();
+            for(const auto &dofname:gjson.at("dofs")){
+                if(!dofname.is_string()){
+                    MessagePrinter::printErrorTxt("the dof name in group-"+to_string(ngroups)+" of your staggered block is not a valid string");
+                    return false;
+                }
+                dofnames.push_back(dofname);
+            }
+            pcname="lu";
+            if(gjson.contains("preconditioner")){
+                if(!gjson.at("preconditioner").is_string()){
+                    MessagePrinter::printErrorTxt("the preconditioner in group-"+to_string(ngroups)+" of your staggered block is not a valid string");
+                    return false;
+                }
+                pcname=gjson.at("preconditioner");
+                if(pcname!="jacobi"&&pcname!="bjacobi"&&pcname!="sor"&&pcname!="ilu"&&
+                   pcname!="icc"&&pcname!="asm"&&pcname!="gamg"&&pcname!="lu"&&
+                   pcname!="cholesky"&&pcname!="none"){
+                    MessagePrinter::printErrorTxt("preconditioner="+pcname+" is invalid in group-"+to_string(ngroups)+
+                                                  " of your staggered block, please check your input file");
+                    return false;
+                }
+            }
+            t_nlsolver.m_NlSolverBlock.m_StaggeredGroupDofNames.push_back(dofnames);
+            t_nlsolver.m_NlSolverBlock.m_StaggeredGroupPCNames.push_back(pcname);
+        }
+    }
+    if(t_nlsolver.m_NlSolverBlock.m_NlSolverType!=NonlinearSolverType::ASFEMNR&&
+       (t_nlsolver.m_NlSolverBlock.m_JacobianLagIters>1||t_nlsolver.m_NlSolverBlock.m_LagJacobianAcrossSteps)){
+        MessagePrinter::printWarningTxt("jacobian lagging only works for type=asfem, it will be ignored by the SNES solvers");
+    }
 
     return HasType;
 }
\ No newline at end of file
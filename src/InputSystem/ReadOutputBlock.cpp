@@ -65,5 +65,29 @@ bool InputSystem::readOutputBlock(nlohmann::json &t_json,OutputSystem &t_output)
         t_output.setIntervalNum(1);
     }
 
+    if(t_json.contains("async")){
+        if(!t_json.at("async").is_boolean()){
+            MessagePrinter::printErrorTxt("the async flag is not valid, it must be true or false, please check your output block");
+            return false;
+        }
+        t_output.setAsyncOutput(t_json.at("async"));
+    }
+    else{
+        t_output.setAsyncOutput(false);
+    }
+
+    if(t_json.contains("queue-depth")){
+        if(!t_json.at("queue-depth").is_number_integer()){
+            MessagePrinter::printErrorTxt("the queue-depth value is not valid, please check your output block");
+            return false;
+        }
+        int depth=t_json.at("queue-depth");
+        if(depth<1){
+            MessagePrinter::printErrorTxt("queue-depth="+to_string(depth)+" is invalid, it must be >=1, please check your output block");
+            return false;
+        }
+        t_output.setQueueDepth(depth);
+    }
+
     return HasType;
 }
\ No newline at end of file
@@ -51,6 +51,9 @@ bool InputSystem::readPostprocessBlock(nlohmann::json &t_json,
             else if(ppsblock.m_pps_typename=="nodalrank4mate"){
                 ppsblock.m_pps_type=PostprocessorType::NODALRANK4MATERIALVALUE;
             }
+            else if(ppsblock.m_pps_typename=="pointvalue"){
+                ppsblock.m_pps_type=PostprocessorType::POINTVALUE;
+            }
             // for side integral type pps
             else if(ppsblock.m_pps_typename=="area"){
                 ppsblock.m_pps_type=PostprocessorType::AREA;
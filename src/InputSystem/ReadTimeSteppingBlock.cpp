@@ -18,6 +18,7 @@ bool InputSystem::readTimeSteppingBlock(nlohmann::json &t_json,TimeStepping &t_t
     // the json already contains "nlsolver" block
     bool HasType;
     bool Adaptive=false;
+    bool IsExplicit=false;
     if(t_json.contains("type")){
         if(!t_json.at("type").is_string()){
             MessagePrinter::printErrorTxt("the type name of your timestepping block is not a valid string");
@@ -42,6 +43,11 @@ bool InputSystem::readTimeSteppingBlock(nlohmann::json &t_json,TimeStepping &t_t
                 solvertypename=="BDF2"){
             t_timestepping.setTimeSteppingMethod(TimeSteppingType::BDF2);
         }
+        else if(solvertypename=="central-difference"||
+                solvertypename=="explicit"){
+            t_timestepping.setTimeSteppingMethod(TimeSteppingType::EXPLICIT);
+            IsExplicit=true;
+        }
         else{
             MessagePrinter::printErrorTxt("type="+solvertypename+" is invalid in [timestepping] block, please check your input file");
             MessagePrinter::exitAsFem();
@@ -181,7 +187,7 @@ bool InputSystem::readTimeSteppingBlock(nlohmann::json &t_json,TimeStepping &t_t
         }
         t_timestepping.setGrowthFactor(growthfactor);
     }
-    else{
+    else if(!IsExplicit){
         if(Adaptive){
             MessagePrinter::printErrorTxt("can\'t find 'growth-factor' in your timestepping block, please check your input file");
         }
@@ -202,12 +208,204 @@ bool InputSystem::readTimeSteppingBlock(nlohmann::json &t_json,TimeStepping &t_t
         }
         t_timestepping.setCutbackFactor(cutbackfactor);
     }
-    else{
+    else if(!IsExplicit){
         if(Adaptive){
             MessagePrinter::printErrorTxt("can\'t find 'cutback-factor' in your timestepping block, please check your input file");
         }
         return false;
     }
 
+    if(t_json.contains("rebalance")){
+        // "rebalance":{"interval":n,"threshold":x}, check the load balance every n steps
+        nlohmann::json rebalance=t_json.at("rebalance");
+        if(!rebalance.is_object()){
+            MessagePrinter::printErrorTxt("the rebalance option of your timestepping block must be a json object, i.e., {\"interval\":5,\"threshold\":0.2}");
+            return false;
+        }
+        for(auto it=rebalance.begin();it!=rebalance.end();it++){
+            if(it.key()!="interval"&&it.key()!="threshold"){
+                MessagePrinter::printErrorTxt("'"+it.key()+"' is invalid in the rebalance option of your timestepping block, only 'interval' and 'threshold' are supported");
+                return false;
+            }
+        }
+        if(!rebalance.contains("interval")||!rebalance.at("interval").is_number_integer()||rebalance.at("interval").get<int>()<1){
+            MessagePrinter::printErrorTxt("the interval of the rebalance option must be a positive integer, please check your input file");
+            return false;
+        }
+        t_timestepping.setRebalanceInterval(rebalance.at("interval").get<int>());
+        if(rebalance.contains("threshold")){
+            if(!rebalance.at("threshold").is_number()||rebalance.at("threshold").get<double>()<0.0){
+                MessagePrinter::printErrorTxt("the threshold of the rebalance option must be a non-negative float, please check your input file");
+                return false;
+            }
+            t_timestepping.setRebalanceThreshold(rebalance.at("threshold").get<double>());
+        }
+        else{
+            t_timestepping.setRebalanceThreshold(0.2);
+        }
+    }
+    else{
+        t_timestepping.setRebalanceInterval(0);
+    }
+
+    if(t_json.contains("adaptivity")){
+        // "adaptivity":{"interval":n,"dof":"c","marker":"gradient","refine":0.5,"coarsen":0.05,"max-level":2,"initial-steps":2}
+        nlohmann::json adaptivity=t_json.at("adaptivity");
+        if(!adaptivity.is_object()){
+            MessagePrinter::printErrorTxt("the adaptivity option of your timestepping block must be a json object, i.e., {\"interval\":5,\"dof\":\"c\"}");
+            return false;
+        }
+        for(auto it=adaptivity.begin();it!=adaptivity.end();it++){
+            if(it.key()!="interval"&&it.key()!="dof"&&it.key()!="marker"&&it.key()!="refine"&&
+               it.key()!="coarsen"&&it.key()!="max-level"&&it.key()!="initial-steps"){
+                MessagePrinter::printErrorTxt("'"+it.key()+"' is invalid in the adaptivity option of your timestepping block, only 'interval', 'dof', "
+                                              "'marker', 'refine', 'coarsen', 'max-level' and 'initial-steps' are supported");
+                return false;
+            }
+        }
+        if(!adaptivity.contains("interval")||!adaptivity.at("interval").is_number_integer()||adaptivity.at("interval").get<int>()<1){
+            MessagePrinter::printErrorTxt("the interval of the adaptivity option must be a positive integer, please check your input file");
+            return false;
+        }
+        t_timestepping.setMeshAdaptInterval(adaptivity.at("interval").get<int>());
+        if(!adaptivity.contains("dof")||!adaptivity.at("dof").is_string()){
+            MessagePrinter::printErrorTxt("the dof of the adaptivity option must be a dof name, i.e., \"dof\":\"c\", please check your input file");
+            return false;
+        }
+        t_timestepping.setMeshAdaptDofName(adaptivity.at("dof").get<string>());
+        MeshAdaptMarkerType marker=MeshAdaptMarkerType::GRADIENT;
+        if(adaptivity.contains("marker")){
+            if(!adaptivity.at("marker").is_string()){
+                MessagePrinter::printErrorTxt("the marker of the adaptivity option must be a string, please check your input file");
+                return false;
+            }
+            string markername=adaptivity.at("marker").get<string>();
+            if(markername=="gradient"){
+                marker=MeshAdaptMarkerType::GRADIENT;
+            }
+            else if(markername=="value"){
+                marker=MeshAdaptMarkerType::VALUE;
+            }
+            else{
+                MessagePrinter::printErrorTxt("marker="+markername+" is invalid in the adaptivity option, only 'gradient' and 'value' are supported");
+                return false;
+            }
+        }
+        t_timestepping.setMeshAdaptMarker(marker);
+        double refine=0.5,coarsen=0.05;
+        if(adaptivity.contains("refine")){
+            if(!adaptivity.at("refine").is_number()){
+                MessagePrinter::printErrorTxt("the refine threshold of the adaptivity option must be a float, please check your input file");
+                return false;
+            }
+            refine=adaptivity.at("refine").get<double>();
+        }
+        if(adaptivity.contains("coarsen")){
+            if(!adaptivity.at("coarsen").is_number()){
+                MessagePrinter::printErrorTxt("the coarsen threshold of the adaptivity option must be a float, please check your input file");
+                return false;
+            }
+            coarsen=adaptivity.at("coarsen").get<double>();
+        }
+        if(coarsen>=refine){
+            MessagePrinter::printErrorTxt("the coarsen threshold of the adaptivity option must be smaller than the refine one, please check your input file");
+            return false;
+        }
+        t_timestepping.setMeshAdaptThresholds(refine,coarsen);
+        if(adaptivity.contains("max-level")){
+            if(!adaptivity.at("max-level").is_number_integer()||adaptivity.at("max-level").get<int>()<1){
+                MessagePrinter::printErrorTxt("the max-level of the adaptivity option must be a positive integer, please check your input file");
+                return false;
+            }
+            t_timestepping.setMeshAdaptMaxLevel(adaptivity.at("max-level").get<int>());
+        }
+        else{
+            t_timestepping.setMeshAdaptMaxLevel(2);
+        }
+        if(adaptivity.contains("initial-steps")){
+            if(!adaptivity.at("initial-steps").is_number_integer()||adaptivity.at("initial-steps").get<int>()<0){
+                MessagePrinter::printErrorTxt("the initial-steps of the adaptivity option must be a non-negative integer, please check your input file");
+                return false;
+            }
+            t_timestepping.setMeshAdaptInitialSteps(adaptivity.at("initial-steps").get<int>());
+        }
+        else{
+            t_timestepping.setMeshAdaptInitialSteps(0);
+        }
+    }
+    else{
+        t_timestepping.setMeshAdaptInterval(0);
+        t_timestepping.setMeshAdaptInitialSteps(0);
+    }
+
+    if(t_json.contains("explicit")){
+        // "explicit":{"mass":"row-sum","cfl":0.9,"estimate-dt":true,"max-substeps":100000}
+        nlohmann::json explicitopts=t_json.at("explicit");
+        if(!explicitopts.is_object()){
+            MessagePrinter::printErrorTxt("the explicit option of your timestepping block must be a json object, i.e., {\"mass\":\"row-sum\",\"cfl\":0.9}");
+            return false;
+        }
+        if(!IsExplicit){
+            MessagePrinter::printWarningTxt("the explicit option only works for type=central-difference, it is ignored");
+        }
+        for(auto it=explicitopts.begin();it!=explicitopts.end();it++){
+            if(it.key()!="mass"&&it.key()!="cfl"&&it.key()!="estimate-dt"&&it.key()!="max-substeps"){
+                MessagePrinter::printErrorTxt("'"+it.key()+"' is invalid in the explicit option of your timestepping block, only 'mass', 'cfl', "
+                                              "'estimate-dt' and 'max-substeps' are supported");
+                return false;
+            }
+        }
+        if(explicitopts.contains("mass")){
+            if(!explicitopts.at("mass").is_string()){
+                MessagePrinter::printErrorTxt("the mass of the explicit option must be a string, please check your input file");
+                return false;
+            }
+            string massname=explicitopts.at("mass").get<string>();
+            if(massname=="row-sum"){
+                t_timestepping.setLumpedMassType(LumpedMassType::ROWSUM);
+            }
+            else if(massname=="hrz"){
+                t_timestepping.setLumpedMassType(LumpedMassType::HRZ);
+            }
+            else{
+                MessagePrinter::printErrorTxt("mass="+massname+" is invalid in the explicit option, only 'row-sum' and 'hrz' are supported");
+                return false;
+            }
+        }
+        else{
+            t_timestepping.setLumpedMassType(LumpedMassType::ROWSUM);
+        }
+        if(explicitopts.contains("cfl")){
+            if(!explicitopts.at("cfl").is_number()||explicitopts.at("cfl").get<double>()<=0.0||explicitopts.at("cfl").get<double>()>1.0){
+                MessagePrinter::printErrorTxt("the cfl of the explicit option must be a float in (0,1], please check your input file");
+                return false;
+            }
+            t_timestepping.setCFLFactor(explicitopts.at("cfl").get<double>());
+        }
+        else{
+            t_timestepping.setCFLFactor(0.9);
+        }
+        if(explicitopts.contains("estimate-dt")){
+            if(!explicitopts.at("estimate-dt").is_boolean()){
+                MessagePrinter::printErrorTxt("the estimate-dt of the explicit option must be a boolean, please check your input file");
+                return false;
+            }
+            t_timestepping.setStableDtEstimation(explicitopts.at("estimate-dt").get<bool>());
+        }
+        else{
+            t_timestepping.setStableDtEstimation(true);
+        }
+        if(explicitopts.contains("max-substeps")){
+            if(!explicitopts.at("max-substeps").is_number_integer()||explicitopts.at("max-substeps").get<int>()<1){
+                MessagePrinter::printErrorTxt("the max-substeps of the explicit option must be a positive integer, please check your input file");
+                return false;
+            }
+            t_timestepping.setMaxSubSteps(explicitopts.at("max-substeps").get<int>());
+        }
+        else{
+            t_timestepping.setMaxSubSteps(100000);
+        }
+    }
+
     return HasType;
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.12
+//+++ Purpose: setup the fieldsplit preconditioner of KSP, the index
+//+++          sets are created from the dof names of DofHandler
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <algorithm>
+
+#include "LinearSolver/KSPSolver.h"
+
+void KSPSolver::setFieldSplitOptions() {
+    if (m_FieldSplitBlockList.size()<2) {
+        MessagePrinter::printErrorTxt("at least 2 splits are required by the fieldsplit preconditioner, please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+
+    if (m_FieldSplitTypeName == "additive") {
+        PCFieldSplitSetType(m_PC,PC_COMPOSITE_ADDITIVE);
+    }
+    else if (m_FieldSplitTypeName == "multiplicative") {
+        PCFieldSplitSetType(m_PC,PC_COMPOSITE_MULTIPLICATIVE);
+    }
+    else if (m_FieldSplitTypeName == "symmetric-multiplicative") {
+        PCFieldSplitSetType(m_PC,PC_COMPOSITE_SYMMETRIC_MULTIPLICATIVE);
+    }
+    else if (m_FieldSplitTypeName == "schur") {
+        if (m_FieldSplitBlockList.size()!=2) {
+            MessagePrinter::printErrorTxt("the schur fieldsplit only works for 2 splits, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+        PCFieldSplitSetType(m_PC,PC_COMPOSITE_SCHUR);
+        if (m_SchurFactTypeName == "diag") {
+            PCFieldSplitSetSchurFactType(m_PC,PC_FIELDSPLIT_SCHUR_FACT_DIAG);
+        }
+        else if (m_SchurFactTypeName == "lower") {
+            PCFieldSplitSetSchurFactType(m_PC,PC_FIELDSPLIT_SCHUR_FACT_LOWER);
+        }
+        else if (m_SchurFactTypeName == "upper") {
+            PCFieldSplitSetSchurFactType(m_PC,PC_FIELDSPLIT_SCHUR_FACT_UPPER);
+        }
+        else {
+            PCFieldSplitSetSchurFactType(m_PC,PC_FIELDSPLIT_SCHUR_FACT_FULL);
+        }
+        if (m_SchurPreTypeName == "self") {
+            PCFieldSplitSetSchurPre(m_PC,PC_FIELDSPLIT_SCHUR_PRE_SELF,NULL);
+        }
+        else if (m_SchurPreTypeName == "a11") {
+            PCFieldSplitSetSchurPre(m_PC,PC_FIELDSPLIT_SCHUR_PRE_A11,NULL);
+        }
+        else if (m_SchurPreTypeName == "full") {
+            PCFieldSplitSetSchurPre(m_PC,PC_FIELDSPLIT_SCHUR_PRE_FULL,NULL);
+        }
+        else {
+            PCFieldSplitSetSchurPre(m_PC,PC_FIELDSPLIT_SCHUR_PRE_SELFP,NULL);
+        }
+    }
+    else {
+        MessagePrinter::printErrorTxt("fieldsplit type="+m_FieldSplitTypeName+" is invalid, please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+
+    // the sub-ksp of each split is created during PCSetUp, where its options prefix is 'fieldsplit_<name>_',
+    // so the sub-solvers are set via the options database
+    string optname;
+    for (const auto &block:m_FieldSplitBlockList) {
+        optname="-fieldsplit_"+block.m_SplitName+"_ksp_type";
+        PetscOptionsSetValue(NULL,optname.c_str(),block.m_KSPTypeName.c_str());
+        optname="-fieldsplit_"+block.m_SplitName+"_pc_type";
+        PetscOptionsSetValue(NULL,optname.c_str(),block.m_PCTypeName.c_str());
+    }
+}
+
+void KSPSolver::initFieldSplit(const DofHandler &t_DofHandler,SparseMatrix &A) {
+    if (m_PCTypeName != "fieldsplit") return;
+
+    const int MaxDofs=t_DofHandler.getMaxDofsPerNode();
+    const int SplitsNum=static_cast<int>(m_FieldSplitBlockList.size());
+    vector<int> Dof2SplitID(MaxDofs,-1);
+    int dofid;
+    for (int s=0;s<SplitsNum;s++) {
+        for (const auto &name:m_FieldSplitBlockList[s].m_DofNameList) {
+            if (!t_DofHandler.isValidDofName(name)) {
+                MessagePrinter::printErrorTxt("dof name="+name+" in split-"+m_FieldSplitBlockList[s].m_SplitName+
+                                              " is not a valid dof name, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            dofid=t_DofHandler.getDofIDViaName(name);
+            if (Dof2SplitID[dofid-1]!=-1) {
+                MessagePrinter::printErrorTxt("dof name="+name+" is used by more than one split, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            Dof2SplitID[dofid-1]=s;
+        }
+    }
+    for (int i=1;i<=MaxDofs;i++) {
+        if (Dof2SplitID[i-1]==-1) {
+            MessagePrinter::printErrorTxt("dof name="+t_DofHandler.getIthDofName(i)+" doesn\'t belong to any split, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+    }
+
+    // the global dof id is (nodeid-1)*MaxDofsPerNode+dofid, so each row is mapped to its split directly
+    PetscInt rstart,rend;
+    MatGetOwnershipRange(A.getReference(),&rstart,&rend);
+    vector<vector<PetscInt>> SplitRows(SplitsNum);
+    for (PetscInt row=rstart;row<rend;row++) {
+        SplitRows[Dof2SplitID[row%MaxDofs]].push_back(row);
+    }
+
+    // the json object is sorted by the key, so the splits are ordered by their first dof in the 'dofs' block,
+    // for schur, the first split gives A00 and the second one gives the schur complement
+    vector<int> SplitOrder;
+    for (int i=0;i<MaxDofs;i++) {
+        if (find(SplitOrder.begin(),SplitOrder.end(),Dof2SplitID[i])==SplitOrder.end()) {
+            SplitOrder.push_back(Dof2SplitID[i]);
+        }
+    }
+
+    IS is;
+    for (const auto &s:SplitOrder) {
+        ISCreateGeneral(PETSC_COMM_WORLD,static_cast<PetscInt>(SplitRows[s].size()),SplitRows[s].data(),PETSC_COPY_VALUES,&is);
+        PCFieldSplitSetIS(m_PC,m_FieldSplitBlockList[s].m_SplitName.c_str(),is);
+        ISDestroy(&is);// the pc holds its own reference
+    }
+}
@@ -0,0 +1,213 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.18
+//+++ Purpose: setup the geometric multigrid preconditioner (PCMG)
+//+++          from the node lattice of the built-in mesh
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <algorithm>
+
+#include "LinearSolver/KSPSolver.h"
+
+namespace{
+    /**
+     * get the first node of current rank, the nodes of each coarse level are evenly split among the ranks
+     */
+    inline PetscInt getLocalNodeStart(const PetscInt &t_NodesNum,const int &t_Rank,const int &t_Size){
+        return t_Rank*(t_NodesNum/t_Size)+std::min<PetscInt>(t_Rank,t_NodesNum%t_Size);
+    }
+}
+
+void KSPSolver::initMultigrid(const FECell &t_FECell,const DofHandler &t_DofHandler,SparseMatrix &A) {
+    if (m_PCTypeName != "mg") return;
+
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    // the lagrange generators put the nodes on a (order*nx+1)x(order*ny+1)x(order*nz+1) lattice
+    int Order;
+    switch (t_FECell.getFECellBulkElmtMeshType()) {
+    case MeshType::EDGE2:
+    case MeshType::QUAD4:
+    case MeshType::HEX8:
+        Order=1;
+        break;
+    case MeshType::EDGE3:
+    case MeshType::QUAD9:
+    case MeshType::HEX27:
+        Order=2;
+        break;
+    case MeshType::EDGE4:
+        Order=3;
+        break;
+    default:
+        Order=0;
+        break;
+    }
+    if (!t_FECell.isStructuredGrid()||Order==0) {
+        MessagePrinter::printErrorTxt("preconditioner=mg requires the built-in edge2/edge3/edge4/quad4/quad9/hex8/hex27 mesh, "
+                                      "please use gamg for the imported mesh");
+        MessagePrinter::exitAsFem();
+    }
+
+    const int Dim=t_FECell.getFECellMaxDim();
+    vector<vector<int>> LevelIntervals;
+    vector<int> Intervals(3,0);
+    PetscInt LatticeNodesNum=1;
+    for (int d=0;d<Dim;d++) {
+        Intervals[d]=Order*t_FECell.getFECellElmtsNumAlongAxis(d+1);
+        LatticeNodesNum*=Intervals[d]+1;
+    }
+    if (t_FECell.hasHangingNodes()||t_FECell.getFECellNodesNum()!=LatticeNodesNum) {
+        MessagePrinter::printWarningTxt("the mesh is not a structured lattice any more, preconditioner=mg is replaced by gamg");
+        m_PCTypeName="gamg";
+        PCSetType(m_PC,PCGAMG);
+        return;
+    }
+
+    // each axis with an even number of intervals (at least 4) is halved, until no axis can be coarsened
+    LevelIntervals.push_back(Intervals);
+    bool IsCoarsened=true;
+    while (IsCoarsened&&(m_MGLevels<1||static_cast<int>(LevelIntervals.size())<m_MGLevels)) {
+        IsCoarsened=false;
+        for (int d=0;d<Dim;d++) {
+            if (Intervals[d]%2==0&&Intervals[d]>=4) {
+                Intervals[d]/=2;
+                IsCoarsened=true;
+            }
+        }
+        if (IsCoarsened) LevelIntervals.push_back(Intervals);
+    }
+    if (m_MGLevels>0&&static_cast<int>(LevelIntervals.size())<m_MGLevels) {
+        MessagePrinter::printWarningTxt("the mesh can only be coarsened into "+to_string(LevelIntervals.size())+
+                                        " multigrid levels, please use even nx/ny/nz for more levels");
+    }
+    if (LevelIntervals.size()<2) {
+        MessagePrinter::printWarningTxt("the mesh can\'t be coarsened (odd nx/ny/nz), preconditioner=mg is replaced by gamg");
+        m_PCTypeName="gamg";
+        PCSetType(m_PC,PCGAMG);
+        return;
+    }
+    // the level-0 of PCMG is the coarsest one
+    std::reverse(LevelIntervals.begin(),LevelIntervals.end());
+    const int Levels=static_cast<int>(LevelIntervals.size());
+    m_MGLevels=Levels;
+
+    // the rows of the finest level follow the current node ids, which may differ from the lattice ids after the reordering
+    int IsReordered=(rank==0&&t_FECell.isMeshReordered())?1:0;
+    MPI_Bcast(&IsReordered,1,MPI_INT,0,PETSC_COMM_WORLD);
+    vector<int> NodeLatticeIDs;
+    if (IsReordered) {
+        NodeLatticeIDs.resize(t_FECell.getFECellNodesNum(),0);
+        if (rank==0) {
+            for (int i=1;i<=t_FECell.getFECellNodesNum();i++) NodeLatticeIDs[i-1]=t_FECell.getFECellIthNodeOrigID(i)-1;
+        }
+        MPI_Bcast(NodeLatticeIDs.data(),t_FECell.getFECellNodesNum(),MPI_INT,0,PETSC_COMM_WORLD);
+    }
+
+    PCMGSetLevels(m_PC,Levels,NULL);
+    PCMGSetGalerkin(m_PC,PC_MG_GALERKIN_BOTH);
+    PCMGSetCycleType(m_PC,m_MGCycleTypeName=="w"?PC_MG_CYCLE_W:PC_MG_CYCLE_V);
+
+    const PetscInt DofsPerNode=t_DofHandler.getMaxDofsPerNode();
+    const int MaxNnzPerRow=1<<Dim;
+    PetscInt rstart,rend,cstart,cend;
+    PetscInt FineNodesNum,CoarseNodesNum;
+    PetscInt row,node,comp,nCols;
+    int Fine[3],Coarse[3][2],nCoarse[3],d,ii,jj,kk;
+    PetscScalar Weights[3][2];
+    PetscInt Cols[8];
+    PetscScalar Vals[8];
+    Mat Interpolation;
+    for (int l=1;l<Levels;l++) {
+        const vector<int> &FineIntervals=LevelIntervals[l];
+        const vector<int> &CoarseIntervals=LevelIntervals[l-1];
+        FineNodesNum=1;CoarseNodesNum=1;
+        for (d=0;d<3;d++) {
+            FineNodesNum*=FineIntervals[d]+1;
+            CoarseNodesNum*=CoarseIntervals[d]+1;
+        }
+        if (l==Levels-1) {
+            MatGetOwnershipRange(A.getReference(),&rstart,&rend);
+        }
+        else {
+            rstart=DofsPerNode*getLocalNodeStart(FineNodesNum,rank,size);
+            rend=DofsPerNode*getLocalNodeStart(FineNodesNum,rank+1,size);
+        }
+        cstart=DofsPerNode*getLocalNodeStart(CoarseNodesNum,rank,size);
+        cend=DofsPerNode*getLocalNodeStart(CoarseNodesNum,rank+1,size);
+
+        MatCreateAIJ(PETSC_COMM_WORLD,rend-rstart,cend-cstart,DofsPerNode*FineNodesNum,DofsPerNode*CoarseNodesNum,
+                     MaxNnzPerRow,NULL,MaxNnzPerRow,NULL,&Interpolation);
+        for (row=rstart;row<rend;row++) {
+            node=row/DofsPerNode;
+            comp=row%DofsPerNode;
+            if (l==Levels-1&&IsReordered) node=NodeLatticeIDs[node];
+            Fine[0]=node%(FineIntervals[0]+1);
+            Fine[1]=(node/(FineIntervals[0]+1))%(FineIntervals[1]+1);
+            Fine[2]=node/((FineIntervals[0]+1)*(FineIntervals[1]+1));
+            // multi-linear interpolation along each coarsened axis, the odd lattice points sit in the middle
+            for (d=0;d<3;d++) {
+                if (CoarseIntervals[d]==FineIntervals[d]) {
+                    nCoarse[d]=1;Coarse[d][0]=Fine[d];Weights[d][0]=1.0;
+                }
+                else if (Fine[d]%2==0) {
+                    nCoarse[d]=1;Coarse[d][0]=Fine[d]/2;Weights[d][0]=1.0;
+                }
+                else {
+                    nCoarse[d]=2;
+                    Coarse[d][0]=(Fine[d]-1)/2;Weights[d][0]=0.5;
+                    Coarse[d][1]=(Fine[d]+1)/2;Weights[d][1]=0.5;
+                }
+            }
+            nCols=0;
+            for (kk=0;kk<nCoarse[2];kk++) {
+                for (jj=0;jj<nCoarse[1];jj++) {
+                    for (ii=0;ii<nCoarse[0];ii++) {
+                        Cols[nCols]=DofsPerNode*(Coarse[0][ii]
+                                                +Coarse[1][jj]*(CoarseIntervals[0]+1)
+                                                +Coarse[2][kk]*(CoarseIntervals[0]+1)*(CoarseIntervals[1]+1))+comp;
+                        Vals[nCols]=Weights[0][ii]*Weights[1][jj]*Weights[2][kk];
+                        nCols+=1;
+                    }
+                }
+            }
+            MatSetValues(Interpolation,1,&row,nCols,Cols,Vals,INSERT_VALUES);
+        }
+        MatAssemblyBegin(Interpolation,MAT_FINAL_ASSEMBLY);
+        MatAssemblyEnd(Interpolation,MAT_FINAL_ASSEMBLY);
+        PCMGSetInterpolation(m_PC,l,Interpolation);
+        MatDestroy(&Interpolation);// the pc holds its own reference, the restriction is its transpose
+    }
+
+    KSP SubKSP;
+    PC SubPC;
+    for (int l=1;l<Levels;l++) {
+        PCMGGetSmoother(m_PC,l,&SubKSP);
+        KSPSetType(SubKSP,m_MGSmootherTypeName.c_str());
+        if (m_MGSmootherTypeName == "chebyshev") {
+            KSPChebyshevEstEigSet(SubKSP,0.0,0.1,0.0,1.1);
+        }
+        KSPSetTolerances(SubKSP,PETSC_CURRENT,PETSC_CURRENT,PETSC_CURRENT,m_MGSmoothSteps);
+        KSPGetPC(SubKSP,&SubPC);
+        PCSetType(SubPC,m_MGSmootherPCTypeName.c_str());
+    }
+
+    if (m_MGCoarseSolverTypeName == "lu" && size>1) {
+        MessagePrinter::printWarningTxt("coarse-solver=lu only works in serial, the redundant lu is used for the coarsest level");
+        m_MGCoarseSolverTypeName="redundant";
+    }
+    PCMGGetCoarseSolve(m_PC,&SubKSP);
+    KSPSetType(SubKSP,KSPPREONLY);
+    KSPGetPC(SubKSP,&SubPC);
+    PCSetType(SubPC,m_MGCoarseSolverTypeName.c_str());
+}
@@ -14,15 +14,35 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "LinearSolver/KSPSolver.h"
+#include "LinearSolver/SinglePrecisionPC.h"
+#include "Utils/Profiler.h"
 
 KSPSolver::KSPSolver() {
     m_Iterations=0;
     m_MaxIterations=10000;
     m_GMRESRestartNumber=1500;
     m_Tolerance=1.0e-25;
+    m_IsAllocated=false;
+    m_ReusePreconditioner=false;
+    m_ComputeResidualNorm=false;
+    m_LinearResidualNorm=0.0;
+    m_HasResidualVec=false;
 
     m_KSPSolverTypeName="gmres";
     m_PCTypeName="bjacobi";
+    m_PCPrecisionName="double";
+
+    m_FieldSplitTypeName="multiplicative";
+    m_SchurFactTypeName="full";
+    m_SchurPreTypeName="selfp";
+    m_FieldSplitBlockList.clear();
+
+    m_MGLevels=0;
+    m_MGSmoothSteps=2;
+    m_MGCycleTypeName="v";
+    m_MGSmootherTypeName="chebyshev";
+    m_MGSmootherPCTypeName="sor";
+    m_MGCoarseSolverTypeName="redundant";
 }
 void KSPSolver::setDefaultParams(){
     m_MaxIterations=10000;
@@ -48,7 +68,16 @@ void KSPSolver::init() {
     KSPSetTolerances(m_KSP,PETSC_CURRENT,m_Tolerance,PETSC_CURRENT,m_MaxIterations);
 
     // setup the preconditioner
-    if (m_PCTypeName == "jacobi") {
+    if (m_PCPrecisionName == "single") {
+        // the ilu factors of the diagonal block of each rank are kept in single precision, in parallel
+        // this is the same as bjacobi with ilu sub-solvers, so both of them share the shell preconditioner
+        if (m_PCTypeName != "ilu" && m_PCTypeName != "bjacobi") {
+            MessagePrinter::printErrorTxt("pc-precision=single is only supported by the ilu and bjacobi preconditioners, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+        SinglePrecisionPC::attachToPC(m_PC);
+    }
+    else if (m_PCTypeName == "jacobi") {
         PCSetType(m_PC,PCJACOBI);
     }
     else if (m_PCTypeName == "bjacobi") {
@@ -97,6 +126,14 @@ void KSPSolver::init() {
     else if (m_PCTypeName == "shell") {
         PCSetType(m_PC,PCSHELL);
     }
+    else if (m_PCTypeName == "fieldsplit") {
+        PCSetType(m_PC,PCFIELDSPLIT);
+        setFieldSplitOptions();
+    }
+    else if (m_PCTypeName == "mg") {
+        // the levels and the interpolations come from the mesh, see initMultigrid
+        PCSetType(m_PC,PCMG);
+    }
     else {
         MessagePrinter::printTxt("preconditoner="+m_PCTypeName+" is invalid, please check your input file");
         MessagePrinter::exitAsFem();
@@ -147,21 +184,55 @@ void KSPSolver::init() {
     // KSPSetUp(m_KSP); // this will raise a very stupid bug, please comment out it
 }
 bool KSPSolver::solve(SparseMatrix &A,Vector &b,Vector &x) {
+    ProfilerScope LinearSolveScope("linear-solve");
     m_Iterations=0;
+    KSPSetReusePreconditioner(m_KSP,m_ReusePreconditioner?PETSC_TRUE:PETSC_FALSE);
     KSPSetOperators(m_KSP,A.getReference(),A.getReference());
     KSPSolve(m_KSP,b.getVectorRef(),x.getVectorRef());
     KSPGetIterationNumber(m_KSP,&m_Iterations);
+    if (m_ComputeResidualNorm) {
+        if (!m_HasResidualVec) {
+            VecDuplicate(b.getVectorRef(),&m_LinearResidual);
+            m_HasResidualVec=true;
+        }
+        MatMult(A.getReference(),x.getVectorRef(),m_LinearResidual);
+        VecAYPX(m_LinearResidual,-1.0,b.getVectorRef());// r=b-A*x
+        VecNorm(m_LinearResidual,NORM_2,&m_LinearResidualNorm);
+    }
     return true;
 }
+void KSPSolver::setRelativeTolerance(const double &rtol) {
+    KSPSetTolerances(m_KSP,rtol,PETSC_CURRENT,PETSC_CURRENT,PETSC_CURRENT);
+}
 void KSPSolver::printKSPSolverInfo()const {
     MessagePrinter::printNormalTxt("KSP solver info:");
     MessagePrinter::printNormalTxt("  max iterations= "+to_string(m_MaxIterations));
     MessagePrinter::printNormalTxt("  restarts= "+to_string(m_GMRESRestartNumber));
     MessagePrinter::printNormalTxt("  solver= "+m_KSPSolverTypeName);
     MessagePrinter::printNormalTxt("  preconditioner type= "+m_PCTypeName);
+    if (m_PCPrecisionName == "single") {
+        MessagePrinter::printNormalTxt("  preconditioner precision= single (ilu(0) factors of each rank)");
+    }
     char buff[65];
     snprintf(buff,65,"  tolerance= %14.6e",m_Tolerance);
     MessagePrinter::printNormalTxt(buff);
+    if (m_PCTypeName == "fieldsplit") {
+        MessagePrinter::printNormalTxt("  fieldsplit type= "+m_FieldSplitTypeName);
+        if (m_FieldSplitTypeName == "schur") {
+            MessagePrinter::printNormalTxt("  schur factorization= "+m_SchurFactTypeName+", schur preconditioner= "+m_SchurPreTypeName);
+        }
+        for (const auto &block:m_FieldSplitBlockList) {
+            string str="  split-"+block.m_SplitName+": dofs=";
+            for (const auto &name:block.m_DofNameList) str+=name+" ";
+            str+=", ksp="+block.m_KSPTypeName+", pc="+block.m_PCTypeName;
+            MessagePrinter::printNormalTxt(str);
+        }
+    }
+    if (m_PCTypeName == "mg") {
+        MessagePrinter::printNormalTxt("  multigrid levels= "+to_string(m_MGLevels)+", cycle= "+m_MGCycleTypeName+", coarse operator= galerkin");
+        MessagePrinter::printNormalTxt("  smoother= "+m_MGSmootherTypeName+"+"+m_MGSmootherPCTypeName+
+                                       " ("+to_string(m_MGSmoothSteps)+" steps), coarse solver= "+m_MGCoarseSolverTypeName);
+    }
     MessagePrinter::printStars();
 }
 void KSPSolver::releaseMemory() {
@@ -170,4 +241,8 @@ void KSPSolver::releaseMemory() {
         // PCDestroy(&m_PC);
         m_IsAllocated=false;
     }
+    if (m_HasResidualVec) {
+        VecDestroy(&m_LinearResidual);
+        m_HasResidualVec=false;
+    }
 }
\ No newline at end of file
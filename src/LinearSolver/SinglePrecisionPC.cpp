@@ -0,0 +1,136 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.16
+//+++ Purpose: the block-jacobi preconditioner with ILU(0) factors
+//+++          stored in single precision
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cmath>
+
+#include "LinearSolver/SinglePrecisionPC.h"
+#include "Utils/MessagePrinter.h"
+
+void SinglePrecisionPC::attachToPC(PC &t_PC){
+    SinglePrecisionPC *ctx=new SinglePrecisionPC();
+    PCSetType(t_PC,PCSHELL);
+    PCShellSetContext(t_PC,ctx);
+    PCShellSetSetUp(t_PC,SinglePrecisionPC::setUp);
+    PCShellSetApply(t_PC,SinglePrecisionPC::apply);
+    PCShellSetDestroy(t_PC,SinglePrecisionPC::destroy);
+    PCShellSetName(t_PC,"single-precision bjacobi/ilu(0)");
+}
+
+PetscErrorCode SinglePrecisionPC::setUp(PC t_PC){
+    SinglePrecisionPC *ctx;
+    Mat A,P,Ad;
+    PCShellGetContext(t_PC,&ctx);
+    PCGetOperators(t_PC,&A,&P);
+    // the on-process block of the parallel matrix, or the matrix itself on one rank
+    MatGetDiagonalBlock(P,&Ad);
+    if(!ctx->factorize(Ad)){
+        MessagePrinter::printErrorTxt("the diagonal entry is missing in the sparsity pattern, the single-precision ILU(0) preconditioner can\'t be built");
+        MessagePrinter::exitAsFem();
+    }
+    return 0;
+}
+
+PetscErrorCode SinglePrecisionPC::apply(PC t_PC,Vec x,Vec y){
+    SinglePrecisionPC *ctx;
+    const PetscScalar *xx;
+    PetscScalar *yy;
+    PCShellGetContext(t_PC,&ctx);
+    VecGetArrayRead(x,&xx);
+    VecGetArray(y,&yy);
+    ctx->solve(xx,yy);
+    VecRestoreArrayRead(x,&xx);
+    VecRestoreArray(y,&yy);
+    return 0;
+}
+
+PetscErrorCode SinglePrecisionPC::destroy(PC t_PC){
+    SinglePrecisionPC *ctx;
+    PCShellGetContext(t_PC,&ctx);
+    delete ctx;
+    return 0;
+}
+
+bool SinglePrecisionPC::factorize(Mat &A){
+    PetscInt ncols,rstart,rend;
+    const PetscInt *cols;
+    const PetscScalar *vals;
+
+    MatGetOwnershipRange(A,&rstart,&rend);
+    m_RowsNum=rend-rstart;
+    m_RowPtr.assign(m_RowsNum+1,0);
+    m_DiagIDs.assign(m_RowsNum,-1);
+    m_ColIDs.clear();
+    m_Vals.clear();
+
+    // the row i is eliminated in double precision in the work array, only the final factors are rounded to float
+    vector<double> Work(m_RowsNum,0.0);
+    vector<PetscInt> Pos(m_RowsNum,-1);
+    PetscInt i,p,q,k,j;
+    double l,pivot;
+    for(i=0;i<m_RowsNum;i++){
+        MatGetRow(A,rstart+i,&ncols,&cols,&vals);
+        for(p=0;p<ncols;p++){
+            j=cols[p];
+            if(j<0||j>=m_RowsNum) continue;
+            Pos[j]=static_cast<PetscInt>(m_ColIDs.size());
+            Work[j]=vals[p];
+            if(j==i) m_DiagIDs[i]=static_cast<PetscInt>(m_ColIDs.size());
+            m_ColIDs.push_back(j);
+        }
+        MatRestoreRow(A,rstart+i,&ncols,&cols,&vals);
+        m_RowPtr[i+1]=static_cast<PetscInt>(m_ColIDs.size());
+        if(m_DiagIDs[i]<0) return false;
+
+        // the columns of the aij rows are sorted, so the lower part is eliminated in order
+        for(p=m_RowPtr[i];p<m_DiagIDs[i];p++){
+            k=m_ColIDs[p];
+            l=Work[k]/static_cast<double>(m_Vals[m_DiagIDs[k]]);
+            Work[k]=l;
+            for(q=m_DiagIDs[k]+1;q<m_RowPtr[k+1];q++){
+                if(Pos[m_ColIDs[q]]>=0) Work[m_ColIDs[q]]-=l*static_cast<double>(m_Vals[q]);
+            }
+        }
+        pivot=Work[i];
+        if(std::fabs(pivot)<1.0e-30){
+            // shift the zero pivot, which also keeps it nonzero after the rounding to float
+            Work[i]=pivot<0.0?-1.0e-12:1.0e-12;
+        }
+        for(p=m_RowPtr[i];p<m_RowPtr[i+1];p++){
+            m_Vals.push_back(static_cast<float>(Work[m_ColIDs[p]]));
+            Pos[m_ColIDs[p]]=-1;
+            Work[m_ColIDs[p]]=0.0;
+        }
+    }
+    m_ColIDs.shrink_to_fit();
+    m_Vals.shrink_to_fit();
+    return true;
+}
+
+void SinglePrecisionPC::solve(const PetscScalar *b,PetscScalar *x)const{
+    PetscInt i,p;
+    double sum;
+    // L*z=b, L has the unit diagonal
+    for(i=0;i<m_RowsNum;i++){
+        sum=b[i];
+        for(p=m_RowPtr[i];p<m_DiagIDs[i];p++) sum-=static_cast<double>(m_Vals[p])*x[m_ColIDs[p]];
+        x[i]=sum;
+    }
+    // U*x=z
+    for(i=m_RowsNum-1;i>=0;i--){
+        sum=x[i];
+        for(p=m_DiagIDs[i]+1;p<m_RowPtr[i+1];p++) sum-=static_cast<double>(m_Vals[p])*x[m_ColIDs[p]];
+        x[i]=sum/static_cast<double>(m_Vals[m_DiagIDs[i]]);
+    }
+}
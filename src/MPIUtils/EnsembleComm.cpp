@@ -0,0 +1,73 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.13
+//+++ Purpose: split the mpi ranks into several groups for the
+//+++          ensemble execution
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "petsc.h"
+#include "MPIUtils/EnsembleComm.h"
+
+int EnsembleComm::m_GroupsNum=1;
+int EnsembleComm::m_GroupID=0;
+bool EnsembleComm::m_OwnMPI=false;
+MPI_Comm EnsembleComm::m_SubComm=MPI_COMM_NULL;
+
+bool EnsembleComm::init(int args,char *argv[]){
+    m_GroupsNum=1;
+    m_GroupID=0;
+    for(int i=1;i<args-1;i++){
+        if(std::string(argv[i])=="--ensemble-groups"){
+            m_GroupsNum=std::atoi(argv[i+1]);
+            break;
+        }
+    }
+    if(m_GroupsNum==1) return true;
+
+    // PETSc is not initialized yet, so the messages are printed by plain printf
+    if(m_GroupsNum<1){
+        printf("*** Error: '--ensemble-groups' must be a positive integer\n");
+        return false;
+    }
+    int IsInit;
+    MPI_Initialized(&IsInit);
+    if(!IsInit){
+        MPI_Init(&args,&argv);
+        m_OwnMPI=true;
+    }
+    int rank,size;
+    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_size(MPI_COMM_WORLD,&size);
+    if(m_GroupsNum>size){
+        if(rank==0) printf("*** Error: '--ensemble-groups %d' is larger than the %d mpi ranks\n",m_GroupsNum,size);
+        return false;
+    }
+    // contiguous ranks are grouped together, the extra ranks go to the first groups
+    m_GroupID=static_cast<int>((static_cast<long>(rank)*m_GroupsNum)/size);
+    MPI_Comm_split(MPI_COMM_WORLD,m_GroupID,rank,&m_SubComm);
+    PETSC_COMM_WORLD=m_SubComm;
+    return true;
+}
+
+void EnsembleComm::finalize(){
+    if(m_SubComm!=MPI_COMM_NULL){
+        MPI_Comm_free(&m_SubComm);
+        m_SubComm=MPI_COMM_NULL;
+    }
+    if(m_OwnMPI){
+        MPI_Finalize();
+        m_OwnMPI=false;
+    }
+}
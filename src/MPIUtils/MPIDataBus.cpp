@@ -15,23 +15,48 @@
 //+++          Receive: others <----- master
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#include <climits>
+#include <algorithm>
+
 #include "MPIUtils/MPIDataBus.h"
+#include "Utils/MessagePrinter.h"
+
+namespace{
+    /**
+     * the fixed-size header of one mesh cell in the packed buffer
+     */
+    struct MeshCellWireHeader{
+        int Dim;/**< the dimension of the cell */
+        int NodesNumPerElmt;/**< the nodes number per cell */
+        int ConnNum;/**< the length of the connectivity */
+        int DofsNum;/**< the length of the dof ids */
+        int VTKCellType;/**< the vtk cell type */
+        int CellMeshType;/**< the mesh type */
+        int PhysicalGroupNums;/**< the physical groups number */
+        int PhyNamesNum;/**< the length of the physical name list */
+        int PhyIDsNum;/**< the length of the physical id list */
+        int Reserved;/**< keep the volume aligned */
+        double Volume;/**< the volume of the cell */
+    };
+    const map<string,int> EmptyPhyName2IDMap;/**< used when the physical names are not broadcast yet */
+    const map<int,string> EmptyPhyID2NameMap;/**< used when the physical names are not broadcast yet */
+}
 
 void MPIDataBus::printRankStatus(){
     int rank,size;
-    MPI_Comm_size(MPI_COMM_WORLD,&size);
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     printf("\033[1;91m[Deeeebuuugggg]  =====> in rank-%5d of size=%5d\n",rank,size);
 }
 
 void MPIDataBus::sendIntegerToOthers(const int &Val,const int &Tag,const int &Cpuid){
     MPI_Request request;
-    MPI_Isend(&Val,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&Val,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 }
 void MPIDataBus::receiveIntegerFromMaster(int &Val,const int &Tag){
     MPI_Request request;
-    MPI_Irecv(&Val,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&Val,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 }
 //********************************************************
@@ -39,20 +64,20 @@ void MPIDataBus::sendStringToOthers(const string &Txt,const int &Tag,const int &
     MPI_Request request;
     int datasize;
     datasize=static_cast<int>(Txt.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     //
-    MPI_Isend(Txt.data(),datasize,MPI_CHAR,Cpuid,Tag+1,MPI_COMM_WORLD,&request);
+    MPI_Isend(Txt.data(),datasize,MPI_CHAR,Cpuid,Tag+1,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 }
 void MPIDataBus::receiveStringFromMaster(string &Txt,const int &Tag){
     MPI_Request request;
     int datasize;
-    MPI_Irecv(&datasize,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&datasize,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     //
     Txt.resize(datasize);
-    MPI_Irecv(Txt.data(),datasize,MPI_CHAR,0,Tag+1,MPI_COMM_WORLD,&request);
+    MPI_Irecv(Txt.data(),datasize,MPI_CHAR,0,Tag+1,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 }
 //********************************************************
@@ -60,13 +85,13 @@ void MPIDataBus::sendMeshTypeToOthers(const MeshType &t_MeshType,const int &Tag,
     MPI_Request request;
     int val;
     val=static_cast<int>(t_MeshType);
-    MPI_Isend(&val,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&val,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 }
 void MPIDataBus::receiveMeshTypeFromMater(MeshType &t_MeshType,const int &Tag) {
     MPI_Request request;
     int val;
-    MPI_Irecv(&val,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&val,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     t_MeshType=static_cast<MeshType>(val);
 }
@@ -75,21 +100,21 @@ void MPIDataBus::sentIntegerVectorToOthers(const vector<int> &Vec,const int &Tag
     MPI_Request request;
     int datasize;
     datasize=static_cast<int>(Vec.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     if (datasize>0) {
-        MPI_Isend(Vec.data(),datasize,MPI_INT,Cpuid,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Isend(Vec.data(),datasize,MPI_INT,Cpuid,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
 void MPIDataBus::receiveIntegerVectorFromMaster(vector<int> &Vec,const int &Tag){
     MPI_Request request;
     int vecsize;
-    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     Vec.resize(vecsize,0);
     if (vecsize>0) {
-        MPI_Irecv(Vec.data(),vecsize,MPI_INT,0,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Irecv(Vec.data(),vecsize,MPI_INT,0,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
@@ -98,29 +123,29 @@ void MPIDataBus::sentVectorOfIntegerVectorToOthers(const vector<vector<int>> &Ve
     MPI_Request request;
     int datasize,vecsize;
     vecsize=static_cast<int>(Vec.size());
-    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     for(int i=0;i<vecsize;i++){
         datasize=static_cast<int>(Vec[i].size());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
-        MPI_Isend(Vec[i].data(),datasize,MPI_INT,Cpuid,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Isend(Vec[i].data(),datasize,MPI_INT,Cpuid,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
 void MPIDataBus::receiveVectorOfIntegerVectorFromMaster(vector<vector<int>> &Vec,const int &Tag){
     MPI_Request request;
     int vecsize,datasize;
-    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     Vec.resize(vecsize,vector<int>(0));
     for(int i=0;i<vecsize;i++){
-        MPI_Irecv(&datasize,1,MPI_INT,0,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Irecv(&datasize,1,MPI_INT,0,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
         Vec[i].resize(datasize,0);
-        MPI_Irecv(Vec[i].data(),datasize,MPI_INT,0,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Irecv(Vec[i].data(),datasize,MPI_INT,0,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
@@ -133,7 +158,7 @@ void MPIDataBus::sendAlignedVectorOfIntegerVectorToOthers(const vector<vector<in
     int vecsize,width;
     vector<int> tempvec;
     vecsize=static_cast<int>(Vec.size());
-    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     //
     if (vecsize>0) {
@@ -144,10 +169,10 @@ void MPIDataBus::sendAlignedVectorOfIntegerVectorToOthers(const vector<vector<in
                 tempvec.push_back(Vec[i][j]);
             }
         }
-        MPI_Isend(&width,1,MPI_INT,Cpuid,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Isend(&width,1,MPI_INT,Cpuid,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
-        MPI_Isend(tempvec.data(),vecsize*width,MPI_INT,Cpuid,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Isend(tempvec.data(),vecsize*width,MPI_INT,Cpuid,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
     tempvec=vector<int>(0);// release memory
@@ -156,15 +181,15 @@ void MPIDataBus::receiveAlignedVectorOfIntegerVectorFromMaster(vector<vector<int
     MPI_Request request;
     int vecsize,width;
     vector<int> tempvec;
-    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     //
     if (vecsize>0) {
-        MPI_Irecv(&width,1,MPI_INT,0,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Irecv(&width,1,MPI_INT,0,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
         tempvec.resize(vecsize*width,0);
-        MPI_Irecv(tempvec.data(),vecsize*width,MPI_INT,0,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Irecv(tempvec.data(),vecsize*width,MPI_INT,0,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
         Vec.resize(vecsize,vector<int>(width,0));
@@ -184,342 +209,89 @@ void MPIDataBus::sentStringVectorToOthers(const vector<string> &Vec,const int &T
     MPI_Request request;
     int datasize,vecsize;
     vecsize=static_cast<int>(Vec.size());
-    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,MPI_COMM_WORLD,&request);
+    MPI_Isend(&vecsize,1,MPI_INT,Cpuid,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     for(int i=0;i<vecsize;i++){
         datasize=static_cast<int>(Vec[i].size());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         //
-        MPI_Isend(Vec[i].data(),datasize,MPI_CHAR,Cpuid,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Isend(Vec[i].data(),datasize,MPI_CHAR,Cpuid,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
 void MPIDataBus::receiveStringVectorFromMaster(vector<string> &Vec,const int &Tag){
     MPI_Request request;
     int datasize,vecsize;
-    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&vecsize,1,MPI_INT,0,Tag,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     Vec.resize(vecsize);
     for(int i=0;i<vecsize;i++){
-        MPI_Irecv(&datasize,1,MPI_INT,0,Tag+1,MPI_COMM_WORLD,&request);
+        MPI_Irecv(&datasize,1,MPI_INT,0,Tag+1,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
         Vec[i].resize(datasize);
-        MPI_Irecv(Vec[i].data(),datasize,MPI_CHAR,0,Tag+2,MPI_COMM_WORLD,&request);
+        MPI_Irecv(Vec[i].data(),datasize,MPI_CHAR,0,Tag+2,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
 //********************************************************
 void MPIDataBus::sendMeshCellToOthers(const vector<SingleMeshCell> &Meshcellvec,const int &Tag,const int &Cpuid){
-    int Basetag;
-    Basetag=Tag;
-
-    int datasize;
-
-    MPI_Request request;
-
-    // send out the length of the mesh cell vector
-    datasize=static_cast<int>(Meshcellvec.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    for(const auto &cell:Meshcellvec){
-        // send Dim
-        MPI_Isend(&cell.Dim,1,MPI_INT,Cpuid,Basetag+2,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send NodesNumPerElmt
-        MPI_Isend(&cell.NodesNumPerElmt,1,MPI_INT,Cpuid,Basetag+3,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtConn
-        datasize=static_cast<int>(cell.ElmtConn.size());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtConn.data(),datasize,MPI_INT,Cpuid,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtNodeCoords0
-        datasize=static_cast<int>(cell.ElmtNodeCoords0.getSize());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtNodeCoords0.getCopy().data(),datasize*3,MPI_DOUBLE,Cpuid,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send VTKCellType
-        MPI_Isend(&cell.VTKCellType,1,MPI_INT,Cpuid,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-    }
-
+    BinaryWriter writer;
+    // the whole mesh cell vector is packed into one message
+    packMeshCellVector(writer,Meshcellvec,EmptyPhyName2IDMap);
+    sendChunkedBufferToOther(writer.getDataRef(),Cpuid,Tag+1);
 }
 //********************************************************
 void MPIDataBus::receiveMeshCellFromMaster(vector<SingleMeshCell> &Meshcellvec,const int &Tag){
-    int Basetag;
-    Basetag=Tag;
-
-    int datasize;
-
-    MPI_Request request;
-
-    // receive the length of the mesh cell vector
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    Meshcellvec.resize(datasize);
-    for(auto &cell:Meshcellvec){
-        // receive Dim 
-        MPI_Irecv(&cell.Dim,1,MPI_INT,0,Basetag+2,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive NodesNumPerElmt
-        MPI_Irecv(&cell.NodesNumPerElmt,1,MPI_INT,0,Basetag+3,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtConn
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtConn.resize(datasize,0);
-        MPI_Irecv(cell.ElmtConn.data(),datasize,MPI_INT,0,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtNodeCoords0
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtNodeCoords0.resize(datasize);
-        MPI_Irecv(cell.ElmtNodeCoords0.getData(),datasize*3,MPI_DOUBLE,0,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        cell.ElmtNodeCoords=cell.ElmtNodeCoords0;// make a copy
-
-        // receive VTKCellType
-        MPI_Irecv(&cell.VTKCellType,1,MPI_INT,0,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
+    vector<char> buff;
+    receiveChunkedBufferFromMaster(buff,Tag+1);
+    BinaryReader reader(buff.data(),buff.size());
+    if(!unpackMeshCellVector(reader,Meshcellvec,EmptyPhyID2NameMap)){
+        MessagePrinter::printErrorTxt("the mesh cell received from master rank is broken, please check your code");
+        MessagePrinter::exitAsFem();
     }
 }
 
 //***********************************************************
 void MPIDataBus::sendPhyName2MeshCellMapToOthers(const string &Phyname,const vector<SingleMeshCell> &Meshcellvec,const int &Tag,const int &Cpuid){
-    int Basetag;
-    Basetag=Tag;
-
-    int datasize;
-
-    MPI_Request request;
-
-    // send out the physical name to each rank
-    datasize=static_cast<int>(Phyname.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-    // send the char
-    MPI_Isend(Phyname.c_str(),datasize,MPI_CHAR,Cpuid,Basetag+2,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    // send out the length of the mesh cell vector
-    datasize=static_cast<int>(Meshcellvec.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+3,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    for(const auto &cell:Meshcellvec){
-        // send Dim
-        MPI_Isend(&cell.Dim,1,MPI_INT,Cpuid,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send NodesNumPerElmt
-        MPI_Isend(&cell.NodesNumPerElmt,1,MPI_INT,Cpuid,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtConn
-        datasize=static_cast<int>(cell.ElmtConn.size());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtConn.data(),datasize,MPI_INT,Cpuid,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtNodeCoords0
-        datasize=static_cast<int>(cell.ElmtNodeCoords0.getSize());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtNodeCoords0.getCopy().data(),datasize*3,MPI_DOUBLE,Cpuid,Basetag+9,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send VTKCellType
-        MPI_Isend(&cell.VTKCellType,1,MPI_INT,Cpuid,Basetag+10,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-    }
+    BinaryWriter writer;
+    writer.writeString(Phyname);
+    packMeshCellVector(writer,Meshcellvec,EmptyPhyName2IDMap);
+    sendChunkedBufferToOther(writer.getDataRef(),Cpuid,Tag+1);
 }
 //*************************************************************************
 void MPIDataBus::receivePhyName2MeshCellMapFromMaster(map<string,vector<SingleMeshCell>> &Localmap,const int &Tag){
-    int Basetag;
-    Basetag=Tag;
-
     string Phyname;
-    char buff[108];
-
-    int datasize;
-
-    MPI_Request request;
     vector<SingleMeshCell> Meshcellvec;
-
-    // receive the size of physical name 
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-    // receive the char of phy name
-    MPI_Irecv(buff,datasize,MPI_CHAR,0,Basetag+2,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-    Phyname.clear();
-    for(int i=0;i<datasize;i++) Phyname.push_back(buff[i]);
-
-    // receive the length of the mesh cell vector
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+3,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    Meshcellvec.resize(datasize);
-    for(auto &cell:Meshcellvec){
-        // receive Dim
-        MPI_Irecv(&cell.Dim,1,MPI_INT,0,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive NodesNumPerElmt
-        MPI_Irecv(&cell.NodesNumPerElmt,1,MPI_INT,0,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtConn
-        datasize=0;
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtConn.resize(datasize,0);
-        MPI_Irecv(cell.ElmtConn.data(),datasize,MPI_INT,0,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtNodeCoords0
-        datasize=0;
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtNodeCoords0.resize(datasize);
-        MPI_Irecv(cell.ElmtNodeCoords0.getData(),datasize*3,MPI_DOUBLE,0,Basetag+9,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        cell.ElmtNodeCoords=cell.ElmtNodeCoords0;
-
-        // receive VTKCellType
-        MPI_Irecv(&cell.VTKCellType,1,MPI_INT,0,Basetag+10,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
+    vector<char> buff;
+    receiveChunkedBufferFromMaster(buff,Tag+1);
+    BinaryReader reader(buff.data(),buff.size());
+    if(!reader.readString(Phyname)||!unpackMeshCellVector(reader,Meshcellvec,EmptyPhyID2NameMap)){
+        MessagePrinter::printErrorTxt("the physical group mesh cell received from master rank is broken, please check your code");
+        MessagePrinter::exitAsFem();
     }
-
-    Localmap[Phyname]=Meshcellvec;
-    Meshcellvec.clear();
+    Localmap[Phyname]=std::move(Meshcellvec);
 }
 
 //**************************************************************
 void MPIDataBus::sendPhyID2MeshCellMapToOthers(const int &Phyid,const vector<SingleMeshCell> &Meshcellvec,const int &Tag,const int &Cpuid){
-    int Basetag;
-    Basetag=Tag;
-
-    int datasize;
-
-    MPI_Request request;
-
-    // send out the physical name to each rank
-    MPI_Isend(&Phyid,1,MPI_INT,Cpuid,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    // send out the length of the mesh cell vector
-    datasize=static_cast<int>(Meshcellvec.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+2,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-
-    for(const auto &cell:Meshcellvec){
-        // send Dim
-        MPI_Isend(&cell.Dim,1,MPI_INT,Cpuid,Basetag+3,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send NodesNumPerElmt
-        MPI_Isend(&cell.NodesNumPerElmt,1,MPI_INT,Cpuid,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtConn
-        datasize=static_cast<int>(cell.ElmtConn.size());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtConn.data(),datasize,MPI_INT,Cpuid,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send ElmtNodeCoords0
-        datasize=static_cast<int>(cell.ElmtNodeCoords0.getSize());
-        MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        MPI_Isend(cell.ElmtNodeCoords0.getCopy().data(),datasize*3,MPI_DOUBLE,Cpuid,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // send VTKCellType
-        MPI_Isend(&cell.VTKCellType,1,MPI_INT,Cpuid,Basetag+9,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-    }
+    BinaryWriter writer;
+    writer.writeValue(Phyid);
+    packMeshCellVector(writer,Meshcellvec,EmptyPhyName2IDMap);
+    sendChunkedBufferToOther(writer.getDataRef(),Cpuid,Tag+1);
 }
 //***************************************************************
 void MPIDataBus::receivePhyID2MeshCellMapFromMaster(map<int,vector<SingleMeshCell>> &Localmap,const int &Tag){
-    int Basetag;
-    Basetag=Tag;
-
-    int datasize;
     int phyid;
-
-    MPI_Request request;
     vector<SingleMeshCell> Meshcellvec;
-
-    // receive the physical name to each rank
-    MPI_Irecv(&phyid,1,MPI_INT,0,Basetag+1,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    // receive the length of the mesh cell vector
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+2,MPI_COMM_WORLD,&request);
-    MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-    Meshcellvec.resize(datasize);
-    for(auto &cell:Meshcellvec){
-        // receive Dim
-        MPI_Irecv(&cell.Dim,1,MPI_INT,0,Basetag+3,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive NodesNumPerElmt
-        MPI_Irecv(&cell.NodesNumPerElmt,1,MPI_INT,0,Basetag+4,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtConn
-        datasize=0;
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+5,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtConn.resize(datasize,0);
-        MPI_Irecv(cell.ElmtConn.data(),datasize,MPI_INT,0,Basetag+6,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-
-        // receive ElmtNodeCoords0
-        datasize=0;
-        MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+7,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        //
-        cell.ElmtNodeCoords0.resize(datasize);
-        MPI_Irecv(cell.ElmtNodeCoords0.getData(),datasize*3,MPI_DOUBLE,0,Basetag+8,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
-        cell.ElmtNodeCoords=cell.ElmtNodeCoords0;
-
-        // receive VTKCellType
-        MPI_Irecv(&cell.VTKCellType,1,MPI_INT,0,Basetag+9,MPI_COMM_WORLD,&request);
-        MPI_Wait(&request,MPI_STATUS_IGNORE);
+    vector<char> buff;
+    receiveChunkedBufferFromMaster(buff,Tag+1);
+    BinaryReader reader(buff.data(),buff.size());
+    if(!reader.readValue(phyid)||!unpackMeshCellVector(reader,Meshcellvec,EmptyPhyID2NameMap)){
+        MessagePrinter::printErrorTxt("the physical group mesh cell received from master rank is broken, please check your code");
+        MessagePrinter::exitAsFem();
     }
-
-    Localmap[phyid]=Meshcellvec;
-    Meshcellvec.clear();
+    Localmap[phyid]=std::move(Meshcellvec);
 }
 
 //******************************************************************
@@ -533,19 +305,19 @@ void MPIDataBus::sendPhyName2NodeIDVecMapToOthers(const string &Phyname,const ve
 
     // send out the physical name to each rank
     datasize=static_cast<int>(Phyname.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+1,MPI_COMM_WORLD,&request);
+    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+1,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     // send the char of the phy name
-    MPI_Isend(Phyname.c_str(),datasize,MPI_CHAR,Cpuid,Basetag+2,MPI_COMM_WORLD,&request);
+    MPI_Isend(Phyname.c_str(),datasize,MPI_CHAR,Cpuid,Basetag+2,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
 
     // send out the length of the node id vector
     datasize=static_cast<int>(Nodesid.size());
-    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+3,MPI_COMM_WORLD,&request);
+    MPI_Isend(&datasize,1,MPI_INT,Cpuid,Basetag+3,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     if (datasize>0) {
         // send out the node id vector
-        MPI_Isend(Nodesid.data(),datasize,MPI_INT,Cpuid,Basetag+4,MPI_COMM_WORLD,&request);
+        MPI_Isend(Nodesid.data(),datasize,MPI_INT,Cpuid,Basetag+4,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 }
@@ -563,25 +335,416 @@ void MPIDataBus::receivePhyName2NodeIDVecMapFromMaster(map<string,vector<int>> &
     vector<int> nodeidvec;
 
     // receive the physical name length from master rank
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+1,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+1,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     // receive the phy name
-    MPI_Irecv(buff,datasize,MPI_CHAR,0,Basetag+2,MPI_COMM_WORLD,&request);
+    MPI_Irecv(buff,datasize,MPI_CHAR,0,Basetag+2,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     phyname.clear();
     for(int i=0;i<datasize;i++) phyname.push_back(buff[i]);
 
     // receive the length of the nodeid vector
-    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+3,MPI_COMM_WORLD,&request);
+    MPI_Irecv(&datasize,1,MPI_INT,0,Basetag+3,PETSC_COMM_WORLD,&request);
     MPI_Wait(&request,MPI_STATUS_IGNORE);
     
     nodeidvec.resize(datasize,0);
     if (datasize>0) {
         // receive the nodeid vector
-        MPI_Irecv(nodeidvec.data(),datasize,MPI_INT,0,Basetag+4,MPI_COMM_WORLD,&request);
+        MPI_Irecv(nodeidvec.data(),datasize,MPI_INT,0,Basetag+4,PETSC_COMM_WORLD,&request);
         MPI_Wait(&request,MPI_STATUS_IGNORE);
     }
 
     Localmap[phyname]=nodeidvec;
     nodeidvec.clear();
-}
\ No newline at end of file
+}
+//********************************************************
+void MPIDataBus::exchangeBuffersAmongRanks(const vector<vector<char>> &SendBufs,vector<vector<char>> &RecvBufs){
+    int size,rank;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    // exchange the buffer size first, then the buffer itself
+    vector<uint64_t> SendSizes(size,0),RecvSizes(size,0);
+    for(int i=0;i<size;i++) SendSizes[i]=static_cast<uint64_t>(SendBufs[i].size());
+    MPI_Alltoall(SendSizes.data(),1,MPI_UINT64_T,RecvSizes.data(),1,MPI_UINT64_T,PETSC_COMM_WORLD);
+
+    long long SendTotal=0,RecvTotal=0;
+    for(int i=0;i<size;i++){
+        SendTotal+=static_cast<long long>(SendSizes[i]);
+        RecvTotal+=static_cast<long long>(RecvSizes[i]);
+    }
+    // the totals differ among ranks, so the switch to the point-to-point transfer is agreed by all the ranks
+    int IsTooLarge=(SendTotal>INT_MAX||RecvTotal>INT_MAX)?1:0;
+    MPI_Allreduce(MPI_IN_PLACE,&IsTooLarge,1,MPI_INT,MPI_MAX,PETSC_COMM_WORLD);
+
+    RecvBufs.resize(size);
+    if(IsTooLarge){
+        // each buffer is sent in chunks below 2GB, all the receives are posted before the sends
+        const int Tag=7000;
+        const size_t MaxChunkSize=static_cast<size_t>(INT_MAX);
+        vector<MPI_Request> requests;
+        for(int i=0;i<size;i++){
+            if(i==rank){
+                RecvBufs[i]=SendBufs[i];
+                continue;
+            }
+            RecvBufs[i].resize(static_cast<size_t>(RecvSizes[i]));
+            for(size_t offset=0;offset<RecvBufs[i].size();offset+=MaxChunkSize){
+                const size_t chunksize=std::min(MaxChunkSize,RecvBufs[i].size()-offset);
+                requests.emplace_back();
+                MPI_Irecv(RecvBufs[i].data()+offset,static_cast<int>(chunksize),MPI_CHAR,i,Tag,PETSC_COMM_WORLD,&requests.back());
+            }
+        }
+        for(int i=0;i<size;i++){
+            if(i==rank) continue;
+            for(size_t offset=0;offset<SendBufs[i].size();offset+=MaxChunkSize){
+                const size_t chunksize=std::min(MaxChunkSize,SendBufs[i].size()-offset);
+                requests.emplace_back();
+                MPI_Isend(SendBufs[i].data()+offset,static_cast<int>(chunksize),MPI_CHAR,i,Tag,PETSC_COMM_WORLD,&requests.back());
+            }
+        }
+        MPI_Waitall(static_cast<int>(requests.size()),requests.data(),MPI_STATUSES_IGNORE);
+        return;
+    }
+
+    vector<int> SendCounts(size,0),RecvCounts(size,0),SendDispls(size,0),RecvDispls(size,0);
+    int SendOffset=0,RecvOffset=0;
+    for(int i=0;i<size;i++){
+        SendCounts[i]=static_cast<int>(SendSizes[i]);
+        RecvCounts[i]=static_cast<int>(RecvSizes[i]);
+        SendDispls[i]=SendOffset;SendOffset+=SendCounts[i];
+        RecvDispls[i]=RecvOffset;RecvOffset+=RecvCounts[i];
+    }
+    vector<char> SendData,RecvData;
+    SendData.reserve(SendOffset);
+    for(int i=0;i<size;i++) SendData.insert(SendData.end(),SendBufs[i].begin(),SendBufs[i].end());
+    RecvData.resize(RecvOffset>0?RecvOffset:1);
+    if(SendData.empty()) SendData.push_back(0);
+
+    MPI_Alltoallv(SendData.data(),SendCounts.data(),SendDispls.data(),MPI_CHAR,
+                  RecvData.data(),RecvCounts.data(),RecvDispls.data(),MPI_CHAR,PETSC_COMM_WORLD);
+
+    for(int i=0;i<size;i++){
+        RecvBufs[i].assign(RecvData.begin()+RecvDispls[i],RecvData.begin()+RecvDispls[i]+RecvCounts[i]);
+    }
+}
+
+//********************************************************
+//*** for the packed buffer transfer
+//********************************************************
+void MPIDataBus::packMeshCellVector(BinaryWriter &Writer,const vector<SingleMeshCell> &MeshCellVec,const map<string,int> &PhyName2IDMap){
+    const uint64_t CellsNum=MeshCellVec.size();
+    Writer.writeValue(CellsNum);
+    if(CellsNum<1) return;
+
+    /**
+     * the fixed-size headers go first, then the arrays of all the cells are concatenated,
+     * the connectivity is stored as the index of the unique node list, so each node's coordinates are sent once
+     */
+    vector<MeshCellWireHeader> Headers(CellsNum);
+    vector<int> NodeIDs;
+    uint64_t ConnTotal=0,DofsTotal=0,NamesTotal=0,IDsTotal=0;
+    bool HasDeformedCoords=false;
+    for(uint64_t e=0;e<CellsNum;e++){
+        const SingleMeshCell &cell=MeshCellVec[e];
+        if(cell.ElmtNodeCoords0.getSize()!=static_cast<int>(cell.ElmtConn.size())){
+            MessagePrinter::printErrorTxt("the nodes number of the coordinates differs from the connectivity of a mesh cell, it can\'t be packed");
+            MessagePrinter::exitAsFem();
+        }
+        Headers[e].Dim=cell.Dim;
+        Headers[e].NodesNumPerElmt=cell.NodesNumPerElmt;
+        Headers[e].ConnNum=static_cast<int>(cell.ElmtConn.size());
+        Headers[e].DofsNum=static_cast<int>(cell.ElmtDofIDs.size());
+        Headers[e].VTKCellType=cell.VTKCellType;
+        Headers[e].CellMeshType=static_cast<int>(cell.CellMeshType);
+        Headers[e].PhysicalGroupNums=cell.PhysicalGroupNums;
+        Headers[e].PhyNamesNum=static_cast<int>(cell.PhysicalNameList.size());
+        Headers[e].PhyIDsNum=static_cast<int>(cell.PhysicalIDList.size());
+        Headers[e].Volume=cell.Volume;
+        ConnTotal+=Headers[e].ConnNum;
+        DofsTotal+=Headers[e].DofsNum;
+        NamesTotal+=Headers[e].PhyNamesNum;
+        IDsTotal+=Headers[e].PhyIDsNum;
+        NodeIDs.insert(NodeIDs.end(),cell.ElmtConn.begin(),cell.ElmtConn.end());
+        if(!HasDeformedCoords){
+            HasDeformedCoords=cell.ElmtNodeCoords.getLength()!=cell.ElmtNodeCoords0.getLength()||
+                              !std::equal(cell.ElmtNodeCoords0.getData(),cell.ElmtNodeCoords0.getData()+cell.ElmtNodeCoords0.getLength(),cell.ElmtNodeCoords.getData());
+        }
+    }
+    std::sort(NodeIDs.begin(),NodeIDs.end());
+    NodeIDs.erase(std::unique(NodeIDs.begin(),NodeIDs.end()),NodeIDs.end());
+
+    const size_t NodesNum=NodeIDs.size();
+    vector<double> Coords0(3*NodesNum,0.0),Coords;
+    vector<int> LocalConn,DofIDs,PhyNameIDs,PhyIDs;
+    vector<string> ExtraNames;
+    if(HasDeformedCoords) Coords.assign(3*NodesNum,0.0);
+    LocalConn.reserve(ConnTotal);
+    DofIDs.reserve(DofsTotal);
+    PhyNameIDs.reserve(NamesTotal);
+    PhyIDs.reserve(IDsTotal);
+    int LocalID;
+    for(const auto &cell:MeshCellVec){
+        for(int i=0;i<static_cast<int>(cell.ElmtConn.size());i++){
+            LocalID=static_cast<int>(std::lower_bound(NodeIDs.begin(),NodeIDs.end(),cell.ElmtConn[i])-NodeIDs.begin());
+            LocalConn.push_back(LocalID);
+            std::memcpy(Coords0.data()+3*LocalID,cell.ElmtNodeCoords0.getData()+3*i,3*sizeof(double));
+            if(HasDeformedCoords){
+                if(cell.ElmtNodeCoords.getLength()!=cell.ElmtNodeCoords0.getLength()){
+                    MessagePrinter::printErrorTxt("the deformed and undeformed coordinates of a mesh cell have different size, it can\'t be packed");
+                    MessagePrinter::exitAsFem();
+                }
+                std::memcpy(Coords.data()+3*LocalID,cell.ElmtNodeCoords.getData()+3*i,3*sizeof(double));
+            }
+        }
+        DofIDs.insert(DofIDs.end(),cell.ElmtDofIDs.begin(),cell.ElmtDofIDs.end());
+        PhyIDs.insert(PhyIDs.end(),cell.PhysicalIDList.begin(),cell.PhysicalIDList.end());
+        // the physical names are replaced by the global physical id, the unknown ones go to a small string table
+        for(const auto &name:cell.PhysicalNameList){
+            auto it=PhyName2IDMap.find(name);
+            if(it!=PhyName2IDMap.end()){
+                PhyNameIDs.push_back(it->second);
+            }
+            else{
+                auto jt=std::find(ExtraNames.begin(),ExtraNames.end(),name);
+                if(jt==ExtraNames.end()) jt=ExtraNames.insert(ExtraNames.end(),name);
+                PhyNameIDs.push_back(-1-static_cast<int>(jt-ExtraNames.begin()));
+            }
+        }
+    }
+
+    Writer.writeValue(static_cast<uint64_t>(NodesNum));
+    Writer.writeValue(static_cast<uint8_t>(HasDeformedCoords?1:0));
+    Writer.writeValue(ConnTotal);
+    Writer.writeValue(DofsTotal);
+    Writer.writeValue(NamesTotal);
+    Writer.writeValue(IDsTotal);
+    Writer.reserve(Writer.getSize()+CellsNum*sizeof(MeshCellWireHeader)+NodesNum*(sizeof(int)+(HasDeformedCoords?6:3)*sizeof(double))
+                   +(ConnTotal+DofsTotal+NamesTotal+IDsTotal)*sizeof(int));
+    Writer.writeRawArray(Headers.data(),Headers.size());
+    Writer.writeRawArray(NodeIDs.data(),NodeIDs.size());
+    Writer.writeRawArray(Coords0.data(),Coords0.size());
+    if(HasDeformedCoords) Writer.writeRawArray(Coords.data(),Coords.size());
+    Writer.writeRawArray(LocalConn.data(),LocalConn.size());
+    Writer.writeRawArray(DofIDs.data(),DofIDs.size());
+    Writer.writeRawArray(PhyNameIDs.data(),PhyNameIDs.size());
+    Writer.writeRawArray(PhyIDs.data(),PhyIDs.size());
+    Writer.writeStringVector(ExtraNames);
+}
+bool MPIDataBus::unpackMeshCellVector(BinaryReader &Reader,vector<SingleMeshCell> &MeshCellVec,const map<int,string> &PhyID2NameMap){
+    uint64_t CellsNum,NodesNum,ConnTotal,DofsTotal,NamesTotal,IDsTotal;
+    uint8_t HasDeformedCoords;
+    MeshCellVec.clear();
+    if(!Reader.readValue(CellsNum)) return false;
+    if(CellsNum<1) return true;
+    Reader.readValue(NodesNum);
+    Reader.readValue(HasDeformedCoords);
+    Reader.readValue(ConnTotal);
+    Reader.readValue(DofsTotal);
+    Reader.readValue(NamesTotal);
+    Reader.readValue(IDsTotal);
+    // the arrays can't be larger than the remaining buffer
+    if(!Reader.isValid()||
+       CellsNum>Reader.getRemainingSize()/sizeof(MeshCellWireHeader)||
+       NodesNum>Reader.getRemainingSize()/sizeof(int)||
+       ConnTotal>Reader.getRemainingSize()/sizeof(int)||
+       DofsTotal>Reader.getRemainingSize()/sizeof(int)||
+       NamesTotal>Reader.getRemainingSize()/sizeof(int)||
+       IDsTotal>Reader.getRemainingSize()/sizeof(int)) return false;
+
+    vector<MeshCellWireHeader> Headers(CellsNum);
+    vector<int> NodeIDs(NodesNum),LocalConn(ConnTotal),DofIDs(DofsTotal),PhyNameIDs(NamesTotal),PhyIDs(IDsTotal);
+    vector<double> Coords0,Coords;
+    vector<string> ExtraNames;
+    if(!Reader.readRawArray(Headers.data(),Headers.size())) return false;
+    if(!Reader.readRawArray(NodeIDs.data(),NodeIDs.size())) return false;
+    if(3*NodesNum>Reader.getRemainingSize()/sizeof(double)) return false;
+    Coords0.resize(3*NodesNum);
+    if(!Reader.readRawArray(Coords0.data(),Coords0.size())) return false;
+    if(HasDeformedCoords){
+        if(3*NodesNum>Reader.getRemainingSize()/sizeof(double)) return false;
+        Coords.resize(3*NodesNum);
+        if(!Reader.readRawArray(Coords.data(),Coords.size())) return false;
+    }
+    if(!Reader.readRawArray(LocalConn.data(),LocalConn.size())) return false;
+    if(!Reader.readRawArray(DofIDs.data(),DofIDs.size())) return false;
+    if(!Reader.readRawArray(PhyNameIDs.data(),PhyNameIDs.size())) return false;
+    if(!Reader.readRawArray(PhyIDs.data(),PhyIDs.size())) return false;
+    if(!Reader.readStringVector(ExtraNames)) return false;
+
+    uint64_t ConnSum=0,DofsSum=0,NamesSum=0,IDsSum=0;
+    for(const auto &header:Headers){
+        if(header.ConnNum<0||header.DofsNum<0||header.PhyNamesNum<0||header.PhyIDsNum<0) return false;
+        ConnSum+=header.ConnNum;
+        DofsSum+=header.DofsNum;
+        NamesSum+=header.PhyNamesNum;
+        IDsSum+=header.PhyIDsNum;
+    }
+    if(ConnSum!=ConnTotal||DofsSum!=DofsTotal||NamesSum!=NamesTotal||IDsSum!=IDsTotal) return false;
+
+    MeshCellVec.resize(CellsNum);
+    const int *pConn=LocalConn.data();
+    const int *pDofs=DofIDs.data();
+    const int *pNames=PhyNameIDs.data();
+    const int *pIDs=PhyIDs.data();
+    int LocalID;
+    for(uint64_t e=0;e<CellsNum;e++){
+        const MeshCellWireHeader &header=Headers[e];
+        SingleMeshCell &cell=MeshCellVec[e];
+        cell.Dim=header.Dim;
+        cell.NodesNumPerElmt=header.NodesNumPerElmt;
+        cell.VTKCellType=header.VTKCellType;
+        cell.CellMeshType=static_cast<MeshType>(header.CellMeshType);
+        cell.PhysicalGroupNums=header.PhysicalGroupNums;
+        cell.Volume=header.Volume;
+
+        cell.ElmtConn.resize(header.ConnNum);
+        cell.ElmtNodeCoords0.resize(header.ConnNum);
+        if(HasDeformedCoords) cell.ElmtNodeCoords.resize(header.ConnNum);
+        for(int i=0;i<header.ConnNum;i++){
+            LocalID=pConn[i];
+            if(LocalID<0||static_cast<uint64_t>(LocalID)>=NodesNum) return false;
+            cell.ElmtConn[i]=NodeIDs[LocalID];
+            std::memcpy(cell.ElmtNodeCoords0.getData()+3*i,Coords0.data()+3*LocalID,3*sizeof(double));
+            if(HasDeformedCoords) std::memcpy(cell.ElmtNodeCoords.getData()+3*i,Coords.data()+3*LocalID,3*sizeof(double));
+        }
+        if(!HasDeformedCoords) cell.ElmtNodeCoords=cell.ElmtNodeCoords0;
+        pConn+=header.ConnNum;
+
+        cell.ElmtDofIDs.assign(pDofs,pDofs+header.DofsNum);
+        pDofs+=header.DofsNum;
+        cell.PhysicalIDList.assign(pIDs,pIDs+header.PhyIDsNum);
+        pIDs+=header.PhyIDsNum;
+
+        cell.PhysicalNameList.resize(header.PhyNamesNum);
+        for(int i=0;i<header.PhyNamesNum;i++){
+            if(pNames[i]>=0){
+                auto it=PhyID2NameMap.find(pNames[i]);
+                if(it==PhyID2NameMap.end()) return false;
+                cell.PhysicalNameList[i]=it->second;
+            }
+            else{
+                if(-1-pNames[i]>=static_cast<int>(ExtraNames.size())) return false;
+                cell.PhysicalNameList[i]=ExtraNames[-1-pNames[i]];
+            }
+        }
+        pNames+=header.PhyNamesNum;
+    }
+    return true;
+}
+//********************************************************
+void MPIDataBus::packAlignedVectorOfIntegerVector(BinaryWriter &Writer,const vector<vector<int>> &Vec){
+    /**
+     * The input Vec must have the same number of cols, otherwise it dosen\'t work!!!
+     */
+    const uint64_t vecsize=Vec.size();
+    const uint64_t width=vecsize>0?Vec[0].size():0;
+    Writer.writeValue(vecsize);
+    Writer.writeValue(width);
+    Writer.reserve(Writer.getSize()+vecsize*width*sizeof(int));
+    for(const auto &it:Vec) Writer.writeRawArray(it.data(),static_cast<size_t>(width));
+}
+bool MPIDataBus::unpackAlignedVectorOfIntegerVector(BinaryReader &Reader,vector<vector<int>> &Vec){
+    uint64_t vecsize,width;
+    if(!Reader.readValue(vecsize)||!Reader.readValue(width)) return false;
+    if(width>0&&vecsize>Reader.getRemainingSize()/(width*sizeof(int))) return false;
+    Vec.assign(static_cast<size_t>(vecsize),vector<int>(static_cast<size_t>(width),0));
+    for(auto &it:Vec){
+        if(!Reader.readRawArray(it.data(),static_cast<size_t>(width))) return false;
+    }
+    return true;
+}
+//********************************************************
+void MPIDataBus::sendBuffersToOthers(const vector<vector<char>> &SendBufs,const int &Tag){
+    int size;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    const size_t MaxChunkSize=static_cast<size_t>(INT_MAX);
+    // the same size-then-chunks layout as sendChunkedBufferToOther, but all the messages are posted at once
+    vector<uint64_t> datasizes(size,0);
+    vector<MPI_Request> requests;
+    requests.reserve(2*size);
+    for(int cpuid=1;cpuid<size;cpuid++){
+        datasizes[cpuid]=static_cast<uint64_t>(SendBufs[cpuid].size());
+        requests.emplace_back();
+        MPI_Isend(&datasizes[cpuid],1,MPI_UINT64_T,cpuid,Tag,PETSC_COMM_WORLD,&requests.back());
+        for(size_t offset=0;offset<SendBufs[cpuid].size();offset+=MaxChunkSize){
+            const size_t chunksize=std::min(MaxChunkSize,SendBufs[cpuid].size()-offset);
+            requests.emplace_back();
+            MPI_Isend(SendBufs[cpuid].data()+offset,static_cast<int>(chunksize),MPI_CHAR,cpuid,Tag,PETSC_COMM_WORLD,&requests.back());
+        }
+    }
+    MPI_Waitall(static_cast<int>(requests.size()),requests.data(),MPI_STATUSES_IGNORE);
+}
+void MPIDataBus::sendChunkedBufferToOther(const vector<char> &Buf,const int &cpuid,const int &Tag){
+    const size_t MaxChunkSize=static_cast<size_t>(INT_MAX);
+    uint64_t datasize=static_cast<uint64_t>(Buf.size());
+    MPI_Send(&datasize,1,MPI_UINT64_T,cpuid,Tag,PETSC_COMM_WORLD);
+    for(size_t offset=0;offset<Buf.size();offset+=MaxChunkSize){
+        const size_t chunksize=std::min(MaxChunkSize,Buf.size()-offset);
+        MPI_Send(Buf.data()+offset,static_cast<int>(chunksize),MPI_CHAR,cpuid,Tag,PETSC_COMM_WORLD);
+    }
+}
+void MPIDataBus::receiveChunkedBufferFromMaster(vector<char> &Buf,const int &Tag){
+    const size_t MaxChunkSize=static_cast<size_t>(INT_MAX);
+    uint64_t datasize;
+    MPI_Recv(&datasize,1,MPI_UINT64_T,0,Tag,PETSC_COMM_WORLD,MPI_STATUS_IGNORE);
+    Buf.resize(static_cast<size_t>(datasize));
+    for(size_t offset=0;offset<Buf.size();offset+=MaxChunkSize){
+        const size_t chunksize=std::min(MaxChunkSize,Buf.size()-offset);
+        MPI_Recv(Buf.data()+offset,static_cast<int>(chunksize),MPI_CHAR,0,Tag,PETSC_COMM_WORLD,MPI_STATUS_IGNORE);
+    }
+}
+//********************************************************
+void MPIDataBus::scatterBuffersFromMaster(const vector<vector<char>> &SendBufs,vector<char> &RecvBuf){
+    int size,rank;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    vector<int> SendCounts,SendDispls;
+    vector<char> SendData;
+    // the size check is shared by all the ranks, so no rank is left waiting in the collective calls
+    int IsTooLarge=0;
+    size_t total=0;
+    if(rank==0){
+        for(int i=0;i<size;i++) total+=SendBufs[i].size();
+        IsTooLarge=total>static_cast<size_t>(INT_MAX)?1:0;
+    }
+    MPI_Bcast(&IsTooLarge,1,MPI_INT,0,PETSC_COMM_WORLD);
+    if(IsTooLarge){
+        MessagePrinter::printErrorTxt("the scattered buffers exceed 2GB in total, please use the point-to-point transfer");
+        MessagePrinter::exitAsFem();
+    }
+    if(rank==0){
+        SendCounts.assign(size,0);
+        SendDispls.assign(size,0);
+        total=0;
+        for(int i=0;i<size;i++){
+            SendDispls[i]=static_cast<int>(total);
+            SendCounts[i]=static_cast<int>(SendBufs[i].size());
+            total+=SendBufs[i].size();
+        }
+        SendData.reserve(total>0?total:1);
+        for(int i=0;i<size;i++) SendData.insert(SendData.end(),SendBufs[i].begin(),SendBufs[i].end());
+        if(SendData.empty()) SendData.push_back(0);
+    }
+    int RecvCount=0;
+    MPI_Scatter(SendCounts.data(),1,MPI_INT,&RecvCount,1,MPI_INT,0,PETSC_COMM_WORLD);
+    RecvBuf.resize(RecvCount>0?RecvCount:1);
+    MPI_Scatterv(SendData.data(),SendCounts.data(),SendDispls.data(),MPI_CHAR,
+                 RecvBuf.data(),RecvCount,MPI_CHAR,0,PETSC_COMM_WORLD);
+    RecvBuf.resize(RecvCount);
+}
+//********************************************************
+void MPIDataBus::broadcastBufferFromMaster(vector<char> &Buf){
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    const size_t MaxChunkSize=static_cast<size_t>(INT_MAX);
+    uint64_t datasize=static_cast<uint64_t>(Buf.size());
+    MPI_Bcast(&datasize,1,MPI_UINT64_T,0,PETSC_COMM_WORLD);
+    if(rank!=0) Buf.resize(static_cast<size_t>(datasize));
+    // the buffer is broadcast in chunks below 2GB, so its size is not limited by the int count of MPI
+    for(size_t offset=0;offset<Buf.size();offset+=MaxChunkSize){
+        const size_t chunksize=std::min(MaxChunkSize,Buf.size()-offset);
+        MPI_Bcast(Buf.data()+offset,static_cast<int>(chunksize),MPI_CHAR,0,PETSC_COMM_WORLD);
+    }
+}
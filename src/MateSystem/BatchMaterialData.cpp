@@ -0,0 +1,85 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.20
+//+++ Purpose: pack the old materials into and unpack the batched
+//+++          materials from the SoA arrays
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "MateSystem/BatchMaterialData.h"
+
+const double* BatchMaterialInput::ScalarMaterialOld(const string &matename)const{
+    auto it=m_ScalarMaterialsOld.find(matename);
+    if(it==m_ScalarMaterialsOld.end()){
+        MessagePrinter::printErrorTxt("scalar material ("+matename+") is not defined in your old materials");
+        MessagePrinter::exitAsFem();
+    }
+    return it->second.data();
+}
+const double* BatchMaterialInput::Rank2MaterialOld(const string &matename)const{
+    auto it=m_Rank2MaterialsOld.find(matename);
+    if(it==m_Rank2MaterialsOld.end()){
+        MessagePrinter::printErrorTxt("rank-2 material ("+matename+") is not defined in your old materials");
+        MessagePrinter::exitAsFem();
+    }
+    return it->second.data();
+}
+
+void BatchMaterialInput::packMaterialsOld(const int &q,const MaterialsContainer &t_mateold){
+    const int N=m_QpointsNum;
+    for(const auto &it:t_mateold.getScalarMaterialsRef()){
+        vector<double> &vals=m_ScalarMaterialsOld[it.first];
+        vals.resize(N,0.0);
+        vals[q]=it.second;
+    }
+    for(const auto &it:t_mateold.getVectorMaterialsRef()){
+        vector<double> &vals=m_VectorMaterialsOld[it.first];
+        vals.resize(3*N,0.0);
+        for(int k=1;k<=3;k++) vals[(k-1)*N+q]=it.second(k);
+    }
+    for(const auto &it:t_mateold.getRank2MaterialsRef()){
+        vector<double> &vals=m_Rank2MaterialsOld[it.first];
+        vals.resize(9*N,0.0);
+        for(int i=1;i<=3;i++){
+            for(int j=1;j<=3;j++) vals[((i-1)*3+j-1)*N+q]=it.second(i,j);
+        }
+    }
+}
+
+void BatchMaterialOutput::unpack(const int &q,MaterialsContainer &t_mate)const{
+    const int N=m_QpointsNum;
+    for(const auto &it:m_ScalarMaterials){
+        t_mate.ScalarMaterial(it.first)=it.second[q];
+    }
+    for(const auto &it:m_VectorMaterials){
+        Vector3d &vec=t_mate.VectorMaterial(it.first);
+        for(int k=1;k<=3;k++) vec(k)=it.second[(k-1)*N+q];
+    }
+    for(const auto &it:m_Rank2Materials){
+        Rank2Tensor &tensor=t_mate.Rank2Material(it.first);
+        for(int i=1;i<=3;i++){
+            for(int j=1;j<=3;j++) tensor(i,j)=it.second[((i-1)*3+j-1)*N+q];
+        }
+    }
+    for(const auto &it:m_Rank4Materials){
+        Rank4Tensor &tensor=t_mate.Rank4Material(it.first);
+        int c=0;
+        for(int i=1;i<=3;i++){
+            for(int j=1;j<=3;j++){
+                for(int k=1;k<=3;k++){
+                    for(int l=1;l<=3;l++){
+                        tensor(i,j,k,l)=it.second[c*N+q];
+                        c+=1;
+                    }
+                }
+            }
+        }
+    }
+}
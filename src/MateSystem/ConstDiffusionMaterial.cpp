@@ -44,4 +44,23 @@ void ConstDiffusionMaterial::computeMaterialProperties(const nlohmann::json &inp
     mate.ScalarMaterial("dDdc")=0.0;// dD/dc
     mate.VectorMaterial("gradc")=elmtsoln.m_QpGradU[1];// the gradient of concentration
 
-}
\ No newline at end of file
+}
+//********************************************************************
+void ConstDiffusionMaterial::computeBatchMaterialProperties(const nlohmann::json &inputparams,
+                                                            const BatchMaterialInput &input,
+                                                            BatchMaterialOutput &output){
+    const int N=input.m_QpointsNum;
+    const double D=JsonUtils::getValue(inputparams,"D");// diffusivity
+
+    double *D_q=output.ScalarMaterial("D");
+    double *dDdc=output.ScalarMaterial("dDdc");
+    double *gradc=output.VectorMaterial("gradc");
+    for(int q=0;q<N;q++){
+        D_q[q]=D;
+        dDdc[q]=0.0;
+    }
+    for(int k=1;k<=3;k++){
+        const double *dc=input.GradU(1,k);
+        for(int q=0;q<N;q++) gradc[(k-1)*N+q]=dc[q];
+    }
+}
@@ -86,4 +86,39 @@ void DoubleWellPotentialMaterial::computeFreeEnergyAndDerivatives(const nlohmann
     dFdargs(1)=2.0*m_w*(c-m_a)*(c-m_b)*(2.0*c-m_a-m_b);
     d2Fdargs2(1,1)=2.0*m_w*(m_a*m_a+4*m_a*m_b+m_b*m_b-6*m_a*c-6*m_b*c+6*c*c);
 
-}
\ No newline at end of file
+}
+//**************************************************************
+void DoubleWellPotentialMaterial::computeBatchMaterialProperties(const nlohmann::json &inputparams,
+                                                                 const BatchMaterialInput &input,
+                                                                 BatchMaterialOutput &output){
+    if(!JsonUtils::hasOnlyGivenValues(inputparams,vector<string>{"alpha","beta","w","L","eps"})){
+        MessagePrinter::printErrorTxt("DoubleWellPotential material requires only: alpha, beta, w, L, and eps, "
+                                      "please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+    const int N=input.m_QpointsNum;
+    const double a=JsonUtils::getValue(inputparams,"alpha");
+    const double b=JsonUtils::getValue(inputparams,"beta");
+    const double w=JsonUtils::getValue(inputparams,"w");
+    const double eps=JsonUtils::getValue(inputparams,"eps");
+    const double L=JsonUtils::getValue(inputparams,"L");
+
+    const double *c=input.U(1);
+    double *F=output.ScalarMaterial("F");
+    double *dFdeta=output.ScalarMaterial("dFdeta");
+    double *d2Fdeta2=output.ScalarMaterial("d2Fdeta2");
+    double *eps_q=output.ScalarMaterial("eps");
+    double *L_q=output.ScalarMaterial("L");
+    double *gradu=output.VectorMaterial("gradu");
+    for(int q=0;q<N;q++){
+        F[q]=w*(c[q]-a)*(c[q]-a)*(c[q]-b)*(c[q]-b);
+        dFdeta[q]=2.0*w*(c[q]-a)*(c[q]-b)*(2.0*c[q]-a-b);
+        d2Fdeta2[q]=2.0*w*(a*a+4*a*b+b*b-6*a*c[q]-6*b*c[q]+6*c[q]*c[q]);
+        eps_q[q]=eps;
+        L_q[q]=L;
+    }
+    for(int k=1;k<=3;k++){
+        const double *du=input.GradU(1,k);
+        for(int q=0;q<N;q++) gradu[(k-1)*N+q]=du[q];
+    }
+}
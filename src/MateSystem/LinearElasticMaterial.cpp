@@ -157,4 +157,107 @@ void LinearElasticMaterial::computeStressAndJacobian(const nlohmann::json &param
         }
     }
 
-}
\ No newline at end of file
+}
+void LinearElasticMaterial::computeBatchMaterialProperties(const nlohmann::json &params,
+                                                           const BatchMaterialInput &input,
+                                                           BatchMaterialOutput &output){
+    const int N=input.m_QpointsNum;
+    const int dim=input.m_Dim;
+    double E,nu;// Youngs modulus and poisso ratio
+    double K,G; // bulk moduli and shear moduli
+    double lame;// lame constant
+
+    E=nu=K=G=lame=0.0;
+    if(JsonUtils::hasValue(params,"E")&&
+       JsonUtils::hasValue(params,"nu")){
+        E=JsonUtils::getValue(params,"E");
+        nu=JsonUtils::getValue(params,"nu");
+        lame=E*nu/((1.0+nu)*(1.0-2.0*nu));
+        G=0.5*E/(1+nu);
+    }
+    else if(JsonUtils::hasValue(params,"K")&&
+            JsonUtils::hasValue(params,"G")){
+        K=JsonUtils::getValue(params,"K");
+        G=JsonUtils::getValue(params,"G");
+        lame=K-2.0*G/3.0;
+    }
+    else if(JsonUtils::hasValue(params,"Lame")&&
+            JsonUtils::hasValue(params,"G")){
+        lame=JsonUtils::getValue(params,"Lame");
+        G=JsonUtils::getValue(params,"G");
+    }
+    else{
+        MessagePrinter::printErrorTxt("Invalid parameters, for linear elastic material, you should give either E,nu or K,G or Lame,G. Please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+    bool IsPlaneStress=false;
+    if(JsonUtils::hasValue(params,"plane-strain")){
+        if(dim!=2){
+            MessagePrinter::printErrorTxt("plane-strain option works only for 2d case, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+        IsPlaneStress=!JsonUtils::getBoolean(params,"plane-strain");
+    }
+
+    double *strain=output.Rank2Material("strain");
+    double *stress=output.Rank2Material("stress");
+    double *jacobian=output.Rank4Material("jacobian");
+
+    // eps_ij=0.5*(u_i,j+u_j,i), the components beyond dim stay zero
+    for(int i=1;i<=dim;i++){
+        for(int j=1;j<=dim;j++){
+            const double *gij=input.GradU(i,j);
+            const double *gji=input.GradU(j,i);
+            double *eps=strain+batchRank2ID(i,j)*N;
+            for(int q=0;q<N;q++) eps[q]=0.5*(gij[q]+gji[q]);
+        }
+    }
+    if(IsPlaneStress){
+        // stress_zz=0=lame*(strain_kk)+2*mu*strain_zz gives the strain_zz of the plane-stress case
+        const double *e11=strain+batchRank2ID(1,1)*N;
+        const double *e22=strain+batchRank2ID(2,2)*N;
+        double *e33=strain+batchRank2ID(3,3)*N;
+        for(int q=0;q<N;q++) e33[q]=-lame*(e11[q]+e22[q])/(lame+2.0*G);
+    }
+
+    // stress_ij=lame*delta_ij*trace(eps_ij)+2mu*eps_ij, the jacobian is the same for all the qpoints
+    const double *e11=strain+batchRank2ID(1,1)*N;
+    const double *e22=strain+batchRank2ID(2,2)*N;
+    const double *e33=strain+batchRank2ID(3,3)*N;
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            const double *eps=strain+batchRank2ID(i,j)*N;
+            double *sig=stress+batchRank2ID(i,j)*N;
+            if(i==j){
+                for(int q=0;q<N;q++) sig[q]=lame*(e11[q]+e22[q]+e33[q])+2.0*G*eps[q];
+            }
+            else{
+                for(int q=0;q<N;q++) sig[q]=2.0*G*eps[q];
+            }
+            for(int k=1;k<=3;k++){
+                for(int l=1;l<=3;l++){
+                    const double val=lame*(i==j)*(k==l)+G*((i==k)*(j==l)+(i==l)*(j==k));
+                    double *jac=jacobian+batchRank4ID(i,j,k,l)*N;
+                    for(int q=0;q<N;q++) jac[q]=val;
+                }
+            }
+        }
+    }
+
+    double *hydro=output.ScalarMaterial("hydrostatic-stress");
+    const double *s11=stress+batchRank2ID(1,1)*N;
+    const double *s22=stress+batchRank2ID(2,2)*N;
+    const double *s33=stress+batchRank2ID(3,3)*N;
+    for(int q=0;q<N;q++) hydro[q]=(s11[q]+s22[q]+s33[q])/3.0;
+    batchVonMises(N,stress,output.ScalarMaterial("vonMises-stress"));
+    batchVonMises(N,strain,output.ScalarMaterial("vonMises-strain"));
+
+    const vector<string> GradNames{"gradux","graduy","graduz"};
+    for(int i=1;i<=dim;i++){
+        double *gradu=output.VectorMaterial(GradNames[i-1]);
+        for(int k=1;k<=3;k++){
+            const double *du=input.GradU(i,k);
+            for(int q=0;q<N;q++) gradu[(k-1)*N+q]=du[q];
+        }
+    }
+}
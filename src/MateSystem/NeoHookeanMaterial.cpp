@@ -125,4 +125,195 @@ void NeoHookeanMaterial::computeStressAndJacobian(const nlohmann::json &params,
     
     //TODO: add plane-stress modification
 
-}
\ No newline at end of file
+}
+void NeoHookeanMaterial::computeBatchMaterialProperties(const nlohmann::json &params,
+                                                        const BatchMaterialInput &input,
+                                                        BatchMaterialOutput &output){
+    const int N=input.m_QpointsNum;
+    const int dim=input.m_Dim;
+    double E=0.0,nu=0.0;
+    double K=0.0,G=0.0;
+    double lame=0.0;
+    if(JsonUtils::hasValue(params,"E")&&
+       JsonUtils::hasValue(params,"nu")){
+        E=JsonUtils::getValue(params,"E");
+        nu=JsonUtils::getValue(params,"nu");
+        lame=E*nu/((1+nu)*(1-2*nu));
+        G=0.5*E/(1.0+nu);
+    }
+    else if(JsonUtils::hasValue(params,"K")&&
+            JsonUtils::hasValue(params,"G")){
+        K=JsonUtils::getValue(params,"K");
+        G=JsonUtils::getValue(params,"G");
+        lame=K-G*2.0/3.0;
+    }
+    else if(JsonUtils::hasValue(params,"Lame")&&
+            JsonUtils::hasValue(params,"mu")){
+        lame=JsonUtils::getValue(params,"Lame");
+        G=JsonUtils::getValue(params,"mu");
+    }
+    else{
+        MessagePrinter::printErrorTxt("Invalid parameters, for neohookean material, you should give either E,nu or K,G or Lame,G. Please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+
+    // the scratch arrays: F, C^-1, the 2nd PK stress S, F*C^-1, J and det(C)
+    m_BatchWork.resize(38*N);
+    double *F=m_BatchWork.data();
+    double *Cinv=F+9*N;
+    double *S=Cinv+9*N;
+    double *FCinv=S+9*N;
+    double *J=FCinv+9*N;
+    double *detC=J+N;
+
+    double *strain=output.Rank2Material("strain");// the Lagrangian-Green strain
+    double *stress=output.Rank2Material("stress");// the 1st PK stress
+    double *cauchy=output.Rank2Material("cauchy-stress");
+    double *jacobian=output.Rank4Material("jacobian");
+    double *psi=output.ScalarMaterial("psi");
+
+    // F=I+gradU, the components beyond dim only keep the identity part
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            double *Fij=F+batchRank2ID(i,j)*N;
+            const double delta=(i==j)?1.0:0.0;
+            if(i<=dim&&j<=dim){
+                const double *gij=input.GradU(i,j);
+                for(int q=0;q<N;q++) Fij[q]=delta+gij[q];
+            }
+            else{
+                for(int q=0;q<N;q++) Fij[q]=delta;
+            }
+        }
+    }
+    // C=F^T*F is stored in the strain slot first
+    double *C=strain;
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            double *Cij=C+batchRank2ID(i,j)*N;
+            for(int q=0;q<N;q++) Cij[q]=0.0;
+            for(int k=1;k<=3;k++){
+                const double *Fki=F+batchRank2ID(k,i)*N;
+                const double *Fkj=F+batchRank2ID(k,j)*N;
+                for(int q=0;q<N;q++) Cij[q]+=Fki[q]*Fkj[q];
+            }
+        }
+    }
+    const double *F11=F,*F12=F+N,*F13=F+2*N,*F21=F+3*N,*F22=F+4*N,*F23=F+5*N,*F31=F+6*N,*F32=F+7*N,*F33=F+8*N;
+    const double *C11=C,*C12=C+N,*C13=C+2*N,*C21=C+3*N,*C22=C+4*N,*C23=C+5*N,*C31=C+6*N,*C32=C+7*N,*C33=C+8*N;
+    int SingularNum=0;
+    for(int q=0;q<N;q++){
+        J[q]=F11[q]*F22[q]*F33[q]-F11[q]*F23[q]*F32[q]-F12[q]*F21[q]*F33[q]
+            +F12[q]*F23[q]*F31[q]+F13[q]*F21[q]*F32[q]-F13[q]*F22[q]*F31[q];
+        detC[q]=C11[q]*C22[q]*C33[q]-C11[q]*C23[q]*C32[q]-C12[q]*C21[q]*C33[q]
+               +C12[q]*C23[q]*C31[q]+C13[q]*C21[q]*C32[q]-C13[q]*C22[q]*C31[q];
+        SingularNum+=(std::abs(detC[q])<1.0e-16)?1:0;
+    }
+    if(SingularNum>0){
+        MessagePrinter::printErrorTxt("inverse operation failed for a singular rank-2 tensor !");
+        MessagePrinter::exitAsFem();
+    }
+    for(int q=0;q<N;q++){
+        Cinv[q]    =( C22[q]*C33[q]-C23[q]*C32[q])/detC[q];
+        Cinv[N+q]  =(-C12[q]*C33[q]+C13[q]*C32[q])/detC[q];
+        Cinv[2*N+q]=( C12[q]*C23[q]-C13[q]*C22[q])/detC[q];
+        Cinv[3*N+q]=(-C21[q]*C33[q]+C23[q]*C31[q])/detC[q];
+        Cinv[4*N+q]=( C11[q]*C33[q]-C13[q]*C31[q])/detC[q];
+        Cinv[5*N+q]=(-C11[q]*C23[q]+C13[q]*C21[q])/detC[q];
+        Cinv[6*N+q]=( C21[q]*C32[q]-C22[q]*C31[q])/detC[q];
+        Cinv[7*N+q]=(-C11[q]*C32[q]+C12[q]*C31[q])/detC[q];
+        Cinv[8*N+q]=( C11[q]*C22[q]-C12[q]*C21[q])/detC[q];
+        // the polyconvex strain energy
+        psi[q]=0.5*G*(C11[q]+C22[q]+C33[q]-3.0)+(lame/4.0)*(J[q]*J[q]-1)-(0.5*lame+G)*log(J[q]);
+    }
+    // S=0.5*lame*(J^2-1)*C^-1+G*(I-C^-1), then E=0.5*(C-I) overwrites C
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            const int c=batchRank2ID(i,j)*N;
+            const double delta=(i==j)?1.0:0.0;
+            for(int q=0;q<N;q++){
+                S[c+q]=Cinv[c+q]*0.5*lame*(J[q]*J[q]-1.0)+(delta-Cinv[c+q])*G;
+                strain[c+q]=(strain[c+q]-delta)*0.5;
+            }
+        }
+    }
+    // P=F*S, sigma=F*S*F^T/J and F*C^-1
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            double *Pij=stress+batchRank2ID(i,j)*N;
+            double *Aij=FCinv+batchRank2ID(i,j)*N;
+            for(int q=0;q<N;q++){
+                Pij[q]=0.0;
+                Aij[q]=0.0;
+            }
+            for(int k=1;k<=3;k++){
+                const double *Fik=F+batchRank2ID(i,k)*N;
+                const double *Skj=S+batchRank2ID(k,j)*N;
+                const double *Cikj=Cinv+batchRank2ID(k,j)*N;
+                for(int q=0;q<N;q++){
+                    Pij[q]+=Fik[q]*Skj[q];
+                    Aij[q]+=Fik[q]*Cikj[q];
+                }
+            }
+        }
+    }
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            double *sig=cauchy+batchRank2ID(i,j)*N;
+            for(int q=0;q<N;q++) sig[q]=0.0;
+            for(int k=1;k<=3;k++){
+                const double *Pik=stress+batchRank2ID(i,k)*N;
+                const double *Fjk=F+batchRank2ID(j,k)*N;
+                for(int q=0;q<N;q++) sig[q]+=Pik[q]*Fjk[q];
+            }
+            for(int q=0;q<N;q++) sig[q]/=J[q];
+        }
+    }
+
+    /**
+     * the push forward of dS/dE=lame*J^2*C^-1 x C^-1+(2G-lame*(J^2-1))*C^-1 odot C^-1 is taken in its closed form,
+     * F*C^-1*F^T=I, which avoids the 6-fold summation of conjPushForward:
+     *   A_ijkl=delta_ik*S_lj+lame*J^2*(FC^-1)_ij*(FC^-1)_kl+0.5*(2G-lame*(J^2-1))*(delta_ik*C^-1_jl+(FC^-1)_il*(FC^-1)_kj)
+     */
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            const double *Aij=FCinv+batchRank2ID(i,j)*N;
+            for(int k=1;k<=3;k++){
+                const double *Akj=FCinv+batchRank2ID(k,j)*N;
+                for(int l=1;l<=3;l++){
+                    const double *Akl=FCinv+batchRank2ID(k,l)*N;
+                    const double *Ail=FCinv+batchRank2ID(i,l)*N;
+                    const double *Slj=S+batchRank2ID(l,j)*N;
+                    const double *Cijl=Cinv+batchRank2ID(j,l)*N;
+                    double *jac=jacobian+batchRank4ID(i,j,k,l)*N;
+                    if(i==k){
+                        for(int q=0;q<N;q++){
+                            jac[q]=Slj[q]+lame*J[q]*J[q]*Aij[q]*Akl[q]
+                                  +0.5*(2.0*G-lame*(J[q]*J[q]-1.0))*(Cijl[q]+Ail[q]*Akj[q]);
+                        }
+                    }
+                    else{
+                        for(int q=0;q<N;q++){
+                            jac[q]=lame*J[q]*J[q]*Aij[q]*Akl[q]
+                                  +0.5*(2.0*G-lame*(J[q]*J[q]-1.0))*Ail[q]*Akj[q];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    double *hydro=output.ScalarMaterial("hydrostatic-stress");
+    for(int q=0;q<N;q++) hydro[q]=(stress[q]+stress[4*N+q]+stress[8*N+q])/3.0;
+    batchVonMises(N,stress,output.ScalarMaterial("vonMises-stress"));
+    batchVonMises(N,strain,output.ScalarMaterial("vonMises-strain"));
+
+    const vector<string> GradNames{"gradux","graduy","graduz"};
+    for(int i=1;i<=dim;i++){
+        double *gradu=output.VectorMaterial(GradNames[i-1]);
+        for(int k=1;k<=3;k++){
+            const double *du=input.GradU(i,k);
+            for(int q=0;q<N;q++) gradu[(k-1)*N+q]=du[q];
+        }
+    }
+}
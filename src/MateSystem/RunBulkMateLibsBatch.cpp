@@ -0,0 +1,58 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.20
+//+++ Purpose: call the materials with the batched (SoA) kernel
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "MateSystem/BulkMateSystem.h"
+
+bool BulkMateSystem::hasBatchMateLibs(const MateType &t_MateType){
+    switch (t_MateType)
+    {
+    case MateType::CONSTDIFFUSIONNMATE:
+    case MateType::DOUBLEWELLMATE:
+    case MateType::LINEARELASTICMATE:
+    case MateType::NEOHOOKEANMATE:
+    case MateType::SMALLSTRAINJ2PLASTICITYMATE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void BulkMateSystem::runBulkMateLibsBatch(const MateType &t_MateType,
+                                          const nlohmann::json &Params,
+                                          const BatchMaterialInput &Input,
+                                          BatchMaterialOutput &Output){
+    Output.reset(Input.m_QpointsNum);
+    switch (t_MateType)
+    {
+    case MateType::CONSTDIFFUSIONNMATE:
+        ConstDiffusionMaterial::computeBatchMaterialProperties(Params,Input,Output);
+        break;
+    case MateType::DOUBLEWELLMATE:
+        DoubleWellPotentialMaterial::computeBatchMaterialProperties(Params,Input,Output);
+        break;
+    case MateType::LINEARELASTICMATE:
+        LinearElasticMaterial::computeBatchMaterialProperties(Params,Input,Output);
+        break;
+    case MateType::NEOHOOKEANMATE:
+        NeoHookeanMaterial::computeBatchMaterialProperties(Params,Input,Output);
+        break;
+    case MateType::SMALLSTRAINJ2PLASTICITYMATE:
+        SmallStrainJ2PlasticityMaterial::computeBatchMaterialProperties(Params,Input,Output);
+        break;
+    default:
+        MessagePrinter::printErrorTxt("the material has no batched kernel, please use the per-qpoint runBulkMateLibs");
+        MessagePrinter::exitAsFem();
+        break;
+    }
+}
@@ -181,3 +181,148 @@ void SmallStrainJ2PlasticityMaterial::computeAdmissibleStressState(const nlohman
     mate.Rank2Material("strain")=total_strain;
     mate.Rank2Material("elastic-strain")=total_strain-mate.Rank2Material("plastic-strain");
 }
+//***********************************************************************************
+void SmallStrainJ2PlasticityMaterial::computeBatchMaterialProperties(const nlohmann::json &parameters,
+                                                                     const BatchMaterialInput &input,
+                                                                     BatchMaterialOutput &output){
+    const int N=input.m_QpointsNum;
+    const int dim=input.m_Dim;
+    if(dim<1||dim>3){
+        MessagePrinter::printErrorTxt("dim>3 is invalid for SmallStrainJ2PlasticityMaterial, please check your code");
+        MessagePrinter::exitAsFem();
+    }
+    double K,G;// for elastic constants
+    double H,YieldStress;// hardening moduli and yield stress
+
+    H=JsonUtils::getValue(parameters,"Hardening-modulus");
+    YieldStress=JsonUtils::getValue(parameters,"Yield-stress");
+    K=0.0;G=0.0;
+    if(JsonUtils::hasValue(parameters,"E")&&
+       JsonUtils::hasValue(parameters,"nu")){
+        const double E=JsonUtils::getValue(parameters,"E");
+        const double nu=JsonUtils::getValue(parameters,"nu");
+        K=E/(3.0*(1.0-2.0*nu));
+        G=0.5*E/(1.0+nu);
+    }
+    else if(JsonUtils::hasValue(parameters,"K")&&
+            JsonUtils::hasValue(parameters,"G")){
+        K=JsonUtils::getValue(parameters,"K");
+        G=JsonUtils::getValue(parameters,"G");
+    }
+    else if(JsonUtils::hasValue(parameters,"Lame")&&
+            JsonUtils::hasValue(parameters,"mu")){
+        G=JsonUtils::getValue(parameters,"mu");
+        K=JsonUtils::getValue(parameters,"Lame")+2.0*G/3.0;
+    }
+    else if(JsonUtils::hasValue(parameters,"Lame")&&
+            JsonUtils::hasValue(parameters,"G")){
+        G=JsonUtils::getValue(parameters,"G");
+        K=JsonUtils::getValue(parameters,"Lame")+2.0*G/3.0;
+    }
+    else{
+        MessagePrinter::printErrorTxt("Invalid parameters, for small strain J2 plasticity material, you should give either E,nu or K,G or Lame,G. Please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+
+    const double *PlasticStrainOld=input.Rank2MaterialOld("plastic-strain");
+    const double *EffPlasticStrainOld=input.ScalarMaterialOld("effective-plastic-strain");
+
+    // the scratch arrays: tr(eps), |Strial|, gamma, theta and theta_bar
+    m_BatchWork.resize(5*N);
+    double *TrStrain=m_BatchWork.data();
+    double *NormStrial=TrStrain+N;
+    double *Gamma=NormStrial+N;
+    double *Theta=Gamma+N;
+    double *ThetaBar=Theta+N;
+
+    double *strain=output.Rank2Material("strain");
+    double *Strial=output.Rank2Material("Strial");
+    double *stress=output.Rank2Material("stress");
+    double *PlasticStrain=output.Rank2Material("plastic-strain");
+    double *ElasticStrain=output.Rank2Material("elastic-strain");
+    double *EffPlasticStrain=output.ScalarMaterial("effective-plastic-strain");
+    double *jacobian=output.Rank4Material("jacobian");
+
+    for(int i=1;i<=dim;i++){
+        for(int j=1;j<=dim;j++){
+            const double *gij=input.GradU(i,j);
+            const double *gji=input.GradU(j,i);
+            double *eps=strain+batchRank2ID(i,j)*N;
+            for(int q=0;q<N;q++) eps[q]=0.5*(gij[q]+gji[q]);
+        }
+    }
+    for(int q=0;q<N;q++){
+        TrStrain[q]=strain[q]+strain[4*N+q]+strain[8*N+q];
+        NormStrial[q]=0.0;
+    }
+    // implementation for BOX 3.2(P124), Strial=2G*(dev(eps)-eps_p_old)
+    for(int c=0;c<9;c++){
+        const double delta=(c==0||c==4||c==8)?1.0:0.0;
+        for(int q=0;q<N;q++){
+            Strial[c*N+q]=2.0*G*(strain[c*N+q]-delta*TrStrain[q]/3.0-PlasticStrainOld[c*N+q]);
+            NormStrial[q]+=Strial[c*N+q]*Strial[c*N+q];
+        }
+    }
+    /**
+     * the elastic qpoints take gamma=0, theta=1 and theta_bar=0, then the elastoplastic update below reduces to
+     * the elastic one, so the same branch-free update is used for all the qpoints
+     */
+    double YieldF;
+    for(int q=0;q<N;q++){
+        NormStrial[q]=std::sqrt(NormStrial[q]);
+        YieldF=NormStrial[q]-sqrt(2.0/3.0)*(YieldStress+EffPlasticStrainOld[q]*H);
+        Gamma[q]=(YieldF>0.0)?YieldF/(2.0*G+2.0*H/3.0):0.0;
+        Theta[q]=(YieldF>0.0)?1.0-2.0*G*Gamma[q]/NormStrial[q]:1.0;
+        ThetaBar[q]=(YieldF>0.0)?1.0/(1.0+H/(3.0*G))-(1.0-Theta[q]):0.0;
+        // N=Strial/|Strial| is only used by the plastic qpoints
+        NormStrial[q]=(YieldF>0.0)?NormStrial[q]:1.0;
+        EffPlasticStrain[q]=EffPlasticStrainOld[q]+sqrt(2.0/3.0)*Gamma[q];
+    }
+    for(int c=0;c<9;c++){
+        const double delta=(c==0||c==4||c==8)?1.0:0.0;
+        for(int q=0;q<N;q++){
+            PlasticStrain[c*N+q]=PlasticStrainOld[c*N+q]+Strial[c*N+q]/NormStrial[q]*Gamma[q];
+            stress[c*N+q]=delta*TrStrain[q]*K+Strial[c*N+q]-Strial[c*N+q]/NormStrial[q]*2.0*G*Gamma[q];
+            ElasticStrain[c*N+q]=strain[c*N+q]-PlasticStrain[c*N+q];
+        }
+    }
+    // jacobian=K*IxI+2G*theta*(I4sym-IxI/3)-2G*theta_bar*NxN
+    for(int i=1;i<=3;i++){
+        for(int j=1;j<=3;j++){
+            const double *Sij=Strial+batchRank2ID(i,j)*N;
+            for(int k=1;k<=3;k++){
+                for(int l=1;l<=3;l++){
+                    const double *Skl=Strial+batchRank2ID(k,l)*N;
+                    const double IxI=(i==j)*(k==l);
+                    const double I4Sym=0.5*((i==k)*(j==l)+(i==l)*(j==k));
+                    double *jac=jacobian+batchRank4ID(i,j,k,l)*N;
+                    for(int q=0;q<N;q++){
+                        jac[q]=K*IxI+2.0*G*Theta[q]*(I4Sym-IxI/3.0)
+                              -2.0*G*ThetaBar[q]*Sij[q]*Skl[q]/(NormStrial[q]*NormStrial[q]);
+                    }
+                }
+            }
+        }
+    }
+
+    // for postprocess
+    batchVonMises(N,stress,output.ScalarMaterial("vonMises-stress"));
+    batchVonMises(N,strain,output.ScalarMaterial("vonMises-strain"));
+    // the plastic and the elastic ones use the full tensor, not the deviatoric part
+    double *vmPlasticStrain=output.ScalarMaterial("vonMises-plastic-strain");
+    double *vmElasticStrain=output.ScalarMaterial("vonMises-elastic-strain");
+    for(int q=0;q<N;q++){
+        vmPlasticStrain[q]=0.0;
+        vmElasticStrain[q]=0.0;
+    }
+    for(int c=0;c<9;c++){
+        for(int q=0;q<N;q++){
+            vmPlasticStrain[q]+=PlasticStrain[c*N+q]*PlasticStrain[c*N+q];
+            vmElasticStrain[q]+=ElasticStrain[c*N+q]*ElasticStrain[c*N+q];
+        }
+    }
+    for(int q=0;q<N;q++){
+        vmPlasticStrain[q]=sqrt(1.5*vmPlasticStrain[q]);
+        vmElasticStrain[q]=sqrt(1.5*vmElasticStrain[q]);
+    }
+}
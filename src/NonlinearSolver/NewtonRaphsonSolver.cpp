@@ -12,8 +12,12 @@
 //+++ Purpose: the newton-raphson solver from AsFem
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#include <cmath>
+#include <algorithm>
+
 #include "NonlinearSolver/NewtonRaphsonSolver.h"
 #include "TimeStepping/TimeSteppingTool.h"
+#include "Utils/Profiler.h"
 
 NewtonRaphsonSolver::NewtonRaphsonSolver() {
     m_MaxIterations=50;
@@ -25,6 +29,23 @@ NewtonRaphsonSolver::NewtonRaphsonSolver() {
     m_Rnorm0=1.0;
     m_dUnorm=1.0;
     m_dUnorm0=1.0;
+
+    m_JacobianLagIters=1;
+    m_LagJacobianAcrossSteps=false;
+    m_JacobianRefreshRatio=0.5;
+    m_HasJacobian=false;
+    m_RefreshJacobian=true;
+    m_JacobianAge=0;
+    m_JacobianBuilds=0;
+    m_RnormOld=1.0;
+
+    m_ForcingTermType=ForcingTermType::NONE;
+    m_Eta0=0.3;
+    m_EtaMin=1.0e-10;
+    m_EtaMax=0.9;
+    m_Eta=m_Eta0;
+    m_LinearRnorm=0.0;
+    m_KSPIterations=0;
 }
 
 bool NewtonRaphsonSolver::solve(FECell &t_FECell,
@@ -38,12 +59,19 @@ bool NewtonRaphsonSolver::solve(FECell &t_FECell,
                                 EquationSystem &t_EqSystem,
                                 LinearSolver &t_LinearSolver,
                                 FEControlInfo &t_FECtrlInfo) {
+    ProfilerScope NonlinearSolveScope("nonlinear-solve",true);
     char buff[68];
     m_Timer.startTimer();
     t_SolnSystem.m_Utemp.copyFrom(t_SolnSystem.m_Ucurrent);
     t_SolnSystem.m_Ucopy.copyFrom(t_SolnSystem.m_Ucurrent);
     m_IsConverged=false;
     m_Iterations=0;
+    m_JacobianBuilds=0;
+    m_KSPIterations=0;
+    m_Eta=m_Eta0;
+    t_LinearSolver.setComputeResidualNorm(m_ForcingTermType==ForcingTermType::EW1);
+    FECalcType calcType;
+    if (!m_LagJacobianAcrossSteps) m_HasJacobian=false;
     while (m_Iterations<m_MaxIterations && !m_IsConverged) {
         t_BCSystem.applyPresetBoundaryConditions(FECalcType::UPDATEU,
                                              t_FECtrlInfo.Dt+t_FECtrlInfo.T,
@@ -59,7 +87,16 @@ bool NewtonRaphsonSolver::solve(FECell &t_FECell,
 
         computeTimeDerivatives(t_FECtrlInfo,t_SolnSystem);// calculate V and A, based on Utemp
 
-        t_FESystem.formBulkFE(FECalcType::COMPUTERESIDUALANDJACOBIAN,
+        // for the modified newton method, the lagged K (and its factorization) is reused,
+        // only the residual is assembled in the in-between iterations
+        if (!m_HasJacobian||m_RefreshJacobian||m_JacobianAge>=m_JacobianLagIters) {
+            calcType=FECalcType::COMPUTERESIDUALANDJACOBIAN;
+        }
+        else {
+            calcType=FECalcType::COMPUTERESIDUAL;
+        }
+
+        t_FESystem.formBulkFE(calcType,
                               t_FECtrlInfo.Dt+t_FECtrlInfo.T,
                               t_FECtrlInfo.Dt,
                               t_FECtrlInfo.Ctan,
@@ -74,7 +111,7 @@ bool NewtonRaphsonSolver::solve(FECell &t_FECell,
 
         // t_BCSystem.setDirichletPenalty(t_FESystem.getMaxCoefOfKMatrix()*1.0e10);
         t_BCSystem.setDirichletPenalty(1.0e23);
-        t_BCSystem.applyBoundaryConditions(FECalcType::COMPUTERESIDUALANDJACOBIAN,
+        t_BCSystem.applyBoundaryConditions(calcType,
                                            t_FECtrlInfo.Dt+t_FECtrlInfo.T,
                                            t_FECtrlInfo.Ctan,
                                            t_FECell,
@@ -87,19 +124,54 @@ bool NewtonRaphsonSolver::solve(FECell &t_FECell,
                                            t_SolnSystem.m_V,
                                            t_EqSystem.m_AMATRIX,
                                            t_EqSystem.m_RHS);
-        t_EqSystem.m_AMATRIX*=-1.0;// in this NR iteration, the K=-dR/dU, which is different from the one in SNES solver !!!
+        if (calcType==FECalcType::COMPUTERESIDUALANDJACOBIAN) {
+            t_EqSystem.m_AMATRIX*=-1.0;// in this NR iteration, the K=-dR/dU, which is different from the one in SNES solver !!!
+            t_LinearSolver.setReusePreconditioner(false);
+            m_HasJacobian=true;
+            m_RefreshJacobian=false;
+            m_JacobianAge=0;
+            m_JacobianBuilds+=1;
+        }
+        else {
+            t_LinearSolver.setReusePreconditioner(true);
+        }
+        if (m_ForcingTermType!=ForcingTermType::NONE) {
+            m_Rnorm=t_EqSystem.m_RHS.getNorm();
+            computeForcingTerm();
+            t_LinearSolver.setRelativeTolerance(m_Eta);
+        }
         t_LinearSolver.solve(t_EqSystem.m_AMATRIX,t_EqSystem.m_RHS,t_SolnSystem.m_dU);
+        m_KSPIterations+=t_LinearSolver.getIterationNumber();
+        if (m_ForcingTermType==ForcingTermType::EW1) {
+            m_LinearRnorm=t_LinearSolver.getLinearResidualNorm();
+        }
         t_SolnSystem.m_Utemp+=t_SolnSystem.m_dU;
         m_Iterations+=1;
+        m_JacobianAge+=1;
         m_Rnorm=t_EqSystem.m_RHS.getNorm();
         m_dUnorm=t_SolnSystem.m_dU.getNorm();
         if (m_Iterations==1) {
             m_Rnorm0=m_Rnorm;
             m_dUnorm0=m_dUnorm;
         }
+        else if (m_Rnorm>m_JacobianRefreshRatio*m_RnormOld) {
+            // the contraction rate degrades, the lagged jacobian is too old
+            m_RefreshJacobian=true;
+        }
+        m_RnormOld=m_Rnorm;
         if (t_FECtrlInfo.IsDepDebug) {
-            snprintf(buff,68,"  AsFem solver: iters=%4d, |R|=%12.5e, |dU|=%12.5e",m_Iterations,m_Rnorm,m_dUnorm);
+            if (m_JacobianLagIters>1||m_LagJacobianAcrossSteps) {
+                snprintf(buff,68,"  AsFem solver: iters=%4d, |R|=%12.5e, |dU|=%12.5e%s",m_Iterations,m_Rnorm,m_dUnorm,
+                         calcType==FECalcType::COMPUTERESIDUALANDJACOBIAN?", K":"");
+            }
+            else {
+                snprintf(buff,68,"  AsFem solver: iters=%4d, |R|=%12.5e, |dU|=%12.5e",m_Iterations,m_Rnorm,m_dUnorm);
+            }
             MessagePrinter::printNormalTxt(buff);
+            if (m_ForcingTermType!=ForcingTermType::NONE) {
+                snprintf(buff,68,"                ksp iters=%6d, eta=%12.5e",t_LinearSolver.getIterationNumber(),m_Eta);
+                MessagePrinter::printNormalTxt(buff);
+            }
         }
         if (m_Rnorm<m_RAbsTol||m_Rnorm<m_RRelTol*m_Rnorm0) {
             m_IsConverged=true;
@@ -110,14 +182,50 @@ bool NewtonRaphsonSolver::solve(FECell &t_FECell,
         snprintf(buff,68,"  AsFem solver: iters=%4d, |R0|=%12.5e, |R|=%12.5e",m_Iterations,m_Rnorm0,m_Rnorm);
         MessagePrinter::printNormalTxt(buff);
     }
+    if (m_ForcingTermType!=ForcingTermType::NONE&&!t_FECtrlInfo.IsDepDebug) {
+        snprintf(buff,68,"  AsFem solver: ksp iters=%6d, last eta=%12.5e",m_KSPIterations,m_Eta);
+        MessagePrinter::printNormalTxt(buff);
+    }
+    if ((m_JacobianLagIters>1||m_LagJacobianAcrossSteps)&&!t_FECtrlInfo.IsDepDebug) {
+        snprintf(buff,68,"  AsFem solver: jacobian rebuilds=%4d",m_JacobianBuilds);
+        MessagePrinter::printNormalTxt(buff);
+    }
     if (m_IsConverged) {
         t_SolnSystem.m_Ucurrent.copyFrom(t_SolnSystem.m_Utemp);
     }
+    else {
+        m_HasJacobian=false;// always start the retry (with a smaller dt) from a fresh jacobian
+    }
     m_Timer.endTimer();
     m_Timer.printElapseTime("AsFem solver is done");
     return m_IsConverged;
 }
 
+void NewtonRaphsonSolver::computeForcingTerm() {
+    if (m_Iterations==0||m_RnormOld<=0.0) {
+        m_Eta=m_Eta0;
+        return;
+    }
+    const double EtaOld=m_Eta;
+    double alpha,gamma,EtaSafe;
+    if (m_ForcingTermType==ForcingTermType::EW1) {
+        // choice 1 of Eisenstat & Walker, SIAM J. Sci. Comput. 17 (1996) 16-32
+        alpha=0.5*(1.0+std::sqrt(5.0));
+        m_Eta=std::fabs(m_Rnorm-m_LinearRnorm)/m_RnormOld;
+        EtaSafe=std::pow(EtaOld,alpha);
+    }
+    else {
+        // choice 2 of Eisenstat & Walker
+        gamma=0.9;
+        alpha=2.0;
+        m_Eta=gamma*std::pow(m_Rnorm/m_RnormOld,alpha);
+        EtaSafe=gamma*std::pow(EtaOld,alpha);
+    }
+    // the safeguard avoids the too small forcing term caused by an occasional good iteration
+    if (EtaSafe>0.1) m_Eta=std::max(m_Eta,EtaSafe);
+    m_Eta=std::min(std::max(m_Eta,m_EtaMin),m_EtaMax);
+}
+
 void NewtonRaphsonSolver::printSolverInfo()const {
     MessagePrinter::printNormalTxt("Nonlinear (ASFEM) solver information summary:");
     char buff[70];
@@ -136,6 +244,20 @@ void NewtonRaphsonSolver::printSolverInfo()const {
     snprintf(buff,70,"  Relative |R| tolerance=%14.5e",m_RRelTol);
     str=buff;
     MessagePrinter::printNormalTxt(str);
+    if (m_JacobianLagIters>1||m_LagJacobianAcrossSteps) {
+        snprintf(buff,70,"  Jacobian lag=%3d, refresh ratio=%12.4e",m_JacobianLagIters,m_JacobianRefreshRatio);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+        str=m_LagJacobianAcrossSteps?"  Jacobian is reused across steps":"  Jacobian is rebuilt in every step";
+        MessagePrinter::printNormalTxt(str);
+    }
+    if (m_ForcingTermType!=ForcingTermType::NONE) {
+        str=m_ForcingTermType==ForcingTermType::EW1?"  Inexact newton with Eisenstat-Walker choice 1":"  Inexact newton with Eisenstat-Walker choice 2";
+        MessagePrinter::printNormalTxt(str);
+        snprintf(buff,70,"  eta0=%10.3e, eta-min=%10.3e, eta-max=%10.3e",m_Eta0,m_EtaMin,m_EtaMax);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+    }
     MessagePrinter::printStars();
 }
 
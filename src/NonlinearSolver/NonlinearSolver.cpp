@@ -27,6 +27,23 @@ void NonlinearSolver::init(LinearSolver &lsolver){
         NewtonRaphsonSolver::setMaxIterationNum(m_NlSolverBlock.m_MaxIters);
         NewtonRaphsonSolver::setRAbsTolerance(m_NlSolverBlock.m_AbsTolR);
         NewtonRaphsonSolver::setRRelTolerance(m_NlSolverBlock.m_RelTolR);
+        NewtonRaphsonSolver::setJacobianLagIterations(m_NlSolverBlock.m_JacobianLagIters);
+        NewtonRaphsonSolver::setLagJacobianAcrossSteps(m_NlSolverBlock.m_LagJacobianAcrossSteps);
+        NewtonRaphsonSolver::setJacobianRefreshRatio(m_NlSolverBlock.m_JacobianRefreshRatio);
+        NewtonRaphsonSolver::setForcingTerm(m_NlSolverBlock.m_ForcingTermType,
+                                            m_NlSolverBlock.m_Eta0,
+                                            m_NlSolverBlock.m_EtaMin,
+                                            m_NlSolverBlock.m_EtaMax);
+    }
+    else if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED) {
+        StaggeredSolver::setGroupNRParams(m_NlSolverBlock.m_MaxIters,
+                                          m_NlSolverBlock.m_AbsTolR,
+                                          m_NlSolverBlock.m_RelTolR);
+        StaggeredSolver::setStaggeredParams(m_NlSolverBlock.m_StaggeredMaxIters,
+                                            m_NlSolverBlock.m_StaggeredAbsTol,
+                                            m_NlSolverBlock.m_StaggeredRelTol);
+        StaggeredSolver::setFieldGroups(m_NlSolverBlock.m_StaggeredGroupDofNames,
+                                        m_NlSolverBlock.m_StaggeredGroupPCNames);
     }
     else {
         initSolver(lsolver);
@@ -37,6 +54,9 @@ int NonlinearSolver::getIterationNum()const {
     if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::ASFEMNR) {
         return NewtonRaphsonSolver::getNRIterationNum();
     }
+    else if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED) {
+        return StaggeredSolver::getStaggeredIterationNum();
+    }
     else {
         return SNESSolver::getIterationNum();
     }
@@ -67,6 +87,19 @@ bool NonlinearSolver::solve(FECell &t_FECell,
                                    t_LinearSolver,
                                    t_FECtrlInfo);
     }
+    else if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED) {
+        return StaggeredSolver::solve(t_FECell,
+                                      t_DofHandler,
+                                      t_FE,
+                                      t_ElmtSystem,
+                                      t_MateSystem,
+                                      t_FESystem,
+                                      t_BCSystem,
+                                      t_SolnSystem,
+                                      t_EqSystem,
+                                      t_LinearSolver,
+                                      t_FECtrlInfo);
+    }
     else {
         return SNESSolver::solve(t_FECell,
                           t_DofHandler,
@@ -87,13 +120,19 @@ void NonlinearSolver::printSolverInfo()const {
     if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::ASFEMNR) {
         NewtonRaphsonSolver::printSolverInfo();
     }
+    else if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED) {
+        StaggeredSolver::printSolverInfo();
+    }
     else {
         SNESSolver::printSolverInfo();
     }
 }
 
 void NonlinearSolver::releaseMemory() {
-    if (m_NlSolverBlock.m_NlSolverType!=NonlinearSolverType::ASFEMNR) {
+    if (m_NlSolverBlock.m_NlSolverType==NonlinearSolverType::STAGGERED) {
+        StaggeredSolver::releaseMemory();
+    }
+    else if (m_NlSolverBlock.m_NlSolverType!=NonlinearSolverType::ASFEMNR) {
         SNESSolver::releaseMemory();
     }
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include "NonlinearSolver/SNESSolver.h"
 #include "TimeStepping/TimeSteppingTool.h"
+#include "Utils/Profiler.h"
 
 //***************************************************************
 //*** here we define a monitor to print out the iteration info
@@ -152,6 +153,7 @@ bool SNESSolver::solve(FECell &t_FECell,
                        EquationSystem &t_EqSystem,
                        LinearSolver &t_LinearSolver,
                        FEControlInfo &t_FECtrlInfo){
+    ProfilerScope NonlinearSolveScope("nonlinear-solve",true);
 
     if (t_LinearSolver.getIterationNumber()){}
     m_Timer.startTimer();
@@ -0,0 +1,290 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.15
+//+++ Purpose: the staggered (alternate-minimization) solver, each
+//+++          field group is solved by its own newton-raphson
+//+++          iterations on the sub-matrix of the group's dofs
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "NonlinearSolver/StaggeredSolver.h"
+#include "TimeStepping/TimeSteppingTool.h"
+#include "Utils/Profiler.h"
+
+StaggeredSolver::StaggeredSolver() {
+    m_GroupMaxIters=25;
+    m_GroupRAbsTol=5.0e-7;
+    m_GroupRRelTol=1.0e-9;
+    m_MaxStaggeredIters=50;
+    m_dUAbsTol=1.0e-7;
+    m_dURelTol=1.0e-5;
+    m_StaggeredIters=0;
+    m_TotalGroupIters=0;
+    m_GroupDofNames.clear();
+    m_GroupPCNames.clear();
+    m_IsSetup=false;
+}
+
+void StaggeredSolver::setupFieldGroups(const DofHandler &t_DofHandler,EquationSystem &t_EqSystem,SolutionSystem &t_SolnSystem) {
+    const int MaxDofs=t_DofHandler.getMaxDofsPerNode();
+    const int GroupsNum=static_cast<int>(m_GroupDofNames.size());
+    vector<int> Dof2GroupID(MaxDofs,-1);
+    int dofid;
+    for (int g=0;g<GroupsNum;g++) {
+        for (const auto &name:m_GroupDofNames[g]) {
+            if (!t_DofHandler.isValidDofName(name)) {
+                MessagePrinter::printErrorTxt("dof name="+name+" in group-"+to_string(g+1)+
+                                              " of the staggered solver is invalid, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            dofid=t_DofHandler.getDofIDViaName(name);
+            if (Dof2GroupID[dofid-1]!=-1) {
+                MessagePrinter::printErrorTxt("dof name="+name+" is used by more than one group of the staggered solver, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            Dof2GroupID[dofid-1]=g;
+        }
+    }
+    for (int i=1;i<=MaxDofs;i++) {
+        if (Dof2GroupID[i-1]==-1) {
+            MessagePrinter::printErrorTxt("dof name="+t_DofHandler.getIthDofName(i)+" doesn\'t belong to any group of the staggered solver, please check your input file");
+            MessagePrinter::exitAsFem();
+        }
+    }
+
+    // the global dof id is (nodeid-1)*MaxDofsPerNode+dofid, so each local row is mapped to its group directly
+    PetscInt rstart,rend;
+    MatGetOwnershipRange(t_EqSystem.m_AMATRIX.getReference(),&rstart,&rend);
+    vector<vector<PetscInt>> GroupRows(GroupsNum);
+    for (PetscInt row=rstart;row<rend;row++) {
+        GroupRows[Dof2GroupID[row%MaxDofs]].push_back(row);
+    }
+
+    m_GroupIS.resize(GroupsNum);
+    m_GroupK.resize(GroupsNum);
+    m_GroupdU.resize(GroupsNum);
+    m_GroupKSP.resize(GroupsNum);
+    PC pc;
+    string prefix;
+    for (int g=0;g<GroupsNum;g++) {
+        ISCreateGeneral(PETSC_COMM_WORLD,static_cast<PetscInt>(GroupRows[g].size()),GroupRows[g].data(),PETSC_COPY_VALUES,&m_GroupIS[g]);
+        MatCreateSubMatrix(t_EqSystem.m_AMATRIX.getReference(),m_GroupIS[g],m_GroupIS[g],MAT_INITIAL_MATRIX,&m_GroupK[g]);
+        MatCreateVecs(m_GroupK[g],&m_GroupdU[g],NULL);
+
+        KSPCreate(PETSC_COMM_WORLD,&m_GroupKSP[g]);
+        prefix="staggered_"+to_string(g+1)+"_";
+        KSPSetOptionsPrefix(m_GroupKSP[g],prefix.c_str());
+        KSPSetType(m_GroupKSP[g],KSPGMRES);
+        KSPGetPC(m_GroupKSP[g],&pc);
+        PCSetType(pc,m_GroupPCNames[g].c_str());
+        if (m_GroupPCNames[g]=="lu") PCFactorSetZeroPivot(pc,1.0e-12);
+        KSPSetTolerances(m_GroupKSP[g],PETSC_CURRENT,1.0e-26,PETSC_CURRENT,10000);
+        KSPSetFromOptions(m_GroupKSP[g]);
+    }
+    VecDuplicate(t_SolnSystem.m_Ucurrent.getVectorRef(),&m_Upass);
+    m_IsSetup=true;
+}
+
+bool StaggeredSolver::solve(FECell &t_FECell,
+                            DofHandler &t_DofHandler,
+                            FE &t_FE,
+                            ElmtSystem &t_ElmtSystem,
+                            MateSystem &t_MateSystem,
+                            FESystem &t_FESystem,
+                            BCSystem &t_BCSystem,
+                            SolutionSystem &t_SolnSystem,
+                            EquationSystem &t_EqSystem,
+                            LinearSolver &t_LinearSolver,
+                            FEControlInfo &t_FECtrlInfo) {
+    ProfilerScope NonlinearSolveScope("nonlinear-solve",true);
+    if (t_LinearSolver.getIterationNumber()) {}
+    char buff[68];
+    m_Timer.startTimer();
+    if (!m_IsSetup) setupFieldGroups(t_DofHandler,t_EqSystem,t_SolnSystem);
+
+    t_SolnSystem.m_Utemp.copyFrom(t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_Ucopy.copyFrom(t_SolnSystem.m_Ucurrent);
+
+    const int GroupsNum=static_cast<int>(m_GroupIS.size());
+    int GroupIters;
+    PetscInt KSPIters;
+    PetscReal Rnorm,Rnorm0,dUnorm,dUnorm0;
+    bool IsGroupConverged,IsConverged;
+    Vec Rsub,dUsub;
+
+    IsConverged=false;
+    m_StaggeredIters=0;
+    m_TotalGroupIters=0;
+    dUnorm0=1.0;
+    Rnorm=0.0;
+    IsGroupConverged=false;
+    while (m_StaggeredIters<m_MaxStaggeredIters && !IsConverged) {
+        VecCopy(t_SolnSystem.m_Utemp.getVectorRef(),m_Upass);
+        for (int g=0;g<GroupsNum;g++) {
+            GroupIters=0;
+            IsGroupConverged=false;
+            Rnorm0=1.0;
+            while (GroupIters<=m_GroupMaxIters) {
+                t_BCSystem.applyPresetBoundaryConditions(FECalcType::UPDATEU,
+                                                         t_FECtrlInfo.Dt+t_FECtrlInfo.T,
+                                                         t_FECell,
+                                                         t_DofHandler,
+                                                         t_SolnSystem.m_Utemp,
+                                                         t_SolnSystem.m_Ucopy,
+                                                         t_SolnSystem.m_Uold,
+                                                         t_SolnSystem.m_Uolder,
+                                                         t_SolnSystem.m_V,
+                                                         t_EqSystem.m_AMATRIX,
+                                                         t_EqSystem.m_RHS);
+
+                computeTimeDerivatives(t_FECtrlInfo,t_SolnSystem);
+
+                t_FESystem.formBulkFE(FECalcType::COMPUTERESIDUALANDJACOBIAN,
+                                      t_FECtrlInfo.Dt+t_FECtrlInfo.T,
+                                      t_FECtrlInfo.Dt,
+                                      t_FECtrlInfo.Ctan,
+                                      t_FECell,
+                                      t_DofHandler,
+                                      t_FE,
+                                      t_ElmtSystem,
+                                      t_MateSystem,
+                                      t_SolnSystem,
+                                      t_EqSystem.m_AMATRIX,
+                                      t_EqSystem.m_RHS);
+
+                t_BCSystem.setDirichletPenalty(1.0e23);
+                t_BCSystem.applyBoundaryConditions(FECalcType::COMPUTERESIDUALANDJACOBIAN,
+                                                   t_FECtrlInfo.Dt+t_FECtrlInfo.T,
+                                                   t_FECtrlInfo.Ctan,
+                                                   t_FECell,
+                                                   t_DofHandler,
+                                                   t_FE,
+                                                   t_SolnSystem.m_Utemp,
+                                                   t_SolnSystem.m_Ucopy,
+                                                   t_SolnSystem.m_Uold,
+                                                   t_SolnSystem.m_Uolder,
+                                                   t_SolnSystem.m_V,
+                                                   t_EqSystem.m_AMATRIX,
+                                                   t_EqSystem.m_RHS);
+
+                // only the residual of current group is checked, the other groups are frozen
+                VecGetSubVector(t_EqSystem.m_RHS.getVectorRef(),m_GroupIS[g],&Rsub);
+                VecNorm(Rsub,NORM_2,&Rnorm);
+                if (GroupIters==0) Rnorm0=Rnorm;
+                if (Rnorm<m_GroupRAbsTol||(GroupIters>0&&Rnorm<m_GroupRRelTol*Rnorm0)) {
+                    VecRestoreSubVector(t_EqSystem.m_RHS.getVectorRef(),m_GroupIS[g],&Rsub);
+                    IsGroupConverged=true;
+                    break;
+                }
+                if (GroupIters==m_GroupMaxIters) {
+                    VecRestoreSubVector(t_EqSystem.m_RHS.getVectorRef(),m_GroupIS[g],&Rsub);
+                    break;
+                }
+
+                t_EqSystem.m_AMATRIX*=-1.0;// K=-dR/dU, the same as the one in asfem's NR solver
+                MatCreateSubMatrix(t_EqSystem.m_AMATRIX.getReference(),m_GroupIS[g],m_GroupIS[g],MAT_REUSE_MATRIX,&m_GroupK[g]);
+                KSPSetOperators(m_GroupKSP[g],m_GroupK[g],m_GroupK[g]);
+                KSPSolve(m_GroupKSP[g],Rsub,m_GroupdU[g]);
+                KSPGetIterationNumber(m_GroupKSP[g],&KSPIters);
+                VecRestoreSubVector(t_EqSystem.m_RHS.getVectorRef(),m_GroupIS[g],&Rsub);
+
+                // scatter the group increment back to the full dU
+                t_SolnSystem.m_dU.setToZero();
+                VecGetSubVector(t_SolnSystem.m_dU.getVectorRef(),m_GroupIS[g],&dUsub);
+                VecCopy(m_GroupdU[g],dUsub);
+                VecRestoreSubVector(t_SolnSystem.m_dU.getVectorRef(),m_GroupIS[g],&dUsub);
+                t_SolnSystem.m_Utemp+=t_SolnSystem.m_dU;
+
+                GroupIters+=1;
+                m_TotalGroupIters+=1;
+                if (t_FECtrlInfo.IsDepDebug) {
+                    snprintf(buff,68,"    group-%2d: iters=%3d, |R|=%12.5e, ksp iters=%5d",g+1,GroupIters,Rnorm,static_cast<int>(KSPIters));
+                    MessagePrinter::printNormalTxt(buff);
+                }
+            }// end-of-group-newton-iteration
+            if (!IsGroupConverged) {
+                snprintf(buff,68,"  Staggered solver: group-%2d failed, |R|=%12.5e",g+1,Rnorm);
+                MessagePrinter::printWarningTxt(buff);
+                break;
+            }
+        }// end-of-group-loop
+        m_StaggeredIters+=1;
+        if (!IsGroupConverged) break;
+
+        // check the field increment of current pass
+        VecAYPX(m_Upass,-1.0,t_SolnSystem.m_Utemp.getVectorRef());// Upass=Utemp-Upass
+        VecNorm(m_Upass,NORM_2,&dUnorm);
+        if (m_StaggeredIters==1) dUnorm0=dUnorm;
+        if (t_FECtrlInfo.IsDepDebug) {
+            snprintf(buff,68,"  Staggered solver: iters=%4d, |dU|=%12.5e",m_StaggeredIters,dUnorm);
+            MessagePrinter::printNormalTxt(buff);
+        }
+        if (dUnorm<m_dUAbsTol||(m_StaggeredIters>1&&dUnorm<m_dURelTol*dUnorm0)) {
+            IsConverged=true;
+        }
+    }// end-of-staggered-iteration
+
+    if (!t_FECtrlInfo.IsDepDebug) {
+        snprintf(buff,68,"  Staggered solver: iters=%4d, group iters=%5d",m_StaggeredIters,m_TotalGroupIters);
+        MessagePrinter::printNormalTxt(buff);
+    }
+    if (IsConverged) {
+        t_SolnSystem.m_Ucurrent.copyFrom(t_SolnSystem.m_Utemp);
+    }
+    m_Timer.endTimer();
+    m_Timer.printElapseTime("Staggered solver is done");
+    return IsConverged;
+}
+
+void StaggeredSolver::printSolverInfo()const {
+    MessagePrinter::printNormalTxt("Nonlinear (staggered) solver information summary:");
+    char buff[70];
+    string str;
+    str="  Solver type= staggered newton-raphson";
+    MessagePrinter::printNormalTxt(str);
+    snprintf(buff,70,"  Max staggered iterations=%3d, max group iterations=%3d",m_MaxStaggeredIters,m_GroupMaxIters);
+    str=buff;
+    MessagePrinter::printNormalTxt(str);
+    snprintf(buff,70,"  Absolute |dU| tolerance=%14.5e",m_dUAbsTol);
+    str=buff;
+    MessagePrinter::printNormalTxt(str);
+    snprintf(buff,70,"  Relative |dU| tolerance=%14.5e",m_dURelTol);
+    str=buff;
+    MessagePrinter::printNormalTxt(str);
+    snprintf(buff,70,"  Absolute |R| tolerance=%14.5e",m_GroupRAbsTol);
+    str=buff;
+    MessagePrinter::printNormalTxt(str);
+    snprintf(buff,70,"  Relative |R| tolerance=%14.5e",m_GroupRRelTol);
+    str=buff;
+    MessagePrinter::printNormalTxt(str);
+    for (int g=0;g<static_cast<int>(m_GroupDofNames.size());g++) {
+        str="  group-"+to_string(g+1)+": dofs=";
+        for (const auto &name:m_GroupDofNames[g]) str+=name+" ";
+        str+=", pc="+m_GroupPCNames[g];
+        MessagePrinter::printNormalTxt(str);
+    }
+    MessagePrinter::printStars();
+}
+
+void StaggeredSolver::releaseMemory() {
+    if (!m_IsSetup) return;
+    for (int g=0;g<static_cast<int>(m_GroupIS.size());g++) {
+        KSPDestroy(&m_GroupKSP[g]);
+        MatDestroy(&m_GroupK[g]);
+        VecDestroy(&m_GroupdU[g]);
+        ISDestroy(&m_GroupIS[g]);
+    }
+    VecDestroy(&m_Upass);
+    m_GroupIS.clear();
+    m_GroupK.clear();
+    m_GroupdU.clear();
+    m_GroupKSP.clear();
+    m_IsSetup=false;
+}
@@ -0,0 +1,96 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.24
+//+++ Purpose: the bounded task queue served by a background
+//+++          output thread
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "OutputSystem/AsyncOutputQueue.h"
+
+AsyncOutputQueue::AsyncOutputQueue(){
+    m_MaxDepth=2;
+    m_IsRunning=false;
+    m_IsBusy=false;
+    m_StopRequested=false;
+    m_ErrorMsg.clear();
+}
+AsyncOutputQueue::~AsyncOutputQueue(){
+    stop();
+}
+//************************************************
+void AsyncOutputQueue::start(const int &maxdepth){
+    if(m_IsRunning) return;
+    m_MaxDepth=maxdepth<1?1:maxdepth;
+    m_StopRequested=false;
+    m_IsBusy=false;
+    m_Thread=std::thread(&AsyncOutputQueue::run,this);
+    m_IsRunning=true;
+}
+//************************************************
+void AsyncOutputQueue::push(std::function<string()> task){
+    if(!m_IsRunning){
+        // no output thread, run it in place
+        string msg=task();
+        if(!msg.empty()&&m_ErrorMsg.empty()) m_ErrorMsg=msg;
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    // back pressure: the solver waits here if the writer falls too far behind
+    m_SpaceCond.wait(lock,[this]{return static_cast<int>(m_Tasks.size())<m_MaxDepth;});
+    m_Tasks.push_back(std::move(task));
+    lock.unlock();
+    m_TaskCond.notify_one();
+}
+//************************************************
+void AsyncOutputQueue::flush(){
+    if(!m_IsRunning) return;
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_SpaceCond.wait(lock,[this]{return m_Tasks.empty()&&!m_IsBusy;});
+}
+//************************************************
+void AsyncOutputQueue::stop(){
+    if(!m_IsRunning) return;
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_StopRequested=true;
+    }
+    m_TaskCond.notify_one();
+    m_Thread.join();
+    m_IsRunning=false;
+}
+//************************************************
+string AsyncOutputQueue::getErrorMessage(){
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_ErrorMsg;
+}
+//************************************************
+void AsyncOutputQueue::run(){
+    std::function<string()> task;
+    string msg;
+    while(true){
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_TaskCond.wait(lock,[this]{return m_StopRequested||!m_Tasks.empty();});
+            if(m_Tasks.empty()&&m_StopRequested) break;
+            task=std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+            m_IsBusy=true;
+        }
+        msg=task();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(!msg.empty()&&m_ErrorMsg.empty()) m_ErrorMsg=msg;
+            m_IsBusy=false;
+        }
+        m_SpaceCond.notify_all();
+    }
+}
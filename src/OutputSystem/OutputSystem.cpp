@@ -22,6 +22,8 @@ OutputSystem::OutputSystem(){
     m_pvdfile_name.clear();
     m_fileformat=ResultFileFormat::VTU;
     m_intervals=1;
+    m_async=false;
+    m_queuedepth=2;
 }
 
 void OutputSystem::printInfo()const{
@@ -36,5 +38,8 @@ void OutputSystem::printInfo()const{
         MessagePrinter::printNormalTxt("  output file format = csv");
     }
     MessagePrinter::printNormalTxt("  output interval = "+to_string(m_intervals));
+    if(m_async){
+        MessagePrinter::printNormalTxt("  asynchronous output = true, queue depth = "+to_string(m_queuedepth));
+    }
     MessagePrinter::printStars();
 }
@@ -13,12 +13,14 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "OutputSystem/OutputSystem.h"
+#include "Utils/Profiler.h"
 
 void OutputSystem::saveResults2File(const int &t_step,
                                     const FECell &t_fecell,
                                     const DofHandler &t_dofHandler,
                                     SolutionSystem &t_solution,
                                     ProjectionSystem &t_projection){
+    ProfilerScope OutputScope("output",true);
     if(t_step<0){
         // negative for static result output
         m_outputfile_name=m_inputfile_name.substr(0,m_inputfile_name.size()-5);// remove '.json'
@@ -33,21 +35,60 @@ void OutputSystem::saveResults2File(const int &t_step,
     }
     
     if(m_fileformat==ResultFileFormat::VTU){
-        VTUWriter::saveResults(m_outputfile_name,t_fecell,t_dofHandler,t_solution,t_projection);
+        if(m_async){
+            // only the snapshot is taken here, the formatting and writing is done by the output thread
+            auto snapshot=std::make_shared<VTUSnapshot>();
+            VTUWriter::takeSnapshot(m_outputfile_name,t_fecell,t_dofHandler,t_solution,t_projection,*snapshot);
+            runOutputTask([snapshot](){return VTUWriter::writeSnapshot(*snapshot);});
+        }
+        else{
+            VTUWriter::saveResults(m_outputfile_name,t_fecell,t_dofHandler,t_solution,t_projection);
+        }
+    }
+}
+//***********************************************
+//*** for output tasks
+//***********************************************
+void OutputSystem::runOutputTask(std::function<string()> task){
+    MPI_Comm_rank(PETSC_COMM_WORLD, &m_rank);
+    if(m_rank!=0) return;
+    if(m_async){
+        checkOutputError();
+        if(!m_outputqueue.isRunning()) m_outputqueue.start(m_queuedepth);
+        m_outputqueue.push(std::move(task));
+    }
+    else{
+        string errmsg=task();
+        if(!errmsg.empty()){
+            MessagePrinter::printErrorTxt(errmsg);
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
+void OutputSystem::checkOutputError(){
+    string errmsg=m_outputqueue.getErrorMessage();
+    if(!errmsg.empty()){
+        MessagePrinter::printErrorTxt(errmsg);
+        MessagePrinter::exitAsFem();
     }
 }
+void OutputSystem::flush(){
+    MPI_Comm_rank(PETSC_COMM_WORLD, &m_rank);
+    if(m_rank!=0) return;
+    m_outputqueue.stop();
+    checkOutputError();
+}
 //***********************************************
 //*** for pvd file
 //***********************************************
 void OutputSystem::savePVDHead(){
-    MPI_Comm_rank(PETSC_COMM_WORLD, &m_rank);
-    if(m_rank == 0){
-        m_pvdfile_name=m_inputfile_name.substr(0,m_inputfile_name.size()-5)+".pvd";// remove ".json" extension name
+    m_pvdfile_name=m_inputfile_name.substr(0,m_inputfile_name.size()-5)+".pvd";// remove ".json" extension name
+    const string pvdfile=m_pvdfile_name;
+    runOutputTask([pvdfile](){
         std::ofstream out;
-        out.open(m_pvdfile_name,std::ios::out);
+        out.open(pvdfile,std::ios::out);
         if (!out.is_open()){
-            MessagePrinter::printErrorTxt("can\'t create a new pvd file(="+m_pvdfile_name+")!, please make sure you have the write permission");
-            MessagePrinter::exitAsFem();
+            return "can\'t create a new pvd file(="+pvdfile+")!, please make sure you have the write permission";
         }
         out<<"<?xml version=\"1.0\"?>\n";
         out<<"<VTKFile type=\"Collection\" version=\"0.1\"\n"
@@ -55,29 +96,31 @@ void OutputSystem::savePVDHead(){
              "         compressor=\"vtkZLibDataCompressor\">\n";
         out<<"<Collection>"<<endl;
         out.close();
-    }
+        return string();
+    });
 }
 void OutputSystem::savePVDEnd(){
-    MPI_Comm_rank(PETSC_COMM_WORLD, &m_rank);
-    if(m_rank==0){
+    const string pvdfile=m_pvdfile_name;
+    runOutputTask([pvdfile](){
         std::ofstream out;
-        out.open(m_pvdfile_name,std::ios::app|std::ios::out);
+        out.open(pvdfile,std::ios::app|std::ios::out);
         if (!out.is_open()){
-            MessagePrinter::printErrorTxt("can\'t open pvd file(="+m_pvdfile_name+")!, please make sure you have the write permission");
-            MessagePrinter::exitAsFem();
+            return "can\'t open pvd file(="+pvdfile+")!, please make sure you have the write permission";
         }
         out<<"</Collection>\n";
         out<<"</VTKFile>\n";
         out.close();
-    }
+        return string();
+    });
 }
 void OutputSystem::savePVDResults(const double &current_time){
-    MPI_Comm_rank(PETSC_COMM_WORLD, &m_rank);
-    if(m_rank==0){
+    const string pvdfile=m_pvdfile_name;
+    const string outputfile=m_outputfile_name;
+    runOutputTask([pvdfile,outputfile,current_time](){
         std::ifstream in;
         string line;
         vector<string> lines;
-        in.open(m_pvdfile_name,std::ios::in);
+        in.open(pvdfile,std::ios::in);
         while(!in.eof()){
             getline(in,line);
             lines.push_back(line);
@@ -91,22 +134,22 @@ void OutputSystem::savePVDResults(const double &current_time){
 
         std::ofstream out;
         char val[20];
-        out.open(m_pvdfile_name,std::ios::out);
+        out.open(pvdfile,std::ios::out);
         if (!out.is_open()){
-            MessagePrinter::printErrorTxt("can\'t open pvd file(="+m_pvdfile_name+")! please make sure you have the write permission");
-            MessagePrinter::exitAsFem();
+            return "can\'t open pvd file(="+pvdfile+")! please make sure you have the write permission";
         }
         for(const auto &line:lines){
             out<<line<<endl;
         }
 
-        sprintf(val,"%14.6e",current_time);
+        snprintf(val,20,"%14.6e",current_time);
 
         out<<"<DataSet timestep=\""<<string(val)<<"\" "
            <<"group=\"\" part=\"0\" "
-           <<"file=\""<<m_outputfile_name<<"\"/>"<<endl;
+           <<"file=\""<<outputfile<<"\"/>"<<endl;
         out<<"</Collection>\n";
         out<<"</VTKFile>\n";
         out.close();
-    }
+        return string();
+    });
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 //+++ Purpose: Defines the abstract class for result output
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#include <sstream>
+
 #include "OutputSystem/VTUWriter.h"
 
 void VTUWriter::saveResults(const string &t_filename,
@@ -19,10 +21,25 @@ void VTUWriter::saveResults(const string &t_filename,
                             const DofHandler &t_dofHandler,
                             SolutionSystem &t_solution,
                             ProjectionSystem &t_projection){
+    VTUSnapshot snapshot;
+    takeSnapshot(t_filename,t_fecell,t_dofHandler,t_solution,t_projection,snapshot);
+    if(m_rank==0){
+        string errmsg=writeSnapshot(snapshot);
+        if(!errmsg.empty()){
+            MessagePrinter::printErrorTxt(errmsg);
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
+//*************************************************
+void VTUWriter::takeSnapshot(const string &t_filename,
+                             const FECell &t_fecell,
+                             const DofHandler &t_dofHandler,
+                             SolutionSystem &t_solution,
+                             ProjectionSystem &t_projection,
+                             VTUSnapshot &t_snapshot){
     MPI_Comm_rank(PETSC_COMM_WORLD,&m_rank);
 
-    if(t_dofHandler.getActiveDofs()){}
-
     t_solution.m_Ucurrent.makeGhostCopy();
 
     for (auto &it:t_projection.getProjectionDataRef().m_ScalarProjMateVecList) it.makeGhostCopy();
@@ -31,213 +48,245 @@ void VTUWriter::saveResults(const string &t_filename,
     for (auto &it:t_projection.getProjectionDataRef().m_Rank4ProjMateVecList) it.makeGhostCopy();
 
     if(m_rank==0){
-        std::ofstream out;
-        out.open(t_filename,std::ios::out);
-        if(!out.is_open()){
-            MessagePrinter::printErrorTxt("can\'t create/open "+t_filename+", please make sure you have the write permission");
-            MessagePrinter::exitAsFem();
-        }
-
-        int i,j,k,iInd,e;
-        if(i||j||k||iInd||e){}
-
-        out << "<?xml version=\"1.0\"?>\n";
-        out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\">\n";
-        out << "<UnstructuredGrid>\n";
-        out << "<Piece NumberOfPoints=\"" << t_fecell.getFECellNodesNum() << "\" NumberOfCells=\"" << t_fecell.getFECellBulkElmtsNum() << "\">\n";
-        out << "<Points>\n";
-        out << "<DataArray type=\"Float64\" Name=\"nodes\"  NumberOfComponents=\"3\"  format=\"ascii\">\n";
-
-        //*****************************
-        // print out node coordinates
-        out <<std::scientific << std::setprecision(6);
-        for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-            out << t_fecell.getFECellIthNodeJthCoord(i, 1) << " ";
-            out << t_fecell.getFECellIthNodeJthCoord(i, 2) << " ";
-            out << t_fecell.getFECellIthNodeJthCoord(i, 3) << "\n";
-        }
-        out << "</DataArray>\n";
-        out << "</Points>\n";
-
-        //***************************************
-        //*** For cell information
-        //***************************************
-        out << "<Cells>\n";
-        out << "<DataArray type=\"Int32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\">\n";
-        for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
-            for (j = 1; j <= t_fecell.getFECellIthBulkElmtNodesNum(e); j++){
-                out << t_fecell.getFECellIthBulkElmtJthNodeID(e,j) - 1 << " ";
-            }
-            out << "\n";
-        }
-        out << "</DataArray>\n";
+        int i,j,k,e;
+        const int nNodes=t_fecell.getFECellNodesNum();
+        const int nDofs=t_dofHandler.getMaxDofsPerNode();
 
         //***************************************
-        //*** For offset
+        //*** the mesh doesn't change between the
+        //*** steps, so it is formatted only once
         //***************************************
-        out << "<DataArray type=\"Int32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\">\n";
-        int offset = 0;
-        for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
-            offset += t_fecell.getFECellIthBulkElmtNodesNum(e);
-            out << offset << "\n";
-        }
-        out << "</DataArray>\n";
+        if(!m_GeometryTxt){
+            std::ostringstream out;
+            out << "<?xml version=\"1.0\"?>\n";
+            out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\">\n";
+            out << "<UnstructuredGrid>\n";
+            out << "<Piece NumberOfPoints=\"" << nNodes << "\" NumberOfCells=\"" << t_fecell.getFECellBulkElmtsNum() << "\">\n";
+            out << "<Points>\n";
+            out << "<DataArray type=\"Float64\" Name=\"nodes\"  NumberOfComponents=\"3\"  format=\"ascii\">\n";
 
-        //***************************************
-        //*** For connectivity
-        //***************************************
-        out << "<DataArray type=\"Int32\" Name=\"types\"  NumberOfComponents=\"1\"  format=\"ascii\">\n";
-        for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
-            out << t_fecell.getFECellIthBulkElmtVTKCellType(e) << "\n";
-        }
-        out << "</DataArray>\n";
-        out << "</Cells>\n";
-
-
-        //***************************************
-        //*** For solutions
-        //***************************************
-        string dofname;
-        double value;
-        string ScalarName,VectorName,Rank2Name,Rank4Name,TensorName;
-
-        ScalarName="<PointData Scalar=\"";
-        for (j = 1;j<=t_dofHandler.getMaxDofsPerNode();j++){
-            ScalarName+=t_dofHandler.getIthDofName(j)+" ";
-        }
-        for(j=1;j<=t_projection.getScalarMaterialNum();j++){
-            ScalarName+=t_projection.getIthScalarMateName(j)+" ";
-        }
-        ScalarName+="\" ";
+            //*****************************
+            // print out node coordinates
+            out <<std::scientific << std::setprecision(6);
+            for (i = 1; i <= nNodes; i++){
+                out << t_fecell.getFECellIthNodeJthCoord(i, 1) << " ";
+                out << t_fecell.getFECellIthNodeJthCoord(i, 2) << " ";
+                out << t_fecell.getFECellIthNodeJthCoord(i, 3) << "\n";
+            }
+            out << "</DataArray>\n";
+            out << "</Points>\n";
 
-        VectorName.clear();
-        if(t_projection.getVectorMaterialNum()){
-            VectorName="Vector=\"";
-            for(j=1;j<=t_projection.getVectorMaterialNum();j++){
-                VectorName+=t_projection.getIthVectorMateName(j)+" ";
+            //***************************************
+            //*** For cell information
+            //***************************************
+            out << "<Cells>\n";
+            out << "<DataArray type=\"Int32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\">\n";
+            for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
+                for (j = 1; j <= t_fecell.getFECellIthBulkElmtNodesNum(e); j++){
+                    out << t_fecell.getFECellIthBulkElmtJthNodeID(e,j) - 1 << " ";
+                }
+                out << "\n";
             }
-            VectorName+="\" ";
-        }
+            out << "</DataArray>\n";
 
-        TensorName.clear();
-        if(t_projection.getRank2MaterialNum()||t_projection.getRank4MaterialNum()){
-            TensorName="Tensor=\"";
-            for(j=1;j<=t_projection.getRank2MaterialNum();j++){
-                TensorName+=t_projection.getIthRank2MateName(j)+" ";
+            //***************************************
+            //*** For offset
+            //***************************************
+            out << "<DataArray type=\"Int32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\">\n";
+            int offset = 0;
+            for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
+                offset += t_fecell.getFECellIthBulkElmtNodesNum(e);
+                out << offset << "\n";
             }
-            for(j=1;j<=t_projection.getRank4MaterialNum();j++){
-                TensorName+=t_projection.getIthRank4MateName(j)+" ";
+            out << "</DataArray>\n";
+
+            //***************************************
+            //*** For connectivity
+            //***************************************
+            out << "<DataArray type=\"Int32\" Name=\"types\"  NumberOfComponents=\"1\"  format=\"ascii\">\n";
+            for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
+                out << t_fecell.getFECellIthBulkElmtVTKCellType(e) << "\n";
             }
-            TensorName+="\" ";
-        }
+            out << "</DataArray>\n";
+            out << "</Cells>\n";
 
-        out << ScalarName<< VectorName<< TensorName<<">\n";
+            //***************************************
+            //*** the original ids of the reordered
+            //*** mesh, for the comparison with the
+            //*** input mesh
+            //***************************************
+            if(t_fecell.isMeshReordered()){
+                out << "<CellData Scalars=\"original-elmtid\">\n";
+                out << "<DataArray type=\"Int32\" Name=\"original-elmtid\" NumberOfComponents=\"1\" format=\"ascii\">\n";
+                for (e = 1; e <= t_fecell.getFECellBulkElmtsNum(); e++){
+                    out << t_fecell.getFECellIthBulkElmtOrigID(e) << "\n";
+                }
+                out << "</DataArray>\n";
+                out << "</CellData>\n";
 
-        //**************************************
-        //*** for solution output
-        //**************************************
-        for (j = 1;j<=t_dofHandler.getMaxDofsPerNode();j++){
-            dofname =t_dofHandler.getIthDofName(j);
-            out<<"<DataArray type=\"Float64\" Name=\"" << dofname << "\"  NumberOfComponents=\"1\" format=\"ascii\">\n";
-            out<<std::scientific<<std::setprecision(6);
-            for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-                iInd = t_dofHandler.getIthNodeJthDofID(i,j);
-                value=t_solution.m_Ucurrent.getIthValueFromGhost(iInd);
-                out << value << "\n";
+                std::ostringstream idout;
+                idout << "<DataArray type=\"Int32\" Name=\"original-nodeid\" NumberOfComponents=\"1\" format=\"ascii\">\n";
+                for (i = 1; i <= nNodes; i++){
+                    idout << t_fecell.getFECellIthNodeOrigID(i) << "\n";
+                }
+                idout << "</DataArray>\n\n";
+                m_NodeOrigIDTxt=std::make_shared<const string>(idout.str());
             }
-            out << "</DataArray>\n\n";
+            m_GeometryTxt=std::make_shared<const string>(out.str());
         }
 
-        int nproj;
-        //**************************************
-        //*** for projected scalar output
-        //**************************************
-        nproj=t_projection.getScalarMaterialNum();
-        for (j = 1;j<=nproj;j++){
-            dofname = t_projection.getIthScalarMateName(j);
-            out<<"<DataArray type=\"Float64\" Name=\"" << dofname << "\"  NumberOfComponents=\"1\" format=\"ascii\">\n";
-            out<<std::scientific<<std::setprecision(6);
-            for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-                iInd = (i-1)*(1+1)+2;
-                value=t_projection.getProjectionDataRef().m_ScalarProjMateVecList[j-1].getIthValueFromGhost(iInd);
-                out << value << "\n";
+        t_snapshot.m_FileName=t_filename;
+        t_snapshot.m_GeometryTxt=m_GeometryTxt;
+        t_snapshot.m_NodeOrigIDTxt=m_NodeOrigIDTxt;
+        t_snapshot.m_NodesNum=nNodes;
+
+        //***************************************
+        //*** For solutions
+        //***************************************
+        t_snapshot.m_DofNames.resize(nDofs);
+        for (j = 1;j<=nDofs;j++) t_snapshot.m_DofNames[j-1]=t_dofHandler.getIthDofName(j);
+        t_snapshot.m_U.resize(static_cast<size_t>(nNodes)*nDofs);
+        for (i = 1; i <= nNodes; i++){
+            for (j = 1;j<=nDofs;j++){
+                t_snapshot.m_U[(i-1)*nDofs+j-1]=t_solution.m_Ucurrent.getIthValueFromGhost(t_dofHandler.getIthNodeJthDofID(i,j));
             }
-            out << "</DataArray>\n\n";
         }
 
         //**************************************
-        //*** for projected vector output
+        //*** for projected quantities, each
+        //*** node stores [weight, values...]
         //**************************************
-        nproj=t_projection.getVectorMaterialNum();
-        for (j = 1;j<=nproj;j++){
-            dofname = t_projection.getIthVectorMateName(j);
-            out<<"<DataArray type=\"Float64\" Name=\"" << dofname << "\"  NumberOfComponents=\"3\" format=\"ascii\">\n";
-            out<<std::scientific<<std::setprecision(6);
-            for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-                for(k=1;k<=3;k++){
-                    iInd = (i-1)*(1+3)+k+1;
-                    value=t_projection.getProjectionDataRef().m_VectorProjMateVecList[j-1].getIthValueFromGhost(iInd);
-                    out << value << " ";
+        auto copyProjection=[&](const vector<Vector> &projvec,const int &ncomps,vector<vector<double>> &vals){
+            vals.resize(projvec.size());
+            for(size_t m=0;m<projvec.size();m++){
+                vals[m].resize(static_cast<size_t>(nNodes)*ncomps);
+                for (i = 1; i <= nNodes; i++){
+                    for(k=1;k<=ncomps;k++){
+                        vals[m][(i-1)*ncomps+k-1]=projvec[m].getIthValueFromGhost((i-1)*(1+ncomps)+k+1);
+                    }
                 }
-                out <<"\n";
             }
-            out << "</DataArray>\n\n";
+        };
+        t_snapshot.m_ScalarNames.resize(t_projection.getScalarMaterialNum());
+        for(j=1;j<=t_projection.getScalarMaterialNum();j++) t_snapshot.m_ScalarNames[j-1]=t_projection.getIthScalarMateName(j);
+        t_snapshot.m_VectorNames.resize(t_projection.getVectorMaterialNum());
+        for(j=1;j<=t_projection.getVectorMaterialNum();j++) t_snapshot.m_VectorNames[j-1]=t_projection.getIthVectorMateName(j);
+        t_snapshot.m_Rank2Names.resize(t_projection.getRank2MaterialNum());
+        for(j=1;j<=t_projection.getRank2MaterialNum();j++) t_snapshot.m_Rank2Names[j-1]=t_projection.getIthRank2MateName(j);
+        t_snapshot.m_Rank4Names.resize(t_projection.getRank4MaterialNum());
+        for(j=1;j<=t_projection.getRank4MaterialNum();j++) t_snapshot.m_Rank4Names[j-1]=t_projection.getIthRank4MateName(j);
+
+        copyProjection(t_projection.getProjectionDataRef().m_ScalarProjMateVecList,1,t_snapshot.m_ScalarVals);
+        copyProjection(t_projection.getProjectionDataRef().m_VectorProjMateVecList,3,t_snapshot.m_VectorVals);
+        copyProjection(t_projection.getProjectionDataRef().m_Rank2ProjMateVecList,9,t_snapshot.m_Rank2Vals);
+        copyProjection(t_projection.getProjectionDataRef().m_Rank4ProjMateVecList,36,t_snapshot.m_Rank4Vals);
+    }// end-of-master-rank-process
+
+    t_solution.m_Ucurrent.destroyGhostCopy();
+    for (auto &it:t_projection.getProjectionDataRef().m_ScalarProjMateVecList) it.destroyGhostCopy();
+    for (auto &it:t_projection.getProjectionDataRef().m_VectorProjMateVecList) it.destroyGhostCopy();
+    for (auto &it:t_projection.getProjectionDataRef().m_Rank2ProjMateVecList) it.destroyGhostCopy();
+    for (auto &it:t_projection.getProjectionDataRef().m_Rank4ProjMateVecList) it.destroyGhostCopy();
+
+}
+//*************************************************
+string VTUWriter::writeSnapshot(const VTUSnapshot &t_snapshot){
+    std::ofstream out;
+    out.open(t_snapshot.m_FileName,std::ios::out);
+    if(!out.is_open()){
+        return "can\'t create/open "+t_snapshot.m_FileName+", please make sure you have the write permission";
+    }
+
+    const int nNodes=t_snapshot.m_NodesNum;
+    const int nDofs=static_cast<int>(t_snapshot.m_DofNames.size());
+    int i,j,k;
+
+    if(t_snapshot.m_GeometryTxt) out << *t_snapshot.m_GeometryTxt;
+
+    //***************************************
+    //*** For solutions
+    //***************************************
+    string ScalarName,VectorName,TensorName;
+
+    ScalarName="<PointData Scalar=\"";
+    for (const auto &name:t_snapshot.m_DofNames) ScalarName+=name+" ";
+    for (const auto &name:t_snapshot.m_ScalarNames) ScalarName+=name+" ";
+    ScalarName+="\" ";
+
+    VectorName.clear();
+    if(t_snapshot.m_VectorNames.size()){
+        VectorName="Vector=\"";
+        for (const auto &name:t_snapshot.m_VectorNames) VectorName+=name+" ";
+        VectorName+="\" ";
+    }
+
+    TensorName.clear();
+    if(t_snapshot.m_Rank2Names.size()||t_snapshot.m_Rank4Names.size()){
+        TensorName="Tensor=\"";
+        for (const auto &name:t_snapshot.m_Rank2Names) TensorName+=name+" ";
+        for (const auto &name:t_snapshot.m_Rank4Names) TensorName+=name+" ";
+        TensorName+="\" ";
+    }
+
+    out << ScalarName<< VectorName<< TensorName<<">\n";
+
+    //**************************************
+    //*** for solution output
+    //**************************************
+    for (j = 1;j<=nDofs;j++){
+        out<<"<DataArray type=\"Float64\" Name=\"" << t_snapshot.m_DofNames[j-1] << "\"  NumberOfComponents=\"1\" format=\"ascii\">\n";
+        out<<std::scientific<<std::setprecision(6);
+        for (i = 1; i <= nNodes; i++){
+            out << t_snapshot.m_U[(i-1)*nDofs+j-1] << "\n";
         }
+        out << "</DataArray>\n\n";
+    }
 
-        //**************************************
-        //*** for projected rank-2 output
-        //**************************************
-        nproj=t_projection.getRank2MaterialNum();
-        for (j = 1;j<=nproj;j++){
-            dofname = t_projection.getIthRank2MateName(j);
-            out<<"<DataArray type=\"Float64\" Name=\"" << dofname << "\"  NumberOfComponents=\"9\" format=\"ascii\">\n";
-            out<<std::scientific<<std::setprecision(6);
-            for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-                for(k=1;k<=9;k++){
-                    iInd = (i-1)*(1+9)+k+1;
-                    value=t_projection.getProjectionDataRef().m_Rank2ProjMateVecList[j-1].getIthValueFromGhost(iInd);
-                    out << value << " ";
-                }
-                out <<"\n";
-            }
-            out << "</DataArray>\n\n";
+    //**************************************
+    //*** for projected scalar output
+    //**************************************
+    for (j = 1;j<=static_cast<int>(t_snapshot.m_ScalarNames.size());j++){
+        out<<"<DataArray type=\"Float64\" Name=\"" << t_snapshot.m_ScalarNames[j-1] << "\"  NumberOfComponents=\"1\" format=\"ascii\">\n";
+        out<<std::scientific<<std::setprecision(6);
+        for (i = 1; i <= nNodes; i++){
+            out << t_snapshot.m_ScalarVals[j-1][i-1] << "\n";
         }
+        out << "</DataArray>\n\n";
+    }
 
-        //**************************************
-        //*** for projected rank-4 output
-        //**************************************
-        nproj=t_projection.getRank4MaterialNum();
-        for (j = 1;j<=nproj;j++){
-            dofname = t_projection.getIthRank4MateName(j);
-            out<<"<DataArray type=\"Float64\" Name=\"" << dofname << "\"  NumberOfComponents=\"36\" format=\"ascii\">\n";
+    //**************************************
+    //*** for projected vector/rank-2/rank-4
+    //*** output
+    //**************************************
+    auto writeComponents=[&](const vector<string> &names,const vector<vector<double>> &vals,const int &ncomps){
+        for (size_t m=0;m<names.size();m++){
+            out<<"<DataArray type=\"Float64\" Name=\"" << names[m] << "\"  NumberOfComponents=\""<<ncomps<<"\" format=\"ascii\">\n";
             out<<std::scientific<<std::setprecision(6);
-            for (i = 1; i <= t_fecell.getFECellNodesNum(); i++){
-                for(k=1;k<=36;k++){
-                    iInd = (i-1)*(1+36)+k+1;
-                    value=t_projection.getProjectionDataRef().m_Rank4ProjMateVecList[j-1].getIthValueFromGhost(iInd);
-                    out << value << " ";
+            for (i = 1; i <= nNodes; i++){
+                for(k=1;k<=ncomps;k++){
+                    out << vals[m][(i-1)*ncomps+k-1] << " ";
                 }
                 out <<"\n";
             }
             out << "</DataArray>\n\n";
         }
+    };
+    writeComponents(t_snapshot.m_VectorNames,t_snapshot.m_VectorVals,3);
+    writeComponents(t_snapshot.m_Rank2Names,t_snapshot.m_Rank2Vals,9);
+    writeComponents(t_snapshot.m_Rank4Names,t_snapshot.m_Rank4Vals,36);
+    if(t_snapshot.m_NodeOrigIDTxt) out << *t_snapshot.m_NodeOrigIDTxt;
 
-        //***************************************
-        //*** End of output
-        //***************************************
-        out << "</PointData>\n";
-        out << "</Piece>\n";
-        out << "</UnstructuredGrid>\n";
-        out << "</VTKFile>" << endl;
-
-        out.close();
-
-    }// end-of-master-rank-process
-
-    t_solution.m_Ucurrent.destroyGhostCopy();
-    for (auto &it:t_projection.getProjectionDataRef().m_ScalarProjMateVecList) it.destroyGhostCopy();
-    for (auto &it:t_projection.getProjectionDataRef().m_VectorProjMateVecList) it.destroyGhostCopy();
-    for (auto &it:t_projection.getProjectionDataRef().m_Rank2ProjMateVecList) it.destroyGhostCopy();
-    for (auto &it:t_projection.getProjectionDataRef().m_Rank4ProjMateVecList) it.destroyGhostCopy();
+    //***************************************
+    //*** End of output
+    //***************************************
+    out << "</PointData>\n";
+    out << "</Piece>\n";
+    out << "</UnstructuredGrid>\n";
+    out << "</VTKFile>" << endl;
 
-}
\ No newline at end of file
+    out.close();
+    if(out.fail()){
+        return "failed to write "+t_snapshot.m_FileName+", please check your disk space";
+    }
+    return "";
+}
@@ -13,6 +13,7 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "Postprocess/Postprocessor.h"
+#include "Utils/Profiler.h"
 
 void Postprocessor::executePostprocess(const FECell &t_fecell,
                                        const DofHandler &t_dofhandler,
@@ -20,71 +21,119 @@ void Postprocessor::executePostprocess(const FECell &t_fecell,
                                        MateSystem &t_matesystem,
                                        ProjectionSystem &t_projsystem,
                                        SolutionSystem &t_solution){
-    if(t_fecell.getFECellElmtsNum()||
-       t_dofhandler.getActiveDofs()||
-       t_fe.getMaxDim()||
-       t_matesystem.m_MaterialContainer.getRank2MaterialsNum()||
-       t_projsystem.getNodesNum()||
-       t_solution.getDofsNum()){}
-    // if(t_mesh.getBulkMeshBulkElmtOrder()||t_fe.getMaxDim()||t_matesystem.m_materialcontainer.getRank2MaterialsNum()){}
-    
-    // t_projsystem.makeGhostCopyOfProjectionData();// always make ghost copy here, not in each individual rank !!!
-    
-    // int dofid;
-    // PostprocessorType pps_type;
-    // for(int i=1;i<=getPPSBlocksNum();i++){
-    //     dofid=getIthPPSBlock(i).m_dofid;
-    //     pps_type=getIthPPSBlock(i).m_pps_type;
-    //     switch (pps_type)
-    //     {
-    //     case PostprocessorType::NULLPPS:
-    //         break;
-    //     case PostprocessorType::NODALVALUE:
-    //     case PostprocessorType::NODALSCALARMATERIALVALUE:
-    //     case PostprocessorType::NODALVECTORMATERIALVALUE:
-    //     case PostprocessorType::NODALRANK2MATERIALVALUE:
-    //     case PostprocessorType::NODALRANK4MATERIALVALUE:
-    //     {
-    //         m_pps_values[i-1]=executeNodalPostprocess(pps_type,dofid,getIthPPSBlock(i).m_parameters,t_dofhandler,t_solution,t_projsystem);
-    //         break;
-    //     }
-    //     case PostprocessorType::AREA:
-    //     case PostprocessorType::SIDEAVERAGEVALUE:
-    //     case PostprocessorType::SIDEAVERAGESCALARMATERIALVALUE:
-    //     case PostprocessorType::SIDEAVERAGEVECTORMATERIALVALUE:
-    //     case PostprocessorType::SIDEAVERAGERANK2MATERIALVALUE:
-    //     case PostprocessorType::SIDEAVERAGERANK4MATERIALVALUE:
-    //     case PostprocessorType::SIDEINTEGRATEVALUE:
-    //     case PostprocessorType::SIDEINTEGRATESCALARMATERIALVALUE:
-    //     case PostprocessorType::SIDEINTEGRATEVECTORMATERIALVALUE:
-    //     case PostprocessorType::SIDEINTEGRATERANK2MATERIALVALUE:
-    //     case PostprocessorType::SIDEINTEGRATERANK4MATERIALVALUE:
-    //     case PostprocessorType::USER1SIDEINTEGRALPPS:
-    //     {
-    //         m_pps_values[i-1]=executeSideIntegralPostprocess(pps_type,dofid,getIthPPSBlock(i).m_sidenamelist,getIthPPSBlock(i).m_parameters,t_mesh,t_dofhandler,t_fe,t_solution,t_projsystem);
-    //         break;
-    //     }
-    //     case PostprocessorType::VOLUME:
-    //     case PostprocessorType::VOLUMEAVERAGEVALUE:
-    //     case PostprocessorType::VOLUMEAVERAGESCALARMATERIALVALUE:
-    //     case PostprocessorType::VOLUMEAVERAGEVECTORMATERIALVALUE:
-    //     case PostprocessorType::VOLUMEAVERAGERANK2MATERIALVALUE:
-    //     case PostprocessorType::VOLUMEAVERAGERANK4MATERIALVALUE:
-    //     case PostprocessorType::VOLUMEINTEGRATEVALUE:
-    //     case PostprocessorType::VOLUMEINTEGRATESCALARMATERIALVALUE:
-    //     case PostprocessorType::VOLUMEINTEGRATEVECTORMATERIALVALUE:
-    //     case PostprocessorType::VOLUMEINTEGRATERANK2MATERIALVALUE:
-    //     case PostprocessorType::VOLUMEINTEGRATERANK4MATERIALVALUE:
-    //     case PostprocessorType::USER1VOLUMEINTEGRALPPS:
-    //     {
-    //         m_pps_values[i-1]=executeVolumeIntegralPostprocess(pps_type,dofid,getIthPPSBlock(i).m_domainnamelist,getIthPPSBlock(i).m_parameters,t_mesh,t_dofhandler,t_fe,t_solution,t_projsystem);
-    //         break;
-    //     }
-    //     default:
-    //         MessagePrinter::printErrorTxt("Unsupported postprocessor type in executePostprocess, please check either your code or your input file");
-    //         MessagePrinter::exitAsFem();
-    //         break;
-    //     }
-    // }
-    // t_projsystem.destroyGhostCopyOfProjectionData();
-}
\ No newline at end of file
+    ProfilerScope PostprocessScope("postprocess",true);
+    if(t_matesystem.m_MaterialContainer.getRank2MaterialsNum()){}
+
+    // the nodal and point value pps are resolved to their owner ranks only once
+    if(!m_probe.isSetup()) setupPointProbes(t_fecell,t_dofhandler,t_fe,t_solution,t_projsystem);
+
+    //*************************************************************
+    //*** the probed pps are gathered at once, the integral ones
+    //*** are grouped by their side/domain name, so each side/domain
+    //*** is only visited once no matter how many pps are defined on it
+    //*************************************************************
+    map<string,vector<int>> Side2BlockIDs,Domain2BlockIDs;
+    vector<bool> IsIntegral(m_pps_blocksnum,false),IsAverage(m_pps_blocksnum,false);
+    bool NeedsProjection=false;
+    PostprocessorType pps_type;
+    for(int i=1;i<=getPPSBlocksNum();i++){
+        pps_type=m_pps_blocklist[i-1].m_pps_type;
+        switch (pps_type)
+        {
+        case PostprocessorType::NULLPPS:
+            break;
+        case PostprocessorType::NODALVALUE:
+        case PostprocessorType::NODALSCALARMATERIALVALUE:
+        case PostprocessorType::NODALVECTORMATERIALVALUE:
+        case PostprocessorType::NODALRANK2MATERIALVALUE:
+        case PostprocessorType::NODALRANK4MATERIALVALUE:
+        case PostprocessorType::POINTVALUE:
+        {
+            if(m_pps_isprobed[i-1]) break;
+            // the nodal material pps read the projected data from its ghost copy
+            if(pps_type!=PostprocessorType::NODALVALUE) t_projsystem.makeGhostCopyOfProjectionData();
+            m_pps_values[i-1]=executeNodalPostprocess(pps_type,m_pps_blocklist[i-1].m_dofid,m_pps_blocklist[i-1].m_parameters,t_dofhandler,t_solution,t_projsystem);
+            if(pps_type!=PostprocessorType::NODALVALUE) t_projsystem.destroyGhostCopyOfProjectionData();
+            break;
+        }
+        case PostprocessorType::SIDEAVERAGEVALUE:
+        case PostprocessorType::SIDEAVERAGESCALARMATERIALVALUE:
+        case PostprocessorType::SIDEAVERAGEVECTORMATERIALVALUE:
+        case PostprocessorType::SIDEAVERAGERANK2MATERIALVALUE:
+        case PostprocessorType::SIDEAVERAGERANK4MATERIALVALUE:
+            IsAverage[i-1]=true;
+            [[fallthrough]];
+        case PostprocessorType::AREA:
+        case PostprocessorType::SIDEINTEGRATEVALUE:
+        case PostprocessorType::SIDEINTEGRATESCALARMATERIALVALUE:
+        case PostprocessorType::SIDEINTEGRATEVECTORMATERIALVALUE:
+        case PostprocessorType::SIDEINTEGRATERANK2MATERIALVALUE:
+        case PostprocessorType::SIDEINTEGRATERANK4MATERIALVALUE:
+        case PostprocessorType::USER1SIDEINTEGRALPPS:
+        {
+            IsIntegral[i-1]=true;
+            if(pps_type!=PostprocessorType::AREA&&
+               pps_type!=PostprocessorType::SIDEAVERAGEVALUE&&
+               pps_type!=PostprocessorType::SIDEINTEGRATEVALUE) NeedsProjection=true;
+            for(const auto &name:m_pps_blocklist[i-1].m_sidenamelist) Side2BlockIDs[name].push_back(i);
+            break;
+        }
+        case PostprocessorType::VOLUMEAVERAGEVALUE:
+        case PostprocessorType::VOLUMEAVERAGESCALARMATERIALVALUE:
+        case PostprocessorType::VOLUMEAVERAGEVECTORMATERIALVALUE:
+        case PostprocessorType::VOLUMEAVERAGERANK2MATERIALVALUE:
+        case PostprocessorType::VOLUMEAVERAGERANK4MATERIALVALUE:
+            IsAverage[i-1]=true;
+            [[fallthrough]];
+        case PostprocessorType::VOLUME:
+        case PostprocessorType::VOLUMEINTEGRATEVALUE:
+        case PostprocessorType::VOLUMEINTEGRATESCALARMATERIALVALUE:
+        case PostprocessorType::VOLUMEINTEGRATEVECTORMATERIALVALUE:
+        case PostprocessorType::VOLUMEINTEGRATERANK2MATERIALVALUE:
+        case PostprocessorType::VOLUMEINTEGRATERANK4MATERIALVALUE:
+        case PostprocessorType::USER1VOLUMEINTEGRALPPS:
+        {
+            IsIntegral[i-1]=true;
+            if(pps_type!=PostprocessorType::VOLUME&&
+               pps_type!=PostprocessorType::VOLUMEAVERAGEVALUE&&
+               pps_type!=PostprocessorType::VOLUMEINTEGRATEVALUE) NeedsProjection=true;
+            for(const auto &name:m_pps_blocklist[i-1].m_domainnamelist) Domain2BlockIDs[name].push_back(i);
+            break;
+        }
+        default:
+            MessagePrinter::printErrorTxt("Unsupported postprocessor type in executePostprocess, please check either your code or your input file");
+            MessagePrinter::exitAsFem();
+            break;
+        }
+    }
+    if(m_probe.getProbeTermsNum()) m_probe.gatherProbeValues(t_solution,t_projsystem,m_pps_values);
+
+    if(Side2BlockIDs.empty()&&Domain2BlockIDs.empty()) return;
+
+    // all the integral pps share one ghost copy of the solution (and projection data) per output step
+    t_solution.m_Ucurrent.makeGhostCopy();
+    if(NeedsProjection) t_projsystem.makeGhostCopyOfProjectionData();
+
+    m_pps_localsums.assign(2*m_pps_blocksnum,0.0);
+    for(const auto &it:Side2BlockIDs){
+        accumulateSideIntegralPostprocess(it.first,it.second,t_fecell,t_dofhandler,t_fe,t_solution,t_projsystem);
+    }
+    for(const auto &it:Domain2BlockIDs){
+        accumulateVolumeIntegralPostprocess(it.first,it.second,t_fecell,t_dofhandler,t_fe,t_solution,t_projsystem);
+    }
+
+    t_solution.m_Ucurrent.destroyGhostCopy();
+    if(NeedsProjection) t_projsystem.destroyGhostCopyOfProjectionData();
+
+    // the (integral,measure) pairs of all the pps blocks are collected by one reduction
+    m_pps_globalsums.assign(2*m_pps_blocksnum,0.0);
+    MPI_Allreduce(m_pps_localsums.data(),m_pps_globalsums.data(),2*m_pps_blocksnum,MPI_DOUBLE,MPI_SUM,PETSC_COMM_WORLD);
+
+    for(int i=1;i<=getPPSBlocksNum();i++){
+        if(!IsIntegral[i-1]) continue;
+        m_pps_values[i-1]=m_pps_globalsums[2*(i-1)];
+        if(IsAverage[i-1]&&m_pps_globalsums[2*(i-1)+1]>0.0){
+            m_pps_values[i-1]/=m_pps_globalsums[2*(i-1)+1];
+        }
+    }
+}
@@ -0,0 +1,247 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.10
+//+++ Purpose: the probe service for nodal and point value monitors,
+//+++          each probe is resolved to its owner rank once, and
+//+++          all the probe values are gathered by one MPI_Gatherv
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Postprocess/PointProbe.h"
+
+PointProbe::PointProbe(){
+    m_IsSetup=false;
+}
+
+void PointProbe::addEntryProbe(const int &slot,const ProbeSource &source,const int &sourceid,const int &index){
+    ProbeTerm term;
+    term.Slot=slot;
+    term.Source=source;
+    term.SourceID=sourceid;
+    term.Index=index;
+    term.Weight=1.0;
+    m_Terms.push_back(term);
+    m_IsSetup=false;
+}
+
+bool PointProbe::addPointProbe(const int &slot,const Vector3d &point,const int &dofid,
+                               const FECell &t_fecell,const DofHandler &t_dofhandler,FE &t_fe){
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    vector<int> indices;
+    vector<double> weights;
+    double xi[3];
+    for(const auto &cell:t_fecell.getLocalBulkFECellVecRef()){
+        if(!locatePointInCell(cell,point,t_fe.m_BulkShp,xi)) continue;
+        t_fe.m_BulkShp.calc(xi[0],xi[1],xi[2],cell.ElmtNodeCoords0,false);
+        for(int i=1;i<=cell.NodesNumPerElmt;i++){
+            indices.push_back(t_dofhandler.getIthNodeJthDofID(cell.ElmtConn[i-1],dofid));
+            weights.push_back(t_fe.m_BulkShp.shape_value(i));
+        }
+        break;
+    }
+
+    // the point may be found on several ranks (shared faces), the lowest rank is taken as the host
+    int myrank=indices.size()?rank:size;
+    int hostrank;
+    MPI_Allreduce(&myrank,&hostrank,1,MPI_INT,MPI_MIN,PETSC_COMM_WORLD);
+    if(hostrank==size) return false;
+
+    int n=static_cast<int>(indices.size());
+    MPI_Bcast(&n,1,MPI_INT,hostrank,PETSC_COMM_WORLD);
+    indices.resize(n);weights.resize(n);
+    MPI_Bcast(indices.data(),n,MPI_INT,hostrank,PETSC_COMM_WORLD);
+    MPI_Bcast(weights.data(),n,MPI_DOUBLE,hostrank,PETSC_COMM_WORLD);
+
+    ProbeTerm term;
+    term.Slot=slot;
+    term.Source=ProbeSource::SOLUTION;
+    term.SourceID=0;
+    for(int i=0;i<n;i++){
+        term.Index=indices[i];
+        term.Weight=weights[i];
+        m_Terms.push_back(term);
+    }
+    m_IsSetup=false;
+    return true;
+}
+
+void PointProbe::setup(SolutionSystem &t_soln,ProjectionSystem &t_projsystem){
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    PetscInt iStart,iEnd;
+    ProbeTerm localterm;
+    m_LocalTerms.clear();
+    for(const auto &term:m_Terms){
+        VecGetOwnershipRange(getSourceVector(term.Source,term.SourceID,t_soln,t_projsystem).getVectorRef(),&iStart,&iEnd);
+        if(term.Index-1>=iStart&&term.Index-1<iEnd){
+            localterm=term;
+            localterm.Index=term.Index-1-static_cast<int>(iStart);
+            m_LocalTerms.push_back(localterm);
+        }
+    }
+    int nLocal=static_cast<int>(m_LocalTerms.size());
+    m_LocalValues.assign(nLocal,0.0);
+
+    vector<int> localslots(nLocal);
+    for(int i=0;i<nLocal;i++) localslots[i]=m_LocalTerms[i].Slot;
+
+    m_RecvCounts.assign(rank==0?size:0,0);
+    m_Displs.assign(rank==0?size:0,0);
+    MPI_Gather(&nLocal,1,MPI_INT,m_RecvCounts.data(),1,MPI_INT,0,PETSC_COMM_WORLD);
+    int nTotal=0;
+    if(rank==0){
+        for(int cpuid=0;cpuid<size;cpuid++){
+            m_Displs[cpuid]=nTotal;
+            nTotal+=m_RecvCounts[cpuid];
+        }
+    }
+    m_GatheredSlots.assign(nTotal,0);
+    m_GatheredValues.assign(nTotal,0.0);
+    MPI_Gatherv(localslots.data(),nLocal,MPI_INT,
+                m_GatheredSlots.data(),m_RecvCounts.data(),m_Displs.data(),MPI_INT,0,PETSC_COMM_WORLD);
+    m_IsSetup=true;
+}
+
+void PointProbe::gatherProbeValues(SolutionSystem &t_soln,ProjectionSystem &t_projsystem,vector<double> &values){
+    if(!m_IsSetup) setup(t_soln,t_projsystem);
+
+    const PetscScalar *array;
+    for(int i=0;i<static_cast<int>(m_LocalTerms.size());i++){
+        Vec &vec=getSourceVector(m_LocalTerms[i].Source,m_LocalTerms[i].SourceID,t_soln,t_projsystem).getVectorRef();
+        VecGetArrayRead(vec,&array);
+        m_LocalValues[i]=m_LocalTerms[i].Weight*array[m_LocalTerms[i].Index];
+        VecRestoreArrayRead(vec,&array);
+    }
+
+    MPI_Gatherv(m_LocalValues.data(),static_cast<int>(m_LocalValues.size()),MPI_DOUBLE,
+                m_GatheredValues.data(),m_RecvCounts.data(),m_Displs.data(),MPI_DOUBLE,0,PETSC_COMM_WORLD);
+
+    // only the master rank has the gathered values
+    for(const auto &slot:m_GatheredSlots) values[slot]=0.0;
+    for(int i=0;i<static_cast<int>(m_GatheredSlots.size());i++){
+        values[m_GatheredSlots[i]]+=m_GatheredValues[i];
+    }
+}
+
+Vector& PointProbe::getSourceVector(const ProbeSource &source,const int &sourceid,
+                                    SolutionSystem &t_soln,ProjectionSystem &t_projsystem){
+    switch (source)
+    {
+    case ProbeSource::SCALARMATE:
+        return t_projsystem.getProjectionDataRef().m_ScalarProjMateVecList[sourceid];
+    case ProbeSource::VECTORMATE:
+        return t_projsystem.getProjectionDataRef().m_VectorProjMateVecList[sourceid];
+    case ProbeSource::RANK2MATE:
+        return t_projsystem.getProjectionDataRef().m_Rank2ProjMateVecList[sourceid];
+    default:
+        break;
+    }
+    return t_soln.m_Ucurrent;
+}
+
+bool PointProbe::locatePointInCell(const SingleMeshCell &cell,const Vector3d &point,ShapeFun &t_shp,double (&xi)[3]){
+    const int dim=cell.Dim;
+    const int nNodes=cell.NodesNumPerElmt;
+    const double tol=1.0e-6;
+
+    // quick rejection via the bounding box of the cell
+    double xmin,xmax,pad;
+    for(int j=1;j<=dim;j++){
+        xmin=cell.ElmtNodeCoords0(1,j);xmax=xmin;
+        for(int i=2;i<=nNodes;i++){
+            xmin=std::min(xmin,cell.ElmtNodeCoords0(i,j));
+            xmax=std::max(xmax,cell.ElmtNodeCoords0(i,j));
+        }
+        pad=tol*std::max(1.0,xmax-xmin);
+        if(point(j)<xmin-pad||point(j)>xmax+pad) return false;
+    }
+
+    const bool IsSimplex=cell.CellMeshType==MeshType::TRI3||cell.CellMeshType==MeshType::TRI6||
+                         cell.CellMeshType==MeshType::TET4||cell.CellMeshType==MeshType::TET10;
+    for(int k=0;k<3;k++) xi[k]=(IsSimplex&&k<dim)?1.0/(dim+1):0.0;
+
+    // newton iteration for x(xi)=point
+    double r[3],jac[3][3],dxi[3],det,dxinorm;
+    for(int iter=0;iter<25;iter++){
+        t_shp.calc(xi[0],xi[1],xi[2],cell.ElmtNodeCoords0,false);
+        for(int j=0;j<dim;j++){
+            r[j]=point(j+1);
+            for(int k=0;k<dim;k++) jac[j][k]=0.0;
+        }
+        for(int i=1;i<=nNodes;i++){
+            for(int j=0;j<dim;j++){
+                r[j]-=t_shp.shape_value(i)*cell.ElmtNodeCoords0(i,j+1);
+                for(int k=0;k<dim;k++) jac[j][k]+=cell.ElmtNodeCoords0(i,j+1)*t_shp.shape_grad(i)(k+1);
+            }
+        }
+        if(dim==1){
+            det=jac[0][0];
+            if(std::abs(det)<1.0e-16) return false;
+            dxi[0]=r[0]/det;
+        }
+        else if(dim==2){
+            det=jac[0][0]*jac[1][1]-jac[0][1]*jac[1][0];
+            if(std::abs(det)<1.0e-16) return false;
+            dxi[0]=( jac[1][1]*r[0]-jac[0][1]*r[1])/det;
+            dxi[1]=(-jac[1][0]*r[0]+jac[0][0]*r[1])/det;
+        }
+        else{
+            det=jac[0][0]*(jac[1][1]*jac[2][2]-jac[1][2]*jac[2][1])
+               -jac[0][1]*(jac[1][0]*jac[2][2]-jac[1][2]*jac[2][0])
+               +jac[0][2]*(jac[1][0]*jac[2][1]-jac[1][1]*jac[2][0]);
+            if(std::abs(det)<1.0e-16) return false;
+            dxi[0]=( (jac[1][1]*jac[2][2]-jac[1][2]*jac[2][1])*r[0]
+                    -(jac[0][1]*jac[2][2]-jac[0][2]*jac[2][1])*r[1]
+                    +(jac[0][1]*jac[1][2]-jac[0][2]*jac[1][1])*r[2])/det;
+            dxi[1]=(-(jac[1][0]*jac[2][2]-jac[1][2]*jac[2][0])*r[0]
+                    +(jac[0][0]*jac[2][2]-jac[0][2]*jac[2][0])*r[1]
+                    -(jac[0][0]*jac[1][2]-jac[0][2]*jac[1][0])*r[2])/det;
+            dxi[2]=( (jac[1][0]*jac[2][1]-jac[1][1]*jac[2][0])*r[0]
+                    -(jac[0][0]*jac[2][1]-jac[0][1]*jac[2][0])*r[1]
+                    +(jac[0][0]*jac[1][1]-jac[0][1]*jac[1][0])*r[2])/det;
+        }
+        dxinorm=0.0;
+        for(int k=0;k<dim;k++){
+            xi[k]+=dxi[k];
+            dxinorm+=dxi[k]*dxi[k];
+        }
+        if(dxinorm<1.0e-24) break;
+    }
+
+    // check whether the local coordinates are inside the reference element
+    if(IsSimplex){
+        double sum=0.0;
+        for(int k=0;k<dim;k++){
+            if(xi[k]<-tol) return false;
+            sum+=xi[k];
+        }
+        return sum<=1.0+tol;
+    }
+    for(int k=0;k<dim;k++){
+        if(std::abs(xi[k])>1.0+tol) return false;
+    }
+    return true;
+}
+
+void PointProbe::releaseMemory(){
+    m_Terms.clear();
+    m_LocalTerms.clear();
+    m_LocalValues.clear();
+    m_GatheredSlots.clear();
+    m_GatheredValues.clear();
+    m_RecvCounts.clear();
+    m_Displs.clear();
+    m_IsSetup=false;
+}
@@ -18,6 +18,8 @@ Postprocessor::Postprocessor(){
     m_output_interval=1;
     m_pps_namelist.clear();
     m_pps_values.clear();
+    m_pps_localsums.clear();
+    m_pps_globalsums.clear();
 
     m_inputfilename.clear();
 
@@ -34,6 +36,10 @@ void Postprocessor::init(){
 void Postprocessor::releaseMemory(){
     m_nodes0.clear();
     m_nodes.clear();
+    m_pps_localsums.clear();
+    m_pps_globalsums.clear();
+    m_probe.releaseMemory();
+    m_pps_isprobed.clear();
 }
 //**********************************************
 void Postprocessor::addPPSBlock2List(const PostprocessorBlock &t_block){
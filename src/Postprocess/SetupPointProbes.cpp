@@ -0,0 +1,158 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.10
+//+++ Purpose: resolve the nodal and point value pps to the probe
+//+++          service before the first postprocess step
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "Postprocess/Postprocessor.h"
+
+/**
+ * find the index of the given material name in the projection name list
+ */
+static int getProjMateIndex(const vector<string> &namelist,const string &matename,const string &blockname){
+    for(int i=0;i<static_cast<int>(namelist.size());i++){
+        if(namelist[i]==matename) return i;
+    }
+    MessagePrinter::printErrorTxt("can\'t find projected material(="+matename+") for postprocess block("+blockname+"), "
+                                  "please check your input file");
+    MessagePrinter::exitAsFem();
+    return -1;
+}
+/**
+ * read the index parameter in [1,3]
+ */
+static int getComponentIndex(const nlohmann::json &parameters,const string &name,const string &blockname){
+    int i=JsonUtils::getInteger(parameters,name);
+    if(i<1||i>3){
+        MessagePrinter::printErrorTxt(name+"="+to_string(i)+" is invalid for postprocess block("+blockname+"), please check your input file");
+        MessagePrinter::exitAsFem();
+    }
+    return i;
+}
+
+void Postprocessor::setupPointProbes(const FECell &t_fecell,
+                                     const DofHandler &t_dofhandler,
+                                     FE &t_fe,
+                                     SolutionSystem &t_soln,
+                                     ProjectionSystem &t_projsystem){
+    int nodeid,sourceid,i,j;
+    string blockname;
+    m_probe.releaseMemory();
+    m_pps_isprobed.assign(m_pps_blocksnum,false);
+    for(int b=1;b<=getPPSBlocksNum();b++){
+        const PostprocessorBlock &block=m_pps_blocklist[b-1];
+        const nlohmann::json &parameters=block.m_parameters;
+        blockname=block.m_block_name;
+        if(block.m_pps_type==PostprocessorType::NODALVALUE||
+           block.m_pps_type==PostprocessorType::NODALSCALARMATERIALVALUE||
+           block.m_pps_type==PostprocessorType::NODALVECTORMATERIALVALUE||
+           block.m_pps_type==PostprocessorType::NODALRANK2MATERIALVALUE){
+            nodeid=JsonUtils::getInteger(parameters,"nodeid");
+            if(nodeid<1||nodeid>t_dofhandler.getNodesNum()){
+                MessagePrinter::printErrorTxt("node id="+to_string(nodeid)+" is invalid for postprocess block("+blockname+"), please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+        }
+        else{
+            nodeid=0;
+        }
+
+        switch (block.m_pps_type)
+        {
+        case PostprocessorType::NODALVALUE:
+        {
+            if(!JsonUtils::hasOnlyGivenValues(parameters,vector<string>{"nodeid"})){
+                MessagePrinter::printErrorTxt("Unsupported options in parameters of the NodalValuePostprocessor, "
+                                              "the 'nodeid' is the only parameter you need,"
+                                              "please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            if(block.m_dofid<1||block.m_dofid>t_dofhandler.getMaxDofsPerNode()){
+                MessagePrinter::printErrorTxt("dof id="+to_string(block.m_dofid)+" is invalid for postprocess block("+blockname+"), please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            m_probe.addEntryProbe(b-1,ProbeSource::SOLUTION,0,t_dofhandler.getIthNodeJthDofID(nodeid,block.m_dofid));
+            m_pps_isprobed[b-1]=true;
+            break;
+        }
+        case PostprocessorType::NODALSCALARMATERIALVALUE:
+        {
+            if(!JsonUtils::hasOnlyGivenValues(parameters,vector<string>{"nodeid","scalarmate"})){
+                MessagePrinter::printErrorTxt("Unsupported options in parameters of the NodalScalarMatePostprocessor, "
+                                              "the 'nodeid' and 'scalarmate' are the only parameters you need,"
+                                              "please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            sourceid=getProjMateIndex(t_projsystem.getProjectionDataRef().m_ScalarProjMateNameList,
+                                      JsonUtils::getString(parameters,"scalarmate"),blockname);
+            m_probe.addEntryProbe(b-1,ProbeSource::SCALARMATE,sourceid,(nodeid-1)*(1+1)+2);
+            m_pps_isprobed[b-1]=true;
+            break;
+        }
+        case PostprocessorType::NODALVECTORMATERIALVALUE:
+        {
+            if(!JsonUtils::hasOnlyGivenValues(parameters,vector<string>{"nodeid","vectormate","component"})){
+                MessagePrinter::printErrorTxt("Unsupported options in parameters of the NodalVectorMatePostprocessor, "
+                                              "the 'nodeid', 'vectormate', and 'component' are the only parameters you need,"
+                                              "please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            i=getComponentIndex(parameters,"component",blockname);
+            sourceid=getProjMateIndex(t_projsystem.getProjectionDataRef().m_VectorProjMateNamelist,
+                                      JsonUtils::getString(parameters,"vectormate"),blockname);
+            m_probe.addEntryProbe(b-1,ProbeSource::VECTORMATE,sourceid,(nodeid-1)*(1+3)+i+1);
+            m_pps_isprobed[b-1]=true;
+            break;
+        }
+        case PostprocessorType::NODALRANK2MATERIALVALUE:
+        {
+            if(!JsonUtils::hasOnlyGivenValues(parameters,vector<string>{"nodeid","rank2mate","i-index","j-index"})){
+                MessagePrinter::printErrorTxt("Unsupported options in parameters of the NodalRank2MatePostprocessor, "
+                                              "the 'nodeid', 'rank2mate', 'i-index', and 'j-index' are the only parameters you need,"
+                                              "please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            i=getComponentIndex(parameters,"i-index",blockname);
+            j=getComponentIndex(parameters,"j-index",blockname);
+            sourceid=getProjMateIndex(t_projsystem.getProjectionDataRef().m_Rank2ProjMateNameList,
+                                      JsonUtils::getString(parameters,"rank2mate"),blockname);
+            m_probe.addEntryProbe(b-1,ProbeSource::RANK2MATE,sourceid,(nodeid-1)*(1+9)+(i-1)*3+j+1);
+            m_pps_isprobed[b-1]=true;
+            break;
+        }
+        case PostprocessorType::POINTVALUE:
+        {
+            if(!JsonUtils::hasOnlyGivenValues(parameters,vector<string>{"point"})){
+                MessagePrinter::printErrorTxt("Unsupported options in parameters of the point value postprocessor, "
+                                              "the 'point' is the only parameter you need,"
+                                              "please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            if(block.m_dofid<1||block.m_dofid>t_dofhandler.getMaxDofsPerNode()){
+                MessagePrinter::printErrorTxt("dof id="+to_string(block.m_dofid)+" is invalid for postprocess block("+blockname+"), "
+                                              "a valid 'dof' is required by the point value postprocessor");
+                MessagePrinter::exitAsFem();
+            }
+            if(!m_probe.addPointProbe(b-1,JsonUtils::getVector(parameters,"point"),block.m_dofid,t_fecell,t_dofhandler,t_fe)){
+                MessagePrinter::printErrorTxt("the point of postprocess block("+blockname+") is outside of your mesh, please check your input file");
+                MessagePrinter::exitAsFem();
+            }
+            m_pps_isprobed[b-1]=true;
+            break;
+        }
+        default:
+            // the rank-4 nodal pps and the integral pps are not handled by the probe service
+            break;
+        }
+    }
+    m_probe.setup(t_soln,t_projsystem);
+}
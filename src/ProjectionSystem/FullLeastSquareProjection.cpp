@@ -95,27 +95,26 @@ void FullLeastSquareProjection::projectLocalScalarMate2Global(const int &NodesNu
 
     bool HasName;
     int j,k,jInd,iInd,qp;
+    double Val;
     for(k=1;k<=ProjNum;k++){
-        HasName=false;
-        for(const auto &it:SolnSystem.m_QpointsScalarMaterials_Local[(ElmtID-1)*QPointsNum+1-1]){
-            if(it.first==ScalarMateNameList[k-1]){
-                RHSVec.setZero();
-                QpSolnVec.setZero();
-                NodalSolnVec.setZero();
-                for (qp=1;qp<=QPointsNum;qp++) {
-                    QpSolnVec.coeffRef(qp-1)=SolnSystem.m_QpointsScalarMaterials_Local[(ElmtID-1)*QPointsNum+qp-1].at(it.first);
-                }
-                RHSVec=ARight*QpSolnVec;
-                NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
-                HasName=true;
-                for(j=1;j<=NodesNum;j++) {
-                    iInd=ElConn[j-1];
-                    jInd=(iInd-1)*(1+1)+1;
-                    ScalarProjMateVecList[k-1].addValue(jInd,Volume);
-                    jInd=(iInd-1)*(1+1)+2;
-                    ScalarProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
-                }
-                break;
+        // the material may be stored in either double or single precision, so it is accessed by the solution system
+        HasName=SolnSystem.getLocalQpMaterial(ElmtID,1,ScalarMateNameList[k-1],Val);
+        if(HasName){
+            RHSVec.setZero();
+            QpSolnVec.setZero();
+            NodalSolnVec.setZero();
+            for (qp=1;qp<=QPointsNum;qp++) {
+                SolnSystem.getLocalQpMaterial(ElmtID,qp,ScalarMateNameList[k-1],Val);
+                QpSolnVec.coeffRef(qp-1)=Val;
+            }
+            RHSVec=ARight*QpSolnVec;
+            NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
+            for(j=1;j<=NodesNum;j++) {
+                iInd=ElConn[j-1];
+                jInd=(iInd-1)*(1+1)+1;
+                ScalarProjMateVecList[k-1].addValue(jInd,Volume);
+                jInd=(iInd-1)*(1+1)+2;
+                ScalarProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
             }
         }
         if(!HasName){
@@ -142,32 +141,32 @@ void FullLeastSquareProjection::projectLocalVectorMate2Global(const int &NodesNu
     }
     bool HasName;
     int j,jInd,iInd;
+    vector<Vector3d> QpVals(QPointsNum);
     for(int k=1;k<=ProjNum;k++){
-        HasName=false;
-        for(const auto &it:SolnSystem.m_QpointsVectorMaterials_Local[(ElmtID-1)*QPointsNum+1-1]){
-            if(it.first==VectorMateNameList[k-1]){
-                HasName=true;
-                for(j=1;j<=NodesNum;j++) {
-                    iInd=ElConn[j-1];
-                    jInd=(iInd-1)*(1+3)+1;
-                    VectorProjMateVecList[k-1].addValue(jInd,Volume);
+        HasName=true;
+        for (int qp=1;qp<=QPointsNum&&HasName;qp++) {
+            HasName=SolnSystem.getLocalQpMaterial(ElmtID,qp,VectorMateNameList[k-1],QpVals[qp-1]);
+        }
+        if(HasName){
+            for(j=1;j<=NodesNum;j++) {
+                iInd=ElConn[j-1];
+                jInd=(iInd-1)*(1+3)+1;
+                VectorProjMateVecList[k-1].addValue(jInd,Volume);
+            }
+            for (int component=1;component<=3;component++) {
+                RHSVec.setZero();
+                QpSolnVec.setZero();
+                NodalSolnVec.setZero();
+                for (int qp=1;qp<=QPointsNum;qp++) {
+                    QpSolnVec.coeffRef(qp-1)=QpVals[qp-1](component);
                 }
-                for (int component=1;component<=3;component++) {
-                    RHSVec.setZero();
-                    QpSolnVec.setZero();
-                    NodalSolnVec.setZero();
-                    for (int qp=1;qp<=QPointsNum;qp++) {
-                        QpSolnVec.coeffRef(qp-1)=SolnSystem.m_QpointsVectorMaterials_Local[(ElmtID-1)*QPointsNum+qp-1].at(it.first)(component);
-                    }
-                    RHSVec=ARight*QpSolnVec;
-                    NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
-                    for (j=1;j<=NodesNum;j++) {
-                        iInd=ElConn[j-1];
-                        jInd=(iInd-1)*(1+3)+1+component;
-                        VectorProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
-                    }
+                RHSVec=ARight*QpSolnVec;
+                NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
+                for (j=1;j<=NodesNum;j++) {
+                    iInd=ElConn[j-1];
+                    jInd=(iInd-1)*(1+3)+1+component;
+                    VectorProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
                 }
-                break;
             }
         }
         if(!HasName){
@@ -195,37 +194,37 @@ void FullLeastSquareProjection::projectLocalRank2Mate2Global(const int &NodesNum
     bool HasName;
     int j,k,jInd,iInd;
     int i1,j1,ii;
+    vector<Rank2Tensor> QpVals(QPointsNum);
     for(k=1;k<=ProjNum;k++){
-        HasName=false;
-        for(const auto &it:SolnSystem.m_QpointsRank2Materials_Local[(ElmtID-1)*QPointsNum+1-1]){
-            if(it.first==Rank2MateNameList[k-1]){
-                HasName=true;
-                for(j=1;j<=NodesNum;j++) {
-                    iInd=ElConn[j-1];
-                    jInd=(iInd-1)*(9+1)+0+1;
-                    Rank2ProjMateVecList[k-1].addValue(jInd,Volume);
-                }
+        HasName=true;
+        for (int qp=1;qp<=QPointsNum&&HasName;qp++) {
+            HasName=SolnSystem.getLocalQpMaterial(ElmtID,qp,Rank2MateNameList[k-1],QpVals[qp-1]);
+        }
+        if(HasName){
+            for(j=1;j<=NodesNum;j++) {
+                iInd=ElConn[j-1];
+                jInd=(iInd-1)*(9+1)+0+1;
+                Rank2ProjMateVecList[k-1].addValue(jInd,Volume);
+            }
 
-                ii=0;
-                for(i1=1;i1<=3;i1++){
-                    for(j1=1;j1<=3;j1++){
-                        RHSVec.setZero();
-                        QpSolnVec.setZero();
-                        NodalSolnVec.setZero();
-                        for (int qp=1;qp<=QPointsNum;qp++) {
-                            QpSolnVec.coeffRef(qp-1)=SolnSystem.m_QpointsRank2Materials_Local[(ElmtID-1)*QPointsNum+qp-1].at(it.first)(i1,j1);
-                        }
-                        RHSVec=ARight*QpSolnVec;
-                        NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
-                        ii+=1;
-                        for(j=1;j<=NodesNum;j++) {
-                            iInd=ElConn[j-1];
-                            jInd=(iInd-1)*(9+1)+ii+1;
-                            Rank2ProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
-                        }
+            ii=0;
+            for(i1=1;i1<=3;i1++){
+                for(j1=1;j1<=3;j1++){
+                    RHSVec.setZero();
+                    QpSolnVec.setZero();
+                    NodalSolnVec.setZero();
+                    for (int qp=1;qp<=QPointsNum;qp++) {
+                        QpSolnVec.coeffRef(qp-1)=QpVals[qp-1](i1,j1);
+                    }
+                    RHSVec=ARight*QpSolnVec;
+                    NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
+                    ii+=1;
+                    for(j=1;j<=NodesNum;j++) {
+                        iInd=ElConn[j-1];
+                        jInd=(iInd-1)*(9+1)+ii+1;
+                        Rank2ProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
                     }
                 }
-                break;
             }
         }
         if(!HasName){
@@ -253,37 +252,37 @@ void FullLeastSquareProjection::projectLocalRank4Mate2Global(const int &NodesNum
     bool HasName;
     int j,k,jInd,iInd;
     int i1,j1,ii;
+    vector<Rank4Tensor> QpVals(QPointsNum);
     for(k=1;k<=ProjNum;k++){
-        HasName=false;
-        for(const auto &it:SolnSystem.m_QpointsRank4Materials_Local[(ElmtID-1)*QPointsNum+1-1]){
-            if(it.first==Rank4MateNameList[k-1]){
-                HasName=true;
-                ii=0;
-                for(j=1;j<=NodesNum;j++) {
-                    iInd=ElConn[j-1];
-                    jInd=(iInd-1)*(36+1)+ii+1;
-                    Rank4ProjMateVecList[k-1].addValue(jInd,Volume);
-                }
-                for(i1=1;i1<=6;i1++){
-                    for(j1=1;j1<=6;j1++){
-                        RHSVec.setZero();
-                        QpSolnVec.setZero();
-                        NodalSolnVec.setZero();
-                        for (int qp=1;qp<=QPointsNum;qp++) {
-                            QpSolnVec.coeffRef(qp-1)=SolnSystem.m_QpointsRank4Materials_Local[(ElmtID-1)*QPointsNum+qp-1].at(it.first).getVoigtComponent(i1,j1);
-                        }
-                        RHSVec=ARight*QpSolnVec;
-                        NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
-
-                        ii+=1;
-                        for(j=1;j<=NodesNum;j++) {
-                            iInd=ElConn[j-1];
-                            jInd=(iInd-1)*(36+1)+ii+1;
-                            Rank4ProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
-                        }
+        HasName=true;
+        for (int qp=1;qp<=QPointsNum&&HasName;qp++) {
+            HasName=SolnSystem.getLocalQpMaterial(ElmtID,qp,Rank4MateNameList[k-1],QpVals[qp-1]);
+        }
+        if(HasName){
+            ii=0;
+            for(j=1;j<=NodesNum;j++) {
+                iInd=ElConn[j-1];
+                jInd=(iInd-1)*(36+1)+ii+1;
+                Rank4ProjMateVecList[k-1].addValue(jInd,Volume);
+            }
+            for(i1=1;i1<=6;i1++){
+                for(j1=1;j1<=6;j1++){
+                    RHSVec.setZero();
+                    QpSolnVec.setZero();
+                    NodalSolnVec.setZero();
+                    for (int qp=1;qp<=QPointsNum;qp++) {
+                        QpSolnVec.coeffRef(qp-1)=QpVals[qp-1].getVoigtComponent(i1,j1);
+                    }
+                    RHSVec=ARight*QpSolnVec;
+                    NodalSolnVec=ALeft.fullPivLu().solve(RHSVec);
+
+                    ii+=1;
+                    for(j=1;j<=NodesNum;j++) {
+                        iInd=ElConn[j-1];
+                        jInd=(iInd-1)*(36+1)+ii+1;
+                        Rank4ProjMateVecList[k-1].addValue(jInd,NodalSolnVec.coeff(j-1)*Volume);
                     }
                 }
-                break;
             }
         }
         if(!HasName){
@@ -458,22 +457,8 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
     MyLocalCellVec=t_FECell.getLocalBulkFECellVecCopy();
     m_BulkElmtNodesNum=t_FECell.getFECellNodesNumPerBulkElmt();
 
-    QpointsNum=t_FE.m_BulkQpoints.getQPointsNum();
-    m_LocalElmtInfo.m_QpointsNum=QpointsNum;
-
-    if (IsFirstSetup) {
-        A.resize(QpointsNum,m_BulkElmtNodesNum);
-        AT.resize(m_BulkElmtNodesNum,QpointsNum);
-        W.resize(QpointsNum,QpointsNum);
-
-        Al.resize(m_BulkElmtNodesNum,m_BulkElmtNodesNum);
-        Ar.resize(m_BulkElmtNodesNum,QpointsNum);
-
-        QpSolnVec.resize(QpointsNum);
-        NodalSolnVec.resize(m_BulkElmtNodesNum);
-        RHSVec.resize(m_BulkElmtNodesNum);
-        IsFirstSetup=false;
-    }
+    bool HasMeanDilatation;
+    int SubElmtsNum,DispNum;
 
     for (int e=1;e<=t_FECell.getLocalFECellBulkElmtsNum();e++) {
         m_LocalElmtInfo.m_Dim=MyLocalCellVec[e-1].Dim;
@@ -485,6 +470,46 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
         m_Nodes0=MyLocalCellVec[e-1].ElmtNodeCoords0;
         m_ElmtConn=MyLocalCellVec[e-1].ElmtConn;
 
+        SubElmtsNum=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);
+        const QPoint &Qpoints=t_FE.getIthBlockBulkQpoints(SubElmtsNum>0?t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,1):0);
+        QpointsNum=Qpoints.getQPointsNum();
+        m_LocalElmtInfo.m_QpointsNum=QpointsNum;
+
+        // the blocks may have different qpoints number, so the matrices are resized once the number changes
+        if (IsFirstSetup||A.rows()!=QpointsNum) {
+            A.resize(QpointsNum,m_BulkElmtNodesNum);
+            AT.resize(m_BulkElmtNodesNum,QpointsNum);
+            W.resize(QpointsNum,QpointsNum);
+
+            Al.resize(m_BulkElmtNodesNum,m_BulkElmtNodesNum);
+            Ar.resize(m_BulkElmtNodesNum,QpointsNum);
+
+            QpSolnVec.resize(QpointsNum);
+            NodalSolnVec.resize(m_BulkElmtNodesNum);
+            RHSVec.resize(m_BulkElmtNodesNum);
+            IsFirstSetup=false;
+        }
+
+        // the mean dilatation of the selective reduced integration blocks
+        HasMeanDilatation=false;
+        for (int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++) {
+            const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt));
+            if (!Block.m_IsSelectiveReduced) continue;
+            if (!HasMeanDilatation) {
+                m_ReducedIntegration.computeMeanShapeGrad(Qpoints,t_FE.m_BulkShp,m_Nodes0,m_LocalElmtInfo.m_Dim,m_LocalElmtInfo.m_NodesNum);
+                m_SubElmtMeanDilatation.assign(SubElmtsNum,0.0);
+                m_ReducedNodalU.assign(3*m_LocalElmtInfo.m_NodesNum,0.0);
+                HasMeanDilatation=true;
+            }
+            DispNum=std::min(m_LocalElmtInfo.m_Dim,static_cast<int>(Block.m_DofIDs.size()));
+            for (int i=1;i<=m_LocalElmtInfo.m_NodesNum;i++) {
+                for (int k=1;k<=DispNum;k++) {
+                    m_ReducedNodalU[(i-1)*3+k-1]=t_SolnSystem.m_Ucurrent.getIthValueFromGhost(t_DofHandler.getIthNodeJthDofID(m_ElmtConn[i-1],Block.m_DofIDs[k-1]));
+                }
+            }
+            m_SubElmtMeanDilatation[SubElmt-1]=m_ReducedIntegration.getMeanDilatation(m_ReducedNodalU.data());
+        }
+
         A.setZero();
         AT.setZero();
         W.setZero();
@@ -494,18 +519,18 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
         Volume=0.0;
 
         for (int qp=1;qp<=QpointsNum;qp++) {
-            w=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,0);
-            xi=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,1);
+            w=Qpoints.getIthPointJthCoord(qp,0);
+            xi=Qpoints.getIthPointJthCoord(qp,1);
             if (m_LocalElmtInfo.m_Dim==1) {
                 eta=0.0;zeta=0.0;
             }
             else if (m_LocalElmtInfo.m_Dim==2) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
                 zeta=0.0;
             }
             else if (m_LocalElmtInfo.m_Dim==3) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
-                zeta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,3);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
+                zeta=Qpoints.getIthPointJthCoord(qp,3);
             }
             t_FE.m_BulkShp.calc(xi,eta,zeta,m_Nodes0,true);
             J=t_FE.m_BulkShp.getJacDet();
@@ -525,10 +550,7 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
                 AT.coeffRef(i-1,qp-1)=t_FE.m_BulkShp.shape_value(i);
             }
 
-            t_MateSystem.m_MaterialContainerOld.getScalarMaterialsRef()=t_SolnSystem.m_QpointsScalarMaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getVectorMaterialsRef()=t_SolnSystem.m_QpointsVectorMaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getRank2MaterialsRef()=t_SolnSystem.m_QpointsRank2MaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getRank4MaterialsRef()=t_SolnSystem.m_QpointsRank4MaterialsOld_Local[(e-1)*QpointsNum+qp-1];
+            t_SolnSystem.loadLocalQpMaterialsOld(e,qp,t_MateSystem.m_MaterialContainerOld);
 
             for (int SubElmt=1;SubElmt<=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);SubElmt++) {
                 SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
@@ -583,6 +605,10 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
                         m_LocalElmtSoln.m_QpGradV[i](3)+=t_FE.m_BulkShp.shape_grad(j)(3)*t_SolnSystem.m_V.getIthValueFromGhost(GlobalDofID);
                     }
                 }// end-of-sub-element-dofs-loop
+                if (HasMeanDilatation&&t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_IsSelectiveReduced) {
+                    DispNum=std::min(m_LocalElmtInfo.m_Dim,m_SubElmtDofs);
+                    ReducedIntegration::applyMeanDilatation(m_SubElmtMeanDilatation[SubElmt-1],DispNum,m_LocalElmtInfo.m_Dim,m_LocalElmtSoln.m_QpGradU);
+                }
 
 
                 //***********************************************************
@@ -593,10 +619,7 @@ void FullLeastSquareProjection::executeMyProjection(const FECell &t_FECell,
                                              m_LocalElmtInfo,
                                              m_LocalElmtSoln);
 
-                t_SolnSystem.m_QpointsScalarMaterials_Local[(e-1)*QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getScalarMaterialsCopy();
-                t_SolnSystem.m_QpointsVectorMaterials_Local[(e-1)*QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getVectorMaterialsCopy();
-                t_SolnSystem.m_QpointsRank2Materials_Local[(e-1)*QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank2MaterialsCopy();
-                t_SolnSystem.m_QpointsRank4Materials_Local[(e-1)*QpointsNum+qp-1]=t_MateSystem.m_MaterialContainer.getRank4MaterialsCopy();
+                t_SolnSystem.saveLocalQpMaterials(e,qp,t_MateSystem.m_MaterialContainer,false);
 
             }//end-of-sub-element-loop
         }// end-of-qpoints-loop
@@ -412,8 +412,8 @@ void LeastSquareProjection::executeMyProjection(const FECell &t_FECell,
     MyLocalCellVec=t_FECell.getLocalBulkFECellVecCopy();
     m_BulkElmtNodesNum=t_FECell.getFECellNodesNumPerBulkElmt();
 
-    QpointsNum=t_FE.m_BulkQpoints.getQPointsNum();
-    m_LocalElmtInfo.m_QpointsNum=QpointsNum;
+    bool HasMeanDilatation;
+    int SubElmtsNum,DispNum;
 
     for (int e=1;e<=t_FECell.getLocalFECellBulkElmtsNum();e++) {
         m_LocalElmtInfo.m_Dim=MyLocalCellVec[e-1].Dim;
@@ -424,19 +424,45 @@ void LeastSquareProjection::executeMyProjection(const FECell &t_FECell,
         m_Nodes=MyLocalCellVec[e-1].ElmtNodeCoords;
         m_Nodes0=MyLocalCellVec[e-1].ElmtNodeCoords0;
         m_ElmtConn=MyLocalCellVec[e-1].ElmtConn;
+
+        SubElmtsNum=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);
+        const QPoint &Qpoints=t_FE.getIthBlockBulkQpoints(SubElmtsNum>0?t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,1):0);
+        QpointsNum=Qpoints.getQPointsNum();
+        m_LocalElmtInfo.m_QpointsNum=QpointsNum;
+
+        // the mean dilatation of the selective reduced integration blocks
+        HasMeanDilatation=false;
+        for (int SubElmt=1;SubElmt<=SubElmtsNum;SubElmt++) {
+            const ElmtBlock &Block=t_ElmtSystem.getIthBulkElmtBlockRef(t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt));
+            if (!Block.m_IsSelectiveReduced) continue;
+            if (!HasMeanDilatation) {
+                m_ReducedIntegration.computeMeanShapeGrad(Qpoints,t_FE.m_BulkShp,m_Nodes0,m_LocalElmtInfo.m_Dim,m_LocalElmtInfo.m_NodesNum);
+                m_SubElmtMeanDilatation.assign(SubElmtsNum,0.0);
+                m_ReducedNodalU.assign(3*m_LocalElmtInfo.m_NodesNum,0.0);
+                HasMeanDilatation=true;
+            }
+            DispNum=std::min(m_LocalElmtInfo.m_Dim,static_cast<int>(Block.m_DofIDs.size()));
+            for (int i=1;i<=m_LocalElmtInfo.m_NodesNum;i++) {
+                for (int k=1;k<=DispNum;k++) {
+                    m_ReducedNodalU[(i-1)*3+k-1]=t_SolnSystem.m_Ucurrent.getIthValueFromGhost(t_DofHandler.getIthNodeJthDofID(m_ElmtConn[i-1],Block.m_DofIDs[k-1]));
+                }
+            }
+            m_SubElmtMeanDilatation[SubElmt-1]=m_ReducedIntegration.getMeanDilatation(m_ReducedNodalU.data());
+        }
+
         for (int qp=1;qp<=QpointsNum;qp++) {
-            w=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,0);
-            xi=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,1);
+            w=Qpoints.getIthPointJthCoord(qp,0);
+            xi=Qpoints.getIthPointJthCoord(qp,1);
             if (m_LocalElmtInfo.m_Dim==1) {
                 eta=0.0;zeta=0.0;
             }
             else if (m_LocalElmtInfo.m_Dim==2) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
                 zeta=0.0;
             }
             else if (m_LocalElmtInfo.m_Dim==3) {
-                eta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,2);
-                zeta=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,3);
+                eta=Qpoints.getIthPointJthCoord(qp,2);
+                zeta=Qpoints.getIthPointJthCoord(qp,3);
             }
             t_FE.m_BulkShp.calc(xi,eta,zeta,m_Nodes0,true);
             J=t_FE.m_BulkShp.getJacDet();
@@ -450,10 +476,8 @@ void LeastSquareProjection::executeMyProjection(const FECell &t_FECell,
                 m_LocalElmtInfo.m_QpCoords0(3)+=t_FE.m_BulkShp.shape_value(i)*m_Nodes0(i,3);
             }
 
-            t_MateSystem.m_MaterialContainerOld.getScalarMaterialsRef()=t_SolnSystem.m_QpointsScalarMaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getVectorMaterialsRef()=t_SolnSystem.m_QpointsVectorMaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getRank2MaterialsRef()=t_SolnSystem.m_QpointsRank2MaterialsOld_Local[(e-1)*QpointsNum+qp-1];
-            t_MateSystem.m_MaterialContainerOld.getRank4MaterialsRef()=t_SolnSystem.m_QpointsRank4MaterialsOld_Local[(e-1)*QpointsNum+qp-1];
+            // the single precision materials are restored from their float storage as well
+            t_SolnSystem.loadLocalQpMaterialsOld(e,qp,t_MateSystem.m_MaterialContainerOld);
 
             for (int SubElmt=1;SubElmt<=t_ElmtSystem.getLocalIthBulkElmtSubElmtsNum(e);SubElmt++) {
                 SubElmtBlockID=t_ElmtSystem.getLocalIthBulkElmtJthSubElmtID(e,SubElmt);
@@ -508,6 +532,10 @@ void LeastSquareProjection::executeMyProjection(const FECell &t_FECell,
                         m_LocalElmtSoln.m_QpGradV[i](3)+=t_FE.m_BulkShp.shape_grad(j)(3)*t_SolnSystem.m_V.getIthValueFromGhost(GlobalDofID);
                     }
                 }// end-of-sub-element-dofs-loop
+                if (HasMeanDilatation&&t_ElmtSystem.getIthBulkElmtBlockRef(SubElmtBlockID).m_IsSelectiveReduced) {
+                    DispNum=std::min(m_LocalElmtInfo.m_Dim,m_SubElmtDofs);
+                    ReducedIntegration::applyMeanDilatation(m_SubElmtMeanDilatation[SubElmt-1],DispNum,m_LocalElmtInfo.m_Dim,m_LocalElmtSoln.m_QpGradU);
+                }
 
 
                 //***********************************************************
@@ -14,6 +14,7 @@
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 #include "ProjectionSystem/ProjectionSystem.h"
+#include "Utils/Profiler.h"
 
 void ProjectionSystem::executeProjection(const FECell &t_FECell,
                                          const DofHandler &t_DofHandler,
@@ -22,6 +23,7 @@ void ProjectionSystem::executeProjection(const FECell &t_FECell,
                                          FE &t_FE,
                                          SolutionSystem &t_SolnSystem,
                                          const FEControlInfo &t_FECtrlInfo){
+    ProfilerScope ProjScope("projection",true);
     // if no projection is required, then return back
     if(getScalarMaterialNum()<1 &&
        getVectorMaterialNum()<1 &&
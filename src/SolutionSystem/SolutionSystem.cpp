@@ -86,6 +86,11 @@ void SolutionSystem::releaseMemory(){
         for(auto &it:m_QpointsRank4MaterialsOld_Total) it.clear();
         m_QpointsRank4MaterialsOld_Total.clear();
 
+        m_SinglePrecisionScalarMaterials_Local.clear();
+        m_SinglePrecisionVectorMaterials_Local.clear();
+        m_SinglePrecisionRank2Materials_Local.clear();
+        m_SinglePrecisionRank4Materials_Local.clear();
+
         m_Allocated=false;
     }
 }
\ No newline at end of file
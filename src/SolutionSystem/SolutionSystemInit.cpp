@@ -18,7 +18,7 @@ void SolutionSystem::init(const DofHandler &t_dofhandler,const FE &t_fe){
     m_Dofs=t_dofhandler.getActiveDofs();
     m_BulkElmtsNum=t_dofhandler.getBulkElmtsNum();
     m_BulkElmtsNum_Local=t_dofhandler.getLocalBulkElmtsNum();
-    m_QpointsNum=t_fe.m_BulkQpoints.getQPointsNum();
+    m_QpointsNum=t_fe.getMaxBulkQPointsNum();// the elements with fewer qpoints leave the tail slots empty
 
     //******************************************************
     //*** initialize each vector
@@ -35,7 +35,7 @@ void SolutionSystem::init(const DofHandler &t_dofhandler,const FE &t_fe){
     m_A.resize(m_Dofs,0.0);
 
     int rank;
-    MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
     
 
     if(rank==0){
@@ -61,6 +61,11 @@ void SolutionSystem::init(const DofHandler &t_dofhandler,const FE &t_fe){
     m_QpointsVectorMaterialsOld_Local.resize(m_BulkElmtsNum_Local*m_QpointsNum);
     m_QpointsRank2MaterialsOld_Local.resize(m_BulkElmtsNum_Local*m_QpointsNum);
     m_QpointsRank4MaterialsOld_Local.resize(m_BulkElmtsNum_Local*m_QpointsNum);
+    // the single-precision materials are allocated once they are computed
+    m_SinglePrecisionScalarMaterials_Local.clear();
+    m_SinglePrecisionVectorMaterials_Local.clear();
+    m_SinglePrecisionRank2Materials_Local.clear();
+    m_SinglePrecisionRank4Materials_Local.clear();
 
     m_Allocated=true;
 
@@ -0,0 +1,418 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.14
+//+++ Purpose: move the qpoint materials among ranks once the bulk
+//+++          elements are re-partitioned, and transfer them to
+//+++          the adapted mesh
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cmath>
+
+#include "SolutionSystem/SolutionSystem.h"
+#include "Utils/BinaryStream.h"
+#include "MPIUtils/MPIDataBus.h"
+
+namespace{
+    // the tensors are not trivially copyable, so their components are written one by one
+    void writeMate(BinaryWriter &writer,const double &val){writer.writeValue(val);}
+    void writeMate(BinaryWriter &writer,const Vector3d &val){
+        for(int i=1;i<=3;i++) writer.writeValue(val(i));
+    }
+    void writeMate(BinaryWriter &writer,const Rank2Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) writer.writeValue(val(i,j));
+    }
+    void writeMate(BinaryWriter &writer,const Rank4Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) for(int k=1;k<=3;k++) for(int l=1;l<=3;l++) writer.writeValue(val(i,j,k,l));
+    }
+    void readMate(BinaryReader &reader,double &val){reader.readValue(val);}
+    void readMate(BinaryReader &reader,Vector3d &val){
+        for(int i=1;i<=3;i++) reader.readValue(val(i));
+    }
+    void readMate(BinaryReader &reader,Rank2Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) reader.readValue(val(i,j));
+    }
+    void readMate(BinaryReader &reader,Rank4Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) for(int k=1;k<=3;k++) for(int l=1;l<=3;l++) reader.readValue(val(i,j,k,l));
+    }
+
+    template<typename T>
+    void writeMateMap(BinaryWriter &writer,const map<string,T> &mate){
+        writer.writeValue(static_cast<uint64_t>(mate.size()));
+        for(const auto &it:mate){
+            writer.writeString(it.first);
+            writeMate(writer,it.second);
+        }
+    }
+    template<typename T>
+    bool readMateMap(BinaryReader &reader,map<string,T> &mate){
+        uint64_t n;
+        string name;
+        mate.clear();
+        if(!reader.readValue(n)||n>reader.getRemainingSize()) return false;
+        for(uint64_t i=0;i<n;i++){
+            reader.readString(name);
+            readMate(reader,mate[name]);
+        }
+        return reader.isValid();
+    }
+
+    /**
+     * the single-precision materials of one element, the qpoint values are written as plain float arrays
+     */
+    void writeFields(BinaryWriter &writer,const map<string,SinglePrecisionMateField> &fields,const int &t_Offset,const int &t_QpointsNum){
+        writer.writeValue(static_cast<uint64_t>(fields.size()));
+        for(const auto &it:fields){
+            const size_t start=static_cast<size_t>(t_Offset)*it.second.m_ComponentsNum;
+            const size_t n=static_cast<size_t>(t_QpointsNum)*it.second.m_ComponentsNum;
+            writer.writeString(it.first);
+            writer.writeValue(it.second.m_ComponentsNum);
+            writer.writeArray(it.second.m_Vals.data()+start,n);
+            writer.writeArray(it.second.m_ValsOld.data()+start,n);
+        }
+    }
+    bool readFields(BinaryReader &reader,map<string,SinglePrecisionMateField> &fields,const int &t_Offset,const int &t_QpointsNum,const int &t_DataSize){
+        uint64_t n;
+        string name;
+        int ncomp;
+        vector<float> vals,valsold;
+        if(!reader.readValue(n)||n>reader.getRemainingSize()) return false;
+        for(uint64_t i=0;i<n;i++){
+            if(!reader.readString(name)||!reader.readValue(ncomp)) return false;
+            if(!reader.readVector(vals)||!reader.readVector(valsold)) return false;
+            if(ncomp<1||vals.size()!=static_cast<size_t>(t_QpointsNum)*ncomp||valsold.size()!=vals.size()) return false;
+            SinglePrecisionMateField &field=fields[name];
+            if(field.m_Vals.empty()){
+                // the material is new to current rank
+                field.m_ComponentsNum=ncomp;
+                field.m_Vals.assign(static_cast<size_t>(t_DataSize)*ncomp,0.0f);
+                field.m_ValsOld.assign(static_cast<size_t>(t_DataSize)*ncomp,0.0f);
+            }
+            if(field.m_ComponentsNum!=ncomp) return false;
+            std::copy(vals.begin(),vals.end(),field.m_Vals.begin()+static_cast<size_t>(t_Offset)*ncomp);
+            std::copy(valsold.begin(),valsold.end(),field.m_ValsOld.begin()+static_cast<size_t>(t_Offset)*ncomp);
+        }
+        return reader.isValid();
+    }
+}
+
+void SolutionSystem::migrateLocalQpMaterials(const vector<int> &t_OldPartInfo,const vector<int> &t_NewPartInfo){
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    /**
+     * pack the qpoint materials of each local element with its global id, the local elements are in ascending order of the global id
+     */
+    vector<BinaryWriter> Writers(size);
+    vector<uint64_t> SendNum(size,0);
+    int LocalID=0,ID,cpuid;
+    for(int e=1;e<=m_BulkElmtsNum;e++){
+        if(t_OldPartInfo[e-1]!=rank) continue;
+        cpuid=t_NewPartInfo[e-1];
+        SendNum[cpuid]+=1;
+        Writers[cpuid].writeValue(e);
+        for(int qp=1;qp<=m_QpointsNum;qp++){
+            ID=LocalID*m_QpointsNum+qp-1;
+            writeMateMap(Writers[cpuid],m_QpointsScalarMaterials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsVectorMaterials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank2Materials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank4Materials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsScalarMaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsVectorMaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank2MaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank4MaterialsOld_Local[ID]);
+        }
+        writeFields(Writers[cpuid],m_SinglePrecisionScalarMaterials_Local,LocalID*m_QpointsNum,m_QpointsNum);
+        writeFields(Writers[cpuid],m_SinglePrecisionVectorMaterials_Local,LocalID*m_QpointsNum,m_QpointsNum);
+        writeFields(Writers[cpuid],m_SinglePrecisionRank2Materials_Local,LocalID*m_QpointsNum,m_QpointsNum);
+        writeFields(Writers[cpuid],m_SinglePrecisionRank4Materials_Local,LocalID*m_QpointsNum,m_QpointsNum);
+        LocalID+=1;
+    }
+    if(LocalID!=m_BulkElmtsNum_Local){
+        MessagePrinter::printErrorTxt("the local elements number(="+to_string(m_BulkElmtsNum_Local)+") of the solution system doesn\'t match the old partition info, "
+                                      "can\'t migrate the qpoint materials");
+        MessagePrinter::exitAsFem();
+    }
+    vector<vector<char>> SendBufs(size),RecvBufs;
+    for(cpuid=0;cpuid<size;cpuid++){
+        BinaryWriter writer;
+        writer.writeValue(SendNum[cpuid]);
+        writer.getDataRef().insert(writer.getDataRef().end(),Writers[cpuid].getData(),Writers[cpuid].getData()+Writers[cpuid].getSize());
+        Writers[cpuid].clear();
+        SendBufs[cpuid]=std::move(writer.getDataRef());
+    }
+    MPIDataBus::exchangeBuffersAmongRanks(SendBufs,RecvBufs);
+    SendBufs.clear();
+
+    /**
+     * the new local id of each global element
+     */
+    map<int,int> Global2LocalIDMap;
+    m_BulkElmtsNum_Local=0;
+    for(int e=1;e<=m_BulkElmtsNum;e++){
+        if(t_NewPartInfo[e-1]==rank){
+            Global2LocalIDMap[e]=m_BulkElmtsNum_Local;
+            m_BulkElmtsNum_Local+=1;
+        }
+    }
+    const int DataSize=m_BulkElmtsNum_Local*m_QpointsNum;
+    m_QpointsScalarMaterials_Local.assign(DataSize,ScalarMateType());
+    m_QpointsVectorMaterials_Local.assign(DataSize,VectorMateType());
+    m_QpointsRank2Materials_Local.assign(DataSize,Rank2MateType());
+    m_QpointsRank4Materials_Local.assign(DataSize,Rank4MateType());
+    m_QpointsScalarMaterialsOld_Local.assign(DataSize,ScalarMateType());
+    m_QpointsVectorMaterialsOld_Local.assign(DataSize,VectorMateType());
+    m_QpointsRank2MaterialsOld_Local.assign(DataSize,Rank2MateType());
+    m_QpointsRank4MaterialsOld_Local.assign(DataSize,Rank4MateType());
+    for(auto *fields:{&m_SinglePrecisionScalarMaterials_Local,&m_SinglePrecisionVectorMaterials_Local,
+                      &m_SinglePrecisionRank2Materials_Local,&m_SinglePrecisionRank4Materials_Local}){
+        for(auto &it:*fields){
+            it.second.m_Vals.assign(static_cast<size_t>(DataSize)*it.second.m_ComponentsNum,0.0f);
+            it.second.m_ValsOld.assign(static_cast<size_t>(DataSize)*it.second.m_ComponentsNum,0.0f);
+        }
+    }
+
+    bool IsValid=true;
+    for(cpuid=0;cpuid<size&&IsValid;cpuid++){
+        BinaryReader reader(RecvBufs[cpuid].data(),RecvBufs[cpuid].size());
+        uint64_t n=0;
+        reader.readValue(n);
+        for(uint64_t i=0;i<n&&IsValid;i++){
+            int e=0;
+            reader.readValue(e);
+            if(Global2LocalIDMap.find(e)==Global2LocalIDMap.end()){
+                IsValid=false;
+                break;
+            }
+            for(int qp=1;qp<=m_QpointsNum;qp++){
+                ID=Global2LocalIDMap[e]*m_QpointsNum+qp-1;
+                IsValid=readMateMap(reader,m_QpointsScalarMaterials_Local[ID])&&
+                        readMateMap(reader,m_QpointsVectorMaterials_Local[ID])&&
+                        readMateMap(reader,m_QpointsRank2Materials_Local[ID])&&
+                        readMateMap(reader,m_QpointsRank4Materials_Local[ID])&&
+                        readMateMap(reader,m_QpointsScalarMaterialsOld_Local[ID])&&
+                        readMateMap(reader,m_QpointsVectorMaterialsOld_Local[ID])&&
+                        readMateMap(reader,m_QpointsRank2MaterialsOld_Local[ID])&&
+                        readMateMap(reader,m_QpointsRank4MaterialsOld_Local[ID]);
+                if(!IsValid) break;
+            }
+            if(!IsValid) break;
+            ID=Global2LocalIDMap[e]*m_QpointsNum;
+            IsValid=readFields(reader,m_SinglePrecisionScalarMaterials_Local,ID,m_QpointsNum,DataSize)&&
+                    readFields(reader,m_SinglePrecisionVectorMaterials_Local,ID,m_QpointsNum,DataSize)&&
+                    readFields(reader,m_SinglePrecisionRank2Materials_Local,ID,m_QpointsNum,DataSize)&&
+                    readFields(reader,m_SinglePrecisionRank4Materials_Local,ID,m_QpointsNum,DataSize);
+        }
+        if(!IsValid){
+            MessagePrinter::printErrorTxt("the qpoint materials received from rank-"+to_string(cpuid)+" are broken, the migration fails");
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
+
+void SolutionSystem::transferSolution(const MeshTransferData &t_Transfer,const DofHandler &t_DofHandler,const FE &t_FE,
+                                      const vector<int> &t_OldPartInfo,const vector<int> &t_NewPartInfo){
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    /**
+     * the nodal solutions, the dofs are numbered node by node, so the old dof id follows from the old node id
+     */
+    const int nDofsPerNode=t_DofHandler.getMaxDofsPerNode();
+    const int NewDofs=t_DofHandler.getActiveDofs();
+    PetscInt iStart,iEnd;
+    m_dU.resize(NewDofs,0.0);
+    VecGetOwnershipRange(m_dU.getVectorRef(),&iStart,&iEnd);
+    vector<int> Rows;
+    vector<double> Vals;
+    int i,k,p,node;
+    for(Vector *vec:{&m_Ucurrent,&m_Uold,&m_Uolder,&m_V,&m_A}){
+        vec->makeGhostCopy();
+        Rows.clear();Vals.clear();
+        for(i=static_cast<int>(iStart);i<static_cast<int>(iEnd);i++){
+            node=i/nDofsPerNode+1;
+            k=i%nDofsPerNode+1;
+            double val=0.0;
+            for(p=t_Transfer.NodeSrcPtr[node-1];p<t_Transfer.NodeSrcPtr[node];p++){
+                val+=t_Transfer.NodeSrcWeights[p]*vec->getIthValueFromGhost((t_Transfer.NodeSrcIDs[p]-1)*nDofsPerNode+k);
+            }
+            Rows.push_back(i);
+            Vals.push_back(val);
+        }
+        vec->destroyGhostCopy();
+        vec->resize(NewDofs,0.0);
+        vec->insertValues(static_cast<int>(Rows.size()),Rows.data(),Vals.data());
+        vec->assemble();
+    }
+    m_Dofs=NewDofs;
+    m_Utemp.resize(m_Dofs,0.0);
+    m_Utemp=m_Ucurrent;
+    m_Ucopy.resize(m_Dofs,0.0);
+
+    /**
+     * the source qpoint of each new qpoint, the element map only lives on the master rank
+     */
+    if(t_FE.hasBlockQpoints()){
+        MessagePrinter::printErrorTxt("the qpoint transfer of the mesh refinement only supports the global bulk qpoints, please remove the 'qpoints' of your element blocks");
+        MessagePrinter::exitAsFem();
+    }
+    const int OldElmtsNum=m_BulkElmtsNum;
+    const int NewElmtsNum=t_DofHandler.getBulkElmtsNum();
+    vector<int> QpSrc(2*NewElmtsNum*m_QpointsNum,0);
+    if(rank==0){
+        const int dim=t_Transfer.Dim;
+        double xi[3],xo[3],dist,mindist;
+        int s,qp,qo,src;
+        for(int e=1;e<=NewElmtsNum;e++){
+            for(qp=1;qp<=m_QpointsNum;qp++){
+                for(k=0;k<dim;k++) xi[k]=t_FE.m_BulkQpoints.getIthPointJthCoord(qp,k+1);
+                src=-1;
+                for(s=t_Transfer.ElmtSrcPtr[e-1];s<t_Transfer.ElmtSrcPtr[e];s++){
+                    bool IsInside=true;
+                    for(k=0;k<dim;k++){
+                        xo[k]=t_Transfer.ElmtSrcMaps[4*s]*xi[k]+t_Transfer.ElmtSrcMaps[4*s+1+k];
+                        if(std::abs(xo[k])>1.0+1.0e-10) IsInside=false;
+                    }
+                    if(IsInside){src=s;break;}
+                }
+                if(src<0){
+                    MessagePrinter::printErrorTxt("can\'t find the old element of the "+to_string(qp)+"-th qpoint of the "+to_string(e)+"-th new element, the qpoint transfer fails");
+                    MessagePrinter::exitAsFem();
+                }
+                QpSrc[2*((e-1)*m_QpointsNum+qp-1)]=t_Transfer.ElmtSrcIDs[src];
+                mindist=1.0e30;
+                for(qo=1;qo<=m_QpointsNum;qo++){
+                    dist=0.0;
+                    for(k=0;k<dim;k++) dist+=(xo[k]-t_FE.m_BulkQpoints.getIthPointJthCoord(qo,k+1))*(xo[k]-t_FE.m_BulkQpoints.getIthPointJthCoord(qo,k+1));
+                    if(dist<mindist){
+                        mindist=dist;
+                        QpSrc[2*((e-1)*m_QpointsNum+qp-1)+1]=qo;
+                    }
+                }
+            }
+        }
+    }
+    if(!QpSrc.empty()) MPI_Bcast(QpSrc.data(),static_cast<int>(QpSrc.size()),MPI_INT,0,PETSC_COMM_WORLD);
+
+    /**
+     * the old owner sends the history of each new qpoint to the new owner, one qpoint each time
+     */
+    map<int,int> OldGlobal2LocalIDMap;
+    int LocalID=0;
+    for(int e=1;e<=OldElmtsNum;e++){
+        if(t_OldPartInfo[e-1]==rank) OldGlobal2LocalIDMap[e]=LocalID++;
+    }
+    vector<BinaryWriter> Writers(size);
+    vector<uint64_t> SendNum(size,0);
+    int ID,cpuid,OldElmt;
+    for(int e=1;e<=NewElmtsNum;e++){
+        cpuid=t_NewPartInfo[e-1];
+        for(int qp=1;qp<=m_QpointsNum;qp++){
+            OldElmt=QpSrc[2*((e-1)*m_QpointsNum+qp-1)];
+            if(t_OldPartInfo[OldElmt-1]!=rank) continue;
+            ID=OldGlobal2LocalIDMap[OldElmt]*m_QpointsNum+QpSrc[2*((e-1)*m_QpointsNum+qp-1)+1]-1;
+            SendNum[cpuid]+=1;
+            Writers[cpuid].writeValue(e);
+            Writers[cpuid].writeValue(qp);
+            writeMateMap(Writers[cpuid],m_QpointsScalarMaterials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsVectorMaterials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank2Materials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank4Materials_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsScalarMaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsVectorMaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank2MaterialsOld_Local[ID]);
+            writeMateMap(Writers[cpuid],m_QpointsRank4MaterialsOld_Local[ID]);
+            writeFields(Writers[cpuid],m_SinglePrecisionScalarMaterials_Local,ID,1);
+            writeFields(Writers[cpuid],m_SinglePrecisionVectorMaterials_Local,ID,1);
+            writeFields(Writers[cpuid],m_SinglePrecisionRank2Materials_Local,ID,1);
+            writeFields(Writers[cpuid],m_SinglePrecisionRank4Materials_Local,ID,1);
+        }
+    }
+    vector<vector<char>> SendBufs(size),RecvBufs;
+    for(cpuid=0;cpuid<size;cpuid++){
+        BinaryWriter writer;
+        writer.writeValue(SendNum[cpuid]);
+        writer.getDataRef().insert(writer.getDataRef().end(),Writers[cpuid].getData(),Writers[cpuid].getData()+Writers[cpuid].getSize());
+        Writers[cpuid].clear();
+        SendBufs[cpuid]=std::move(writer.getDataRef());
+    }
+    MPIDataBus::exchangeBuffersAmongRanks(SendBufs,RecvBufs);
+    SendBufs.clear();
+
+    map<int,int> NewGlobal2LocalIDMap;
+    m_BulkElmtsNum=NewElmtsNum;
+    m_BulkElmtsNum_Local=0;
+    for(int e=1;e<=m_BulkElmtsNum;e++){
+        if(t_NewPartInfo[e-1]==rank) NewGlobal2LocalIDMap[e]=m_BulkElmtsNum_Local++;
+    }
+    if(rank==0){
+        // the global copies are only filled for the output, so they just follow the new size
+        const int TotalSize=m_BulkElmtsNum*m_QpointsNum;
+        m_QpointsScalarMaterials_Total.assign(TotalSize,ScalarMateType());
+        m_QpointsVectorMaterials_Total.assign(TotalSize,VectorMateType());
+        m_QpointsRank2Materials_Total.assign(TotalSize,Rank2MateType());
+        m_QpointsRank4Materials_Total.assign(TotalSize,Rank4MateType());
+        m_QpointsScalarMaterialsOld_Total.assign(TotalSize,ScalarMateType());
+        m_QpointsVectorMaterialsOld_Total.assign(TotalSize,VectorMateType());
+        m_QpointsRank2MaterialsOld_Total.assign(TotalSize,Rank2MateType());
+        m_QpointsRank4MaterialsOld_Total.assign(TotalSize,Rank4MateType());
+    }
+    const int DataSize=m_BulkElmtsNum_Local*m_QpointsNum;
+    m_QpointsScalarMaterials_Local.assign(DataSize,ScalarMateType());
+    m_QpointsVectorMaterials_Local.assign(DataSize,VectorMateType());
+    m_QpointsRank2Materials_Local.assign(DataSize,Rank2MateType());
+    m_QpointsRank4Materials_Local.assign(DataSize,Rank4MateType());
+    m_QpointsScalarMaterialsOld_Local.assign(DataSize,ScalarMateType());
+    m_QpointsVectorMaterialsOld_Local.assign(DataSize,VectorMateType());
+    m_QpointsRank2MaterialsOld_Local.assign(DataSize,Rank2MateType());
+    m_QpointsRank4MaterialsOld_Local.assign(DataSize,Rank4MateType());
+    for(auto *fields:{&m_SinglePrecisionScalarMaterials_Local,&m_SinglePrecisionVectorMaterials_Local,
+                      &m_SinglePrecisionRank2Materials_Local,&m_SinglePrecisionRank4Materials_Local}){
+        for(auto &it:*fields){
+            it.second.m_Vals.assign(static_cast<size_t>(DataSize)*it.second.m_ComponentsNum,0.0f);
+            it.second.m_ValsOld.assign(static_cast<size_t>(DataSize)*it.second.m_ComponentsNum,0.0f);
+        }
+    }
+
+    bool IsValid=true;
+    for(cpuid=0;cpuid<size&&IsValid;cpuid++){
+        BinaryReader reader(RecvBufs[cpuid].data(),RecvBufs[cpuid].size());
+        uint64_t n=0;
+        reader.readValue(n);
+        for(uint64_t j=0;j<n&&IsValid;j++){
+            int e=0,qp=0;
+            reader.readValue(e);
+            reader.readValue(qp);
+            if(NewGlobal2LocalIDMap.find(e)==NewGlobal2LocalIDMap.end()||qp<1||qp>m_QpointsNum){
+                IsValid=false;
+                break;
+            }
+            ID=NewGlobal2LocalIDMap[e]*m_QpointsNum+qp-1;
+            IsValid=readMateMap(reader,m_QpointsScalarMaterials_Local[ID])&&
+                    readMateMap(reader,m_QpointsVectorMaterials_Local[ID])&&
+                    readMateMap(reader,m_QpointsRank2Materials_Local[ID])&&
+                    readMateMap(reader,m_QpointsRank4Materials_Local[ID])&&
+                    readMateMap(reader,m_QpointsScalarMaterialsOld_Local[ID])&&
+                    readMateMap(reader,m_QpointsVectorMaterialsOld_Local[ID])&&
+                    readMateMap(reader,m_QpointsRank2MaterialsOld_Local[ID])&&
+                    readMateMap(reader,m_QpointsRank4MaterialsOld_Local[ID])&&
+                    readFields(reader,m_SinglePrecisionScalarMaterials_Local,ID,1,DataSize)&&
+                    readFields(reader,m_SinglePrecisionVectorMaterials_Local,ID,1,DataSize)&&
+                    readFields(reader,m_SinglePrecisionRank2Materials_Local,ID,1,DataSize)&&
+                    readFields(reader,m_SinglePrecisionRank4Materials_Local,ID,1,DataSize);
+        }
+        if(!IsValid){
+            MessagePrinter::printErrorTxt("the qpoint materials received from rank-"+to_string(cpuid)+" are broken, the transfer to the adapted mesh fails");
+            MessagePrinter::exitAsFem();
+        }
+    }
+}
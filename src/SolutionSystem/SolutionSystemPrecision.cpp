@@ -0,0 +1,147 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.16
+//+++ Purpose: save and load the qpoint materials, the selected
+//+++          ones are stored in single precision
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "SolutionSystem/SolutionSystem.h"
+
+namespace{
+    void packMate(const double &val,float *t_Data){
+        t_Data[0]=static_cast<float>(val);
+    }
+    void packMate(const Vector3d &val,float *t_Data){
+        for(int i=1;i<=3;i++) t_Data[i-1]=static_cast<float>(val(i));
+    }
+    void packMate(const Rank2Tensor &val,float *t_Data){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) t_Data[(i-1)*3+j-1]=static_cast<float>(val(i,j));
+    }
+    void packMate(const Rank4Tensor &val,float *t_Data){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) for(int k=1;k<=3;k++) for(int l=1;l<=3;l++){
+            t_Data[(((i-1)*3+j-1)*3+k-1)*3+l-1]=static_cast<float>(val(i,j,k,l));
+        }
+    }
+    void unpackMate(const float *t_Data,double &val){
+        val=static_cast<double>(t_Data[0]);
+    }
+    void unpackMate(const float *t_Data,Vector3d &val){
+        for(int i=1;i<=3;i++) val(i)=static_cast<double>(t_Data[i-1]);
+    }
+    void unpackMate(const float *t_Data,Rank2Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) val(i,j)=static_cast<double>(t_Data[(i-1)*3+j-1]);
+    }
+    void unpackMate(const float *t_Data,Rank4Tensor &val){
+        for(int i=1;i<=3;i++) for(int j=1;j<=3;j++) for(int k=1;k<=3;k++) for(int l=1;l<=3;l++){
+            val(i,j,k,l)=static_cast<double>(t_Data[(((i-1)*3+j-1)*3+k-1)*3+l-1]);
+        }
+    }
+
+    /**
+     * copy the double-precision materials and move the selected ones into the float arrays
+     */
+    template<typename T>
+    void saveMateMap(const map<string,T> &t_Mate,const std::set<string> &t_Names,const int &t_ComponentsNum,
+                     const int &t_DataSize,const int &t_ID,const bool &t_IsOld,
+                     map<string,T> &t_Dest,map<string,SinglePrecisionMateField> &t_Fields){
+        t_Dest=t_Mate;
+        for(const auto &name:t_Names){
+            auto it=t_Dest.find(name);
+            if(it==t_Dest.end()) continue;
+            SinglePrecisionMateField &field=t_Fields[name];
+            if(field.m_Vals.empty()){
+                // the material is registered the first time it is computed
+                field.m_ComponentsNum=t_ComponentsNum;
+                field.m_Vals.assign(static_cast<size_t>(t_DataSize)*t_ComponentsNum,0.0f);
+                field.m_ValsOld.assign(static_cast<size_t>(t_DataSize)*t_ComponentsNum,0.0f);
+            }
+            packMate(it->second,(t_IsOld?field.m_ValsOld:field.m_Vals).data()+static_cast<size_t>(t_ID)*t_ComponentsNum);
+            t_Dest.erase(it);
+        }
+    }
+    template<typename T>
+    void loadMateMap(const map<string,T> &t_Mate,const map<string,SinglePrecisionMateField> &t_Fields,const int &t_ID,
+                     map<string,T> &t_Dest){
+        t_Dest=t_Mate;
+        for(const auto &it:t_Fields){
+            unpackMate(it.second.m_ValsOld.data()+static_cast<size_t>(t_ID)*it.second.m_ComponentsNum,t_Dest[it.first]);
+        }
+    }
+    template<typename T>
+    bool getMate(const map<string,T> &t_Mate,const map<string,SinglePrecisionMateField> &t_Fields,const int &t_ID,
+                 const string &t_MateName,T &t_Val){
+        auto it=t_Mate.find(t_MateName);
+        if(it!=t_Mate.end()){
+            t_Val=it->second;
+            return true;
+        }
+        auto jt=t_Fields.find(t_MateName);
+        if(jt!=t_Fields.end()){
+            unpackMate(jt->second.m_Vals.data()+static_cast<size_t>(t_ID)*jt->second.m_ComponentsNum,t_Val);
+            return true;
+        }
+        return false;
+    }
+}
+
+void SolutionSystem::setSinglePrecisionMaterials(const vector<string> &t_MateNames){
+    m_SinglePrecisionMateNames.clear();
+    for(const auto &name:t_MateNames) m_SinglePrecisionMateNames.insert(name);
+}
+
+void SolutionSystem::saveLocalQpMaterials(const int &e,const int &qp,MaterialsContainer &t_Mate,const bool &t_IsOld){
+    const int ID=(e-1)*m_QpointsNum+qp-1;
+    if(m_SinglePrecisionMateNames.empty()){
+        if(t_IsOld){
+            m_QpointsScalarMaterialsOld_Local[ID]=t_Mate.getScalarMaterialsRef();
+            m_QpointsVectorMaterialsOld_Local[ID]=t_Mate.getVectorMaterialsRef();
+            m_QpointsRank2MaterialsOld_Local[ID]=t_Mate.getRank2MaterialsRef();
+            m_QpointsRank4MaterialsOld_Local[ID]=t_Mate.getRank4MaterialsRef();
+        }
+        else{
+            m_QpointsScalarMaterials_Local[ID]=t_Mate.getScalarMaterialsRef();
+            m_QpointsVectorMaterials_Local[ID]=t_Mate.getVectorMaterialsRef();
+            m_QpointsRank2Materials_Local[ID]=t_Mate.getRank2MaterialsRef();
+            m_QpointsRank4Materials_Local[ID]=t_Mate.getRank4MaterialsRef();
+        }
+        return;
+    }
+    const int DataSize=m_BulkElmtsNum_Local*m_QpointsNum;
+    saveMateMap(t_Mate.getScalarMaterialsRef(),m_SinglePrecisionMateNames,1,DataSize,ID,t_IsOld,
+                t_IsOld?m_QpointsScalarMaterialsOld_Local[ID]:m_QpointsScalarMaterials_Local[ID],m_SinglePrecisionScalarMaterials_Local);
+    saveMateMap(t_Mate.getVectorMaterialsRef(),m_SinglePrecisionMateNames,3,DataSize,ID,t_IsOld,
+                t_IsOld?m_QpointsVectorMaterialsOld_Local[ID]:m_QpointsVectorMaterials_Local[ID],m_SinglePrecisionVectorMaterials_Local);
+    saveMateMap(t_Mate.getRank2MaterialsRef(),m_SinglePrecisionMateNames,9,DataSize,ID,t_IsOld,
+                t_IsOld?m_QpointsRank2MaterialsOld_Local[ID]:m_QpointsRank2Materials_Local[ID],m_SinglePrecisionRank2Materials_Local);
+    saveMateMap(t_Mate.getRank4MaterialsRef(),m_SinglePrecisionMateNames,81,DataSize,ID,t_IsOld,
+                t_IsOld?m_QpointsRank4MaterialsOld_Local[ID]:m_QpointsRank4Materials_Local[ID],m_SinglePrecisionRank4Materials_Local);
+}
+
+void SolutionSystem::loadLocalQpMaterialsOld(const int &e,const int &qp,MaterialsContainer &t_MateOld)const{
+    const int ID=(e-1)*m_QpointsNum+qp-1;
+    loadMateMap(m_QpointsScalarMaterialsOld_Local[ID],m_SinglePrecisionScalarMaterials_Local,ID,t_MateOld.getScalarMaterialsRef());
+    loadMateMap(m_QpointsVectorMaterialsOld_Local[ID],m_SinglePrecisionVectorMaterials_Local,ID,t_MateOld.getVectorMaterialsRef());
+    loadMateMap(m_QpointsRank2MaterialsOld_Local[ID],m_SinglePrecisionRank2Materials_Local,ID,t_MateOld.getRank2MaterialsRef());
+    loadMateMap(m_QpointsRank4MaterialsOld_Local[ID],m_SinglePrecisionRank4Materials_Local,ID,t_MateOld.getRank4MaterialsRef());
+}
+
+bool SolutionSystem::getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,double &t_Val)const{
+    return getMate(m_QpointsScalarMaterials_Local[(e-1)*m_QpointsNum+qp-1],m_SinglePrecisionScalarMaterials_Local,(e-1)*m_QpointsNum+qp-1,t_MateName,t_Val);
+}
+bool SolutionSystem::getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Vector3d &t_Val)const{
+    return getMate(m_QpointsVectorMaterials_Local[(e-1)*m_QpointsNum+qp-1],m_SinglePrecisionVectorMaterials_Local,(e-1)*m_QpointsNum+qp-1,t_MateName,t_Val);
+}
+bool SolutionSystem::getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Rank2Tensor &t_Val)const{
+    return getMate(m_QpointsRank2Materials_Local[(e-1)*m_QpointsNum+qp-1],m_SinglePrecisionRank2Materials_Local,(e-1)*m_QpointsNum+qp-1,t_MateName,t_Val);
+}
+bool SolutionSystem::getLocalQpMaterial(const int &e,const int &qp,const string &t_MateName,Rank4Tensor &t_Val)const{
+    return getMate(m_QpointsRank4Materials_Local[(e-1)*m_QpointsNum+qp-1],m_SinglePrecisionRank4Materials_Local,(e-1)*m_QpointsNum+qp-1,t_MateName,t_Val);
+}
@@ -31,4 +31,8 @@ void SolutionSystem::updateMaterialsSolution(){
             m_QpointsRank4MaterialsOld_Local[(e-1)*m_QpointsNum+j-1]=m_QpointsRank4Materials_Local[(e-1)*m_QpointsNum+j-1];
         }
     }
+    for(auto &it:m_SinglePrecisionScalarMaterials_Local) it.second.m_ValsOld=it.second.m_Vals;
+    for(auto &it:m_SinglePrecisionVectorMaterials_Local) it.second.m_ValsOld=it.second.m_Vals;
+    for(auto &it:m_SinglePrecisionRank2Materials_Local) it.second.m_ValsOld=it.second.m_Vals;
+    for(auto &it:m_SinglePrecisionRank4Materials_Local) it.second.m_ValsOld=it.second.m_Vals;
 }
\ No newline at end of file
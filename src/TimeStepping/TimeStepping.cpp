@@ -25,6 +25,19 @@ TimeStepping::TimeStepping(){
     m_Data.m_GrowthFactor=1.1;/**< the growth factor for time adaptive */
     m_Data.m_IsAdaptive=false;/**< boolean flag for adaptive */
     m_Data.m_OptimizeIters=4;/**< optimize nonlinear iterations for time adaptive */
+    m_Data.m_RebalanceInterval=0;/**< no load rebalance */
+    m_Data.m_RebalanceThreshold=0.2;/**< the imbalance threshold of the rebalance */
+    m_Data.m_AdaptInterval=0;/**< no mesh adaptivity */
+    m_Data.m_AdaptInitialSteps=0;/**< no adaptation of the initial conditions */
+    m_Data.m_AdaptDofName.clear();/**< the dof which drives the marker */
+    m_Data.m_AdaptMarker=MeshAdaptMarkerType::GRADIENT;/**< the marker type */
+    m_Data.m_AdaptRefine=0.5;/**< the refine threshold */
+    m_Data.m_AdaptCoarsen=0.05;/**< the coarsen threshold */
+    m_Data.m_AdaptMaxLevel=2;/**< the maximum refinement level */
+    m_Data.m_LumpedMassType=LumpedMassType::ROWSUM;/**< the lumped mass of the explicit dynamics */
+    m_Data.m_CFLFactor=0.9;/**< the cfl factor of the explicit sub-step */
+    m_Data.m_EstimateStableDt=true;/**< estimate the explicit sub-step */
+    m_Data.m_MaxSubSteps=100000;/**< the maximum explicit sub-steps */
 
     m_Data.m_SteppingType=TimeSteppingType::BACKWARDEULER;/**< the time stepping type */
 }
@@ -39,6 +52,19 @@ void TimeStepping::applyDefaultSettings(){
     m_Data.m_GrowthFactor=1.1;/**< the growth factor for time adaptive */
     m_Data.m_IsAdaptive=false;/**< boolean flag for adaptive */
     m_Data.m_OptimizeIters=4;/**< optimize nonlinear iterations for time adaptive */
+    m_Data.m_RebalanceInterval=0;/**< no load rebalance */
+    m_Data.m_RebalanceThreshold=0.2;/**< the imbalance threshold of the rebalance */
+    m_Data.m_AdaptInterval=0;/**< no mesh adaptivity */
+    m_Data.m_AdaptInitialSteps=0;/**< no adaptation of the initial conditions */
+    m_Data.m_AdaptDofName.clear();/**< the dof which drives the marker */
+    m_Data.m_AdaptMarker=MeshAdaptMarkerType::GRADIENT;/**< the marker type */
+    m_Data.m_AdaptRefine=0.5;/**< the refine threshold */
+    m_Data.m_AdaptCoarsen=0.05;/**< the coarsen threshold */
+    m_Data.m_AdaptMaxLevel=2;/**< the maximum refinement level */
+    m_Data.m_LumpedMassType=LumpedMassType::ROWSUM;/**< the lumped mass of the explicit dynamics */
+    m_Data.m_CFLFactor=0.9;/**< the cfl factor of the explicit sub-step */
+    m_Data.m_EstimateStableDt=true;/**< estimate the explicit sub-step */
+    m_Data.m_MaxSubSteps=100000;/**< the maximum explicit sub-steps */
 
     m_Data.m_SteppingType=TimeSteppingType::BACKWARDEULER;/**< the time stepping type */
 }
@@ -71,6 +97,25 @@ void TimeStepping::printInfo()const{
         MessagePrinter::printNormalTxt("  adaptive = false");
     }
 
+    if(getRebalanceInterval()>0){
+        snprintf(buff,69,"  rebalance every %4d steps, imbalance threshold=%8.3f",
+                         getRebalanceInterval(),getRebalanceThreshold());
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+    }
+
+    if(getMeshAdaptInterval()>0){
+        snprintf(buff,69,"  adapt mesh every %4d steps by '%s', max level=%2d",
+                         getMeshAdaptInterval(),m_Data.m_AdaptDofName.c_str(),m_Data.m_AdaptMaxLevel);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+        snprintf(buff,69,"  %s marker, refine=%12.5e, coarsen=%12.5e",
+                         m_Data.m_AdaptMarker==MeshAdaptMarkerType::GRADIENT?"gradient":"value",
+                         m_Data.m_AdaptRefine,m_Data.m_AdaptCoarsen);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+    }
+
     if(getTimeSteppingType()==TimeSteppingType::BACKWARDEULER){
         MessagePrinter::printNormalTxt("  stepping method = backward euler(BE)");
     }
@@ -83,6 +128,17 @@ void TimeStepping::printInfo()const{
     else if(getTimeSteppingType()==TimeSteppingType::BDF2){
         MessagePrinter::printNormalTxt("  stepping method = BDF2");
     }
+    else if(getTimeSteppingType()==TimeSteppingType::EXPLICIT){
+        MessagePrinter::printNormalTxt("  stepping method = explicit central difference");
+        snprintf(buff,69,"  %s lumped mass, cfl=%8.3f, max sub-steps=%8d",
+                         m_Data.m_LumpedMassType==LumpedMassType::HRZ?"hrz":"row-sum",
+                         m_Data.m_CFLFactor,m_Data.m_MaxSubSteps);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+        if(!m_Data.m_EstimateStableDt){
+            MessagePrinter::printNormalTxt("  stable dt estimate = false, dt0 is used as the sub-step");
+        }
+    }
 
     MessagePrinter::printStars();
 }
\ No newline at end of file
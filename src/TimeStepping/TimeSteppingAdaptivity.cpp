@@ -0,0 +1,92 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.17
+//+++ Purpose: refine and coarsen the mesh during the transient
+//+++          analysis, then rebuild the systems which depend on
+//+++          the mesh
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "TimeStepping/TimeStepping.h"
+#include "Utils/Profiler.h"
+
+bool TimeStepping::adaptMesh(FECell &t_FECell,
+                             DofHandler &t_DofHandler,
+                             FE &t_FE,
+                             ElmtSystem &t_ElmtSystem,
+                             FESystem &t_FESystem,
+                             BCSystem &t_BCSystem,
+                             SolutionSystem &t_SolnSystem,
+                             EquationSystem &t_EqSystem,
+                             ProjectionSystem &t_ProjSystem,
+                             LinearSolver &t_LinearSolver,
+                             NonlinearSolver &t_NLSolver,
+                             OutputSystem &t_Output,
+                             Postprocessor &t_PostProcess){
+    ProfilerScope AdaptScope("mesh-adaptivity");
+    int rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+
+    /**
+     * the marker only runs on the master rank, which holds the global mesh
+     */
+    const int DofID=t_DofHandler.getDofIDViaName(m_Data.m_AdaptDofName);
+    vector<double> NodalValues;
+    t_SolnSystem.m_Ucurrent.makeGhostCopy();
+    if(rank==0){
+        NodalValues.resize(t_DofHandler.getNodesNum(),0.0);
+        for(int i=1;i<=t_DofHandler.getNodesNum();i++){
+            NodalValues[i-1]=t_SolnSystem.m_Ucurrent.getIthValueFromGhost(t_DofHandler.getIthNodeJthDofID(i,DofID));
+        }
+    }
+    t_SolnSystem.m_Ucurrent.destroyGhostCopy();
+
+    const vector<int> OldPartInfo=t_FECell.getBulkElmtsPartInfo();
+    const int OldElmtsNum=t_FECell.getFECellBulkElmtsNum();
+    MeshTransferData Transfer;
+    if(!t_FECell.adaptMesh(NodalValues,m_Data.m_AdaptMarker,m_Data.m_AdaptRefine,m_Data.m_AdaptCoarsen,
+                           m_Data.m_AdaptMaxLevel,Transfer)){
+        return false;
+    }
+
+    /**
+     * the dofs map and the sparsity pattern are rebuilt from the new mesh, the element blocks and the bc faces
+     * are re-collected from the new physical groups
+     */
+    t_DofHandler.createBulkDofsMap(t_FECell,t_ElmtSystem);
+    t_ElmtSystem.init(t_FECell);
+    t_BCSystem.resetBoundaryDofSets();
+    t_FESystem.init(t_FECell,t_DofHandler);
+    t_EqSystem.releaseMemory();
+    t_EqSystem.init(t_DofHandler);
+    t_EqSystem.createSparsityPattern(t_DofHandler);
+
+    t_SolnSystem.transferSolution(Transfer,t_DofHandler,t_FE,OldPartInfo,t_FECell.getBulkElmtsPartInfo());
+    t_ProjSystem.init(t_FECell,t_DofHandler);
+
+    // the solvers hold the old matrix layout
+    t_NLSolver.releaseMemory();
+    t_LinearSolver.releaseMemory();
+    t_LinearSolver.init();
+    t_LinearSolver.initFieldSplit(t_DofHandler,t_EqSystem.m_AMATRIX);
+    t_LinearSolver.initMultigrid(t_FECell,t_DofHandler,t_EqSystem.m_AMATRIX);
+    t_NLSolver.init(t_LinearSolver);
+    t_NLSolver.resetJacobian();
+
+    t_Output.resetGeometryCache();
+    // the probes hold the old host elements and the old local offsets of the vectors
+    t_PostProcess.resetProbes();
+    t_FESystem.resetLocalElmtCost();
+
+    char buff[68];
+    snprintf(buff,68," Mesh is adapted, bulk elements: %8d -> %8d",OldElmtsNum,t_FECell.getFECellBulkElmtsNum());
+    MessagePrinter::printNormalTxt(string(buff),MessageColor::BLUE);
+    return true;
+}
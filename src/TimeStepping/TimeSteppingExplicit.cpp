@@ -0,0 +1,237 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.19
+//+++ Purpose: explicit central difference scheme (in the velocity
+//+++          verlet form) with the lumped mass:
+//+++            v_{n+1/2}=v_n+0.5*dt*a_n
+//+++            u_{n+1}  =u_n+dt*v_{n+1/2}
+//+++            a_{n+1}  =-R(u_{n+1})/M
+//+++            v_{n+1}  =v_{n+1/2}+0.5*dt*a_{n+1}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <cmath>
+#include <algorithm>
+
+#include "TimeStepping/TimeStepping.h"
+#include "Utils/Profiler.h"
+
+namespace{
+    /**
+     * evaluate the acceleration of the current solution (stored in u_temp), a=-R/M, the dirichlet rows of R are zero
+     */
+    void computeExplicitAcceleration(const double &T,
+                                     FEControlInfo &t_FECtrlInfo,
+                                     FECell &t_FECell,
+                                     DofHandler &t_DofHandler,
+                                     FE &t_FE,
+                                     ElmtSystem &t_ElmtSystem,
+                                     MateSystem &t_MateSystem,
+                                     FESystem &t_FESystem,
+                                     BCSystem &t_BCSystem,
+                                     SolutionSystem &t_SolnSystem,
+                                     EquationSystem &t_EqSystem,
+                                     Vector &Mass){
+        t_BCSystem.applyPresetBoundaryConditions(FECalcType::UPDATEU,T,t_FECell,t_DofHandler,
+                                                 t_SolnSystem.m_Utemp,t_SolnSystem.m_Ucopy,
+                                                 t_SolnSystem.m_Uold,t_SolnSystem.m_Uolder,t_SolnSystem.m_V,
+                                                 t_EqSystem.m_AMATRIX,t_EqSystem.m_RHS);
+        t_FESystem.formBulkFE(FECalcType::COMPUTERESIDUAL,T,t_FECtrlInfo.Dt,t_FECtrlInfo.Ctan,
+                              t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_MateSystem,t_SolnSystem,
+                              t_EqSystem.m_AMATRIX,t_EqSystem.m_RHS);
+        t_BCSystem.applyBoundaryConditions(FECalcType::COMPUTERESIDUAL,T,t_FECtrlInfo.Ctan,t_FECell,t_DofHandler,t_FE,
+                                           t_SolnSystem.m_Utemp,t_SolnSystem.m_Ucopy,
+                                           t_SolnSystem.m_Uold,t_SolnSystem.m_Uolder,t_SolnSystem.m_V,
+                                           t_EqSystem.m_AMATRIX,t_EqSystem.m_RHS);
+        VecPointwiseDivide(t_SolnSystem.m_A.getVectorRef(),t_EqSystem.m_RHS.getVectorRef(),Mass.getVectorRef());
+        VecScale(t_SolnSystem.m_A.getVectorRef(),-1.0);
+    }
+}
+
+bool TimeStepping::solveExplicit(FECell &t_FECell,
+                                 DofHandler &t_DofHandler,
+                                 FE &t_FE,
+                                 ElmtSystem &t_ElmtSystem,
+                                 MateSystem &t_MateSystem,
+                                 FESystem &t_FESystem,
+                                 BCSystem &t_BCSystem,
+                                 ICSystem &t_ICSystem,
+                                 SolutionSystem &t_SolnSystem,
+                                 EquationSystem &t_EqSystem,
+                                 ProjectionSystem &t_ProjSystem,
+                                 FEControlInfo &t_FECtrlInfo,
+                                 OutputSystem &t_Output,
+                                 Postprocessor &t_PostProcess){
+    char buff[68];
+    string str;
+
+    if(t_FECell.hasHangingNodes()){
+        MessagePrinter::printErrorTxt("the explicit dynamics doesn\'t support the hanging node constraints, please use the conforming mesh");
+        return false;
+    }
+    if(isAdaptive()||m_Data.m_RebalanceInterval>0||m_Data.m_AdaptInterval>0||m_Data.m_AdaptInitialSteps>0){
+        MessagePrinter::printWarningTxt("the adaptive dt, the load rebalance and the mesh adaptivity are ignored in the explicit dynamics");
+    }
+
+    t_FECtrlInfo.m_TimesteppingType=TimeSteppingType::EXPLICIT;
+    t_FECtrlInfo.Dt=m_Data.m_Dt0;
+    t_FECtrlInfo.CurrentStep=0;
+    t_FECtrlInfo.T=0.0;
+
+    t_SolnSystem.m_Ucurrent.setToZero();
+    t_ICSystem.applyInitialConditions(t_FECell,t_DofHandler,t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_Utemp.copyFrom(t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_Ucopy.copyFrom(t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_Uold.copyFrom(t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_Uolder.copyFrom(t_SolnSystem.m_Ucurrent);
+    t_SolnSystem.m_V.setToZero();
+    t_SolnSystem.m_A.setToZero();
+
+    // initialize the material
+    t_FESystem.formBulkFE(FECalcType::INITMATERIAL,
+                          t_FECtrlInfo.T,
+                          t_FECtrlInfo.Dt,
+                          t_FECtrlInfo.Ctan,
+                          t_FECell,
+                          t_DofHandler,
+                          t_FE,
+                          t_ElmtSystem,
+                          t_MateSystem,
+                          t_SolnSystem,
+                          t_EqSystem.m_AMATRIX,
+                          t_EqSystem.m_RHS);
+
+    /**
+     * the lumped mass is assembled only once, the sub-step comes from the cfl condition of the undeformed mesh
+     */
+    Vector Mass(t_SolnSystem.m_Ucurrent);
+    t_FESystem.formBulkLumpedMass(m_Data.m_LumpedMassType,t_FECell,t_DofHandler,t_FE,t_ElmtSystem,Mass);
+    double SubDtMax=m_Data.m_Dt0;
+    if(m_Data.m_EstimateStableDt){
+        const double DtStable=t_FESystem.estimateStableDt(t_FECell,t_ElmtSystem);
+        SubDtMax=m_Data.m_CFLFactor*DtStable;
+        snprintf(buff,68,"Stable dt=%13.5e, explicit sub-step=%13.5e",DtStable,std::min(SubDtMax,m_Data.m_Dt0));
+        MessagePrinter::printDashLine();
+        MessagePrinter::printNormalTxt(string(buff));
+    }
+
+    // the acceleration of the initial state
+    computeExplicitAcceleration(t_FECtrlInfo.T,t_FECtrlInfo,t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_MateSystem,
+                                t_FESystem,t_BCSystem,t_SolnSystem,t_EqSystem,Mass);
+    t_SolnSystem.m_Ucurrent.copyFrom(t_SolnSystem.m_Utemp);
+    t_SolnSystem.updateMaterialsSolution();
+
+    t_ProjSystem.executeProjection(t_FECell,t_DofHandler,t_ElmtSystem,t_MateSystem,t_FE,t_SolnSystem,t_FECtrlInfo);
+    MessagePrinter::printDashLine();
+    MessagePrinter::printNormalTxt("Material properties and lumped mass have been initialized");
+    MessagePrinter::printDashLine();
+
+    t_Output.savePVDHead();
+    t_Output.savePVDEnd();
+    t_Output.saveResults2File(0,t_FECell,t_DofHandler,t_SolnSystem,t_ProjSystem);
+    t_Output.savePVDResults(0.0);
+    MessagePrinter::printDashLine(MessageColor::BLUE);
+    MessagePrinter::printNormalTxt("Save results to "+t_Output.getOutputFileName(),MessageColor::BLUE);
+    MessagePrinter::printDashLine(MessageColor::BLUE);
+    if(t_PostProcess.hasPostprocess()){
+        t_PostProcess.prepareCSVFileHeader();
+        t_PostProcess.executePostprocess(t_FECell,t_DofHandler,t_FE,t_MateSystem,t_ProjSystem,t_SolnSystem);
+        t_PostProcess.savePPSResults2CSVFile(0.0);
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+        MessagePrinter::printNormalTxt("Save postprocess result to "+t_PostProcess.getCSVFileName(),MessageColor::BLUE);
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+    }
+    MessagePrinter::printStars();
+
+    /**
+     * each step of dt0 (the output step) is split into the equal sub-steps, which are not larger than the stable one
+     */
+    const double TimeTol=1.0e-12*m_Data.m_FinalTime;
+    double StepDt,SubDt,Anorm;
+    int SubSteps;
+    while(t_FECtrlInfo.T<m_Data.m_FinalTime-TimeTol){
+        ProfilerScope StepScope("explicit-step",true);
+        StepDt=std::min(m_Data.m_Dt0,m_Data.m_FinalTime-t_FECtrlInfo.T);
+        SubSteps=static_cast<int>(std::ceil(StepDt/SubDtMax-1.0e-10));
+        if(SubSteps<1) SubSteps=1;
+        if(SubSteps>m_Data.m_MaxSubSteps){
+            snprintf(buff,68,"%d sub-steps exceed the max-substeps=%d",SubSteps,m_Data.m_MaxSubSteps);
+            MessagePrinter::printErrorTxt(string(buff)+", please reduce dt0 or increase max-substeps in the explicit option");
+            Mass.releaseMemory();
+            return false;
+        }
+        SubDt=StepDt/SubSteps;
+        t_FECtrlInfo.Dt=SubDt;
+
+        snprintf(buff,68,"Time=%13.5e, step=%8d, dt=%13.5e",t_FECtrlInfo.T+StepDt,t_FECtrlInfo.CurrentStep+1,SubDt);
+        str=buff;
+        MessagePrinter::printNormalTxt(str);
+        for(int sub=1;sub<=SubSteps;sub++){
+            t_SolnSystem.m_Uolder.copyFrom(t_SolnSystem.m_Uold);
+            t_SolnSystem.m_Uold.copyFrom(t_SolnSystem.m_Ucurrent);
+            // half-step velocity and the new displacement
+            VecAXPY(t_SolnSystem.m_V.getVectorRef(),0.5*SubDt,t_SolnSystem.m_A.getVectorRef());
+            VecAXPY(t_SolnSystem.m_Ucurrent.getVectorRef(),SubDt,t_SolnSystem.m_V.getVectorRef());
+            t_SolnSystem.m_Utemp.copyFrom(t_SolnSystem.m_Ucurrent);
+            t_SolnSystem.m_Ucopy.copyFrom(t_SolnSystem.m_Ucurrent);
+
+            t_FECtrlInfo.T+=SubDt;
+            computeExplicitAcceleration(t_FECtrlInfo.T,t_FECtrlInfo,t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_MateSystem,
+                                        t_FESystem,t_BCSystem,t_SolnSystem,t_EqSystem,Mass);
+            t_SolnSystem.m_Ucurrent.copyFrom(t_SolnSystem.m_Utemp);
+            VecAXPY(t_SolnSystem.m_V.getVectorRef(),0.5*SubDt,t_SolnSystem.m_A.getVectorRef());
+            t_SolnSystem.updateMaterialsSolution();
+        }
+        t_FECtrlInfo.CurrentStep+=1;
+
+        Anorm=t_SolnSystem.m_A.getNorm();
+        snprintf(buff,68,"  Explicit solver: sub-steps=%8d, |a|=%12.5e",SubSteps,Anorm);
+        MessagePrinter::printNormalTxt(string(buff));
+        if(std::isnan(Anorm)||std::isinf(Anorm)){
+            MessagePrinter::printErrorTxt("the explicit solution diverges, please reduce the cfl factor or the dt0");
+            Mass.releaseMemory();
+            return false;
+        }
+
+        if(t_FECtrlInfo.CurrentStep%t_Output.getIntervalNum()==0){
+            t_ProjSystem.executeProjection(t_FECell,t_DofHandler,t_ElmtSystem,t_MateSystem,t_FE,t_SolnSystem,t_FECtrlInfo);
+            t_Output.saveResults2File(t_FECtrlInfo.CurrentStep,t_FECell,t_DofHandler,t_SolnSystem,t_ProjSystem);
+            t_Output.savePVDResults(t_FECtrlInfo.T);
+            MessagePrinter::printDashLine(MessageColor::BLUE);
+            MessagePrinter::printNormalTxt("Save results to "+t_Output.getOutputFileName(),MessageColor::BLUE);
+            MessagePrinter::printDashLine(MessageColor::BLUE);
+        }
+        if(t_PostProcess.hasPostprocess()){
+            if(t_FECtrlInfo.CurrentStep%t_PostProcess.getInterval()==0){
+                if(t_FECtrlInfo.CurrentStep%t_Output.getIntervalNum()!=0){
+                    t_ProjSystem.executeProjection(t_FECell,t_DofHandler,t_ElmtSystem,t_MateSystem,t_FE,t_SolnSystem,t_FECtrlInfo);
+                }
+                t_PostProcess.executePostprocess(t_FECell,t_DofHandler,t_FE,t_MateSystem,t_ProjSystem,t_SolnSystem);
+                t_PostProcess.savePPSResults2CSVFile(t_FECtrlInfo.T);
+                MessagePrinter::printDashLine(MessageColor::BLUE);
+                MessagePrinter::printNormalTxt("Save postprocess result to "+t_PostProcess.getCSVFileName(),MessageColor::BLUE);
+                MessagePrinter::printDashLine(MessageColor::BLUE);
+            }
+        }
+        MessagePrinter::printStars();
+    }
+    if(t_FECtrlInfo.CurrentStep%t_Output.getIntervalNum()!=0){
+        t_ProjSystem.executeProjection(t_FECell,t_DofHandler,t_ElmtSystem,t_MateSystem,t_FE,t_SolnSystem,t_FECtrlInfo);
+        t_Output.saveResults2File(t_FECtrlInfo.CurrentStep,t_FECell,t_DofHandler,t_SolnSystem,t_ProjSystem);
+        t_Output.savePVDResults(t_FECtrlInfo.T);
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+        MessagePrinter::printNormalTxt("Save results to "+t_Output.getOutputFileName(),MessageColor::BLUE);
+        MessagePrinter::printDashLine(MessageColor::BLUE);
+        MessagePrinter::printStars();
+    }
+    Mass.releaseMemory();
+
+    return true;
+}
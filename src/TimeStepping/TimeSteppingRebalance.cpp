@@ -0,0 +1,57 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.03.14
+//+++ Purpose: check the rank-time imbalance of the bulk assembly
+//+++          and re-partition the bulk elements during the
+//+++          transient analysis
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include "TimeStepping/TimeStepping.h"
+#include "Utils/Profiler.h"
+
+void TimeStepping::rebalanceBulkElmts(FECell &t_FECell,
+                                      DofHandler &t_DofHandler,
+                                      ElmtSystem &t_ElmtSystem,
+                                      FESystem &t_FESystem,
+                                      SolutionSystem &t_SolnSystem){
+    ProfilerScope RebalanceScope("rebalance");
+    int size;
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    const vector<double> &LocalCost=t_FESystem.getLocalElmtCost();
+    double RankCost=0.0,MaxCost,SumCost;
+    for(const auto &cost:LocalCost) RankCost+=cost;
+    MPI_Allreduce(&RankCost,&MaxCost,1,MPI_DOUBLE,MPI_MAX,PETSC_COMM_WORLD);
+    MPI_Allreduce(&RankCost,&SumCost,1,MPI_DOUBLE,MPI_SUM,PETSC_COMM_WORLD);
+    if(SumCost<=0.0) return;
+
+    const double Imbalance=MaxCost/(SumCost/size)-1.0;
+    char buff[68];
+    snprintf(buff,68," Load imbalance of the bulk assembly=%8.3f",Imbalance);
+    MessagePrinter::printNormalTxt(string(buff));
+    if(Imbalance<=m_Data.m_RebalanceThreshold){
+        t_FESystem.resetLocalElmtCost();
+        return;
+    }
+
+    vector<int> OldPartInfo;
+    if(!t_FECell.rebalanceBulkElmts(LocalCost,OldPartInfo)){
+        t_FESystem.resetLocalElmtCost();
+        return;
+    }
+    // the global dofs map and the sparsity pattern don't depend on the partition, only the local data is moved
+    t_DofHandler.updateLocalBulkDofsMap(t_FECell);
+    t_ElmtSystem.init(t_FECell);
+    t_SolnSystem.migrateLocalQpMaterials(OldPartInfo,t_FECell.getBulkElmtsPartInfo());
+    t_FESystem.resetLocalElmtCost();
+
+    MessagePrinter::printNormalTxt(" Bulk elements are re-partitioned by their assembly cost",MessageColor::BLUE);
+}
@@ -31,6 +31,11 @@ bool TimeStepping::solve(FECell &t_FECell,
                          OutputSystem &t_Output,
                          Postprocessor &t_PostProcess){
 
+    if(m_Data.m_SteppingType==TimeSteppingType::EXPLICIT){
+        return solveExplicit(t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_MateSystem,t_FESystem,t_BCSystem,t_ICSystem,
+                             t_SolnSystem,t_EqSystem,t_ProjSystem,t_FECtrlInfo,t_Output,t_PostProcess);
+    }
+
     char buff[68];//77-12=65
     string str;
     int lastiters=1000;
@@ -40,6 +45,21 @@ bool TimeStepping::solve(FECell &t_FECell,
 
     t_SolnSystem.m_Ucurrent.setToZero();
     t_ICSystem.applyInitialConditions(t_FECell,t_DofHandler,t_SolnSystem.m_Ucurrent);
+
+    bool IsMeshAdapt=m_Data.m_AdaptInterval>0||m_Data.m_AdaptInitialSteps>0;
+    if(IsMeshAdapt&&t_FECell.isImplicitGrid()){
+        MessagePrinter::printWarningTxt("the implicit structured grid can't be adapted, the mesh adaptivity is disabled");
+        IsMeshAdapt=false;
+    }
+    if(IsMeshAdapt){
+        // resolve the initial fronts, the initial conditions are evaluated again on the adapted mesh
+        for(int i=0;i<m_Data.m_AdaptInitialSteps;i++){
+            if(!adaptMesh(t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_FESystem,t_BCSystem,t_SolnSystem,
+                          t_EqSystem,t_ProjSystem,t_LinearSolver,t_NLSolver,t_Output,t_PostProcess)) break;
+            t_SolnSystem.m_Ucurrent.setToZero();
+            t_ICSystem.applyInitialConditions(t_FECell,t_DofHandler,t_SolnSystem.m_Ucurrent);
+        }
+    }
     t_SolnSystem.m_Utemp.copyFrom(t_SolnSystem.m_Ucurrent);
     t_SolnSystem.m_Uold.copyFrom(t_SolnSystem.m_Ucurrent);
     t_SolnSystem.m_Uolder.copyFrom(t_SolnSystem.m_Ucurrent);
@@ -79,6 +99,15 @@ bool TimeStepping::solve(FECell &t_FECell,
     }
     MessagePrinter::printStars();
 
+    // the assembly time of each element is measured for the load rebalance
+    bool IsRebalance=m_Data.m_RebalanceInterval>0;
+    if(IsRebalance&&t_FECell.isImplicitGrid()){
+        MessagePrinter::printWarningTxt("the implicit structured grid can't be re-partitioned, the load rebalance is disabled");
+        IsRebalance=false;
+    }
+    t_FESystem.setElmtCostMeasurement(IsRebalance);
+    t_FESystem.resetLocalElmtCost();
+
     IsLastStepFailed=true;
     for(t_FECtrlInfo.T=0.0;t_FECtrlInfo.T<=m_Data.m_FinalTime;){
         snprintf(buff,68,"Time=%13.5e, step=%8d, dt=%13.5e",t_FECtrlInfo.T+t_FECtrlInfo.Dt,t_FECtrlInfo.CurrentStep+1,t_FECtrlInfo.Dt);
@@ -155,6 +184,13 @@ bool TimeStepping::solve(FECell &t_FECell,
             t_SolnSystem.m_Uolder.copyFrom(t_SolnSystem.m_Uold);
             t_SolnSystem.m_Uold.copyFrom(t_SolnSystem.m_Ucurrent);
             t_SolnSystem.m_V.setToZero();
+            if(IsRebalance&&t_FECtrlInfo.CurrentStep%m_Data.m_RebalanceInterval==0){
+                rebalanceBulkElmts(t_FECell,t_DofHandler,t_ElmtSystem,t_FESystem,t_SolnSystem);
+            }
+            if(IsMeshAdapt&&m_Data.m_AdaptInterval>0&&t_FECtrlInfo.CurrentStep%m_Data.m_AdaptInterval==0){
+                adaptMesh(t_FECell,t_DofHandler,t_FE,t_ElmtSystem,t_FESystem,t_BCSystem,t_SolnSystem,
+                          t_EqSystem,t_ProjSystem,t_LinearSolver,t_NLSolver,t_Output,t_PostProcess);
+            }
             // store the previous step's iteration numbers
             lastiters=t_NLSolver.getIterationNum();
             IsLastStepFailed=false;
@@ -182,6 +218,7 @@ bool TimeStepping::solve(FECell &t_FECell,
         MessagePrinter::printDashLine(MessageColor::BLUE);
         MessagePrinter::printStars();
     }
+    t_FESystem.setElmtCostMeasurement(false);
     
     return true;
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+//****************************************************************
+//* This file is part of the AsFem framework
+//* Advanced Simulation kit based on Finite Element Method (AsFem)
+//* All rights reserved, Yang Bai/MM-Lab@CopyRight 2020-present
+//* https://github.com/MatMechLab/AsFem
+//* Licensed under GNU GPLv3, please see LICENSE for details
+//* https://www.gnu.org/licenses/gpl-3.0.en.html
+//****************************************************************
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//+++ Author : Yang Bai
+//+++ Date   : 2025.02.20
+//+++ Purpose: the hierarchical runtime profiler of AsFem, it is
+//+++          enabled by the '--profile' command line option
+//++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+#include <fstream>
+#include <algorithm>
+
+#include "Utils/Profiler.h"
+#include "Utils/MessagePrinter.h"
+#include "nlohmann/json.hpp"
+
+bool Profiler::m_Enabled=false;
+vector<Profiler::ScopeNode> Profiler::m_Nodes;
+vector<int> Profiler::m_NodeStack;
+vector<std::chrono::steady_clock::time_point> Profiler::m_StartStack;
+map<string,PetscLogStage> Profiler::m_Stages;
+
+void Profiler::enable(const bool &flag){
+    m_Enabled=flag;
+    m_Nodes.clear();
+    m_NodeStack.clear();
+    m_StartStack.clear();
+    if(!m_Enabled) return;
+
+    ScopeNode root;
+    root.m_Name="asfem";
+    root.m_Path="asfem";
+    root.m_Parent=-1;
+    root.m_Depth=0;
+    root.m_Time=0.0;
+    root.m_Calls=1;
+    root.m_HasStage=false;
+    m_Nodes.push_back(root);
+    m_NodeStack.push_back(0);
+    m_StartStack.push_back(std::chrono::steady_clock::now());
+}
+
+void Profiler::beginScope(const char *name,const bool &petscstage){
+    if(!m_Enabled) return;
+    const int parent=m_NodeStack.back();
+    int id=-1;
+    for(const auto &child:m_Nodes[parent].m_Children){
+        if(m_Nodes[child].m_Name==name){
+            id=child;break;
+        }
+    }
+    if(id<0){
+        ScopeNode node;
+        node.m_Name=name;
+        node.m_Path=m_Nodes[parent].m_Path+"/"+node.m_Name;
+        node.m_Parent=parent;
+        node.m_Depth=m_Nodes[parent].m_Depth+1;
+        node.m_Time=0.0;
+        node.m_Calls=0;
+        node.m_HasStage=false;
+        if(petscstage){
+            // the same scope name may appear under different parents, but PETSc only accepts unique stage names
+            if(!m_Stages.count(node.m_Name)){
+                PetscLogStage stage;
+                PetscLogStageRegister(name,&stage);
+                m_Stages[node.m_Name]=stage;
+            }
+            node.m_Stage=m_Stages[node.m_Name];
+            node.m_HasStage=true;
+        }
+        id=static_cast<int>(m_Nodes.size());
+        m_Nodes.push_back(node);
+        m_Nodes[parent].m_Children.push_back(id);
+    }
+    if(m_Nodes[id].m_HasStage) PetscLogStagePush(m_Nodes[id].m_Stage);
+    m_NodeStack.push_back(id);
+    m_StartStack.push_back(std::chrono::steady_clock::now());
+}
+
+void Profiler::endScope(){
+    if(!m_Enabled||m_NodeStack.size()<2) return;
+    const int id=m_NodeStack.back();
+    m_Nodes[id].m_Time+=std::chrono::duration<double>(std::chrono::steady_clock::now()-m_StartStack.back()).count();
+    m_Nodes[id].m_Calls+=1;
+    if(m_Nodes[id].m_HasStage) PetscLogStagePop();
+    m_NodeStack.pop_back();
+    m_StartStack.pop_back();
+}
+
+void Profiler::writeReport(const string &prefix){
+    if(!m_Enabled) return;
+    int rank,size;
+    MPI_Comm_rank(PETSC_COMM_WORLD,&rank);
+    MPI_Comm_size(PETSC_COMM_WORLD,&size);
+
+    // close all the opened scopes, including the root one
+    while(m_NodeStack.size()>1) endScope();
+    m_Nodes[0].m_Time=std::chrono::duration<double>(std::chrono::steady_clock::now()-m_StartStack[0]).count();
+
+    // the scope trees may differ between ranks, so the union of all the scope paths is created on the master rank
+    string LocalPaths;
+    for(const auto &node:m_Nodes) LocalPaths+=node.m_Path+"\n";
+    int LocalLength=static_cast<int>(LocalPaths.size());
+    vector<int> Lengths(size,0),Displs(size,0);
+    MPI_Gather(&LocalLength,1,MPI_INT,Lengths.data(),1,MPI_INT,0,PETSC_COMM_WORLD);
+    string AllPaths;
+    if(rank==0){
+        for(int i=1;i<size;i++) Displs[i]=Displs[i-1]+Lengths[i-1];
+        AllPaths.resize(Displs[size-1]+Lengths[size-1]);
+    }
+    MPI_Gatherv(LocalPaths.data(),LocalLength,MPI_CHAR,rank==0?&AllPaths[0]:nullptr,Lengths.data(),Displs.data(),MPI_CHAR,0,PETSC_COMM_WORLD);
+
+    vector<string> Paths;
+    vector<int> Depths;
+    if(rank==0){
+        map<string,bool> HasPath;
+        string path;
+        for(const auto &c:AllPaths){
+            if(c=='\n'){
+                if(!HasPath.count(path)){
+                    HasPath[path]=true;
+                    Paths.push_back(path);
+                }
+                path.clear();
+            }
+            else{
+                path+=c;
+            }
+        }
+        AllPaths.clear();
+        for(const auto &p:Paths) AllPaths+=p+"\n";
+    }
+    int AllLength=static_cast<int>(AllPaths.size());
+    MPI_Bcast(&AllLength,1,MPI_INT,0,PETSC_COMM_WORLD);
+    if(rank!=0) AllPaths.resize(AllLength);
+    MPI_Bcast(&AllPaths[0],AllLength,MPI_CHAR,0,PETSC_COMM_WORLD);
+    if(rank!=0){
+        string path;
+        for(const auto &c:AllPaths){
+            if(c=='\n'){
+                Paths.push_back(path);path.clear();
+            }
+            else{
+                path+=c;
+            }
+        }
+    }
+
+    // now each rank fills its own time and calls, the missing scopes are zero
+    map<string,int> Path2Node;
+    for(int i=0;i<static_cast<int>(m_Nodes.size());i++) Path2Node[m_Nodes[i].m_Path]=i;
+    const int n=static_cast<int>(Paths.size());
+    vector<double> Times(n,0.0),MinTimes(n,0.0),MaxTimes(n,0.0),SumTimes(n,0.0);
+    vector<double> Calls(n,0.0),SumCalls(n,0.0),MaxCalls(n,0.0);
+    for(int i=0;i<n;i++){
+        if(Path2Node.count(Paths[i])){
+            Times[i]=m_Nodes[Path2Node[Paths[i]]].m_Time;
+            Calls[i]=static_cast<double>(m_Nodes[Path2Node[Paths[i]]].m_Calls);
+        }
+    }
+    MPI_Reduce(Times.data(),MinTimes.data(),n,MPI_DOUBLE,MPI_MIN,0,PETSC_COMM_WORLD);
+    MPI_Reduce(Times.data(),MaxTimes.data(),n,MPI_DOUBLE,MPI_MAX,0,PETSC_COMM_WORLD);
+    MPI_Reduce(Times.data(),SumTimes.data(),n,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);
+    MPI_Reduce(Calls.data(),SumCalls.data(),n,MPI_DOUBLE,MPI_SUM,0,PETSC_COMM_WORLD);
+    MPI_Reduce(Calls.data(),MaxCalls.data(),n,MPI_DOUBLE,MPI_MAX,0,PETSC_COMM_WORLD);
+
+    if(rank==0){
+        nlohmann::json report;
+        report["ranks"]=size;
+        report["scopes"]=nlohmann::json::array();
+        std::ofstream csv;
+        csv.open(prefix+"-profile.csv",std::ios::out);
+        csv<<"scope,depth,calls-avg,calls-max,time-min,time-max,time-avg,imbalance"<<std::endl;
+        double avg,imbalance;
+        int depth;
+        char buff[70];
+        MessagePrinter::printStars();
+        MessagePrinter::printNormalTxt("Profiler summary (time in [s], max/avg/imbalance over ranks):");
+        for(int i=0;i<n;i++){
+            avg=SumTimes[i]/size;
+            imbalance=avg>0.0?MaxTimes[i]/avg:1.0;
+            depth=static_cast<int>(std::count(Paths[i].begin(),Paths[i].end(),'/'));
+            nlohmann::json scope;
+            scope["scope"]=Paths[i];
+            scope["depth"]=depth;
+            scope["calls-avg"]=SumCalls[i]/size;
+            scope["calls-max"]=MaxCalls[i];
+            scope["time-min"]=MinTimes[i];
+            scope["time-max"]=MaxTimes[i];
+            scope["time-avg"]=avg;
+            scope["imbalance"]=imbalance;
+            report["scopes"].push_back(scope);
+            csv<<Paths[i]<<","<<depth<<","<<SumCalls[i]/size<<","<<MaxCalls[i]<<","
+               <<MinTimes[i]<<","<<MaxTimes[i]<<","<<avg<<","<<imbalance<<std::endl;
+            if(depth<=2){
+                snprintf(buff,70,"%*s%-*.*s%10.3e %10.3e %6.2f",2*depth,"",28-2*depth,28-2*depth,
+                         Paths[i].substr(Paths[i].find_last_of('/')+1).c_str(),MaxTimes[i],avg,imbalance);
+                MessagePrinter::printNormalTxt(buff);
+            }
+        }
+        csv.close();
+        std::ofstream out;
+        out.open(prefix+"-profile.json",std::ios::out);
+        out<<report.dump(4)<<std::endl;
+        out.close();
+        MessagePrinter::printNormalTxt("Profiler report is saved to "+prefix+"-profile.json/csv");
+        MessagePrinter::printStars();
+    }
+}